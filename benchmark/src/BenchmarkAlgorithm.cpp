@@ -10,6 +10,8 @@
 #include <EAStdC/EAStopwatch.h>
 #include <EAStdC/EAMemory.h>
 #include <EASTL/algorithm.h>
+#include <EASTL/execution.h>
+#include <EASTL/numeric.h>
 #include <EASTL/sort.h>
 #include <EASTL/vector.h>
 #include <EASTL/slist.h>
@@ -450,6 +452,33 @@ namespace
 		stopwatch.Stop();
 		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%p", &*out);
 	}
+
+	template <typename ExecutionPolicy, typename Iterator>
+	void TestForEachPolicy(EA::StdC::Stopwatch& stopwatch, const ExecutionPolicy& policy, Iterator first, Iterator last)
+	{
+		stopwatch.Restart();
+		eastl::for_each(policy, first, last, [](uint32_t& x) { x = (x * 2654435761u) ^ (x >> 7); });
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)*first);
+	}
+
+	template <typename ExecutionPolicy, typename Iterator>
+	void TestTransformPolicy(EA::StdC::Stopwatch& stopwatch, const ExecutionPolicy& policy, Iterator first, Iterator last, Iterator out)
+	{
+		stopwatch.Restart();
+		eastl::transform(policy, first, last, out, [](uint32_t x) { return (x * 2654435761u) ^ (x >> 7); });
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)*out);
+	}
+
+	template <typename ExecutionPolicy, typename Iterator>
+	void TestReducePolicy(EA::StdC::Stopwatch& stopwatch, const ExecutionPolicy& policy, Iterator first, Iterator last)
+	{
+		stopwatch.Restart();
+		const uint64_t nSum = eastl::reduce(policy, first, last, (uint64_t)0);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%llu", (unsigned long long)nSum);
+	}
 } // namespace
 
 
@@ -1212,6 +1241,57 @@ void BenchmarkAlgorithm8(EASTLTest_Rand& rng, EA::StdC::Stopwatch& stopwatch1, E
 }
 
 
+void BenchmarkAlgorithm9(EASTLTest_Rand& rng, EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2)
+{
+	// Sequential eastl algorithms against the parallel ones, which run on thread_pool::get_default().
+	const eastl_size_t kElementCount = 1000000;
+
+	EaVectorUint32 srcVec(kElementCount);
+	EaVectorUint32 eaVec1(kElementCount), eaVec2(kElementCount);
+	EaVectorUint32 eaOut1(kElementCount), eaOut2(kElementCount);
+
+	for(eastl_size_t i = 0; i < kElementCount; i++)
+		srcVec[i] = (uint32_t)rng();
+
+	for(int i = 0; i < 2; i++)
+	{
+		///////////////////////////////
+		// Test for_each(par)
+		///////////////////////////////
+
+		eaVec1 = srcVec;
+		eaVec2 = srcVec;
+
+		TestForEachPolicy(stopwatch1, eastl::execution::seq, eaVec1.begin(), eaVec1.end());
+		TestForEachPolicy(stopwatch2, eastl::execution::par, eaVec2.begin(), eaVec2.end());
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/for_each(par)/vector<uint32_t>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: sequential eastl::for_each");
+
+
+		///////////////////////////////
+		// Test transform(par)
+		///////////////////////////////
+
+		TestTransformPolicy(stopwatch1, eastl::execution::seq, srcVec.begin(), srcVec.end(), eaOut1.begin());
+		TestTransformPolicy(stopwatch2, eastl::execution::par, srcVec.begin(), srcVec.end(), eaOut2.begin());
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/transform(par)/vector<uint32_t>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: sequential eastl::transform");
+
+
+		///////////////////////////////
+		// Test reduce(par)
+		///////////////////////////////
+
+		TestReducePolicy(stopwatch1, eastl::execution::seq, srcVec.begin(), srcVec.end());
+		TestReducePolicy(stopwatch2, eastl::execution::par, srcVec.begin(), srcVec.end());
+
+		if(i == 1)
+			Benchmark::AddResult("algorithm/reduce(par)/vector<uint32_t>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: sequential eastl::reduce");
+	}
+}
+
 
 void BenchmarkAlgorithm()
 {
@@ -1229,6 +1309,7 @@ void BenchmarkAlgorithm()
 	BenchmarkAlgorithm6(rng, stopwatch1, stopwatch2);
 	BenchmarkAlgorithm7(rng, stopwatch1, stopwatch2);
 	BenchmarkAlgorithm8(rng, stopwatch1, stopwatch2);
+	BenchmarkAlgorithm9(rng, stopwatch1, stopwatch2);
 }
 
 
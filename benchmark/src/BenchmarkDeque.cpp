@@ -10,6 +10,10 @@
 #include <EASTL/deque.h>
 #include <EASTL/vector.h>
 #include <EASTL/sort.h>
+#include <EASTL/bonus/ring_buffer.h>
+#include <EASTL/bonus/spsc_ring_buffer.h>
+#include <EASTL/bonus/mpmc_bounded_queue.h>
+#include <eathread/eathread_thread.h>
 
 #ifdef _MSC_VER
 	#pragma warning(push, 0)
@@ -18,6 +22,8 @@
 #include <algorithm>
 #include <vector>
 #include <deque>
+#include <atomic>
+#include <mutex>
 #include <stdio.h>
 #include <stdlib.h>
 #ifdef _MSC_VER
@@ -60,6 +66,65 @@ typedef std::deque<ValuePair>   StdDeque;
 typedef eastl::deque<ValuePair, EASTLAllocatorType, 128> EaDeque;  // What value do we pick for the subarray size to make the comparison fair? Using the default isn't ideal because it results in this test measuring speed efficiency and ignoring memory efficiency. 
 
 
+// MutexRingBuffer
+//
+// A ring_buffer shared between threads by guarding it with a single mutex, which is
+// what spsc_ring_buffer and mpmc_bounded_queue are measured against. It has the
+// subset of their interface that the multithreaded benchmarks use.
+//
+template <typename T>
+class MutexRingBuffer
+{
+public:
+	explicit MutexRingBuffer(eastl_size_t nCapacity) : mMutex(), mRingBuffer(nCapacity) {}
+
+	bool try_push(const T& value)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if(mRingBuffer.full())
+			return false;
+		mRingBuffer.push_back(value);
+		return true;
+	}
+
+	bool try_pop(T& value)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if(mRingBuffer.empty())
+			return false;
+		value = mRingBuffer.front();
+		mRingBuffer.pop_front();
+		return true;
+	}
+
+	eastl_size_t push_n(const T* pValues, eastl_size_t n)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		eastl_size_t i = 0;
+		for(; (i < n) && !mRingBuffer.full(); i++)
+			mRingBuffer.push_back(pValues[i]);
+		return i;
+	}
+
+	eastl_size_t pop_n(T* pValues, eastl_size_t n)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		eastl_size_t i = 0;
+		for(; (i < n) && !mRingBuffer.empty(); i++)
+		{
+			pValues[i] = mRingBuffer.front();
+			mRingBuffer.pop_front();
+		}
+		return i;
+	}
+
+protected:
+	std::mutex                  mMutex;
+	eastl::ring_buffer<T>       mRingBuffer;
+};
+
+
+
 
 namespace
 {
@@ -195,6 +260,266 @@ namespace
 		stopwatch.Stop();
 	}
 
+
+	// Pushes mnCount values, in batches of mnBatchSize when that is more than one, and
+	// yields when the queue is full. Each thread waits until all of the threads have
+	// started, so that they run at the same time.
+	template <typename Queue>
+	struct QueueProducerThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::ThreadParameters mThreadParams;
+		EA::Thread::Thread           mThread;
+		Queue*                       mpQueue;
+		std::atomic<int>*            mpStartedCount;
+		int                          mnThreadCount;
+		uint32_t                     mnCount;
+		uint32_t                     mnBatchSize;
+
+		QueueProducerThread() : mThreadParams(), mThread(), mpQueue(NULL), mpStartedCount(NULL), mnThreadCount(0), mnCount(0), mnBatchSize(1) {}
+		QueueProducerThread(const QueueProducerThread&) = delete;
+		void operator=(const QueueProducerThread&) = delete;
+
+		intptr_t Run(void*) override
+		{
+			mpStartedCount->fetch_add(1);
+			while(mpStartedCount->load() < mnThreadCount)
+				EA::Thread::ThreadSleep(0);
+
+			uint32_t batch[64];
+
+			for(uint32_t i = 0; i < mnCount; )
+			{
+				if(mnBatchSize > 1)
+				{
+					const uint32_t n = eastl::min_alt(mnBatchSize, mnCount - i);
+
+					for(uint32_t j = 0; j < n; j++)
+						batch[j] = i + j;
+
+					for(uint32_t nPushed = 0; nPushed < n; )
+					{
+						const uint32_t nCount = (uint32_t)mpQueue->push_n(batch + nPushed, n - nPushed);
+
+						if(!nCount)
+							EA::Thread::ThreadSleep(0);
+						nPushed += nCount;
+					}
+
+					i += n;
+				}
+				else
+				{
+					while(!mpQueue->try_push(i))
+						EA::Thread::ThreadSleep(0);
+					i++;
+				}
+			}
+
+			return 0;
+		}
+	};
+
+
+	// Pops values until all of the producers' values have been consumed.
+	template <typename Queue>
+	struct QueueConsumerThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::ThreadParameters mThreadParams;
+		EA::Thread::Thread           mThread;
+		Queue*                       mpQueue;
+		std::atomic<int>*            mpStartedCount;
+		std::atomic<uint32_t>*       mpConsumedCount;
+		int                          mnThreadCount;
+		uint32_t                     mnTotalCount;
+		uint32_t                     mnBatchSize;
+		uint32_t                     mnSum;
+
+		QueueConsumerThread() : mThreadParams(), mThread(), mpQueue(NULL), mpStartedCount(NULL), mpConsumedCount(NULL), mnThreadCount(0), mnTotalCount(0), mnBatchSize(1), mnSum(0) {}
+		QueueConsumerThread(const QueueConsumerThread&) = delete;
+		void operator=(const QueueConsumerThread&) = delete;
+
+		intptr_t Run(void*) override
+		{
+			mpStartedCount->fetch_add(1);
+			while(mpStartedCount->load() < mnThreadCount)
+				EA::Thread::ThreadSleep(0);
+
+			uint32_t batch[64];
+
+			while(mpConsumedCount->load(std::memory_order_relaxed) < mnTotalCount)
+			{
+				uint32_t n = 0;
+
+				if(mnBatchSize > 1)
+					n = (uint32_t)mpQueue->pop_n(batch, mnBatchSize);
+				else if(mpQueue->try_pop(batch[0]))
+					n = 1;
+
+				if(n)
+				{
+					for(uint32_t j = 0; j < n; j++)
+						mnSum += batch[j];
+					mpConsumedCount->fetch_add(n, std::memory_order_relaxed);
+				}
+				else
+					EA::Thread::ThreadSleep(0);
+			}
+
+			return 0;
+		}
+	};
+
+
+	// Measures the time for nProducerCount threads to pass nTotalCount values through the
+	// queue to nConsumerCount threads.
+	template <typename Queue>
+	void TestQueueThroughput(EA::StdC::Stopwatch& stopwatch, Queue& q, int nProducerCount, int nConsumerCount, uint32_t nTotalCount, uint32_t nBatchSize)
+	{
+		eastl::vector<QueueProducerThread<Queue>> producers((eastl_size_t)nProducerCount);
+		eastl::vector<QueueConsumerThread<Queue>> consumers((eastl_size_t)nConsumerCount);
+		std::atomic<int>      nStartedCount(0);
+		std::atomic<uint32_t> nConsumedCount(0);
+		const int             nThreadCount = nProducerCount + nConsumerCount;
+
+		for(int t = 0; t < nProducerCount; t++)
+		{
+			producers[t].mpQueue        = &q;
+			producers[t].mpStartedCount = &nStartedCount;
+			producers[t].mnThreadCount  = nThreadCount;
+			producers[t].mnCount        = nTotalCount / (uint32_t)nProducerCount;
+			producers[t].mnBatchSize    = nBatchSize;
+			producers[t].mThreadParams.mpName = "QueueProducerThread";
+		}
+
+		for(int t = 0; t < nConsumerCount; t++)
+		{
+			consumers[t].mpQueue         = &q;
+			consumers[t].mpStartedCount  = &nStartedCount;
+			consumers[t].mpConsumedCount = &nConsumedCount;
+			consumers[t].mnThreadCount   = nThreadCount;
+			consumers[t].mnTotalCount    = (nTotalCount / (uint32_t)nProducerCount) * (uint32_t)nProducerCount;
+			consumers[t].mnBatchSize     = nBatchSize;
+			consumers[t].mThreadParams.mpName = "QueueConsumerThread";
+		}
+
+		stopwatch.Restart();
+
+		for(int t = 0; t < nProducerCount; t++)
+			producers[t].mThread.Begin(&producers[t], NULL, &producers[t].mThreadParams);
+		for(int t = 0; t < nConsumerCount; t++)
+			consumers[t].mThread.Begin(&consumers[t], NULL, &consumers[t].mThreadParams);
+
+		uint32_t nSum = 0;
+
+		for(int t = 0; t < nProducerCount; t++)
+			producers[t].mThread.WaitForEnd();
+		for(int t = 0; t < nConsumerCount; t++)
+		{
+			consumers[t].mThread.WaitForEnd();
+			nSum += consumers[t].mnSum;
+		}
+
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nSum);
+	}
+
+
+	// Measures the cost of a push and a pop when there is no other thread.
+	template <typename Queue>
+	void TestQueuePushPop(EA::StdC::Stopwatch& stopwatch, Queue& q, uint32_t nCount)
+	{
+		uint32_t nSum = 0, value = 0;
+
+		stopwatch.Restart();
+		for(uint32_t i = 0; i < nCount; i++)
+		{
+			q.try_push(i);
+			q.try_pop(value);
+			nSum += value;
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nSum);
+	}
+
+
+	// One end of a round trip. The sender sends the values 0 to mnCount - 1 one at a time,
+	// and waits for each to come back before sending the next. The other end sends each
+	// value that it receives straight back. Both ends run on threads of their own, as the
+	// benchmark's main thread runs at a raised priority and would starve a waiting peer.
+	template <typename Queue>
+	struct QueueRoundTripThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::ThreadParameters mThreadParams;
+		EA::Thread::Thread           mThread;
+		Queue*                       mpOutgoing;
+		Queue*                       mpIncoming;
+		EA::StdC::Stopwatch*         mpStopwatch; // Non-NULL for the sender, which times the round trips.
+		uint32_t                     mnCount;
+		uint32_t                     mnSum;
+
+		QueueRoundTripThread() : mThreadParams(), mThread(), mpOutgoing(NULL), mpIncoming(NULL), mpStopwatch(NULL), mnCount(0), mnSum(0) {}
+		QueueRoundTripThread(const QueueRoundTripThread&) = delete;
+		void operator=(const QueueRoundTripThread&) = delete;
+
+		intptr_t Run(void*) override
+		{
+			uint32_t value = 0;
+
+			if(mpStopwatch)
+				mpStopwatch->Restart();
+
+			for(uint32_t i = 0; i < mnCount; i++)
+			{
+				if(mpStopwatch)
+				{
+					while(!mpOutgoing->try_push(i))
+						EA::Thread::ThreadSleep(0);
+					while(!mpIncoming->try_pop(value))
+						EA::Thread::ThreadSleep(0);
+					mnSum += value;
+				}
+				else
+				{
+					while(!mpIncoming->try_pop(value))
+						EA::Thread::ThreadSleep(0);
+					while(!mpOutgoing->try_push(value))
+						EA::Thread::ThreadSleep(0);
+				}
+			}
+
+			if(mpStopwatch)
+				mpStopwatch->Stop();
+			return 0;
+		}
+	};
+
+
+	// Measures the latency of a round trip to another thread and back, one value at a time.
+	template <typename Queue>
+	void TestQueueRoundTrip(EA::StdC::Stopwatch& stopwatch, Queue& requests, Queue& replies, uint32_t nCount)
+	{
+		QueueRoundTripThread<Queue> sender, echo;
+
+		sender.mpOutgoing  = &requests;
+		sender.mpIncoming  = &replies;
+		sender.mpStopwatch = &stopwatch;
+		sender.mnCount     = nCount;
+		sender.mThreadParams.mpName = "QueueRoundTripThread";
+
+		echo.mpOutgoing = &replies;
+		echo.mpIncoming = &requests;
+		echo.mnCount    = nCount;
+		echo.mThreadParams.mpName = "QueueRoundTripThread";
+
+		echo.mThread.Begin(&echo, NULL, &echo.mThreadParams);
+		sender.mThread.Begin(&sender, NULL, &sender.mThreadParams);
+
+		sender.mThread.WaitForEnd();
+		echo.mThread.WaitForEnd();
+
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)sender.mnSum);
+	}
+
 } // namespace
 
 
@@ -318,6 +643,83 @@ void BenchmarkDeque()
 				Benchmark::AddResult("deque<ValuePair>/erase", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
 		}
 	}
+
+	{
+		// Passing uint32_t values between threads through a bounded queue. The std column is
+		// a ring_buffer guarded by one std::mutex; the EASTL column is spsc_ring_buffer when
+		// there is one producer and one consumer, and mpmc_bounded_queue otherwise. The total
+		// number of values is the same for each thread count.
+		const int      kThreadPairCounts[] = { 1, 2, 4, 8, 16 };
+		const uint32_t kTotalCount         = 200000;
+		const uint32_t kRoundTripCount     = 20000;
+		const uint32_t kCapacity           = 1024;
+		char name[96];
+
+		for(int i = 0; i < 2; i++)
+		{
+			{
+				MutexRingBuffer<uint32_t>           mutexQueue(kCapacity);
+				eastl::spsc_ring_buffer<uint32_t>   spscQueue(kCapacity);
+				eastl::mpmc_bounded_queue<uint32_t> mpmcQueue(kCapacity);
+
+				TestQueuePushPop(stopwatch1, mutexQueue, kTotalCount);
+				TestQueuePushPop(stopwatch2, spscQueue,  kTotalCount);
+
+				if(i == 1)
+					Benchmark::AddResult("spsc_ring_buffer<uint32_t>/push+pop/1 thread", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: ring_buffer with one mutex");
+
+				TestQueuePushPop(stopwatch1, mutexQueue, kTotalCount);
+				TestQueuePushPop(stopwatch2, mpmcQueue,  kTotalCount);
+
+				if(i == 1)
+					Benchmark::AddResult("mpmc_bounded_queue<uint32_t>/push+pop/1 thread", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: ring_buffer with one mutex");
+			}
+
+			for(uint32_t nBatchSize = 1; nBatchSize <= 32; nBatchSize *= 32)
+			{
+				MutexRingBuffer<uint32_t>         mutexQueue(kCapacity);
+				eastl::spsc_ring_buffer<uint32_t> spscQueue(kCapacity);
+
+				TestQueueThroughput(stopwatch1, mutexQueue, 1, 1, kTotalCount, nBatchSize);
+				TestQueueThroughput(stopwatch2, spscQueue,  1, 1, kTotalCount, nBatchSize);
+
+				if(i == 1)
+				{
+					EA::StdC::Snprintf(name, sizeof(name), "spsc_ring_buffer<uint32_t>/throughput/batch %u/2 threads", (unsigned)nBatchSize);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: ring_buffer with one mutex");
+				}
+
+				for(eastl_size_t t = 0; t < EAArrayCount(kThreadPairCounts); t++)
+				{
+					const int nPairCount = kThreadPairCounts[t];
+					MutexRingBuffer<uint32_t>           mutexQueue2(kCapacity);
+					eastl::mpmc_bounded_queue<uint32_t> mpmcQueue(kCapacity);
+
+					TestQueueThroughput(stopwatch1, mutexQueue2, nPairCount, nPairCount, kTotalCount, nBatchSize);
+					TestQueueThroughput(stopwatch2, mpmcQueue,   nPairCount, nPairCount, kTotalCount, nBatchSize);
+
+					if(i == 1)
+					{
+						EA::StdC::Snprintf(name, sizeof(name), "mpmc_bounded_queue<uint32_t>/throughput/batch %u/%d threads", (unsigned)nBatchSize, nPairCount * 2);
+						Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: ring_buffer with one mutex");
+					}
+				}
+			}
+
+			{
+				// Latency: one value at a time is sent to another thread, which sends it back.
+				MutexRingBuffer<uint32_t>         mutexRequests(kCapacity), mutexReplies(kCapacity);
+				eastl::spsc_ring_buffer<uint32_t> spscRequests(kCapacity),  spscReplies(kCapacity);
+
+				TestQueueRoundTrip(stopwatch1, mutexRequests, mutexReplies, kRoundTripCount);
+				TestQueueRoundTrip(stopwatch2, spscRequests,  spscReplies,  kRoundTripCount);
+
+				if(i == 1)
+					Benchmark::AddResult("spsc_ring_buffer<uint32_t>/round trip latency/2 threads", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: ring_buffer with one mutex");
+			}
+		}
+	}
+
 }
 
 
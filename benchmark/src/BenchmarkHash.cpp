@@ -8,8 +8,13 @@
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/vector.h>
 #include <EASTL/hash_map.h>
+#include <EASTL/flat_hash_map.h>
+#include <EASTL/concurrent_hash_map.h>
+#include <EASTL/string_hash_map.h>
 #include <EASTL/string.h>
 #include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+#include <eathread/eathread_thread.h>
 
 
 
@@ -17,6 +22,8 @@ EA_DISABLE_ALL_VC_WARNINGS()
 #include <unordered_map>
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <stdio.h>
 EA_RESTORE_ALL_VC_WARNINGS()
 
@@ -62,6 +69,86 @@ using StdMapStrUint32 = std::unordered_map<std::string, uint32_t, HashString8<st
 using EaMapUint32TO = eastl::hash_map<uint32_t, TestObject>;
 using EaMapStrUint32 = eastl::hash_map<eastl::string, uint32_t, HashString8<eastl::string>>;
 
+// Power2HashMap
+//
+// hash_map fixes its rehash policy, so we use hashtable directly to measure
+// power2_rehash_policy with mask_range_hashing against the default prime policy.
+//
+template <typename Key, typename T>
+class Power2HashMap
+	: public eastl::hashtable<Key, eastl::pair<const Key, T>, EASTLAllocatorType, eastl::use_first<eastl::pair<const Key, T>>, eastl::equal_to<Key>,
+							  eastl::hash<Key>, eastl::mask_range_hashing, eastl::default_ranged_hash, eastl::power2_rehash_policy, false, true, true>
+{
+public:
+	typedef eastl::hashtable<Key, eastl::pair<const Key, T>, EASTLAllocatorType, eastl::use_first<eastl::pair<const Key, T>>, eastl::equal_to<Key>,
+							 eastl::hash<Key>, eastl::mask_range_hashing, eastl::default_ranged_hash, eastl::power2_rehash_policy, false, true, true> base_type;
+
+	Power2HashMap()
+		: base_type(0, eastl::hash<Key>(), eastl::mask_range_hashing(), eastl::default_ranged_hash(), eastl::equal_to<Key>(), eastl::use_first<eastl::pair<const Key, T>>()) { }
+};
+
+
+// IncrementalHashMap
+//
+// hashtable with incremental_rehash_policy, whose per-insert latency is compared
+// against hash_map, which rehashes the whole table at once.
+//
+template <typename Key, typename T>
+class IncrementalHashMap
+	: public eastl::hashtable<Key, eastl::pair<const Key, T>, EASTLAllocatorType, eastl::use_first<eastl::pair<const Key, T>>, eastl::equal_to<Key>,
+							  eastl::hash<Key>, eastl::mod_range_hashing, eastl::default_ranged_hash, eastl::incremental_rehash_policy, false, true, true>
+{
+public:
+	typedef eastl::hashtable<Key, eastl::pair<const Key, T>, EASTLAllocatorType, eastl::use_first<eastl::pair<const Key, T>>, eastl::equal_to<Key>,
+							 eastl::hash<Key>, eastl::mod_range_hashing, eastl::default_ranged_hash, eastl::incremental_rehash_policy, false, true, true> base_type;
+
+	IncrementalHashMap()
+		: base_type(0, eastl::hash<Key>(), eastl::mod_range_hashing(), eastl::default_ranged_hash(), eastl::equal_to<Key>(), eastl::use_first<eastl::pair<const Key, T>>()) { }
+};
+
+
+// MutexHashMap
+//
+// A hash_map shared between threads by guarding it with a single mutex, which is
+// what concurrent_hash_map is measured against. It has the subset of the
+// concurrent_hash_map interface that the multithreaded benchmark uses.
+//
+template <typename Key, typename T>
+class MutexHashMap
+{
+public:
+	bool find(const Key& k, T& value) const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		typename eastl::hash_map<Key, T>::const_iterator it = mMap.find(k);
+
+		if(it == mMap.end())
+			return false;
+
+		value = it->second;
+		return true;
+	}
+
+	bool insert_or_assign(const Key& k, const T& value)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mMap.insert_or_assign(k, value).second;
+	}
+
+protected:
+	mutable std::mutex      mMutex;
+	eastl::hash_map<Key, T> mMap;
+};
+
+
+using StdMapUint32Uint32     = std::unordered_map<uint32_t, uint32_t>;
+using EaMapUint32Uint32      = eastl::hash_map<uint32_t, uint32_t>;
+using EaP2MapUint32Uint32    = Power2HashMap<uint32_t, uint32_t>;
+using EaFlatMapUint32Uint32  = eastl::flat_hash_map<uint32_t, uint32_t>;
+using EaIncMapUint32Uint32   = IncrementalHashMap<uint32_t, uint32_t>;
+using MutexMapUint32Uint32   = MutexHashMap<uint32_t, uint32_t>;
+using EaConcMapUint32Uint32  = eastl::concurrent_hash_map<uint32_t, uint32_t>;
+
 
 namespace
 {
@@ -74,6 +161,132 @@ namespace
 	}
 
 
+	template <typename Container, typename Value>
+	void TestInsertBulk(EA::StdC::Stopwatch& stopwatch, Container& c, const Value* pArrayBegin, const Value* pArrayEnd)
+	{
+		stopwatch.Restart();
+		c.insert_bulk(pArrayBegin, pArrayEnd);
+		stopwatch.Stop();
+	}
+
+
+	// Times each insert individually, and returns the sorted latencies in CPU cycles.
+	template <typename Container, typename Value>
+	void TestInsertLatency(Container& c, const Value* pArrayBegin, const Value* pArrayEnd, eastl::vector<uint64_t>& latencies)
+	{
+		latencies.clear();
+		latencies.reserve((eastl_size_t)(pArrayEnd - pArrayBegin)); // So that the timed loop doesn't allocate.
+
+		for(; pArrayBegin != pArrayEnd; ++pArrayBegin)
+		{
+			const uint64_t nStart = EA::StdC::Stopwatch::GetCPUCycle();
+			c.insert(*pArrayBegin);
+			latencies.push_back(EA::StdC::Stopwatch::GetCPUCycle() - nStart);
+		}
+
+		eastl::sort(latencies.begin(), latencies.end());
+	}
+
+
+	// Runs a mix of lookups and updates on a map shared with other threads. Each thread
+	// waits until all of the threads have started, so that they run at the same time.
+	template <typename Container>
+	struct SharedMapThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::ThreadParameters mThreadParams;
+		EA::Thread::Thread           mThread;
+		Container*                   mpContainer;
+		std::atomic<int>*            mpStartedCount;
+		int                          mnThreadCount;
+		uint32_t                     mnSeed;
+		uint32_t                     mnKeyCount;
+		uint32_t                     mnOpCount;
+		uint32_t                     mnFoundCount;
+
+		SharedMapThread() : mThreadParams(), mThread(), mpContainer(NULL), mpStartedCount(NULL), mnThreadCount(0), mnSeed(0), mnKeyCount(0), mnOpCount(0), mnFoundCount(0) {}
+		SharedMapThread(const SharedMapThread&) = delete;
+		void operator=(const SharedMapThread&) = delete;
+
+		intptr_t Run(void*) override
+		{
+			mpStartedCount->fetch_add(1);
+			while(mpStartedCount->load() < mnThreadCount)
+				EA::Thread::ThreadSleep(0);
+
+			uint32_t nRand = mnSeed | 1;
+			uint32_t value = 0;
+
+			for(uint32_t i = 0; i < mnOpCount; i++)
+			{
+				nRand ^= nRand << 13; nRand ^= nRand >> 17; nRand ^= nRand << 5; // xorshift32
+
+				const uint32_t k = nRand % mnKeyCount;
+
+				if((nRand >> 24) < 26) // About 10% of the operations are updates.
+					mpContainer->insert_or_assign(k, i);
+				else
+					mnFoundCount += mpContainer->find(k, value) ? 1 : 0;
+			}
+
+			return 0;
+		}
+	};
+
+
+	template <typename Container>
+	void TestSharedMapThreads(EA::StdC::Stopwatch& stopwatch, Container& c, int nThreadCount, uint32_t nKeyCount, uint32_t nOpCountPerThread)
+	{
+		eastl::vector<SharedMapThread<Container>> threads((eastl_size_t)nThreadCount);
+		std::atomic<int> nStartedCount(0);
+
+		for(int t = 0; t < nThreadCount; t++)
+		{
+			threads[t].mpContainer     = &c;
+			threads[t].mpStartedCount  = &nStartedCount;
+			threads[t].mnThreadCount   = nThreadCount;
+			threads[t].mnSeed          = (uint32_t)(t + 1) * UINT32_C(2654435761);
+			threads[t].mnKeyCount      = nKeyCount;
+			threads[t].mnOpCount       = nOpCountPerThread;
+			threads[t].mThreadParams.mpName = "SharedMapThread";
+		}
+
+		stopwatch.Restart();
+
+		for(int t = 0; t < nThreadCount; t++)
+			threads[t].mThread.Begin(&threads[t], NULL, &threads[t].mThreadParams);
+
+		uint32_t nFoundCount = 0;
+
+		for(int t = 0; t < nThreadCount; t++)
+		{
+			threads[t].mThread.WaitForEnd();
+			nFoundCount += threads[t].mnFoundCount;
+		}
+
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nFoundCount);
+	}
+
+
+	template <typename Container>
+	void TestFindLoop(EA::StdC::Stopwatch& stopwatch, Container& c, const uint32_t* pKeyBegin, const uint32_t* pKeyEnd, typename Container::iterator* pResults)
+	{
+		stopwatch.Restart();
+		while(pKeyBegin != pKeyEnd)
+			*pResults++ = c.find(*pKeyBegin++);
+		stopwatch.Stop();
+	}
+
+
+	template <typename Container>
+	void TestFindBatch(EA::StdC::Stopwatch& stopwatch, Container& c, const uint32_t* pKeyBegin, const uint32_t* pKeyEnd, typename Container::iterator* pResults)
+	{
+		stopwatch.Restart();
+		c.find_batch(pKeyBegin, (typename Container::size_type)(pKeyEnd - pKeyBegin), pResults);
+		stopwatch.Stop();
+	}
+
+
 	template <typename Container, typename Value>
 	void TestIteration(EA::StdC::Stopwatch& stopwatch, const Container& c, const Value& findValue)
 	{
@@ -227,6 +440,97 @@ namespace
 	}
 
 
+	// Runs insert, find and erase over nCount random keys for a std map and an EASTL map, adding a result for each.
+	template <typename StdContainer, typename EaContainer>
+	void BenchmarkInsertFindErase(EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2, const char* pName, eastl_size_t nCount,
+								  const eastl::vector< std::pair<uint32_t, uint32_t> >& stdVector, const eastl::vector< eastl::pair<uint32_t, uint32_t> >& eaVector)
+	{
+		char name[64];
+
+		for(int i = 0; i < 2; i++)
+		{
+			StdContainer stdMap;
+			EaContainer  eaMap;
+
+			TestInsert(stopwatch1, stdMap, stdVector.data(), stdVector.data() + nCount);
+			TestInsert(stopwatch2, eaMap,   eaVector.data(),  eaVector.data() + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/insert/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestFind(stopwatch1, stdMap, stdVector.data(), stdVector.data() + nCount);
+			TestFind(stopwatch2, eaMap,   eaVector.data(),  eaVector.data() + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/find/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestEraseValue(stopwatch1, stdMap, stdVector.data(), stdVector.data() + nCount);
+			TestEraseValue(stopwatch2, eaMap,   eaVector.data(),  eaVector.data() + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/erase val/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+		}
+	}
+
+
+	// Hashes every key in the container nRepeatCount times, accumulating the results so that the work can't be optimized away.
+	template <typename Hash, typename Container>
+	void TestHashKeys(EA::StdC::Stopwatch& stopwatch, const Container& c, int nRepeatCount)
+	{
+		Hash   hash;
+		size_t result = 0;
+
+		stopwatch.Restart();
+		for(int r = 0; r < nRepeatCount; r++)
+		{
+			for(typename Container::const_iterator it = c.begin(), itEnd = c.end(); it != itEnd; ++it)
+				result += hash(*it);
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)result);
+	}
+
+
+	// Inserts every name into every map, as when many tables are keyed on the same asset and tag names.
+	template <typename Container, typename Key>
+	void TestInsertNames(EA::StdC::Stopwatch& stopwatch, eastl::vector<Container>& maps, const eastl::vector<Key>& keys)
+	{
+		stopwatch.Restart();
+		for(eastl_size_t m = 0; m < maps.size(); m++)
+		{
+			for(eastl_size_t k = 0; k < keys.size(); k++)
+				maps[m].insert_or_assign(keys[k], (uint32_t)k);
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)maps.back().size());
+	}
+
+
+	template <typename Container, typename Key>
+	void TestFindNames(EA::StdC::Stopwatch& stopwatch, const Container& c, const eastl::vector<Key>& keys, int nRepeatCount)
+	{
+		uint32_t result = 0;
+
+		stopwatch.Restart();
+		for(int r = 0; r < nRepeatCount; r++)
+		{
+			for(eastl_size_t k = 0; k < keys.size(); k++)
+				result += c.find(keys[k])->second;
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)result);
+	}
+
+
 } // namespace
 
 
@@ -448,6 +752,250 @@ void BenchmarkHash()
 
 		}
 	}
+
+	{
+		// Compare the node-based hash_map with the open-addressing flat_hash_map as the
+		// element count grows past the cache sizes. The larger sizes only run at higher test levels.
+		eastl_size_t nMaxCount = 100000;
+
+		if(gEASTL_TestLevel >= kEASTL_TestLevelHigh)
+			nMaxCount = 10000000;
+		else if(gEASTL_TestLevel >= kEASTL_TestLevelLow)
+			nMaxCount = 1000000;
+
+		eastl::vector<   std::pair<uint32_t, uint32_t> > stdVectorUU(nMaxCount);
+		eastl::vector< eastl::pair<uint32_t, uint32_t> >  eaVectorUU(nMaxCount);
+
+		for(eastl_size_t i = 0; i < nMaxCount; i++)
+		{
+			const uint32_t n1 = rng.RandValue();
+			const uint32_t n2 = rng.RandValue();
+
+			stdVectorUU[i] =   std::pair<uint32_t, uint32_t>(n1, n2);
+			eaVectorUU[i]  = eastl::pair<uint32_t, uint32_t>(n1, n2);
+		}
+
+		for(eastl_size_t nCount = 1000; nCount <= nMaxCount; nCount *= 10)
+		{
+			BenchmarkInsertFindErase<StdMapUint32Uint32, EaMapUint32Uint32>    (stopwatch1, stopwatch2, "hash_map<uint32_t, uint32_t>",      nCount, stdVectorUU, eaVectorUU);
+			BenchmarkInsertFindErase<StdMapUint32Uint32, EaP2MapUint32Uint32>  (stopwatch1, stopwatch2, "hash_map<uint32_t, uint32_t>/power2", nCount, stdVectorUU, eaVectorUU);
+			BenchmarkInsertFindErase<StdMapUint32Uint32, EaFlatMapUint32Uint32>(stopwatch1, stopwatch2, "flat_hash_map<uint32_t, uint32_t>", nCount, stdVectorUU, eaVectorUU);
+
+			// Compare against the hash_map<uint32_t, uint32_t>/insert results above, which use insert(first, last).
+			for(int i = 0; i < 2; i++)
+			{
+				StdMapUint32Uint32 stdMap;
+				EaMapUint32Uint32  eaMap;
+
+				TestInsert(stopwatch1, stdMap, stdVectorUU.data(), stdVectorUU.data() + nCount);
+				TestInsertBulk(stopwatch2, eaMap, eaVectorUU.data(), eaVectorUU.data() + nCount);
+
+				if(i == 1)
+				{
+					char name[64];
+					EA::StdC::Snprintf(name, sizeof(name), "hash_map<uint32_t, uint32_t>/insert_bulk/%u", (unsigned)nCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+				}
+			}
+
+			// The find_loop and find_batch results look up the same keys, in the same order, with a loop of find calls and with find_batch.
+			{
+				StdMapUint32Uint32 stdMap(stdVectorUU.data(), stdVectorUU.data() + nCount);
+				EaMapUint32Uint32  eaMap(eaVectorUU.data(), eaVectorUU.data() + nCount);
+
+				eastl::vector<uint32_t> keys(nCount);
+				for(eastl_size_t k = 0; k < nCount; k++)
+					keys[k] = eaVectorUU[(k * 7919) % nCount].first; // Visit the keys in a different order than they were inserted.
+
+				eastl::vector<StdMapUint32Uint32::iterator> stdResults(nCount);
+				eastl::vector<EaMapUint32Uint32::iterator>  eaResults(nCount);
+
+				for(int i = 0; i < 2; i++)
+				{
+					char name[64];
+
+					TestFindLoop(stopwatch1, stdMap, keys.data(), keys.data() + nCount, stdResults.data());
+					TestFindLoop(stopwatch2, eaMap,  keys.data(), keys.data() + nCount, eaResults.data());
+
+					if(i == 1)
+					{
+						EA::StdC::Snprintf(name, sizeof(name), "hash_map<uint32_t, uint32_t>/find_loop/%u", (unsigned)nCount);
+						Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+					}
+
+					TestFindLoop(stopwatch1, stdMap, keys.data(), keys.data() + nCount, stdResults.data());
+					TestFindBatch(stopwatch2, eaMap, keys.data(), keys.data() + nCount, eaResults.data());
+
+					if(i == 1)
+					{
+						EA::StdC::Snprintf(name, sizeof(name), "hash_map<uint32_t, uint32_t>/find_batch/%u", (unsigned)nCount);
+						Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+					}
+				}
+			}
+		}
+
+		// Per-insert latency percentiles while a table grows from empty, which shows the cost of the
+		// inserts that trigger a rehash. The std column here is hash_map, which rehashes all at once,
+		// and the EASTL column is hashtable with incremental_rehash_policy.
+		const eastl_size_t kLatencyCounts[] = { 100000, 1000000, 5000000 };
+
+		for(eastl_size_t c = 0; (c < EAArrayCount(kLatencyCounts)) && (kLatencyCounts[c] <= nMaxCount); c++)
+		{
+			const eastl_size_t nCount = kLatencyCounts[c];
+			eastl::vector<uint64_t> latencies1, latencies2;
+
+			for(int i = 0; i < 2; i++)
+			{
+				EaMapUint32Uint32    eaMap;
+				EaIncMapUint32Uint32 eaIncMap;
+
+				TestInsertLatency(eaMap,    eaVectorUU.data(), eaVectorUU.data() + nCount, latencies1);
+				TestInsertLatency(eaIncMap, eaVectorUU.data(), eaVectorUU.data() + nCount, latencies2);
+			}
+
+			const struct { const char* pName; double fPercentile; } kPercentiles[] =
+				{ { "p50", 0.5 }, { "p99", 0.99 }, { "p99.9", 0.999 }, { "p99.99", 0.9999 }, { "max", 1.0 } };
+
+			for(eastl_size_t p = 0; p < EAArrayCount(kPercentiles); p++)
+			{
+				const eastl_size_t nIndex = eastl::min_alt((eastl_size_t)(kPercentiles[p].fPercentile * nCount), nCount - 1);
+				char name[64];
+
+				EA::StdC::Snprintf(name, sizeof(name), "hash_map<uint32_t, uint32_t>/insert latency %s/%u", kPercentiles[p].pName, (unsigned)nCount);
+				Benchmark::AddResult(name, EA::StdC::Stopwatch::kUnitsCPUCycles, (int64_t)latencies1[nIndex], (int64_t)latencies2[nIndex],
+									 "std: prime_rehash_policy, EASTL: incremental_rehash_policy");
+			}
+		}
+	}
+
+	{
+		// String hashing throughput per key length. The std column is std::hash<std::string>; the EASTL
+		// column is the default (FNV1, unless EASTL_STRING_HASH_FAST is enabled) hash and fast_string_hash.
+		const eastl_size_t kKeyLengths[] = { 4, 8, 16, 32, 64, 256, 1024 };
+		const eastl_size_t kKeyCount     = 256;
+
+		for(eastl_size_t l = 0; l < EAArrayCount(kKeyLengths); l++)
+		{
+			const eastl_size_t nLength = kKeyLengths[l];
+			const int nRepeatCount     = (int)(65536 / nLength);   // Hash about the same number of bytes for each length.
+
+			eastl::vector<std::string>   stdKeys(kKeyCount);
+			eastl::vector<eastl::string> eaKeys(kKeyCount);
+
+			for(eastl_size_t k = 0; k < kKeyCount; k++)
+			{
+				eaKeys[k].resize(nLength);
+				for(eastl_size_t c = 0; c < nLength; c++)
+					eaKeys[k][c] = (char)('!' + rng.RandLimit(90));
+				stdKeys[k].assign(eaKeys[k].data(), eaKeys[k].size());
+			}
+
+			char name[64];
+
+			for(int i = 0; i < 2; i++)
+			{
+				TestHashKeys< std::hash<std::string> >(stopwatch1, stdKeys, nRepeatCount);
+				TestHashKeys< eastl::hash<eastl::string> >(stopwatch2, eaKeys, nRepeatCount);
+
+				if(i == 1)
+				{
+					EA::StdC::Snprintf(name, sizeof(name), "hash<string>/%u", (unsigned)nLength);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+				}
+
+				TestHashKeys< std::hash<std::string> >(stopwatch1, stdKeys, nRepeatCount);
+				TestHashKeys< eastl::fast_string_hash >(stopwatch2, eaKeys, nRepeatCount);
+
+				if(i == 1)
+				{
+					EA::StdC::Snprintf(name, sizeof(name), "fast_string_hash/%u", (unsigned)nLength);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+				}
+			}
+		}
+	}
+
+	{
+		// Throughput of a map shared by several threads, with 90% lookups and 10% updates over a
+		// fixed set of keys. The std column is a hash_map guarded by one std::mutex; the EASTL
+		// column is concurrent_hash_map. The total number of operations is the same for each
+		// thread count, so with enough cores the EASTL time should fall as threads are added.
+		const int      kThreadCounts[] = { 1, 2, 4, 8, 16, 32 };
+		const uint32_t kKeyCount       = 100000;
+		const uint32_t kTotalOpCount   = 1600000;
+
+		for(eastl_size_t t = 0; t < EAArrayCount(kThreadCounts); t++)
+		{
+			const int nThreadCount = kThreadCounts[t];
+
+			for(int i = 0; i < 2; i++)
+			{
+				MutexMapUint32Uint32  mutexMap;
+				EaConcMapUint32Uint32 concurrentMap;
+
+				for(uint32_t k = 0; k < kKeyCount; k += 2) // Half of the lookups find their key.
+				{
+					mutexMap.insert_or_assign(k, k);
+					concurrentMap.insert_or_assign(k, k);
+				}
+
+				TestSharedMapThreads(stopwatch1, mutexMap,      nThreadCount, kKeyCount, kTotalOpCount / (uint32_t)nThreadCount);
+				TestSharedMapThreads(stopwatch2, concurrentMap, nThreadCount, kKeyCount, kTotalOpCount / (uint32_t)nThreadCount);
+
+				if(i == 1)
+				{
+					char name[64];
+					EA::StdC::Snprintf(name, sizeof(name), "concurrent_hash_map<uint32_t, uint32_t>/90%% find/%d threads", nThreadCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(),
+										 "std: hash_map with one mutex");
+				}
+			}
+		}
+	}
+
+	{
+		// Asset and tag names shared between many tables. string_hash_map copies, hashes and
+		// compares the characters of each key; interned_string_hash_map keys share one copy
+		// of each name in a string_pool and compare by pointer with a precomputed hash.
+		const int kMapCount = 16;
+		eastl::vector<eastl::string> names;
+		eastl::vector<const char*>   namePointers;
+
+		for(uint32_t n = 0; n < 4000; n++)
+			names.push_back(eastl::string(eastl::string::CtorSprintf(), "asset/texture/environment/rock_%u_%u.dds", (unsigned)rng.RandValue(), (unsigned)n));
+		for(eastl_size_t n = 0; n < names.size(); n++)
+			namePointers.push_back(names[n].c_str());
+
+		for(int i = 0; i < 2; i++)
+		{
+			eastl::string_pool pool;
+			eastl::vector<eastl::interned_string> internedNames;
+
+			for(eastl_size_t n = 0; n < names.size(); n++)
+				internedNames.push_back(pool.intern(names[n]));
+
+			eastl::vector< eastl::string_hash_map<uint32_t> > stringMaps(kMapCount);
+			eastl::vector< eastl::interned_string_hash_map<uint32_t> > internedMaps;
+
+			for(int m = 0; m < kMapCount; m++)
+				internedMaps.push_back(eastl::interned_string_hash_map<uint32_t>(pool));
+
+			TestInsertNames(stopwatch1, stringMaps,   namePointers);
+			TestInsertNames(stopwatch2, internedMaps, internedNames);
+
+			if(i == 1)
+				Benchmark::AddResult("interned_string_hash_map/insert", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(),
+									 "std: string_hash_map");
+
+			TestFindNames(stopwatch1, stringMaps[0],   namePointers,  100);
+			TestFindNames(stopwatch2, internedMaps[0], internedNames, 100);
+
+			if(i == 1)
+				Benchmark::AddResult("interned_string_hash_map/find", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(),
+									 "std: string_hash_map");
+		}
+	}
 }
 
 
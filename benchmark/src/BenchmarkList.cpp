@@ -10,6 +10,10 @@
 #include <EASTL/vector.h>
 #include <EASTL/algorithm.h>
 #include <EASTL/random.h>
+#include <EASTL/map.h>
+#include <EASTL/size_class_allocator.h>
+#include <EASTL/stats_allocator.h>
+#include <eathread/eathread_thread.h>
 
 #ifdef _MSC_VER
 	#pragma warning(push, 0)
@@ -17,6 +21,7 @@
 	#pragma warning(disable: 4350) // behavior change: X called instead of Y
 #endif
 #include <list>
+#include <atomic>
 #ifdef _MSC_VER
 	#pragma warning(pop)
 #endif
@@ -170,6 +175,81 @@ namespace
 		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.back().mX);
 	}
 
+
+	// Builds and tears down a list and a map over and over, as threads processing independent
+	// jobs do with their node containers. Each thread waits until all of the threads have
+	// started, so that they run at the same time.
+	template <typename List, typename Map>
+	struct NodeChurnThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::ThreadParameters mThreadParams;
+		EA::Thread::Thread           mThread;
+		std::atomic<int>*            mpStartedCount;
+		int                          mnThreadCount;
+		int                          mnRoundCount;
+		uint32_t                     mnResult;
+
+		NodeChurnThread() : mThreadParams(), mThread(), mpStartedCount(NULL), mnThreadCount(0), mnRoundCount(0), mnResult(0) {}
+		NodeChurnThread(const NodeChurnThread&) = delete;
+		void operator=(const NodeChurnThread&) = delete;
+
+		intptr_t Run(void*) override
+		{
+			mpStartedCount->fetch_add(1);
+			while(mpStartedCount->load() < mnThreadCount)
+				EA::Thread::ThreadSleep(0);
+
+			for(int r = 0; r < mnRoundCount; r++)
+			{
+				List l;
+				Map  m;
+
+				for(uint32_t i = 0; i < 256; i++)
+				{
+					l.push_back(i);
+					m[(i * 2654435761u) >> 8] = i;
+				}
+
+				mnResult += (uint32_t)l.size() + (uint32_t)m.size();
+			}
+
+			return 0;
+		}
+	};
+
+
+	template <typename List, typename Map>
+	void TestNodeChurnThreads(EA::StdC::Stopwatch& stopwatch, int nThreadCount, int nRoundCountPerThread)
+	{
+		eastl::vector< NodeChurnThread<List, Map> > threads((eastl_size_t)nThreadCount);
+		std::atomic<int> nStartedCount(0);
+
+		for(int t = 0; t < nThreadCount; t++)
+		{
+			threads[t].mpStartedCount = &nStartedCount;
+			threads[t].mnThreadCount  = nThreadCount;
+			threads[t].mnRoundCount   = nRoundCountPerThread;
+			threads[t].mThreadParams.mpName = "NodeChurnThread";
+		}
+
+		stopwatch.Restart();
+
+		for(int t = 0; t < nThreadCount; t++)
+			threads[t].mThread.Begin(&threads[t], NULL, &threads[t].mThreadParams);
+
+		uint32_t nResult = 0;
+
+		for(int t = 0; t < nThreadCount; t++)
+		{
+			threads[t].mThread.WaitForEnd();
+			nResult += threads[t].mnResult;
+		}
+
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nResult);
+	}
+
+
 } // namespace
 
 
@@ -357,6 +437,88 @@ void BenchmarkList()
 				Benchmark::AddResult("list<TestObject>/erase", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
 		}
 	}
+
+	{
+		// Node allocation from many threads at once. The std column uses the default allocator,
+		// which is the global heap; the EASTL column uses size_class_allocator. The total work is
+		// the same for each thread count, so with enough cores the time should fall as threads
+		// are added unless the allocator contends.
+		typedef eastl::list<uint32_t>                                                          HeapList;
+		typedef eastl::map<uint32_t, uint32_t>                                                 HeapMap;
+		typedef eastl::list<uint32_t, eastl::size_class_allocator>                             SizeClassList;
+		typedef eastl::map<uint32_t, uint32_t, eastl::less<uint32_t>, eastl::size_class_allocator> SizeClassMap;
+
+		const int kThreadCounts[]  = { 1, 2, 4, 8, 16, 32 };
+		const int kTotalRoundCount = 3200;
+
+		for(eastl_size_t t = 0; t < EAArrayCount(kThreadCounts); t++)
+		{
+			const int nThreadCount = kThreadCounts[t];
+
+			for(int i = 0; i < 2; i++)
+			{
+				TestNodeChurnThreads<HeapList, HeapMap>(stopwatch1, nThreadCount, kTotalRoundCount / nThreadCount);
+				TestNodeChurnThreads<SizeClassList, SizeClassMap>(stopwatch2, nThreadCount, kTotalRoundCount / nThreadCount);
+
+				if(i == 1)
+				{
+					char name[64];
+					EA::StdC::Snprintf(name, sizeof(name), "size_class_allocator/list+map churn/%d threads", nThreadCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(),
+										 "std: eastl::allocator");
+				}
+			}
+		}
+	}
+
+	{
+		// The cost of recording allocation statistics, with the cheap and the detailed stats_allocator.
+		// The std column uses the default allocator directly. The threads all record into the same
+		// "EASTL list" and "EASTL map" statistics, so this also shows the cost of sharing the counters.
+		typedef eastl::stats_allocator<EASTLAllocatorType, false>                            CheapStatsAllocator;
+		typedef eastl::stats_allocator<EASTLAllocatorType, true>                             DetailedStatsAllocator;
+		typedef eastl::list<uint32_t>                                                        HeapList;
+		typedef eastl::map<uint32_t, uint32_t>                                               HeapMap;
+		typedef eastl::list<uint32_t, CheapStatsAllocator>                                   CheapStatsList;
+		typedef eastl::map<uint32_t, uint32_t, eastl::less<uint32_t>, CheapStatsAllocator>    CheapStatsMap;
+		typedef eastl::list<uint32_t, DetailedStatsAllocator>                                DetailedStatsList;
+		typedef eastl::map<uint32_t, uint32_t, eastl::less<uint32_t>, DetailedStatsAllocator> DetailedStatsMap;
+
+		const int kThreadCounts[]  = { 1, 8 };
+		const int kTotalRoundCount = 3200;
+
+		for(eastl_size_t t = 0; t < EAArrayCount(kThreadCounts); t++)
+		{
+			const int nThreadCount = kThreadCounts[t];
+			char name[64];
+
+			for(int i = 0; i < 2; i++)
+			{
+				TestNodeChurnThreads<HeapList, HeapMap>(stopwatch1, nThreadCount, kTotalRoundCount / nThreadCount);
+				TestNodeChurnThreads<CheapStatsList, CheapStatsMap>(stopwatch2, nThreadCount, kTotalRoundCount / nThreadCount);
+
+				if(i == 1)
+				{
+					EA::StdC::Snprintf(name, sizeof(name), "stats_allocator/list+map churn/%d threads", nThreadCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(),
+										 "std: eastl::allocator");
+				}
+			}
+
+			for(int i = 0; i < 2; i++)
+			{
+				TestNodeChurnThreads<HeapList, HeapMap>(stopwatch1, nThreadCount, kTotalRoundCount / nThreadCount);
+				TestNodeChurnThreads<DetailedStatsList, DetailedStatsMap>(stopwatch2, nThreadCount, kTotalRoundCount / nThreadCount);
+
+				if(i == 1)
+				{
+					EA::StdC::Snprintf(name, sizeof(name), "stats_allocator<detailed>/list+map churn/%d threads", nThreadCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(),
+										 "std: eastl::allocator");
+				}
+			}
+		}
+	}
 }
 
 
@@ -7,6 +7,10 @@
 #include "EASTLTest.h"
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/map.h>
+#include <EASTL/fixed_map.h>
+#include <EASTL/arena_allocator.h>
+#include <EASTL/list.h>
+#include <EASTL/btree_map.h>
 #include <EASTL/vector.h>
 #include <EASTL/algorithm.h>
 
@@ -22,6 +26,15 @@ using namespace EA;
 typedef std::map<TestObject, uint32_t>     StdMapTOUint32;
 typedef eastl::map<TestObject, uint32_t>   EaMapTOUint32;
 
+typedef eastl::map<uint32_t, uint32_t>                                                   EaMapUint32Uint32;
+typedef eastl::btree_map<uint32_t, uint32_t>                                             EaBTreeMapUint32Uint32;
+typedef eastl::map<uint32_t, uint32_t, eastl::less<uint32_t>, CountingAllocator>         EaCountingMapUint32Uint32;
+typedef eastl::map<uint32_t, uint32_t, eastl::less<uint32_t>, eastl::arena_allocator>    EaArenaMapUint32Uint32;
+typedef eastl::btree_map<uint32_t, uint32_t, eastl::less<uint32_t>, CountingAllocator>   EaCountingBTreeMapUint32Uint32;
+
+typedef eastl::fixed_map<uint32_t, uint32_t, 64, true>                                                                  EaFixedMapUint32Uint32;
+typedef eastl::fixed_map<uint32_t, uint32_t, 64, true, eastl::less<uint32_t>, eastl::slab_overflow_allocator<> >       EaSlabFixedMapUint32Uint32;
+
 
 namespace
 {
@@ -197,6 +210,141 @@ namespace
 	}
 
 
+	// Returns the bytes of memory a container allocates per element for the given elements.
+	template <typename Container, typename Value>
+	uint64_t MeasureBytesPerElement(const Value* pArrayBegin, const Value* pArrayEnd)
+	{
+		CountingAllocator::resetCount();
+		Container c(pArrayBegin, pArrayEnd);
+		return c.empty() ? 0 : (CountingAllocator::getActiveAllocationSize() / (uint64_t)c.size());
+	}
+
+
+	// Compares two ordered containers of the same interface, such as map and btree_map,
+	// with nCount elements. The first container's results are in the first column.
+	template <typename Container1, typename Container2, typename CountingContainer1, typename CountingContainer2, typename Value>
+	void BenchmarkTreeLayout(EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2, const char* pName, const Value* pArray, eastl_size_t nCount, const Value& highValue)
+	{
+		char name[64];
+
+		for(int i = 0; i < 2; i++)
+		{
+			Container1 c1;
+			Container2 c2;
+
+			TestInsert(stopwatch1, c1, pArray, pArray + nCount, highValue);
+			TestInsert(stopwatch2, c2, pArray, pArray + nCount, highValue);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/insert/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestIteration(stopwatch1, c1, typename Container1::value_type(highValue.first + 1, 0));
+			TestIteration(stopwatch2, c2, typename Container2::value_type(highValue.first + 1, 0));
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/iteration/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestFind(stopwatch1, c1, pArray, pArray + nCount);
+			TestFind(stopwatch2, c2, pArray, pArray + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/find/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestLowerBound(stopwatch1, c1, pArray, pArray + nCount);
+			TestLowerBound(stopwatch2, c2, pArray, pArray + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/lower_bound/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestEraseValue(stopwatch1, c1, pArray, pArray + nCount);
+			TestEraseValue(stopwatch2, c2, pArray, pArray + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/erase/key/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+		}
+
+		// The memory use is reported in the time columns, as bytes rather than cycles.
+		EA::StdC::Snprintf(name, sizeof(name), "%s/bytes per element/%u", pName, (unsigned)nCount);
+		Benchmark::AddResult(name, stopwatch1.GetUnits(), (int64_t)MeasureBytesPerElement<CountingContainer1>(pArray, pArray + nCount),
+							 (int64_t)MeasureBytesPerElement<CountingContainer2>(pArray, pArray + nCount), "Bytes allocated per element, not time.");
+	}
+
+
+	// Builds and tears down a map, a list and a vector per request, as a request handler does
+	// with its scratch containers. With an arena, the arena is made the default for the duration
+	// of the request and reset afterwards, so the containers are default-constructed as usual.
+	template <typename Map, typename List, typename Vector>
+	void TestRequestContainers(EA::StdC::Stopwatch& stopwatch, eastl::arena* pArena, const uint32_t* pKeys, int nRequestCount, int nRequestSize)
+	{
+		uint32_t result = 0;
+
+		stopwatch.Restart();
+		for(int r = 0; r < nRequestCount; r++)
+		{
+			eastl::arena* const pPrevArena = eastl::SetDefaultArena(pArena);
+			{
+				Map    m;
+				List   l;
+				Vector v;
+
+				for(int i = 0; i < nRequestSize; i++)
+				{
+					const uint32_t key = pKeys[(r + i) & 0xffff];
+					m[key] = (uint32_t)i;
+					l.push_back(key);
+					v.push_back(key);
+				}
+
+				result += (uint32_t)m.size() + l.back() + v[v.size() / 2];
+			}
+			eastl::SetDefaultArena(pPrevArena);
+
+			if(pArena)
+				pArena->reset();
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)result);
+	}
+
+
+	// Fills a fixed_map well past its fixed capacity, looks every key up and clears it again.
+	template <typename FixedMap>
+	void TestFixedMapOverflow(EA::StdC::Stopwatch& stopwatch, const uint32_t* pKeys, int nCount, int nRepeatCount)
+	{
+		uint32_t result = 0;
+		FixedMap m;
+
+		stopwatch.Restart();
+		for(int r = 0; r < nRepeatCount; r++)
+		{
+			for(int i = 0; i < nCount; i++)
+				m[pKeys[i]] = (uint32_t)i;
+
+			for(int i = 0; i < nCount; i++)
+				result += m.find(pKeys[i])->second;
+
+			m.clear();
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)result);
+	}
+
+
 } // namespace
 
 
@@ -364,6 +512,81 @@ void BenchmarkMap()
 
 		}
 	}
+
+	{
+		// Compare map with btree_map as the element count grows past the cache sizes. Both columns
+		// are EASTL containers here, so that the comparison is of the tree layouts alone: the first
+		// column is map and the second is btree_map. The larger sizes only run at higher test levels.
+		eastl_size_t nMaxCount = 100000;
+
+		if(gEASTL_TestLevel >= kEASTL_TestLevelHigh)
+			nMaxCount = 10000000;
+		else if(gEASTL_TestLevel >= kEASTL_TestLevelLow)
+			nMaxCount = 1000000;
+
+		eastl::vector< eastl::pair<uint32_t, uint32_t> > eaVectorUU(nMaxCount);
+
+		for(eastl_size_t i = 0; i < nMaxCount; i++)
+			eaVectorUU[i] = eastl::pair<uint32_t, uint32_t>(rng.RandLimit(0x7fffffff), rng.RandValue());
+
+		const eastl::pair<uint32_t, uint32_t> eaHighValue(0x7fffffff, 0x7fffffff);
+
+		for(eastl_size_t nCount = 1000; nCount <= nMaxCount; nCount *= 10)
+		{
+			BenchmarkTreeLayout<EaMapUint32Uint32, EaBTreeMapUint32Uint32, EaCountingMapUint32Uint32, EaCountingBTreeMapUint32Uint32>
+				(stopwatch1, stopwatch2, "btree_map<uint32_t, uint32_t>", eaVectorUU.data(), nCount, eaHighValue);
+		}
+	}
+
+	{
+		// Per-request scratch containers, built and torn down with the default allocator and with an arena.
+		eastl::vector<uint32_t> keys(0x10000);
+
+		for(eastl_size_t i = 0; i < keys.size(); i++)
+			keys[i] = rng.RandValue();
+
+		for(int nRequestSize = 16; nRequestSize <= 1024; nRequestSize *= 8)
+		{
+			for(int i = 0; i < 2; i++)
+			{
+				eastl::arena arena;
+
+				TestRequestContainers<EaMapUint32Uint32, eastl::list<uint32_t>, eastl::vector<uint32_t> >(stopwatch1, NULL, keys.data(), 65536 / nRequestSize, nRequestSize);
+				TestRequestContainers<EaArenaMapUint32Uint32, eastl::list<uint32_t, eastl::arena_allocator>, eastl::vector<uint32_t, eastl::arena_allocator> >(stopwatch2, &arena, keys.data(), 65536 / nRequestSize, nRequestSize);
+
+				if(i == 1)
+				{
+					char name[64];
+					EA::StdC::Snprintf(name, sizeof(name), "arena_allocator/map+list+vector build,teardown/%d", nRequestSize);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: eastl::allocator");
+				}
+			}
+		}
+	}
+
+	{
+		// fixed_map overflowing its 64 fixed nodes, into the overflow allocator node by node and into slabs.
+		eastl::vector<uint32_t> keys(0x10000);
+
+		for(eastl_size_t i = 0; i < keys.size(); i++)
+			keys[i] = rng.RandValue();
+
+		for(int nCount = 256; nCount <= 65536; nCount *= 16)
+		{
+			for(int i = 0; i < 2; i++)
+			{
+				TestFixedMapOverflow<EaFixedMapUint32Uint32>(stopwatch1, keys.data(), nCount, 262144 / nCount);
+				TestFixedMapOverflow<EaSlabFixedMapUint32Uint32>(stopwatch2, keys.data(), nCount, 262144 / nCount);
+
+				if(i == 1)
+				{
+					char name[64];
+					EA::StdC::Snprintf(name, sizeof(name), "fixed_map<uint32_t, uint32_t, 64>/overflow insert,find,clear/%d", nCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: fixed_pool_with_overflow");
+				}
+			}
+		}
+	}
 }
 
 
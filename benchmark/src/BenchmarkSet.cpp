@@ -7,6 +7,7 @@
 #include "EASTLTest.h"
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/set.h>
+#include <EASTL/btree_set.h>
 #include <EASTL/vector.h>
 #include <EASTL/algorithm.h>
 
@@ -22,6 +23,10 @@ using namespace EA;
 typedef std::set<uint32_t>     StdSetUint32;
 typedef eastl::set<uint32_t>   EaSetUint32;
 
+typedef eastl::btree_set<uint32_t>                                             EaBTreeSetUint32;
+typedef eastl::set<uint32_t, eastl::less<uint32_t>, CountingAllocator>         EaCountingSetUint32;
+typedef eastl::btree_set<uint32_t, eastl::less<uint32_t>, CountingAllocator>   EaCountingBTreeSetUint32;
+
 
 namespace
 {
@@ -189,6 +194,140 @@ namespace
 	}
 
 
+	// Returns the bytes of memory a container allocates per element for the given elements.
+	template <typename Container>
+	uint64_t MeasureBytesPerElement(const uint32_t* pArrayBegin, const uint32_t* pArrayEnd)
+	{
+		CountingAllocator::resetCount();
+		Container c(pArrayBegin, pArrayEnd);
+		return c.empty() ? 0 : (CountingAllocator::getActiveAllocationSize() / (uint64_t)c.size());
+	}
+
+
+	// Compares two ordered containers of the same interface, such as set and btree_set,
+	// with nCount elements. The first container's results are in the first column.
+	template <typename Container1, typename Container2, typename CountingContainer1, typename CountingContainer2>
+	void BenchmarkTreeLayout(EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2, const char* pName, const uint32_t* pArray, eastl_size_t nCount)
+	{
+		char name[64];
+
+		for(int i = 0; i < 2; i++)
+		{
+			Container1 c1;
+			Container2 c2;
+
+			TestInsert(stopwatch1, c1, pArray, pArray + nCount);
+			TestInsert(stopwatch2, c2, pArray, pArray + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/insert/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestIteration(stopwatch1, c1);
+			TestIteration(stopwatch2, c2);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/iteration/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestFind(stopwatch1, c1, pArray, pArray + nCount);
+			TestFind(stopwatch2, c2, pArray, pArray + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/find/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestLowerBound(stopwatch1, c1, pArray, pArray + nCount);
+			TestLowerBound(stopwatch2, c2, pArray, pArray + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/lower_bound/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			TestEraseValue(stopwatch1, c1, pArray, pArray + nCount);
+			TestEraseValue(stopwatch2, c2, pArray, pArray + nCount);
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "%s/erase/val/%u", pName, (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+		}
+
+		// The memory use is reported in the time columns, as bytes rather than cycles.
+		EA::StdC::Snprintf(name, sizeof(name), "%s/bytes per element/%u", pName, (unsigned)nCount);
+		Benchmark::AddResult(name, stopwatch1.GetUnits(), (int64_t)MeasureBytesPerElement<CountingContainer1>(pArray, pArray + nCount),
+							 (int64_t)MeasureBytesPerElement<CountingContainer2>(pArray, pArray + nCount), "Bytes allocated per element, not time.");
+	}
+
+
+#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+	// Compares percentile-style queries done with a linear walk (first column) against
+	// the order statistics of the tree (second column), on the same set.
+	void BenchmarkOrderStatistics(EA::StdC::Stopwatch& stopwatch1, EA::StdC::Stopwatch& stopwatch2, const uint32_t* pArray, eastl_size_t nCount)
+	{
+		const eastl_size_t kQueryCount = 1000;
+		char name[64];
+
+		EaSetUint32 c(pArray, pArray + nCount);
+		eastl::vector<EaSetUint32::const_iterator> queryIterators;
+		eastl::vector<eastl_size_t>                queryPositions;
+
+		for(eastl_size_t i = 0; i < kQueryCount; i++)
+		{
+			queryPositions.push_back((i * c.size()) / kQueryCount);
+			queryIterators.push_back(c.lower_bound(pArray[(i * 7919) % nCount]));
+		}
+
+		for(int i = 0; i < 2; i++)
+		{
+			uint32_t temp = 0;
+
+			stopwatch1.Restart();
+			for(eastl_size_t q = 0; q < kQueryCount; q++)
+				temp += *eastl::next(c.cbegin(), (ptrdiff_t)queryPositions[q]);
+			stopwatch1.Stop();
+
+			stopwatch2.Restart();
+			for(eastl_size_t q = 0; q < kQueryCount; q++)
+				temp += *c.nth(queryPositions[q]);
+			stopwatch2.Stop();
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "set<uint32_t>/nth/%u", (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "next(begin(), n) vs nth(n)");
+			}
+
+			stopwatch1.Restart();
+			for(eastl_size_t q = 0; q < kQueryCount; q++)
+				temp += (uint32_t)eastl::distance(c.cbegin(), queryIterators[q]);
+			stopwatch1.Stop();
+
+			stopwatch2.Restart();
+			for(eastl_size_t q = 0; q < kQueryCount; q++)
+				temp += (uint32_t)c.rank(queryIterators[q]);
+			stopwatch2.Stop();
+
+			if(i == 1)
+			{
+				EA::StdC::Snprintf(name, sizeof(name), "set<uint32_t>/rank/%u", (unsigned)nCount);
+				Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "distance(begin(), it) vs rank(it)");
+			}
+
+			EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)temp);
+		}
+	}
+#endif
+
 } // namespace
 
 
@@ -335,19 +474,29 @@ void BenchmarkSet()
 
 		}
 	}
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
 
+	{
+		// Compare set with btree_set as the element count grows past the cache sizes. Both columns
+		// are EASTL containers here, so that the comparison is of the tree layouts alone: the first
+		// column is set and the second is btree_set. The larger sizes only run at higher test levels.
+		eastl_size_t nMaxCount = 100000;
+
+		if(gEASTL_TestLevel >= kEASTL_TestLevelHigh)
+			nMaxCount = 10000000;
+		else if(gEASTL_TestLevel >= kEASTL_TestLevelLow)
+			nMaxCount = 1000000;
+
+		eastl::vector<uint32_t> intVector(nMaxCount);
+		for(eastl_size_t i = 0; i < nMaxCount; i++)
+			intVector[i] = (uint32_t)rng.RandLimit(0x7fffffff);
+
+		for(eastl_size_t nCount = 1000; nCount <= nMaxCount; nCount *= 10)
+			BenchmarkTreeLayout<EaSetUint32, EaBTreeSetUint32, EaCountingSetUint32, EaCountingBTreeSetUint32>(stopwatch1, stopwatch2, "btree_set<uint32_t>", intVector.data(), nCount);
+
+		#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+			// The linear walk in the first column makes the larger sizes too slow to be worth running.
+			for(eastl_size_t nCount = 1000; nCount <= eastl::min_alt(nMaxCount, (eastl_size_t)100000); nCount *= 10)
+				BenchmarkOrderStatistics(stopwatch1, stopwatch2, intVector.data(), nCount);
+		#endif
+	}
+}
@@ -0,0 +1,524 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include <EAStdC/EAStopwatch.h>
+#include <EASTL/local_shared_ptr.h>
+#include <EASTL/map.h>
+#include <EASTL/memory_reclamation.h>
+#include <EASTL/shared_ptr.h>
+#include <EASTL/vector.h>
+#include <eathread/eathread_thread.h>
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+#endif
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+
+using namespace EA;
+
+
+namespace
+{
+	struct Snapshot
+	{
+		uint32_t mnVersion;
+		uint32_t mData[15];
+	};
+
+	typedef eastl::shared_ptr<Snapshot> SnapshotPtr;
+
+
+	SnapshotPtr LoadSnapshot(const SnapshotPtr& source)
+	{
+		return eastl::atomic_load(&source);
+	}
+
+	SnapshotPtr LoadSnapshot(const eastl::atomic_shared_ptr<Snapshot>& source)
+	{
+		return source.load();
+	}
+
+	void StoreSnapshot(SnapshotPtr& dest, SnapshotPtr value)
+	{
+		eastl::atomic_store(&dest, eastl::move(value));
+	}
+
+	void StoreSnapshot(eastl::atomic_shared_ptr<Snapshot>& dest, SnapshotPtr value)
+	{
+		dest.store(eastl::move(value));
+	}
+
+
+	// Loads the shared snapshot mnCount times. Each thread waits until all of the threads
+	// have started, so that they run at the same time.
+	template <typename Source>
+	struct SnapshotReaderThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::ThreadParameters mThreadParams;
+		EA::Thread::Thread           mThread;
+		const Source*                mpSource;
+		std::atomic<int>*            mpStartedCount;
+		int                          mnThreadCount;
+		uint32_t                     mnCount;
+		uint32_t                     mnSum;
+
+		SnapshotReaderThread() : mThreadParams(), mThread(), mpSource(NULL), mpStartedCount(NULL), mnThreadCount(0), mnCount(0), mnSum(0) {}
+		SnapshotReaderThread(const SnapshotReaderThread&) = delete;
+		void operator=(const SnapshotReaderThread&) = delete;
+
+		intptr_t Run(void*) override
+		{
+			mpStartedCount->fetch_add(1);
+			while(mpStartedCount->load() < mnThreadCount)
+				EA::Thread::ThreadSleep(0);
+
+			for(uint32_t i = 0; i < mnCount; i++)
+			{
+				const SnapshotPtr pSnapshot = LoadSnapshot(*mpSource);
+				mnSum += pSnapshot->mnVersion;
+			}
+
+			return 0;
+		}
+	};
+
+
+	// Replaces the shared snapshot until told to stop.
+	template <typename Source>
+	struct SnapshotWriterThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::ThreadParameters mThreadParams;
+		EA::Thread::Thread           mThread;
+		Source*                      mpSource;
+		std::atomic<bool>*           mpShouldContinue;
+
+		SnapshotWriterThread() : mThreadParams(), mThread(), mpSource(NULL), mpShouldContinue(NULL) {}
+		SnapshotWriterThread(const SnapshotWriterThread&) = delete;
+		void operator=(const SnapshotWriterThread&) = delete;
+
+		intptr_t Run(void*) override
+		{
+			for(uint32_t nVersion = 1; mpShouldContinue->load(std::memory_order_relaxed); nVersion++)
+			{
+				SnapshotPtr pSnapshot = eastl::make_shared<Snapshot>();
+				pSnapshot->mnVersion = nVersion;
+				StoreSnapshot(*mpSource, eastl::move(pSnapshot));
+				EA::Thread::ThreadSleep(0);
+			}
+
+			return 0;
+		}
+	};
+
+
+	// Measures the time for nReaderCount threads to each load the snapshot nCount times,
+	// optionally while another thread keeps replacing it.
+	template <typename Source>
+	void TestSnapshotReaders(EA::StdC::Stopwatch& stopwatch, Source& source, int nReaderCount, uint32_t nCount, bool bWithWriter)
+	{
+		eastl::vector<SnapshotReaderThread<Source>> readers((eastl_size_t)nReaderCount);
+		SnapshotWriterThread<Source>                 writer;
+		std::atomic<int>                             nStartedCount(0);
+		std::atomic<bool>                            bShouldContinue(true);
+
+		for(int t = 0; t < nReaderCount; t++)
+		{
+			readers[t].mpSource       = &source;
+			readers[t].mpStartedCount = &nStartedCount;
+			readers[t].mnThreadCount  = nReaderCount;
+			readers[t].mnCount        = nCount;
+			readers[t].mThreadParams.mpName = "SnapshotReaderThread";
+		}
+
+		writer.mpSource         = &source;
+		writer.mpShouldContinue = &bShouldContinue;
+		writer.mThreadParams.mpName = "SnapshotWriterThread";
+
+		stopwatch.Restart();
+
+		if(bWithWriter)
+			writer.mThread.Begin(&writer, NULL, &writer.mThreadParams);
+		for(int t = 0; t < nReaderCount; t++)
+			readers[t].mThread.Begin(&readers[t], NULL, &readers[t].mThreadParams);
+
+		uint32_t nSum = 0;
+
+		for(int t = 0; t < nReaderCount; t++)
+		{
+			readers[t].mThread.WaitForEnd();
+			nSum += readers[t].mnSum;
+		}
+
+		stopwatch.Stop();
+
+		if(bWithWriter)
+		{
+			bShouldContinue.store(false, std::memory_order_relaxed);
+			writer.mThread.WaitForEnd();
+		}
+
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nSum);
+	}
+
+
+	// Copies p into each element of the vector and then destroys the copies, which
+	// measures an increment and a decrement of the reference count per element.
+	template <typename SharedPtr>
+	void TestCopyDestroy(EA::StdC::Stopwatch& stopwatch, const SharedPtr& p, eastl::vector<SharedPtr>& v)
+	{
+		stopwatch.Restart();
+		for(eastl_size_t j = 0, jEnd = v.size(); j < jEnd; j++)
+			v[j] = p;
+		for(eastl_size_t j = 0, jEnd = v.size(); j < jEnd; j++)
+			v[j].reset();
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%d", p.use_count());
+	}
+
+
+	// Passes p by value down a chain of calls, which is a common source of reference
+	// count traffic.
+	template <typename SharedPtr>
+	EA_NO_INLINE uint32_t PassByValue(SharedPtr p, int nDepth)
+	{
+		return nDepth ? PassByValue(p, nDepth - 1) : p->mnVersion;
+	}
+
+	template <typename SharedPtr>
+	void TestPassByValue(EA::StdC::Stopwatch& stopwatch, const SharedPtr& p, uint32_t nCount)
+	{
+		uint32_t nSum = 0;
+
+		stopwatch.Restart();
+		for(uint32_t i = 0; i < nCount; i++)
+			nSum += PassByValue(p, 8);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nSum);
+	}
+
+
+
+	// A read-mostly map which readers search while a writer keeps changing it. Each
+	// source has a Reader, made once per reader thread, and an Update for the writer.
+	typedef eastl::map<int, int> SnapshotMap;
+
+	const int kSnapshotMapSize = 1000;
+
+	void InitSnapshotMap(SnapshotMap& m)
+	{
+		for(int i = 0; i < kSnapshotMapSize; i++)
+			m[i] = i;
+	}
+
+
+	// The writer changes the map in place, and readers lock it while they search.
+	struct LockedSnapshotMap
+	{
+		SnapshotMap mMap;
+		std::mutex  mMutex;
+
+		LockedSnapshotMap() { InitSnapshotMap(mMap); }
+
+		struct Reader
+		{
+			LockedSnapshotMap* mpSource;
+
+			explicit Reader(LockedSnapshotMap& source) : mpSource(&source) {}
+
+			int Find(int nKey)
+			{
+				std::lock_guard<std::mutex> lock(mpSource->mMutex);
+				SnapshotMap::const_iterator it = mpSource->mMap.find(nKey);
+				return (it != mpSource->mMap.end()) ? it->second : 0;
+			}
+		};
+
+		void Update(int nValue)
+		{
+			SnapshotMap copy(mMap); // Done by the other sources, so done here too for a fair comparison.
+			copy[nValue % kSnapshotMapSize] = nValue;
+
+			std::lock_guard<std::mutex> lock(mMutex);
+			mMap.swap(copy);
+		}
+	};
+
+
+	// The writer publishes a copy of the map, and retires the old one to an ebr_domain.
+	struct EbrSnapshotMap
+	{
+		std::atomic<SnapshotMap*> mpMap;
+		eastl::ebr_domain         mDomain;
+
+		EbrSnapshotMap() : mpMap(new SnapshotMap) { InitSnapshotMap(*mpMap.load()); }
+	   ~EbrSnapshotMap() { delete mpMap.load(); }
+
+		struct Reader
+		{
+			EbrSnapshotMap* mpSource;
+
+			explicit Reader(EbrSnapshotMap& source) : mpSource(&source) {}
+
+			int Find(int nKey)
+			{
+				eastl::ebr_domain::guard guard(mpSource->mDomain);
+				const SnapshotMap* const pMap = mpSource->mpMap.load(std::memory_order_acquire);
+				SnapshotMap::const_iterator it = pMap->find(nKey);
+				return (it != pMap->end()) ? it->second : 0;
+			}
+		};
+
+		void Update(int nValue)
+		{
+			SnapshotMap* const pMap = new SnapshotMap(*mpMap.load(std::memory_order_relaxed));
+			(*pMap)[nValue % kSnapshotMapSize] = nValue;
+			mDomain.retire(mpMap.exchange(pMap));
+		}
+	};
+
+
+	// As EbrSnapshotMap, but readers protect the map with a hazard_pointer.
+	struct HazardSnapshotMap
+	{
+		std::atomic<SnapshotMap*> mpMap;
+		eastl::hazard_domain      mDomain;
+
+		HazardSnapshotMap() : mpMap(new SnapshotMap) { InitSnapshotMap(*mpMap.load()); }
+	   ~HazardSnapshotMap() { delete mpMap.load(); }
+
+		struct Reader
+		{
+			HazardSnapshotMap*    mpSource;
+			eastl::hazard_pointer mHazardPointer;
+
+			explicit Reader(HazardSnapshotMap& source) : mpSource(&source), mHazardPointer(eastl::make_hazard_pointer(source.mDomain)) {}
+
+			int Find(int nKey)
+			{
+				// The protection is left in place until the next Find replaces it.
+				const SnapshotMap* const pMap = mHazardPointer.protect(mpSource->mpMap);
+				SnapshotMap::const_iterator it = pMap->find(nKey);
+				return (it != pMap->end()) ? it->second : 0;
+			}
+		};
+
+		void Update(int nValue)
+		{
+			SnapshotMap* const pMap = new SnapshotMap(*mpMap.load(std::memory_order_relaxed));
+			(*pMap)[nValue % kSnapshotMapSize] = nValue;
+			mDomain.retire(mpMap.exchange(pMap));
+		}
+	};
+
+
+	template <typename Source>
+	struct MapReaderThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::ThreadParameters mThreadParams;
+		EA::Thread::Thread           mThread;
+		Source*                      mpSource;
+		std::atomic<int>*            mpStartedCount;
+		int                          mnThreadCount;
+		uint32_t                     mnCount;
+		uint32_t                     mnSum;
+
+		MapReaderThread() : mThreadParams(), mThread(), mpSource(NULL), mpStartedCount(NULL), mnThreadCount(0), mnCount(0), mnSum(0) {}
+		MapReaderThread(const MapReaderThread&) = delete;
+		void operator=(const MapReaderThread&) = delete;
+
+		intptr_t Run(void*) override
+		{
+			typename Source::Reader reader(*mpSource);
+
+			mpStartedCount->fetch_add(1);
+			while(mpStartedCount->load() < mnThreadCount)
+				EA::Thread::ThreadSleep(0);
+
+			for(uint32_t i = 0; i < mnCount; i++)
+				mnSum += (uint32_t)reader.Find((int)((i * 7919) % kSnapshotMapSize));
+
+			return 0;
+		}
+	};
+
+
+	template <typename Source>
+	struct MapWriterThread : public EA::Thread::IRunnable
+	{
+		EA::Thread::ThreadParameters mThreadParams;
+		EA::Thread::Thread           mThread;
+		Source*                      mpSource;
+		std::atomic<bool>*           mpShouldContinue;
+
+		MapWriterThread() : mThreadParams(), mThread(), mpSource(NULL), mpShouldContinue(NULL) {}
+		MapWriterThread(const MapWriterThread&) = delete;
+		void operator=(const MapWriterThread&) = delete;
+
+		intptr_t Run(void*) override
+		{
+			for(int nValue = kSnapshotMapSize; mpShouldContinue->load(std::memory_order_relaxed); nValue++)
+			{
+				mpSource->Update(nValue);
+				EA::Thread::ThreadSleep(0);
+			}
+
+			return 0;
+		}
+	};
+
+
+	// Measures the time for nReaderCount threads to each search the map nCount times
+	// while another thread keeps changing it.
+	template <typename Source>
+	void TestMapSnapshotReaders(EA::StdC::Stopwatch& stopwatch, int nReaderCount, uint32_t nCount)
+	{
+		Source                                   source;
+		eastl::vector<MapReaderThread<Source>>   readers((eastl_size_t)nReaderCount);
+		MapWriterThread<Source>                  writer;
+		std::atomic<int>                         nStartedCount(0);
+		std::atomic<bool>                        bShouldContinue(true);
+
+		for(int t = 0; t < nReaderCount; t++)
+		{
+			readers[t].mpSource       = &source;
+			readers[t].mpStartedCount = &nStartedCount;
+			readers[t].mnThreadCount  = nReaderCount;
+			readers[t].mnCount        = nCount;
+			readers[t].mThreadParams.mpName = "MapReaderThread";
+		}
+
+		writer.mpSource         = &source;
+		writer.mpShouldContinue = &bShouldContinue;
+		writer.mThreadParams.mpName = "MapWriterThread";
+
+		stopwatch.Restart();
+
+		writer.mThread.Begin(&writer, NULL, &writer.mThreadParams);
+		for(int t = 0; t < nReaderCount; t++)
+			readers[t].mThread.Begin(&readers[t], NULL, &readers[t].mThreadParams);
+
+		uint32_t nSum = 0;
+
+		for(int t = 0; t < nReaderCount; t++)
+		{
+			readers[t].mThread.WaitForEnd();
+			nSum += readers[t].mnSum;
+		}
+
+		stopwatch.Stop();
+
+		bShouldContinue.store(false, std::memory_order_relaxed);
+		writer.mThread.WaitForEnd();
+
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nSum);
+	}
+
+} // namespace
+
+
+
+void BenchmarkSmartPtr()
+{
+	EASTLTest_Printf("SmartPtr\n");
+
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+	EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	{
+		const int      kReaderCounts[] = { 1, 2, 4, 8, 16, 32 };
+		const uint32_t kLoadCount      = 200000;
+		char           name[128];
+
+		for(int i = 0; i < 2; i++)
+		{
+			for(eastl_size_t t = 0; t < EAArrayCount(kReaderCounts); t++)
+			{
+				const int nReaderCount = kReaderCounts[t];
+
+				for(int w = 0; w < 2; w++)
+				{
+					SnapshotPtr                        sharedPtr(eastl::make_shared<Snapshot>());
+					eastl::atomic_shared_ptr<Snapshot> atomicSharedPtr(eastl::make_shared<Snapshot>());
+
+					TestSnapshotReaders(stopwatch1, sharedPtr,       nReaderCount, kLoadCount / (uint32_t)nReaderCount, w != 0);
+					TestSnapshotReaders(stopwatch2, atomicSharedPtr, nReaderCount, kLoadCount / (uint32_t)nReaderCount, w != 0);
+
+					if(i == 1)
+					{
+						EA::StdC::Snprintf(name, sizeof(name), "atomic_shared_ptr<Snapshot>/load/%d readers%s", nReaderCount, w ? " + 1 writer" : "");
+						Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: atomic_load(shared_ptr*) with striped mutex");
+					}
+				}
+			}
+		}
+	}
+
+	{
+		typedef eastl::local_shared_ptr<Snapshot> LocalSnapshotPtr;
+
+		const eastl_size_t kCopyCount = 100000;
+
+		SnapshotPtr                     sharedPtr(eastl::make_shared<Snapshot>());
+		LocalSnapshotPtr                localSharedPtr(eastl::make_local_shared<Snapshot>());
+		eastl::vector<SnapshotPtr>      sharedPtrVector(kCopyCount);
+		eastl::vector<LocalSnapshotPtr> localSharedPtrVector(kCopyCount);
+
+		for(int i = 0; i < 2; i++)
+		{
+			TestCopyDestroy(stopwatch1, sharedPtr,      sharedPtrVector);
+			TestCopyDestroy(stopwatch2, localSharedPtr, localSharedPtrVector);
+
+			if(i == 1)
+				Benchmark::AddResult("local_shared_ptr<Snapshot>/copy+destroy", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: eastl::shared_ptr with atomic counts");
+
+			TestPassByValue(stopwatch1, sharedPtr,      (uint32_t)kCopyCount / 8);
+			TestPassByValue(stopwatch2, localSharedPtr, (uint32_t)kCopyCount / 8);
+
+			if(i == 1)
+				Benchmark::AddResult("local_shared_ptr<Snapshot>/pass by value", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: eastl::shared_ptr with atomic counts");
+		}
+	}
+
+	{
+		const int      kReaderCounts[] = { 1, 2, 4, 8 };
+		const uint32_t kFindCount      = 200000;
+		char           name[128];
+
+		for(int i = 0; i < 2; i++)
+		{
+			for(eastl_size_t t = 0; t < EAArrayCount(kReaderCounts); t++)
+			{
+				const int      nReaderCount = kReaderCounts[t];
+				const uint32_t nCount       = kFindCount / (uint32_t)nReaderCount;
+
+				TestMapSnapshotReaders<LockedSnapshotMap>(stopwatch1, nReaderCount, nCount);
+				TestMapSnapshotReaders<EbrSnapshotMap>   (stopwatch2, nReaderCount, nCount);
+
+				if(i == 1)
+				{
+					EA::StdC::Snprintf(name, sizeof(name), "ebr_domain map snapshot/find/%d readers + 1 writer", nReaderCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: eastl::map with std::mutex");
+				}
+
+				TestMapSnapshotReaders<LockedSnapshotMap>(stopwatch1, nReaderCount, nCount);
+				TestMapSnapshotReaders<HazardSnapshotMap>(stopwatch2, nReaderCount, nCount);
+
+				if(i == 1)
+				{
+					EA::StdC::Snprintf(name, sizeof(name), "hazard_pointer map snapshot/find/%d readers + 1 writer", nReaderCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: eastl::map with std::mutex");
+				}
+			}
+		}
+	}
+}
@@ -4,6 +4,7 @@
 
 
 #include <EASTL/bonus/sort_extra.h>
+#include <EASTL/execution.h>
 #include <EASTL/sort.h>
 #include <EASTL/vector.h>
 #include <EAStdC/EAStopwatch.h>
@@ -143,6 +144,26 @@ namespace
 		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)eaVectorTO[0].mX);
 	}
 
+
+	template <typename ExecutionPolicy>
+	void TestSortPolicy(EA::StdC::Stopwatch& stopwatch, const ExecutionPolicy& policy, EaVectorInt& eaVectorInt)
+	{
+		stopwatch.Restart();
+		eastl::sort(policy, eaVectorInt.begin(), eaVectorInt.end());
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)eaVectorInt[0]);
+	}
+
+
+	template <typename ExecutionPolicy>
+	void TestStableSortPolicy(EA::StdC::Stopwatch& stopwatch, const ExecutionPolicy& policy, EaVectorInt& eaVectorInt)
+	{
+		stopwatch.Restart();
+		eastl::stable_sort(policy, eaVectorInt.begin(), eaVectorInt.end());
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)eaVectorInt[0]);
+	}
+
 } // namespace
 
 
@@ -1391,6 +1412,52 @@ void BenchmarkSort()
 				Benchmark::AddResult("sort/q_sort/TestObject[]/sorted", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
 		}
 	}
+
+	{
+		// Sequential eastl sorts against the parallel ones, which run on thread_pool::get_default().
+		eastl::vector<uint32_t> intVector(1000000);
+		eastl::generate(intVector.begin(), intVector.end(), rng);
+
+		EaVectorInt eaVectorInt1(intVector.size());
+		EaVectorInt eaVectorInt2(intVector.size());
+
+		for (int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test sort(par)/vector/Int
+			///////////////////////////////
+
+			eaVectorInt1 = intVector;
+			eaVectorInt2 = intVector;
+
+			TestSortPolicy(stopwatch1, eastl::execution::seq, eaVectorInt1);
+			TestSortPolicy(stopwatch2, eastl::execution::par, eaVectorInt2);
+
+			if(i == 1)
+				Benchmark::AddResult("sort/sort(par)/vector<uint32>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: sequential eastl::sort");
+
+			TestSortPolicy(stopwatch1, eastl::execution::seq, eaVectorInt1);
+			TestSortPolicy(stopwatch2, eastl::execution::par, eaVectorInt2);
+
+			if(i == 1)
+				Benchmark::AddResult("sort/sort(par)/vector<uint32>/sorted", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: sequential eastl::sort");
+
+
+
+			///////////////////////////////
+			// Test stable_sort(par)/vector/Int
+			///////////////////////////////
+
+			eaVectorInt1 = intVector;
+			eaVectorInt2 = intVector;
+
+			TestStableSortPolicy(stopwatch1, eastl::execution::seq, eaVectorInt1);
+			TestStableSortPolicy(stopwatch2, eastl::execution::par, eaVectorInt2);
+
+			if(i == 1)
+				Benchmark::AddResult("sort/stable_sort(par)/vector<uint32>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "std: sequential eastl::stable_sort");
+		}
+	}
 }
 
 
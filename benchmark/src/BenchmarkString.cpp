@@ -8,13 +8,23 @@
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/algorithm.h>
 #include <EASTL/string.h>
+#include <EASTL/string_view.h>
+#include <EASTL/charconv.h>
+#include <EASTL/rope.h>
 #include <EASTL/sort.h>
+#include <EASTL/vector.h>
 
 EA_DISABLE_ALL_VC_WARNINGS()
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <stdio.h>
 #include <stdlib.h>
+#if defined(__has_include)
+	#if __has_include(<charconv>)
+		#include <charconv>
+	#endif
+#endif
 EA_RESTORE_ALL_VC_WARNINGS()
 
 
@@ -165,6 +175,52 @@ namespace
 	}
 
 
+	// The following scan a whole block of text, as a log parser does, and count the hits.
+	template <typename Container>
+	void TestFindCharScan(EA::StdC::Stopwatch& stopwatch, const Container& c, typename Container::value_type ch)
+	{
+		unsigned count = 0;
+		stopwatch.Restart();
+		for(int i = 0; i < 10; i++)
+		{
+			for(typename Container::size_type pos = c.find(ch); pos != Container::npos; pos = c.find(ch, pos + 1))
+				count++;
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", count);
+	}
+
+
+	template <typename Container, typename T>
+	void TestFindScan(EA::StdC::Stopwatch& stopwatch, const Container& c, const T* p, int n)
+	{
+		unsigned count = 0;
+		stopwatch.Restart();
+		for(int i = 0; i < 10; i++)
+		{
+			for(typename Container::size_type pos = c.find(p, 0, (typename Container::size_type)n); pos != Container::npos; pos = c.find(p, pos + 1, (typename Container::size_type)n))
+				count++;
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", count);
+	}
+
+
+	template <typename Container, typename T>
+	void TestFirstOfScan(EA::StdC::Stopwatch& stopwatch, const Container& c, const T* p, int n)
+	{
+		unsigned count = 0;
+		stopwatch.Restart();
+		for(int i = 0; i < 10; i++)
+		{
+			for(typename Container::size_type pos = c.find_first_of(p, 0, (typename Container::size_type)n); pos != Container::npos; pos = c.find_first_of(p, pos + 1, (typename Container::size_type)n))
+				count++;
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", count);
+	}
+
+
 	template <typename Container> 
 	void TestCompare(EA::StdC::Stopwatch& stopwatch, Container& c1, Container& c2) // size()
 	{
@@ -519,6 +575,296 @@ void BenchmarkString()
 		}
 	}
 
+	{
+		// Scans over log text. The searched-for characters are sparse, as they are in practice,
+		// so these measure the cost of skipping over non-matching text.
+		std::string   ssLog;
+		eastl::string esLog;
+
+		for(int i = 0; i < 1000; i++)
+		{
+			char line[128];
+			EA::StdC::Snprintf(line, sizeof(line), "2024-03-01 12:%02d:%02d.%03d [%s] worker=%d request=%08x path=/api/v1/items status=200 latency=%dus\n",
+							   (i / 60) % 60, i % 60, (i * 7) % 1000, (i % 50) ? "INFO" : "ERROR", i % 16, (unsigned)(i * 2654435761u), (i * 37) % 5000);
+			ssLog += line;
+			esLog += line;
+		}
+
+		std::string_view   ssvLog(ssLog.data(), ssLog.size());
+		eastl::string_view esvLog(esLog.data(), esLog.size());
+
+		const char pError[]       = "[ERROR]";
+		const int  kErrorSize     = 7;
+		const char pDelimiters[]  = "[]|;";
+		const int  kDelimiterSize = 4;
+
+		for(int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test find(value_type c, size_type position)
+			///////////////////////////////
+
+			TestFindCharScan(stopwatch1, ssLog, '\n');
+			TestFindCharScan(stopwatch2, esLog, '\n');
+
+			if(i == 1)
+				Benchmark::AddResult("string<char>/find/c,pos log scan", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test find(const value_type* p, size_type position, size_type n)
+			///////////////////////////////
+
+			TestFindScan(stopwatch1, ssLog, pError, kErrorSize);
+			TestFindScan(stopwatch2, esLog, pError, kErrorSize);
+
+			if(i == 1)
+				Benchmark::AddResult("string<char>/find/p,pos,n log scan", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestFindScan(stopwatch1, ssvLog, pError, kErrorSize);
+			TestFindScan(stopwatch2, esvLog, pError, kErrorSize);
+
+			if(i == 1)
+				Benchmark::AddResult("string_view<char>/find/p,pos,n log scan", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test rfind(value_type c, size_type position)
+			///////////////////////////////
+
+			stopwatch1.Restart();
+			for(int j = 0; j < 1000; j++)
+				Benchmark::DoNothing(&ssLog, ssLog.rfind('|'));
+			stopwatch1.Stop();
+
+			stopwatch2.Restart();
+			for(int j = 0; j < 1000; j++)
+				Benchmark::DoNothing(&esLog, esLog.rfind('|'));
+			stopwatch2.Stop();
+
+			if(i == 1)
+				Benchmark::AddResult("string<char>/rfind/c,pos log scan", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test find_first_of(const value_type* p, size_type position, size_type n)
+			///////////////////////////////
+
+			TestFirstOfScan(stopwatch1, ssLog, pDelimiters, kDelimiterSize);
+			TestFirstOfScan(stopwatch2, esLog, pDelimiters, kDelimiterSize);
+
+			if(i == 1)
+				Benchmark::AddResult("string<char>/find_first_of/p,pos,n log scan", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// Number formatting as done by a telemetry serializer. The integers span all digit counts
+		// and the floats are a mix of short decimal values and full precision values.
+		eastl::vector<int64_t> intValues;
+		eastl::vector<double>  floatValues;
+		EASTLTest_Rand         rng(EA::UnitTest::GetRandSeed());
+
+		for(int i = 0; i < 10000; i++)
+		{
+			intValues.push_back((int64_t)(rng.RandLimit(0x7FFFFFFF) >> rng.RandLimit(31)) * ((i & 1) ? -1 : 1));
+			floatValues.push_back((i & 1) ? ((double)rng.RandLimit(1000000) / 100.0) : ((double)rng.RandLimit(0x7FFFFFFF) / (double)(rng.RandLimit(0x7FFFFFFF) + 1)));
+		}
+
+		eastl::string sFormatted;
+		sFormatted.reserve(400000);
+
+		for(int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test append_integer(Integer value)
+			///////////////////////////////
+
+			sFormatted.clear();
+			stopwatch1.Restart();
+			for(eastl_size_t j = 0; j < intValues.size(); j++)
+				sFormatted.append_sprintf("%lld,", (long long)intValues[j]);
+			stopwatch1.Stop();
+
+			sFormatted.clear();
+			stopwatch2.Restart();
+			for(eastl_size_t j = 0; j < intValues.size(); j++)
+				sFormatted.append_integer(intValues[j]).push_back(',');
+			stopwatch2.Stop();
+
+			if(i == 1)
+				Benchmark::AddResult("string<char>/append_integer vs append_sprintf", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test append_float(Float value)
+			///////////////////////////////
+
+			// %.17g is the shortest printf format which always round trips, as append_float does.
+			sFormatted.clear();
+			stopwatch1.Restart();
+			for(eastl_size_t j = 0; j < floatValues.size(); j++)
+				sFormatted.append_sprintf("%.17g,", floatValues[j]);
+			stopwatch1.Stop();
+
+			sFormatted.clear();
+			stopwatch2.Restart();
+			for(eastl_size_t j = 0; j < floatValues.size(); j++)
+				sFormatted.append_float(floatValues[j]).push_back(',');
+			stopwatch2.Stop();
+
+			if(i == 1)
+				Benchmark::AddResult("string<char>/append_float vs append_sprintf", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test from_chars(const char* first, const char* last, double& value)
+			///////////////////////////////
+
+			const char* const pBegin = sFormatted.data();
+			const char* const pEnd   = sFormatted.data() + sFormatted.size();
+			double            sum    = 0;
+
+			stopwatch1.Restart();
+			for(const char* p = pBegin; p < pEnd; )
+			{
+				char* pParseEnd;
+				sum += strtod(p, &pParseEnd);
+				p = pParseEnd + 1;
+			}
+			stopwatch1.Stop();
+
+			stopwatch2.Restart();
+			for(const char* p = pBegin; p < pEnd; )
+			{
+				double value = 0;
+				p = eastl::from_chars(p, pEnd, value).ptr + 1;
+				sum += value;
+			}
+			stopwatch2.Stop();
+
+			EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%f", sum);
+
+			if(i == 1)
+				Benchmark::AddResult("from_chars<double> vs strtod", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			#if defined(__cpp_lib_to_chars)
+				///////////////////////////////
+				// Test to_chars(char* first, char* last, double value)
+				///////////////////////////////
+
+				char buffer[64];
+				size_t nTotal = 0;
+
+				stopwatch1.Restart();
+				for(eastl_size_t j = 0; j < floatValues.size(); j++)
+					nTotal += (size_t)(std::to_chars(buffer, buffer + sizeof(buffer), floatValues[j]).ptr - buffer);
+				stopwatch1.Stop();
+
+				stopwatch2.Restart();
+				for(eastl_size_t j = 0; j < floatValues.size(); j++)
+					nTotal += (size_t)(eastl::to_chars(buffer, buffer + sizeof(buffer), floatValues[j]).ptr - buffer);
+				stopwatch2.Stop();
+
+				EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nTotal);
+
+				if(i == 1)
+					Benchmark::AddResult("to_chars<double>", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			#endif
+		}
+	}
+
+	{
+		// Editing in the middle of a large document, as a text editor or script patcher does.
+		// string moves everything after the edit; rope splits and rejoins its tree.
+		const eastl_size_t kDocumentSize = 4 * 1024 * 1024;
+		eastl::vector<eastl_size_t> positions;
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+		for(int i = 0; i < 4000; i++)
+			positions.push_back((eastl_size_t)rng.RandLimit((uint32_t)kDocumentSize));
+
+		eastl::string sDocument(kDocumentSize, 'x');
+		for(eastl_size_t i = 0; i < kDocumentSize; i += 61)
+			sDocument[i] = '\n';
+
+		for(int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test insert(pos, p, n) / erase(pos, n)
+			///////////////////////////////
+
+			eastl::string     s(sDocument);
+			eastl::rope<char> r(sDocument);
+
+			stopwatch1.Restart();
+			for(eastl_size_t j = 0; j < positions.size(); j += 2)
+			{
+				s.insert(positions[j], "edited text 0123", 16);
+				s.erase(positions[j + 1], 16);
+			}
+			stopwatch1.Stop();
+
+			stopwatch2.Restart();
+			for(eastl_size_t j = 0; j < positions.size(); j += 2)
+			{
+				r.insert(positions[j], "edited text 0123", 16);
+				r.erase(positions[j + 1], 16);
+			}
+			stopwatch2.Stop();
+
+			EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)(s.size() + r.size()));
+
+			if(i == 1)
+				Benchmark::AddResult("rope<char>/insert,erase vs string", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test substr(pos, n)
+			///////////////////////////////
+
+			eastl_size_t nTotal = 0;
+
+			stopwatch1.Restart();
+			for(eastl_size_t j = 0; j < positions.size(); j++)
+				nTotal += s.substr(positions[j] / 2, 64 * 1024).size();
+			stopwatch1.Stop();
+
+			stopwatch2.Restart();
+			for(eastl_size_t j = 0; j < positions.size(); j++)
+				nTotal += r.substr(positions[j] / 2, 64 * 1024).size();
+			stopwatch2.Stop();
+
+			EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nTotal);
+
+			if(i == 1)
+				Benchmark::AddResult("rope<char>/substr vs string", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test iteration
+			///////////////////////////////
+
+			nTotal = 0;
+
+			stopwatch1.Restart();
+			for(eastl::string::const_iterator it = s.begin(), itEnd = s.end(); it != itEnd; ++it)
+				nTotal += (*it == '\n');
+			stopwatch1.Stop();
+
+			stopwatch2.Restart();
+			for(eastl::rope<char>::const_iterator it = r.begin(), itEnd = r.end(); it != itEnd; ++it)
+				nTotal += (*it == '\n');
+			stopwatch2.Stop();
+
+			EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nTotal);
+
+			if(i == 1)
+				Benchmark::AddResult("rope<char>/iteration vs string", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
 }
 
 
@@ -8,13 +8,19 @@
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/algorithm.h>
 #include <EASTL/vector.h>
+#include <EASTL/fixed_vector.h>
+#include <EASTL/small_vector.h>
 #include <EASTL/sort.h>
+#include <EASTL/string.h>
+#include <EASTL/unique_ptr.h>
 
 #ifdef _MSC_VER
 	#pragma warning(push, 0)
 	#pragma warning(disable: 4350)
 #endif
 #include <algorithm>
+#include <memory>
+#include <string>
 #include <vector>
 #include <stdio.h>
 #include <stdlib.h>
@@ -282,6 +288,50 @@ namespace
 	}
 
 
+	// Grows the container one push_back at a time, so the cost is dominated by
+	// moving the existing elements into each new buffer.
+	template <typename Container, typename Value>
+	void TestPushBackGrowth(EA::StdC::Stopwatch& stopwatch, Container& c, const Value& value, int count)
+	{
+		stopwatch.Restart();
+		for(int j = 0; j < count; j++)
+			c.push_back(value);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.size());
+	}
+
+
+	template <typename Container, typename Pointer>
+	void TestPushBackGrowthUniquePtr(EA::StdC::Stopwatch& stopwatch, Container& c, int count)
+	{
+		stopwatch.Restart();
+		for(int j = 0; j < count; j++)
+			c.push_back(Pointer(new uint64_t((uint64_t)j)));
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.size());
+	}
+
+
+	// Builds many short-lived containers of elementCount elements each, which is the
+	// use case that fixed_vector and small_vector are intended for.
+	template <typename Container>
+	void TestShortLivedPushBack(EA::StdC::Stopwatch& stopwatch, const eastl::vector<uint32_t>& intVector, eastl_size_t elementCount)
+	{
+		uint64_t sum = 0;
+
+		stopwatch.Restart();
+		for(eastl_size_t r = 0; (r + elementCount) <= intVector.size(); r += elementCount)
+		{
+			Container c;
+			for(eastl_size_t j = 0; j < elementCount; j++)
+				c.push_back((uint64_t)intVector[r + j]);
+			sum += c[elementCount / 2];
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)(sum & 0xffffffff));
+	}
+
+
 	template <typename Container>
 	void TestMoveErase(EA::StdC::Stopwatch& stopwatch, Container& c)
 	{
@@ -409,6 +459,51 @@ void BenchmarkVector()
 				Benchmark::AddResult("vector<MovableType>/erase", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
 
 
+			///////////////////////////////////////////
+			// Test fixed_vector vs. small_vector
+			///////////////////////////////////////////
+
+			TestShortLivedPushBack<eastl::fixed_vector<uint64_t, 16, true> >(stopwatch1, intVector, 16);
+			TestShortLivedPushBack<eastl::small_vector<uint64_t, 16> >(stopwatch2, intVector, 16);
+
+			if(i == 1)
+				Benchmark::AddResult("small_vector<uint64,16>/push_back", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "fixed_vector vs small_vector, inline");
+
+			TestShortLivedPushBack<eastl::fixed_vector<uint64_t, 16, true> >(stopwatch1, intVector, 40);
+			TestShortLivedPushBack<eastl::small_vector<uint64_t, 16> >(stopwatch2, intVector, 40);
+
+			if(i == 1)
+				Benchmark::AddResult("small_vector<uint64,16>/push_back spill", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), "fixed_vector vs small_vector, overflowed");
+
+
+			///////////////////////////////////////////
+			// Test growth of relocatable element types
+			// eastl::vector memcpys these on reallocation.
+			///////////////////////////////////////////
+
+			{
+				std::vector<std::string>   stdVectorString;
+				eastl::vector<eastl::string> eaVectorString;
+
+				TestPushBackGrowth(stopwatch1, stdVectorString, std::string("a string long enough to be heap allocated"), 100000);
+				TestPushBackGrowth(stopwatch2, eaVectorString, eastl::string("a string long enough to be heap allocated"), 100000);
+
+				if(i == 1)
+					Benchmark::AddResult("vector<string>/push_back growth", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+			{
+				std::vector<std::unique_ptr<uint64_t> >     stdVectorUniquePtr;
+				eastl::vector<eastl::unique_ptr<uint64_t> > eaVectorUniquePtr;
+
+				TestPushBackGrowthUniquePtr<std::vector<std::unique_ptr<uint64_t> >, std::unique_ptr<uint64_t> >(stopwatch1, stdVectorUniquePtr, 100000);
+				TestPushBackGrowthUniquePtr<eastl::vector<eastl::unique_ptr<uint64_t> >, eastl::unique_ptr<uint64_t> >(stopwatch2, eaVectorUniquePtr, 100000);
+
+				if(i == 1)
+					Benchmark::AddResult("vector<unique_ptr<T>>/push_back growth", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+			}
+
+
 			///////////////////////////////////////////
 			// Test move of AutoRefCount
 			// Should be much faster with C++11 move.
@@ -34,6 +34,7 @@
 
 
 void BenchmarkSort();
+void BenchmarkSmartPtr();
 void BenchmarkList();
 void BenchmarkString();
 void BenchmarkVector();
@@ -132,6 +132,7 @@ int EAMain(int argc, char* argv[])
 	BenchmarkHeap();
 	BenchmarkBitset();
 	BenchmarkSort();
+	BenchmarkSmartPtr();
 	BenchmarkTupleVector();
 
 	stopwatch.Stop();
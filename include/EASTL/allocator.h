@@ -7,6 +7,7 @@
 
 
 #include <EASTL/internal/config.h>
+#include <EASTL/type_traits.h>
 #include <stddef.h>
 
 
@@ -96,6 +97,11 @@ namespace eastl
 #endif
 
 
+	// Neither allocator refers to its own address, so containers using them can be relocated with memcpy.
+	template <> struct is_trivially_relocatable<allocator>       : public true_type {};
+	template <> struct is_trivially_relocatable<dummy_allocator> : public true_type {};
+
+
 	/// Defines a static default allocator which is constant across all types.
 	/// This is different from get_default_allocator, which is is bound at
 	/// compile-time and expected to differ per allocator type.
@@ -0,0 +1,390 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     arena
+//     arena_allocator
+//     scoped_default_arena
+//     GetDefaultArena / SetDefaultArena
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+#include <EASTL/type_traits.h>
+#include <stddef.h>
+
+
+
+namespace eastl
+{
+
+	/// EASTL_ARENA_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_ARENA_DEFAULT_NAME
+		#define EASTL_ARENA_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " arena" // Unless the user overrides something, this is "EASTL arena".
+	#endif
+
+
+	/// EASTL_ARENA_DEFAULT_BLOCK_SIZE
+	///
+	/// The size of the first block an arena allocates, unless the user specifies one.
+	/// Each further block is twice the size of the previous, up to EASTL_ARENA_MAX_BLOCK_SIZE.
+	///
+	#ifndef EASTL_ARENA_DEFAULT_BLOCK_SIZE
+		#define EASTL_ARENA_DEFAULT_BLOCK_SIZE 4096
+	#endif
+
+
+	/// EASTL_ARENA_MAX_BLOCK_SIZE
+	///
+	/// The size beyond which arena blocks stop growing. Allocations larger than this
+	/// still get a block of their own.
+	///
+	#ifndef EASTL_ARENA_MAX_BLOCK_SIZE
+		#define EASTL_ARENA_MAX_BLOCK_SIZE (1024 * 1024)
+	#endif
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// arena
+	///////////////////////////////////////////////////////////////////////////
+
+	/// arena
+	///
+	/// Implements a monotonic (bump pointer) memory resource. Memory is carved
+	/// from a chain of blocks which grow geometrically, and individual frees are
+	/// ignored except for the most recent allocation, which is rolled back so that
+	/// a growing vector or string can reuse its own space. All memory is reclaimed
+	/// at once with reset() or release().
+	///
+	/// reset() is O(1): it rewinds to the first block and keeps the chain, so that
+	/// an arena which is reset once per frame or per request stops touching the
+	/// heap after the first few. release() returns the blocks to the backing
+	/// allocator. Both invalidate everything allocated from the arena, so any
+	/// container using the arena must be destroyed or cleared before then.
+	///
+	/// An arena is not thread-safe and can't be copied. Containers use it through
+	/// arena_allocator, which refers to an arena.
+	///
+	/// Example usage:
+	///     eastl::arena arena;
+	///
+	///     for(Request& request : requests)
+	///     {
+	///         eastl::vector<Token, eastl::arena_allocator> tokens(eastl::arena_allocator(arena));
+	///         eastl::map<int, Token, eastl::less<int>, eastl::arena_allocator> index(eastl::arena_allocator(arena));
+	///         Process(request, tokens, index);
+	///     }   // tokens and index are destroyed here...
+	///     arena.reset(); // ...so their memory can be reclaimed.
+	///
+	class EASTL_API arena
+	{
+	public:
+		/// arena
+		///
+		/// Creates an arena whose blocks come from the given allocator. No memory is
+		/// allocated until the first allocation.
+		///
+		explicit arena(size_t nInitialBlockSize = EASTL_ARENA_DEFAULT_BLOCK_SIZE,
+		               const EASTLAllocatorType& allocator = EASTLAllocatorType(EASTL_ARENA_DEFAULT_NAME));
+
+		/// arena
+		///
+		/// Creates an arena which allocates from the given buffer first, and from the
+		/// allocator once the buffer is used up. The buffer is not freed by the arena
+		/// and must outlive it.
+		///
+		arena(void* pBuffer, size_t nBufferSize,
+		      const EASTLAllocatorType& allocator = EASTLAllocatorType(EASTL_ARENA_DEFAULT_NAME));
+
+		~arena();
+
+		void* allocate(size_t n, size_t alignment = EASTL_ALLOCATOR_MIN_ALIGNMENT, size_t alignmentOffset = 0);
+		void  deallocate(void* p, size_t n);
+
+		void reset();
+		void release();
+
+		/// The bytes handed out since construction or the last reset, excluding alignment padding.
+		size_t allocated_size() const { return mnAllocatedSize; }
+
+		/// The total size of the blocks held by the arena, including a user-supplied buffer.
+		size_t capacity() const { return mnCapacity; }
+
+		size_t block_count() const { return mnBlockCount; }
+
+		const char* get_name() const;
+		void        set_name(const char* pName);
+
+		const EASTLAllocatorType& get_allocator() const { return mAllocator; }
+		EASTLAllocatorType&       get_allocator()       { return mAllocator; }
+
+	protected:
+		struct Block
+		{
+			Block* mpNext;
+			char*  mpEnd;
+			bool   mbOwned; // False for the user-supplied buffer.
+		};
+
+		EASTLAllocatorType mAllocator;
+		Block*             mpFirstBlock;
+		Block*             mpCurrentBlock;
+		Block*             mpLastBlock;
+		char*              mpCurrent;         // The next free byte in mpCurrentBlock.
+		char*              mpEnd;             // The end of mpCurrentBlock.
+		size_t             mnNextBlockSize;
+		size_t             mnAllocatedSize;
+		size_t             mnCapacity;
+		size_t             mnBlockCount;
+
+		// Returns the first address at or after p which is alignmentOffset bytes past an alignment boundary, as allocate_memory expects.
+		static char* AlignUp(char* p, size_t alignment, size_t alignmentOffset)
+			{ return (char*)((((uintptr_t)p - alignmentOffset + (alignment - 1)) & ~(uintptr_t)(alignment - 1)) + alignmentOffset); }
+
+		static char* BlockBegin(Block* pBlock)
+			{ return (char*)(pBlock + 1); }
+
+		void* DoAllocateFromNextBlock(size_t n, size_t alignment, size_t alignmentOffset);
+		void  DoSetCurrentBlock(Block* pBlock);
+
+	private:
+		// Not copyable; containers share an arena through arena_allocator.
+		arena(const arena&);
+		arena& operator=(const arena&);
+	};
+
+
+	inline void* arena::allocate(size_t n, size_t alignment, size_t alignmentOffset)
+	{
+		// Assert that alignment is a power of 2 value (e.g. 1, 2, 4, 8, 16, etc.)
+		EASTL_ASSERT((alignment & (alignment - 1)) == 0);
+
+		if(mpCurrent)
+		{
+			char* const p = AlignUp(mpCurrent, alignment, alignmentOffset);
+
+			if((p <= mpEnd) && (n <= (size_t)(mpEnd - p)))
+			{
+				mpCurrent        = p + n;
+				mnAllocatedSize += n;
+				return p;
+			}
+		}
+
+		return DoAllocateFromNextBlock(n, alignment, alignmentOffset);
+	}
+
+
+	inline void arena::deallocate(void* p, size_t n)
+	{
+		// Only the most recent allocation can be given back.
+		if(((char*)p + n) == mpCurrent)
+		{
+			mpCurrent        = (char*)p;
+			mnAllocatedSize -= n;
+		}
+	}
+
+
+
+	/// GetDefaultArena / SetDefaultArena
+	///
+	/// The arena which a default-constructed arena_allocator uses. When it is NULL,
+	/// as it is initially, default-constructed arena_allocators use EASTLAllocatorDefault().
+	/// Unlike SetDefaultAllocator, this setting is per thread where the compiler
+	/// supports thread_local, so that each worker thread can scope its own arena.
+	/// SetDefaultArena returns the previous value. See scoped_default_arena.
+	///
+	EASTL_API arena* GetDefaultArena();
+	EASTL_API arena* SetDefaultArena(arena* pArena);
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// arena_allocator
+	///////////////////////////////////////////////////////////////////////////
+
+	/// arena_allocator
+	///
+	/// An EASTL allocator which allocates from an arena. It refers to the arena
+	/// rather than owning it, so it can be freely copied, and two arena_allocators
+	/// compare equal if they use the same arena.
+	///
+	/// A default-constructed arena_allocator uses GetDefaultArena() as it is at the
+	/// time of construction, or the default heap allocator if there is none. This is
+	/// what allows scoped_default_arena to redirect the containers built within a scope.
+	///
+	class EASTL_API arena_allocator
+	{
+	public:
+		EASTL_ALLOCATOR_EXPLICIT arena_allocator(const char* pName = EASTL_NAME_VAL(EASTL_ARENA_DEFAULT_NAME))
+			: mpArena(GetDefaultArena())
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName ? pName : EASTL_ARENA_DEFAULT_NAME;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+		explicit arena_allocator(arena& a, const char* pName = EASTL_NAME_VAL(EASTL_ARENA_DEFAULT_NAME))
+			: mpArena(&a)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName ? pName : EASTL_ARENA_DEFAULT_NAME;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+		arena_allocator(const arena_allocator& x)
+			: mpArena(x.mpArena)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = x.mpName;
+			#endif
+		}
+
+		arena_allocator(const arena_allocator& x, const char* pName)
+			: mpArena(x.mpArena)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName ? pName : EASTL_ARENA_DEFAULT_NAME;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+		arena_allocator& operator=(const arena_allocator& x)
+		{
+			mpArena = x.mpArena;
+			#if EASTL_NAME_ENABLED
+				mpName = x.mpName;
+			#endif
+			return *this;
+		}
+
+		void* allocate(size_t n, int flags = 0)
+		{
+			if(mpArena)
+				return mpArena->allocate(n);
+
+			EA_UNUSED(flags);
+			void* const p = EASTLAlloc(*EASTLAllocatorDefault(), n);
+			return p;
+		}
+
+		void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0)
+		{
+			if(mpArena)
+				return mpArena->allocate(n, alignment, offset);
+
+			EA_UNUSED(flags);
+			void* const p = EASTLAllocAligned(*EASTLAllocatorDefault(), n, alignment, offset);
+			return p;
+		}
+
+		void deallocate(void* p, size_t n)
+		{
+			if(mpArena)
+				mpArena->deallocate(p, n);
+			else
+				EASTLFree(*EASTLAllocatorDefault(), p, n);
+		}
+
+		/// Returns the arena this allocator uses, or NULL if it uses the default heap allocator.
+		arena* get_arena() const { return mpArena; }
+
+		const char* get_name() const
+		{
+			#if EASTL_NAME_ENABLED
+				return mpName;
+			#else
+				return EASTL_ARENA_DEFAULT_NAME;
+			#endif
+		}
+
+		void set_name(const char* pName)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+	protected:
+		arena* mpArena;
+
+		#if EASTL_NAME_ENABLED
+			const char* mpName; // Debug name, used to track memory.
+		#endif
+	};
+
+	inline bool operator==(const arena_allocator& a, const arena_allocator& b)
+	{
+		return a.get_arena() == b.get_arena();
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	inline bool operator!=(const arena_allocator& a, const arena_allocator& b)
+	{
+		return a.get_arena() != b.get_arena();
+	}
+#endif
+
+	// arena_allocator refers to its arena, never to itself, so containers using it can be relocated with memcpy.
+	template <> struct is_trivially_relocatable<arena_allocator> : public true_type {};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// scoped_default_arena
+	///////////////////////////////////////////////////////////////////////////
+
+	/// scoped_default_arena
+	///
+	/// Makes an arena the calling thread's default arena for the lifetime of this
+	/// object, and restores the previous default when it is destroyed. Containers
+	/// which use arena_allocator and are default-constructed within the scope
+	/// allocate from the arena, including those constructed deep within other code.
+	///
+	/// Example usage:
+	///     typedef eastl::vector<int, eastl::arena_allocator> IntVector;
+	///
+	///     eastl::arena arena;
+	///     {
+	///         eastl::scoped_default_arena scope(arena);
+	///         IntVector v;        // Allocates from arena.
+	///         BuildReport(v);
+	///     }
+	///     IntVector v2;           // Allocates from the heap.
+	///
+	class scoped_default_arena
+	{
+	public:
+		explicit scoped_default_arena(arena& a)
+			: mpPrevArena(SetDefaultArena(&a)) {}
+
+		~scoped_default_arena()
+			{ SetDefaultArena(mpPrevArena); }
+
+	protected:
+		arena* mpPrevArena;
+
+	private:
+		scoped_default_arena(const scoped_default_arena&);
+		scoped_default_arena& operator=(const scoped_default_arena&);
+	};
+
+} // namespace eastl
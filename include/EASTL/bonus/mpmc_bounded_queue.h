@@ -0,0 +1,577 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements mpmc_bounded_queue, a fixed-size FIFO queue which any
+// number of threads may push to and pop from at once without locks. It is the
+// bounded queue design by Dmitry Vyukov: every slot has a sequence number that
+// tells the threads racing for a position whether the slot is ready for them.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/allocator.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/utility.h>
+#include <stddef.h>
+
+
+
+namespace eastl
+{
+	/// EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_NAME
+		#define EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " mpmc_bounded_queue" // Unless the user overrides something, this is "EASTL mpmc_bounded_queue".
+	#endif
+
+	/// EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_ALLOCATOR
+		#define EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_ALLOCATOR allocator_type(EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_NAME)
+	#endif
+
+
+
+	/// mpmc_bounded_queue
+	///
+	/// A bounded queue which may be pushed to and popped from by any number of threads
+	/// at once. Neither side takes a lock. A thread claims a position by advancing the
+	/// enqueue (or dequeue) position with a compare-and-swap, and then works on that
+	/// position's slot without interference. Each slot has a sequence number which the
+	/// owner of the slot advances when it is done with it, which both publishes the
+	/// element to the other side and tells later threads whether the slot is free yet.
+	/// A push into a full queue and a pop from an empty queue fail rather than wait.
+	///
+	/// The capacity is rounded up to a power of two, and is at least two. The enqueue
+	/// and dequeue positions are kept on separate cache lines, so that producers and
+	/// consumers only contend with their own kind.
+	///
+	/// push_n and pop_n claim a run of consecutive positions with one compare-and-swap,
+	/// which under contention is far cheaper per element than claiming them one at a
+	/// time. They move as many elements as there is room for (or as are available)
+	/// and return the count. The elements of a batch stay consecutive in the queue,
+	/// but a consumer can see the first of them before the producer has stored the
+	/// rest, and then pops only the ones that are ready.
+	///
+	/// A thread which is descheduled between claiming a slot and publishing it holds
+	/// up the threads which reach that slot on the other side, so the queue is not
+	/// strictly lock-free; in practice that window is a single element copy.
+	///
+	/// A claimed position can't be handed back, so an exception can't be fully rolled
+	/// back. If constructing an element throws, the push gives up the slot and the
+	/// consumer which reaches it steps over it; push_n keeps the elements it stored
+	/// before the one which threw. If moving an element out throws, the pop destroys
+	/// it, and pop_n also destroys the rest of its batch. Those elements are lost, but
+	/// the queue stays usable.
+	///
+	/// size and empty may be called from any thread, but when other threads are using
+	/// the queue they are only a snapshot.
+	///
+	/// Example usage:
+	///     mpmc_bounded_queue<Task> tasks(4096);
+	///
+	///     // Any thread:
+	///     if(!tasks.try_push(Task(...)))
+	///         RunTaskNow(...);
+	///
+	///     // Any worker thread:
+	///     Task task;
+	///     while(tasks.try_pop(task))
+	///         task();
+	///
+	template <typename T, typename Allocator = EASTLAllocatorType>
+	class mpmc_bounded_queue
+	{
+	public:
+		typedef mpmc_bounded_queue<T, Allocator>  this_type;
+		typedef T                                 value_type;
+		typedef T&                                reference;
+		typedef const T&                          const_reference;
+		typedef eastl_size_t                      size_type;
+		typedef Allocator                         allocator_type;
+
+	public:
+		explicit mpmc_bounded_queue(size_type nCapacity, const allocator_type& allocator = EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_ALLOCATOR);
+	   ~mpmc_bounded_queue();
+
+		mpmc_bounded_queue(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+		bool try_push(const value_type& value);
+		bool try_push(value_type&& value);
+
+		template <class... Args>
+		bool try_emplace(Args&&... args);
+
+		template <typename InputIterator>
+		size_type push_n(InputIterator first, size_type n);
+
+		bool try_pop(value_type& value);
+
+		template <typename OutputIterator>
+		size_type pop_n(OutputIterator dest, size_type n);
+
+		size_type size() const EA_NOEXCEPT;
+		bool      empty() const EA_NOEXCEPT;
+		size_type capacity() const EA_NOEXCEPT;
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT;
+
+	protected:
+		struct cell_type
+		{
+			std::atomic<size_type>                                        mnSequence;
+			typename aligned_storage<sizeof(T), EASTL_ALIGN_OF(T)>::type  mValue;
+
+			value_type* get_value() EA_NOEXCEPT { return reinterpret_cast<value_type*>(mValue.mCharData); }
+		};
+
+		// A slot is free for the producer which claims position i when its sequence is i,
+		// and holds an element for the consumer which claims position i when it is i + 1.
+		enum SlotState { kSlotEarly, kSlotReady, kSlotLate };
+
+		struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) position_type
+		{
+			std::atomic<size_type> mnPosition;
+		} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+
+		struct buffer_storage_tag {};
+
+		// For fixed_mpmc_bounded_queue, which calls DoSetBuffer with its own storage.
+		mpmc_bounded_queue(buffer_storage_tag, const allocator_type& allocator);
+
+		void DoSetBuffer(cell_type* pCells, size_type nCapacity, bool bOwnsBuffer) EA_NOEXCEPT;
+		void DoFreeBuffer();
+
+		static SlotState DoGetSlotState(size_type nSequence, size_type nExpected) EA_NOEXCEPT;
+		size_type        DoClaim(position_type& position, size_type nSequenceOffset, size_type nWanted, size_type& nPosition) EA_NOEXCEPT;
+		void             DoDiscard(size_type nPosition, size_type n, bool bDestroy) EA_NOEXCEPT;
+
+	protected:
+		position_type  mEnqueue;
+		position_type  mDequeue;
+		cell_type*     mpCells;      // The members from here on are only written on construction, so all threads can share their cache line.
+		size_type      mnMask;       // The capacity minus one.
+		bool           mbOwnsBuffer; // False when the buffer is the storage of a fixed_mpmc_bounded_queue.
+		allocator_type mAllocator;
+
+	}; // class mpmc_bounded_queue
+
+
+
+	/// fixed_mpmc_bounded_queue
+	///
+	/// An mpmc_bounded_queue whose slots are stored within the object itself rather
+	/// than allocated. nCapacity must be a power of two, and at least two.
+	///
+	/// Example usage:
+	///     fixed_mpmc_bounded_queue<uint32_t, 1024> freeIds;
+	///     freeIds.try_push(id);
+	///
+	template <typename T, size_t nCapacity>
+	class fixed_mpmc_bounded_queue : public mpmc_bounded_queue<T, dummy_allocator>
+	{
+		static_assert((nCapacity >= 2) && ((nCapacity & (nCapacity - 1)) == 0), "fixed_mpmc_bounded_queue capacity must be a power of two, and at least two.");
+
+	public:
+		typedef mpmc_bounded_queue<T, dummy_allocator>  base_type;
+		typedef fixed_mpmc_bounded_queue<T, nCapacity>  this_type;
+		typedef typename base_type::value_type          value_type;
+		typedef typename base_type::size_type           size_type;
+
+		enum { kMaxSize = nCapacity };
+
+	public:
+		fixed_mpmc_bounded_queue()
+			: base_type(typename base_type::buffer_storage_tag(), dummy_allocator())
+		{
+			base_type::DoSetBuffer(reinterpret_cast<cell_type*>(mBuffer.mCharData), nCapacity, false);
+		}
+
+	   ~fixed_mpmc_bounded_queue()
+		{
+			base_type::DoFreeBuffer(); // Destroy the remaining elements while mBuffer is still alive.
+		}
+
+	protected:
+		typedef typename base_type::cell_type cell_type;
+
+		typename aligned_storage<sizeof(cell_type) * nCapacity, EASTL_ALIGN_OF(cell_type)>::type mBuffer;
+
+	}; // class fixed_mpmc_bounded_queue
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// mpmc_bounded_queue
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Allocator>
+	inline mpmc_bounded_queue<T, Allocator>::mpmc_bounded_queue(size_type nCapacity, const allocator_type& allocator)
+		: mpmc_bounded_queue(buffer_storage_tag(), allocator)
+	{
+		EASTL_ASSERT(nCapacity != 0);
+
+		size_type nRoundedCapacity = 2; // With one slot, a full slot would look free to the next lap's producer.
+		while(nRoundedCapacity < nCapacity)
+			nRoundedCapacity *= 2;
+
+		cell_type* const pCells = (cell_type*)allocate_memory(mAllocator, nRoundedCapacity * sizeof(cell_type), EASTL_ALIGN_OF(cell_type), 0);
+		DoSetBuffer(pCells, nRoundedCapacity, true);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline mpmc_bounded_queue<T, Allocator>::mpmc_bounded_queue(buffer_storage_tag, const allocator_type& allocator)
+		: mpCells(NULL)
+		, mnMask(0)
+		, mbOwnsBuffer(false)
+		, mAllocator(allocator)
+	{
+		mEnqueue.mnPosition.store(0, std::memory_order_relaxed);
+		mDequeue.mnPosition.store(0, std::memory_order_relaxed);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline mpmc_bounded_queue<T, Allocator>::~mpmc_bounded_queue()
+	{
+		DoFreeBuffer();
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool mpmc_bounded_queue<T, Allocator>::try_push(const value_type& value)
+	{
+		return try_emplace(value);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool mpmc_bounded_queue<T, Allocator>::try_push(value_type&& value)
+	{
+		return try_emplace(eastl::move(value));
+	}
+
+
+	template <typename T, typename Allocator>
+	template <class... Args>
+	inline bool mpmc_bounded_queue<T, Allocator>::try_emplace(Args&&... args)
+	{
+		size_type nPosition = mEnqueue.mnPosition.load(std::memory_order_relaxed);
+		cell_type* pCell;
+
+		for(;;)
+		{
+			pCell = mpCells + (nPosition & mnMask);
+
+			const SlotState state = DoGetSlotState(pCell->mnSequence.load(std::memory_order_acquire), nPosition);
+
+			if(state == kSlotReady)
+			{
+				if(mEnqueue.mnPosition.compare_exchange_weak(nPosition, nPosition + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if(state == kSlotEarly) // The consumer of the previous lap hasn't taken the element, so the queue is full.
+				return false;
+			else
+				nPosition = mEnqueue.mnPosition.load(std::memory_order_relaxed);
+		}
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				::new((void*)pCell->get_value()) value_type(eastl::forward<Args>(args)...);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				DoDiscard(nPosition, 1, false);
+				throw;
+			}
+		#endif
+
+		pCell->mnSequence.store(nPosition + 1, std::memory_order_release);
+		return true;
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename InputIterator>
+	inline typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::push_n(InputIterator first, size_type n)
+	{
+		size_type nPosition;
+		n = DoClaim(mEnqueue, 0, n, nPosition);
+
+		size_type i = 0;
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				for(; i < n; ++i, ++first)
+				{
+					cell_type* const pCell = mpCells + ((nPosition + i) & mnMask);
+
+					::new((void*)pCell->get_value()) value_type(*first);
+					pCell->mnSequence.store(nPosition + i + 1, std::memory_order_release);
+				}
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				DoDiscard(nPosition + i, n - i, false);
+				throw;
+			}
+		#endif
+
+		return n;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool mpmc_bounded_queue<T, Allocator>::try_pop(value_type& value)
+	{
+		size_type nPosition = mDequeue.mnPosition.load(std::memory_order_relaxed);
+		cell_type* pCell;
+
+		for(;;)
+		{
+			pCell = mpCells + (nPosition & mnMask);
+
+			const SlotState state = DoGetSlotState(pCell->mnSequence.load(std::memory_order_acquire), nPosition + 1);
+
+			if(state == kSlotReady)
+			{
+				if(mDequeue.mnPosition.compare_exchange_weak(nPosition, nPosition + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if(state == kSlotEarly) // The producer of this position hasn't stored its element, so the queue is empty.
+				return false;
+			else if(mDequeue.mnPosition.compare_exchange_weak(nPosition, nPosition + 1, std::memory_order_relaxed))
+				++nPosition; // No consumer had claimed the position, so its producer gave it up (see DoDiscard).
+		}
+
+		value_type* const pValue = pCell->get_value();
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				value = eastl::move(*pValue);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				DoDiscard(nPosition, 1, true);
+				throw;
+			}
+		#endif
+
+		pValue->~value_type();
+		pCell->mnSequence.store(nPosition + mnMask + 1, std::memory_order_release);
+		return true;
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename OutputIterator>
+	inline typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::pop_n(OutputIterator dest, size_type n)
+	{
+		size_type nPosition;
+		n = DoClaim(mDequeue, 1, n, nPosition);
+
+		size_type i = 0;
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				for(; i < n; ++i, ++dest)
+				{
+					cell_type* const  pCell  = mpCells + ((nPosition + i) & mnMask);
+					value_type* const pValue = pCell->get_value();
+
+					*dest = eastl::move(*pValue);
+					pValue->~value_type();
+					pCell->mnSequence.store(nPosition + i + mnMask + 1, std::memory_order_release);
+				}
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				DoDiscard(nPosition + i, n - i, true);
+				throw;
+			}
+		#endif
+
+		return n;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::size() const EA_NOEXCEPT
+	{
+		// The dequeue position is read first, so that the enqueue position can't be behind
+		// it. Positions which have been claimed but not yet published are counted, as are
+		// positions which a push gave up and no consumer has stepped over yet.
+		const size_type nDequeue = mDequeue.mnPosition.load(std::memory_order_acquire);
+		const size_type nEnqueue = mEnqueue.mnPosition.load(std::memory_order_acquire);
+		const size_type nSize    = nEnqueue - nDequeue;
+
+		return (nSize <= mnMask) ? nSize : (mnMask + 1); // Both may have moved on between the two reads.
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool mpmc_bounded_queue<T, Allocator>::empty() const EA_NOEXCEPT
+	{
+		return size() == 0;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::capacity() const EA_NOEXCEPT
+	{
+		return mnMask + 1;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline const typename mpmc_bounded_queue<T, Allocator>::allocator_type&
+	mpmc_bounded_queue<T, Allocator>::get_allocator() const EA_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void mpmc_bounded_queue<T, Allocator>::DoSetBuffer(cell_type* pCells, size_type nCapacity, bool bOwnsBuffer) EA_NOEXCEPT
+	{
+		for(size_type i = 0; i < nCapacity; i++)
+			::new((void*)&pCells[i].mnSequence) std::atomic<size_type>(i);
+
+		mpCells      = pCells;
+		mnMask       = nCapacity - 1;
+		mbOwnsBuffer = bOwnsBuffer;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void mpmc_bounded_queue<T, Allocator>::DoFreeBuffer()
+	{
+		if(mpCells)
+		{
+			const size_type nEnqueue = mEnqueue.mnPosition.load(std::memory_order_acquire);
+
+			// A position which a push gave up has no element. Its slot's sequence has moved on,
+			// and the slot may hold the element of the same position on the next lap instead.
+			for(size_type i = mDequeue.mnPosition.load(std::memory_order_acquire); i != nEnqueue; ++i)
+			{
+				cell_type& cell = mpCells[i & mnMask];
+
+				if(cell.mnSequence.load(std::memory_order_acquire) == (i + 1))
+					cell.get_value()->~value_type();
+			}
+
+			if(mbOwnsBuffer)
+				EASTLFree(mAllocator, mpCells, (mnMask + 1) * sizeof(cell_type));
+			mpCells = NULL;
+		}
+	}
+
+
+	// Compares a slot's sequence with the one that a thread claiming it expects. Early
+	// means the slot is still in use from the previous lap, and late means that other
+	// threads have claimed the position since it was read. For a consumer it can also
+	// mean that the position's producer gave it up, if no other consumer has claimed it.
+	template <typename T, typename Allocator>
+	inline typename mpmc_bounded_queue<T, Allocator>::SlotState
+	mpmc_bounded_queue<T, Allocator>::DoGetSlotState(size_type nSequence, size_type nExpected) EA_NOEXCEPT
+	{
+		typedef typename eastl::make_signed<size_type>::type difference_type;
+
+		const difference_type d = (difference_type)(nSequence - nExpected);
+		return (d == 0) ? kSlotReady : ((d < 0) ? kSlotEarly : kSlotLate);
+	}
+
+
+	// Claims up to nWanted consecutive positions, and returns how many it claimed and
+	// the first of them. Every slot of the run is checked to be ready before the claim.
+	// Only the thread which owns a position can change its slot's sequence, so the
+	// slots are still ready once the compare-and-swap succeeds.
+	template <typename T, typename Allocator>
+	inline typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::DoClaim(position_type& position, size_type nSequenceOffset, size_type nWanted, size_type& nPosition) EA_NOEXCEPT
+	{
+		if(nWanted > (mnMask + 1))
+			nWanted = mnMask + 1;
+
+		nPosition = position.mnPosition.load(std::memory_order_relaxed);
+
+		while(nWanted)
+		{
+			size_type n = 0;
+			SlotState state = kSlotReady;
+
+			while(n < nWanted)
+			{
+				const size_type nSlotPosition = nPosition + n;
+
+				state = DoGetSlotState(mpCells[nSlotPosition & mnMask].mnSequence.load(std::memory_order_acquire), nSlotPosition + nSequenceOffset);
+				if(state != kSlotReady)
+					break;
+				++n;
+			}
+
+			if(n)
+			{
+				if(position.mnPosition.compare_exchange_weak(nPosition, nPosition + n, std::memory_order_relaxed))
+					return n;
+			}
+			else if(state == kSlotEarly) // Full, when pushing, or empty, when popping.
+				return 0;
+			else if(nSequenceOffset == 0)
+				nPosition = position.mnPosition.load(std::memory_order_relaxed);
+			else if(position.mnPosition.compare_exchange_weak(nPosition, nPosition + 1, std::memory_order_relaxed))
+				++nPosition; // No consumer had claimed the position, so its producer gave it up (see DoDiscard).
+		}
+
+		return 0;
+	}
+
+
+	// Frees n claimed slots from nPosition on without handing on what they hold. A push
+	// calls it for the slots it has no element for, which sets them to the sequence a
+	// consumer would have left them with. A consumer reaching such a position finds
+	// its slot late while the dequeue position is still at it, and steps over it. A pop
+	// calls it for the elements it couldn't move out, which are destroyed.
+	template <typename T, typename Allocator>
+	inline void mpmc_bounded_queue<T, Allocator>::DoDiscard(size_type nPosition, size_type n, bool bDestroy) EA_NOEXCEPT
+	{
+		for(size_type i = 0; i < n; ++i)
+		{
+			cell_type* const pCell = mpCells + ((nPosition + i) & mnMask);
+
+			if(bDestroy)
+				pCell->get_value()->~value_type();
+			pCell->mnSequence.store(nPosition + i + mnMask + 1, std::memory_order_release);
+		}
+	}
+
+
+} // namespace eastl
@@ -1044,7 +1044,7 @@ namespace eastl
 
 			ContainerTemporary<Container> cTemp(c);
 			cTemp.get().resize(n + 1);
-			eastl::copy(begin(), end(), cTemp.get().begin());
+			eastl::move(begin(), end(), cTemp.get().begin()); // The old elements are discarded with the old container, so move rather than copy them.
 			eastl::swap(c, cTemp.get());
 
 			mBegin = c.begin();
@@ -1098,7 +1098,7 @@ namespace eastl
 				mSize = n;
 			}
 
-			eastl::copy(itCopyBegin, end(), cTemp.get().begin());  // The begin-end range may in fact be larger than n, in which case values will be overwritten.
+			eastl::move(itCopyBegin, end(), cTemp.get().begin());  // The begin-end range may in fact be larger than n, in which case values will be overwritten.
 			eastl::swap(c, cTemp.get());
 
 			mBegin = c.begin();
@@ -1118,7 +1118,7 @@ namespace eastl
 		{
 			ContainerTemporary<Container> cTemp(c);
 			cTemp.get().resize(n + 1);
-			eastl::copy(begin(), end(), cTemp.get().begin());
+			eastl::move(begin(), end(), cTemp.get().begin()); // The old elements are discarded with the old container, so move rather than copy them.
 			eastl::swap(c, cTemp.get());
 
 			mBegin = c.begin();
@@ -0,0 +1,458 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements spsc_ring_buffer, a bounded FIFO queue which passes
+// elements from one producer thread to one consumer thread without locks.
+// Unlike ring_buffer, it never overwrites old elements: a push into a full
+// buffer fails, and the producer decides whether to retry or drop the element.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/allocator.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/utility.h>
+#include <stddef.h>
+
+
+
+namespace eastl
+{
+	/// EASTL_SPSC_RING_BUFFER_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_SPSC_RING_BUFFER_DEFAULT_NAME
+		#define EASTL_SPSC_RING_BUFFER_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " spsc_ring_buffer" // Unless the user overrides something, this is "EASTL spsc_ring_buffer".
+	#endif
+
+	/// EASTL_SPSC_RING_BUFFER_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_SPSC_RING_BUFFER_DEFAULT_ALLOCATOR
+		#define EASTL_SPSC_RING_BUFFER_DEFAULT_ALLOCATOR allocator_type(EASTL_SPSC_RING_BUFFER_DEFAULT_NAME)
+	#endif
+
+
+
+	/// spsc_ring_buffer
+	///
+	/// A bounded queue for exactly one producer thread and one consumer thread. The
+	/// producer calls the push functions and the consumer calls the pop functions;
+	/// neither takes a lock or waits for the other.
+	///
+	/// The capacity is rounded up to a power of two, so that a position in the buffer
+	/// is found with a mask. The head and tail positions count up forever and are
+	/// only masked when the buffer is indexed, which lets a full buffer be told apart
+	/// from an empty one without a sentinel slot.
+	///
+	/// The tail, which only the producer writes, and the head, which only the consumer
+	/// writes, are kept on separate cache lines. Each side also keeps a private copy of
+	/// the other side's position and only reads the shared one when its copy says that
+	/// the buffer is full (or empty). When the two threads are working on different
+	/// parts of the buffer they therefore don't touch each other's cache lines at all.
+	///
+	/// push_n and pop_n move a batch of elements and publish them with a single store,
+	/// which is much cheaper per element than pushing them one at a time. They move as
+	/// many elements as there is room for (or as are available) and return the count.
+	///
+	/// If constructing or moving out an element throws, the buffer is left as if the
+	/// push or pop hadn't been called, except that push_n keeps the elements it stored
+	/// before the one which threw, and pop_n keeps the ones it moved out.
+	///
+	/// size and empty may be called from any thread, but when the producer or the
+	/// consumer is active they are only a snapshot.
+	///
+	/// Example usage:
+	///     spsc_ring_buffer<Job*> jobs(1024);
+	///
+	///     // Producer thread:
+	///     while(!jobs.try_push(pJob))
+	///         EA::Thread::ThreadSleep(0);
+	///
+	///     // Consumer thread:
+	///     Job* jobBatch[32];
+	///     for(size_t i = 0, n = jobs.pop_n(jobBatch, 32); i < n; i++)
+	///         jobBatch[i]->Run();
+	///
+	template <typename T, typename Allocator = EASTLAllocatorType>
+	class spsc_ring_buffer
+	{
+	public:
+		typedef spsc_ring_buffer<T, Allocator>  this_type;
+		typedef T                               value_type;
+		typedef T&                              reference;
+		typedef const T&                        const_reference;
+		typedef eastl_size_t                    size_type;
+		typedef Allocator                       allocator_type;
+
+	public:
+		explicit spsc_ring_buffer(size_type nCapacity, const allocator_type& allocator = EASTL_SPSC_RING_BUFFER_DEFAULT_ALLOCATOR);
+	   ~spsc_ring_buffer();
+
+		spsc_ring_buffer(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+		// Producer functions
+		bool try_push(const value_type& value);
+		bool try_push(value_type&& value);
+
+		template <class... Args>
+		bool try_emplace(Args&&... args);
+
+		template <typename InputIterator>
+		size_type push_n(InputIterator first, size_type n);
+
+		// Consumer functions
+		bool try_pop(value_type& value);
+
+		template <typename OutputIterator>
+		size_type pop_n(OutputIterator dest, size_type n);
+
+		// Functions which may be called from any thread.
+		size_type size() const EA_NOEXCEPT;
+		bool      empty() const EA_NOEXCEPT;
+		size_type capacity() const EA_NOEXCEPT;
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT;
+
+	protected:
+		struct buffer_storage_tag {};
+
+		// For fixed_spsc_ring_buffer, which calls DoSetBuffer with its own storage.
+		spsc_ring_buffer(buffer_storage_tag, const allocator_type& allocator);
+
+		void DoSetBuffer(value_type* pBuffer, size_type nCapacity, bool bOwnsBuffer) EA_NOEXCEPT;
+		void DoFreeBuffer();
+
+		size_type DoGetFreeCount(size_type nTail, size_type nWanted) EA_NOEXCEPT;
+		size_type DoGetReadyCount(size_type nHead, size_type nWanted) EA_NOEXCEPT;
+
+	protected:
+		// Written by the producer. mnHeadCache is the last value of the head that it read.
+		struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) producer_type
+		{
+			std::atomic<size_type> mnTail;
+			size_type              mnHeadCache;
+		} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+
+		// Written by the consumer. mnTailCache is the last value of the tail that it read.
+		struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) consumer_type
+		{
+			std::atomic<size_type> mnHead;
+			size_type              mnTailCache;
+		} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+
+		producer_type  mProducer;
+		consumer_type  mConsumer;
+		value_type*    mpBuffer;     // The members from here on are only written on construction, so both threads can share their cache line.
+		size_type      mnMask;       // The capacity minus one.
+		bool           mbOwnsBuffer; // False when the buffer is the storage of a fixed_spsc_ring_buffer.
+		allocator_type mAllocator;
+
+	}; // class spsc_ring_buffer
+
+
+
+	/// fixed_spsc_ring_buffer
+	///
+	/// An spsc_ring_buffer whose elements are stored within the object itself rather
+	/// than allocated. nCapacity must be a power of two.
+	///
+	/// Example usage:
+	///     fixed_spsc_ring_buffer<AudioCommand, 256> commands;
+	///     commands.try_push(AudioCommand(kStop));
+	///
+	template <typename T, size_t nCapacity>
+	class fixed_spsc_ring_buffer : public spsc_ring_buffer<T, dummy_allocator>
+	{
+		static_assert((nCapacity != 0) && ((nCapacity & (nCapacity - 1)) == 0), "fixed_spsc_ring_buffer capacity must be a power of two.");
+
+	public:
+		typedef spsc_ring_buffer<T, dummy_allocator>  base_type;
+		typedef fixed_spsc_ring_buffer<T, nCapacity>  this_type;
+		typedef typename base_type::value_type        value_type;
+		typedef typename base_type::size_type         size_type;
+
+		enum { kMaxSize = nCapacity };
+
+	public:
+		fixed_spsc_ring_buffer()
+			: base_type(typename base_type::buffer_storage_tag(), dummy_allocator())
+		{
+			base_type::DoSetBuffer(reinterpret_cast<value_type*>(mBuffer.mCharData), nCapacity, false);
+		}
+
+	   ~fixed_spsc_ring_buffer()
+		{
+			base_type::DoFreeBuffer(); // Destroy the remaining elements while mBuffer is still alive.
+		}
+
+	protected:
+		typename aligned_storage<sizeof(T) * nCapacity, EASTL_ALIGN_OF(T)>::type mBuffer;
+
+	}; // class fixed_spsc_ring_buffer
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// spsc_ring_buffer
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Allocator>
+	inline spsc_ring_buffer<T, Allocator>::spsc_ring_buffer(size_type nCapacity, const allocator_type& allocator)
+		: spsc_ring_buffer(buffer_storage_tag(), allocator)
+	{
+		EASTL_ASSERT(nCapacity != 0);
+
+		size_type nRoundedCapacity = 1;
+		while(nRoundedCapacity < nCapacity)
+			nRoundedCapacity *= 2;
+
+		value_type* const pBuffer = (value_type*)allocate_memory(mAllocator, nRoundedCapacity * sizeof(value_type), EASTL_ALIGN_OF(value_type), 0);
+		DoSetBuffer(pBuffer, nRoundedCapacity, true);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline spsc_ring_buffer<T, Allocator>::spsc_ring_buffer(buffer_storage_tag, const allocator_type& allocator)
+		: mpBuffer(NULL)
+		, mnMask(0)
+		, mbOwnsBuffer(false)
+		, mAllocator(allocator)
+	{
+		mProducer.mnTail.store(0, std::memory_order_relaxed);
+		mProducer.mnHeadCache = 0;
+		mConsumer.mnHead.store(0, std::memory_order_relaxed);
+		mConsumer.mnTailCache = 0;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline spsc_ring_buffer<T, Allocator>::~spsc_ring_buffer()
+	{
+		DoFreeBuffer();
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool spsc_ring_buffer<T, Allocator>::try_push(const value_type& value)
+	{
+		return try_emplace(value);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool spsc_ring_buffer<T, Allocator>::try_push(value_type&& value)
+	{
+		return try_emplace(eastl::move(value));
+	}
+
+
+	template <typename T, typename Allocator>
+	template <class... Args>
+	inline bool spsc_ring_buffer<T, Allocator>::try_emplace(Args&&... args)
+	{
+		const size_type nTail = mProducer.mnTail.load(std::memory_order_relaxed);
+
+		if(!DoGetFreeCount(nTail, 1))
+			return false;
+
+		::new((void*)(mpBuffer + (nTail & mnMask))) value_type(eastl::forward<Args>(args)...);
+		mProducer.mnTail.store(nTail + 1, std::memory_order_release);
+		return true;
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename InputIterator>
+	inline typename spsc_ring_buffer<T, Allocator>::size_type
+	spsc_ring_buffer<T, Allocator>::push_n(InputIterator first, size_type n)
+	{
+		const size_type nTail = mProducer.mnTail.load(std::memory_order_relaxed);
+
+		n = DoGetFreeCount(nTail, n);
+
+		size_type i = 0;
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				for(; i < n; ++i, ++first)
+					::new((void*)(mpBuffer + ((nTail + i) & mnMask))) value_type(*first);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				if(i)
+					mProducer.mnTail.store(nTail + i, std::memory_order_release);
+				throw;
+			}
+		#endif
+
+		if(n)
+			mProducer.mnTail.store(nTail + n, std::memory_order_release);
+		return n;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool spsc_ring_buffer<T, Allocator>::try_pop(value_type& value)
+	{
+		const size_type nHead = mConsumer.mnHead.load(std::memory_order_relaxed);
+
+		if(!DoGetReadyCount(nHead, 1))
+			return false;
+
+		value_type* const pValue = mpBuffer + (nHead & mnMask);
+
+		value = eastl::move(*pValue);
+		pValue->~value_type();
+		mConsumer.mnHead.store(nHead + 1, std::memory_order_release);
+		return true;
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename OutputIterator>
+	inline typename spsc_ring_buffer<T, Allocator>::size_type
+	spsc_ring_buffer<T, Allocator>::pop_n(OutputIterator dest, size_type n)
+	{
+		const size_type nHead = mConsumer.mnHead.load(std::memory_order_relaxed);
+
+		n = DoGetReadyCount(nHead, n);
+
+		size_type i = 0;
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				for(; i < n; ++i, ++dest)
+				{
+					value_type* const pValue = mpBuffer + ((nHead + i) & mnMask);
+
+					*dest = eastl::move(*pValue);
+					pValue->~value_type();
+				}
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				if(i) // The elements before i have been destroyed, so they mustn't be seen again.
+					mConsumer.mnHead.store(nHead + i, std::memory_order_release);
+				throw;
+			}
+		#endif
+
+		if(n)
+			mConsumer.mnHead.store(nHead + n, std::memory_order_release);
+		return n;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename spsc_ring_buffer<T, Allocator>::size_type
+	spsc_ring_buffer<T, Allocator>::size() const EA_NOEXCEPT
+	{
+		// The head is read first, so that the tail can't be behind it.
+		const size_type nHead = mConsumer.mnHead.load(std::memory_order_acquire);
+		const size_type nTail = mProducer.mnTail.load(std::memory_order_acquire);
+
+		return nTail - nHead;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool spsc_ring_buffer<T, Allocator>::empty() const EA_NOEXCEPT
+	{
+		return size() == 0;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename spsc_ring_buffer<T, Allocator>::size_type
+	spsc_ring_buffer<T, Allocator>::capacity() const EA_NOEXCEPT
+	{
+		return mnMask + 1;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline const typename spsc_ring_buffer<T, Allocator>::allocator_type&
+	spsc_ring_buffer<T, Allocator>::get_allocator() const EA_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void spsc_ring_buffer<T, Allocator>::DoSetBuffer(value_type* pBuffer, size_type nCapacity, bool bOwnsBuffer) EA_NOEXCEPT
+	{
+		mpBuffer     = pBuffer;
+		mnMask       = nCapacity - 1;
+		mbOwnsBuffer = bOwnsBuffer;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void spsc_ring_buffer<T, Allocator>::DoFreeBuffer()
+	{
+		if(mpBuffer)
+		{
+			const size_type nTail = mProducer.mnTail.load(std::memory_order_acquire);
+
+			for(size_type i = mConsumer.mnHead.load(std::memory_order_acquire); i != nTail; ++i)
+				mpBuffer[i & mnMask].~value_type();
+
+			if(mbOwnsBuffer)
+				EASTLFree(mAllocator, mpBuffer, (mnMask + 1) * sizeof(value_type));
+			mpBuffer = NULL;
+		}
+	}
+
+
+	// Returns how many of nWanted elements can be pushed at nTail. The head is only
+	// read from the consumer's cache line when the cached copy says there's too little room.
+	template <typename T, typename Allocator>
+	inline typename spsc_ring_buffer<T, Allocator>::size_type
+	spsc_ring_buffer<T, Allocator>::DoGetFreeCount(size_type nTail, size_type nWanted) EA_NOEXCEPT
+	{
+		size_type nFree = (mnMask + 1) - (nTail - mProducer.mnHeadCache);
+
+		if(nFree < nWanted)
+		{
+			mProducer.mnHeadCache = mConsumer.mnHead.load(std::memory_order_acquire);
+			nFree = (mnMask + 1) - (nTail - mProducer.mnHeadCache);
+		}
+
+		return (nFree < nWanted) ? nFree : nWanted;
+	}
+
+
+	// Returns how many of nWanted elements can be popped at nHead. The tail is only
+	// read from the producer's cache line when the cached copy says there are too few.
+	template <typename T, typename Allocator>
+	inline typename spsc_ring_buffer<T, Allocator>::size_type
+	spsc_ring_buffer<T, Allocator>::DoGetReadyCount(size_type nHead, size_type nWanted) EA_NOEXCEPT
+	{
+		size_type nReady = mConsumer.mnTailCache - nHead;
+
+		if(nReady < nWanted)
+		{
+			mConsumer.mnTailCache = mProducer.mnTail.load(std::memory_order_acquire);
+			nReady = mConsumer.mnTailCache - nHead;
+		}
+
+		return (nReady < nWanted) ? nReady : nWanted;
+	}
+
+
+} // namespace eastl
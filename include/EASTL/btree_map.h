@@ -0,0 +1,582 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements btree_map and btree_multimap, which have the interface
+// of map and multimap but store their values in a B-tree with wide nodes.
+// See internal/btree.h for how they differ from map and multimap, the most
+// important difference being that insert and erase invalidate iterators.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/btree.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#include <EASTL/tuple.h>
+#if EASTL_EXCEPTIONS_ENABLED
+#include <stdexcept>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_BTREE_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_MAP_DEFAULT_NAME
+		#define EASTL_BTREE_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree_map" // Unless the user overrides something, this is "EASTL btree_map".
+	#endif
+
+
+	/// EASTL_BTREE_MULTIMAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_MULTIMAP_DEFAULT_NAME
+		#define EASTL_BTREE_MULTIMAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree_multimap" // Unless the user overrides something, this is "EASTL btree_multimap".
+	#endif
+
+
+	/// EASTL_BTREE_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_MAP_DEFAULT_NAME)
+	#endif
+
+	/// EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_MULTIMAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// btree_map
+	///
+	/// Implements a map with the interface of eastl::map, whose values are stored many to a
+	/// node in a B-tree. Lookup and in-order iteration are faster than with map for all but
+	/// small containers or large values, and the memory used per element is much less.
+	///
+	/// Unlike map, insert and erase invalidate all iterators, pointers and references to
+	/// elements. If you hold on to iterators or pointers to elements across modifications
+	/// of the container, use map.
+	///
+	/// The large majority of the implementation of this class is found in the btree
+	/// base class. We control the behaviour of btree via template parameters.
+	///
+	/// nTargetNodeSize is the approximate size in bytes of a node, which sets how many
+	/// values a node holds. See EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE.
+	///
+	/// Example usage:
+	///     btree_map<int, Widget> widgetMap;
+	///     widgetMap.emplace(37, Widget());
+	///     for(auto& entry : widgetMap)
+	///         entry.second.Update();
+	///
+	template <typename Key, typename T, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType,
+			  size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree_map
+		: public btree<Key, eastl::pair<const Key, T>, Compare, Allocator, eastl::use_first<eastl::pair<const Key, T> >, true, true, nTargetNodeSize>
+	{
+	public:
+		typedef btree<Key, eastl::pair<const Key, T>, Compare, Allocator,
+					  eastl::use_first<eastl::pair<const Key, T> >, true, true, nTargetNodeSize> base_type;
+		typedef btree_map<Key, T, Compare, Allocator, nTargetNodeSize>                   this_type;
+		typedef typename base_type::size_type                                            size_type;
+		typedef typename base_type::key_type                                             key_type;
+		typedef T                                                                        mapped_type;
+		typedef typename base_type::value_type                                           value_type;
+		typedef typename base_type::node_type                                            node_type;
+		typedef typename base_type::iterator                                             iterator;
+		typedef typename base_type::const_iterator                                       const_iterator;
+		typedef typename base_type::allocator_type                                       allocator_type;
+		typedef typename base_type::insert_return_type                                   insert_return_type;
+		typedef typename base_type::extract_key                                          extract_key;
+		// Other types are inherited from the base class.
+
+		using base_type::begin;
+		using base_type::end;
+		using base_type::find;
+		using base_type::lower_bound;
+		using base_type::insert;
+
+	protected:
+		using base_type::mCompare;
+
+	public:
+		class value_compare
+		{
+		protected:
+			friend class btree_map;
+			Compare compare;
+			value_compare(Compare c) : compare(c) {}
+
+		public:
+			bool operator()(const value_type& x, const value_type& y) const
+				{ return compare(x.first, y.first); }
+		};
+
+	public:
+		btree_map(const allocator_type& allocator = EASTL_BTREE_MAP_DEFAULT_ALLOCATOR);
+		btree_map(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_MAP_DEFAULT_ALLOCATOR);
+		btree_map(const this_type& x);
+		btree_map(this_type&& x);
+		btree_map(this_type&& x, const allocator_type& allocator);
+		btree_map(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_BTREE_MAP_DEFAULT_ALLOCATOR);
+		btree_map(std::initializer_list<value_type> ilist, const allocator_type& allocator);
+
+		template <typename Iterator>
+		btree_map(Iterator itBegin, Iterator itEnd);
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		/// This is an extension to the C++ standard, as with map::insert(const Key&).
+		/// We insert a default-constructed element with the given key.
+		insert_return_type insert(const Key& key);
+
+		value_compare value_comp() const;
+
+		T& operator[](const Key& key);
+		T& operator[](Key&& key);
+
+		T& at(const Key& key);
+		const T& at(const Key& key) const;
+
+		/// The hint versions of try_emplace ignore the hint, which is of little use for a
+		/// btree as the search it saves touches only a few nodes.
+		template <class... Args> eastl::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args);
+		template <class... Args> eastl::pair<iterator, bool> try_emplace(key_type&& k, Args&&... args);
+		template <class... Args> iterator                    try_emplace(const_iterator position, const key_type& k, Args&&... args);
+		template <class... Args> iterator                    try_emplace(const_iterator position, key_type&& k, Args&&... args);
+
+	private:
+		template <class KFwd, class... Args>
+		eastl::pair<iterator, bool> try_emplace_forward(KFwd&& k, Args&&... args);
+	}; // btree_map
+
+
+
+
+
+
+	/// btree_multimap
+	///
+	/// Implements a multimap with the interface of eastl::multimap, whose values are stored
+	/// many to a node in a B-tree. As with multimap, values with equivalent keys are kept in
+	/// the order they were inserted. See btree_map.
+	///
+	template <typename Key, typename T, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType,
+			  size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree_multimap
+		: public btree<Key, eastl::pair<const Key, T>, Compare, Allocator, eastl::use_first<eastl::pair<const Key, T> >, true, false, nTargetNodeSize>
+	{
+	public:
+		typedef btree<Key, eastl::pair<const Key, T>, Compare, Allocator,
+					  eastl::use_first<eastl::pair<const Key, T> >, true, false, nTargetNodeSize> base_type;
+		typedef btree_multimap<Key, T, Compare, Allocator, nTargetNodeSize>               this_type;
+		typedef typename base_type::size_type                                             size_type;
+		typedef typename base_type::key_type                                              key_type;
+		typedef T                                                                         mapped_type;
+		typedef typename base_type::value_type                                            value_type;
+		typedef typename base_type::node_type                                             node_type;
+		typedef typename base_type::iterator                                              iterator;
+		typedef typename base_type::const_iterator                                        const_iterator;
+		typedef typename base_type::allocator_type                                        allocator_type;
+		typedef typename base_type::insert_return_type                                    insert_return_type;
+		typedef typename base_type::extract_key                                           extract_key;
+		// Other types are inherited from the base class.
+
+		using base_type::insert;
+
+	protected:
+		using base_type::mCompare;
+
+	public:
+		class value_compare
+		{
+		protected:
+			friend class btree_multimap;
+			Compare compare;
+			value_compare(Compare c) : compare(c) {}
+
+		public:
+			bool operator()(const value_type& x, const value_type& y) const
+				{ return compare(x.first, y.first); }
+		};
+
+	public:
+		btree_multimap(const allocator_type& allocator = EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR);
+		btree_multimap(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR);
+		btree_multimap(const this_type& x);
+		btree_multimap(this_type&& x);
+		btree_multimap(this_type&& x, const allocator_type& allocator);
+		btree_multimap(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR);
+		btree_multimap(std::initializer_list<value_type> ilist, const allocator_type& allocator);
+
+		template <typename Iterator>
+		btree_multimap(Iterator itBegin, Iterator itEnd);
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		/// This is an extension to the C++ standard, as with multimap::insert(const Key&).
+		insert_return_type insert(const Key& key);
+
+		value_compare value_comp() const;
+
+		/// equal_range_small
+		/// This is a special version of equal_range which is optimized for the
+		/// case of there being few or no duplicated keys in the tree.
+		eastl::pair<iterator, iterator>             equal_range_small(const Key& key);
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const Key& key) const;
+
+	private:
+		// these base member functions are not included in multimaps
+		using base_type::insert_or_assign;
+	}; // btree_multimap
+
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree_map
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_map<Key, T, Compare, Allocator, N>::btree_map(const allocator_type& allocator)
+		: base_type(allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_map<Key, T, Compare, Allocator, N>::btree_map(const Compare& compare, const allocator_type& allocator)
+		: base_type(compare, allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_map<Key, T, Compare, Allocator, N>::btree_map(const this_type& x)
+		: base_type(x)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_map<Key, T, Compare, Allocator, N>::btree_map(this_type&& x)
+		: base_type(eastl::move(x))
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_map<Key, T, Compare, Allocator, N>::btree_map(this_type&& x, const allocator_type& allocator)
+		: base_type(eastl::move(x), allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_map<Key, T, Compare, Allocator, N>::btree_map(std::initializer_list<value_type> ilist, const Compare& compare, const allocator_type& allocator)
+		: base_type(ilist.begin(), ilist.end(), compare, allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_map<Key, T, Compare, Allocator, N>::btree_map(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+		: base_type(ilist.begin(), ilist.end(), Compare(), allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	template <typename Iterator>
+	inline btree_map<Key, T, Compare, Allocator, N>::btree_map(Iterator itBegin, Iterator itEnd)
+		: base_type(itBegin, itEnd, Compare(), EASTL_BTREE_MAP_DEFAULT_ALLOCATOR)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline typename btree_map<Key, T, Compare, Allocator, N>::insert_return_type
+	btree_map<Key, T, Compare, Allocator, N>::insert(const Key& key)
+	{
+		return try_emplace_forward(key);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline typename btree_map<Key, T, Compare, Allocator, N>::value_compare
+	btree_map<Key, T, Compare, Allocator, N>::value_comp() const
+	{
+		return value_compare(mCompare);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline T& btree_map<Key, T, Compare, Allocator, N>::operator[](const Key& key)
+	{
+		return try_emplace_forward(key).first->second;
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline T& btree_map<Key, T, Compare, Allocator, N>::operator[](Key&& key)
+	{
+		return try_emplace_forward(eastl::move(key)).first->second;
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline T& btree_map<Key, T, Compare, Allocator, N>::at(const Key& key)
+	{
+		// use the use const version of ::at to remove duplication
+		return const_cast<T&>(const_cast<this_type const*>(this)->at(key));
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline const T& btree_map<Key, T, Compare, Allocator, N>::at(const Key& key) const
+	{
+		const_iterator candidate = this->find(key);
+
+		if (candidate == end())
+		{
+			#if EASTL_EXCEPTIONS_ENABLED
+				throw std::out_of_range("btree_map::at key does not exist");
+			#else
+				EASTL_FAIL_MSG("btree_map::at key does not exist");
+			#endif
+		}
+
+		return candidate->second;
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	template <class... Args>
+	inline eastl::pair<typename btree_map<Key, T, Compare, Allocator, N>::iterator, bool>
+	btree_map<Key, T, Compare, Allocator, N>::try_emplace(const key_type& key, Args&&... args)
+	{
+		return try_emplace_forward(key, eastl::forward<Args>(args)...);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	template <class... Args>
+	inline eastl::pair<typename btree_map<Key, T, Compare, Allocator, N>::iterator, bool>
+	btree_map<Key, T, Compare, Allocator, N>::try_emplace(key_type&& key, Args&&... args)
+	{
+		return try_emplace_forward(eastl::move(key), eastl::forward<Args>(args)...);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	template <class... Args>
+	inline typename btree_map<Key, T, Compare, Allocator, N>::iterator
+	btree_map<Key, T, Compare, Allocator, N>::try_emplace(const_iterator /*hint*/, const key_type& key, Args&&... args)
+	{
+		return try_emplace_forward(key, eastl::forward<Args>(args)...).first;
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	template <class... Args>
+	inline typename btree_map<Key, T, Compare, Allocator, N>::iterator
+	btree_map<Key, T, Compare, Allocator, N>::try_emplace(const_iterator /*hint*/, key_type&& key, Args&&... args)
+	{
+		return try_emplace_forward(eastl::move(key), eastl::forward<Args>(args)...).first;
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	template <class KFwd, class... Args>
+	inline eastl::pair<typename btree_map<Key, T, Compare, Allocator, N>::iterator, bool>
+	btree_map<Key, T, Compare, Allocator, N>::try_emplace_forward(KFwd&& key, Args&&... args)
+	{
+		// The key is only compared against before the value is constructed, so it can be
+		// forwarded into the value even though the search uses it.
+		return base_type::DoInsertUnique(key, piecewise_construct, eastl::forward_as_tuple(eastl::forward<KFwd>(key)),
+										 eastl::forward_as_tuple(eastl::forward<Args>(args)...));
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/map/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class T, class Compare, class Allocator, size_t N, class Predicate>
+	typename btree_map<Key, T, Compare, Allocator, N>::size_type erase_if(btree_map<Key, T, Compare, Allocator, N>& c, Predicate predicate)
+	{
+		// Erase invalidates end(), so unlike map's erase_if we can't hold on to it.
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree_multimap
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_multimap<Key, T, Compare, Allocator, N>::btree_multimap(const allocator_type& allocator)
+		: base_type(allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_multimap<Key, T, Compare, Allocator, N>::btree_multimap(const Compare& compare, const allocator_type& allocator)
+		: base_type(compare, allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_multimap<Key, T, Compare, Allocator, N>::btree_multimap(const this_type& x)
+		: base_type(x)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_multimap<Key, T, Compare, Allocator, N>::btree_multimap(this_type&& x)
+		: base_type(eastl::move(x))
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_multimap<Key, T, Compare, Allocator, N>::btree_multimap(this_type&& x, const allocator_type& allocator)
+		: base_type(eastl::move(x), allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_multimap<Key, T, Compare, Allocator, N>::btree_multimap(std::initializer_list<value_type> ilist, const Compare& compare, const allocator_type& allocator)
+		: base_type(ilist.begin(), ilist.end(), compare, allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline btree_multimap<Key, T, Compare, Allocator, N>::btree_multimap(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+		: base_type(ilist.begin(), ilist.end(), Compare(), allocator)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	template <typename Iterator>
+	inline btree_multimap<Key, T, Compare, Allocator, N>::btree_multimap(Iterator itBegin, Iterator itEnd)
+		: base_type(itBegin, itEnd, Compare(), EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR)
+	{
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline typename btree_multimap<Key, T, Compare, Allocator, N>::insert_return_type
+	btree_multimap<Key, T, Compare, Allocator, N>::insert(const Key& key)
+	{
+		return base_type::DoInsertMulti(key, piecewise_construct, eastl::forward_as_tuple(key), eastl::forward_as_tuple());
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline typename btree_multimap<Key, T, Compare, Allocator, N>::value_compare
+	btree_multimap<Key, T, Compare, Allocator, N>::value_comp() const
+	{
+		return value_compare(mCompare);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline eastl::pair<typename btree_multimap<Key, T, Compare, Allocator, N>::iterator,
+					   typename btree_multimap<Key, T, Compare, Allocator, N>::iterator>
+	btree_multimap<Key, T, Compare, Allocator, N>::equal_range_small(const Key& key)
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const iterator itLower(base_type::lower_bound(key));
+		iterator       itUpper(itLower);
+
+		while((itUpper != base_type::end()) && !mCompare(key, itUpper->first))
+			++itUpper;
+
+		return eastl::pair<iterator, iterator>(itLower, itUpper);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t N>
+	inline eastl::pair<typename btree_multimap<Key, T, Compare, Allocator, N>::const_iterator,
+					   typename btree_multimap<Key, T, Compare, Allocator, N>::const_iterator>
+	btree_multimap<Key, T, Compare, Allocator, N>::equal_range_small(const Key& key) const
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const const_iterator itLower(base_type::lower_bound(key));
+		const_iterator       itUpper(itLower);
+
+		while((itUpper != base_type::end()) && !mCompare(key, itUpper->first))
+			++itUpper;
+
+		return eastl::pair<const_iterator, const_iterator>(itLower, itUpper);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/multimap/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class T, class Compare, class Allocator, size_t N, class Predicate>
+	typename btree_multimap<Key, T, Compare, Allocator, N>::size_type erase_if(btree_multimap<Key, T, Compare, Allocator, N>& c, Predicate predicate)
+	{
+		// Erase invalidates end(), so unlike multimap's erase_if we can't hold on to it.
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+} // namespace eastl
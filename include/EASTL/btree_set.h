@@ -0,0 +1,385 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements btree_set and btree_multiset, which have the interface
+// of set and multiset but store their values in a B-tree with wide nodes.
+// See internal/btree.h for how they differ from set and multiset, the most
+// important difference being that insert and erase invalidate iterators.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/btree.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+
+
+namespace eastl
+{
+
+	/// EASTL_BTREE_SET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_SET_DEFAULT_NAME
+		#define EASTL_BTREE_SET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree_set" // Unless the user overrides something, this is "EASTL btree_set".
+	#endif
+
+
+	/// EASTL_BTREE_MULTISET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_MULTISET_DEFAULT_NAME
+		#define EASTL_BTREE_MULTISET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree_multiset" // Unless the user overrides something, this is "EASTL btree_multiset".
+	#endif
+
+
+	/// EASTL_BTREE_SET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_SET_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_SET_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_SET_DEFAULT_NAME)
+	#endif
+
+	/// EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_MULTISET_DEFAULT_NAME)
+	#endif
+
+
+
+	/// btree_set
+	///
+	/// Implements a set with the interface of eastl::set, whose values are stored many to a
+	/// node in a B-tree. Lookup and in-order iteration are faster than with set for all but
+	/// small containers or large values, and the memory used per element is much less.
+	///
+	/// Unlike set, insert and erase invalidate all iterators, pointers and references to
+	/// elements. As with set, iterator is a const iterator.
+	///
+	/// nTargetNodeSize is the approximate size in bytes of a node, which sets how many
+	/// values a node holds. See EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE.
+	///
+	template <typename Key, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType,
+			  size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree_set
+		: public btree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, true, nTargetNodeSize>
+	{
+	public:
+		typedef btree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, true, nTargetNodeSize> base_type;
+		typedef btree_set<Key, Compare, Allocator, nTargetNodeSize>                                     this_type;
+		typedef typename base_type::size_type                                                           size_type;
+		typedef typename base_type::value_type                                                          value_type;
+		typedef typename base_type::iterator                                                            iterator;
+		typedef typename base_type::const_iterator                                                      const_iterator;
+		typedef typename base_type::reverse_iterator                                                    reverse_iterator;
+		typedef typename base_type::const_reverse_iterator                                              const_reverse_iterator;
+		typedef typename base_type::allocator_type                                                      allocator_type;
+		typedef Compare                                                                                 value_compare;
+		// Other types are inherited from the base class.
+
+	protected:
+		using base_type::mCompare;
+
+	public:
+		btree_set(const allocator_type& allocator = EASTL_BTREE_SET_DEFAULT_ALLOCATOR);
+		btree_set(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_SET_DEFAULT_ALLOCATOR);
+		btree_set(const this_type& x);
+		btree_set(this_type&& x);
+		btree_set(this_type&& x, const allocator_type& allocator);
+		btree_set(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_BTREE_SET_DEFAULT_ALLOCATOR);
+		btree_set(std::initializer_list<value_type> ilist, const allocator_type& allocator);
+
+		template <typename Iterator>
+		btree_set(Iterator itBegin, Iterator itEnd);
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		value_compare value_comp() const { return mCompare; }
+
+	private:
+		// these base member functions are not included in sets
+		using base_type::insert_or_assign;
+	}; // btree_set
+
+
+
+	/// btree_multiset
+	///
+	/// Implements a multiset with the interface of eastl::multiset, whose values are stored
+	/// many to a node in a B-tree. As with multiset, equivalent values are kept in the order
+	/// they were inserted. See btree_set.
+	///
+	template <typename Key, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType,
+			  size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree_multiset
+		: public btree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, false, nTargetNodeSize>
+	{
+	public:
+		typedef btree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, false, nTargetNodeSize> base_type;
+		typedef btree_multiset<Key, Compare, Allocator, nTargetNodeSize>                                 this_type;
+		typedef typename base_type::size_type                                                            size_type;
+		typedef typename base_type::value_type                                                           value_type;
+		typedef typename base_type::iterator                                                             iterator;
+		typedef typename base_type::const_iterator                                                       const_iterator;
+		typedef typename base_type::reverse_iterator                                                     reverse_iterator;
+		typedef typename base_type::const_reverse_iterator                                               const_reverse_iterator;
+		typedef typename base_type::allocator_type                                                       allocator_type;
+		typedef Compare                                                                                  value_compare;
+		// Other types are inherited from the base class.
+
+	protected:
+		using base_type::mCompare;
+
+	public:
+		btree_multiset(const allocator_type& allocator = EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR);
+		btree_multiset(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR);
+		btree_multiset(const this_type& x);
+		btree_multiset(this_type&& x);
+		btree_multiset(this_type&& x, const allocator_type& allocator);
+		btree_multiset(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR);
+		btree_multiset(std::initializer_list<value_type> ilist, const allocator_type& allocator);
+
+		template <typename Iterator>
+		btree_multiset(Iterator itBegin, Iterator itEnd);
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		value_compare value_comp() const { return mCompare; }
+
+		/// equal_range_small
+		/// This is a special version of equal_range which is optimized for the
+		/// case of there being few or no duplicated keys in the tree.
+		eastl::pair<iterator, iterator>             equal_range_small(const Key& key);
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const Key& key) const;
+
+	private:
+		// these base member functions are not included in multisets
+		using base_type::insert_or_assign;
+	}; // btree_multiset
+
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree_set
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_set<Key, Compare, Allocator, N>::btree_set(const allocator_type& allocator)
+		: base_type(allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_set<Key, Compare, Allocator, N>::btree_set(const Compare& compare, const allocator_type& allocator)
+		: base_type(compare, allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_set<Key, Compare, Allocator, N>::btree_set(const this_type& x)
+		: base_type(x)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_set<Key, Compare, Allocator, N>::btree_set(this_type&& x)
+		: base_type(eastl::move(x))
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_set<Key, Compare, Allocator, N>::btree_set(this_type&& x, const allocator_type& allocator)
+		: base_type(eastl::move(x), allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_set<Key, Compare, Allocator, N>::btree_set(std::initializer_list<value_type> ilist, const Compare& compare, const allocator_type& allocator)
+		: base_type(ilist.begin(), ilist.end(), compare, allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_set<Key, Compare, Allocator, N>::btree_set(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+		: base_type(ilist.begin(), ilist.end(), Compare(), allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	template <typename Iterator>
+	inline btree_set<Key, Compare, Allocator, N>::btree_set(Iterator itBegin, Iterator itEnd)
+		: base_type(itBegin, itEnd, Compare(), EASTL_BTREE_SET_DEFAULT_ALLOCATOR)
+	{
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/set/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class Compare, class Allocator, size_t N, class Predicate>
+	typename btree_set<Key, Compare, Allocator, N>::size_type erase_if(btree_set<Key, Compare, Allocator, N>& c, Predicate predicate)
+	{
+		// Erase invalidates end(), so unlike set's erase_if we can't hold on to it.
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree_multiset
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_multiset<Key, Compare, Allocator, N>::btree_multiset(const allocator_type& allocator)
+		: base_type(allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_multiset<Key, Compare, Allocator, N>::btree_multiset(const Compare& compare, const allocator_type& allocator)
+		: base_type(compare, allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_multiset<Key, Compare, Allocator, N>::btree_multiset(const this_type& x)
+		: base_type(x)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_multiset<Key, Compare, Allocator, N>::btree_multiset(this_type&& x)
+		: base_type(eastl::move(x))
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_multiset<Key, Compare, Allocator, N>::btree_multiset(this_type&& x, const allocator_type& allocator)
+		: base_type(eastl::move(x), allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_multiset<Key, Compare, Allocator, N>::btree_multiset(std::initializer_list<value_type> ilist, const Compare& compare, const allocator_type& allocator)
+		: base_type(ilist.begin(), ilist.end(), compare, allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline btree_multiset<Key, Compare, Allocator, N>::btree_multiset(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+		: base_type(ilist.begin(), ilist.end(), Compare(), allocator)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	template <typename Iterator>
+	inline btree_multiset<Key, Compare, Allocator, N>::btree_multiset(Iterator itBegin, Iterator itEnd)
+		: base_type(itBegin, itEnd, Compare(), EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR)
+	{
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline eastl::pair<typename btree_multiset<Key, Compare, Allocator, N>::iterator,
+					   typename btree_multiset<Key, Compare, Allocator, N>::iterator>
+	btree_multiset<Key, Compare, Allocator, N>::equal_range_small(const Key& key)
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const iterator itLower(base_type::lower_bound(key));
+		iterator       itUpper(itLower);
+
+		while((itUpper != base_type::end()) && !mCompare(key, *itUpper))
+			++itUpper;
+
+		return eastl::pair<iterator, iterator>(itLower, itUpper);
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t N>
+	inline eastl::pair<typename btree_multiset<Key, Compare, Allocator, N>::const_iterator,
+					   typename btree_multiset<Key, Compare, Allocator, N>::const_iterator>
+	btree_multiset<Key, Compare, Allocator, N>::equal_range_small(const Key& key) const
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const const_iterator itLower(base_type::lower_bound(key));
+		const_iterator       itUpper(itLower);
+
+		while((itUpper != base_type::end()) && !mCompare(key, *itUpper))
+			++itUpper;
+
+		return eastl::pair<const_iterator, const_iterator>(itLower, itUpper);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/multiset/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class Compare, class Allocator, size_t N, class Predicate>
+	typename btree_multiset<Key, Compare, Allocator, N>::size_type erase_if(btree_multiset<Key, Compare, Allocator, N>& c, Predicate predicate)
+	{
+		// Erase invalidates end(), so unlike multiset's erase_if we can't hold on to it.
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+} // namespace eastl
@@ -0,0 +1,381 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the C++17 <charconv> functions to_chars and from_chars.
+//
+// These are non-throwing conversions between numbers and character ranges,
+// intended for serialization rather than for human-readable formatting. The
+// primary differences from the C++17 standard are:
+//    - errc is an eastl enum with only the values that these functions can
+//      report. Its values are those of the corresponding std::errc values.
+//    - Floating point to_chars without a precision produces the shortest
+//      output that round-trips, computed with the Grisu3 algorithm. The
+//      rare values Grisu3 can't decide fall back to an exact search.
+//    - Conversions with a precision, hexadecimal conversions and long double
+//      conversions (when long double is larger than double) are done by the
+//      C library's vsnprintf rather than the user-supplied Vsnprintf which
+//      the rest of EASTL uses, as they need exactly rounded output. The
+//      C locale's decimal point which vsnprintf writes is replaced with '.',
+//      so this output doesn't depend on the locale. vsnprintf also needs room
+//      for a terminating null, so output of 512 or more characters which
+//      exactly fills the range is formatted into a temporary allocation from
+//      the default EASTL allocator. No other conversion allocates.
+//    - Floating point from_chars handles the common case of up to 19 digit
+//      values with small exponents exactly and directly. Other values are
+//      converted by strtod on a bounded stack copy of the input, so the
+//      conversion is locale-dependent in that case if the C locale has been
+//      changed from "C".
+//
+// Integer conversions are templates implemented here; floating point
+// conversions are implemented in charconv.cpp.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <EABase/eabase.h>
+#include <EASTL/internal/config.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/numeric_limits.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+	#include <errno.h>
+	#include <string.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+namespace eastl
+{
+
+	/// chars_format
+	///
+	/// Selects the notation of floating point to_chars and from_chars.
+	///
+	enum class chars_format
+	{
+		scientific = 0x1,
+		fixed      = 0x2,
+		hex        = 0x4,
+		general    = fixed | scientific
+	};
+
+
+	/// errc
+	///
+	/// The error codes reported by to_chars and from_chars. A value-initialized
+	/// errc (errc()) indicates success, as with std::errc.
+	///
+	enum class errc
+	{
+		invalid_argument    = EINVAL,
+		result_out_of_range = ERANGE,
+		value_too_large     = EOVERFLOW
+	};
+
+
+	/// to_chars_result
+	///
+	/// On success ptr is one past the last character written and ec is errc().
+	/// On failure ptr is last and ec is errc::value_too_large; the contents of
+	/// the range are unspecified.
+	///
+	struct to_chars_result
+	{
+		char* ptr;
+		errc  ec;
+
+		#if defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+			friend bool operator==(const to_chars_result&, const to_chars_result&) = default;
+		#endif
+	};
+
+
+	/// from_chars_result
+	///
+	/// On success ptr is one past the last character parsed and ec is errc().
+	/// If no number could be parsed, ptr is first and ec is errc::invalid_argument.
+	/// If the number doesn't fit in the type, ptr is one past the number and ec
+	/// is errc::result_out_of_range. The value is unmodified on failure.
+	///
+	struct from_chars_result
+	{
+		const char* ptr;
+		errc        ec;
+
+		#if defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+			friend bool operator==(const from_chars_result&, const from_chars_result&) = default;
+		#endif
+	};
+
+
+
+	namespace Internal
+	{
+		/// gCharConvDigitPairs
+		///
+		/// "00010203...9899". Writing two digits per division halves the number
+		/// of divisions needed to format an integer.
+		///
+		extern EASTL_API const char gCharConvDigitPairs[200];
+
+
+		template <typename T>
+		struct is_char_conv_integral
+			: public integral_constant<bool, is_integral<T>::value && !is_same<typename remove_cv<T>::type, bool>::value> {};
+
+
+		// Unsigned types narrower than 32 bits are formatted and parsed as uint32_t.
+		template <typename U>
+		struct char_conv_unsigned
+			{ typedef typename conditional<(sizeof(U) < sizeof(uint32_t)), uint32_t, U>::type type; };
+
+
+		template <typename T>
+		inline bool CharConvIsNegative(T value, true_type)  { return value < 0; }
+
+		template <typename T>
+		inline bool CharConvIsNegative(T, false_type)       { return false; }
+
+
+		// Returns the number of decimal digits in value, which is at least 1.
+		template <typename U>
+		inline int CharConvCountDigits10(U value)
+		{
+			for(int n = 1; ; n += 4)
+			{
+				if(value < 10u)
+					return n;
+				if(value < 100u)
+					return n + 1;
+				if(value < 1000u)
+					return n + 2;
+				if(value < 10000u)
+					return n + 3;
+				value /= 10000u;
+			}
+		}
+
+
+		// Writes the decimal digits of value backwards, ending just before pEnd.
+		template <typename U>
+		inline void CharConvWriteDigits10(char* pEnd, U value)
+		{
+			while(value >= 100u)
+			{
+				const unsigned i = (unsigned)(value % 100u) * 2;
+				value /= 100u;
+				*--pEnd = gCharConvDigitPairs[i + 1];
+				*--pEnd = gCharConvDigitPairs[i];
+			}
+
+			if(value >= 10u)
+			{
+				const unsigned i = (unsigned)value * 2;
+				*--pEnd = gCharConvDigitPairs[i + 1];
+				*--pEnd = gCharConvDigitPairs[i];
+			}
+			else
+				*--pEnd = (char)('0' + (unsigned)value);
+		}
+
+
+		template <typename U>
+		to_chars_result ToCharsUnsigned(char* first, char* last, U value, int base)
+		{
+			if(base == 10)
+			{
+				const int n = CharConvCountDigits10(value);
+
+				if((last - first) < n)
+					return { last, errc::value_too_large };
+
+				CharConvWriteDigits10(first + n, value);
+				return { first + n, errc() };
+			}
+			else
+			{
+				// Other bases are written backwards into a buffer large enough for base 2.
+				char  buffer[sizeof(U) * 8];
+				char* p = buffer + sizeof(buffer);
+
+				do {
+					*--p = "0123456789abcdefghijklmnopqrstuvwxyz"[value % (unsigned)base];
+					value /= (unsigned)base;
+				} while(value);
+
+				const ptrdiff_t n = (buffer + sizeof(buffer)) - p;
+
+				if((last - first) < n)
+					return { last, errc::value_too_large };
+
+				memcpy(first, p, (size_t)n);
+				return { first + n, errc() };
+			}
+		}
+
+
+		// Returns the value of c as a digit in base 36, or 36 if c isn't a digit.
+		inline unsigned CharConvDigitValue(char c)
+		{
+			if((c >= '0') && (c <= '9'))
+				return (unsigned)(c - '0');
+			if((c >= 'a') && (c <= 'z'))
+				return (unsigned)(c - 'a') + 10;
+			if((c >= 'A') && (c <= 'Z'))
+				return (unsigned)(c - 'A') + 10;
+			return 36;
+		}
+
+
+		// Parses digits from p, accumulating them into result. Returns the end of the digits.
+		// bOverflow is set if the value exceeds the range of U, in which case the
+		// remaining digits are consumed but result is no longer meaningful.
+		template <typename U>
+		EA_FORCE_INLINE const char* FromCharsUnsigned(const char* p, const char* last, U& result, bool& bOverflow, unsigned base)
+		{
+			const U kMaxValue = eastl::numeric_limits<U>::max();
+
+			for(; p != last; ++p)
+			{
+				const unsigned digit = (base <= 10) ? (unsigned)((unsigned char)*p - (unsigned char)'0') : CharConvDigitValue(*p);
+
+				if(digit >= base)
+					break;
+
+				if(result > ((kMaxValue - digit) / base))
+					bOverflow = true;
+				else if(!bOverflow)
+					result = (U)((result * base) + digit);
+			}
+
+			return p;
+		}
+
+	} // namespace Internal
+
+
+
+	/// to_chars (integer)
+	///
+	/// Writes value in the given base (2 to 36) into [first, last), with a leading
+	/// '-' if negative and lower case letters for digits above 9. No null
+	/// terminator is written.
+	///
+	/// Example usage:
+	///     char buffer[32];
+	///     to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), 1234);
+	///     if(result.ec == errc())
+	///         puts(string_view(buffer, result.ptr - buffer));
+	///
+	template <typename T>
+	typename enable_if<Internal::is_char_conv_integral<T>::value, to_chars_result>::type
+	to_chars(char* first, char* last, T value, int base = 10)
+	{
+		EASTL_ASSERT((base >= 2) && (base <= 36));
+
+		typedef typename Internal::char_conv_unsigned<typename make_unsigned<T>::type>::type U;
+
+		U uValue = (U)(typename make_unsigned<T>::type)value;
+
+		if(Internal::CharConvIsNegative(value, is_signed<T>()))
+		{
+			if(first == last)
+				return { last, errc::value_too_large };
+
+			*first++ = '-';
+			uValue = (U)(typename make_unsigned<T>::type)(0u - (typename make_unsigned<T>::type)value);
+		}
+
+		return Internal::ToCharsUnsigned(first, last, uValue, base);
+	}
+
+	to_chars_result to_chars(char* first, char* last, bool value, int base = 10) = delete;
+
+
+	/// to_chars (floating point)
+	///
+	/// The versions without a format write the shortest representation that
+	/// from_chars converts back to the same value, in fixed or scientific
+	/// notation, whichever is shorter (fixed on a tie). The version with a format
+	/// writes the shortest representation in that format, where general uses
+	/// scientific notation for exponents less than -4 or at least 6, as %g does.
+	/// The version with a precision is the equivalent of printf with the
+	/// %f, %e, %a (with no leading "0x") or %g specifier.
+	///
+	EASTL_API to_chars_result to_chars(char* first, char* last, float value);
+	EASTL_API to_chars_result to_chars(char* first, char* last, double value);
+	EASTL_API to_chars_result to_chars(char* first, char* last, long double value);
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, float value, chars_format fmt);
+	EASTL_API to_chars_result to_chars(char* first, char* last, double value, chars_format fmt);
+	EASTL_API to_chars_result to_chars(char* first, char* last, long double value, chars_format fmt);
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, float value, chars_format fmt, int precision);
+	EASTL_API to_chars_result to_chars(char* first, char* last, double value, chars_format fmt, int precision);
+	EASTL_API to_chars_result to_chars(char* first, char* last, long double value, chars_format fmt, int precision);
+
+
+
+	/// from_chars (integer)
+	///
+	/// Parses an integer in the given base (2 to 36) from the start of [first, last).
+	/// A leading '-' is accepted only for signed types. Unlike strtol, leading
+	/// whitespace, a leading '+' and a "0x" prefix are not accepted.
+	///
+	template <typename T>
+	typename enable_if<Internal::is_char_conv_integral<T>::value, from_chars_result>::type
+	from_chars(const char* first, const char* last, T& value, int base = 10)
+	{
+		EASTL_ASSERT((base >= 2) && (base <= 36));
+
+		typedef typename make_unsigned<T>::type                            UT;
+		typedef typename Internal::char_conv_unsigned<UT>::type            U;
+
+		const char* p         = first;
+		bool        bNegative = false;
+
+		if(eastl::is_signed<T>::value && (p != last) && (*p == '-'))
+		{
+			bNegative = true;
+			++p;
+		}
+
+		U           result    = 0;
+		bool        bOverflow = false;
+		const char* pDigits   = p;
+
+		if(base == 10) // Separate call so that the base is a constant.
+			p = Internal::FromCharsUnsigned<U>(p, last, result, bOverflow, 10);
+		else
+			p = Internal::FromCharsUnsigned<U>(p, last, result, bOverflow, (unsigned)base);
+
+		if(p == pDigits)
+			return { first, errc::invalid_argument };
+
+		const U kMaxMagnitude = bNegative ? ((U)(UT)eastl::numeric_limits<T>::max() + 1) : (U)(UT)eastl::numeric_limits<T>::max();
+
+		if(bOverflow || (result > kMaxMagnitude))
+			return { p, errc::result_out_of_range };
+
+		value = bNegative ? (T)(UT)(0u - (UT)result) : (T)(UT)result;
+		return { p, errc() };
+	}
+
+	from_chars_result from_chars(const char* first, const char* last, bool& value, int base = 10) = delete;
+
+
+	/// from_chars (floating point)
+	///
+	/// Parses a floating point value in the given format from the start of [first, last).
+	/// As with strtod, "inf", "infinity" and "nan" are accepted in any case. Unlike strtod,
+	/// leading whitespace, a leading '+' and (for chars_format::hex) a "0x" prefix are not
+	/// accepted. chars_format::scientific requires an exponent and chars_format::fixed
+	/// doesn't parse one.
+	///
+	EASTL_API from_chars_result from_chars(const char* first, const char* last, float& value, chars_format fmt = chars_format::general);
+	EASTL_API from_chars_result from_chars(const char* first, const char* last, double& value, chars_format fmt = chars_format::general);
+	EASTL_API from_chars_result from_chars(const char* first, const char* last, long double& value, chars_format fmt = chars_format::general);
+
+} // namespace eastl
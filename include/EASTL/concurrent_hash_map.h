@@ -0,0 +1,509 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements concurrent_hash_map, a hash_map which may be used from
+// several threads at once. Keys are split by hash code across a fixed number
+// of shards, each of which is an ordinary hash_map guarded by its own reader/
+// writer spinlock, so that threads working on different shards don't contend.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#include <EASTL/tuple.h>
+
+
+
+namespace eastl
+{
+
+	/// EASTL_CONCURRENT_HASH_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_CONCURRENT_HASH_MAP_DEFAULT_NAME
+		#define EASTL_CONCURRENT_HASH_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " concurrent_hash_map" // Unless the user overrides something, this is "EASTL concurrent_hash_map".
+	#endif
+
+
+	/// EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_CONCURRENT_HASH_MAP_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT
+	///
+	/// The default number of shards. This should be a few times the number of
+	/// threads expected to use a container at once, so that two threads rarely
+	/// need the same shard. It must be a power of two.
+	///
+	#ifndef EASTL_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT
+		#define EASTL_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT 64
+	#endif
+
+
+
+	/// concurrent_hash_map
+	///
+	/// A hash map which may be read and written by several threads at once without
+	/// external locking. The keys are split across nShardCount independent hash_map
+	/// shards by their hash code. Each shard has its own reader/writer spinlock, and
+	/// each shard is aligned to a cache line so that the locks of neighbouring shards
+	/// don't share one. Lookups take their shard's lock for reading and modifications
+	/// take it for writing, so threads only wait for each other when they use the
+	/// same shard at the same time and at least one of them is modifying it.
+	///
+	/// Because another thread may erase an element at any time, the container doesn't
+	/// hand out iterators or references. Instead, find copies the mapped value out,
+	/// and visit calls a function on an element while its shard is locked. Such a
+	/// function must not call back into the same container, since the locks are not
+	/// recursive. It should also be short, as it blocks other users of the shard.
+	///
+	/// The key is hashed once per call, outside of the lock. The shard is chosen from
+	/// a mix of the hash code's bits, and the hash code is passed on to the shard so
+	/// that it doesn't hash the key again.
+	///
+	/// size and empty sum the shards one at a time, so when other threads are
+	/// modifying the container they return a value which may never have been exact
+	/// at any single moment. The same is true of visit_all, which sees each shard as
+	/// it is when it gets to that shard.
+	///
+	/// Each shard has its own copy of the allocator, and the shards can allocate at
+	/// the same time from different threads, so these copies must be safe to use
+	/// concurrently. The default allocator is.
+	///
+	/// Example usage:
+	///     concurrent_hash_map<int, string> cache;
+	///     cache.insert_or_assign(7, "seven");        // May be called from any thread.
+	///     string s;
+	///     if(cache.find(7, s))                       // Copies the value out.
+	///         ...
+	///     cache.visit(7, [](pair<const int, string>& v) { v.second += "!"; });
+	///
+	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
+			  typename Allocator = EASTLAllocatorType, size_t nShardCount = EASTL_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT>
+	class concurrent_hash_map
+	{
+		static_assert((nShardCount != 0) && ((nShardCount & (nShardCount - 1)) == 0), "concurrent_hash_map shard count must be a power of two.");
+
+	public:
+		typedef concurrent_hash_map<Key, T, Hash, Predicate, Allocator, nShardCount>  this_type;
+		typedef eastl::hash_map<Key, T, Hash, Predicate, Allocator>                  shard_map_type;
+		typedef typename shard_map_type::key_type                                    key_type;
+		typedef typename shard_map_type::mapped_type                                 mapped_type;
+		typedef typename shard_map_type::value_type                                  value_type;
+		typedef typename shard_map_type::size_type                                   size_type;
+		typedef typename shard_map_type::hash_code_t                                 hash_code_t;
+		typedef typename shard_map_type::hasher                                      hasher;
+		typedef typename shard_map_type::key_equal                                   key_equal;
+		typedef typename shard_map_type::allocator_type                              allocator_type;
+
+		static const size_t kShardCount = nShardCount;
+
+	public:
+		/// concurrent_hash_map
+		///
+		/// Default constructor.
+		///
+		concurrent_hash_map()
+			: concurrent_hash_map(EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR)
+		{
+			// Empty
+		}
+
+
+		/// concurrent_hash_map
+		///
+		/// Constructor which creates an empty container with allocator.
+		///
+		explicit concurrent_hash_map(const allocator_type& allocator)
+			: mShards(), mHash(), mPredicate()
+		{
+			for(size_t i = 0; i < nShardCount; i++)
+				mShards[i].mMap.set_allocator(allocator);
+		}
+
+
+		/// concurrent_hash_map
+		///
+		/// Constructor which creates an empty container with the given hash function, predicate
+		/// and allocator. nElementCount is the number of elements to reserve space for, in total
+		/// across all shards.
+		///
+		explicit concurrent_hash_map(size_type nElementCount, const Hash& hashFunction = Hash(), const Predicate& predicate = Predicate(),
+									 const allocator_type& allocator = EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR)
+			: mShards(), mHash(hashFunction), mPredicate(predicate)
+		{
+			for(size_t i = 0; i < nShardCount; i++)
+			{
+				shard_map_type map(0, hashFunction, predicate, allocator);
+				mShards[i].mMap.swap(map);
+			}
+
+			if(nElementCount)
+				reserve(nElementCount);
+		}
+
+
+		// The container is meant to be shared between threads rather than passed around,
+		// and a copy could not be made atomically with respect to other writers.
+		concurrent_hash_map(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+
+		/// find
+		///
+		/// If an element with the key k exists, copies its mapped value to value and returns true.
+		/// Otherwise leaves value unchanged and returns false.
+		///
+		bool find(const key_type& k, mapped_type& value) const
+		{
+			const hash_code_t c = get_hash_code(k);
+			const shard_type& shard = get_shard(c);
+			Internal::auto_rw_spinlock_shared lock(shard.mLock);
+
+			typename shard_map_type::const_iterator it = shard.mMap.find_with_hash(k, c);
+
+			if(it == shard.mMap.end())
+				return false;
+
+			value = it->second;
+			return true;
+		}
+
+
+		/// contains
+		///
+		/// Returns true if an element with the key k exists.
+		///
+		bool contains(const key_type& k) const
+		{
+			const hash_code_t c = get_hash_code(k);
+			const shard_type& shard = get_shard(c);
+			Internal::auto_rw_spinlock_shared lock(shard.mLock);
+
+			return shard.mMap.find_with_hash(k, c) != shard.mMap.end();
+		}
+
+
+		/// insert
+		///
+		/// Inserts value if no element with its key exists. Returns true if value was inserted.
+		///
+		bool insert(const value_type& value)
+		{
+			const hash_code_t c = get_hash_code(value.first);
+			shard_type& shard = get_shard(c);
+			Internal::auto_rw_spinlock lock(shard.mLock);
+
+			return shard.mMap.insert_with_hash(c, value).second;
+		}
+
+		bool insert(value_type&& value)
+		{
+			const hash_code_t c = get_hash_code(value.first);
+			shard_type& shard = get_shard(c);
+			Internal::auto_rw_spinlock lock(shard.mLock);
+
+			return shard.mMap.insert_with_hash(c, eastl::move(value)).second;
+		}
+
+
+		/// insert_or_assign
+		///
+		/// Assigns obj to the mapped value of the element with the key k if one exists, else
+		/// inserts a new element made from k and obj. Returns true if an element was inserted.
+		///
+		template <class M>
+		bool insert_or_assign(const key_type& k, M&& obj)
+			{ return DoInsertOrAssign(k, eastl::forward<M>(obj)); }
+
+		template <class M>
+		bool insert_or_assign(key_type&& k, M&& obj)
+			{ return DoInsertOrAssign(eastl::move(k), eastl::forward<M>(obj)); }
+
+
+		/// try_emplace
+		///
+		/// Inserts an element with the key k and a mapped value constructed from args if no
+		/// element with the key k exists. Otherwise does nothing, and args are not moved from.
+		/// Returns true if an element was inserted.
+		///
+		template <class... Args>
+		bool try_emplace(const key_type& k, Args&&... args)
+			{ return DoTryEmplace(k, eastl::forward<Args>(args)...); }
+
+		template <class... Args>
+		bool try_emplace(key_type&& k, Args&&... args)
+			{ return DoTryEmplace(eastl::move(k), eastl::forward<Args>(args)...); }
+
+
+		/// erase
+		///
+		/// Erases the element with the key k, if any. Returns the number of elements erased.
+		///
+		size_type erase(const key_type& k)
+		{
+			const hash_code_t c = get_hash_code(k);
+			shard_type& shard = get_shard(c);
+			Internal::auto_rw_spinlock lock(shard.mLock);
+
+			typename shard_map_type::iterator it = shard.mMap.find_with_hash(k, c);
+
+			if(it == shard.mMap.end())
+				return 0;
+
+			shard.mMap.erase(it);
+			return 1;
+		}
+
+
+		/// visit
+		///
+		/// If an element with the key k exists, calls function(value_type&) on it while its
+		/// shard is locked for writing, and returns true. Otherwise returns false. The
+		/// function may modify the mapped value.
+		///
+		template <typename Function>
+		bool visit(const key_type& k, Function&& function)
+		{
+			const hash_code_t c = get_hash_code(k);
+			shard_type& shard = get_shard(c);
+			Internal::auto_rw_spinlock lock(shard.mLock);
+
+			typename shard_map_type::iterator it = shard.mMap.find_with_hash(k, c);
+
+			if(it == shard.mMap.end())
+				return false;
+
+			function(*it);
+			return true;
+		}
+
+
+		/// cvisit
+		///
+		/// As visit, but calls function(const value_type&) while the shard is locked only for
+		/// reading, so other readers of the shard can proceed at the same time.
+		///
+		template <typename Function>
+		bool cvisit(const key_type& k, Function&& function) const
+		{
+			const hash_code_t c = get_hash_code(k);
+			const shard_type& shard = get_shard(c);
+			Internal::auto_rw_spinlock_shared lock(shard.mLock);
+
+			typename shard_map_type::const_iterator it = shard.mMap.find_with_hash(k, c);
+
+			if(it == shard.mMap.end())
+				return false;
+
+			function(*it);
+			return true;
+		}
+
+
+		/// visit_all
+		///
+		/// Calls function(value_type&) on every element, locking one shard at a time for writing.
+		///
+		template <typename Function>
+		void visit_all(Function&& function)
+		{
+			for(size_t i = 0; i < nShardCount; i++)
+			{
+				Internal::auto_rw_spinlock lock(mShards[i].mLock);
+
+				for(typename shard_map_type::iterator it = mShards[i].mMap.begin(), itEnd = mShards[i].mMap.end(); it != itEnd; ++it)
+					function(*it);
+			}
+		}
+
+
+		/// cvisit_all
+		///
+		/// Calls function(const value_type&) on every element, locking one shard at a time for reading.
+		///
+		template <typename Function>
+		void cvisit_all(Function&& function) const
+		{
+			for(size_t i = 0; i < nShardCount; i++)
+			{
+				Internal::auto_rw_spinlock_shared lock(mShards[i].mLock);
+
+				for(typename shard_map_type::const_iterator it = mShards[i].mMap.begin(), itEnd = mShards[i].mMap.end(); it != itEnd; ++it)
+					function(*it);
+			}
+		}
+
+
+		size_type size() const
+		{
+			size_type n = 0;
+
+			for(size_t i = 0; i < nShardCount; i++)
+			{
+				Internal::auto_rw_spinlock_shared lock(mShards[i].mLock);
+				n += mShards[i].mMap.size();
+			}
+
+			return n;
+		}
+
+
+		bool empty() const
+		{
+			for(size_t i = 0; i < nShardCount; i++)
+			{
+				Internal::auto_rw_spinlock_shared lock(mShards[i].mLock);
+
+				if(!mShards[i].mMap.empty())
+					return false;
+			}
+
+			return true;
+		}
+
+
+		/// clear
+		///
+		/// Erases all elements, one shard at a time. Elements which other threads insert into
+		/// shards that have already been cleared remain.
+		///
+		void clear()
+		{
+			for(size_t i = 0; i < nShardCount; i++)
+			{
+				Internal::auto_rw_spinlock lock(mShards[i].mLock);
+				mShards[i].mMap.clear();
+			}
+		}
+
+
+		/// reserve
+		///
+		/// Reserves space for nElementCount elements in total, assuming that the keys are spread
+		/// evenly across the shards.
+		///
+		void reserve(size_type nElementCount)
+		{
+			const size_type nShardElementCount = (size_type)((nElementCount + nShardCount - 1) / nShardCount);
+
+			for(size_t i = 0; i < nShardCount; i++)
+			{
+				Internal::auto_rw_spinlock lock(mShards[i].mLock);
+				mShards[i].mMap.reserve(nShardElementCount);
+			}
+		}
+
+
+		hasher hash_function() const
+			{ return mHash; }
+
+		key_equal key_eq() const
+			{ return mPredicate; }
+
+		bool validate() const
+		{
+			for(size_t i = 0; i < nShardCount; i++)
+			{
+				Internal::auto_rw_spinlock_shared lock(mShards[i].mLock);
+
+				if(!mShards[i].mMap.validate())
+					return false;
+
+				// Every element must be in the shard that its hash code selects.
+				for(typename shard_map_type::const_iterator it = mShards[i].mMap.begin(), itEnd = mShards[i].mMap.end(); it != itEnd; ++it)
+				{
+					if(get_shard_index(get_hash_code(it->first)) != i)
+						return false;
+				}
+			}
+
+			return true;
+		}
+
+	protected:
+		struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) shard_type
+		{
+			mutable Internal::rw_spinlock mLock;
+			shard_map_type                mMap;
+		} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+
+		hash_code_t get_hash_code(const key_type& k) const
+			{ return (hash_code_t)mHash(k); }
+
+		// The shards' hash maps choose buckets from the low bits of the hash code (the bucket
+		// count is prime, but a prime modulus still keeps these bits' patterns). The shard is
+		// chosen from the high bits of the code multiplied by a large odd constant, which
+		// depend on all of the code's bits and are independent of the bucket choice.
+		static size_t get_shard_index(hash_code_t c)
+		{
+			#if (EA_PLATFORM_WORD_SIZE >= 8)
+				const uint64_t nMixed = (uint64_t)c * UINT64_C(0x9E3779B97F4A7C15);
+				return (size_t)(nMixed >> 32) & (nShardCount - 1);
+			#else
+				const uint32_t nMixed = (uint32_t)c * UINT32_C(0x9E3779B9);
+				return (size_t)(nMixed >> 16) & (nShardCount - 1);
+			#endif
+		}
+
+		shard_type& get_shard(hash_code_t c)
+			{ return mShards[get_shard_index(c)]; }
+
+		const shard_type& get_shard(hash_code_t c) const
+			{ return mShards[get_shard_index(c)]; }
+
+		template <typename K, typename M>
+		bool DoInsertOrAssign(K&& k, M&& obj)
+		{
+			const hash_code_t c = get_hash_code(k);
+			shard_type& shard = get_shard(c);
+			Internal::auto_rw_spinlock lock(shard.mLock);
+
+			typename shard_map_type::iterator it = shard.mMap.find_with_hash(k, c);
+
+			if(it != shard.mMap.end())
+			{
+				it->second = eastl::forward<M>(obj);
+				return false;
+			}
+
+			shard.mMap.insert_with_hash(c, value_type(eastl::forward<K>(k), eastl::forward<M>(obj)));
+			return true;
+		}
+
+		template <typename K, class... Args>
+		bool DoTryEmplace(K&& k, Args&&... args)
+		{
+			const hash_code_t c = get_hash_code(k);
+			shard_type& shard = get_shard(c);
+			Internal::auto_rw_spinlock lock(shard.mLock);
+
+			if(shard.mMap.find_with_hash(k, c) != shard.mMap.end())
+				return false;
+
+			shard.mMap.insert_with_hash(c, value_type(eastl::piecewise_construct, eastl::forward_as_tuple(eastl::forward<K>(k)),
+			                                          eastl::forward_as_tuple(eastl::forward<Args>(args)...)));
+			return true;
+		}
+
+	protected:
+		shard_type mShards[nShardCount];
+		Hash       mHash;
+		Predicate  mPredicate;
+
+	}; // concurrent_hash_map
+
+
+} // namespace eastl
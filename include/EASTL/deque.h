@@ -520,6 +520,11 @@ namespace eastl
 	}; // class deque
 
 
+	// deque's iterators and pointer array point only into heap memory, so it can be relocated with memcpy whenever its allocator can.
+	template <typename T, typename Allocator, unsigned kDequeSubarraySize>
+	struct is_trivially_relocatable<deque<T, Allocator, kDequeSubarraySize>> : public is_trivially_relocatable<Allocator> {};
+
+
 
 
 	///////////////////////////////////////////////////////////////////////
@@ -0,0 +1,533 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     execution::sequenced_policy / execution::seq
+//     execution::parallel_policy  / execution::par
+//     is_execution_policy
+//     sort(policy, ...)
+//     stable_sort(policy, ...)
+//     for_each(policy, ...)
+//     transform(policy, ...)
+//     reduce(policy, ...)
+//
+// These follow the C++17 parallel algorithm overloads. The parallel versions
+// split random access ranges into pieces and run them on a thread_pool, which
+// is thread_pool::get_default() unless the policy names another with
+// par.on(pool). Ranges which aren't random access are processed sequentially,
+// as is everything when the pool has no worker threads.
+//
+// As with the standard versions, the functions and comparisons passed to the
+// parallel algorithms are called from several threads at once, and must not
+// throw.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/functional.h>
+#include <EASTL/iterator.h>
+#include <EASTL/numeric.h>
+#include <EASTL/optional.h>
+#include <EASTL/sort.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/type_traits.h>
+
+
+
+namespace eastl
+{
+
+	/// EASTL_PARALLEL_SORT_MIN_SIZE
+	///
+	/// The size below which the parallel sorts sort a piece of the range sequentially
+	/// rather than splitting it further.
+	///
+	#ifndef EASTL_PARALLEL_SORT_MIN_SIZE
+		#define EASTL_PARALLEL_SORT_MIN_SIZE 4096
+	#endif
+
+
+	/// EASTL_PARALLEL_PIECES_PER_THREAD
+	///
+	/// The number of pieces per pool thread that the parallel algorithms split a range
+	/// into. More pieces balance uneven work better; fewer have less overhead.
+	///
+	#ifndef EASTL_PARALLEL_PIECES_PER_THREAD
+		#define EASTL_PARALLEL_PIECES_PER_THREAD 8
+	#endif
+
+
+
+	namespace execution
+	{
+		/// sequenced_policy
+		///
+		/// Runs the algorithm on the calling thread, as the overload without a policy does.
+		///
+		class sequenced_policy
+		{
+		};
+
+
+		/// parallel_policy
+		///
+		/// Allows the algorithm to run on several threads of a thread_pool.
+		///
+		/// Example usage:
+		///     eastl::sort(eastl::execution::par, v.begin(), v.end());
+		///     eastl::sort(eastl::execution::par.on(myPool), v.begin(), v.end());
+		///
+		class parallel_policy
+		{
+		public:
+			EA_CONSTEXPR parallel_policy() EA_NOEXCEPT
+				: mpPool(NULL) {}
+
+			/// Returns a policy which runs on pool rather than on thread_pool::get_default().
+			parallel_policy on(thread_pool& pool) const EA_NOEXCEPT
+			{
+				parallel_policy policy;
+				policy.mpPool = &pool;
+				return policy;
+			}
+
+			thread_pool& pool() const
+				{ return mpPool ? *mpPool : thread_pool::get_default(); }
+
+		protected:
+			thread_pool* mpPool;
+		};
+
+
+		EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR sequenced_policy seq = sequenced_policy();
+		EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR parallel_policy  par = parallel_policy();
+
+	} // namespace execution
+
+
+
+	/// is_execution_policy
+	///
+	/// Identifies the policy types, which the algorithm overloads below require as
+	/// their first argument.
+	///
+	template <typename T> struct is_execution_policy                              : public false_type {};
+	template <>           struct is_execution_policy<execution::sequenced_policy> : public true_type {};
+	template <>           struct is_execution_policy<execution::parallel_policy>  : public true_type {};
+
+	#if EASTL_VARIABLE_TEMPLATES_ENABLED
+		template <typename T>
+		EA_CONSTEXPR bool is_execution_policy_v = is_execution_policy<T>::value;
+	#endif
+
+
+
+	namespace Internal
+	{
+		template <typename ExecutionPolicy, typename T = void>
+		using enable_if_execution_policy_t = typename enable_if<is_execution_policy<typename decay<ExecutionPolicy>::type>::value, T>::type;
+
+
+		// Returns the pool to run on, or NULL to run sequentially.
+		inline thread_pool* get_execution_pool(const execution::sequenced_policy&)
+			{ return NULL; }
+
+		inline thread_pool* get_execution_pool(const execution::parallel_policy& policy)
+		{
+			thread_pool& pool = policy.pool();
+			return pool.thread_count() ? &pool : NULL;
+		}
+
+
+		template <typename Iterator>
+		struct is_random_access_iterator
+			: public is_base_of<EASTL_ITC_NS::random_access_iterator_tag, typename iterator_traits<Iterator>::iterator_category> {};
+
+
+		template <typename Size>
+		Size parallel_grain_size(const thread_pool& pool, Size n)
+		{
+			const Size nGrainSize = n / (Size)(pool.concurrency() * EASTL_PARALLEL_PIECES_PER_THREAD);
+			return (nGrainSize > 1) ? nGrainSize : 1;
+		}
+
+
+		// Calls function(nBegin, nEnd) for pieces of [nBegin, nEnd) of at most nGrainSize,
+		// splitting the range in halves so that thieves take the largest pieces.
+		template <typename Size, typename Function>
+		void parallel_for(thread_pool& pool, Size nBegin, Size nEnd, Size nGrainSize, Function& function)
+		{
+			if((nEnd - nBegin) <= nGrainSize)
+				function(nBegin, nEnd);
+			else
+			{
+				const Size nMid = nBegin + ((nEnd - nBegin) / 2);
+
+				pool.invoke([&]{ Internal::parallel_for(pool, nBegin, nMid, nGrainSize, function); },
+							[&]{ Internal::parallel_for(pool, nMid,   nEnd, nGrainSize, function); });
+			}
+		}
+
+
+		template <typename RandomAccessIterator, typename Compare>
+		void parallel_sort_impl(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, Compare& compare,
+								typename iterator_traits<RandomAccessIterator>::difference_type nMinSize, int nDepthLimit)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::value_type      value_type;
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			const difference_type n = last - first;
+
+			// Past the depth limit the partitions are badly unbalanced; eastl::sort copes with that.
+			if((n <= nMinSize) || (nDepthLimit == 0))
+			{
+				eastl::sort<RandomAccessIterator, Compare&>(first, last, compare);
+				return;
+			}
+
+			// Move the median of three to the front and partition the rest around it. The other
+			// two samples stay in the partitioned range and keep its scans in bounds.
+			const RandomAccessIterator a = first + 1, b = first + (n / 2), c = last - 1;
+			RandomAccessIterator       median;
+
+			if(compare(*a, *b))
+				median = compare(*b, *c) ? b : (compare(*a, *c) ? c : a);
+			else
+				median = compare(*a, *c) ? a : (compare(*b, *c) ? c : b);
+
+			eastl::iter_swap(first, median);
+
+			const RandomAccessIterator position = eastl::get_partition_impl<RandomAccessIterator, const value_type&, Compare&>(first + 1, last, *first, compare);
+
+			pool.invoke([&]{ Internal::parallel_sort_impl(pool, first, position, compare, nMinSize, nDepthLimit - 1); },
+						[&]{ Internal::parallel_sort_impl(pool, position, last, compare, nMinSize, nDepthLimit - 1); });
+		}
+
+
+		// Merges [first1, last1) and [first2, last2) into result by moving, splitting the
+		// larger range at its middle and the other at the matching position. Equivalent
+		// elements of the first range stay ahead of those of the second.
+		template <typename InputIterator, typename OutputIterator, typename Compare>
+		void parallel_merge(thread_pool& pool, InputIterator first1, InputIterator last1, InputIterator first2, InputIterator last2,
+							OutputIterator result, Compare& compare, typename iterator_traits<InputIterator>::difference_type nMinSize)
+		{
+			if(((last1 - first1) + (last2 - first2)) <= nMinSize)
+			{
+				eastl::merge(eastl::make_move_iterator(first1), eastl::make_move_iterator(last1),
+							 eastl::make_move_iterator(first2), eastl::make_move_iterator(last2), result, compare);
+				return;
+			}
+
+			InputIterator mid1, mid2;
+
+			if((last1 - first1) >= (last2 - first2))
+			{
+				mid1 = first1 + ((last1 - first1) / 2);
+				mid2 = eastl::lower_bound(first2, last2, *mid1, compare);
+			}
+			else
+			{
+				mid2 = first2 + ((last2 - first2) / 2);
+				mid1 = eastl::upper_bound(first1, last1, *mid2, compare);
+			}
+
+			const OutputIterator resultMid = result + ((mid1 - first1) + (mid2 - first2));
+
+			pool.invoke([&]{ Internal::parallel_merge(pool, first1, mid1, first2, mid2, result,    compare, nMinSize); },
+						[&]{ Internal::parallel_merge(pool, mid1,   last1, mid2, last2, resultMid, compare, nMinSize); });
+		}
+
+
+		// Sorts each half in parallel, merges the halves into pBuffer, and moves the result back.
+		template <typename RandomAccessIterator, typename T, typename Compare>
+		void parallel_merge_sort(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last, T* pBuffer, Compare& compare,
+								 typename iterator_traits<RandomAccessIterator>::difference_type nMinSize)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			const difference_type n = last - first;
+
+			if(n <= nMinSize)
+			{
+				eastl::merge_sort_buffer<RandomAccessIterator, T, Compare&>(first, last, pBuffer, compare);
+				return;
+			}
+
+			const difference_type nMid = n / 2;
+
+			pool.invoke([&]{ Internal::parallel_merge_sort(pool, first, first + nMid, pBuffer, compare, nMinSize); },
+						[&]{ Internal::parallel_merge_sort(pool, first + nMid, last, pBuffer + nMid, compare, nMinSize); });
+
+			if(!compare(*(first + nMid), *(first + (nMid - 1))))
+				return; // The halves are already in order.
+
+			Internal::parallel_merge(pool, first, first + nMid, first + nMid, last, pBuffer, compare, nMinSize);
+
+			auto moveBack = [&](difference_type nBegin, difference_type nEnd)
+				{ eastl::move(pBuffer + nBegin, pBuffer + nEnd, first + nBegin); };
+
+			Internal::parallel_for(pool, (difference_type)0, n, eastl::max_alt(nMinSize, Internal::parallel_grain_size(pool, n)), moveBack);
+		}
+
+
+		template <typename RandomAccessIterator, typename T, typename BinaryOperation>
+		T parallel_reduce(thread_pool& pool, RandomAccessIterator first, RandomAccessIterator last,
+						  typename iterator_traits<RandomAccessIterator>::difference_type nGrainSize, BinaryOperation& binary_op)
+		{
+			if((last - first) <= nGrainSize)
+			{
+				T result(*first);
+				return eastl::reduce(++first, last, eastl::move(result), binary_op);
+			}
+
+			const RandomAccessIterator mid = first + ((last - first) / 2);
+			eastl::optional<T>         result1, result2;
+
+			pool.invoke([&]{ result1.emplace(Internal::parallel_reduce<RandomAccessIterator, T>(pool, first, mid,  nGrainSize, binary_op)); },
+						[&]{ result2.emplace(Internal::parallel_reduce<RandomAccessIterator, T>(pool, mid,   last, nGrainSize, binary_op)); });
+
+			return binary_op(eastl::move(*result1), eastl::move(*result2));
+		}
+
+
+		template <typename ForwardIterator, typename Function>
+		void for_each_impl(thread_pool* pPool, ForwardIterator first, ForwardIterator last, Function& function, false_type)
+		{
+			EA_UNUSED(pPool);
+			eastl::for_each<ForwardIterator, Function&>(first, last, function);
+		}
+
+		template <typename RandomAccessIterator, typename Function>
+		void for_each_impl(thread_pool* pPool, RandomAccessIterator first, RandomAccessIterator last, Function& function, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			if(!pPool)
+				eastl::for_each<RandomAccessIterator, Function&>(first, last, function);
+			else
+			{
+				auto forEachPiece = [&](difference_type nBegin, difference_type nEnd)
+					{ eastl::for_each<RandomAccessIterator, Function&>(first + nBegin, first + nEnd, function); };
+
+				Internal::parallel_for(*pPool, (difference_type)0, last - first, Internal::parallel_grain_size(*pPool, last - first), forEachPiece);
+			}
+		}
+
+
+		template <typename ForwardIterator1, typename ForwardIterator2, typename UnaryOperation>
+		ForwardIterator2 transform_impl(thread_pool* pPool, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result, UnaryOperation& unaryOperation, false_type)
+		{
+			EA_UNUSED(pPool);
+			return eastl::transform<ForwardIterator1, ForwardIterator2, UnaryOperation&>(first, last, result, unaryOperation);
+		}
+
+		template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename UnaryOperation>
+		RandomAccessIterator2 transform_impl(thread_pool* pPool, RandomAccessIterator1 first, RandomAccessIterator1 last, RandomAccessIterator2 result, UnaryOperation& unaryOperation, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+
+			if(!pPool)
+				return eastl::transform<RandomAccessIterator1, RandomAccessIterator2, UnaryOperation&>(first, last, result, unaryOperation);
+
+			auto transformPiece = [&](difference_type nBegin, difference_type nEnd)
+				{ eastl::transform<RandomAccessIterator1, RandomAccessIterator2, UnaryOperation&>(first + nBegin, first + nEnd, result + nBegin, unaryOperation); };
+
+			const difference_type n = last - first;
+			Internal::parallel_for(*pPool, (difference_type)0, n, Internal::parallel_grain_size(*pPool, n), transformPiece);
+			return result + n;
+		}
+
+
+		template <typename ForwardIterator1, typename ForwardIterator2, typename ForwardIterator3, typename BinaryOperation>
+		ForwardIterator3 transform_impl(thread_pool* pPool, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, ForwardIterator3 result, BinaryOperation& binaryOperation, false_type)
+		{
+			EA_UNUSED(pPool);
+			return eastl::transform<ForwardIterator1, ForwardIterator2, ForwardIterator3, BinaryOperation&>(first1, last1, first2, result, binaryOperation);
+		}
+
+		template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename RandomAccessIterator3, typename BinaryOperation>
+		RandomAccessIterator3 transform_impl(thread_pool* pPool, RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2, RandomAccessIterator3 result, BinaryOperation& binaryOperation, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+
+			if(!pPool)
+				return eastl::transform<RandomAccessIterator1, RandomAccessIterator2, RandomAccessIterator3, BinaryOperation&>(first1, last1, first2, result, binaryOperation);
+
+			auto transformPiece = [&](difference_type nBegin, difference_type nEnd)
+				{ eastl::transform<RandomAccessIterator1, RandomAccessIterator2, RandomAccessIterator3, BinaryOperation&>(first1 + nBegin, first1 + nEnd, first2 + nBegin, result + nBegin, binaryOperation); };
+
+			const difference_type n = last1 - first1;
+			Internal::parallel_for(*pPool, (difference_type)0, n, Internal::parallel_grain_size(*pPool, n), transformPiece);
+			return result + n;
+		}
+
+
+		template <typename ForwardIterator, typename T, typename BinaryOperation>
+		T reduce_impl(thread_pool* pPool, ForwardIterator first, ForwardIterator last, T init, BinaryOperation& binary_op, false_type)
+		{
+			EA_UNUSED(pPool);
+			return eastl::reduce<ForwardIterator, T, BinaryOperation&>(first, last, eastl::move(init), binary_op);
+		}
+
+		template <typename RandomAccessIterator, typename T, typename BinaryOperation>
+		T reduce_impl(thread_pool* pPool, RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation& binary_op, true_type)
+		{
+			if(!pPool || (first == last))
+				return eastl::reduce<RandomAccessIterator, T, BinaryOperation&>(first, last, eastl::move(init), binary_op);
+
+			return binary_op(eastl::move(init), Internal::parallel_reduce<RandomAccessIterator, T>(*pPool, first, last, Internal::parallel_grain_size(*pPool, last - first), binary_op));
+		}
+
+	} // namespace Internal
+
+
+
+	/// sort
+	///
+	/// Sorts [first, last) as eastl::sort does. The parallel version is a quick sort
+	/// whose partitions are sorted in parallel, switching to eastl::sort for pieces
+	/// which are small enough.
+	///
+	template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy>
+	sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+		thread_pool* const    pPool = Internal::get_execution_pool(policy);
+		const difference_type n     = last - first;
+
+		if(!pPool || (n <= (difference_type)EASTL_PARALLEL_SORT_MIN_SIZE))
+			eastl::sort<RandomAccessIterator, Compare>(first, last, compare);
+		else
+		{
+			const difference_type nMinSize = eastl::max_alt((difference_type)EASTL_PARALLEL_SORT_MIN_SIZE, Internal::parallel_grain_size(*pPool, n));
+			Internal::parallel_sort_impl(*pPool, first, last, compare, nMinSize, 2 * Internal::Log2(n));
+		}
+	}
+
+	template <typename ExecutionPolicy, typename RandomAccessIterator>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy>
+	sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last)
+	{
+		eastl::sort(eastl::forward<ExecutionPolicy>(policy), first, last, eastl::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+
+	/// stable_sort
+	///
+	/// Sorts [first, last) as eastl::stable_sort does, allocating a buffer of
+	/// last - first default-constructed elements as merge_sort does. The parallel
+	/// version is a merge sort whose halves are sorted and merged in parallel.
+	///
+	template <typename ExecutionPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy>
+	stable_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering compare)
+	{
+		typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		thread_pool* const    pPool = Internal::get_execution_pool(policy);
+		const difference_type n     = last - first;
+
+		if(!pPool || (n <= (difference_type)EASTL_PARALLEL_SORT_MIN_SIZE))
+			eastl::stable_sort<RandomAccessIterator, StrictWeakOrdering>(first, last, compare);
+		else
+		{
+			EASTLAllocatorType& allocator = *get_default_allocator(0);
+			value_type* const   pBuffer   = (value_type*)allocate_memory(allocator, n * sizeof(value_type), EASTL_ALIGN_OF(value_type), 0);
+			eastl::uninitialized_fill(pBuffer, pBuffer + n, value_type());
+
+			const difference_type nMinSize = eastl::max_alt((difference_type)EASTL_PARALLEL_SORT_MIN_SIZE, Internal::parallel_grain_size(*pPool, n));
+			Internal::parallel_merge_sort(*pPool, first, last, pBuffer, compare, nMinSize);
+
+			eastl::destruct(pBuffer, pBuffer + n);
+			EASTLFree(allocator, pBuffer, n * sizeof(value_type));
+		}
+	}
+
+	template <typename ExecutionPolicy, typename RandomAccessIterator>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy>
+	stable_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last)
+	{
+		eastl::stable_sort(eastl::forward<ExecutionPolicy>(policy), first, last, eastl::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+
+	/// for_each
+	///
+	/// Calls function for each element of [first, last). The parallel version calls it
+	/// for different elements from different threads, in no particular order.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename Function>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy>
+	for_each(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, Function function)
+	{
+		Internal::for_each_impl(Internal::get_execution_pool(policy), first, last, function, Internal::is_random_access_iterator<ForwardIterator>());
+	}
+
+
+	/// transform
+	///
+	/// Writes unaryOperation(*i) for each element i of [first, last) to result, and
+	/// returns the end of the output. The parallel version requires both ranges to be
+	/// random access to run in parallel.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename UnaryOperation>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy, ForwardIterator2>
+	transform(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result, UnaryOperation unaryOperation)
+	{
+		typedef integral_constant<bool, Internal::is_random_access_iterator<ForwardIterator1>::value &&
+										Internal::is_random_access_iterator<ForwardIterator2>::value> is_parallel;
+
+		return Internal::transform_impl(Internal::get_execution_pool(policy), first, last, result, unaryOperation, is_parallel());
+	}
+
+	/// Writes binaryOperation(*i, *j) for each pair of elements of [first1, last1) and
+	/// [first2, first2 + (last1 - first1)) to result, and returns the end of the output.
+	template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename ForwardIterator3, typename BinaryOperation>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy, ForwardIterator3>
+	transform(ExecutionPolicy&& policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, ForwardIterator3 result, BinaryOperation binaryOperation)
+	{
+		typedef integral_constant<bool, Internal::is_random_access_iterator<ForwardIterator1>::value &&
+										Internal::is_random_access_iterator<ForwardIterator2>::value &&
+										Internal::is_random_access_iterator<ForwardIterator3>::value> is_parallel;
+
+		return Internal::transform_impl(Internal::get_execution_pool(policy), first1, last1, first2, result, binaryOperation, is_parallel());
+	}
+
+
+	/// reduce
+	///
+	/// Combines init and the elements of [first, last) with binary_op, which must be
+	/// associative and commutative, as the parallel version combines the elements of
+	/// each piece and then the pieces' results in no particular order.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy, T>
+	reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation binary_op)
+	{
+		return Internal::reduce_impl(Internal::get_execution_pool(policy), first, last, eastl::move(init), binary_op, Internal::is_random_access_iterator<ForwardIterator>());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy, T>
+	reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init)
+	{
+		return eastl::reduce(eastl::forward<ExecutionPolicy>(policy), first, last, eastl::move(init), eastl::plus<>());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator>
+	Internal::enable_if_execution_policy_t<ExecutionPolicy, typename iterator_traits<ForwardIterator>::value_type>
+	reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last)
+	{
+		return eastl::reduce(eastl::forward<ExecutionPolicy>(policy), first, last, typename iterator_traits<ForwardIterator>::value_type(), eastl::plus<>());
+	}
+
+} // namespace eastl
@@ -0,0 +1,394 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements flat_hash_map, an open-addressing alternative to
+// hash_map. See internal/flat_hashtable.h for the design and for how its
+// iterator invalidation rules differ from hash_map.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/flat_hashtable.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#include <EASTL/tuple.h>
+#if EASTL_EXCEPTIONS_ENABLED
+#include <stdexcept>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_FLAT_HASH_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_FLAT_HASH_MAP_DEFAULT_NAME
+		#define EASTL_FLAT_HASH_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " flat_hash_map" // Unless the user overrides something, this is "EASTL flat_hash_map".
+	#endif
+
+
+	/// EASTL_FLAT_HASH_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_FLAT_HASH_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_FLAT_HASH_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_FLAT_HASH_MAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// flat_hash_map
+	///
+	/// Implements a flat_hash_map, which is a hashed associative container
+	/// with the same interface as hash_map but which stores its elements
+	/// inline in an open-addressed array rather than in linked nodes.
+	/// It uses less memory per element and usually does fewer cache misses
+	/// per lookup than hash_map, at the cost of invalidating iterators and
+	/// references to elements whenever an insertion causes the table to grow.
+	///
+	/// The element type must be MoveConstructible, as elements are moved
+	/// when the table grows.
+	///
+	/// find_as
+	/// As with hash_map, find_as allows lookups with a key of a type other
+	/// than the key type, as long as the supplied hash function produces the
+	/// same value as the container's hash function does for equivalent keys.
+	///
+	/// Example find_as usage:
+	///     flat_hash_map<string, int> hashMap;
+	///     i = hashMap.find_as("hello");    // Use default hash and compare.
+	///
+	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
+			  typename Allocator = EASTLAllocatorType>
+	class flat_hash_map
+		: public flat_hashtable<Key, eastl::pair<const Key, T>, Allocator, eastl::use_first<eastl::pair<const Key, T> >, Predicate, Hash, true>
+	{
+	public:
+		typedef flat_hashtable<Key, eastl::pair<const Key, T>, Allocator,
+							   eastl::use_first<eastl::pair<const Key, T> >,
+							   Predicate, Hash, true>                             base_type;
+		typedef flat_hash_map<Key, T, Hash, Predicate, Allocator>                 this_type;
+		typedef typename base_type::size_type                                     size_type;
+		typedef typename base_type::key_type                                      key_type;
+		typedef T                                                                 mapped_type;
+		typedef typename base_type::value_type                                    value_type;     // NOTE: 'value_type = pair<const key_type, mapped_type>'.
+		typedef typename base_type::allocator_type                                allocator_type;
+		typedef typename base_type::insert_return_type                            insert_return_type;
+		typedef typename base_type::iterator                                      iterator;
+		typedef typename base_type::const_iterator                                const_iterator;
+
+		using base_type::insert;
+
+	public:
+		/// flat_hash_map
+		///
+		/// Default constructor.
+		///
+		flat_hash_map()
+			: this_type(EASTL_FLAT_HASH_MAP_DEFAULT_ALLOCATOR)
+		{
+			// Empty
+		}
+
+
+		/// flat_hash_map
+		///
+		/// Constructor which creates an empty container with allocator.
+		///
+		explicit flat_hash_map(const allocator_type& allocator)
+			: base_type(0, Hash(), Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
+		{
+			// Empty
+		}
+
+
+		/// flat_hash_map
+		///
+		/// Constructor which creates an empty container with at least nBucketCount slots.
+		///
+		explicit flat_hash_map(size_type nBucketCount, const Hash& hashFunction = Hash(),
+							   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_FLAT_HASH_MAP_DEFAULT_ALLOCATOR)
+			: base_type(nBucketCount, hashFunction, predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
+		{
+			// Empty
+		}
+
+
+		flat_hash_map(const this_type& x)
+		  : base_type(x)
+		{
+		}
+
+
+		flat_hash_map(this_type&& x)
+		  : base_type(eastl::move(x))
+		{
+		}
+
+
+		flat_hash_map(this_type&& x, const allocator_type& allocator)
+		  : base_type(eastl::move(x), allocator)
+		{
+		}
+
+
+		/// flat_hash_map
+		///
+		/// initializer_list-based constructor.
+		/// Allows for initializing with brace values (e.g. flat_hash_map<int, char*> hm = { {3,"c"}, {4,"d"}, {5,"e"} }; )
+		///
+		flat_hash_map(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_FLAT_HASH_MAP_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
+		{
+			// Empty
+		}
+
+		flat_hash_map(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), 0, Hash(), Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
+		{
+			// Empty
+		}
+
+
+		/// flat_hash_map
+		///
+		/// Range constructor. The table is sized for the number of elements in the input range.
+		///
+		template <typename ForwardIterator>
+		flat_hash_map(ForwardIterator first, ForwardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_FLAT_HASH_MAP_DEFAULT_ALLOCATOR)
+			: base_type(first, last, nBucketCount, hashFunction, predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
+		{
+			// Empty
+		}
+
+
+		this_type& operator=(const this_type& x)
+		{
+			return static_cast<this_type&>(base_type::operator=(x));
+		}
+
+
+		this_type& operator=(std::initializer_list<value_type> ilist)
+		{
+			return static_cast<this_type&>(base_type::operator=(ilist));
+		}
+
+
+		this_type& operator=(this_type&& x)
+		{
+			return static_cast<this_type&>(base_type::operator=(eastl::move(x)));
+		}
+
+
+		/// insert
+		///
+		/// This is an extension to the C++ standard. We insert a default-constructed
+		/// element with the given key, as hash_map::insert(key) does.
+		///
+		insert_return_type insert(const key_type& key)
+		{
+			return try_emplace(key);
+		}
+
+		insert_return_type insert(key_type&& key)
+		{
+			return try_emplace(eastl::move(key));
+		}
+
+
+		T& at(const key_type& k)
+		{
+			iterator it = base_type::find(k);
+
+			if (it == base_type::end())
+			{
+				#if EASTL_EXCEPTIONS_ENABLED
+					// throw exeption if exceptions enabled
+					throw std::out_of_range("invalid flat_hash_map<K, T> key");
+				#else
+					// assert false if asserts enabled
+					EASTL_ASSERT_MSG(false, "invalid flat_hash_map<K, T> key");
+				#endif
+			}
+			// undefined behaviour if exceptions and asserts are disabled and it == end()
+			return it->second;
+		}
+
+
+		const T& at(const key_type& k) const
+		{
+			const_iterator it = base_type::find(k);
+
+			if (it == base_type::end())
+			{
+				#if EASTL_EXCEPTIONS_ENABLED
+					// throw exeption if exceptions enabled
+					throw std::out_of_range("invalid flat_hash_map<K, T> key");
+				#else
+					// assert false if asserts enabled
+					EASTL_ASSERT_MSG(false, "invalid flat_hash_map<K, T> key");
+				#endif
+			}
+			// undefined behaviour if exceptions and asserts are disabled and it == end()
+			return it->second;
+		}
+
+
+		mapped_type& operator[](const key_type& key)
+		{
+			return try_emplace(key).first->second;
+		}
+
+		mapped_type& operator[](key_type&& key)
+		{
+			return try_emplace(eastl::move(key)).first->second;
+		}
+
+
+		template <class... Args>
+		inline insert_return_type try_emplace(const key_type& k, Args&&... args)
+		{
+			return try_emplace_forwarding(k, eastl::forward<Args>(args)...);
+		}
+
+		template <class... Args>
+		inline insert_return_type try_emplace(key_type&& k, Args&&... args)
+		{
+			return try_emplace_forwarding(eastl::move(k), eastl::forward<Args>(args)...);
+		}
+
+		template <class... Args>
+		inline iterator try_emplace(const_iterator, const key_type& k, Args&&... args)
+		{
+			// Currently, the first parameter is ignored.
+			return try_emplace(k, eastl::forward<Args>(args)...).first;
+		}
+
+		template <class... Args>
+		inline iterator try_emplace(const_iterator, key_type&& k, Args&&... args)
+		{
+			// Currently, the first parameter is ignored.
+			return try_emplace(eastl::move(k), eastl::forward<Args>(args)...).first;
+		}
+
+
+		template <class M>
+		insert_return_type insert_or_assign(const key_type& k, M&& obj)
+		{
+			insert_return_type result = try_emplace(k, eastl::forward<M>(obj));
+			if(!result.second)
+				result.first->second = eastl::forward<M>(obj);
+			return result;
+		}
+
+		template <class M>
+		insert_return_type insert_or_assign(key_type&& k, M&& obj)
+		{
+			insert_return_type result = try_emplace(eastl::move(k), eastl::forward<M>(obj));
+			if(!result.second)
+				result.first->second = eastl::forward<M>(obj);
+			return result;
+		}
+
+		template <class M>
+		iterator insert_or_assign(const_iterator, const key_type& k, M&& obj)
+		{
+			return insert_or_assign(k, eastl::forward<M>(obj)).first;
+		}
+
+		template <class M>
+		iterator insert_or_assign(const_iterator, key_type&& k, M&& obj)
+		{
+			return insert_or_assign(eastl::move(k), eastl::forward<M>(obj)).first;
+		}
+
+	private:
+		template <class K, class... Args>
+		insert_return_type try_emplace_forwarding(K&& k, Args&&... args)
+		{
+			// Unlike emplace, this constructs the value directly in its slot.
+			const size_t h = base_type::DoHash(k);
+			const eastl::pair<size_type, bool> result = base_type::DoFindOrPrepareInsert(k, h);
+
+			if(result.second)
+			{
+				::new(eastl::addressof(base_type::mpSlots[result.first]))
+					value_type(piecewise_construct, eastl::forward_as_tuple(eastl::forward<K>(k)),
+							   eastl::forward_as_tuple(eastl::forward<Args>(args)...));
+				base_type::DoCommitInsert(result.first, h);
+			}
+
+			return insert_return_type(base_type::DoMakeIterator(result.first), result.second);
+		}
+	}; // flat_hash_map
+
+
+	/// flat_hash_map erase_if
+	///
+	/// https://en.cppreference.com/w/cpp/container/unordered_map/erase_if
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, typename UserPredicate>
+	typename eastl::flat_hash_map<Key, T, Hash, Predicate, Allocator>::size_type erase_if(eastl::flat_hash_map<Key, T, Hash, Predicate, Allocator>& c, UserPredicate predicate)
+	{
+		auto oldSize = c.size();
+		// Erases all elements that satisfy the predicate from the container.
+		for (auto i = c.begin(), last = c.end(); i != last;)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator==(const flat_hash_map<Key, T, Hash, Predicate, Allocator>& a,
+						   const flat_hash_map<Key, T, Hash, Predicate, Allocator>& b)
+	{
+		typedef typename flat_hash_map<Key, T, Hash, Predicate, Allocator>::const_iterator const_iterator;
+
+		// We implement branching with the assumption that the return value is usually false.
+		if(a.size() != b.size())
+			return false;
+
+		// Keys are unique, so we need only test that each element in a can be found in b.
+		for(const_iterator ai = a.begin(), aiEnd = a.end(), biEnd = b.end(); ai != aiEnd; ++ai)
+		{
+			const_iterator bi = b.find(ai->first);
+
+			if((bi == biEnd) || !(*ai == *bi))  // We have to compare the values, because lookups are done by keys alone.
+				return false;
+		}
+
+		return true;
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator!=(const flat_hash_map<Key, T, Hash, Predicate, Allocator>& a,
+						   const flat_hash_map<Key, T, Hash, Predicate, Allocator>& b)
+	{
+		return !(a == b);
+	}
+#endif
+
+
+} // namespace eastl
@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements flat_hash_set, an open-addressing alternative to
+// hash_set. See internal/flat_hashtable.h for the design and for how its
+// iterator invalidation rules differ from hash_set.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/flat_hashtable.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+
+
+namespace eastl
+{
+
+	/// EASTL_FLAT_HASH_SET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_FLAT_HASH_SET_DEFAULT_NAME
+		#define EASTL_FLAT_HASH_SET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " flat_hash_set" // Unless the user overrides something, this is "EASTL flat_hash_set".
+	#endif
+
+
+	/// EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR
+		#define EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR allocator_type(EASTL_FLAT_HASH_SET_DEFAULT_NAME)
+	#endif
+
+
+
+	/// flat_hash_set
+	///
+	/// Implements a flat_hash_set, which is a hashed unique-item container
+	/// with the same interface as hash_set but which stores its elements
+	/// inline in an open-addressed array rather than in linked nodes.
+	/// Iterators and references are invalidated whenever an insertion
+	/// causes the table to grow.
+	///
+	/// Example find_as usage:
+	///     flat_hash_set<string> hashSet;
+	///     i = hashSet.find_as("hello");    // Use default hash and compare.
+	///
+	template <typename Value, typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>,
+			  typename Allocator = EASTLAllocatorType>
+	class flat_hash_set
+		: public flat_hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate, Hash, false>
+	{
+	public:
+		typedef flat_hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate, Hash, false> base_type;
+		typedef flat_hash_set<Value, Hash, Predicate, Allocator>                  this_type;
+		typedef typename base_type::size_type                                     size_type;
+		typedef typename base_type::value_type                                    value_type;
+		typedef typename base_type::allocator_type                                allocator_type;
+
+	public:
+		/// flat_hash_set
+		///
+		/// Default constructor.
+		///
+		flat_hash_set()
+			: this_type(EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+		{
+			// Empty
+		}
+
+
+		/// flat_hash_set
+		///
+		/// Constructor which creates an empty container with allocator.
+		///
+		explicit flat_hash_set(const allocator_type& allocator)
+			: base_type(0, Hash(), Predicate(), eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		/// flat_hash_set
+		///
+		/// Constructor which creates an empty container with at least nBucketCount slots.
+		///
+		explicit flat_hash_set(size_type nBucketCount, const Hash& hashFunction = Hash(), const Predicate& predicate = Predicate(),
+							   const allocator_type& allocator = EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+			: base_type(nBucketCount, hashFunction, predicate, eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		flat_hash_set(const this_type& x)
+		  : base_type(x)
+		{
+		}
+
+
+		flat_hash_set(this_type&& x)
+		  : base_type(eastl::move(x))
+		{
+		}
+
+
+		flat_hash_set(this_type&& x, const allocator_type& allocator)
+		  : base_type(eastl::move(x), allocator)
+		{
+		}
+
+
+		/// flat_hash_set
+		///
+		/// initializer_list-based constructor.
+		/// Allows for initializing with brace values (e.g. flat_hash_set<int> hs = { 3, 4, 5, }; )
+		///
+		flat_hash_set(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, predicate, eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+		flat_hash_set(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), 0, Hash(), Predicate(), eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		/// flat_hash_set
+		///
+		/// Range constructor. The table is sized for the number of elements in the input range.
+		///
+		template <typename ForwardIterator>
+		flat_hash_set(ForwardIterator first, ForwardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+			: base_type(first, last, nBucketCount, hashFunction, predicate, eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		this_type& operator=(const this_type& x)
+		{
+			return static_cast<this_type&>(base_type::operator=(x));
+		}
+
+
+		this_type& operator=(std::initializer_list<value_type> ilist)
+		{
+			return static_cast<this_type&>(base_type::operator=(ilist));
+		}
+
+
+		this_type& operator=(this_type&& x)
+		{
+			return static_cast<this_type&>(base_type::operator=(eastl::move(x)));
+		}
+
+	}; // flat_hash_set
+
+
+	/// flat_hash_set erase_if
+	///
+	/// https://en.cppreference.com/w/cpp/container/unordered_set/erase_if
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, typename UserPredicate>
+	typename eastl::flat_hash_set<Value, Hash, Predicate, Allocator>::size_type erase_if(eastl::flat_hash_set<Value, Hash, Predicate, Allocator>& c, UserPredicate predicate)
+	{
+		auto oldSize = c.size();
+		// Erases all elements that satisfy the predicate pred from the container.
+		for (auto i = c.begin(), last = c.end(); i != last;)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Value, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator==(const flat_hash_set<Value, Hash, Predicate, Allocator>& a,
+						   const flat_hash_set<Value, Hash, Predicate, Allocator>& b)
+	{
+		typedef typename flat_hash_set<Value, Hash, Predicate, Allocator>::const_iterator const_iterator;
+
+		// We implement branching with the assumption that the return value is usually false.
+		if(a.size() != b.size())
+			return false;
+
+		// Values are unique, so we need only test that each element in a can be found in b.
+		for(const_iterator ai = a.begin(), aiEnd = a.end(), biEnd = b.end(); ai != aiEnd; ++ai)
+		{
+			const_iterator bi = b.find(*ai);
+
+			if((bi == biEnd) || !(*ai == *bi)) // The lookup uses Predicate, which isn't strictly required to be identical to the Value operator==.
+				return false;
+		}
+
+		return true;
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator!=(const flat_hash_set<Value, Hash, Predicate, Allocator>& a,
+						   const flat_hash_set<Value, Hash, Predicate, Allocator>& b)
+	{
+		return !(a == b);
+	}
+#endif
+
+
+} // namespace eastl
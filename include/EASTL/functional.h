@@ -12,6 +12,13 @@
 #include <EASTL/internal/functional_base.h>
 #include <EASTL/internal/mem_fn.h>
 
+EA_DISABLE_ALL_VC_WARNINGS()
+	#include <string.h>
+	#if defined(EA_COMPILER_MSVC) && defined(EA_PROCESSOR_X86_64)
+		#include <intrin.h>
+	#endif
+EA_RESTORE_ALL_VC_WARNINGS()
+
 // 4512/4626 - 'class' : assignment operator could not be generated.  // This disabling would best be put elsewhere.
 EA_DISABLE_VC_WARNING(4512 4626);
 
@@ -1191,6 +1198,157 @@ namespace eastl
 		{ size_t operator()(long double val) const { return static_cast<size_t>(val); } };
 
 
+	namespace Internal
+	{
+		inline uint64_t FastHashRead64(const uint8_t* p)
+		{
+			uint64_t v;
+			memcpy(&v, p, sizeof(v));
+			EASTL_SYSTEM_BIG_ENDIAN_STATEMENT(v = ((v >> 56) | ((v >> 40) & 0xff00) | ((v >> 24) & 0xff0000) | ((v >> 8) & 0xff000000) |
+												   ((v & 0xff000000) << 8) | ((v & 0xff0000) << 24) | ((v & 0xff00) << 40) | (v << 56));)
+			return v;
+		}
+
+		inline uint64_t FastHashRead32(const uint8_t* p)
+		{
+			return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24); // Compilers merge this into a single load on little endian platforms.
+		}
+
+		// Returns the low and high halves of the 128 bit product of a and b, xor'd together.
+		inline uint64_t FastHashMix(uint64_t a, uint64_t b)
+		{
+			#if defined(EA_COMPILER_MSVC) && defined(EA_PROCESSOR_X86_64)
+				uint64_t hi;
+				const uint64_t lo = _umul128(a, b, &hi);
+				return lo ^ hi;
+			#elif defined(__SIZEOF_INT128__)
+				const unsigned __int128 r = (unsigned __int128)a * b;
+				return (uint64_t)r ^ (uint64_t)(r >> 64);
+			#else
+				const uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t)a, lb = (uint32_t)b;
+				const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+				const uint64_t t  = rl + (rm0 << 32);
+				uint64_t       c  = (t < rl) ? 1 : 0;
+				const uint64_t lo = t + (rm1 << 32);
+				c += (lo < t) ? 1 : 0;
+				const uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+				return lo ^ hi;
+			#endif
+		}
+
+		/// FastHashBytes
+		///
+		/// Hashes nLength bytes at pData eight or sixteen bytes at a time, in the style of
+		/// wyhash (which is in the public domain). Each step is a single 64x64->128 bit
+		/// multiply whose halves are folded together, which gives full avalanche.
+		/// Input is read as little endian so results are the same on all platforms.
+		///
+		inline uint64_t FastHashBytes(const void* pData, size_t nLength, uint64_t seed = 0)
+		{
+			const uint64_t kSecret0 = UINT64_C(0xa0761d6478bd642f);
+			const uint64_t kSecret1 = UINT64_C(0xe7037ed1a0b428db);
+			const uint64_t kSecret2 = UINT64_C(0x8ebc6af09c88c6e3);
+			const uint64_t kSecret3 = UINT64_C(0x589965cc75374cc3);
+
+			const uint8_t* p = static_cast<const uint8_t*>(pData);
+			uint64_t a, b;
+
+			seed ^= FastHashMix(seed ^ kSecret0, kSecret1);
+
+			if(EASTL_LIKELY(nLength <= 16))
+			{
+				if(EASTL_LIKELY(nLength >= 4))
+				{
+					// Two pairs of possibly overlapping 4 byte reads cover any length in [4, 16].
+					const size_t nOffset = (nLength >> 3) << 2;
+					a = (FastHashRead32(p) << 32) | FastHashRead32(p + nOffset);
+					b = (FastHashRead32(p + nLength - 4) << 32) | FastHashRead32(p + nLength - 4 - nOffset);
+				}
+				else if(EASTL_LIKELY(nLength > 0))
+				{
+					a = ((uint64_t)p[0] << 16) | ((uint64_t)p[nLength >> 1] << 8) | (uint64_t)p[nLength - 1];
+					b = 0;
+				}
+				else
+					a = b = 0;
+			}
+			else
+			{
+				size_t i = nLength;
+
+				if(EASTL_UNLIKELY(i > 48))
+				{
+					// Three independent lanes let the multiplies overlap in the pipeline.
+					uint64_t see1 = seed, see2 = seed;
+					do
+					{
+						seed = FastHashMix(FastHashRead64(p)      ^ kSecret1, FastHashRead64(p + 8)  ^ seed);
+						see1 = FastHashMix(FastHashRead64(p + 16) ^ kSecret2, FastHashRead64(p + 24) ^ see1);
+						see2 = FastHashMix(FastHashRead64(p + 32) ^ kSecret3, FastHashRead64(p + 40) ^ see2);
+						p += 48;
+						i -= 48;
+					} while(EASTL_LIKELY(i > 48));
+					seed ^= see1 ^ see2;
+				}
+
+				while(EASTL_UNLIKELY(i > 16))
+				{
+					seed = FastHashMix(FastHashRead64(p) ^ kSecret1, FastHashRead64(p + 8) ^ seed);
+					i -= 16;
+					p += 16;
+				}
+
+				a = FastHashRead64(p + i - 16);
+				b = FastHashRead64(p + i - 8);
+			}
+
+			return FastHashMix(kSecret1 ^ nLength, FastHashMix(a ^ kSecret1, b ^ seed));
+		}
+
+		template <typename CharT>
+		inline size_t FastHashStrlen(const CharT* p)
+		{
+			const CharT* pEnd = p;
+			while(*pEnd)
+				++pEnd;
+			return (size_t)(pEnd - p);
+		}
+
+		inline size_t FastHashStrlen(const char* p)
+			{ return strlen(p); }
+	}
+
+
+	/// fast_string_hash
+	///
+	/// A 64 bit string hash which processes eight or more bytes per step instead
+	/// of the one byte per step of the FNV1 hash used by the default string hashes
+	/// below. It is much faster for strings longer than a few characters and has
+	/// far better avalanche behavior, which matters for power of two tables.
+	///
+	/// It can be used with any null-terminated character pointer or any type with
+	/// data() and size(), such as basic_string and basic_string_view. The same
+	/// characters give the same hash regardless of the string type used, so
+	/// find_as lookups by character pointer work.
+	///
+	/// Define EASTL_STRING_HASH_FAST to 1 to make this the default eastl::hash
+	/// for character pointers, strings and string views.
+	///
+	/// Example usage:
+	///    hash_map<string, int, fast_string_hash> stringMap;
+	///
+	struct fast_string_hash
+	{
+		template <typename CharT>
+		size_t operator()(const CharT* p) const
+			{ return (size_t)Internal::FastHashBytes(p, Internal::FastHashStrlen(p) * sizeof(CharT)); }
+
+		template <typename String>
+		size_t operator()(const String& s) const
+			{ return (size_t)Internal::FastHashBytes(s.data(), (size_t)s.size() * sizeof(*s.data())); }
+	};
+
+
 	///////////////////////////////////////////////////////////////////////////
 	// string hashes
 	//
@@ -1207,10 +1365,14 @@ namespace eastl
 	{
 		size_t operator()(const char* p) const
 		{
-			uint32_t c, result = 2166136261U;   // FNV1 hash. Perhaps the best string hash. Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint8_t)*p++) != 0)     // Using '!=' disables compiler warnings.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;   // FNV1 hash. Perhaps the best string hash. Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while((c = (uint8_t)*p++) != 0)     // Using '!=' disables compiler warnings.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -1218,10 +1380,14 @@ namespace eastl
 	{
 		size_t operator()(const char* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint8_t)*p++) != 0)     // cast to unsigned 8 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while((c = (uint8_t)*p++) != 0)     // cast to unsigned 8 bit.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -1230,10 +1396,14 @@ namespace eastl
 	{
 		size_t operator()(const char8_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // FNV1 hash. Perhaps the best string hash. Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint8_t)*p++) != 0)     // Using '!=' disables compiler warnings.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;   // FNV1 hash. Perhaps the best string hash. Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while((c = (uint8_t)*p++) != 0)     // Using '!=' disables compiler warnings.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -1241,10 +1411,14 @@ namespace eastl
 	{
 		size_t operator()(const char8_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint8_t)*p++) != 0)     // cast to unsigned 8 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while((c = (uint8_t)*p++) != 0)     // cast to unsigned 8 bit.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 #endif
@@ -1254,10 +1428,14 @@ namespace eastl
 	{
 		size_t operator()(const char16_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint16_t)*p++) != 0)    // cast to unsigned 16 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while((c = (uint16_t)*p++) != 0)    // cast to unsigned 16 bit.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -1265,10 +1443,14 @@ namespace eastl
 	{
 		size_t operator()(const char16_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint16_t)*p++) != 0)    // cast to unsigned 16 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while((c = (uint16_t)*p++) != 0)    // cast to unsigned 16 bit.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -1276,10 +1458,14 @@ namespace eastl
 	{
 		size_t operator()(const char32_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -1287,10 +1473,14 @@ namespace eastl
 	{
 		size_t operator()(const char32_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -1299,10 +1489,14 @@ namespace eastl
 	{
 		size_t operator()(const wchar_t* p) const
 		{
-			uint32_t c, result = 2166136261U;    // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while ((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;    // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while ((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -1310,10 +1504,14 @@ namespace eastl
 	{
 		size_t operator()(const wchar_t* p) const
 		{
-			uint32_t c, result = 2166136261U;    // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while ((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(p);
+			#else
+				uint32_t c, result = 2166136261U;    // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while ((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 #endif
@@ -1334,11 +1532,15 @@ namespace eastl
 
 		size_t operator()(const string_type& s) const
 		{
-			const unsigned_value_type* p = (const unsigned_value_type*)s.c_str();
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = *p++) != 0)
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(s);
+			#else
+				const unsigned_value_type* p = (const unsigned_value_type*)s.c_str();
+				uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				while((c = *p++) != 0)
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -0,0 +1,1867 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements btree, an ordered tree with wide nodes which is the
+// shared implementation of btree_map, btree_multimap, btree_set and
+// btree_multiset.
+//
+// The primary distinctions between btree and rbtree are:
+//    - Each node holds many values (as many as fit in about 256 bytes by
+//      default) stored inline in an array, rather than one value per node.
+//      A lookup thus visits a few nodes and does a binary search within
+//      each, rather than chasing a pointer per comparison, and in-order
+//      iteration mostly walks along an array.
+//    - The per-element overhead is a small fraction of a pointer, whereas
+//      an rbtree node has three pointers and a color per element.
+//    - Values are moved between nodes as the tree is modified, so insert
+//      and erase invalidate all iterators, pointers and references into the
+//      container, as with vector. rbtree insert never invalidates them.
+//    - The value types must be MoveConstructible.
+//
+// This is a classic B-tree rather than a B+tree: internal nodes hold values
+// as well as children. It follows the btree containers of Google's Abseil
+// library in its node layout and erase rebalancing.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EABase/eabase.h>
+
+#include <EASTL/internal/config.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/allocator.h>
+#include <EASTL/iterator.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/initializer_list.h>
+#include <string.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+	#include <new>
+	#include <stddef.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+// 4512/4626 - 'class' : assignment operator could not be generated.
+// 4530 - C++ exception handler used, but unwind semantics are not enabled. Specify /EHsc
+// 4571 - catch(...) semantics changed since Visual C++ 7.1; structured exceptions (SEH) are no longer caught.
+EA_DISABLE_VC_WARNING(4512 4626 4530 4571);
+
+
+namespace eastl
+{
+
+	/// EASTL_BTREE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_DEFAULT_NAME
+		#define EASTL_BTREE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree" // Unless the user overrides something, this is "EASTL btree".
+	#endif
+
+
+	/// EASTL_BTREE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE
+	///
+	/// The size in bytes that btree nodes are sized to be close to, which
+	/// determines how many values a node holds. Larger nodes make the tree
+	/// shallower but make insert and erase move more values within a node.
+	///
+	#ifndef EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE
+		#define EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE 256
+	#endif
+
+
+
+	namespace Internal
+	{
+		/// btree_node_value_count
+		///
+		/// The number of values which fit in a node of nTargetNodeSize bytes after the node's
+		/// header. A node always holds at least three values, so that when a full node is split
+		/// there is a value left on each side of the one which moves up to the parent.
+		///
+		template <typename Value, size_t nTargetNodeSize>
+		struct btree_node_value_count
+		{
+			static const size_t kHeaderSize = sizeof(void*) * 2;
+			static const size_t kFitCount   = (nTargetNodeSize > kHeaderSize) ? ((nTargetNodeSize - kHeaderSize) / sizeof(Value)) : 0;
+			static const size_t value       = (kFitCount < 3) ? 3 : ((kFitCount > 4096) ? 4096 : kFitCount);
+		};
+	}
+
+
+
+	template <typename Value, size_t nNodeValues>
+	struct btree_internal_node;
+
+
+	/// btree_node
+	///
+	/// A leaf node of a btree, and the leading part of an internal node. Values are
+	/// stored in uninitialized storage, of which the first mnCount slots are constructed.
+	///
+	template <typename Value, size_t nNodeValues>
+	struct btree_node
+	{
+		typedef btree_node<Value, nNodeValues>                                   this_type;
+		typedef btree_internal_node<Value, nNodeValues>                          internal_node_type;
+		typedef typename aligned_storage<sizeof(Value), EASTL_ALIGN_OF(Value)>::type storage_type;
+
+		this_type*   mpParent;      // NULL for the root node.
+		uint16_t     mnPosition;    // The index of this node in mpParent's children.
+		uint16_t     mnCount;       // The number of values in this node.
+		bool         mbLeaf;
+		storage_type mValues[nNodeValues];
+
+		Value* value(int i)
+			{ return reinterpret_cast<Value*>(&mValues[i]); }
+
+		const Value* value(int i) const
+			{ return reinterpret_cast<const Value*>(&mValues[i]); }
+
+		// Valid only for internal nodes, which have mnCount + 1 children.
+		this_type*& child(int i)
+			{ return static_cast<internal_node_type*>(this)->mpChildren[i]; }
+
+		this_type* child(int i) const
+			{ return static_cast<const internal_node_type*>(this)->mpChildren[i]; }
+	};
+
+
+	/// btree_internal_node
+	///
+	template <typename Value, size_t nNodeValues>
+	struct btree_internal_node : public btree_node<Value, nNodeValues>
+	{
+		btree_node<Value, nNodeValues>* mpChildren[nNodeValues + 1];
+	};
+
+
+
+	/// btree_iterator
+	///
+	/// Refers to a value by its node and its index within the node. The end iterator
+	/// refers to one past the last value of the rightmost leaf.
+	///
+	template <typename Value, size_t nNodeValues, typename Pointer, typename Reference>
+	struct btree_iterator
+	{
+		typedef btree_iterator<Value, nNodeValues, Pointer, Reference>            this_type;
+		typedef btree_iterator<Value, nNodeValues, Value*, Value&>                iterator;
+		typedef btree_iterator<Value, nNodeValues, const Value*, const Value&>    const_iterator;
+		typedef btree_node<Value, nNodeValues>                                    node_type;
+		typedef eastl_size_t                                                      size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef ptrdiff_t                                                         difference_type;
+		typedef Value                                                             value_type;
+		typedef Pointer                                                           pointer;
+		typedef Reference                                                         reference;
+		typedef EASTL_ITC_NS::bidirectional_iterator_tag                          iterator_category;
+
+	public:
+		node_type* mpNode;
+		int        mnPosition;
+
+	public:
+		btree_iterator()
+			: mpNode(NULL), mnPosition(0) { }
+
+		btree_iterator(node_type* pNode, int nPosition)
+			: mpNode(pNode), mnPosition(nPosition) { }
+
+		btree_iterator(const iterator& x)
+			: mpNode(x.mpNode), mnPosition(x.mnPosition) { }
+
+		btree_iterator& operator=(const iterator& x)
+			{ mpNode = x.mpNode; mnPosition = x.mnPosition; return *this; }
+
+		reference operator*() const
+			{ return *mpNode->value(mnPosition); }
+
+		pointer operator->() const
+			{ return mpNode->value(mnPosition); }
+
+		this_type& operator++()
+		{
+			if(mpNode->mbLeaf && (++mnPosition < (int)mpNode->mnCount))
+				return *this;
+
+			increment_slow();
+			return *this;
+		}
+
+		this_type operator++(int)
+			{ this_type temp(*this); ++*this; return temp; }
+
+		this_type& operator--()
+		{
+			if(mpNode->mbLeaf && (--mnPosition >= 0))
+				return *this;
+
+			decrement_slow();
+			return *this;
+		}
+
+		this_type operator--(int)
+			{ this_type temp(*this); --*this; return temp; }
+
+	protected:
+		void increment_slow()
+		{
+			if(mpNode->mbLeaf)
+			{
+				// We've stepped off the end of a leaf, so ascend until we come from a child which
+				// has a value after it. If there is none, we were at the last value, and we stay
+				// one past it, which is end().
+				const this_type saved(*this);
+
+				while((mnPosition == (int)mpNode->mnCount) && mpNode->mpParent)
+				{
+					mnPosition = mpNode->mnPosition;
+					mpNode     = mpNode->mpParent;
+				}
+
+				if(mnPosition == (int)mpNode->mnCount)
+					*this = saved;
+			}
+			else
+			{
+				// The next value is the first value of the leftmost leaf of the right child.
+				mpNode = mpNode->child(mnPosition + 1);
+
+				while(!mpNode->mbLeaf)
+					mpNode = mpNode->child(0);
+
+				mnPosition = 0;
+			}
+		}
+
+		void decrement_slow()
+		{
+			if(mpNode->mbLeaf)
+			{
+				const this_type saved(*this);
+
+				while((mnPosition < 0) && mpNode->mpParent)
+				{
+					mnPosition = (int)mpNode->mnPosition - 1;
+					mpNode     = mpNode->mpParent;
+				}
+
+				if(mnPosition < 0) // Decrementing begin() is undefined; we leave the iterator where it was.
+					*this = saved;
+			}
+			else
+			{
+				// The previous value is the last value of the rightmost leaf of the left child.
+				mpNode = mpNode->child(mnPosition);
+
+				while(!mpNode->mbLeaf)
+					mpNode = mpNode->child(mpNode->mnCount);
+
+				mnPosition = (int)mpNode->mnCount - 1;
+			}
+		}
+
+	}; // btree_iterator
+
+
+	template <typename Value, size_t nNodeValues, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+	inline bool operator==(const btree_iterator<Value, nNodeValues, PointerA, ReferenceA>& a,
+						   const btree_iterator<Value, nNodeValues, PointerB, ReferenceB>& b)
+		{ return (a.mpNode == b.mpNode) && (a.mnPosition == b.mnPosition); }
+
+	template <typename Value, size_t nNodeValues, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+	inline bool operator!=(const btree_iterator<Value, nNodeValues, PointerA, ReferenceA>& a,
+						   const btree_iterator<Value, nNodeValues, PointerB, ReferenceB>& b)
+		{ return (a.mpNode != b.mpNode) || (a.mnPosition != b.mnPosition); }
+
+	// We provide a version of operator!= for the case where the iterators are of the
+	// same type. This helps prevent ambiguity errors in the presence of rel_ops.
+	template <typename Value, size_t nNodeValues, typename Pointer, typename Reference>
+	inline bool operator!=(const btree_iterator<Value, nNodeValues, Pointer, Reference>& a,
+						   const btree_iterator<Value, nNodeValues, Pointer, Reference>& b)
+		{ return (a.mpNode != b.mpNode) || (a.mnPosition != b.mnPosition); }
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	/// btree
+	///
+	/// btree is the basis for btree_map, btree_multimap, btree_set and btree_multiset,
+	/// as rbtree is for map, multimap, set and multiset. The template parameters have the
+	/// same meaning as rbtree's, with the addition of nTargetNodeSize.
+	///
+	/// Compare (functor): This is a comparison class which defaults to 'less'.
+	///
+	/// ExtractKey (functor): This is a class which gets the key from a stored value.
+	/// It is eastl::use_first for the maps and eastl::use_self for the sets.
+	///
+	/// bMutableIterators (bool): true if btree::iterator is a mutable iterator, false
+	/// if iterator and const_iterator are both const iterators.
+	///
+	/// bUniqueKeys (bool): true if the keys are to be unique, and false if there can be
+	/// multiple instances of a given key. Equivalent keys are kept in insertion order.
+	///
+	/// nTargetNodeSize (size_t): the approximate size in bytes of a node, which sets the
+	/// number of values per node. See EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE.
+	///
+	/// Every node except the root holds at least one value, and every leaf is at the same
+	/// depth. Erase merges a node with a sibling when they fit in one node together, and
+	/// otherwise moves values from a sibling so that the node isn't left empty, so nodes are
+	/// usually at least half full. Insert splits a full node in two, except that inserting
+	/// at the end or beginning of a node splits it unevenly, which leaves nodes nearly full
+	/// when values are inserted in ascending or descending order.
+	///
+	/// Insert and erase invalidate all iterators, pointers and references into the container.
+	/// The value passed to an insert function must not refer to an element of the container.
+	///
+	template <typename Key, typename Value, typename Compare, typename Allocator, typename ExtractKey,
+			  bool bMutableIterators, bool bUniqueKeys, size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree
+	{
+	public:
+		static const size_t kNodeValues    = Internal::btree_node_value_count<Value, nTargetNodeSize>::value;
+		static const size_t kMinNodeValues = kNodeValues / 2;
+
+		typedef ptrdiff_t                                                                       difference_type;
+		typedef eastl_size_t                                                                    size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef Key                                                                             key_type;
+		typedef Value                                                                           value_type;
+		typedef btree_node<value_type, kNodeValues>                                             node_type;
+		typedef btree_internal_node<value_type, kNodeValues>                                    internal_node_type;
+		typedef value_type&                                                                     reference;
+		typedef const value_type&                                                               const_reference;
+		typedef value_type*                                                                     pointer;
+		typedef const value_type*                                                               const_pointer;
+
+		typedef typename conditional<bMutableIterators,
+					btree_iterator<value_type, kNodeValues, value_type*, value_type&>,
+					btree_iterator<value_type, kNodeValues, const value_type*, const value_type&> >::type iterator;
+		typedef btree_iterator<value_type, kNodeValues, const value_type*, const value_type&>   const_iterator;
+		typedef eastl::reverse_iterator<iterator>                                               reverse_iterator;
+		typedef eastl::reverse_iterator<const_iterator>                                         const_reverse_iterator;
+
+		typedef Allocator                                                                       allocator_type;
+		typedef Compare                                                                         key_compare;
+		typedef typename conditional<bUniqueKeys, eastl::pair<iterator, bool>, iterator>::type  insert_return_type;
+		typedef btree<Key, Value, Compare, Allocator, ExtractKey, bMutableIterators, bUniqueKeys, nTargetNodeSize> this_type;
+		typedef integral_constant<bool, bUniqueKeys>                                            has_unique_keys_type;
+		typedef ExtractKey                                                                      extract_key;
+
+	protected:
+		node_type*      mpRoot;         // NULL when the tree is empty.
+		node_type*      mpLeftmost;     // The leaf which holds the first value, for begin().
+		node_type*      mpRightmost;    // The leaf which holds the last value, for end().
+		size_type       mnSize;
+		Compare         mCompare;       // To do: Make this instance use zero space when it is zero size.
+		allocator_type  mAllocator;     // To do: Use base class optimization to make this go away.
+
+	public:
+		btree();
+		btree(const allocator_type& allocator);
+		btree(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_DEFAULT_ALLOCATOR);
+		btree(const this_type& x);
+		btree(this_type&& x);
+		btree(this_type&& x, const allocator_type& allocator);
+
+		template <typename InputIterator>
+		btree(InputIterator first, InputIterator last, const Compare& compare, const allocator_type& allocator = EASTL_BTREE_DEFAULT_ALLOCATOR);
+
+	   ~btree();
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT { return mAllocator; }
+		allocator_type&       get_allocator() EA_NOEXCEPT       { return mAllocator; }
+		void                  set_allocator(const allocator_type& allocator) { mAllocator = allocator; }
+
+		const key_compare& key_comp() const { return mCompare; }
+		key_compare&       key_comp()       { return mCompare; }
+
+		this_type& operator=(const this_type& x);
+		this_type& operator=(std::initializer_list<value_type> ilist);
+		this_type& operator=(this_type&& x);
+
+		void swap(this_type& x);
+
+		iterator        begin() EA_NOEXCEPT          { return iterator(mpLeftmost, 0); }
+		const_iterator  begin() const EA_NOEXCEPT    { return const_iterator(mpLeftmost, 0); }
+		const_iterator  cbegin() const EA_NOEXCEPT   { return const_iterator(mpLeftmost, 0); }
+
+		iterator        end() EA_NOEXCEPT            { return DoEnd(); }
+		const_iterator  end() const EA_NOEXCEPT      { return DoEnd(); }
+		const_iterator  cend() const EA_NOEXCEPT     { return DoEnd(); }
+
+		reverse_iterator        rbegin() EA_NOEXCEPT        { return reverse_iterator(end()); }
+		const_reverse_iterator  rbegin() const EA_NOEXCEPT  { return const_reverse_iterator(end()); }
+		const_reverse_iterator  crbegin() const EA_NOEXCEPT { return const_reverse_iterator(end()); }
+
+		reverse_iterator        rend() EA_NOEXCEPT          { return reverse_iterator(begin()); }
+		const_reverse_iterator  rend() const EA_NOEXCEPT    { return const_reverse_iterator(begin()); }
+		const_reverse_iterator  crend() const EA_NOEXCEPT   { return const_reverse_iterator(begin()); }
+
+		bool      empty() const EA_NOEXCEPT { return mnSize == 0; }
+		size_type size() const EA_NOEXCEPT  { return mnSize; }
+
+		template <class... Args>
+		insert_return_type emplace(Args&&... args);
+
+		template <class... Args>
+		iterator emplace_hint(const_iterator position, Args&&... args);
+
+		template <class P, class = typename eastl::enable_if<eastl::is_constructible<value_type, P&&>::value>::type>
+		insert_return_type insert(P&& otherValue)
+			{ return emplace(eastl::forward<P>(otherValue)); }
+
+		/// btree_map::insert and btree_set::insert return a pair, while btree_multimap::insert
+		/// and btree_multiset::insert return an iterator.
+		insert_return_type insert(const value_type& value);
+		insert_return_type insert(value_type&& value);
+
+		/// The value is inserted before position if that is where it belongs, which costs
+		/// only a comparison or two, and otherwise is inserted as if no hint were given.
+		iterator insert(const_iterator position, const value_type& value);
+		iterator insert(const_iterator position, value_type&& value);
+
+		void insert(std::initializer_list<value_type> ilist);
+
+		template <typename InputIterator>
+		void insert(InputIterator first, InputIterator last);
+
+		template <class M> eastl::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj);
+		template <class M> eastl::pair<iterator, bool> insert_or_assign(key_type&& k, M&& obj);
+		template <class M> iterator                    insert_or_assign(const_iterator hint, const key_type& k, M&& obj);
+		template <class M> iterator                    insert_or_assign(const_iterator hint, key_type&& k, M&& obj);
+
+		iterator         erase(const_iterator position);
+		iterator         erase(const_iterator first, const_iterator last);
+		reverse_iterator erase(const_reverse_iterator position);
+		reverse_iterator erase(const_reverse_iterator first, const_reverse_iterator last);
+		size_type        erase(const key_type& k);
+
+		void clear();
+		void reset_lose_memory() EA_NOEXCEPT; // This is a unilateral reset to an initially empty state. No destructors are called, no deallocation occurs.
+
+		iterator       find(const key_type& key);
+		const_iterator find(const key_type& key) const;
+
+		/// Implements a find whereby the user supplies a comparison of a different type
+		/// than the tree's value_type, as with rbtree::find_as.
+		///
+		/// Example usage (note that the compare uses string as first type and char* as second):
+		///     btree_set<string> strings;
+		///     strings.find_as("hello", less<>());
+		///
+		template <typename U, typename Compare2> iterator       find_as(const U& u, Compare2 compare2);
+		template <typename U, typename Compare2> const_iterator find_as(const U& u, Compare2 compare2) const;
+
+		bool      contains(const key_type& key) const { return DoFind(key) != DoEnd(); }
+		size_type count(const key_type& key) const;
+
+		iterator       lower_bound(const key_type& key)       { return DoLowerBound(key, mCompare); }
+		const_iterator lower_bound(const key_type& key) const { return DoLowerBound(key, mCompare); }
+
+		iterator       upper_bound(const key_type& key)       { return DoUpperBound(key, mCompare); }
+		const_iterator upper_bound(const key_type& key) const { return DoUpperBound(key, mCompare); }
+
+		eastl::pair<iterator, iterator>             equal_range(const key_type& key);
+		eastl::pair<const_iterator, const_iterator> equal_range(const key_type& key) const;
+
+		/// Returns the number of nodes in the tree. With size(), this gives the number of
+		/// values per node, and with sizeof(node_type) and sizeof(internal_node_type) the
+		/// memory used.
+		size_type node_count() const { return mpRoot ? DoNodeCount(mpRoot) : 0; }
+
+		bool validate() const;
+		int  validate_iterator(const_iterator i) const;
+
+	protected:
+		iterator DoEnd() const
+			{ return iterator(mpRightmost, mpRightmost ? (int)mpRightmost->mnCount : 0); }
+
+		node_type* DoAllocateNode(bool bLeaf);
+		void       DoFreeNode(node_type* pNode);
+		void       DoDestroySubtree(node_type* pNode);
+		size_type  DoNodeCount(const node_type* pNode) const;
+
+		static void DoTransfer(node_type* pDest, int iDest, node_type* pSrc, int iSrc);
+		static void DoTransferRange(node_type* pDest, int iDest, node_type* pSrc, int iSrc, int nCount);
+		static void DoSetChild(node_type* pParent, int i, node_type* pChild);
+
+		template <typename KX, typename CompareX>
+		int DoNodeLowerBound(const node_type* pNode, const KX& k, CompareX compare) const;
+
+		template <typename KX, typename CompareX>
+		int DoNodeUpperBound(const node_type* pNode, const KX& k, CompareX compare) const;
+
+		// These return the bound, and if pLeafPosition is non-NULL, also the position in a
+		// leaf at which a value with key k would be inserted. The two differ when the bound
+		// is a value in an internal node, or is end().
+		template <typename KX, typename CompareX>
+		iterator DoLowerBound(const KX& k, CompareX compare, iterator* pLeafPosition = NULL) const;
+
+		template <typename KX, typename CompareX>
+		iterator DoUpperBound(const KX& k, CompareX compare, iterator* pLeafPosition = NULL) const;
+
+		iterator DoFind(const key_type& k) const;
+
+		template <class... Args>
+		iterator DoInsertAt(node_type* pLeaf, int nPosition, Args&&... args);
+
+		template <class... Args>
+		iterator DoInsertBefore(iterator position, Args&&... args);
+
+		void DoSplit(node_type*& pNode, int& nPosition);
+
+		template <typename KX, class... Args>
+		eastl::pair<iterator, bool> DoInsertUnique(const KX& k, Args&&... args);
+
+		template <class... Args>
+		iterator DoInsertMulti(const key_type& k, Args&&... args);
+
+		template <class... Args>
+		iterator DoInsertHint(true_type, const_iterator position, const key_type& k, Args&&... args);
+
+		template <class... Args>
+		iterator DoInsertHint(false_type, const_iterator position, const key_type& k, Args&&... args);
+
+		template <class V>
+		eastl::pair<iterator, bool> DoInsertValue(true_type, V&& value);
+
+		template <class V>
+		iterator DoInsertValue(false_type, V&& value);
+
+		template <class K, class M>
+		eastl::pair<iterator, bool> DoInsertOrAssign(K&& k, M&& obj);
+
+		iterator DoRebalanceAfterErase(iterator position);
+		bool     DoTryMergeOrRebalance(iterator& position);
+		void     DoMerge(node_type* pLeft, node_type* pRight);
+		void     DoRebalanceRightToLeft(node_type* pLeft, node_type* pRight, int nCount);
+		void     DoRebalanceLeftToRight(node_type* pLeft, node_type* pRight, int nCount);
+		void     DoTryShrink();
+
+		bool     DoValidateNode(const node_type* pNode, int nDepth, int& nLeafDepth, size_type& nValueCount) const;
+
+	}; // class btree
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline btree<K, V, C, A, E, bM, bU, N>::btree()
+		: mpRoot(NULL), mpLeftmost(NULL), mpRightmost(NULL), mnSize(0), mCompare(), mAllocator(EASTL_BTREE_DEFAULT_NAME)
+	{
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline btree<K, V, C, A, E, bM, bU, N>::btree(const allocator_type& allocator)
+		: mpRoot(NULL), mpLeftmost(NULL), mpRightmost(NULL), mnSize(0), mCompare(), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline btree<K, V, C, A, E, bM, bU, N>::btree(const C& compare, const allocator_type& allocator)
+		: mpRoot(NULL), mpLeftmost(NULL), mpRightmost(NULL), mnSize(0), mCompare(compare), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline btree<K, V, C, A, E, bM, bU, N>::btree(const this_type& x)
+		: mpRoot(NULL), mpLeftmost(NULL), mpRightmost(NULL), mnSize(0), mCompare(x.mCompare), mAllocator(x.mAllocator)
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				// The values are already in order, so each is appended to the rightmost leaf.
+				// Appending splits nodes unevenly, so the copy's nodes end up nearly full.
+				for(const_iterator it = x.begin(), itEnd = x.end(); it != itEnd; ++it)
+					DoInsertAt(mpRightmost, mpRightmost ? (int)mpRightmost->mnCount : 0, *it);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				clear();
+				throw;
+			}
+		#endif
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline btree<K, V, C, A, E, bM, bU, N>::btree(this_type&& x)
+		: mpRoot(NULL), mpLeftmost(NULL), mpRightmost(NULL), mnSize(0), mCompare(x.mCompare), mAllocator(x.mAllocator)
+	{
+		swap(x);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline btree<K, V, C, A, E, bM, bU, N>::btree(this_type&& x, const allocator_type& allocator)
+		: mpRoot(NULL), mpLeftmost(NULL), mpRightmost(NULL), mnSize(0), mCompare(x.mCompare), mAllocator(allocator)
+	{
+		swap(x); // swap will directly or indirectly handle the possibility that mAllocator != x.mAllocator.
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <typename InputIterator>
+	inline btree<K, V, C, A, E, bM, bU, N>::btree(InputIterator first, InputIterator last, const C& compare, const allocator_type& allocator)
+		: mpRoot(NULL), mpLeftmost(NULL), mpRightmost(NULL), mnSize(0), mCompare(compare), mAllocator(allocator)
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				insert(first, last);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				clear();
+				throw;
+			}
+		#endif
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline btree<K, V, C, A, E, bM, bU, N>::~btree()
+	{
+		clear();
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	typename btree<K, V, C, A, E, bM, bU, N>::this_type&
+	btree<K, V, C, A, E, bM, bU, N>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			clear();
+
+			#if EASTL_ALLOCATOR_COPY_ENABLED
+				mAllocator = x.mAllocator;
+			#endif
+
+			mCompare = x.mCompare;
+
+			for(const_iterator it = x.begin(), itEnd = x.end(); it != itEnd; ++it)
+				DoInsertAt(mpRightmost, mpRightmost ? (int)mpRightmost->mnCount : 0, *it);
+		}
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	typename btree<K, V, C, A, E, bM, bU, N>::this_type&
+	btree<K, V, C, A, E, bM, bU, N>::operator=(std::initializer_list<value_type> ilist)
+	{
+		clear();
+		insert(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	typename btree<K, V, C, A, E, bM, bU, N>::this_type&
+	btree<K, V, C, A, E, bM, bU, N>::operator=(this_type&& x)
+	{
+		if(this != &x)
+		{
+			clear();
+			swap(x);
+		}
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	void btree<K, V, C, A, E, bM, bU, N>::swap(this_type& x)
+	{
+		eastl::swap(mpRoot,      x.mpRoot);
+		eastl::swap(mpLeftmost,  x.mpLeftmost);
+		eastl::swap(mpRightmost, x.mpRightmost);
+		eastl::swap(mnSize,   x.mnSize);
+		eastl::swap(mCompare, x.mCompare);
+
+		if(mAllocator != x.mAllocator) // If allocators are not equivalent...
+			eastl::swap(mAllocator, x.mAllocator);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class... Args>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::insert_return_type
+	btree<K, V, C, A, E, bM, bU, N>::emplace(Args&&... args)
+	{
+		// We need the key to find the position, so the value is constructed up front and then
+		// moved into the tree.
+		return DoInsertValue(has_unique_keys_type(), value_type(eastl::forward<Args>(args)...));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class... Args>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::emplace_hint(const_iterator position, Args&&... args)
+	{
+		value_type value(eastl::forward<Args>(args)...);
+		return DoInsertHint(has_unique_keys_type(), position, extract_key()(value), eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::insert_return_type
+	btree<K, V, C, A, E, bM, bU, N>::insert(const value_type& value)
+	{
+		return DoInsertValue(has_unique_keys_type(), value);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::insert_return_type
+	btree<K, V, C, A, E, bM, bU, N>::insert(value_type&& value)
+	{
+		return DoInsertValue(has_unique_keys_type(), eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::insert(const_iterator position, const value_type& value)
+	{
+		return DoInsertHint(has_unique_keys_type(), position, extract_key()(value), value);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::insert(const_iterator position, value_type&& value)
+	{
+		return DoInsertHint(has_unique_keys_type(), position, extract_key()(value), eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline void btree<K, V, C, A, E, bM, bU, N>::insert(std::initializer_list<value_type> ilist)
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <typename InputIterator>
+	void btree<K, V, C, A, E, bM, bU, N>::insert(InputIterator first, InputIterator last)
+	{
+		// Hinting with end() makes inserting an already sorted range cost a comparison per value
+		// instead of a search, and costs an extra comparison per value otherwise.
+		for(; first != last; ++first)
+			DoInsertHint(has_unique_keys_type(), end(), extract_key()(*first), *first);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class M>
+	inline eastl::pair<typename btree<K, V, C, A, E, bM, bU, N>::iterator, bool>
+	btree<K, V, C, A, E, bM, bU, N>::insert_or_assign(const key_type& k, M&& obj)
+	{
+		return DoInsertOrAssign(k, eastl::forward<M>(obj));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class M>
+	inline eastl::pair<typename btree<K, V, C, A, E, bM, bU, N>::iterator, bool>
+	btree<K, V, C, A, E, bM, bU, N>::insert_or_assign(key_type&& k, M&& obj)
+	{
+		return DoInsertOrAssign(eastl::move(k), eastl::forward<M>(obj));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class M>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::insert_or_assign(const_iterator /*hint*/, const key_type& k, M&& obj)
+	{
+		return DoInsertOrAssign(k, eastl::forward<M>(obj)).first;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class M>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::insert_or_assign(const_iterator /*hint*/, key_type&& k, M&& obj)
+	{
+		return DoInsertOrAssign(eastl::move(k), eastl::forward<M>(obj)).first;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::erase(const_iterator position)
+	{
+		EASTL_ASSERT_MSG(position != end(), "btree::erase: position must be dereferenceable.");
+
+		iterator   it(position.mpNode, position.mnPosition);
+		const bool bInternal = !it.mpNode->mbLeaf;
+
+		if(bInternal)
+		{
+			// Values can only be removed from leaves, so we replace the value with its
+			// predecessor, which is the last value of a leaf, and remove that instead.
+			iterator itInternal(it);
+			--it;
+			itInternal.mpNode->value(itInternal.mnPosition)->~value_type();
+			DoTransfer(itInternal.mpNode, itInternal.mnPosition, it.mpNode, it.mnPosition);
+		}
+		else
+			it.mpNode->value(it.mnPosition)->~value_type();
+
+		DoTransferRange(it.mpNode, it.mnPosition, it.mpNode, it.mnPosition + 1, (int)it.mpNode->mnCount - (it.mnPosition + 1));
+		it.mpNode->mnCount--;
+		mnSize--;
+
+		// The value after the erased leaf slot is now at it. If we erased from an internal
+		// node, that is the moved predecessor, and the value we want to return follows it.
+		iterator result = DoRebalanceAfterErase(it);
+
+		if(bInternal)
+			++result;
+
+		return result;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::erase(const_iterator first, const_iterator last)
+	{
+		if((first == begin()) && (last == end()))
+		{
+			clear();
+			return end();
+		}
+
+		// Erase invalidates iterators, including last, so we count the values to erase first.
+		iterator  it(first.mpNode, first.mnPosition);
+		size_type n = (size_type)eastl::distance(first, last);
+
+		while(n--)
+			it = erase(it);
+
+		return it;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::reverse_iterator
+	btree<K, V, C, A, E, bM, bU, N>::erase(const_reverse_iterator position)
+	{
+		return reverse_iterator(erase((++position).base()));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	typename btree<K, V, C, A, E, bM, bU, N>::reverse_iterator
+	btree<K, V, C, A, E, bM, bU, N>::erase(const_reverse_iterator first, const_reverse_iterator last)
+	{
+		// Version which erases in order from first to last.
+		// difference_type i(first.base() - last.base());
+		// while(i--)
+		//     first = erase(first);
+		// return first;
+
+		// Version which erases in order from last to first, but is slightly more efficient:
+		return reverse_iterator(erase(last.base(), first.base()));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	typename btree<K, V, C, A, E, bM, bU, N>::size_type
+	btree<K, V, C, A, E, bM, bU, N>::erase(const key_type& k)
+	{
+		const eastl::pair<iterator, iterator> range(equal_range(k));
+		const size_type n = (size_type)eastl::distance(range.first, range.second);
+
+		iterator it(range.first);
+
+		for(size_type i = 0; i < n; ++i)
+			it = erase(it);
+
+		return n;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	void btree<K, V, C, A, E, bM, bU, N>::clear()
+	{
+		if(mpRoot)
+			DoDestroySubtree(mpRoot);
+
+		reset_lose_memory();
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline void btree<K, V, C, A, E, bM, bU, N>::reset_lose_memory() EA_NOEXCEPT
+	{
+		mpRoot      = NULL;
+		mpLeftmost  = NULL;
+		mpRightmost = NULL;
+		mnSize      = 0;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::find(const key_type& key)
+	{
+		return DoFind(key);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::const_iterator
+	btree<K, V, C, A, E, bM, bU, N>::find(const key_type& key) const
+	{
+		return DoFind(key);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <typename U, typename Compare2>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::find_as(const U& u, Compare2 compare2)
+	{
+		const iterator it(DoLowerBound(u, compare2));
+		return ((it == end()) || compare2(u, extract_key()(*it))) ? end() : it;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <typename U, typename Compare2>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::const_iterator
+	btree<K, V, C, A, E, bM, bU, N>::find_as(const U& u, Compare2 compare2) const
+	{
+		return const_cast<this_type*>(this)->find_as(u, compare2);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::size_type
+	btree<K, V, C, A, E, bM, bU, N>::count(const key_type& key) const
+	{
+		if(bU)
+			return contains(key) ? 1 : 0;
+
+		const eastl::pair<const_iterator, const_iterator> range(equal_range(key));
+		return (size_type)eastl::distance(range.first, range.second);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline eastl::pair<typename btree<K, V, C, A, E, bM, bU, N>::iterator, typename btree<K, V, C, A, E, bM, bU, N>::iterator>
+	btree<K, V, C, A, E, bM, bU, N>::equal_range(const key_type& key)
+	{
+		const iterator itLower(DoLowerBound(key, mCompare));
+
+		if(bU)
+		{
+			if((itLower != end()) && !mCompare(key, extract_key()(*itLower)))
+			{
+				iterator itUpper(itLower);
+				return eastl::pair<iterator, iterator>(itLower, ++itUpper);
+			}
+
+			return eastl::pair<iterator, iterator>(itLower, itLower);
+		}
+
+		return eastl::pair<iterator, iterator>(itLower, DoUpperBound(key, mCompare));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline eastl::pair<typename btree<K, V, C, A, E, bM, bU, N>::const_iterator, typename btree<K, V, C, A, E, bM, bU, N>::const_iterator>
+	btree<K, V, C, A, E, bM, bU, N>::equal_range(const key_type& key) const
+	{
+		const eastl::pair<iterator, iterator> range(const_cast<this_type*>(this)->equal_range(key));
+		return eastl::pair<const_iterator, const_iterator>(range.first, range.second);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	bool btree<K, V, C, A, E, bM, bU, N>::validate() const
+	{
+		if(!mpRoot)
+			return (mnSize == 0) && !mpLeftmost && !mpRightmost;
+
+		if(mpRoot->mpParent || (mnSize == 0))
+			return false;
+
+		int       nLeafDepth  = -1;
+		size_type nValueCount = 0;
+
+		if(!DoValidateNode(mpRoot, 0, nLeafDepth, nValueCount) || (nValueCount != mnSize))
+			return false;
+
+		// mpLeftmost and mpRightmost must be the first and last leaves.
+		const node_type* pNode = mpRoot;
+		while(!pNode->mbLeaf)
+			pNode = pNode->child(0);
+		if(pNode != mpLeftmost)
+			return false;
+
+		pNode = mpRoot;
+		while(!pNode->mbLeaf)
+			pNode = pNode->child(pNode->mnCount);
+		if(pNode != mpRightmost)
+			return false;
+
+		// Iteration must visit every value in order, in both directions.
+		size_type nIterCount = 0;
+
+		for(const_iterator it = begin(), itPrev = it, itEnd = end(); it != itEnd; itPrev = it, ++it, ++nIterCount)
+		{
+			if(nIterCount)
+			{
+				if(bU ? !mCompare(extract_key()(*itPrev), extract_key()(*it)) : mCompare(extract_key()(*it), extract_key()(*itPrev)))
+					return false;
+
+				const_iterator itTemp(it);
+				if(--itTemp != itPrev)
+					return false;
+			}
+		}
+
+		return nIterCount == mnSize;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	int btree<K, V, C, A, E, bM, bU, N>::validate_iterator(const_iterator i) const
+	{
+		// To do: Come up with a more efficient mechanism of doing this.
+
+		for(const_iterator temp = begin(), tempEnd = end(); temp != tempEnd; ++temp)
+		{
+			if(temp == i)
+				return (isf_valid | isf_current | isf_can_dereference);
+		}
+
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		return isf_none;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::node_type*
+	btree<K, V, C, A, E, bM, bU, N>::DoAllocateNode(bool bLeaf)
+	{
+		const size_t nSize  = bLeaf ? sizeof(node_type) : sizeof(internal_node_type);
+		node_type*   pNode  = (node_type*)allocate_memory(mAllocator, nSize, EASTL_ALIGN_OF(internal_node_type), 0);
+		EASTL_ASSERT_MSG(pNode != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
+
+		pNode->mpParent   = NULL;
+		pNode->mnPosition = 0;
+		pNode->mnCount    = 0;
+		pNode->mbLeaf     = bLeaf;
+
+		return pNode;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline void btree<K, V, C, A, E, bM, bU, N>::DoFreeNode(node_type* pNode)
+	{
+		EASTLFree(mAllocator, pNode, pNode->mbLeaf ? sizeof(node_type) : sizeof(internal_node_type));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	void btree<K, V, C, A, E, bM, bU, N>::DoDestroySubtree(node_type* pNode)
+	{
+		// The recursion depth is the height of the tree, which is small.
+		if(!pNode->mbLeaf)
+		{
+			for(int i = 0; i <= (int)pNode->mnCount; i++)
+				DoDestroySubtree(pNode->child(i));
+		}
+
+		for(int i = 0; i < (int)pNode->mnCount; i++)
+			pNode->value(i)->~value_type();
+
+		DoFreeNode(pNode);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	typename btree<K, V, C, A, E, bM, bU, N>::size_type
+	btree<K, V, C, A, E, bM, bU, N>::DoNodeCount(const node_type* pNode) const
+	{
+		size_type n = 1;
+
+		if(!pNode->mbLeaf)
+		{
+			for(int i = 0; i <= (int)pNode->mnCount; i++)
+				n += DoNodeCount(pNode->child(i));
+		}
+
+		return n;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline void btree<K, V, C, A, E, bM, bU, N>::DoTransfer(node_type* pDest, int iDest, node_type* pSrc, int iSrc)
+	{
+		// Moves the value at pSrc[iSrc] into the unconstructed slot pDest[iDest], leaving pSrc[iSrc] unconstructed.
+		::new(static_cast<void*>(pDest->value(iDest))) value_type(eastl::move(*pSrc->value(iSrc)));
+		pSrc->value(iSrc)->~value_type();
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	void btree<K, V, C, A, E, bM, bU, N>::DoTransferRange(node_type* pDest, int iDest, node_type* pSrc, int iSrc, int nCount)
+	{
+		// Moves nCount values, which may overlap with their destination if the nodes are the same.
+		// The destination slots which aren't also source slots must be unconstructed, and the
+		// source slots which aren't also destination slots are left unconstructed.
+		if(nCount <= 0)
+			return;
+
+		EA_CONSTEXPR_IF(eastl::is_trivially_copyable<value_type>::value)
+			memmove(static_cast<void*>(pDest->value(iDest)), pSrc->value(iSrc), (size_t)nCount * sizeof(value_type));
+		else
+		{
+			if((pDest != pSrc) || (iDest < iSrc))
+			{
+				for(int i = 0; i < nCount; i++)
+					DoTransfer(pDest, iDest + i, pSrc, iSrc + i);
+			}
+			else
+			{
+				for(int i = nCount - 1; i >= 0; i--)
+					DoTransfer(pDest, iDest + i, pSrc, iSrc + i);
+			}
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline void btree<K, V, C, A, E, bM, bU, N>::DoSetChild(node_type* pParent, int i, node_type* pChild)
+	{
+		pParent->child(i)  = pChild;
+		pChild->mpParent   = pParent;
+		pChild->mnPosition = (uint16_t)i;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <typename KX, typename CompareX>
+	inline int btree<K, V, C, A, E, bM, bU, N>::DoNodeLowerBound(const node_type* pNode, const KX& k, CompareX compare) const
+	{
+		// Returns the index of the first value which is not less than k.
+		int nLow = 0, nHigh = (int)pNode->mnCount;
+
+		while(nLow < nHigh)
+		{
+			const int nMid = (nLow + nHigh) >> 1;
+
+			if(compare(extract_key()(*pNode->value(nMid)), k))
+				nLow = nMid + 1;
+			else
+				nHigh = nMid;
+		}
+
+		return nLow;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <typename KX, typename CompareX>
+	inline int btree<K, V, C, A, E, bM, bU, N>::DoNodeUpperBound(const node_type* pNode, const KX& k, CompareX compare) const
+	{
+		// Returns the index of the first value which is greater than k.
+		int nLow = 0, nHigh = (int)pNode->mnCount;
+
+		while(nLow < nHigh)
+		{
+			const int nMid = (nLow + nHigh) >> 1;
+
+			if(compare(k, extract_key()(*pNode->value(nMid))))
+				nHigh = nMid;
+			else
+				nLow = nMid + 1;
+		}
+
+		return nLow;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <typename KX, typename CompareX>
+	typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoLowerBound(const KX& k, CompareX compare, iterator* pLeafPosition) const
+	{
+		// The deepest node with a value not less than k holds the lower bound, as the values
+		// in a subtree are all less than the value that follows the subtree in its parent.
+		iterator   result(DoEnd());
+		node_type* pNode = mpRoot;
+
+		while(pNode)
+		{
+			const int nPosition = DoNodeLowerBound(pNode, k, compare);
+
+			if(nPosition < (int)pNode->mnCount)
+				result = iterator(pNode, nPosition);
+
+			if(pNode->mbLeaf)
+			{
+				if(pLeafPosition)
+					*pLeafPosition = iterator(pNode, nPosition);
+				break;
+			}
+
+			pNode = pNode->child(nPosition);
+		}
+
+		return result;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <typename KX, typename CompareX>
+	typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoUpperBound(const KX& k, CompareX compare, iterator* pLeafPosition) const
+	{
+		iterator   result(DoEnd());
+		node_type* pNode = mpRoot;
+
+		while(pNode)
+		{
+			const int nPosition = DoNodeUpperBound(pNode, k, compare);
+
+			if(nPosition < (int)pNode->mnCount)
+				result = iterator(pNode, nPosition);
+
+			if(pNode->mbLeaf)
+			{
+				if(pLeafPosition)
+					*pLeafPosition = iterator(pNode, nPosition);
+				break;
+			}
+
+			pNode = pNode->child(nPosition);
+		}
+
+		return result;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoFind(const key_type& k) const
+	{
+		const iterator it(DoLowerBound(k, mCompare));
+		return ((it == DoEnd()) || mCompare(k, extract_key()(*it))) ? DoEnd() : it;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class... Args>
+	typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoInsertAt(node_type* pLeaf, int nPosition, Args&&... args)
+	{
+		if(!mpRoot)
+		{
+			mpRoot = mpLeftmost = mpRightmost = pLeaf = DoAllocateNode(true);
+			nPosition = 0;
+		}
+		else if(pLeaf->mnCount == kNodeValues)
+			DoSplit(pLeaf, nPosition);
+
+		EASTL_ASSERT(pLeaf->mbLeaf && (nPosition <= (int)pLeaf->mnCount) && (pLeaf->mnCount < kNodeValues));
+
+		DoTransferRange(pLeaf, nPosition + 1, pLeaf, nPosition, (int)pLeaf->mnCount - nPosition);
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				::new(static_cast<void*>(pLeaf->value(nPosition))) value_type(eastl::forward<Args>(args)...);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				DoTransferRange(pLeaf, nPosition, pLeaf, nPosition + 1, (int)pLeaf->mnCount - nPosition);
+
+				// The leaf is empty if we allocated the root for this value, or if we split a full
+				// leaf which was being appended to, as DoSplit then moves no values to the new leaf.
+				// Remove it the same way erase removes a leaf it has emptied.
+				if(pLeaf->mnCount == 0)
+					DoRebalanceAfterErase(iterator(pLeaf, nPosition));
+
+				throw;
+			}
+		#endif
+
+		pLeaf->mnCount++;
+		mnSize++;
+
+		return iterator(pLeaf, nPosition);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class... Args>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoInsertBefore(iterator position, Args&&... args)
+	{
+		// Values are only inserted into leaves. The slot before a value in an internal node is
+		// the one after the last value of the rightmost leaf of its left child.
+		if(position.mpNode && !position.mpNode->mbLeaf)
+		{
+			--position;
+			++position.mnPosition;
+		}
+
+		return DoInsertAt(position.mpNode, position.mnPosition, eastl::forward<Args>(args)...);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	void btree<K, V, C, A, E, bM, bU, N>::DoSplit(node_type*& pNode, int& nPosition)
+	{
+		// Splits the full node pNode in two around a value which moves up to the parent, so that
+		// a value or child can then be inserted at nPosition. Updates pNode and nPosition to refer
+		// to where that insertion belongs after the split.
+		EASTL_ASSERT(pNode->mnCount == kNodeValues);
+
+		// Make sure the parent has room for the value which will move up to it.
+		if(!pNode->mpParent)
+		{
+			node_type* const pRoot = DoAllocateNode(false);
+			DoSetChild(pRoot, 0, pNode);
+			mpRoot = pRoot;
+		}
+		else if(pNode->mpParent->mnCount == kNodeValues)
+		{
+			node_type* pParent   = pNode->mpParent;
+			int        nChildPos = (int)pNode->mnPosition;
+			DoSplit(pParent, nChildPos); // This updates pNode->mpParent if pNode moves to a new parent.
+		}
+
+		node_type* const pParent  = pNode->mpParent;
+		node_type* const pSibling = DoAllocateNode(pNode->mbLeaf);
+		const int        nCount   = (int)pNode->mnCount;
+
+		// Values [0, nSplit) stay in pNode, value nSplit moves up to the parent and the rest move to
+		// pSibling. A leaf which is being appended to keeps as many values as it can, and a leaf
+		// which is being prepended to keeps as few, so that sorted insertion leaves full nodes.
+		int nSplit = nCount / 2;
+
+		if(pNode->mbLeaf)
+		{
+			if(nPosition == nCount)
+				nSplit = nCount - 1;
+			else if(nPosition == 0)
+				nSplit = 1;
+		}
+
+		DoTransferRange(pSibling, 0, pNode, nSplit + 1, nCount - (nSplit + 1));
+
+		if(!pNode->mbLeaf)
+		{
+			for(int i = nSplit + 1; i <= nCount; i++)
+				DoSetChild(pSibling, i - (nSplit + 1), pNode->child(i));
+		}
+
+		// Insert the middle value and the sibling into the parent after pNode.
+		const int nParentPos = (int)pNode->mnPosition;
+
+		DoTransferRange(pParent, nParentPos + 1, pParent, nParentPos, (int)pParent->mnCount - nParentPos);
+		DoTransfer(pParent, nParentPos, pNode, nSplit);
+
+		for(int i = (int)pParent->mnCount; i > nParentPos; i--)
+			DoSetChild(pParent, i + 1, pParent->child(i));
+		DoSetChild(pParent, nParentPos + 1, pSibling);
+
+		pParent->mnCount++;
+		pSibling->mnCount = (uint16_t)(nCount - (nSplit + 1));
+		pNode->mnCount    = (uint16_t)nSplit;
+
+		if(pNode == mpRightmost)
+			mpRightmost = pSibling;
+
+		if(nPosition > nSplit)
+		{
+			pNode      = pSibling;
+			nPosition -= (nSplit + 1);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <typename KX, class... Args>
+	eastl::pair<typename btree<K, V, C, A, E, bM, bU, N>::iterator, bool>
+	btree<K, V, C, A, E, bM, bU, N>::DoInsertUnique(const KX& k, Args&&... args)
+	{
+		iterator       itLeaf;
+		const iterator it(DoLowerBound(k, mCompare, &itLeaf));
+
+		if((it != end()) && !mCompare(k, extract_key()(*it))) // If the key is already present...
+			return eastl::pair<iterator, bool>(it, false);
+
+		return eastl::pair<iterator, bool>(DoInsertAt(itLeaf.mpNode, itLeaf.mnPosition, eastl::forward<Args>(args)...), true);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class... Args>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoInsertMulti(const key_type& k, Args&&... args)
+	{
+		// Equivalent keys are kept in insertion order, so a new value goes after any equivalent ones.
+		iterator itLeaf;
+		DoUpperBound(k, mCompare, &itLeaf);
+
+		return DoInsertAt(itLeaf.mpNode, itLeaf.mnPosition, eastl::forward<Args>(args)...);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class... Args>
+	typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoInsertHint(true_type, const_iterator position, const key_type& k, Args&&... args)
+	{
+		if(mpRoot)
+		{
+			// The hint is right if the key belongs between the value before position and position.
+			iterator itHint(position.mpNode, position.mnPosition);
+
+			if((itHint == end()) || mCompare(k, extract_key()(*itHint)))
+			{
+				if(itHint == begin())
+					return DoInsertBefore(itHint, eastl::forward<Args>(args)...);
+
+				iterator itPrev(itHint);
+
+				if(mCompare(extract_key()(*--itPrev), k))
+					return DoInsertBefore(itHint, eastl::forward<Args>(args)...);
+			}
+		}
+
+		return DoInsertUnique(k, eastl::forward<Args>(args)...).first;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class... Args>
+	typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoInsertHint(false_type, const_iterator position, const key_type& k, Args&&... args)
+	{
+		if(mpRoot)
+		{
+			iterator itHint(position.mpNode, position.mnPosition);
+
+			if((itHint == end()) || !mCompare(extract_key()(*itHint), k))
+			{
+				if(itHint == begin())
+					return DoInsertBefore(itHint, eastl::forward<Args>(args)...);
+
+				iterator itPrev(itHint);
+
+				if(!mCompare(k, extract_key()(*--itPrev)))
+					return DoInsertBefore(itHint, eastl::forward<Args>(args)...);
+			}
+		}
+
+		return DoInsertMulti(k, eastl::forward<Args>(args)...);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class V2>
+	inline eastl::pair<typename btree<K, V, C, A, E, bM, bU, N>::iterator, bool>
+	btree<K, V, C, A, E, bM, bU, N>::DoInsertValue(true_type, V2&& value)
+	{
+		return DoInsertUnique(extract_key()(value), eastl::forward<V2>(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class V2>
+	inline typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoInsertValue(false_type, V2&& value)
+	{
+		return DoInsertMulti(extract_key()(value), eastl::forward<V2>(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	template <class KX, class M>
+	eastl::pair<typename btree<K, V, C, A, E, bM, bU, N>::iterator, bool>
+	btree<K, V, C, A, E, bM, bU, N>::DoInsertOrAssign(KX&& k, M&& obj)
+	{
+		iterator       itLeaf;
+		const iterator it(DoLowerBound(k, mCompare, &itLeaf));
+
+		if((it != end()) && !mCompare(k, extract_key()(*it)))
+		{
+			it->second = eastl::forward<M>(obj);
+			return eastl::pair<iterator, bool>(it, false);
+		}
+
+		return eastl::pair<iterator, bool>(DoInsertAt(itLeaf.mpNode, itLeaf.mnPosition, eastl::forward<KX>(k), eastl::forward<M>(obj)), true);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	typename btree<K, V, C, A, E, bM, bU, N>::iterator
+	btree<K, V, C, A, E, bM, bU, N>::DoRebalanceAfterErase(iterator position)
+	{
+		// Walks up from the leaf a value was removed from, merging or rebalancing nodes which
+		// have too few values. position refers to the slot the removed value was in, and the
+		// returned iterator refers to the value which is now after the removed one.
+		iterator result(position);
+		bool     bFirst = true;
+
+		for(;;)
+		{
+			if(position.mpNode == mpRoot)
+			{
+				DoTryShrink();
+
+				if(mnSize == 0)
+					return end();
+				break;
+			}
+
+			if(position.mpNode->mnCount >= kMinNodeValues)
+				break;
+
+			const bool bMerged = DoTryMergeOrRebalance(position);
+
+			// The first merge or rebalance may have moved the leaf values which result refers to.
+			if(bFirst)
+			{
+				result = position;
+				bFirst = false;
+			}
+
+			if(!bMerged)
+				break;
+
+			position.mnPosition = (int)position.mpNode->mnPosition;
+			position.mpNode     = position.mpNode->mpParent;
+		}
+
+		// If result is past the end of its leaf, the next value is further up the tree (or result is end()).
+		if(result.mnPosition == (int)result.mpNode->mnCount)
+		{
+			result.mnPosition = (int)result.mpNode->mnCount - 1;
+			++result;
+		}
+
+		return result;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	bool btree<K, V, C, A, E, bM, bU, N>::DoTryMergeOrRebalance(iterator& position)
+	{
+		// Returns true if position's node was merged with a sibling, which removes a value from
+		// the parent. position is updated to refer to the same slot afterwards.
+		node_type* const pNode   = position.mpNode;
+		node_type* const pParent = pNode->mpParent;
+		const int        nPos    = (int)pNode->mnPosition;
+
+		if(nPos > 0)
+		{
+			// Try merging with our left sibling.
+			node_type* const pLeft = pParent->child(nPos - 1);
+
+			if((1 + (size_t)pLeft->mnCount + (size_t)pNode->mnCount) <= kNodeValues)
+			{
+				position.mnPosition += 1 + (int)pLeft->mnCount;
+				DoMerge(pLeft, pNode);
+				position.mpNode = pLeft;
+				return true;
+			}
+		}
+
+		if(nPos < (int)pParent->mnCount)
+		{
+			// Try merging with our right sibling.
+			node_type* const pRight = pParent->child(nPos + 1);
+
+			if((1 + (size_t)pNode->mnCount + (size_t)pRight->mnCount) <= kNodeValues)
+			{
+				DoMerge(pNode, pRight);
+				return true;
+			}
+
+			// Try taking values from our right sibling. We don't bother if we removed the first
+			// value of a node which isn't empty, as that is the common case of erasing from the
+			// front of the tree, where the values would just be removed again.
+			if((pRight->mnCount > kMinNodeValues) && ((pNode->mnCount == 0) || (position.mnPosition > 0)))
+			{
+				const int nMove = eastl::min_alt(((int)pRight->mnCount - (int)pNode->mnCount) / 2, (int)pRight->mnCount - 1);
+				DoRebalanceRightToLeft(pNode, pRight, nMove);
+				return false;
+			}
+		}
+
+		if(nPos > 0)
+		{
+			// Try taking values from our left sibling, unless we removed the last value of a node
+			// which isn't empty, which is the common case of erasing from the back of the tree.
+			node_type* const pLeft = pParent->child(nPos - 1);
+
+			if((pLeft->mnCount > kMinNodeValues) && ((pNode->mnCount == 0) || (position.mnPosition < (int)pNode->mnCount)))
+			{
+				const int nMove = eastl::min_alt(((int)pLeft->mnCount - (int)pNode->mnCount) / 2, (int)pLeft->mnCount - 1);
+				DoRebalanceLeftToRight(pLeft, pNode, nMove);
+				position.mnPosition += nMove;
+				return false;
+			}
+		}
+
+		return false;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	void btree<K, V, C, A, E, bM, bU, N>::DoMerge(node_type* pLeft, node_type* pRight)
+	{
+		// Moves the parent's value between pLeft and pRight and then all of pRight into pLeft,
+		// and frees pRight.
+		node_type* const pParent    = pLeft->mpParent;
+		const int        nParentPos = (int)pLeft->mnPosition;
+		const int        nLeftCount = (int)pLeft->mnCount;
+		const int        nRightCount = (int)pRight->mnCount;
+
+		DoTransfer(pLeft, nLeftCount, pParent, nParentPos);
+		DoTransferRange(pLeft, nLeftCount + 1, pRight, 0, nRightCount);
+
+		if(!pLeft->mbLeaf)
+		{
+			for(int i = 0; i <= nRightCount; i++)
+				DoSetChild(pLeft, nLeftCount + 1 + i, pRight->child(i));
+		}
+
+		pLeft->mnCount = (uint16_t)(nLeftCount + 1 + nRightCount);
+
+		// Remove the moved value and pRight from the parent.
+		DoTransferRange(pParent, nParentPos, pParent, nParentPos + 1, (int)pParent->mnCount - (nParentPos + 1));
+
+		for(int i = nParentPos + 2; i <= (int)pParent->mnCount; i++)
+			DoSetChild(pParent, i - 1, pParent->child(i));
+
+		pParent->mnCount--;
+
+		if(pRight == mpRightmost)
+			mpRightmost = pLeft;
+
+		DoFreeNode(pRight);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	void btree<K, V, C, A, E, bM, bU, N>::DoRebalanceRightToLeft(node_type* pLeft, node_type* pRight, int nCount)
+	{
+		// Moves nCount values from the front of pRight to the back of pLeft, through the parent.
+		EASTL_ASSERT((nCount >= 1) && (nCount < (int)pRight->mnCount));
+
+		node_type* const pParent    = pLeft->mpParent;
+		const int        nParentPos = (int)pLeft->mnPosition;
+		const int        nLeftCount = (int)pLeft->mnCount;
+
+		DoTransfer(pLeft, nLeftCount, pParent, nParentPos);
+		DoTransferRange(pLeft, nLeftCount + 1, pRight, 0, nCount - 1);
+		DoTransfer(pParent, nParentPos, pRight, nCount - 1);
+		DoTransferRange(pRight, 0, pRight, nCount, (int)pRight->mnCount - nCount);
+
+		if(!pLeft->mbLeaf)
+		{
+			for(int i = 0; i < nCount; i++)
+				DoSetChild(pLeft, nLeftCount + 1 + i, pRight->child(i));
+
+			for(int i = nCount; i <= (int)pRight->mnCount; i++)
+				DoSetChild(pRight, i - nCount, pRight->child(i));
+		}
+
+		pLeft->mnCount  = (uint16_t)(pLeft->mnCount + nCount);
+		pRight->mnCount = (uint16_t)(pRight->mnCount - nCount);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	void btree<K, V, C, A, E, bM, bU, N>::DoRebalanceLeftToRight(node_type* pLeft, node_type* pRight, int nCount)
+	{
+		// Moves nCount values from the back of pLeft to the front of pRight, through the parent.
+		EASTL_ASSERT((nCount >= 1) && (nCount < (int)pLeft->mnCount));
+
+		node_type* const pParent    = pLeft->mpParent;
+		const int        nParentPos = (int)pLeft->mnPosition;
+		const int        nLeftCount = (int)pLeft->mnCount;
+
+		DoTransferRange(pRight, nCount, pRight, 0, (int)pRight->mnCount);
+		DoTransfer(pRight, nCount - 1, pParent, nParentPos);
+		DoTransferRange(pRight, 0, pLeft, nLeftCount - (nCount - 1), nCount - 1);
+		DoTransfer(pParent, nParentPos, pLeft, nLeftCount - nCount);
+
+		if(!pLeft->mbLeaf)
+		{
+			for(int i = (int)pRight->mnCount; i >= 0; i--)
+				DoSetChild(pRight, i + nCount, pRight->child(i));
+
+			for(int i = 0; i < nCount; i++)
+				DoSetChild(pRight, i, pLeft->child(nLeftCount - (nCount - 1) + i));
+		}
+
+		pLeft->mnCount  = (uint16_t)(pLeft->mnCount - nCount);
+		pRight->mnCount = (uint16_t)(pRight->mnCount + nCount);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	void btree<K, V, C, A, E, bM, bU, N>::DoTryShrink()
+	{
+		// The root may be left with no values, in which case an internal root is replaced by its
+		// only child, and a leaf root means the tree is now empty.
+		if(mpRoot->mnCount)
+			return;
+
+		node_type* const pOldRoot = mpRoot;
+
+		if(pOldRoot->mbLeaf)
+			reset_lose_memory();
+		else
+		{
+			mpRoot = pOldRoot->child(0);
+			mpRoot->mpParent   = NULL;
+			mpRoot->mnPosition = 0;
+		}
+
+		DoFreeNode(pOldRoot);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	bool btree<K, V, C, A, E, bM, bU, N>::DoValidateNode(const node_type* pNode, int nDepth, int& nLeafDepth, size_type& nValueCount) const
+	{
+		if((pNode->mnCount > kNodeValues) || ((pNode->mnCount == 0) && (pNode != mpRoot)))
+			return false;
+
+		nValueCount += pNode->mnCount;
+
+		if(pNode->mbLeaf)
+		{
+			// Every leaf must be at the same depth.
+			if(nLeafDepth < 0)
+				nLeafDepth = nDepth;
+			return nLeafDepth == nDepth;
+		}
+
+		for(int i = 0; i <= (int)pNode->mnCount; i++)
+		{
+			const node_type* const pChild = pNode->child(i);
+
+			if((pChild->mpParent != pNode) || ((int)pChild->mnPosition != i))
+				return false;
+
+			// The values of a child must be bounded by the values on either side of it.
+			if((i > 0) && mCompare(extract_key()(*pChild->value(0)), extract_key()(*pNode->value(i - 1))))
+				return false;
+
+			if((i < (int)pNode->mnCount) && mCompare(extract_key()(*pNode->value(i)), extract_key()(*pChild->value((int)pChild->mnCount - 1))))
+				return false;
+
+			if(!DoValidateNode(pChild, nDepth + 1, nLeafDepth, nValueCount))
+				return false;
+		}
+
+		return true;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline bool operator==(const btree<K, V, C, A, E, bM, bU, N>& a, const btree<K, V, C, A, E, bM, bU, N>& b)
+	{
+		return (a.size() == b.size()) && eastl::equal(a.begin(), a.end(), b.begin());
+	}
+
+
+	// As with rbtree, operator< compares the value_type with its operator< rather than with the
+	// tree's Compare function.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline bool operator<(const btree<K, V, C, A, E, bM, bU, N>& a, const btree<K, V, C, A, E, bM, bU, N>& b)
+	{
+		return eastl::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline bool operator!=(const btree<K, V, C, A, E, bM, bU, N>& a, const btree<K, V, C, A, E, bM, bU, N>& b)
+	{
+		return !(a == b);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline bool operator>(const btree<K, V, C, A, E, bM, bU, N>& a, const btree<K, V, C, A, E, bM, bU, N>& b)
+	{
+		return b < a;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline bool operator<=(const btree<K, V, C, A, E, bM, bU, N>& a, const btree<K, V, C, A, E, bM, bU, N>& b)
+	{
+		return !(b < a);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline bool operator>=(const btree<K, V, C, A, E, bM, bU, N>& a, const btree<K, V, C, A, E, bM, bU, N>& b)
+	{
+		return !(a < b);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t N>
+	inline void swap(btree<K, V, C, A, E, bM, bU, N>& a, btree<K, V, C, A, E, bM, bU, N>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+EA_RESTORE_VC_WARNING();
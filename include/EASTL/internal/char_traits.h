@@ -16,6 +16,7 @@
 #include <EASTL/internal/config.h>
 #include <EASTL/type_traits.h>
 #include <EASTL/algorithm.h>
+#include <EASTL/internal/char_traits_simd.h>
 
 EA_DISABLE_ALL_VC_WARNINGS()
 #include <ctype.h>              // toupper, etc.
@@ -538,6 +539,68 @@ namespace eastl
 	}
 
 
+	// CharTypeStringFind
+	// Specialized value_type version of STL find() function.
+	// Return pEnd if not found.
+	template <typename T>
+	inline const T* CharTypeStringFind(const T* pBegin, const T* pEnd, const T c)
+	{
+		return eastl::find(pBegin, pEnd, c);
+	}
+
+
+#if EASTL_CHAR_TRAITS_SIMD
+	// char versions of the above searches which test a whole SSE2, AVX2 or NEON
+	// register of characters per step. See internal/char_traits_simd.h.
+	inline const char* CharTypeStringFind(const char* pBegin, const char* pEnd, const char c)
+	{
+		return Internal::CharSimdFind(pBegin, pEnd, c);
+	}
+
+	inline const char* CharTypeStringRFind(const char* pRBegin, const char* pREnd, const char c)
+	{
+		const char* const pResult = Internal::CharSimdFindLast(pREnd, pRBegin, c);
+		return pResult ? (pResult + 1) : pREnd;
+	}
+
+	inline const char* CharTypeStringSearch(const char* p1Begin, const char* p1End, const char* p2Begin, const char* p2End)
+	{
+		return Internal::CharSimdSearch(p1Begin, p1End, p2Begin, p2End);
+	}
+
+	inline const char* CharTypeStringFindFirstOf(const char* p1Begin, const char* p1End, const char* p2Begin, const char* p2End)
+	{
+		return Internal::CharSimdFindFirstOf(p1Begin, p1End, p2Begin, p2End);
+	}
+
+	#if defined(EA_CHAR8_UNIQUE) && EA_CHAR8_UNIQUE
+		// char8_t is a distinct type but has the same representation as char.
+		inline const char8_t* CharTypeStringFind(const char8_t* pBegin, const char8_t* pEnd, const char8_t c)
+		{
+			return reinterpret_cast<const char8_t*>(Internal::CharSimdFind(reinterpret_cast<const char*>(pBegin), reinterpret_cast<const char*>(pEnd), (char)c));
+		}
+
+		inline const char8_t* CharTypeStringRFind(const char8_t* pRBegin, const char8_t* pREnd, const char8_t c)
+		{
+			const char* const pResult = Internal::CharSimdFindLast(reinterpret_cast<const char*>(pREnd), reinterpret_cast<const char*>(pRBegin), (char)c);
+			return pResult ? (reinterpret_cast<const char8_t*>(pResult) + 1) : pREnd;
+		}
+
+		inline const char8_t* CharTypeStringSearch(const char8_t* p1Begin, const char8_t* p1End, const char8_t* p2Begin, const char8_t* p2End)
+		{
+			return reinterpret_cast<const char8_t*>(Internal::CharSimdSearch(reinterpret_cast<const char*>(p1Begin), reinterpret_cast<const char*>(p1End),
+			                                                                 reinterpret_cast<const char*>(p2Begin), reinterpret_cast<const char*>(p2End)));
+		}
+
+		inline const char8_t* CharTypeStringFindFirstOf(const char8_t* p1Begin, const char8_t* p1End, const char8_t* p2Begin, const char8_t* p2End)
+		{
+			return reinterpret_cast<const char8_t*>(Internal::CharSimdFindFirstOf(reinterpret_cast<const char*>(p1Begin), reinterpret_cast<const char*>(p1End),
+			                                                                      reinterpret_cast<const char*>(p2Begin), reinterpret_cast<const char*>(p2End)));
+		}
+	#endif
+#endif
+
+
 	inline char* CharStringUninitializedFillN(char* pDestination, size_t n, const char c)
 	{
 		if(n) // Some compilers (e.g. GCC 4.3+) generate a warning (which can't be disabled) if you call memset with a size of 0.
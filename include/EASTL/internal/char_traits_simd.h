@@ -0,0 +1,380 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements SIMD versions of the char searches in char_traits.h:
+// find of a single character (forward and reverse), substring search and
+// find_first_of. This is intended for internal EASTL use only; the public
+// entry points are the char overloads of the CharTypeString functions.
+//
+// The width is chosen at compile time: 32 bytes per step with AVX2, else 16
+// with SSE2 or NEON. Ranges shorter than a single step use scalar loops, and
+// longer ranges finish with one overlapping step so no load ever reads
+// outside of the range given.
+//
+// Substring search compares the first and last characters of the pattern
+// against a whole step of candidate positions at once and only compares the
+// full pattern where both match. For typical text this skips nearly all
+// positions without a memcmp.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EABase/eabase.h>
+#include <EASTL/internal/config.h>
+#include <string.h>
+
+
+/// EASTL_CHAR_TRAITS_SIMD
+///
+/// Defined as 0 or 1. If 1 then the char overloads of CharTypeStringFind,
+/// CharTypeStringRFind, CharTypeStringSearch and CharTypeStringFindFirstOf
+/// use the SSE2, AVX2 or NEON implementations below. If 0 all character
+/// types use the portable templates in char_traits.h.
+///
+#ifndef EASTL_CHAR_TRAITS_SIMD
+	#if EA_SSE2 || EA_NEON
+		#define EASTL_CHAR_TRAITS_SIMD 1
+	#else
+		#define EASTL_CHAR_TRAITS_SIMD 0
+	#endif
+#endif
+
+
+#if EASTL_CHAR_TRAITS_SIMD
+
+EA_DISABLE_ALL_VC_WARNINGS()
+	#include <stddef.h>
+	#if defined(EA_COMPILER_MSVC)
+		#include <intrin.h>
+	#endif
+	#if EA_AVX2
+		#include <immintrin.h>
+	#elif EA_SSE2
+		#include <emmintrin.h>
+	#elif EA_NEON
+		#include <arm_neon.h>
+	#endif
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+namespace eastl
+{
+	namespace Internal
+	{
+		/// char_simd
+		///
+		/// The vector operations needed by the searches below. A match mask has
+		/// (1 << kShift) bits per character; only the highest of those bits is
+		/// ever set, so clearing the lowest set bit steps to the next match.
+		///
+		#if EA_AVX2
+
+			struct char_simd
+			{
+				typedef __m256i vector_type;
+
+				static const ptrdiff_t kWidth = 32;
+				static const uint32_t  kShift = 0;
+
+				static vector_type Load(const char* p)                 { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+				static vector_type Splat(char c)                       { return _mm256_set1_epi8(c); }
+				static vector_type Equal(vector_type a, vector_type b) { return _mm256_cmpeq_epi8(a, b); }
+				static vector_type Or(vector_type a, vector_type b)    { return _mm256_or_si256(a, b); }
+				static vector_type And(vector_type a, vector_type b)   { return _mm256_and_si256(a, b); }
+				static uint64_t    Mask(vector_type v)                 { return (uint64_t)(uint32_t)_mm256_movemask_epi8(v); }
+			};
+
+		#elif EA_SSE2
+
+			struct char_simd
+			{
+				typedef __m128i vector_type;
+
+				static const ptrdiff_t kWidth = 16;
+				static const uint32_t  kShift = 0;
+
+				static vector_type Load(const char* p)                 { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+				static vector_type Splat(char c)                       { return _mm_set1_epi8(c); }
+				static vector_type Equal(vector_type a, vector_type b) { return _mm_cmpeq_epi8(a, b); }
+				static vector_type Or(vector_type a, vector_type b)    { return _mm_or_si128(a, b); }
+				static vector_type And(vector_type a, vector_type b)   { return _mm_and_si128(a, b); }
+				static uint64_t    Mask(vector_type v)                 { return (uint64_t)(uint32_t)_mm_movemask_epi8(v); }
+			};
+
+		#else // EA_NEON
+
+			struct char_simd
+			{
+				typedef uint8x16_t vector_type;
+
+				static const ptrdiff_t kWidth = 16;
+				static const uint32_t  kShift = 2;
+
+				static vector_type Load(const char* p)                 { return vld1q_u8(reinterpret_cast<const uint8_t*>(p)); }
+				static vector_type Splat(char c)                       { return vdupq_n_u8((uint8_t)c); }
+				static vector_type Equal(vector_type a, vector_type b) { return vceqq_u8(a, b); }
+				static vector_type Or(vector_type a, vector_type b)    { return vorrq_u8(a, b); }
+				static vector_type And(vector_type a, vector_type b)   { return vandq_u8(a, b); }
+
+				// NEON has no movemask. Narrowing each 16 bit lane by 4 gives a nibble per character.
+				static uint64_t Mask(vector_type v)
+				{
+					const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+					return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & UINT64_C(0x8888888888888888);
+				}
+			};
+
+		#endif
+
+
+		inline uint32_t CharSimdCountTrailingZeros(uint64_t x) // x must be non-zero.
+		{
+			#if defined(EA_COMPILER_MSVC) && defined(EA_PROCESSOR_X86_64)
+				unsigned long index;
+				_BitScanForward64(&index, x);
+				return (uint32_t)index;
+			#elif (defined(EA_COMPILER_GNUC) || defined(EA_COMPILER_CLANG)) && !defined(EA_COMPILER_EDG)
+				return (uint32_t)__builtin_ctzll(x);
+			#else
+				uint32_t n = 0;
+				while((x & 1) == 0) { x >>= 1; ++n; }
+				return n;
+			#endif
+		}
+
+		inline uint32_t CharSimdCountLeadingZeros(uint64_t x) // x must be non-zero.
+		{
+			#if defined(EA_COMPILER_MSVC) && defined(EA_PROCESSOR_X86_64)
+				unsigned long index;
+				_BitScanReverse64(&index, x);
+				return (uint32_t)(63 - index);
+			#elif (defined(EA_COMPILER_GNUC) || defined(EA_COMPILER_CLANG)) && !defined(EA_COMPILER_EDG)
+				return (uint32_t)__builtin_clzll(x);
+			#else
+				uint32_t n = 0;
+				while((x & UINT64_C(0x8000000000000000)) == 0) { x <<= 1; ++n; }
+				return n;
+			#endif
+		}
+
+		// Index of the first and last matching character in a non-zero mask.
+		inline ptrdiff_t CharSimdFirstIndex(uint64_t mask) { return (ptrdiff_t)(CharSimdCountTrailingZeros(mask) >> char_simd::kShift); }
+		inline ptrdiff_t CharSimdLastIndex(uint64_t mask)  { return (ptrdiff_t)((63 - CharSimdCountLeadingZeros(mask)) >> char_simd::kShift); }
+
+		// Mask bits for the characters at indexes [0, n), with n < kWidth.
+		inline uint64_t CharSimdLowMask(ptrdiff_t n) { return (UINT64_C(1) << ((uint32_t)n << char_simd::kShift)) - 1; }
+
+
+		/// CharSimdFind
+		///
+		/// Returns the first occurrence of c in [pBegin, pEnd), or pEnd.
+		///
+		inline const char* CharSimdFind(const char* pBegin, const char* pEnd, char c)
+		{
+			const ptrdiff_t kWidth = char_simd::kWidth;
+			const char*     p      = pBegin;
+
+			if((pEnd - p) < kWidth)
+			{
+				for(; p != pEnd; ++p)
+				{
+					if(*p == c)
+						return p;
+				}
+				return pEnd;
+			}
+
+			const char_simd::vector_type vc = char_simd::Splat(c);
+
+			for(; (pEnd - p) >= kWidth; p += kWidth)
+			{
+				const uint64_t mask = char_simd::Mask(char_simd::Equal(char_simd::Load(p), vc));
+				if(mask)
+					return p + CharSimdFirstIndex(mask);
+			}
+
+			if(p != pEnd) // Re-check the last kWidth characters, ignoring those already tested.
+			{
+				const char* const pLast = pEnd - kWidth;
+				const uint64_t    mask  = char_simd::Mask(char_simd::Equal(char_simd::Load(pLast), vc)) & ~CharSimdLowMask(p - pLast);
+				if(mask)
+					return pLast + CharSimdFirstIndex(mask);
+			}
+
+			return pEnd;
+		}
+
+
+		/// CharSimdFindLast
+		///
+		/// Returns the last occurrence of c in [pBegin, pEnd), or NULL.
+		///
+		inline const char* CharSimdFindLast(const char* pBegin, const char* pEnd, char c)
+		{
+			const ptrdiff_t kWidth = char_simd::kWidth;
+			const char*     p      = pEnd;
+
+			if((p - pBegin) < kWidth)
+			{
+				while(p != pBegin)
+				{
+					if(*--p == c)
+						return p;
+				}
+				return NULL;
+			}
+
+			const char_simd::vector_type vc = char_simd::Splat(c);
+
+			for(; (p - pBegin) >= kWidth; p -= kWidth)
+			{
+				const uint64_t mask = char_simd::Mask(char_simd::Equal(char_simd::Load(p - kWidth), vc));
+				if(mask)
+					return (p - kWidth) + CharSimdLastIndex(mask);
+			}
+
+			if(p != pBegin) // Re-check the first kWidth characters, ignoring those already tested.
+			{
+				const uint64_t mask = char_simd::Mask(char_simd::Equal(char_simd::Load(pBegin), vc)) & CharSimdLowMask(p - pBegin);
+				if(mask)
+					return pBegin + CharSimdLastIndex(mask);
+			}
+
+			return NULL;
+		}
+
+
+		/// CharSimdSearch
+		///
+		/// Returns the first occurrence of [p2Begin, p2End) in [p1Begin, p1End), or p1End.
+		/// As with CharTypeStringSearch, an empty range in either argument returns p1Begin.
+		///
+		inline const char* CharSimdSearch(const char* p1Begin, const char* p1End, const char* p2Begin, const char* p2End)
+		{
+			const ptrdiff_t kWidth = char_simd::kWidth;
+			const ptrdiff_t n      = (p2End - p2Begin);
+
+			if((p1Begin == p1End) || (n == 0))
+				return p1Begin;
+
+			if(n == 1)
+				return CharSimdFind(p1Begin, p1End, *p2Begin);
+
+			if(n > (p1End - p1Begin))
+				return p1End;
+
+			const char* const pLastStart = (p1End - n); // The last position at which a match could begin.
+			const char        cFirst     = p2Begin[0];
+			const char        cLast      = p2Begin[n - 1];
+			const char*       p          = p1Begin;
+
+			if((pLastStart - p) >= kWidth)
+			{
+				const char_simd::vector_type vFirst = char_simd::Splat(cFirst);
+				const char_simd::vector_type vLast  = char_simd::Splat(cLast);
+
+				// Each step tests kWidth starting positions. The second load ends at
+				// (p + kWidth - 1 + n - 1), which is within the range while p + kWidth - 1 <= pLastStart.
+				for(; (pLastStart - p) >= (kWidth - 1); p += kWidth)
+				{
+					uint64_t mask = char_simd::Mask(char_simd::And(char_simd::Equal(char_simd::Load(p),         vFirst),
+					                                               char_simd::Equal(char_simd::Load(p + n - 1), vLast)));
+					while(mask)
+					{
+						const char* const pCandidate = p + CharSimdFirstIndex(mask);
+						if(memcmp(pCandidate + 1, p2Begin + 1, (size_t)(n - 2)) == 0)
+							return pCandidate;
+						mask &= (mask - 1);
+					}
+				}
+			}
+
+			for(; p <= pLastStart; ++p)
+			{
+				if((p[0] == cFirst) && (p[n - 1] == cLast) && (memcmp(p + 1, p2Begin + 1, (size_t)(n - 2)) == 0))
+					return p;
+			}
+
+			return p1End;
+		}
+
+
+		/// CharSimdFindFirstOf
+		///
+		/// Returns the first character in [p1Begin, p1End) which is also in [p2Begin, p2End), or p1End.
+		/// Sets of up to kMaxSimdSetSize characters are compared a step at a time; larger sets
+		/// fall back to a byte-indexed bitmap, which is a single lookup per character.
+		///
+		inline const char* CharSimdFindFirstOf(const char* p1Begin, const char* p1End, const char* p2Begin, const char* p2End)
+		{
+			const ptrdiff_t kWidth           = char_simd::kWidth;
+			const ptrdiff_t kMaxSimdSetSize  = 16;
+			const ptrdiff_t nSetSize         = (p2End - p2Begin);
+			const char*     p                = p1Begin;
+
+			if(nSetSize <= 1)
+				return nSetSize ? CharSimdFind(p1Begin, p1End, *p2Begin) : p1End;
+
+			if((nSetSize <= kMaxSimdSetSize) && ((p1End - p) >= kWidth))
+			{
+				char_simd::vector_type vSet[kMaxSimdSetSize];
+				for(ptrdiff_t i = 0; i < nSetSize; ++i)
+					vSet[i] = char_simd::Splat(p2Begin[i]);
+
+				for(;; p += kWidth)
+				{
+					if((p1End - p) < kWidth) // Step back to re-check the last kWidth characters.
+					{
+						if(p == p1End)
+							return p1End;
+						p = (p1End - kWidth);
+					}
+
+					const char_simd::vector_type v = char_simd::Load(p);
+					char_simd::vector_type vMatch  = char_simd::Equal(v, vSet[0]);
+					for(ptrdiff_t i = 1; i < nSetSize; ++i)
+						vMatch = char_simd::Or(vMatch, char_simd::Equal(v, vSet[i]));
+
+					const uint64_t mask = char_simd::Mask(vMatch);
+					if(mask)
+						return p + CharSimdFirstIndex(mask);
+
+					if(p == (p1End - kWidth))
+						return p1End;
+				}
+			}
+
+			if(nSetSize <= kMaxSimdSetSize) // Short range: compare each character against the set.
+			{
+				for(; p != p1End; ++p)
+				{
+					for(const char* pTemp = p2Begin; pTemp != p2End; ++pTemp)
+					{
+						if(*p == *pTemp)
+							return p;
+					}
+				}
+				return p1End;
+			}
+
+			uint32_t bitmap[256 / 32] = {};
+			for(const char* pTemp = p2Begin; pTemp != p2End; ++pTemp)
+				bitmap[(uint8_t)*pTemp >> 5] |= (1u << ((uint8_t)*pTemp & 31));
+
+			for(; p != p1End; ++p)
+			{
+				if(bitmap[(uint8_t)*p >> 5] & (1u << ((uint8_t)*p & 31)))
+					return p;
+			}
+			return p1End;
+		}
+
+	} // namespace Internal
+
+} // namespace eastl
+
+#endif // EASTL_CHAR_TRAITS_SIMD
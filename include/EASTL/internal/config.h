@@ -940,6 +940,50 @@ namespace eastl
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_STRING_HASH_FAST
+//
+// Defined as 0 or 1. Default is 0.
+// If defined as 1, eastl::hash for character pointers, basic_string and
+// basic_string_view (and eastl::string_hash) use eastl::fast_string_hash,
+// a 64 bit word-at-a-time hash, instead of the 32 bit byte-at-a-time FNV1
+// hash. This is much faster for long strings and distributes better, but
+// changes hash values, so it must not be enabled where hash values are
+// persisted or shared with code built with a different setting.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_STRING_HASH_FAST
+	#define EASTL_STRING_HASH_FAST 0
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_PREFETCH
+//
+// Hints to the processor that the cache line containing the given address
+// will soon be read. This is only a hint: it never faults, even for invalid
+// or null addresses, and it expands to nothing where no intrinsic is known.
+//
+// Example usage:
+//     EASTL_PREFETCH(pBucketArray + n);
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_PREFETCH
+	#if defined(__GNUC__) || defined(__clang__)
+		#define EASTL_PREFETCH(p) __builtin_prefetch((const void*)(p))
+	#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+		#include <xmmintrin.h>
+		#define EASTL_PREFETCH(p) _mm_prefetch((const char*)(p), _MM_HINT_T0)
+	#else
+		#define EASTL_PREFETCH(p) ((void)(p))
+	#endif
+#endif
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // EASTL_MAX_STACK_USAGE
 //
@@ -1045,6 +1089,26 @@ namespace eastl
 #endif
 
 
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+//
+// Defined as 0 or 1. Default is 0.
+// If defined as non-zero, every red-black tree node (map, multimap, set,
+// multiset and their fixed_ variants) stores the number of nodes in its
+// subtree. The count is maintained by the tree insert, erase and rotation
+// functions and enables the nth() and rank() member functions, which find
+// the element at a given sorted position or the sorted position of a given
+// element in O(log n) instead of the O(n) walk that eastl::distance does.
+// The cost is one size_t per node and a few extra writes per insert/erase.
+// This changes the layout of rbtree_node_base, so it must be defined the
+// same way for the EASTL library and all code that uses it.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+	#define EASTL_RBTREE_ORDER_STATISTICS_ENABLED 0
+#endif
+
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // EASTL_VALIDATION_ENABLED
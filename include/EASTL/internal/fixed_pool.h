@@ -8,6 +8,9 @@
 //     fixed_pool_base
 //     fixed_pool
 //     fixed_pool_with_overflow
+//     slab_overflow_allocator
+//     fixed_pool_with_slabs
+//     fixed_node_allocator
 //     fixed_hashtable_allocator
 //     fixed_vector_allocator
 //     fixed_swap
@@ -47,6 +50,16 @@ namespace eastl
 	#endif
 
 
+	/// EASTL_FIXED_POOL_MIN_SLAB_NODE_COUNT
+	///
+	/// The smallest number of nodes a fixed_pool_with_slabs slab holds. This keeps pools
+	/// with a very small fixed capacity from growing a few nodes at a time.
+	///
+	#ifndef EASTL_FIXED_POOL_MIN_SLAB_NODE_COUNT
+		#define EASTL_FIXED_POOL_MIN_SLAB_NODE_COUNT 16
+	#endif
+
+
 
 	///////////////////////////////////////////////////////////////////////////
 	// aligned_buffer
@@ -572,6 +585,402 @@ namespace eastl
 
 
 
+	///////////////////////////////////////////////////////////////////////////
+	// slab_overflow_allocator
+	///////////////////////////////////////////////////////////////////////////
+
+	/// slab_overflow_allocator
+	///
+	/// An overflow allocator which selects fixed_pool_with_slabs as the pool of the
+	/// fixed node containers (fixed_list, fixed_map, fixed_hash_map, etc.) which use it.
+	/// Other than that it is Allocator, which supplies the slab memory.
+	///
+	/// Template parameters:
+	///     Allocator              The allocator which slabs are allocated from.
+	///     nodesPerSlab           The minimum number of nodes in each slab. 0 means as many as
+	///                            the container's fixed capacity, so that the first slab at
+	///                            least doubles it.
+	///
+	/// Example usage:
+	///     typedef eastl::slab_overflow_allocator<> SlabOverflow;
+	///     eastl::fixed_map<int, Widget, 64, true, eastl::less<int>, SlabOverflow> widgetMap;
+	///
+	template <typename Allocator = EASTLAllocatorType, size_t nodesPerSlab = 0>
+	class slab_overflow_allocator : public Allocator
+	{
+	public:
+		typedef Allocator base_type;
+
+		enum
+		{
+			kNodesPerSlab = nodesPerSlab
+		};
+
+		EASTL_ALLOCATOR_EXPLICIT slab_overflow_allocator(const char* pName = EASTL_NAME_VAL(EASTL_FIXED_POOL_DEFAULT_NAME))
+			: Allocator(pName)
+		{
+		}
+
+		slab_overflow_allocator(const Allocator& allocator)
+			: Allocator(allocator)
+		{
+		}
+	};
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// fixed_pool_with_slabs
+	///////////////////////////////////////////////////////////////////////////
+
+	/// fixed_pool_with_slabs
+	///
+	/// A fixed_pool_with_overflow which grows by slabs instead of by nodes. When the fixed
+	/// buffer is used up, the pool allocates a contiguous slab of nodes from the overflow
+	/// allocator and hands its nodes out in the same way as the fixed buffer's, so that
+	/// overflowing nodes stay close together and cost no allocator call each. Freed nodes
+	/// of the fixed buffer and of the slabs go on the same freelist, and deallocate doesn't
+	/// need to check where a node came from. (fixed_hashtable_allocator, whose overflow 
+	/// buckets come straight from the overflow allocator, tells them apart by size.)
+	///
+	/// Slabs are kept until the pool is destroyed or reset, or until release_empty_slabs
+	/// is called, which frees the slabs with no nodes in use. A slab's size is a power of
+	/// two and it is aligned to its size, so the overflow allocator must support such
+	/// alignments, as eastl::allocator does.
+	///
+	/// This pool is selected by using a slab_overflow_allocator as the OverflowAllocator.
+	///
+	template <typename OverflowAllocator>
+	class fixed_pool_with_slabs : public fixed_pool_with_overflow<OverflowAllocator>
+	{
+	public:
+		typedef fixed_pool_with_overflow<OverflowAllocator> base_type;
+		typedef OverflowAllocator                           overflow_allocator_type;
+		typedef typename base_type::Link                    Link;
+
+		using base_type::mpHead;
+		using base_type::mpNext;
+		using base_type::mpCapacity;
+		using base_type::mnNodeSize;
+		using base_type::mOverflowAllocator;
+		using base_type::mpPoolBegin;
+
+		#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+			using base_type::mnCurrentSize;
+			using base_type::mnPeakSize;
+		#endif
+
+
+		fixed_pool_with_slabs(void* pMemory = NULL)
+			: base_type(pMemory)
+		{
+			DoInitSlabs(0, 0);
+		}
+
+
+		fixed_pool_with_slabs(void* pMemory, const overflow_allocator_type& allocator)
+			: base_type(pMemory, allocator)
+		{
+			DoInitSlabs(0, 0);
+		}
+
+
+		fixed_pool_with_slabs(void* pMemory, size_t memorySize, size_t nodeSize, 
+							  size_t alignment, size_t alignmentOffset = 0)
+			: base_type(pMemory, memorySize, nodeSize, alignment, alignmentOffset)
+		{
+			DoInitSlabs(pMemory ? nodeSize : 0, alignment);
+		}
+
+
+		fixed_pool_with_slabs(void* pMemory, size_t memorySize, size_t nodeSize, 
+							  size_t alignment, size_t alignmentOffset,
+							  const overflow_allocator_type& allocator)
+			: base_type(pMemory, memorySize, nodeSize, alignment, alignmentOffset, allocator)
+		{
+			DoInitSlabs(pMemory ? nodeSize : 0, alignment);
+		}
+
+
+		// The slabs belong to the source pool, so a copy starts without any.
+		fixed_pool_with_slabs(const fixed_pool_with_slabs& x)
+			: base_type(x)
+		{
+			mpSlabHead  = NULL;
+			mpPoolEnd   = x.mpPoolEnd;
+			mnSlabSize  = x.mnSlabSize;
+			mnSlabNodeOffset = x.mnSlabNodeOffset;
+			mnSlabNodeCount  = x.mnSlabNodeCount;
+			mnSlabCount = 0;
+		}
+
+
+		~fixed_pool_with_slabs()
+		{
+			DoFreeSlabs();
+		}
+
+
+		fixed_pool_with_slabs& operator=(const fixed_pool_with_slabs& x)
+		{
+			base_type::operator=(x);
+			return *this;
+		}
+
+
+		void init(void* pMemory, size_t memorySize, size_t nodeSize,
+					size_t alignment, size_t alignmentOffset = 0)
+		{
+			// Any nodes still in the slabs are abandoned along with those of the fixed buffer.
+			DoFreeSlabs();
+			base_type::init(pMemory, memorySize, nodeSize, alignment, alignmentOffset);
+			DoInitSlabs(pMemory ? nodeSize : 0, alignment);
+		}
+
+
+		void* allocate()
+		{
+			Link* pLink = mpHead;
+
+			if(pLink)
+				mpHead = pLink->mpNext;
+			else
+			{
+				if(EASTL_UNLIKELY(mpNext == mpCapacity) && !DoAddSlab())
+					return NULL;
+
+				pLink  = mpNext;
+				mpNext = reinterpret_cast<Link*>(reinterpret_cast<char*>(mpNext) + mnNodeSize);
+			}
+
+			#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+				if(++mnCurrentSize > mnPeakSize)
+					mnPeakSize = mnCurrentSize;
+			#endif
+
+			return pLink;
+		}
+
+
+		void* allocate(size_t /*alignment*/, size_t /*alignmentOffset*/)
+		{
+			// Slab nodes have the same alignment as the fixed buffer's nodes.
+			return allocate();
+		}
+
+
+		void deallocate(void* p)
+		{
+			#if EASTL_FIXED_SIZE_TRACKING_ENABLED
+				--mnCurrentSize;
+			#endif
+
+			((Link*)p)->mpNext = mpHead;
+			mpHead = ((Link*)p);
+		}
+
+
+		/// release_empty_slabs
+		///
+		/// Frees the slabs which have no nodes in use, and returns how many were freed.
+		/// This walks the freelist, so it is meant to be called now and then, such as
+		/// after a container has shrunk back from a peak, rather than after every erase.
+		///
+		size_t release_empty_slabs()
+		{
+			if(!mpSlabHead)
+				return 0;
+
+			// Count the free nodes of each slab: those on the freelist, and those of the 
+			// slab currently being handed out which haven't been reached yet.
+			for(Slab* pSlab = mpSlabHead; pSlab; pSlab = pSlab->mpNext)
+				pSlab->mnFreeCount = 0;
+
+			if((mpNext != mpCapacity) && !IsInFixedBuffer(mpNext))
+				GetSlab(mpNext)->mnFreeCount += (size_t)((char*)mpCapacity - (char*)mpNext) / mnNodeSize;
+
+			for(Link* pLink = mpHead; pLink; pLink = pLink->mpNext)
+			{
+				if(!IsInFixedBuffer(pLink))
+					GetSlab(pLink)->mnFreeCount++;
+			}
+
+			// Unlink the free nodes of the empty slabs, then free the slabs.
+			for(Link** ppLink = &mpHead; *ppLink; )
+			{
+				if(!IsInFixedBuffer(*ppLink) && (GetSlab(*ppLink)->mnFreeCount == mnSlabNodeCount))
+					*ppLink = (*ppLink)->mpNext;
+				else
+					ppLink = &(*ppLink)->mpNext;
+			}
+
+			size_t nReleased = 0;
+
+			for(Slab** ppSlab = &mpSlabHead; *ppSlab; )
+			{
+				Slab* const pSlab = *ppSlab;
+
+				if(pSlab->mnFreeCount == mnSlabNodeCount)
+				{
+					if((mpNext != mpCapacity) && !IsInFixedBuffer(mpNext) && (GetSlab(mpNext) == pSlab))
+						mpNext = mpCapacity = NULL;
+
+					*ppSlab = pSlab->mpNext;
+					mOverflowAllocator.deallocate(pSlab, mnSlabSize);
+					mnSlabCount--;
+					nReleased++;
+				}
+				else
+					ppSlab = &pSlab->mpNext;
+			}
+
+			return nReleased;
+		}
+
+
+		/// owns
+		///
+		/// Returns true if p is one of the pool's nodes, in the fixed buffer or in a slab.
+		/// This walks the slabs.
+		///
+		bool owns(const void* p) const
+		{
+			if(IsInFixedBuffer(p))
+				return true;
+
+			for(Slab* pSlab = mpSlabHead; pSlab; pSlab = pSlab->mpNext)
+			{
+				if(((const char*)p >= (const char*)pSlab) && ((const char*)p < ((const char*)pSlab + mnSlabSize)))
+					return true;
+			}
+
+			return false;
+		}
+
+
+		/// Returns the number of slabs the pool currently holds.
+		size_t slab_count() const
+		{
+			return mnSlabCount;
+		}
+
+
+		/// Returns the number of nodes in each slab.
+		size_t slab_node_count() const
+		{
+			return mnSlabNodeCount;
+		}
+
+	protected:
+		struct Slab
+		{
+			Slab*  mpNext;
+			size_t mnFreeCount; // Only valid during release_empty_slabs.
+		};
+
+		bool IsInFixedBuffer(const void* p) const
+		{
+			return (p >= mpPoolBegin) && (p < mpPoolEnd);
+		}
+
+		Slab* GetSlab(const void* p) const
+		{
+			return (Slab*)((uintptr_t)p & ~(uintptr_t)(mnSlabSize - 1));
+		}
+
+		// Works out the slab layout for the node size which the pool was initialized with.
+		// The slab size is rounded up to a power of two, and the nodes fill it.
+		void DoInitSlabs(size_t nodeSize, size_t alignment)
+		{
+			mpSlabHead  = NULL;
+			mpPoolEnd   = mpCapacity;
+			mnSlabSize  = 0;
+			mnSlabNodeOffset = 0;
+			mnSlabNodeCount  = 0;
+			mnSlabCount = 0;
+
+			if(nodeSize)
+			{
+				if(alignment < EASTL_ALIGN_OF(Slab))
+					alignment = EASTL_ALIGN_OF(Slab);
+
+				size_t nNodeCount = (size_t)((char*)mpCapacity - (char*)mpNext) / mnNodeSize;
+				EA_CONSTEXPR_IF(OverflowAllocator::kNodesPerSlab != 0)
+					nNodeCount = OverflowAllocator::kNodesPerSlab;
+				if(nNodeCount < EASTL_FIXED_POOL_MIN_SLAB_NODE_COUNT)
+					nNodeCount = EASTL_FIXED_POOL_MIN_SLAB_NODE_COUNT;
+
+				mnSlabNodeOffset = (sizeof(Slab) + (alignment - 1)) & ~(alignment - 1);
+
+				for(mnSlabSize = alignment; mnSlabSize < (mnSlabNodeOffset + (nNodeCount * mnNodeSize)); )
+					mnSlabSize *= 2;
+
+				mnSlabNodeCount = (mnSlabSize - mnSlabNodeOffset) / mnNodeSize;
+			}
+		}
+
+		// Makes a new slab the range that nodes are handed out from.
+		bool DoAddSlab()
+		{
+			EASTL_ASSERT(mnSlabSize != 0); // If this fails, the pool wasn't initialized with a buffer.
+
+			Slab* const pSlab = (Slab*)allocate_memory(mOverflowAllocator, mnSlabSize, mnSlabSize, 0);
+			EASTL_ASSERT_MSG(pSlab != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
+
+			if(!pSlab)
+				return false;
+
+			pSlab->mpNext = mpSlabHead;
+			mpSlabHead    = pSlab;
+			mnSlabCount++;
+
+			mpNext     = (Link*)((char*)pSlab + mnSlabNodeOffset);
+			mpCapacity = (Link*)((char*)mpNext + (mnSlabNodeCount * mnNodeSize));
+			return true;
+		}
+
+		void DoFreeSlabs()
+		{
+			while(mpSlabHead)
+			{
+				Slab* const pSlab = mpSlabHead;
+				mpSlabHead = pSlab->mpNext;
+				mOverflowAllocator.deallocate(pSlab, mnSlabSize);
+			}
+
+			mnSlabCount = 0;
+		}
+
+	protected:
+		Slab*  mpSlabHead;       // The slabs, most recent first.
+		void*  mpPoolEnd;        // The end of the fixed buffer. mpCapacity moves on to the slabs once they are in use.
+		size_t mnSlabSize;       // The size and alignment of every slab, a power of two.
+		size_t mnSlabNodeOffset; // Where the nodes start in a slab, past its header.
+		size_t mnSlabNodeCount;  // The number of nodes in a slab.
+		size_t mnSlabCount;
+
+	}; // fixed_pool_with_slabs
+
+
+	/// fixed_pool_overflow_type
+	///
+	/// Maps the OverflowAllocator of a fixed node container with overflow enabled to its pool.
+	///
+	template <typename OverflowAllocator>
+	struct fixed_pool_overflow_type
+	{
+		typedef fixed_pool_with_overflow<OverflowAllocator> type;
+	};
+
+	template <typename Allocator, size_t nodesPerSlab>
+	struct fixed_pool_overflow_type< slab_overflow_allocator<Allocator, nodesPerSlab> >
+	{
+		typedef fixed_pool_with_slabs< slab_overflow_allocator<Allocator, nodesPerSlab> > type;
+	};
+
+
+
+
+
 	///////////////////////////////////////////////////////////////////////////
 	// fixed_node_allocator
 	///////////////////////////////////////////////////////////////////////////
@@ -602,7 +1011,7 @@ namespace eastl
 	class fixed_node_allocator
 	{
 	public:
-		typedef typename conditional<bEnableOverflow, fixed_pool_with_overflow<OverflowAllocator>, fixed_pool>::type  pool_type;
+		typedef typename conditional<bEnableOverflow, typename fixed_pool_overflow_type<OverflowAllocator>::type, fixed_pool>::type  pool_type;
 		typedef fixed_node_allocator<nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator>   this_type;
 		typedef OverflowAllocator overflow_allocator_type;
 
@@ -743,6 +1152,16 @@ namespace eastl
 			mPool.mOverflowAllocator = x.mPool.mOverflowAllocator;
 		}
 
+		/// release_empty_slabs
+		///
+		/// Frees the pool's slabs which have no nodes in use. Available only when the
+		/// OverflowAllocator is a slab_overflow_allocator. See fixed_pool_with_slabs.
+		///
+		size_t release_empty_slabs()
+		{
+			return mPool.release_empty_slabs();
+		}
+
 	}; // fixed_node_allocator
 
 
@@ -934,7 +1353,7 @@ namespace eastl
 	class fixed_hashtable_allocator
 	{
 	public:
-		typedef typename conditional<bEnableOverflow, fixed_pool_with_overflow<OverflowAllocator>, fixed_pool>::type                                 pool_type;
+		typedef typename conditional<bEnableOverflow, typename fixed_pool_overflow_type<OverflowAllocator>::type, fixed_pool>::type                                 pool_type;
 		typedef fixed_hashtable_allocator<bucketCount, nodeSize, nodeCount, nodeAlignment, nodeAlignmentOffset, bEnableOverflow, OverflowAllocator>  this_type;
 		typedef OverflowAllocator overflow_allocator_type;
 
@@ -1049,10 +1468,10 @@ namespace eastl
 		}
 
 
-		void deallocate(void* p, size_t)
+		void deallocate(void* p, size_t n)
 		{
-			if(p != mpBucketBuffer) // If we are freeing a node and not buckets...
-				mPool.deallocate(p);
+			if(p != mpBucketBuffer) // If we are freeing a node or overflow buckets...
+				DoDeallocate(p, n, mPool);
 		}
 
 
@@ -1104,6 +1523,34 @@ namespace eastl
 			mPool.mOverflowAllocator = x.mPool.mOverflowAllocator;
 		}
 
+		/// release_empty_slabs
+		///
+		/// Frees the pool's slabs which have no nodes in use. Available only when the
+		/// OverflowAllocator is a slab_overflow_allocator. See fixed_pool_with_slabs.
+		///
+		size_t release_empty_slabs()
+		{
+			return mPool.release_empty_slabs();
+		}
+
+	protected:
+		template <typename Pool>
+		void DoDeallocate(void* p, size_t, Pool& pool)
+		{
+			pool.deallocate(p); // fixed_pool_with_overflow tells its nodes from overflow buckets by address.
+		}
+
+		// fixed_pool_with_slabs puts whatever it is given on its freelist, so overflow buckets
+		// are told apart here. They are always bigger than kBucketsSize, so unless nodes are too, 
+		// the size alone tells.
+		void DoDeallocate(void* p, size_t n, fixed_pool_with_slabs<OverflowAllocator>& pool)
+		{
+			if((n == kNodeSize) && ((kNodeSize <= kBucketsSize) || pool.owns(p)))
+				pool.deallocate(p);
+			else
+				pool.mOverflowAllocator.deallocate(p, n);
+		}
+
 	}; // fixed_hashtable_allocator
 
 
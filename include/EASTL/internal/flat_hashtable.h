@@ -0,0 +1,1397 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements flat_hashtable, an open-addressing hash table which
+// is the shared implementation of flat_hash_map and flat_hash_set.
+//
+// The primary distinctions between flat_hashtable and hashtable are:
+//    - Elements are stored inline in a single contiguous slot array instead
+//      of in individually allocated nodes. A lookup is thus usually a single
+//      cache miss on the control bytes followed by a single cache miss on
+//      the element, rather than a bucket miss followed by a chain of node misses.
+//    - Each slot has a one byte control value which is either empty, deleted
+//      or the low 7 bits of the element's hash. Lookups compare a group of
+//      control bytes at once (16 with SSE2, 8 with the portable fallback),
+//      so most mismatching keys are rejected without touching the element.
+//    - Iterators and references are invalidated by any insertion which causes
+//      a rehash, and erase does not invalidate other iterators. This is the
+//      same contract as vector rather than the node-based hash containers.
+//    - The max load factor is fixed at 7/8.
+//
+// The design follows the SwissTable family of hash tables.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EABase/eabase.h>
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/hashtable.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/allocator.h>
+#include <EASTL/iterator.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#include <EASTL/initializer_list.h>
+#include <string.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+	#include <new>
+	#include <stddef.h>
+	#if defined(EA_COMPILER_MSVC)
+		#include <intrin.h>
+	#endif
+	#if EA_SSE2
+		#include <emmintrin.h>
+	#endif
+EA_RESTORE_ALL_VC_WARNINGS()
+
+// 4512/4626 - 'class' : assignment operator could not be generated.
+// 4530 - C++ exception handler used, but unwind semantics are not enabled. Specify /EHsc
+// 4571 - catch(...) semantics changed since Visual C++ 7.1; structured exceptions (SEH) are no longer caught.
+EA_DISABLE_VC_WARNING(4512 4626 4530 4571);
+
+
+namespace eastl
+{
+
+	/// EASTL_FLAT_HASHTABLE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_FLAT_HASHTABLE_DEFAULT_NAME
+		#define EASTL_FLAT_HASHTABLE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " flat_hashtable" // Unless the user overrides something, this is "EASTL flat_hashtable".
+	#endif
+
+
+	/// EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR
+		#define EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR allocator_type(EASTL_FLAT_HASHTABLE_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_FLAT_HASHTABLE_SSE2
+	///
+	/// Defined as 0 or 1. If 1 then group probing compares 16 control bytes at
+	/// a time with SSE2 instructions, else a portable 8 byte SWAR implementation is used.
+	///
+	#ifndef EASTL_FLAT_HASHTABLE_SSE2
+		#if EA_SSE2
+			#define EASTL_FLAT_HASHTABLE_SSE2 1
+		#else
+			#define EASTL_FLAT_HASHTABLE_SSE2 0
+		#endif
+	#endif
+
+
+	namespace Internal
+	{
+		/// flat_hash_ctrl_t
+		///
+		/// The control byte of a flat_hashtable slot. Full slots store the low 7 bits
+		/// of the element hash (so are >= 0), while the special values all have the
+		/// high bit set. kFlatHashSentinel marks the end of the control array so that
+		/// iteration doesn't need a bounds check.
+		///
+		typedef int8_t flat_hash_ctrl_t;
+
+		enum : flat_hash_ctrl_t
+		{
+			kFlatHashEmpty    = -128, // 0b10000000
+			kFlatHashDeleted  = -2,   // 0b11111110
+			kFlatHashSentinel = -1    // 0b11111111
+		};
+
+		inline bool FlatHashIsFull(flat_hash_ctrl_t c)          { return c >= 0; }
+		inline bool FlatHashIsEmptyOrDeleted(flat_hash_ctrl_t c) { return c < kFlatHashSentinel; }
+
+
+		/// gFlatHashEmptyGroup
+		///
+		/// A shared control array for an empty flat_hashtable, present so that a new
+		/// empty table allocates no memory. It is a sentinel followed by empty bytes,
+		/// which is what a zero capacity table would look like.
+		///
+		extern EASTL_API const flat_hash_ctrl_t gFlatHashEmptyGroup[16];
+
+
+		inline uint32_t FlatHashCountTrailingZeros(uint64_t x) // x must be non-zero.
+		{
+			#if defined(EA_COMPILER_MSVC) && defined(EA_PROCESSOR_X86_64)
+				unsigned long index;
+				_BitScanForward64(&index, x);
+				return (uint32_t)index;
+			#elif (defined(EA_COMPILER_GNUC) || defined(EA_COMPILER_CLANG)) && !defined(EA_COMPILER_EDG)
+				return (uint32_t)__builtin_ctzll(x);
+			#else
+				uint32_t n = 0;
+				while((x & 1) == 0) { x >>= 1; ++n; }
+				return n;
+			#endif
+		}
+
+		inline uint32_t FlatHashCountLeadingZeros(uint64_t x) // x must be non-zero.
+		{
+			#if defined(EA_COMPILER_MSVC) && defined(EA_PROCESSOR_X86_64)
+				unsigned long index;
+				_BitScanReverse64(&index, x);
+				return (uint32_t)(63 - index);
+			#elif (defined(EA_COMPILER_GNUC) || defined(EA_COMPILER_CLANG)) && !defined(EA_COMPILER_EDG)
+				return (uint32_t)__builtin_clzll(x);
+			#else
+				uint32_t n = 0;
+				while((x & UINT64_C(0x8000000000000000)) == 0) { x <<= 1; ++n; }
+				return n;
+			#endif
+		}
+
+
+		/// flat_hash_bitmask
+		///
+		/// A bitmask of matching positions within a group. Each position occupies
+		/// (1 << Shift) bits of T, of which only the highest is ever set.
+		/// Iterate it with: while(mask) { i = mask.LowestBitSet(); ...; mask.ClearLowestBit(); }
+		///
+		template <typename T, uint32_t Width, uint32_t Shift>
+		struct flat_hash_bitmask
+		{
+			T mMask;
+
+			explicit flat_hash_bitmask(T mask) : mMask(mask) { }
+
+			explicit operator bool() const { return mMask != 0; }
+
+			uint32_t LowestBitSet() const  { return FlatHashCountTrailingZeros((uint64_t)mMask) >> Shift; }
+			uint32_t TrailingZeros() const { return FlatHashCountTrailingZeros((uint64_t)mMask) >> Shift; }
+			uint32_t LeadingZeros() const
+			{
+				const uint32_t kExtraBits = 64 - (Width << Shift); // Unused high bits when promoted to uint64_t.
+				return (FlatHashCountLeadingZeros((uint64_t)mMask) - kExtraBits) >> Shift;
+			}
+
+			void ClearLowestBit() { mMask &= (mMask - 1); }
+		};
+
+
+		#if EASTL_FLAT_HASHTABLE_SSE2
+
+			/// flat_hash_group
+			///
+			/// A window of 16 control bytes which can be matched in parallel.
+			///
+			struct flat_hash_group
+			{
+				static const uint32_t kWidth = 16;
+				typedef flat_hash_bitmask<uint32_t, kWidth, 0> bitmask_type;
+
+				__m128i mCtrl;
+
+				explicit flat_hash_group(const flat_hash_ctrl_t* pCtrl)
+					: mCtrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl))) { }
+
+				bitmask_type Match(flat_hash_ctrl_t h2) const
+					{ return bitmask_type((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), mCtrl))); }
+
+				bitmask_type MaskEmpty() const
+					{ return bitmask_type((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(kFlatHashEmpty), mCtrl))); }
+
+				bitmask_type MaskEmptyOrDeleted() const
+					{ return bitmask_type((uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kFlatHashSentinel), mCtrl))); }
+
+				uint32_t CountLeadingEmptyOrDeleted() const
+					{ return FlatHashCountTrailingZeros((uint64_t)(uint32_t)(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kFlatHashSentinel), mCtrl)) + 1)); }
+			};
+
+		#else
+
+			/// flat_hash_group
+			///
+			/// A window of 8 control bytes which are matched in parallel within a
+			/// 64 bit word (SIMD within a register).
+			///
+			struct flat_hash_group
+			{
+				static const uint32_t kWidth = 8;
+				typedef flat_hash_bitmask<uint64_t, kWidth, 3> bitmask_type;
+
+				static const uint64_t kMsbs = UINT64_C(0x8080808080808080);
+				static const uint64_t kLsbs = UINT64_C(0x0101010101010101);
+
+				uint64_t mCtrl;
+
+				explicit flat_hash_group(const flat_hash_ctrl_t* pCtrl)
+				{
+					#if defined(EA_SYSTEM_BIG_ENDIAN)
+						mCtrl = 0;
+						for(int i = 7; i >= 0; --i)
+							mCtrl = (mCtrl << 8) | (uint8_t)pCtrl[i];
+					#else
+						memcpy(&mCtrl, pCtrl, sizeof(mCtrl));
+					#endif
+				}
+
+				// This can report false positives when a byte is h2 + 1 following a match. That's
+				// harmless because every match is subsequently verified with the key comparison.
+				bitmask_type Match(flat_hash_ctrl_t h2) const
+				{
+					const uint64_t x = mCtrl ^ (kLsbs * (uint8_t)h2);
+					return bitmask_type((x - kLsbs) & ~x & kMsbs);
+				}
+
+				bitmask_type MaskEmpty() const
+					{ return bitmask_type((mCtrl & (~mCtrl << 6)) & kMsbs); }
+
+				bitmask_type MaskEmptyOrDeleted() const
+					{ return bitmask_type((mCtrl & (~mCtrl << 7)) & kMsbs); }
+
+				uint32_t CountLeadingEmptyOrDeleted() const
+				{
+					const uint64_t kGaps = UINT64_C(0x00FEFEFEFEFEFEFE);
+					return (FlatHashCountTrailingZeros(((~mCtrl & (mCtrl >> 7)) | kGaps) + 1) + 7) >> 3;
+				}
+			};
+
+		#endif
+
+
+		/// flat_hash_probe_seq
+		///
+		/// Triangular probing over groups. With a capacity of 2^k - 1 this visits
+		/// every group exactly once before repeating.
+		///
+		struct flat_hash_probe_seq
+		{
+			size_t mMask;
+			size_t mOffset;
+			size_t mIndex;
+
+			flat_hash_probe_seq(size_t h1, size_t mask)
+				: mMask(mask), mOffset(h1 & mask), mIndex(0) { }
+
+			size_t offset() const           { return mOffset; }
+			size_t offset(size_t i) const   { return (mOffset + i) & mMask; }
+
+			void next()
+			{
+				mIndex  += flat_hash_group::kWidth;
+				mOffset += mIndex;
+				mOffset &= mMask;
+			}
+		};
+
+	} // namespace Internal
+
+
+
+	/// flat_hashtable_iterator
+	///
+	/// Iterates the full slots of a flat_hashtable. The bConst parameter defines
+	/// if the iterator is a const_iterator or an iterator.
+	///
+	template <typename Value, bool bConst>
+	struct flat_hashtable_iterator
+	{
+	public:
+		typedef flat_hashtable_iterator<Value, bConst>                   this_type;
+		typedef flat_hashtable_iterator<Value, false>                    this_type_non_const;
+		typedef Value                                                    value_type;
+		typedef typename conditional<bConst, const Value*, Value*>::type pointer;
+		typedef typename conditional<bConst, const Value&, Value&>::type reference;
+		typedef ptrdiff_t                                                difference_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag                       iterator_category;
+
+	public:
+		Internal::flat_hash_ctrl_t* mpCtrl;
+		Value*                      mpSlot;
+
+	public:
+		flat_hashtable_iterator(Internal::flat_hash_ctrl_t* pCtrl = NULL, Value* pSlot = NULL)
+			: mpCtrl(pCtrl), mpSlot(pSlot) { }
+
+		template <bool IsConst = bConst, typename enable_if<IsConst, int>::type = 0>
+		flat_hashtable_iterator(const this_type_non_const& x)
+			: mpCtrl(x.mpCtrl), mpSlot(x.mpSlot) { }
+
+		flat_hashtable_iterator(const flat_hashtable_iterator&) = default;
+		flat_hashtable_iterator& operator=(const flat_hashtable_iterator&) = default;
+
+		reference operator*() const
+			{ return *mpSlot; }
+
+		pointer operator->() const
+			{ return mpSlot; }
+
+		flat_hashtable_iterator& operator++()
+			{ ++mpCtrl; ++mpSlot; skip_empty_or_deleted(); return *this; }
+
+		flat_hashtable_iterator operator++(int)
+			{ flat_hashtable_iterator temp(*this); ++*this; return temp; }
+
+		// Advances to the next full slot or to the trailing sentinel, whichever comes first.
+		void skip_empty_or_deleted()
+		{
+			while(Internal::FlatHashIsEmptyOrDeleted(*mpCtrl))
+			{
+				const uint32_t nSkip = Internal::flat_hash_group(mpCtrl).CountLeadingEmptyOrDeleted();
+				mpCtrl += nSkip;
+				mpSlot += nSkip;
+			}
+		}
+
+	}; // flat_hashtable_iterator
+
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator==(const flat_hashtable_iterator<Value, bConstA>& a, const flat_hashtable_iterator<Value, bConstB>& b)
+		{ return a.mpCtrl == b.mpCtrl; }
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator!=(const flat_hashtable_iterator<Value, bConstA>& a, const flat_hashtable_iterator<Value, bConstB>& b)
+		{ return a.mpCtrl != b.mpCtrl; }
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	/// flat_hashtable
+	///
+	/// Key and Value: arbitrary MoveConstructible types.
+	///
+	/// ExtractKey: function object that takes a object of type Value
+	/// and returns a value of type Key.
+	///
+	/// Equal: function object that takes two objects of type k and returns
+	/// a bool-like value that is true if the two objects are considered equal.
+	///
+	/// Hash: a hash function, usually eastl::hash<Key>. The result is mixed
+	/// before use, so weak hashes such as the identity hash<int> are fine.
+	///
+	/// bMutableIterators: true if flat_hashtable::iterator is a mutable
+	/// iterator, false if iterator and const_iterator are both const
+	/// iterators. This is true for flat_hash_map and false for flat_hash_set.
+	///
+	/// Keys are always unique; there is no flat multimap or multiset.
+	///
+	/// Elements are moved when the table rehashes, so pointers, references
+	/// and iterators are invalidated by any insertion that triggers a rehash.
+	/// Use reserve() up front if stable references are needed during a build phase.
+	///
+	template <typename Key, typename Value, typename Allocator, typename ExtractKey,
+			  typename Equal, typename Hash, bool bMutableIterators>
+	class flat_hashtable
+	{
+	public:
+		typedef Key                                                                   key_type;
+		typedef Value                                                                 value_type;
+		typedef Allocator                                                             allocator_type;
+		typedef Equal                                                                 key_equal;
+		typedef Hash                                                                  hasher;
+		typedef ptrdiff_t                                                             difference_type;
+		typedef eastl_size_t                                                          size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef value_type&                                                           reference;
+		typedef const value_type&                                                     const_reference;
+		typedef flat_hashtable_iterator<value_type, !bMutableIterators>               iterator;
+		typedef flat_hashtable_iterator<value_type, true>                             const_iterator;
+		typedef eastl::pair<iterator, bool>                                           insert_return_type;
+		typedef flat_hashtable<Key, Value, Allocator, ExtractKey, Equal, Hash, bMutableIterators> this_type;
+		typedef ExtractKey                                                            extract_key_type;
+		typedef Internal::flat_hash_ctrl_t                                            ctrl_type;
+		typedef Internal::flat_hash_group                                             group_type;
+
+		static const size_type kGroupWidth = group_type::kWidth;
+
+	protected:
+		ctrl_type*      mpCtrl;         // Control bytes: mnCapacity slots, a sentinel, then kGroupWidth - 1 bytes cloned from the start.
+		value_type*     mpSlots;        // Points into the same allocation as mpCtrl.
+		size_type       mnCapacity;     // Always zero or 2^n - 1.
+		size_type       mnSize;
+		size_type       mnGrowthLeft;   // Number of insertions remaining before we must rehash.
+		Hash            mHash;          // To do: Make this instance use zero space when it is zero size.
+		Equal           mEqual;         // To do: Make this instance use zero space when it is zero size.
+		ExtractKey      mExtractKey;    // To do: Make this member go away entirely, as it never has any data.
+		allocator_type  mAllocator;     // To do: Use base class optimization to make this go away.
+
+	public:
+		flat_hashtable(size_type nBucketCount, const Hash& hashFunction, const Equal& equal, const ExtractKey& extractKey,
+					   const allocator_type& allocator = EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR);
+
+		template <typename InputIterator>
+		flat_hashtable(InputIterator first, InputIterator last, size_type nBucketCount, const Hash& hashFunction,
+					   const Equal& equal, const ExtractKey& extractKey,
+					   const allocator_type& allocator = EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR);
+
+		flat_hashtable(const this_type& x);
+		flat_hashtable(this_type&& x);
+		flat_hashtable(this_type&& x, const allocator_type& allocator);
+	   ~flat_hashtable();
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT { return mAllocator; }
+		allocator_type&       get_allocator() EA_NOEXCEPT       { return mAllocator; }
+		void                  set_allocator(const allocator_type& allocator) { mAllocator = allocator; }
+
+		this_type& operator=(const this_type& x);
+		this_type& operator=(std::initializer_list<value_type> ilist);
+		this_type& operator=(this_type&& x);
+
+		void swap(this_type& x);
+
+		iterator begin() EA_NOEXCEPT
+		{
+			iterator i(mpCtrl, mpSlots);
+			i.skip_empty_or_deleted();
+			return i;
+		}
+
+		const_iterator begin() const EA_NOEXCEPT
+		{
+			const_iterator i(mpCtrl, mpSlots);
+			i.skip_empty_or_deleted();
+			return i;
+		}
+
+		const_iterator cbegin() const EA_NOEXCEPT
+			{ return begin(); }
+
+		iterator end() EA_NOEXCEPT
+			{ return iterator(mpCtrl + mnCapacity, mpSlots + mnCapacity); }
+
+		const_iterator end() const EA_NOEXCEPT
+			{ return const_iterator(mpCtrl + mnCapacity, mpSlots + mnCapacity); }
+
+		const_iterator cend() const EA_NOEXCEPT
+			{ return end(); }
+
+		bool empty() const EA_NOEXCEPT
+			{ return mnSize == 0; }
+
+		size_type size() const EA_NOEXCEPT
+			{ return mnSize; }
+
+		size_type capacity() const EA_NOEXCEPT
+			{ return mnCapacity; }
+
+		// Each slot acts as a bucket of size one. Provided for interface parity with hashtable.
+		size_type bucket_count() const EA_NOEXCEPT
+			{ return mnCapacity; }
+
+		float load_factor() const EA_NOEXCEPT
+			{ return mnCapacity ? ((float)mnSize / (float)mnCapacity) : 0.f; }
+
+		// The max load factor of a flat_hashtable is fixed.
+		float get_max_load_factor() const EA_NOEXCEPT
+			{ return 7.f / 8.f; }
+
+		hasher hash_function() const
+			{ return mHash; }
+
+		const key_equal& key_eq() const
+			{ return mEqual; }
+
+		key_equal& key_eq()
+			{ return mEqual; }
+
+		template <class... Args>
+		insert_return_type emplace(Args&&... args);
+
+		template <class... Args>
+		iterator emplace_hint(const_iterator position, Args&&... args);
+
+		insert_return_type                     insert(const value_type& value);
+		insert_return_type                     insert(value_type&& value);
+		iterator                               insert(const_iterator hint, const value_type& value);
+		iterator                               insert(const_iterator hint, value_type&& value);
+		void                                   insert(std::initializer_list<value_type> ilist);
+		template <typename InputIterator> void insert(InputIterator first, InputIterator last);
+
+		iterator         erase(const_iterator position);
+		iterator         erase(const_iterator first, const_iterator last);
+		size_type        erase(const key_type& k);
+
+		void clear();
+		void clear(bool clearBuckets);              // If clearBuckets is true, we free the slot memory and set the capacity back to zero.
+		void reset_lose_memory() EA_NOEXCEPT;       // This is a unilateral reset to an initially empty state. No destructors are called, no deallocation occurs.
+		void rehash(size_type nBucketCount);
+		void reserve(size_type nElementCount);
+
+		iterator       find(const key_type& key);
+		const_iterator find(const key_type& key) const;
+
+		/// Implements a find whereby the user supplies a comparison of a different type
+		/// than the key type, as with hashtable::find_as. uhash must produce the same hash
+		/// value as the container's hash function does for equivalent keys.
+		///
+		/// Example usage (note that the predicate uses string as first type and char* as second):
+		///     flat_hash_set<string> hashSet;
+		///     hashSet.find_as("hello", hash<const char*>(), equal_to<>());
+		///
+		template <typename U, typename UHash, typename BinaryPredicate>
+		iterator       find_as(const U& u, UHash uhash, BinaryPredicate predicate);
+
+		template <typename U, typename UHash, typename BinaryPredicate>
+		const_iterator find_as(const U& u, UHash uhash, BinaryPredicate predicate) const;
+
+		template <typename U>
+		iterator       find_as(const U& u)       { return find_as(u, eastl::hash<U>(), eastl::equal_to<>()); }
+
+		template <typename U>
+		const_iterator find_as(const U& u) const { return find_as(u, eastl::hash<U>(), eastl::equal_to<>()); }
+
+		size_type count(const key_type& k) const
+			{ return (find(k) != end()) ? 1 : 0; }
+
+		bool contains(const key_type& k) const
+			{ return find(k) != end(); }
+
+		eastl::pair<iterator, iterator>             equal_range(const key_type& k);
+		eastl::pair<const_iterator, const_iterator> equal_range(const key_type& k) const;
+
+		bool validate() const;
+		int  validate_iterator(const_iterator i) const;
+
+	protected:
+		static size_type DoNormalizeCapacity(size_type n)
+		{
+			// Returns the smallest 2^k - 1 which is >= n.
+			size_type nCapacity = 1;
+			while(nCapacity < n)
+				nCapacity = (nCapacity << 1) | 1;
+			return nCapacity;
+		}
+
+		static size_type DoCapacityToGrowth(size_type nCapacity)
+		{
+			// With 8 wide groups a capacity of 7 needs at least one empty slot in every group window.
+			if((kGroupWidth == 8) && (nCapacity == 7))
+				return 6;
+			return nCapacity - (nCapacity / 8);
+		}
+
+		static size_type DoGrowthToLowerboundCapacity(size_type nGrowth)
+		{
+			if((kGroupWidth == 8) && (nGrowth == 7))
+				return 8;
+			return nGrowth + (size_type)(((int64_t)nGrowth - 1) / 7);
+		}
+
+		static size_t DoGetSlotOffset(size_type nCapacity)
+		{
+			const size_t nAlign = EASTL_ALIGN_OF(value_type);
+			return ((size_t)(nCapacity + kGroupWidth) + (nAlign - 1)) & ~(nAlign - 1);
+		}
+
+		static size_t DoGetAllocSize(size_type nCapacity)
+			{ return DoGetSlotOffset(nCapacity) + ((size_t)nCapacity * sizeof(value_type)); }
+
+		size_t DoHash(const key_type& k) const
+			{ return Internal::HashMix((size_t)mHash(k)); }
+
+		static size_t           DoH1(size_t h) { return h >> 7; }
+		static ctrl_type        DoH2(size_t h) { return (ctrl_type)(h & 0x7F); }
+
+		void DoSetCtrl(size_type i, ctrl_type h)
+		{
+			// Also update the cloned byte at the end of the control array, so that a group
+			// read which wraps past the sentinel sees the same state as the start of the array.
+			mpCtrl[i] = h;
+			mpCtrl[((i - (kGroupWidth - 1)) & mnCapacity) + ((kGroupWidth - 1) & mnCapacity)] = h;
+		}
+
+		void       DoAllocateSlots(size_type nCapacity);
+		void       DoFreeSlots();
+		void       DoDestroyValues();
+		void       DoResize(size_type nNewCapacity);
+		size_type  DoFindFirstNonFull(size_t h) const;
+		size_type  DoPrepareInsert(size_t h);
+		void       DoCommitInsert(size_type i, size_t h);
+		void       DoEraseSlot(size_type i);
+
+		template <typename K>
+		size_type  DoFindIndex(const K& k, size_t h) const;
+
+		// Returns the index of k and false if it's present. Otherwise returns the index of the
+		// slot it should be constructed in and true, after which the caller must construct the
+		// value at mpSlots[index] and then call DoCommitInsert(index, h).
+		template <typename KeyT>
+		eastl::pair<size_type, bool> DoFindOrPrepareInsert(const KeyT& k, size_t h);
+
+		template <typename V>
+		insert_return_type DoInsertValue(V&& value);
+
+		// Used by copying and rehashing, where the keys are known to be unique and capacity is sufficient.
+		template <typename V>
+		void DoInsertUniqueNoGrow(V&& value);
+
+		iterator       DoMakeIterator(size_type i)       { return iterator(mpCtrl + i, mpSlots + i); }
+		const_iterator DoMakeIterator(size_type i) const { return const_iterator(mpCtrl + i, mpSlots + i); }
+
+	}; // class flat_hashtable
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// flat_hashtable
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(size_type nBucketCount, const H& hashFunction, const Eq& equal,
+														   const EK& extractKey, const allocator_type& allocator)
+		: mHash(hashFunction),
+		  mEqual(equal),
+		  mExtractKey(extractKey),
+		  mAllocator(allocator)
+	{
+		reset_lose_memory();
+
+		if(nBucketCount)
+			DoResize(DoNormalizeCapacity(nBucketCount));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename InputIterator>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(InputIterator first, InputIterator last, size_type nBucketCount,
+														   const H& hashFunction, const Eq& equal, const EK& extractKey,
+														   const allocator_type& allocator)
+		: mHash(hashFunction),
+		  mEqual(equal),
+		  mExtractKey(extractKey),
+		  mAllocator(allocator)
+	{
+		reset_lose_memory();
+
+		if(nBucketCount)
+			DoResize(DoNormalizeCapacity(nBucketCount));
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				insert(first, last);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				clear(true);
+				throw;
+			}
+		#endif
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(const this_type& x)
+		: mHash(x.mHash),
+		  mEqual(x.mEqual),
+		  mExtractKey(x.mExtractKey),
+		  mAllocator(x.mAllocator)
+	{
+		reset_lose_memory();
+
+		if(x.mnSize) // If there is anything to copy...
+		{
+			DoResize(DoNormalizeCapacity(DoGrowthToLowerboundCapacity(x.mnSize)));
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+			#endif
+					for(const_iterator it = x.begin(), itEnd = x.end(); it != itEnd; ++it)
+						DoInsertUniqueNoGrow(*it);
+			#if EASTL_EXCEPTIONS_ENABLED
+				}
+				catch(...)
+				{
+					clear(true);
+					throw;
+				}
+			#endif
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(this_type&& x)
+		: mHash(x.mHash),
+		  mEqual(x.mEqual),
+		  mExtractKey(x.mExtractKey),
+		  mAllocator(x.mAllocator)
+	{
+		reset_lose_memory();
+		swap(x);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(this_type&& x, const allocator_type& allocator)
+		: mHash(x.mHash),
+		  mEqual(x.mEqual),
+		  mExtractKey(x.mExtractKey),
+		  mAllocator(allocator)
+	{
+		reset_lose_memory();
+		swap(x); // swap will directly or indirectly handle the possibility that mAllocator != x.mAllocator.
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline flat_hashtable<K, V, A, EK, Eq, H, bM>::~flat_hashtable()
+	{
+		DoDestroyValues();
+		DoFreeSlots();
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::this_type&
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			clear();
+
+			#if EASTL_ALLOCATOR_COPY_ENABLED
+				mAllocator = x.mAllocator;
+			#endif
+
+			insert(x.begin(), x.end());
+		}
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::this_type&
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::operator=(this_type&& x)
+	{
+		if(this != &x)
+		{
+			clear();
+			swap(x); // member swap handles the case that x has a different allocator than our allocator by doing a copy.
+		}
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::this_type&
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::operator=(std::initializer_list<value_type> ilist)
+	{
+		clear();
+		insert(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::swap(this_type& x)
+	{
+		eastl::swap(mHash,       x.mHash);
+		eastl::swap(mEqual,      x.mEqual);
+		eastl::swap(mExtractKey, x.mExtractKey);
+		EASTL_MACRO_SWAP(ctrl_type*,  mpCtrl,  x.mpCtrl);
+		EASTL_MACRO_SWAP(value_type*, mpSlots, x.mpSlots);
+		eastl::swap(mnCapacity,   x.mnCapacity);
+		eastl::swap(mnSize,       x.mnSize);
+		eastl::swap(mnGrowthLeft, x.mnGrowthLeft);
+
+		if(mAllocator != x.mAllocator) // If allocators are not equivalent...
+			eastl::swap(mAllocator, x.mAllocator);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoAllocateSlots(size_type nCapacity)
+	{
+		EASTL_ASSERT((nCapacity & (nCapacity + 1)) == 0); // Must be 2^n - 1.
+
+		void* const p = allocate_memory(mAllocator, DoGetAllocSize(nCapacity), EASTL_ALIGN_OF(value_type), 0);
+		EASTL_ASSERT_MSG(p != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
+
+		mpCtrl     = static_cast<ctrl_type*>(p);
+		mpSlots    = reinterpret_cast<value_type*>(static_cast<char*>(p) + DoGetSlotOffset(nCapacity));
+		mnCapacity = nCapacity;
+
+		memset(mpCtrl, Internal::kFlatHashEmpty, (size_t)(nCapacity + kGroupWidth));
+		mpCtrl[nCapacity] = Internal::kFlatHashSentinel;
+		mnGrowthLeft = DoCapacityToGrowth(nCapacity) - mnSize;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoFreeSlots()
+	{
+		// A zero capacity means mpCtrl is the shared gFlatHashEmptyGroup.
+		if(mnCapacity)
+			EASTLFree(mAllocator, mpCtrl, DoGetAllocSize(mnCapacity));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoDestroyValues()
+	{
+		EA_CONSTEXPR_IF(!eastl::is_trivially_destructible<value_type>::value)
+		{
+			for(size_type i = 0; i < mnCapacity; ++i)
+			{
+				if(Internal::FlatHashIsFull(mpCtrl[i]))
+					mpSlots[i].~value_type();
+			}
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoResize(size_type nNewCapacity)
+	{
+		// Values are relocated rather than reinserted. Map keys are const and so can't be moved,
+		// so trivially relocatable values are copied bitwise. Other values are moved if that can't
+		// throw and copied otherwise, so that a throw leaves the old slots intact, as when a vector grows.
+		ctrl_type* const  pOldCtrl       = mpCtrl;
+		value_type* const pOldSlots      = mpSlots;
+		const size_type   nOldCapacity   = mnCapacity;
+		const size_type   nOldSize       = mnSize;
+		const size_type   nOldGrowthLeft = mnGrowthLeft;
+
+		mnSize = 0;
+		DoAllocateSlots(nNewCapacity);
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				for(size_type i = 0; i < nOldCapacity; ++i)
+				{
+					if(Internal::FlatHashIsFull(pOldCtrl[i]))
+					{
+						const size_t    h    = DoHash(mExtractKey(pOldSlots[i]));
+						const size_type iNew = DoFindFirstNonFull(h);
+
+						EA_CONSTEXPR_IF(eastl::is_trivially_relocatable<value_type>::value)
+							memcpy(static_cast<void*>(mpSlots + iNew), pOldSlots + i, sizeof(value_type));
+						else
+							::new(eastl::addressof(mpSlots[iNew])) value_type(eastl::move_if_noexcept(pOldSlots[i]));
+
+						DoCommitInsert(iNew, h);
+					}
+				}
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				EA_CONSTEXPR_IF(!eastl::is_trivially_relocatable<value_type>::value)
+					DoDestroyValues();
+				DoFreeSlots();
+
+				mpCtrl       = pOldCtrl;
+				mpSlots      = pOldSlots;
+				mnCapacity   = nOldCapacity;
+				mnSize       = nOldSize;
+				mnGrowthLeft = nOldGrowthLeft;
+				throw;
+			}
+		#endif
+
+		EASTL_ASSERT(mnSize == nOldSize); EA_UNUSED(nOldSize); EA_UNUSED(nOldGrowthLeft);
+
+		EA_CONSTEXPR_IF(!eastl::is_trivially_relocatable<value_type>::value && !eastl::is_trivially_destructible<value_type>::value)
+		{
+			for(size_type i = 0; i < nOldCapacity; ++i)
+			{
+				if(Internal::FlatHashIsFull(pOldCtrl[i]))
+					pOldSlots[i].~value_type();
+			}
+		}
+
+		if(nOldCapacity)
+			EASTLFree(mAllocator, pOldCtrl, DoGetAllocSize(nOldCapacity));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoFindFirstNonFull(size_t h) const
+	{
+		Internal::flat_hash_probe_seq seq(DoH1(h), mnCapacity);
+
+		for(;;)
+		{
+			const group_type g(mpCtrl + seq.offset());
+			const typename group_type::bitmask_type mask = g.MaskEmptyOrDeleted();
+
+			if(mask)
+				return (size_type)seq.offset(mask.LowestBitSet());
+
+			seq.next();
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoPrepareInsert(size_t h)
+	{
+		size_type i = DoFindFirstNonFull(h);
+
+		// We can reuse a deleted slot without growing, as that doesn't reduce the number of empty slots.
+		if((mnGrowthLeft == 0) && (mpCtrl[i] != Internal::kFlatHashDeleted))
+		{
+			// If most of the consumed growth is tombstones then rehash in place (which drops
+			// them) rather than doubling, so erase/insert churn doesn't grow the table forever.
+			if(mnCapacity && (mnSize <= (DoCapacityToGrowth(mnCapacity) / 2)))
+				DoResize(mnCapacity);
+			else
+				DoResize((mnCapacity * 2) + 1);
+
+			i = DoFindFirstNonFull(h);
+		}
+
+		return i;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoCommitInsert(size_type i, size_t h)
+	{
+		mnGrowthLeft -= (mpCtrl[i] == Internal::kFlatHashEmpty) ? 1 : 0;
+		DoSetCtrl(i, DoH2(h));
+		++mnSize;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename V2>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoInsertUniqueNoGrow(V2&& value)
+	{
+		const size_t    h = DoHash(mExtractKey(value));
+		const size_type i = DoFindFirstNonFull(h);
+
+		::new(eastl::addressof(mpSlots[i])) value_type(eastl::forward<V2>(value));
+		DoCommitInsert(i, h);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename KeyT>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoFindIndex(const KeyT& k, size_t h) const
+	{
+		Internal::flat_hash_probe_seq seq(DoH1(h), mnCapacity);
+		const ctrl_type h2 = DoH2(h);
+
+		for(;;)
+		{
+			const group_type g(mpCtrl + seq.offset());
+
+			for(typename group_type::bitmask_type match = g.Match(h2); match; match.ClearLowestBit())
+			{
+				const size_type i = (size_type)seq.offset(match.LowestBitSet());
+
+				if(EASTL_LIKELY(mEqual(k, mExtractKey(mpSlots[i]))))
+					return i;
+			}
+
+			if(EASTL_LIKELY(g.MaskEmpty()))
+				return mnCapacity; // Not found.
+
+			seq.next();
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename KeyT>
+	inline eastl::pair<typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type, bool>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoFindOrPrepareInsert(const KeyT& k, size_t h)
+	{
+		const size_type i = DoFindIndex(k, h);
+
+		if(i != mnCapacity)
+			return eastl::pair<size_type, bool>(i, false);
+
+		return eastl::pair<size_type, bool>(DoPrepareInsert(h), true);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename V2>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::insert_return_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoInsertValue(V2&& value)
+	{
+		const size_t h = DoHash(mExtractKey(value));
+		const eastl::pair<size_type, bool> result = DoFindOrPrepareInsert(mExtractKey(value), h);
+
+		if(result.second)
+		{
+			// If this throws then the table is unmodified, aside from a possible rehash.
+			::new(eastl::addressof(mpSlots[result.first])) value_type(eastl::forward<V2>(value));
+			DoCommitInsert(result.first, h);
+		}
+
+		return insert_return_type(DoMakeIterator(result.first), result.second);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <class... Args>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::insert_return_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::emplace(Args&&... args)
+	{
+		// We need the key in order to know where the value goes, so we construct a temporary
+		// value and move it into place. Use insert or (for maps) try_emplace to avoid this.
+		value_type value(eastl::forward<Args>(args)...);
+		return DoInsertValue(eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <class... Args>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::emplace_hint(const_iterator, Args&&... args)
+	{
+		// We currently ignore the iterator argument as a hint.
+		return emplace(eastl::forward<Args>(args)...).first;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::insert_return_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(const value_type& value)
+	{
+		return DoInsertValue(value);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::insert_return_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(value_type&& value)
+	{
+		return DoInsertValue(eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(const_iterator, const value_type& value)
+	{
+		// We ignore the first argument (hint iterator). It's not likely to be useful for hashtable containers.
+		return DoInsertValue(value).first;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(const_iterator, value_type&& value)
+	{
+		return DoInsertValue(eastl::move(value)).first;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(std::initializer_list<value_type> ilist)
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename InputIterator>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(InputIterator first, InputIterator last)
+	{
+		const size_type nElementAdd = (size_type)eastl::ht_distance(first, last);
+
+		if(nElementAdd)
+			reserve(mnSize + nElementAdd);
+
+		for(; first != last; ++first)
+			DoInsertValue(*first);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoEraseSlot(size_type i)
+	{
+		mpSlots[i].~value_type();
+		--mnSize;
+
+		// If the slot is not within a run of kGroupWidth full or deleted slots then no probe
+		// sequence could have passed over it while searching for a different key, so it can
+		// go back to being empty instead of becoming a tombstone.
+		const size_type nIndexBefore = (i - kGroupWidth) & mnCapacity;
+		const typename group_type::bitmask_type emptyAfter  = group_type(mpCtrl + i).MaskEmpty();
+		const typename group_type::bitmask_type emptyBefore = group_type(mpCtrl + nIndexBefore).MaskEmpty();
+
+		const bool bWasNeverFull = emptyBefore && emptyAfter &&
+								   ((emptyAfter.TrailingZeros() + emptyBefore.LeadingZeros()) < kGroupWidth);
+
+		DoSetCtrl(i, bWasNeverFull ? (ctrl_type)Internal::kFlatHashEmpty : (ctrl_type)Internal::kFlatHashDeleted);
+		mnGrowthLeft += bWasNeverFull ? 1 : 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::erase(const_iterator position)
+	{
+		const size_type i = (size_type)(position.mpCtrl - mpCtrl);
+		EASTL_ASSERT(i < mnCapacity && Internal::FlatHashIsFull(mpCtrl[i]));
+
+		DoEraseSlot(i);
+
+		iterator itNext(DoMakeIterator(i)); // Erasing doesn't move any other element, so we can continue from here.
+		++itNext;
+		return itNext;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::erase(const_iterator first, const_iterator last)
+	{
+		while(first != last)
+			first = erase(first);
+		return iterator(first.mpCtrl, const_cast<value_type*>(first.mpSlot));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::erase(const key_type& k)
+	{
+		const size_type i = DoFindIndex(k, DoHash(k));
+
+		if(i == mnCapacity)
+			return 0;
+
+		DoEraseSlot(i);
+		return 1;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::clear()
+	{
+		DoDestroyValues();
+
+		if(mnCapacity)
+		{
+			memset(mpCtrl, Internal::kFlatHashEmpty, (size_t)(mnCapacity + kGroupWidth));
+			mpCtrl[mnCapacity] = Internal::kFlatHashSentinel;
+		}
+
+		mnSize       = 0;
+		mnGrowthLeft = mnCapacity ? DoCapacityToGrowth(mnCapacity) : 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::clear(bool clearBuckets)
+	{
+		if(clearBuckets)
+		{
+			DoDestroyValues();
+			DoFreeSlots();
+			reset_lose_memory();
+		}
+		else
+			clear();
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::reset_lose_memory() EA_NOEXCEPT
+	{
+		// The reset function is a special extension function which unilaterally
+		// resets the container to an empty state without freeing the memory of
+		// the contained objects. This is useful for very quickly tearing down a
+		// container built into scratch memory.
+		mpCtrl       = const_cast<ctrl_type*>(Internal::gFlatHashEmptyGroup);
+		mpSlots      = NULL;
+		mnCapacity   = 0;
+		mnSize       = 0;
+		mnGrowthLeft = 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::rehash(size_type nBucketCount)
+	{
+		if((nBucketCount == 0) && (mnSize == 0))
+		{
+			clear(true);
+			return;
+		}
+
+		// A rehash can shrink the table, but never below what's needed to hold the current elements.
+		const size_type nMinCapacity = DoGrowthToLowerboundCapacity(mnSize);
+		const size_type nNewCapacity = DoNormalizeCapacity(eastl::max_alt(nBucketCount, nMinCapacity));
+
+		if((nNewCapacity != mnCapacity) || (mnSize + mnGrowthLeft) != DoCapacityToGrowth(mnCapacity)) // If size changes or there are tombstones to drop...
+			DoResize(nNewCapacity);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::reserve(size_type nElementCount)
+	{
+		if(nElementCount > (mnSize + mnGrowthLeft))
+			DoResize(DoNormalizeCapacity(DoGrowthToLowerboundCapacity(nElementCount)));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::find(const key_type& k)
+	{
+		return DoMakeIterator(DoFindIndex(k, DoHash(k))); // Index mnCapacity is end().
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::const_iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::find(const key_type& k) const
+	{
+		return DoMakeIterator(DoFindIndex(k, DoHash(k)));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename U, typename UHash, typename BinaryPredicate>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::find_as(const U& other, UHash uhash, BinaryPredicate predicate)
+	{
+		const size_t h = Internal::HashMix((size_t)uhash(other));
+		Internal::flat_hash_probe_seq seq(DoH1(h), mnCapacity);
+
+		for(;;)
+		{
+			const group_type g(mpCtrl + seq.offset());
+
+			for(typename group_type::bitmask_type match = g.Match(DoH2(h)); match; match.ClearLowestBit())
+			{
+				const size_type i = (size_type)seq.offset(match.LowestBitSet());
+
+				if(predicate(mExtractKey(mpSlots[i]), other)) // Intentionally compare with key as first arg and other as second arg.
+					return DoMakeIterator(i);
+			}
+
+			if(g.MaskEmpty())
+				return end();
+
+			seq.next();
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename U, typename UHash, typename BinaryPredicate>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::const_iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::find_as(const U& other, UHash uhash, BinaryPredicate predicate) const
+	{
+		return const_cast<this_type*>(this)->find_as(other, uhash, predicate);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	eastl::pair<typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator,
+				typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::equal_range(const key_type& k)
+	{
+		iterator it = find(k);
+
+		if(it == end())
+			return eastl::pair<iterator, iterator>(it, it);
+
+		iterator itNext(it);
+		return eastl::pair<iterator, iterator>(it, ++itNext);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	eastl::pair<typename flat_hashtable<K, V, A, EK, Eq, H, bM>::const_iterator,
+				typename flat_hashtable<K, V, A, EK, Eq, H, bM>::const_iterator>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::equal_range(const key_type& k) const
+	{
+		const_iterator it = find(k);
+
+		if(it == end())
+			return eastl::pair<const_iterator, const_iterator>(it, it);
+
+		const_iterator itNext(it);
+		return eastl::pair<const_iterator, const_iterator>(it, ++itNext);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	bool flat_hashtable<K, V, A, EK, Eq, H, bM>::validate() const
+	{
+		if(mnCapacity == 0)
+		{
+			// Verify that gFlatHashEmptyGroup is used exactly and only for zero capacity tables.
+			return (mpCtrl == Internal::gFlatHashEmptyGroup) && (mnSize == 0) && (mnGrowthLeft == 0) &&
+				   (mpCtrl[0] == Internal::kFlatHashSentinel);
+		}
+
+		if((mnCapacity & (mnCapacity + 1)) != 0) // Capacity must be 2^n - 1.
+			return false;
+
+		if(mpCtrl[mnCapacity] != Internal::kFlatHashSentinel)
+			return false;
+
+		// Verify the cloned control bytes mirror the start of the array.
+		for(size_type i = 0; (i < kGroupWidth - 1) && (i < mnCapacity); ++i)
+		{
+			if(mpCtrl[mnCapacity + 1 + i] != mpCtrl[i])
+				return false;
+		}
+
+		// Verify that the element count matches mnSize, that every element is findable
+		// and that each control byte matches its element's hash.
+		size_type nFullCount = 0;
+
+		for(size_type i = 0; i < mnCapacity; ++i)
+		{
+			if(Internal::FlatHashIsFull(mpCtrl[i]))
+			{
+				const size_t h = DoHash(mExtractKey(mpSlots[i]));
+
+				if(mpCtrl[i] != DoH2(h))
+					return false;
+
+				if(DoFindIndex(mExtractKey(mpSlots[i]), h) != i)
+					return false;
+
+				++nFullCount;
+			}
+			else if((mpCtrl[i] != Internal::kFlatHashEmpty) && (mpCtrl[i] != Internal::kFlatHashDeleted))
+				return false;
+		}
+
+		if(nFullCount != mnSize)
+			return false;
+
+		return (mnSize + mnGrowthLeft) <= DoCapacityToGrowth(mnCapacity);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	int flat_hashtable<K, V, A, EK, Eq, H, bM>::validate_iterator(const_iterator i) const
+	{
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		if((i.mpCtrl >= mpCtrl) && (i.mpCtrl < (mpCtrl + mnCapacity)) && Internal::FlatHashIsFull(*i.mpCtrl))
+			return (isf_valid | isf_current | isf_can_dereference);
+
+		return isf_none;
+	}
+
+
+} // namespace eastl
+
+
+EA_RESTORE_VC_WARNING();
@@ -155,6 +155,14 @@ namespace eastl
 		public:
 			static const bool value = sizeof(test<T>(0)) == sizeof(eastl::yes_type);
 		};
+
+		// Custom type-trait that is true when both the hash function and the key equality predicate define
+		// 'is_transparent', in which case the hashtable provides heterogeneous lookup (as C++20 does for unordered containers).
+		template <typename Hash, typename Equal, typename = void>
+		struct is_transparent_hash_lookup : public eastl::false_type {};
+
+		template <typename Hash, typename Equal>
+		struct is_transparent_hash_lookup<Hash, Equal, eastl::void_t<typename Hash::is_transparent, typename Equal::is_transparent>> : public eastl::true_type {};
 	}
 	
 	static_assert(Internal::has_hashcode_member<hash_node<int, true>>::value, "contains a mnHashCode member");
@@ -166,6 +174,7 @@ namespace eastl
 	#define ENABLE_IF_HASHCODE_EASTLSIZET(T, RT) typename eastl::enable_if<eastl::is_convertible<T, eastl_size_t>::value, RT>::type
 	#define ENABLE_IF_TRUETYPE(T) typename eastl::enable_if<T::value>::type*
 	#define DISABLE_IF_TRUETYPE(T) typename eastl::enable_if<!T::value>::type*
+	#define ENABLE_IF_TRANSPARENT_LOOKUP(H, Eq) typename eastl::enable_if<Internal::is_transparent_hash_lookup<H, Eq>::value>::type*
 
 
 	/// node_iterator_base
@@ -277,14 +286,26 @@ namespace eastl
 			while(*mpBucket == NULL) // We store an extra bucket with some non-NULL value at the end 
 				++mpBucket;          // of the bucket array so that finding the end of the bucket
 			mpNode = *mpBucket;      // array is quick and simple.
+
+			// While an incremental rehash is in progress, the extra bucket of the old bucket array
+			// instead holds a link to the new bucket array, tagged with a low bit of 1. Nodes and
+			// bucket arrays are at least 4-byte aligned, and the usual end marker (~0) has both
+			// low bits set, so neither can be mistaken for a link.
+			if(EASTL_UNLIKELY(((uintptr_t)mpNode & 3) == 1))
+			{
+				mpBucket = (node_type**)((uintptr_t)mpNode & ~(uintptr_t)1);
+				while(*mpBucket == NULL)
+					++mpBucket;
+				mpNode = *mpBucket;
+			}
 		}
 
 		void increment()
 		{
 			mpNode = mpNode->mpNext;
 
-			while(mpNode == NULL)
-				mpNode = *++mpBucket;
+			if(mpNode == NULL)
+				increment_bucket();
 		}
 
 	}; // hashtable_iterator_base
@@ -397,6 +418,42 @@ namespace eastl
 	};
 
 
+	namespace Internal
+	{
+		/// HashMix
+		///
+		/// A cheap multiplicative finalizer which spreads the entropy of every input
+		/// bit into the low bits of the result. Many eastl::hash specializations
+		/// (e.g. hash<int>) are the identity function, which is fine with a prime
+		/// bucket count but leaves most buckets unused when only the low bits are kept.
+		///
+		inline size_t HashMix(size_t h)
+		{
+			#if (EA_PLATFORM_WORD_SIZE >= 8)
+				const uint64_t m = (uint64_t)h * UINT64_C(0x9E3779B97F4A7C15);
+				return (size_t)(m ^ (m >> 32));
+			#else
+				const uint32_t m = (uint32_t)h * UINT32_C(0x9E3779B1);
+				return (size_t)(m ^ (m >> 16));
+			#endif
+		}
+	}
+
+
+	/// mask_range_hashing
+	///
+	/// Implements the conversion of a number in the range of [0, SIZE_T_MAX]
+	/// to the range of [0, BucketCount) for power of two bucket counts, by
+	/// mixing the hash and keeping its low bits. This avoids the integer
+	/// division of mod_range_hashing. Use with power2_rehash_policy.
+	///
+	struct mask_range_hashing
+	{
+		uint32_t operator()(size_t r, uint32_t n) const
+			{ return (uint32_t)(Internal::HashMix(r) & (n - 1)); }
+	};
+
+
 	/// default_ranged_hash
 	///
 	/// Default ranged hash function H. In principle it should be a
@@ -452,6 +509,88 @@ namespace eastl
 	};
 
 
+	/// power2_rehash_policy
+	///
+	/// Rehash policy whose bucket counts are always powers of two, so that
+	/// a bucket index can be computed with a mask instead of a modulo.
+	/// This must be paired with mask_range_hashing (or another range hasher
+	/// which mixes the hash), as keeping only the low bits of a weak hash
+	/// would otherwise cluster elements into few buckets.
+	///
+	/// Example usage:
+	///     typedef hashtable<int, pair<const int, int>, EASTLAllocatorType, use_first<pair<const int, int> >, equal_to<int>,
+	///                       hash<int>, mask_range_hashing, default_ranged_hash, power2_rehash_policy, false, true, true> Power2HashMap;
+	///
+	struct EASTL_API power2_rehash_policy
+	{
+	public:
+		float            mfMaxLoadFactor;
+		float            mfGrowthFactor;
+		mutable uint32_t mnNextResize;
+
+	public:
+		power2_rehash_policy(float fMaxLoadFactor = 1.f)
+			: mfMaxLoadFactor(fMaxLoadFactor), mfGrowthFactor(2.f), mnNextResize(0) { }
+
+		float GetMaxLoadFactor() const
+			{ return mfMaxLoadFactor; }
+
+		/// Return a bucket count no greater than nBucketCountHint,
+		/// Don't update member variables while at it.
+		static uint32_t GetPrevBucketCountOnly(uint32_t nBucketCountHint);
+
+		/// Return a bucket count no greater than nBucketCountHint.
+		/// This function has a side effect of updating mnNextResize.
+		uint32_t GetPrevBucketCount(uint32_t nBucketCountHint) const;
+
+		/// Return a bucket count no smaller than nBucketCountHint.
+		/// This function has a side effect of updating mnNextResize.
+		uint32_t GetNextBucketCount(uint32_t nBucketCountHint) const;
+
+		/// Return a bucket count appropriate for nElementCount elements.
+		/// This function has a side effect of updating mnNextResize.
+		uint32_t GetBucketCount(uint32_t nElementCount) const;
+
+		/// Same as prime_rehash_policy::GetRehashRequired, but returns power of two bucket counts.
+		eastl::pair<bool, uint32_t>
+		GetRehashRequired(uint32_t nBucketCount, uint32_t nElementCount, uint32_t nElementAdd) const;
+	};
+
+
+	/// incremental_rehash_policy
+	///
+	/// Rehash policy with the same bucket counts as prime_rehash_policy, but which
+	/// makes the hashtable grow incrementally. When the table grows, the old bucket
+	/// array is kept alongside the new one, and subsequent operations on the table
+	/// each move the elements of a few old buckets to the new array. This bounds
+	/// the cost of any single insert, which otherwise must relink every element
+	/// of the table when it triggers a rehash. Only allocating the new bucket array
+	/// remains proportional to the table size.
+	///
+	/// Only inserts and rehash() move elements. Finds, counts, erases and iteration
+	/// look in whichever bucket array holds the element and never modify the table,
+	/// so they are as cheap as with prime_rehash_policy (apart from one extra bucket
+	/// read) and invalidate no iterators. While a rehash is in progress, an insert
+	/// invalidates iterators even if it does not itself start a rehash. The bucket
+	/// interface (begin(n), bucket_size(n)) covers only the current bucket array, to
+	/// which not every element may have been moved yet. The hash function must work
+	/// with default_ranged_hash (i.e. H1 plus H2).
+	///
+	/// Example usage:
+	///     typedef hashtable<int, pair<const int, int>, EASTLAllocatorType, use_first<pair<const int, int> >, equal_to<int>,
+	///                       hash<int>, mod_range_hashing, default_ranged_hash, incremental_rehash_policy, false, true, true> IncrementalHashMap;
+	///
+	struct incremental_rehash_policy : public prime_rehash_policy
+	{
+	public:
+		uint32_t mnStepBucketCount; // The number of old buckets moved by each operation, in addition to the bucket the operation itself uses.
+
+	public:
+		incremental_rehash_policy(float fMaxLoadFactor = 1.f, uint32_t nStepBucketCount = 8)
+			: prime_rehash_policy(fMaxLoadFactor), mnStepBucketCount(nStepBucketCount ? nStepBucketCount : 1) { }
+	};
+
+
 
 
 
@@ -470,7 +609,7 @@ namespace eastl
 	/// rehash_base
 	///
 	/// Give hashtable the get_max_load_factor functions if the rehash 
-	/// policy is prime_rehash_policy.
+	/// policy is prime_rehash_policy, power2_rehash_policy or incremental_rehash_policy.
 	///
 	template <typename RehashPolicy, typename Hashtable>
 	struct rehash_base { };
@@ -495,6 +634,61 @@ namespace eastl
 		}
 	};
 
+	template <typename Hashtable>
+	struct rehash_base<power2_rehash_policy, Hashtable>
+	{
+		float get_max_load_factor() const
+		{
+			const Hashtable* const pThis = static_cast<const Hashtable*>(this);
+			return pThis->rehash_policy().GetMaxLoadFactor();
+		}
+
+		void set_max_load_factor(float fMaxLoadFactor)
+		{
+			Hashtable* const pThis = static_cast<Hashtable*>(this);
+			pThis->rehash_policy(power2_rehash_policy(fMaxLoadFactor));
+		}
+	};
+
+	/// rehash_base<incremental_rehash_policy>
+	///
+	/// Also holds the state of a rehash in progress. The state belongs to a
+	/// particular container's bucket arrays, so copying a container never copies it.
+	///
+	template <typename Hashtable>
+	struct rehash_base<incremental_rehash_policy, Hashtable>
+	{
+		rehash_base()
+			: mpOldBucketArray(NULL), mnOldBucketCount(0), mnOldBucketIndex(0) { }
+
+		rehash_base(const rehash_base&)
+			: mpOldBucketArray(NULL), mnOldBucketCount(0), mnOldBucketIndex(0) { }
+
+		rehash_base& operator=(const rehash_base&)
+			{ return *this; }
+
+		float get_max_load_factor() const
+		{
+			const Hashtable* const pThis = static_cast<const Hashtable*>(this);
+			return pThis->rehash_policy().GetMaxLoadFactor();
+		}
+
+		void set_max_load_factor(float fMaxLoadFactor)
+		{
+			Hashtable* const pThis = static_cast<Hashtable*>(this);
+			pThis->rehash_policy(incremental_rehash_policy(fMaxLoadFactor, pThis->rehash_policy().mnStepBucketCount));
+		}
+
+		/// Returns true if the table is in the middle of an incremental rehash.
+		bool rehash_in_progress() const
+			{ return mpOldBucketArray != NULL; }
+
+	protected:
+		void**       mpOldBucketArray;  // The bucket array being rehashed from, or NULL if no rehash is in progress. Actually of type node_type**.
+		eastl_size_t mnOldBucketCount;  // The bucket count of mpOldBucketArray.
+		eastl_size_t mnOldBucketIndex;  // Old buckets below this index have been moved to the new bucket array.
+	};
+
 
 
 
@@ -656,6 +850,14 @@ namespace eastl
 		bool compare(const Key& key, hash_code_t, node_type* pNode) const
 			{ return mEqual(key, mExtractKey(pNode->mValue)); }
 
+		template <typename KX>
+		hash_code_t get_hash_code_as(const KX& key) const
+			{ return (hash_code_t)m_h1(key); }
+
+		template <typename KX>
+		bool compare_as(const KX& key, hash_code_t, node_type* pNode) const
+			{ return mEqual(key, mExtractKey(pNode->mValue)); }
+
 		void copy_code(node_type*, const node_type*) const
 			{ } // Nothing to do.
 
@@ -727,6 +929,14 @@ namespace eastl
 		bool compare(const Key& key, hash_code_t c, node_type* pNode) const
 			{ return (pNode->mnHashCode == c) && mEqual(key, mExtractKey(pNode->mValue)); }
 
+		template <typename KX>
+		hash_code_t get_hash_code_as(const KX& key) const
+			{ return (hash_code_t)m_h1(key); }
+
+		template <typename KX>
+		bool compare_as(const KX& key, hash_code_t c, node_type* pNode) const
+			{ return (pNode->mnHashCode == c) && mEqual(key, mExtractKey(pNode->mValue)); }
+
 		void copy_code(node_type* pDest, const node_type* pSource) const
 			{ pDest->mnHashCode = pSource->mnHashCode; }
 
@@ -856,6 +1066,7 @@ namespace eastl
 		typedef H2                                                                                  h2_type;
 		typedef H                                                                                   h_type;
 		typedef integral_constant<bool, bUniqueKeys>                                                has_unique_keys_type;
+		typedef integral_constant<bool, is_same<RehashPolicy, incremental_rehash_policy>::value>    has_incremental_rehash_type;
 
 		using hash_code_base_type::key_eq;
 		using hash_code_base_type::hash_function;
@@ -919,7 +1130,7 @@ namespace eastl
 
 		iterator begin() EA_NOEXCEPT
 		{
-			iterator i(mpBucketArray);
+			iterator i(DoGetFirstBucket(has_incremental_rehash_type())); // Iteration visits an old bucket array first, if a rehash is in progress.
 			if(!i.mpNode)
 				i.increment_bucket();
 			return i;
@@ -927,7 +1138,7 @@ namespace eastl
 
 		const_iterator begin() const EA_NOEXCEPT
 		{
-			const_iterator i(mpBucketArray);
+			const_iterator i(DoGetFirstBucket(has_incremental_rehash_type()));
 			if(!i.mpNode)
 				i.increment_bucket();
 			return i;
@@ -1029,6 +1240,32 @@ namespace eastl
 		// insert_return_type					insert(const_iterator hint, P&& value); // sfinae: is_constructible<value_type, P&&>::value
 		void                                   insert(std::initializer_list<value_type> ilist);
 		template <typename InputIterator> void insert(InputIterator first, InputIterator last);
+
+		/// insert_bulk
+		///
+		/// Inserts the elements of [first, last) like insert(first, last), but is faster for
+		/// large batches. The bucket array is grown at most once, and elements are processed
+		/// in small groups: a group's nodes are constructed and hashed together, and the
+		/// bucket slots and chain heads they will touch are prefetched before any of them is
+		/// linked, so that the cache misses of a group overlap rather than occur one at a time.
+		/// As with insert, elements whose keys are already present are not inserted in a
+		/// container with unique keys.
+		///
+		template <typename ForwardIterator>
+		void insert_bulk(ForwardIterator first, ForwardIterator last);
+
+		/// insert_with_hash
+		///
+		/// Equivalent to insert(value), but uses the given hash code instead of computing one.
+		/// The hash code must be the one that hash_function() returns for the value's key.
+		/// This allows a key to be hashed once and then inserted into or looked up in several
+		/// tables which use the same hash function. See also find_with_hash.
+		///
+		insert_return_type insert_with_hash(hash_code_t c, const value_type& value)
+			{ return insert(c, NULL, value); }
+
+		insert_return_type insert_with_hash(hash_code_t c, value_type&& value)
+			{ return insert(c, NULL, eastl::move(value)); }
 	  //insert_return_type                     insert(node_type&& nh);
 	  //iterator                               insert(const_iterator hint, node_type&& nh);
 
@@ -1077,6 +1314,10 @@ namespace eastl
 		iterator         erase(const_iterator first, const_iterator last);
 		size_type        erase(const key_type& k);
 
+		template <typename KX, typename HX = H1, typename EqX = Equal, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX) = nullptr,
+				  typename = eastl::enable_if_t<!eastl::is_convertible<KX, iterator>::value && !eastl::is_convertible<KX, const_iterator>::value>>
+		size_type        erase(const KX& k);
+
 		void clear();
 		void clear(bool clearBuckets);                  // If clearBuckets is true, we free the bucket memory and set the bucket count back to the newly constructed count.
 		void reset_lose_memory() EA_NOEXCEPT;           // This is a unilateral reset to an initially empty state. No destructors are called, no deallocation occurs.
@@ -1086,11 +1327,48 @@ namespace eastl
 		iterator       find(const key_type& key);
 		const_iterator find(const key_type& key) const;
 
-		// missing transparent key support:
-		// template<typename K>
-		// iterator       find(const K& key);
-		// template<typename K>
-		// const_iterator find(const K& key) const;
+		/// find_with_hash
+		///
+		/// Equivalent to find(key), but uses the given hash code instead of computing one.
+		/// The hash code must be the one that hash_function() returns for key.
+		///
+		iterator       find_with_hash(const key_type& key, hash_code_t c)
+			{ return find_by_hash(key, c); }
+
+		const_iterator find_with_hash(const key_type& key, hash_code_t c) const
+			{ return find_by_hash(key, c); }
+
+		/// find_batch
+		///
+		/// Looks up nCount keys, storing find(pKeyArray[i]) in pResultArray[i]. This is faster
+		/// than a loop of find calls for batches of independent keys in a table that doesn't fit
+		/// in cache, because it overlaps the lookups' cache misses: keys are processed in small
+		/// groups, and a group's hashes are all computed and its bucket slots all prefetched,
+		/// then its chain heads are all prefetched, before any chain is searched.
+		///
+		/// Example usage:
+		///     hash_map<int, int>::iterator results[kCount];
+		///     hashMap.find_batch(keys, kCount, results);
+		///
+		void find_batch(const key_type* pKeyArray, size_type nCount, iterator* pResultArray);
+		void find_batch(const key_type* pKeyArray, size_type nCount, const_iterator* pResultArray) const;
+
+		/// Transparent (heterogeneous) lookup. The find, count, contains, equal_range and erase
+		/// overloads taking a KX participate in overload resolution only if both the hash function
+		/// and the key equality predicate define is_transparent. The hash function must return the
+		/// same value for a KX as for an equal key_type. This allows, for example, searching a
+		/// hash_set<string, hash<string>, equal_to<>> with a string_view or a char pointer without
+		/// constructing a temporary string. Transparent lookup requires the default ranged hash.
+		///
+		/// Example usage:
+		///     hash_map<string, int, hash<string>, equal_to<>> hashMap;
+		///     hashMap.find(string_view("hello"));
+		///
+		template <typename KX, typename HX = H1, typename EqX = Equal, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX) = nullptr>
+		iterator       find(const KX& key);
+
+		template <typename KX, typename HX = H1, typename EqX = Equal, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX) = nullptr>
+		const_iterator find(const KX& key) const;
 
 		/// Implements a find whereby the user supplies a comparison of a different type
 		/// than the hashtable value_type. A useful case of this is one whereby you have
@@ -1136,10 +1414,11 @@ namespace eastl
 				"bCacheHashCode to true or using find_by_hash(const key_type& k, hash_code_t c) instead.");
 
 			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+			node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
 
-			node_type* const pNode = DoFindNode(mpBucketArray[n], c);
+			node_type* const pNode = DoFindNode(*pBucket, c);
 
-			return pNode ? iterator(pNode, mpBucketArray + n) :
+			return pNode ? iterator(pNode, pBucket) :
 						   iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
@@ -1152,28 +1431,31 @@ namespace eastl
 								"bCacheHashCode to true or using find_by_hash(const key_type& k, hash_code_t c) instead.");
 
 			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+			node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
 
-			node_type* const pNode = DoFindNode(mpBucketArray[n], c);
+			node_type* const pNode = DoFindNode(*pBucket, c);
 
 			return pNode ?
-					   const_iterator(pNode, mpBucketArray + n) :
+					   const_iterator(pNode, pBucket) :
 					   const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
 		iterator find_by_hash(const key_type& k, hash_code_t c)
 		{
 			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+			node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
 
-			node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
-			return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+			node_type* const pNode = DoFindNode(*pBucket, k, c);
+			return pNode ? iterator(pNode, pBucket) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
 		const_iterator find_by_hash(const key_type& k, hash_code_t c) const
 		{
 			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+			node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
 
-			node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
-			return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+			node_type* const pNode = DoFindNode(*pBucket, k, c);
+			return pNode ? const_iterator(pNode, pBucket) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
 		// Returns a pair that allows iterating over all nodes in a hash bucket
@@ -1187,18 +1469,24 @@ namespace eastl
 
 		size_type count(const key_type& k) const EA_NOEXCEPT;
 
-		// transparent key support:
-		// template<typename K>
-		// size_type count(const K& k) const;
+		template <typename KX, typename HX = H1, typename EqX = Equal, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX) = nullptr>
+		size_type count(const KX& k) const;
+
+		bool contains(const key_type& k) const
+			{ return find(k) != end(); }
+
+		template <typename KX, typename HX = H1, typename EqX = Equal, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX) = nullptr>
+		bool contains(const KX& k) const
+			{ return find(k) != end(); }
 
 		eastl::pair<iterator, iterator>             equal_range(const key_type& k);
 		eastl::pair<const_iterator, const_iterator> equal_range(const key_type& k) const;
 
-		// transparent key support:
-		// template<typename K>
-		// eastl::pair<iterator, iterator>             equal_range(const K& k);
-		// template<typename K>
-		// eastl::pair<const_iterator, const_iterator> equal_range(const K& k) const;
+		template <typename KX, typename HX = H1, typename EqX = Equal, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX) = nullptr>
+		eastl::pair<iterator, iterator>             equal_range(const KX& k);
+
+		template <typename KX, typename HX = H1, typename EqX = Equal, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX) = nullptr>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& k) const;
 
 		bool validate() const;
 		int  validate_iterator(const_iterator i) const;
@@ -1309,8 +1597,71 @@ namespace eastl
 		iterator                    DoInsertKey(false_type, const key_type& key) { return DoInsertKey(false_type(), key, get_hash_code(key)); }
 
 		void       DoRehash(size_type nBucketCount);
+		void       DoLinkBulkNode(node_type* pNode, hash_code_t c, size_type n);
+
+		// The following implement incremental_rehash_policy. DoRehashStep must be called by every
+		// operation which inserts with hash code c, before it reads the bucket for c, so that every
+		// element with hash code c is in the same bucket array. Lookups instead use DoGetBucket,
+		// which returns the bucket that holds hash code c without moving anything. The false_type
+		// overloads are used with all other rehash policies and do nothing.
+		template <typename BoolConstantT>
+		void DoRehash(BoolConstantT, size_type nBucketCount, ENABLE_IF_TRUETYPE(BoolConstantT) = nullptr);
+
+		template <typename BoolConstantT>
+		void DoRehash(BoolConstantT, size_type nBucketCount, DISABLE_IF_TRUETYPE(BoolConstantT) = nullptr);
+
+		template <typename BoolConstantT>
+		void DoRehashStep(BoolConstantT, hash_code_t c, ENABLE_IF_TRUETYPE(BoolConstantT) = nullptr);
+
+		template <typename BoolConstantT>
+		void DoRehashStep(BoolConstantT, hash_code_t, DISABLE_IF_TRUETYPE(BoolConstantT) = nullptr) { }
+
+		template <typename BoolConstantT>
+		void DoRehashFinish(BoolConstantT, ENABLE_IF_TRUETYPE(BoolConstantT) = nullptr);
+
+		template <typename BoolConstantT>
+		void DoRehashFinish(BoolConstantT, DISABLE_IF_TRUETYPE(BoolConstantT) = nullptr) { }
+
+		template <typename BoolConstantT>
+		void DoRehashMoveBucket(BoolConstantT, size_type nOldBucketIndex, ENABLE_IF_TRUETYPE(BoolConstantT) = nullptr);
+
+		template <typename BoolConstantT>
+		node_type** DoGetBucket(BoolConstantT, hash_code_t c, size_type n, ENABLE_IF_TRUETYPE(BoolConstantT) = nullptr) const;
+
+		template <typename BoolConstantT>
+		node_type** DoGetBucket(BoolConstantT, hash_code_t, size_type n, DISABLE_IF_TRUETYPE(BoolConstantT) = nullptr) const
+			{ return mpBucketArray + n; }
+
+		template <typename BoolConstantT>
+		node_type** DoGetFirstBucket(BoolConstantT, ENABLE_IF_TRUETYPE(BoolConstantT) = nullptr) const
+			{ return this->mpOldBucketArray ? (node_type**)this->mpOldBucketArray : mpBucketArray; }
+
+		template <typename BoolConstantT>
+		node_type** DoGetFirstBucket(BoolConstantT, DISABLE_IF_TRUETYPE(BoolConstantT) = nullptr) const
+			{ return mpBucketArray; }
+
+		template <typename BoolConstantT>
+		void DoCopyOldBuckets(BoolConstantT, const this_type& x, ENABLE_IF_TRUETYPE(BoolConstantT) = nullptr);
+
+		template <typename BoolConstantT>
+		void DoCopyOldBuckets(BoolConstantT, const this_type&, DISABLE_IF_TRUETYPE(BoolConstantT) = nullptr) { }
+
+		template <typename BoolConstantT>
+		void DoRehashAbandon(BoolConstantT, bool bFreeMemory, ENABLE_IF_TRUETYPE(BoolConstantT) = nullptr);
+
+		template <typename BoolConstantT>
+		void DoRehashAbandon(BoolConstantT, bool, DISABLE_IF_TRUETYPE(BoolConstantT) = nullptr) { }
+
+		template <typename BoolConstantT>
+		void DoRehashSwap(BoolConstantT, this_type& x, ENABLE_IF_TRUETYPE(BoolConstantT) = nullptr);
+
+		template <typename BoolConstantT>
+		void DoRehashSwap(BoolConstantT, this_type&, DISABLE_IF_TRUETYPE(BoolConstantT) = nullptr) { }
+
+		template <typename Iterator>
+		void       DoFindBatch(const key_type* pKeyArray, size_type nCount, Iterator* pResultArray) const;
 		node_type* DoFindNode(node_type* pNode, const key_type& k, hash_code_t c) const;
-		NodeFindKeyData DoFindKeyData(const key_type& k) const;
+		NodeFindKeyData DoFindKeyData(const key_type& k);
 
 		template <typename T>
 		ENABLE_IF_HAS_HASHCODE(T, node_type) DoFindNode(T* pNode, hash_code_t c) const
@@ -1326,6 +1677,9 @@ namespace eastl
 		template <typename U, typename BinaryPredicate>
 		node_type* DoFindNodeT(node_type* pNode, const U& u, BinaryPredicate predicate) const;
 
+		template <typename KX>
+		node_type* DoFindNodeAs(node_type* pNode, const KX& k, hash_code_t c) const;
+
 	private:
 		template <typename V, typename Enabled = bool_constant<bUniqueKeys>, ENABLE_IF_TRUETYPE(Enabled) = nullptr>
 		eastl::pair<iterator, bool> DoInsertValueExtraForwarding(const key_type& k,
@@ -1474,6 +1828,8 @@ namespace eastl
 							pNodeSource = pNodeSource->mpNext;
 						}
 					}
+
+					DoCopyOldBuckets(has_incremental_rehash_type(), x);
 			#if EASTL_EXCEPTIONS_ENABLED
 				}
 				catch(...)
@@ -1728,6 +2084,7 @@ namespace eastl
 		EASTL_MACRO_SWAP(node_type**, mpBucketArray, x.mpBucketArray);
 		eastl::swap(mnBucketCount, x.mnBucketCount);
 		eastl::swap(mnElementCount, x.mnElementCount);
+		DoRehashSwap(has_incremental_rehash_type(), x);
 
 		if (mAllocator != x.mAllocator) // If allocators are not equivalent...
 		{
@@ -1757,9 +2114,10 @@ namespace eastl
 	{
 		const hash_code_t c = get_hash_code(k);
 		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
 
-		node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
-		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		node_type* const pNode = DoFindNode(*pBucket, k, c);
+		return pNode ? iterator(pNode, pBucket) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
 
@@ -1771,9 +2129,98 @@ namespace eastl
 	{
 		const hash_code_t c = get_hash_code(k);
 		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
 
-		node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
-		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		node_type* const pNode = DoFindNode(*pBucket, k, c);
+		return pNode ? const_iterator(pNode, pBucket) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename KX, typename HX, typename EqX, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX)>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find(const KX& k)
+	{
+		const hash_code_t c = this->get_hash_code_as(k);
+		const size_type   n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
+
+		node_type* const pNode = DoFindNodeAs(*pBucket, k, c);
+		return pNode ? iterator(pNode, pBucket) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename KX, typename HX, typename EqX, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX)>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find(const KX& k) const
+	{
+		const hash_code_t c = this->get_hash_code_as(k);
+		const size_type   n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
+
+		node_type* const pNode = DoFindNodeAs(*pBucket, k, c);
+		return pNode ? const_iterator(pNode, pBucket) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_batch(const key_type* pKeyArray, size_type nCount, iterator* pResultArray)
+	{
+		DoFindBatch(pKeyArray, nCount, pResultArray);
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_batch(const key_type* pKeyArray, size_type nCount, const_iterator* pResultArray) const
+	{
+		DoFindBatch(pKeyArray, nCount, pResultArray);
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename Iterator>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindBatch(const key_type* pKeyArray, size_type nCount, Iterator* pResultArray) const
+	{
+		// Each stage touches memory that the previous stage prefetched, so by the time a
+		// chain is searched its first node is likely in cache. The group size bounds the
+		// number of outstanding prefetches to roughly what a core can track at once.
+		const size_type kGroupSize = 16;
+
+		hash_code_t codeArray[kGroupSize];
+		node_type** bucketArray[kGroupSize];
+
+		for(size_type nGroupBegin = 0; nGroupBegin < nCount; nGroupBegin += kGroupSize)
+		{
+			const key_type* const pGroupKeys = pKeyArray + nGroupBegin;
+			const size_type       nGroupSize = eastl::min_alt(kGroupSize, nCount - nGroupBegin);
+
+			for(size_type i = 0; i < nGroupSize; i++)
+			{
+				codeArray[i]   = get_hash_code(pGroupKeys[i]);
+				bucketArray[i] = DoGetBucket(has_incremental_rehash_type(), codeArray[i], (size_type)bucket_index(pGroupKeys[i], codeArray[i], (uint32_t)mnBucketCount));
+				EASTL_PREFETCH(bucketArray[i]);
+			}
+
+			for(size_type i = 0; i < nGroupSize; i++)
+				EASTL_PREFETCH(*bucketArray[i]);
+
+			for(size_type i = 0; i < nGroupSize; i++)
+			{
+				node_type* const pNode = DoFindNode(*bucketArray[i], pGroupKeys[i], codeArray[i]);
+				pResultArray[nGroupBegin + i] = pNode ? Iterator(pNode, bucketArray[i]) : Iterator(mpBucketArray + mnBucketCount); // Iterator(mpBucketArray + mnBucketCount) == end()
+			}
+		}
 	}
 
 
@@ -1785,10 +2232,11 @@ namespace eastl
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_as(const U& other, UHash uhash, BinaryPredicate predicate)
 	{
 		const hash_code_t c = (hash_code_t)uhash(other);
-		const size_type   n = (size_type)(c % mnBucketCount); // This assumes we are using the mod range policy.
+		const size_type   n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
 
-		node_type* const pNode = DoFindNodeT(mpBucketArray[n], other, predicate);
-		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		node_type* const pNode = DoFindNodeT(*pBucket, other, predicate);
+		return pNode ? iterator(pNode, pBucket) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
 
@@ -1800,10 +2248,11 @@ namespace eastl
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_as(const U& other, UHash uhash, BinaryPredicate predicate) const
 	{
 		const hash_code_t c = (hash_code_t)uhash(other);
-		const size_type   n = (size_type)(c % mnBucketCount); // This assumes we are using the mod range policy.
+		const size_type   n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
 
-		node_type* const pNode = DoFindNodeT(mpBucketArray[n], other, predicate);
-		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		node_type* const pNode = DoFindNodeT(*pBucket, other, predicate);
+		return pNode ? const_iterator(pNode, pBucket) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
 
@@ -1861,12 +2310,13 @@ namespace eastl
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_range_by_hash(hash_code_t c) const
 	{
 		const size_type start = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
-		node_type* const pNodeStart = mpBucketArray[start];
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, start);
+		node_type* const pNodeStart = *pBucket;
 
 		if (pNodeStart)
 		{
-			eastl::pair<const_iterator, const_iterator> pair(const_iterator(pNodeStart, mpBucketArray + start), 
-															 const_iterator(pNodeStart, mpBucketArray + start));
+			eastl::pair<const_iterator, const_iterator> pair(const_iterator(pNodeStart, pBucket), 
+															 const_iterator(pNodeStart, pBucket));
 			pair.second.increment_bucket();
 			return pair;
 		}
@@ -1884,12 +2334,13 @@ namespace eastl
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_range_by_hash(hash_code_t c)
 	{
 		const size_type start = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
-		node_type* const pNodeStart = mpBucketArray[start];
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, start);
+		node_type* const pNodeStart = *pBucket;
 
 		if (pNodeStart)
 		{
-			eastl::pair<iterator, iterator> pair(iterator(pNodeStart, mpBucketArray + start), 
-												 iterator(pNodeStart, mpBucketArray + start));
+			eastl::pair<iterator, iterator> pair(iterator(pNodeStart, pBucket), 
+												 iterator(pNodeStart, pBucket));
 			pair.second.increment_bucket();
 			return pair;
 
@@ -1909,10 +2360,11 @@ namespace eastl
 		const hash_code_t c      = get_hash_code(k);
 		const size_type   n      = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 		size_type         result = 0;
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
 
 		// To do: Make a specialization for bU (unique keys) == true and take 
 		// advantage of the fact that the count will always be zero or one in that case. 
-		for(node_type* pNode = mpBucketArray[n]; pNode; pNode = pNode->mpNext)
+		for(node_type* pNode = *pBucket; pNode; pNode = pNode->mpNext)
 		{
 			if(compare(k, c, pNode))
 				++result;
@@ -1922,6 +2374,27 @@ namespace eastl
 
 
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename KX, typename HX, typename EqX, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX)>
+	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::size_type
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::count(const KX& k) const
+	{
+		const hash_code_t c      = this->get_hash_code_as(k);
+		const size_type   n      = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		size_type         result = 0;
+		node_type** const pBucket = DoGetBucket(has_incremental_rehash_type(), c, n);
+
+		for(node_type* pNode = *pBucket; pNode; pNode = pNode->mpNext)
+		{
+			if(this->compare_as(k, c, pNode))
+				++result;
+		}
+		return result;
+	}
+
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator,
@@ -1930,7 +2403,7 @@ namespace eastl
 	{
 		const hash_code_t c     = get_hash_code(k);
 		const size_type   n     = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
-		node_type**       head  = mpBucketArray + n;
+		node_type**       head  = DoGetBucket(has_incremental_rehash_type(), c, n);
 		node_type*        pNode = DoFindNode(*head, k, c);
 
 		if(pNode)
@@ -1967,7 +2440,7 @@ namespace eastl
 	{
 		const hash_code_t c     = get_hash_code(k);
 		const size_type   n     = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
-		node_type**       head  = mpBucketArray + n;
+		node_type**       head  = DoGetBucket(has_incremental_rehash_type(), c, n);
 		node_type*        pNode = DoFindNode(*head, k, c);
 
 		if(pNode)
@@ -1994,13 +2467,65 @@ namespace eastl
 	}
 
 
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename KX, typename HX, typename EqX, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX)>
+	eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator,
+				typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator>
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::equal_range(const KX& k)
+	{
+		const hash_code_t c     = this->get_hash_code_as(k);
+		const size_type   n     = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		node_type**       head  = DoGetBucket(has_incremental_rehash_type(), c, n);
+		node_type*        pNode = DoFindNodeAs(*head, k, c);
+
+		if(pNode)
+		{
+			node_type* p1 = pNode->mpNext;
+
+			for(; p1; p1 = p1->mpNext)
+			{
+				if(!this->compare_as(k, c, p1))
+					break;
+			}
+
+			iterator first(pNode, head);
+			iterator last(p1, head);
+
+			if(!p1)
+				last.increment_bucket();
+
+			return eastl::pair<iterator, iterator>(first, last);
+		}
+
+		return eastl::pair<iterator, iterator>(iterator(mpBucketArray + mnBucketCount),  // iterator(mpBucketArray + mnBucketCount) == end()
+											   iterator(mpBucketArray + mnBucketCount));
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename KX, typename HX, typename EqX, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX)>
+	inline eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator,
+					   typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator>
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::equal_range(const KX& k) const
+	{
+		typedef hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU> hashtable_type;
+		const eastl::pair<iterator, iterator> range(const_cast<hashtable_type*>(this)->equal_range(k));
+		return eastl::pair<const_iterator, const_iterator>(range.first, range.second);
+	}
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::NodeFindKeyData
-	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindKeyData(const key_type& k) const {
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindKeyData(const key_type& k) {
 		NodeFindKeyData d;
 		d.code		   = get_hash_code(k);
 		d.bucket_index = (size_type)bucket_index(k, d.code, (uint32_t)mnBucketCount);
+		DoRehashStep(has_incremental_rehash_type(), d.code);
 		d.node		   = DoFindNode(mpBucketArray[d.bucket_index], k, d.code);
 		return d;
 	}
@@ -2035,6 +2560,22 @@ namespace eastl
 	}
 
 
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename KX>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::node_type* 
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindNodeAs(node_type* pNode, const KX& k, hash_code_t c) const
+	{
+		for(; pNode; pNode = pNode->mpNext)
+		{
+			if(this->compare_as(k, c, pNode))
+				return pNode;
+		}
+		return NULL;
+	}
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <bool bDeleteOnException, typename Enabled, ENABLE_IF_TRUETYPE(Enabled)> // only enabled when keys are unique
@@ -2053,6 +2594,7 @@ namespace eastl
 				{
 					n = (size_type)bucket_index(k, c, (uint32_t)bRehash.second);
 					DoRehash(bRehash.second);
+					DoRehashStep(has_incremental_rehash_type(), c); // An incremental rehash has just begun, so move the old bucket for c. See DoGetBucket.
 				}
 
 				EASTL_ASSERT((uintptr_t)mpBucketArray != (uintptr_t)&gpEmptyBucketArray[0]);
@@ -2092,6 +2634,7 @@ namespace eastl
 		const key_type&   k        = mExtractKey(pNodeNew->mValue);
 		const hash_code_t c        = get_hash_code(k);
 		size_type         n        = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		DoRehashStep(has_incremental_rehash_type(), c);
 		node_type* const  pNode    = DoFindNode(mpBucketArray[n], k, c);
 
 		if(pNode == NULL) // If value is not present... add it.
@@ -2129,6 +2672,7 @@ namespace eastl
 		const key_type&   k        = mExtractKey(pNodeNew->mValue);
 		const hash_code_t c        = get_hash_code(k);
 		const size_type   n        = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		DoRehashStep(has_incremental_rehash_type(), c);
 
 		set_code(pNodeNew, c); // This is a no-op for most hashtables.
 
@@ -2222,6 +2766,7 @@ namespace eastl
 		// Adds the value to the hash table if not already present. 
 		// If already present then the existing value is returned via an iterator/bool pair.
 		size_type         n     = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		DoRehashStep(has_incremental_rehash_type(), c);
 		node_type* const  pNode = DoFindNode(mpBucketArray[n], k, c);
 
 		if(pNode == NULL) // If value is not present... add it.
@@ -2271,6 +2816,7 @@ namespace eastl
 			DoRehash(bRehash.second); // Note: We don't need to wrap this call with try/catch because there's nothing we would need to do in the catch.
 
 		const size_type n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		DoRehashStep(has_incremental_rehash_type(), c);
 
 		if(pNodeNew)
 			::new(eastl::addressof(pNodeNew->mValue)) value_type(eastl::move(value)); // It's expected that pNodeNew was allocated with allocate_uninitialized_node.
@@ -2369,6 +2915,7 @@ namespace eastl
 			DoRehash(bRehash.second); // Note: We don't need to wrap this call with try/catch because there's nothing we would need to do in the catch.
 
 		const size_type n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		DoRehashStep(has_incremental_rehash_type(), c);
 
 		if(pNodeNew)
 			::new(eastl::addressof(pNodeNew->mValue)) value_type(value); // It's expected that pNodeNew was allocated with allocate_uninitialized_node.
@@ -2471,6 +3018,7 @@ namespace eastl
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertKey(true_type, const key_type& key, const hash_code_t c) // true_type means bUniqueKeys is true.
 	{
 		size_type         n     = (size_type)bucket_index(key, c, (uint32_t)mnBucketCount);
+		DoRehashStep(has_incremental_rehash_type(), c);
 		node_type* const  pNode = DoFindNode(mpBucketArray[n], key, c);
 
 		if(pNode == NULL)
@@ -2490,6 +3038,7 @@ namespace eastl
 					{
 						n = (size_type)bucket_index(key, c, (uint32_t)bRehash.second);
 						DoRehash(bRehash.second);
+						DoRehashStep(has_incremental_rehash_type(), c); // An incremental rehash has just begun, so move the old bucket for c. See DoGetBucket.
 					}
 
 					EASTL_ASSERT((void**)mpBucketArray != &gpEmptyBucketArray[0]);
@@ -2524,6 +3073,7 @@ namespace eastl
 			DoRehash(bRehash.second);
 
 		const size_type   n = (size_type)bucket_index(key, c, (uint32_t)mnBucketCount);
+		DoRehashStep(has_incremental_rehash_type(), c);
 
 		node_type* const pNodeNew = DoAllocateNodeFromKey(key);
 		set_code(pNodeNew, c); // This is a no-op for most hashtables.
@@ -2673,6 +3223,99 @@ namespace eastl
 	}
 
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename ForwardIterator>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::insert_bulk(ForwardIterator first, ForwardIterator last)
+	{
+		const uint32_t nElementAdd = (uint32_t)eastl::distance(first, last);
+		const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, nElementAdd);
+
+		if(bRehash.first)
+			DoRehash(bRehash.second);
+
+		// The group size is a tradeoff between how many misses are in flight at once and how
+		// many prefetched lines can be evicted again before they are used.
+		const size_type kGroupSize = 16;
+
+		node_type*  pNodeArray[kGroupSize];
+		hash_code_t codeArray[kGroupSize];
+		size_type   bucketArray[kGroupSize];
+
+		while(first != last)
+		{
+			size_type nGroupSize = 0;
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+			#endif
+					for(; (nGroupSize < kGroupSize) && (first != last); ++first, ++nGroupSize)
+					{
+						node_type* const pNode = DoAllocateNode(*first);
+						const key_type&  k     = mExtractKey(pNode->mValue);
+
+						pNodeArray[nGroupSize]  = pNode;
+						codeArray[nGroupSize]   = get_hash_code(k);
+						bucketArray[nGroupSize] = (size_type)bucket_index(k, codeArray[nGroupSize], (uint32_t)mnBucketCount);
+						EASTL_PREFETCH(mpBucketArray + bucketArray[nGroupSize]);
+					}
+			#if EASTL_EXCEPTIONS_ENABLED
+				}
+				catch(...)
+				{
+					for(size_type i = 0; i < nGroupSize; i++)
+						DoFreeNode(pNodeArray[i]);
+					throw;
+				}
+			#endif
+
+			for(size_type i = 0; i < nGroupSize; i++)
+				EASTL_PREFETCH(mpBucketArray[bucketArray[i]]); // The head of the chain, which is searched for an equal key.
+
+			for(size_type i = 0; i < nGroupSize; i++)
+				DoLinkBulkNode(pNodeArray[i], codeArray[i], bucketArray[i]);
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoLinkBulkNode(node_type* pNodeNew, hash_code_t c, size_type n)
+	{
+		// The caller has already ensured that there is room for this node without a rehash.
+		DoRehashStep(has_incremental_rehash_type(), c);
+
+		const key_type&  k         = mExtractKey(pNodeNew->mValue);
+		node_type* const pNodePrev = DoFindNode(mpBucketArray[n], k, c);
+
+		EA_CONSTEXPR_IF(bU)
+		{
+			if(pNodePrev) // If the key is already present, discard the new node.
+			{
+				DoFreeNode(pNodeNew);
+				return;
+			}
+		}
+
+		EASTL_ASSERT((void**)mpBucketArray != &gpEmptyBucketArray[0]);
+		set_code(pNodeNew, c); // This is a no-op for most hashtables.
+
+		if(pNodePrev == NULL)
+		{
+			pNodeNew->mpNext = mpBucketArray[n];
+			mpBucketArray[n] = pNodeNew;
+		}
+		else // Keep equal elements contiguous, as DoInsertValue does for multi-key containers.
+		{
+			pNodeNew->mpNext  = pNodePrev->mpNext;
+			pNodePrev->mpNext = pNodeNew;
+		}
+
+		++mnElementCount;
+	}
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 	          typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <class M>
@@ -2789,7 +3432,7 @@ namespace eastl
 		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 		const size_type   nElementCountSaved = mnElementCount;
 
-		node_type** pBucketArray = mpBucketArray + n;
+		node_type** pBucketArray = DoGetBucket(has_incremental_rehash_type(), c, n);
 
 		while(*pBucketArray && !compare(k, c, *pBucketArray))
 			pBucketArray = &(*pBucketArray)->mpNext;
@@ -2818,10 +3461,49 @@ namespace eastl
 
 
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename KX, typename HX, typename EqX, ENABLE_IF_TRANSPARENT_LOOKUP(HX, EqX), typename>
+	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::size_type
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::erase(const KX& k)
+	{
+		const hash_code_t c = this->get_hash_code_as(k);
+		const size_type   n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		const size_type   nElementCountSaved = mnElementCount;
+
+		node_type** pBucketArray = DoGetBucket(has_incremental_rehash_type(), c, n);
+
+		while(*pBucketArray && !this->compare_as(k, c, *pBucketArray))
+			pBucketArray = &(*pBucketArray)->mpNext;
+
+		node_type* pDeleteList = nullptr;
+		while(*pBucketArray && this->compare_as(k, c, *pBucketArray))
+		{
+			node_type* const pNode = *pBucketArray;
+			*pBucketArray = pNode->mpNext;
+			// As with erase(const key_type&), k might view the key inside this node (e.g. a string_view), so defer freeing it.
+			pNode->mpNext = pDeleteList;
+			pDeleteList = pNode;
+			--mnElementCount;
+		}
+
+		while(pDeleteList)
+		{
+			node_type* const pToDelete = pDeleteList;
+			pDeleteList = pDeleteList->mpNext;
+			DoFreeNode(pToDelete);
+		}
+
+		return nElementCountSaved - mnElementCount;
+	}
+
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::clear()
 	{
+		DoRehashAbandon(has_incremental_rehash_type(), true);
 		DoFreeNodes(mpBucketArray, mnBucketCount);
 		mnElementCount = 0;
 	}
@@ -2832,6 +3514,7 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::clear(bool clearBuckets)
 	{
+		DoRehashAbandon(has_incremental_rehash_type(), true);
 		DoFreeNodes(mpBucketArray, mnBucketCount);
 		if(clearBuckets)
 		{
@@ -2862,6 +3545,7 @@ namespace eastl
 
 		mnElementCount = 0;
 		mRehashPolicy.mnNextResize = 0;
+		DoRehashAbandon(has_incremental_rehash_type(), false);
 	}
 
 
@@ -2887,7 +3571,17 @@ namespace eastl
 
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
-	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehash(size_type nNewBucketCount)
+	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehash(size_type nNewBucketCount)
+	{
+		DoRehash(has_incremental_rehash_type(), nNewBucketCount);
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename BoolConstantT>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehash(BoolConstantT, size_type nNewBucketCount, DISABLE_IF_TRUETYPE(BoolConstantT)) // false_type means the whole table is rehashed at once.
 	{
 		node_type** const pBucketArray = DoAllocateBuckets(nNewBucketCount); // nNewBucketCount should always be >= 2.
 
@@ -2929,6 +3623,187 @@ namespace eastl
 	}
 
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename BoolConstantT>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehash(BoolConstantT, size_type nNewBucketCount, ENABLE_IF_TRUETYPE(BoolConstantT)) // true_type means the table is rehashed incrementally.
+	{
+		// Only the bucket array is allocated here. The elements stay in the old bucket array
+		// and are moved by DoRehashStep. A rehash still in progress is finished first, which
+		// is normally a no-op, as the table must double in size before it rehashes again and
+		// every operation in the meantime moves some buckets.
+		DoRehashFinish(BoolConstantT());
+
+		node_type** const pBucketArray = DoAllocateBuckets(nNewBucketCount); // nNewBucketCount should always be >= 2.
+
+		if(mnElementCount)
+		{
+			this->mpOldBucketArray = (void**)mpBucketArray;
+			this->mnOldBucketCount = mnBucketCount;
+			this->mnOldBucketIndex = 0;
+			mpBucketArray[mnBucketCount] = (node_type*)((uintptr_t)pBucketArray | 1); // Iterators continue from the end of the old bucket array into the new one. See hashtable_iterator_base::increment_bucket.
+		}
+		else
+			DoFreeBuckets(mpBucketArray, mnBucketCount);
+
+		mnBucketCount = nNewBucketCount;
+		mpBucketArray = pBucketArray;
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename BoolConstantT>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehashStep(BoolConstantT, hash_code_t c, ENABLE_IF_TRUETYPE(BoolConstantT))
+	{
+		static_assert(is_same<H, default_ranged_hash>::value, "incremental_rehash_policy requires default_ranged_hash.");
+
+		if(this->mpOldBucketArray) // If a rehash is in progress...
+		{
+			// Move the old bucket that c maps to, so that the caller need only look in the new bucket
+			// array. Then move the next few old buckets in order, so that the rehash finishes in a
+			// bounded number of operations even if they all use the same keys.
+			DoRehashMoveBucket(BoolConstantT(), (size_type)bucket_index(c, (uint32_t)this->mnOldBucketCount));
+
+			const size_type nEnd = eastl::min_alt((size_type)(this->mnOldBucketIndex + mRehashPolicy.mnStepBucketCount), (size_type)this->mnOldBucketCount);
+
+			for(; this->mnOldBucketIndex < nEnd; ++this->mnOldBucketIndex)
+				DoRehashMoveBucket(BoolConstantT(), (size_type)this->mnOldBucketIndex);
+
+			if(this->mnOldBucketIndex == this->mnOldBucketCount) // If every old bucket is now empty...
+			{
+				DoFreeBuckets((node_type**)this->mpOldBucketArray, (size_type)this->mnOldBucketCount);
+				DoRehashAbandon(BoolConstantT(), false);
+			}
+		}
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename BoolConstantT>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehashFinish(BoolConstantT, ENABLE_IF_TRUETYPE(BoolConstantT))
+	{
+		if(this->mpOldBucketArray)
+		{
+			for(; this->mnOldBucketIndex < this->mnOldBucketCount; ++this->mnOldBucketIndex)
+				DoRehashMoveBucket(BoolConstantT(), (size_type)this->mnOldBucketIndex);
+
+			DoFreeBuckets((node_type**)this->mpOldBucketArray, (size_type)this->mnOldBucketCount);
+			DoRehashAbandon(BoolConstantT(), false);
+		}
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename BoolConstantT>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::node_type**
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoGetBucket(BoolConstantT, hash_code_t c, size_type n, ENABLE_IF_TRUETYPE(BoolConstantT)) const
+	{
+		// Old buckets gain no elements once a rehash starts, and an insert moves the old bucket for
+		// its hash code before it links a node into the new bucket array. So a non-empty old bucket
+		// means that the elements with hash code c, if any, are all still in it.
+		if(this->mpOldBucketArray)
+		{
+			node_type** const pOldBucket = (node_type**)this->mpOldBucketArray + bucket_index(c, (uint32_t)this->mnOldBucketCount);
+
+			if(*pOldBucket)
+				return pOldBucket;
+		}
+
+		return mpBucketArray + n;
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename BoolConstantT>
+	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehashMoveBucket(BoolConstantT, size_type nOldBucketIndex, ENABLE_IF_TRUETYPE(BoolConstantT))
+	{
+		// Elements are moved one at a time, so if the hash function throws, every element is
+		// still in either its old or its new bucket. Equal elements are adjacent in the old
+		// bucket, so they remain adjacent in the new bucket.
+		node_type** const pOldBucketArray = (node_type**)this->mpOldBucketArray;
+		node_type* pNode;
+
+		while((pNode = pOldBucketArray[nOldBucketIndex]) != NULL) // Using '!=' disables compiler warnings.
+		{
+			const size_type nNewBucketIndex = (size_type)bucket_index(pNode, (uint32_t)mnBucketCount);
+
+			pOldBucketArray[nOldBucketIndex] = pNode->mpNext;
+			pNode->mpNext = mpBucketArray[nNewBucketIndex];
+			mpBucketArray[nNewBucketIndex] = pNode;
+		}
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename BoolConstantT>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoCopyOldBuckets(BoolConstantT, const this_type& x, ENABLE_IF_TRUETYPE(BoolConstantT))
+	{
+		// Used by the copy constructor, after it has copied x's current buckets. The elements
+		// in a rehash still in progress in x are copied straight into their new buckets, so the
+		// copy starts with no rehash in progress and x is left untouched.
+		if(x.mpOldBucketArray)
+		{
+			node_type* const* const pOldBucketArray = (node_type* const*)x.mpOldBucketArray;
+
+			for(size_type i = 0; i < (size_type)x.mnOldBucketCount; ++i)
+			{
+				for(const node_type* pNodeSource = pOldBucketArray[i]; pNodeSource; pNodeSource = pNodeSource->mpNext)
+				{
+					const size_type  n        = (size_type)bucket_index(pNodeSource, (uint32_t)mnBucketCount);
+					node_type* const pNodeNew = DoAllocateNode(pNodeSource->mValue);
+
+					copy_code(pNodeNew, pNodeSource);
+					pNodeNew->mpNext = mpBucketArray[n];
+					mpBucketArray[n] = pNodeNew;
+				}
+			}
+		}
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename BoolConstantT>
+	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehashAbandon(BoolConstantT, bool bFreeMemory, ENABLE_IF_TRUETYPE(BoolConstantT))
+	{
+		// Forgets the old bucket array. If bFreeMemory is true, any elements left in it are destroyed
+		// and the array is freed. The caller is responsible for mnElementCount.
+		if(this->mpOldBucketArray && bFreeMemory)
+		{
+			DoFreeNodes((node_type**)this->mpOldBucketArray, (size_type)this->mnOldBucketCount);
+			DoFreeBuckets((node_type**)this->mpOldBucketArray, (size_type)this->mnOldBucketCount);
+		}
+
+		this->mpOldBucketArray = NULL;
+		this->mnOldBucketCount = 0;
+		this->mnOldBucketIndex = 0;
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename BoolConstantT>
+	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehashSwap(BoolConstantT, this_type& x, ENABLE_IF_TRUETYPE(BoolConstantT))
+	{
+		eastl::swap(this->mpOldBucketArray, x.mpOldBucketArray);
+		eastl::swap(this->mnOldBucketCount, x.mnOldBucketCount);
+		eastl::swap(this->mnOldBucketIndex, x.mnOldBucketIndex);
+	}
+
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	inline bool hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::validate() const
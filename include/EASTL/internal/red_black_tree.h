@@ -94,6 +94,9 @@ namespace eastl
 		this_type* mpNodeLeft;
 		this_type* mpNodeParent;
 		char       mColor;       // We only need one bit here, would be nice if we could stuff that bit somewhere else.
+	#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+		size_t     mnSubtreeSize; // Count of nodes in the subtree rooted at this node, including this node. Unused in the anchor node.
+	#endif
 	};
 
 
@@ -135,6 +138,12 @@ namespace eastl
 	EASTL_API void              RBTreeErase        (      rbtree_node_base* pNode,
 														  rbtree_node_base* pNodeAnchor); 
 
+	#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+		EASTL_API rbtree_node_base* RBTreeSelect   (const rbtree_node_base* pNodeAnchor, size_t n);
+		EASTL_API size_t            RBTreeRank     (const rbtree_node_base* pNode,
+													const rbtree_node_base* pNodeAnchor);
+	#endif
+
 
 
 
@@ -606,6 +615,17 @@ namespace eastl
 		// template<typename K>
 		// const_iterator upper_bound(const K& key) const;
 
+	#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+		/// Returns the element at sorted position n, the same as eastl::next(begin(), n),
+		/// but in O(log n) time. Returns end() if n >= size().
+		iterator       nth(size_type n);
+		const_iterator nth(size_type n) const;
+
+		/// Returns the sorted position of the element i refers to, the same as
+		/// eastl::distance(begin(), i), but in O(log n) time. rank(end()) is size().
+		size_type      rank(const_iterator i) const;
+	#endif
+
 		bool validate() const;
 		int  validate_iterator(const_iterator i) const;
 
@@ -2015,6 +2035,34 @@ namespace eastl
 	}
 
 
+	#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+		template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+		inline typename rbtree<K, V, C, A, E, bM, bU>::iterator
+		rbtree<K, V, C, A, E, bM, bU>::nth(size_type n)
+		{
+			return iterator(RBTreeSelect(&mAnchor, (size_t)n));
+		}
+
+
+		template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+		inline typename rbtree<K, V, C, A, E, bM, bU>::const_iterator
+		rbtree<K, V, C, A, E, bM, bU>::nth(size_type n) const
+		{
+			return const_iterator(RBTreeSelect(&mAnchor, (size_t)n));
+		}
+
+
+		template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+		inline typename rbtree<K, V, C, A, E, bM, bU>::size_type
+		rbtree<K, V, C, A, E, bM, bU>::rank(const_iterator i) const
+		{
+			if(i.mpNode == &mAnchor)
+				return mnSize;
+			return (size_type)RBTreeRank(i.mpNode, &mAnchor);
+		}
+	#endif
+
+
 	// To do: Move this validate function entirely to a template-less implementation.
 	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
 	bool rbtree<K, V, C, A, E, bM, bU>::validate() const
@@ -2028,6 +2076,7 @@ namespace eastl
 		//   5 The mnSize member of the tree must equal the number of nodes in the tree.
 		//   6 The tree is sorted as per a conventional binary tree.
 		//   7 The comparison function is sane; it obeys strict weak ordering. If compare(a,b) is true, then compare(b,a) must be false. Both cannot be true.
+		//   8 If EASTL_RBTREE_ORDER_STATISTICS_ENABLED, each node's mnSubtreeSize equals the sum of its children's plus one.
 
 		extract_key extractKey;
 
@@ -2085,6 +2134,12 @@ namespace eastl
 					if(RBTreeGetBlackCount(mAnchor.mpNodeParent, pNode) != nBlackCount)
 						return false;
 				}
+
+				#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+					// Verify item #8 above.
+					if(pNode->mnSubtreeSize != ((pNodeLeft ? pNodeLeft->mnSubtreeSize : 0) + (pNodeRight ? pNodeRight->mnSubtreeSize : 0) + 1))
+						return false;
+				#endif
 			}
 
 			// Verify item #5 above.
@@ -2288,6 +2343,9 @@ namespace eastl
 		pNode->mpNodeLeft   = NULL;
 		pNode->mpNodeParent = pNodeParent;
 		pNode->mColor       = pNodeSource->mColor;
+	#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+		pNode->mnSubtreeSize = pNodeSource->mnSubtreeSize;
+	#endif
 
 		return pNode;
 	}
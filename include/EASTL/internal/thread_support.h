@@ -26,9 +26,14 @@
 #if EASTL_CPP11_MUTEX_ENABLED
 	EA_DISABLE_ALL_VC_WARNINGS()
 	#include <mutex>
+	#include <thread>
 	EA_RESTORE_ALL_VC_WARNINGS()
 #endif
 
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <atomic>
+EA_RESTORE_ALL_VC_WARNINGS()
+
 #if defined(EA_PLATFORM_MICROSOFT)
 	// Cannot include Windows headers in our headers, as they kill builds with their #defines.
 #elif defined(EA_PLATFORM_POSIX)
@@ -61,6 +66,11 @@ EA_DISABLE_VC_WARNING(4625 4626 4275);
 		extern "C" long _InterlockedCompareExchange(long volatile* Dest, long Exchange, long Comp);
 		#pragma intrinsic (_InterlockedCompareExchange)
 	#endif
+
+	#if defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64)
+		extern "C" void _mm_pause(void);
+		#pragma intrinsic (_mm_pause)
+	#endif
 #endif
 
 
@@ -134,6 +144,153 @@ namespace eastl
 		};
 
 
+		// cpu_pause
+		//
+		// Tells the processor that the caller is in a spin-wait loop. This reduces the
+		// power use of the loop and the cost of leaving it, and on hyper-threaded cores
+		// gives the other hardware thread more of the core.
+		EA_FORCE_INLINE void cpu_pause()
+		{
+			#if defined(EA_PLATFORM_MICROSOFT) && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+				_mm_pause();
+			#elif (defined(__GNUC__) || defined(__clang__)) && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+				__builtin_ia32_pause();
+			#elif (defined(__GNUC__) || defined(__clang__)) && (defined(EA_PROCESSOR_ARM32) || defined(EA_PROCESSOR_ARM64))
+				__asm__ __volatile__("yield");
+			#endif
+		}
+
+
+		// rw_spinlock
+		//
+		// A reader/writer spinlock which is one 32 bit word in size. Any number of readers
+		// may hold the lock at once, or else one writer. The lock prefers writers: once a
+		// writer has claimed the lock, new readers wait until it is released, so a steady
+		// stream of readers can't starve a writer.
+		//
+		// This is intended for guarding short critical sections, such as a single lookup
+		// in a hash table. Waiters spin for a while and then yield their time slice, so a
+		// lock which is held while its owner is descheduled doesn't burn a whole quantum.
+		// The lock is not recursive, and a reader can't upgrade to a writer.
+		//
+		class rw_spinlock
+		{
+		public:
+			rw_spinlock() EA_NOEXCEPT : mState(0) {}
+
+			rw_spinlock(const rw_spinlock&) = delete;
+			void operator=(const rw_spinlock&) = delete;
+
+			bool try_lock() EA_NOEXCEPT
+			{
+				uint32_t state = 0;
+				return mState.compare_exchange_strong(state, kWriterBit, std::memory_order_acquire, std::memory_order_relaxed);
+			}
+
+			void lock() EA_NOEXCEPT
+			{
+				// Claim the writer bit, which stops new readers from entering, then wait for
+				// the existing readers to leave.
+				for(uint32_t nSpinCount = 0; ; Backoff(nSpinCount))
+				{
+					uint32_t state = mState.load(std::memory_order_relaxed);
+
+					if(!(state & kWriterBit) && mState.compare_exchange_weak(state, state | kWriterBit, std::memory_order_acquire, std::memory_order_relaxed))
+						break;
+				}
+
+				for(uint32_t nSpinCount = 0; mState.load(std::memory_order_acquire) != kWriterBit; Backoff(nSpinCount))
+					{ }
+			}
+
+			void unlock() EA_NOEXCEPT
+			{
+				EASTL_ASSERT(mState.load(std::memory_order_relaxed) == kWriterBit);
+				mState.store(0, std::memory_order_release);
+			}
+
+			bool try_lock_shared() EA_NOEXCEPT
+			{
+				uint32_t state = mState.load(std::memory_order_relaxed);
+				return !(state & kWriterBit) && mState.compare_exchange_strong(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed);
+			}
+
+			void lock_shared() EA_NOEXCEPT
+			{
+				for(uint32_t nSpinCount = 0; !try_lock_shared(); Backoff(nSpinCount))
+					{ }
+			}
+
+			void unlock_shared() EA_NOEXCEPT
+			{
+				EASTL_ASSERT((mState.load(std::memory_order_relaxed) & ~kWriterBit) != 0);
+				mState.fetch_sub(1, std::memory_order_release);
+			}
+
+		protected:
+			static const uint32_t kWriterBit     = UINT32_C(0x80000000);
+			static const uint32_t kSpinsPerYield = 64;
+
+			static void Backoff(uint32_t& nSpinCount) EA_NOEXCEPT
+			{
+				#if EASTL_CPP11_MUTEX_ENABLED
+					if(++nSpinCount >= kSpinsPerYield)
+					{
+						nSpinCount = 0;
+						std::this_thread::yield();
+						return;
+					}
+				#else
+					EA_UNUSED(nSpinCount);
+				#endif
+
+				cpu_pause();
+			}
+
+			std::atomic<uint32_t> mState; // The high bit is set while a writer owns or is waiting for the lock. The other bits count the readers.
+		};
+
+
+		// auto_rw_spinlock
+		//
+		// Holds a rw_spinlock for writing for the lifetime of the object.
+		class auto_rw_spinlock
+		{
+		public:
+			EA_FORCE_INLINE auto_rw_spinlock(rw_spinlock& lock) : pLock(&lock)
+				{ pLock->lock(); }
+
+			EA_FORCE_INLINE ~auto_rw_spinlock()
+				{ pLock->unlock(); }
+
+		protected:
+			rw_spinlock* pLock;
+
+			auto_rw_spinlock(const auto_rw_spinlock&) = delete;
+			void operator=(const auto_rw_spinlock&) = delete;
+		};
+
+
+		// auto_rw_spinlock_shared
+		//
+		// Holds a rw_spinlock for reading for the lifetime of the object.
+		class auto_rw_spinlock_shared
+		{
+		public:
+			EA_FORCE_INLINE auto_rw_spinlock_shared(rw_spinlock& lock) : pLock(&lock)
+				{ pLock->lock_shared(); }
+
+			EA_FORCE_INLINE ~auto_rw_spinlock_shared()
+				{ pLock->unlock_shared(); }
+
+		protected:
+			rw_spinlock* pLock;
+
+			auto_rw_spinlock_shared(const auto_rw_spinlock_shared&) = delete;
+			void operator=(const auto_rw_spinlock_shared&) = delete;
+		};
+
+
 		// shared_ptr_auto_mutex
 		class EASTL_API shared_ptr_auto_mutex : public auto_mutex
 		{
@@ -145,6 +302,53 @@ namespace eastl
 		};
 
 
+		// shared_ptr_hazard
+		//
+		// A hazard pointer, as used by atomic_shared_ptr. A reader protects an object by
+		// publishing its address in the hazard slot of its thread and then checking that
+		// the object is still the current one. A writer which has replaced the object
+		// calls wait_until_unprotected before freeing it, which returns once no reader
+		// has it published. Neither side takes a lock.
+		//
+		// Each thread has one slot, which it keeps until it exits, so a thread can have
+		// only one shared_ptr_hazard at a time.
+		//
+		class EASTL_API shared_ptr_hazard
+		{
+		public:
+			shared_ptr_hazard();
+		   ~shared_ptr_hazard();
+
+			// Returns the current value of source, which is protected until this object is
+			// destroyed or protect is called again.
+			template <typename T>
+			T* protect(const std::atomic<T*>& source) EA_NOEXCEPT
+			{
+				T* p = source.load(std::memory_order_seq_cst);
+
+				for(;;)
+				{
+					mpSlot->store(p, std::memory_order_seq_cst);
+
+					// If source still holds p after p was published, then any thread which
+					// replaces p from now on will see it in the slot before freeing it.
+					T* const pCurrent = source.load(std::memory_order_seq_cst);
+					if(pCurrent == p)
+						return p;
+					p = pCurrent;
+				}
+			}
+
+			static void wait_until_unprotected(const void* p) EA_NOEXCEPT;
+
+			shared_ptr_hazard(const shared_ptr_hazard&) = delete;
+			void operator=(const shared_ptr_hazard&) = delete;
+
+		protected:
+			std::atomic<const void*>* mpSlot;
+		};
+
+
 	} // namespace Internal
 
 } // namespace eastl
@@ -1895,6 +1895,53 @@ EASTL_INTERNAL_RESTORE_DEPRECATED()
 
 
 
+	///////////////////////////////////////////////////////////////////////
+	// is_trivially_relocatable
+	//
+	// This is an EA extension to the type traits standard, along the lines
+	// of the C++ trivial relocation proposals (P1144).
+	//
+	// A trivially relocatable type is one whose objects can be moved to new
+	// storage with memcpy, after which the old storage is simply treated as
+	// uninitialized and no destructor is run for it. Every trivially
+	// copyable type is trivially relocatable, but so are many types whose
+	// move constructor and destructor are not trivial, such as eastl::string,
+	// eastl::vector and eastl::unique_ptr, because they never hold pointers
+	// into themselves. uninitialized_relocate and the container reallocation
+	// paths use this trait to replace element-wise move-and-destroy with
+	// a single memcpy.
+	//
+	// The default is true for types that are both trivially move constructible
+	// and trivially destructible. A type that holds pointers to itself (or 
+	// registers its address elsewhere) must never be declared relocatable.
+	// The user can use EASTL_DECLARE_TRIVIALLY_RELOCATABLE or a specialization 
+	// of this trait to opt a type in:
+	//
+	//     EASTL_DECLARE_TRIVIALLY_RELOCATABLE(Widget) // At global namespace scope.
+	//
+	//     template <typename T, typename Allocator>
+	//     struct eastl::is_trivially_relocatable<MyArray<T, Allocator>> : public eastl::is_trivially_relocatable<Allocator> {};
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	struct is_trivially_relocatable
+		: public integral_constant<bool, eastl::is_trivially_move_constructible<typename eastl::remove_all_extents<T>::type>::value && 
+										 eastl::is_trivially_destructible<T>::value && !eastl::is_volatile<T>::value> {};
+
+	// Const objects relocate the same way as non-const ones, so specializations only need to name the unqualified type.
+	template <typename T>
+	struct is_trivially_relocatable<const T> : public eastl::is_trivially_relocatable<T> {};
+
+	#define EASTL_DECLARE_TRIVIALLY_RELOCATABLE(T) \
+		namespace eastl{ template <> struct is_trivially_relocatable<T> : public eastl::true_type{}; }
+
+	#if EASTL_VARIABLE_TEMPLATES_ENABLED
+		template <class T>
+		EA_CONSTEXPR bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+    #endif
+
+
+
 
 	///////////////////////////////////////////////////////////////////////
 	// is_nothrow_destructible
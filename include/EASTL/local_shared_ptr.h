@@ -0,0 +1,1008 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements local_shared_ptr, local_weak_ptr and
+// enable_local_shared_from_this. They have the same interface as shared_ptr,
+// weak_ptr and enable_shared_from_this, but their reference counts are plain
+// integers instead of atomics. Copying and destroying a local_shared_ptr is
+// thus an ordinary increment or decrement instead of a locked instruction.
+//
+// The price is that every local_shared_ptr and local_weak_ptr which shares
+// ownership of an object must be used from one thread only. This fits code
+// which is single-threaded by design, such as a simulation shard which owns
+// all of its objects. Handing a local_shared_ptr to another thread, even
+// just to copy or destroy it there, is a data race on the reference count.
+//
+// Example usage:
+//     local_shared_ptr<Widget> pWidget = make_local_shared<Widget>(17);
+//     local_shared_ptr<Widget> pWidget2 = pWidget;   // No atomic operation.
+//     local_weak_ptr<Widget>   pWeak(pWidget);
+//
+// local_shared_ptr and shared_ptr can't be converted to each other, as they
+// keep their reference counts differently.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/shared_ptr.h>
+
+
+namespace eastl
+{
+	/// EASTL_LOCAL_SHARED_PTR_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_LOCAL_SHARED_PTR_DEFAULT_NAME
+		#define EASTL_LOCAL_SHARED_PTR_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " local_shared_ptr" // Unless the user overrides something, this is "EASTL local_shared_ptr".
+	#endif
+
+
+	/// EASTL_LOCAL_SHARED_PTR_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_LOCAL_SHARED_PTR_DEFAULT_ALLOCATOR
+		#define EASTL_LOCAL_SHARED_PTR_DEFAULT_ALLOCATOR EASTLAllocatorType(EASTL_LOCAL_SHARED_PTR_DEFAULT_NAME)
+	#endif
+
+
+	// Forward declarations
+	template <typename T> class local_shared_ptr;
+	template <typename T> class local_weak_ptr;
+	template <typename T> class enable_local_shared_from_this;
+
+
+
+	/// ref_count_lsp
+	///
+	/// The reference count used by local_shared_ptr and local_weak_ptr. It has the same
+	/// interface as ref_count_sp, and so can be used as the RefCountBase of ref_count_sp_t
+	/// and ref_count_sp_t_inst, but its counts are not atomic.
+	struct ref_count_lsp
+	{
+		int32_t mRefCount;            /// Reference count on the contained pointer. Starts as 1 by default.
+		int32_t mWeakRefCount;        /// Reference count on contained pointer plus this ref_count_lsp object itself. Starts as 1 by default.
+
+	public:
+		ref_count_lsp(int32_t refCount = 1, int32_t weakRefCount = 1) EA_NOEXCEPT
+			: mRefCount(refCount), mWeakRefCount(weakRefCount) {}
+
+		virtual ~ref_count_lsp() EA_NOEXCEPT {}
+
+		int32_t use_count() const EA_NOEXCEPT
+		{
+			return mRefCount;
+		}
+
+		void addref() EA_NOEXCEPT
+		{
+			++mRefCount;
+			++mWeakRefCount;
+		}
+
+		void release()
+		{
+			EASTL_ASSERT(mRefCount > 0);
+			if(--mRefCount == 0)
+				free_value();
+
+			weak_release();
+		}
+
+		void weak_addref() EA_NOEXCEPT
+		{
+			++mWeakRefCount;
+		}
+
+		void weak_release()
+		{
+			EASTL_ASSERT(mWeakRefCount > 0);
+			if(--mWeakRefCount == 0)
+				free_ref_count_sp();
+		}
+
+		ref_count_lsp* lock() EA_NOEXCEPT
+		{
+			if(mRefCount == 0)
+				return nullptr;
+
+			addref();
+			return this;
+		}
+
+		virtual void free_value() EA_NOEXCEPT = 0;          // Release the contained object.
+		virtual void free_ref_count_sp() EA_NOEXCEPT = 0;   // Release this instance.
+
+		#if EASTL_RTTI_ENABLED
+			virtual void* get_deleter(const std::type_info& type) const EA_NOEXCEPT = 0;
+		#else
+			virtual void* get_deleter() const EA_NOEXCEPT = 0;
+		#endif
+	};
+
+
+	/// do_enable_local_shared_from_this
+	///
+	/// The local_shared_ptr counterpart of do_enable_shared_from_this.
+	///
+	template <typename T, typename U>
+	void do_enable_local_shared_from_this(const ref_count_lsp* pRefCount,
+	                                      const enable_local_shared_from_this<T>* pEnableSharedFromThis,
+	                                      const U* pValue)
+	{
+		if (pEnableSharedFromThis)
+			pEnableSharedFromThis->mWeakPtr.assign(const_cast<U*>(pValue), const_cast<ref_count_lsp*>(pRefCount));
+	}
+
+	inline void do_enable_local_shared_from_this(const ref_count_lsp*, ...) {} // Empty specialization. This no-op version is
+	                                                                          // called by local_shared_ptr when its T type is
+	                                                                          // anything but an enable_local_shared_from_this class.
+
+
+
+	/// local_shared_ptr
+	///
+	/// A shared_ptr whose reference count is not atomic. See the top of this file for when
+	/// that is safe. Apart from that, it behaves like shared_ptr and the shared_ptr
+	/// documentation applies to it.
+	///
+	template <typename T>
+	class local_shared_ptr
+	{
+	public:
+		typedef local_shared_ptr<T>                              this_type;
+		typedef T                                                element_type;
+		typedef typename shared_ptr_traits<T>::reference_type    reference_type;
+		typedef EASTLAllocatorType                               default_allocator_type;
+		typedef default_delete<T>                                default_deleter_type;
+		typedef local_weak_ptr<T>                                weak_type;
+
+	protected:
+		element_type*   mpValue;
+		ref_count_lsp*  mpRefCount;           /// Base pointer to Reference count for owned pointer and the owned pointer.
+
+	public:
+		/// Initializes an empty local_shared_ptr.
+		/// Postcondition: use_count() == zero and get() == 0
+		local_shared_ptr() EA_NOEXCEPT
+			: mpValue(nullptr), mpRefCount(nullptr) {}
+
+		local_shared_ptr(std::nullptr_t) EA_NOEXCEPT
+			: mpValue(nullptr), mpRefCount(nullptr) {}
+
+		/// Takes ownership of the pointer, which will be deleted with default_delete<U>.
+		/// The reference count is allocated with the default EASTL allocator.
+		template <typename U>
+		explicit local_shared_ptr(U* pValue,
+		                          typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0)
+			: mpValue(nullptr), mpRefCount(nullptr) // alloc_internal will set this.
+		{
+			alloc_internal(pValue, default_allocator_type(), default_delete<U>());
+		}
+
+		/// Takes ownership of the pointer, which will be disposed using the provided deleter.
+		template <typename U, typename Deleter>
+		local_shared_ptr(U* pValue,
+		                 Deleter deleter,
+		                 typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0)
+			: mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(pValue, default_allocator_type(), eastl::move(deleter));
+		}
+
+		template <typename Deleter>
+		local_shared_ptr(std::nullptr_t, Deleter deleter)
+			: mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(nullptr, default_allocator_type(), eastl::move(deleter));
+		}
+
+		/// Takes ownership of the pointer, which will be disposed using the provided deleter.
+		/// The reference count is allocated with the provided allocator.
+		template <typename U, typename Deleter, typename Allocator>
+		explicit local_shared_ptr(U* pValue,
+		                          Deleter deleter,
+		                          const Allocator& allocator,
+		                          typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0)
+			: mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(pValue, allocator, eastl::move(deleter));
+		}
+
+		template <typename Deleter, typename Allocator>
+		local_shared_ptr(std::nullptr_t, Deleter deleter, Allocator allocator)
+			: mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(nullptr, eastl::move(allocator), eastl::move(deleter));
+		}
+
+		local_shared_ptr(const local_shared_ptr& sharedPtr) EA_NOEXCEPT
+			: mpValue(sharedPtr.mpValue), mpRefCount(sharedPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->addref();
+		}
+
+		template <typename U>
+		local_shared_ptr(const local_shared_ptr<U>& sharedPtr,
+		                 typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+			: mpValue(sharedPtr.mpValue), mpRefCount(sharedPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->addref();
+		}
+
+		/// Aliasing constructor. Stores pValue and shares ownership with sharedPtr.
+		template <typename U>
+		local_shared_ptr(const local_shared_ptr<U>& sharedPtr, element_type* pValue) EA_NOEXCEPT
+			: mpValue(pValue), mpRefCount(sharedPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->addref();
+		}
+
+		local_shared_ptr(local_shared_ptr&& sharedPtr) EA_NOEXCEPT
+			: mpValue(sharedPtr.mpValue), mpRefCount(sharedPtr.mpRefCount)
+		{
+			sharedPtr.mpValue = nullptr;
+			sharedPtr.mpRefCount = nullptr;
+		}
+
+		template <typename U>
+		local_shared_ptr(local_shared_ptr<U>&& sharedPtr,
+		                 typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+			: mpValue(sharedPtr.mpValue), mpRefCount(sharedPtr.mpRefCount)
+		{
+			sharedPtr.mpValue = nullptr;
+			sharedPtr.mpRefCount = nullptr;
+		}
+
+		template <typename U, typename Deleter>
+		local_shared_ptr(unique_ptr<U, Deleter>&& uniquePtr,
+		                 typename eastl::enable_if<!eastl::is_array<U>::value && !is_lvalue_reference<Deleter>::value &&
+		                                           eastl::is_convertible<U*, element_type*>::value>::type* = 0)
+			: mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(uniquePtr.release(), default_allocator_type(), uniquePtr.get_deleter());
+		}
+
+		template <typename U, typename Deleter, typename Allocator>
+		local_shared_ptr(unique_ptr<U, Deleter>&& uniquePtr,
+		                 const Allocator& allocator,
+		                 typename eastl::enable_if<!eastl::is_array<U>::value && !is_lvalue_reference<Deleter>::value &&
+		                                           eastl::is_convertible<U*, element_type*>::value>::type* = 0)
+			: mpValue(nullptr), mpRefCount(nullptr)
+		{
+			alloc_internal(uniquePtr.release(), allocator, uniquePtr.get_deleter());
+		}
+
+		/// Shares ownership with weakPtr. Throws bad_weak_ptr if weakPtr has expired.
+		template <typename U>
+		explicit local_shared_ptr(const local_weak_ptr<U>& weakPtr,
+		                          typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0)
+			: mpValue(weakPtr.mpValue),
+			  mpRefCount(weakPtr.mpRefCount ? weakPtr.mpRefCount->lock() : weakPtr.mpRefCount) // mpRefCount->lock() addref's the return value for us.
+		{
+			if(!mpRefCount)
+			{
+				mpValue = nullptr;
+
+				#if EASTL_EXCEPTIONS_ENABLED
+					throw eastl::bad_weak_ptr();
+				#else
+					EASTL_FAIL_MSG("eastl::local_shared_ptr -- bad_weak_ptr");
+				#endif
+			}
+		}
+
+		~local_shared_ptr()
+		{
+			if(mpRefCount)
+				mpRefCount->release();
+		}
+
+		this_type& operator=(const local_shared_ptr& sharedPtr) EA_NOEXCEPT
+		{
+			if(&sharedPtr != this)
+				this_type(sharedPtr).swap(*this);
+			return *this;
+		}
+
+		template <typename U>
+		typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+		{
+			if(!equivalent_ownership(sharedPtr))
+				this_type(sharedPtr).swap(*this);
+			return *this;
+		}
+
+		this_type& operator=(local_shared_ptr&& sharedPtr) EA_NOEXCEPT
+		{
+			if(&sharedPtr != this)
+				this_type(eastl::move(sharedPtr)).swap(*this);
+			return *this;
+		}
+
+		template <typename U>
+		typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(local_shared_ptr<U>&& sharedPtr) EA_NOEXCEPT
+		{
+			if(!equivalent_ownership(sharedPtr))
+				this_type(eastl::move(sharedPtr)).swap(*this);
+			return *this;
+		}
+
+		template <typename U, typename Deleter>
+		typename eastl::enable_if<!eastl::is_array<U>::value && eastl::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(unique_ptr<U, Deleter>&& uniquePtr)
+		{
+			this_type(eastl::move(uniquePtr)).swap(*this);
+			return *this;
+		}
+
+		void reset() EA_NOEXCEPT
+		{
+			this_type().swap(*this);
+		}
+
+		template <typename U>
+		typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value, void>::type
+		reset(U* pValue)
+		{
+			this_type(pValue).swap(*this);
+		}
+
+		template <typename U, typename Deleter>
+		typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value, void>::type
+		reset(U* pValue, Deleter deleter)
+		{
+			this_type(pValue, deleter).swap(*this);
+		}
+
+		template <typename U, typename Deleter, typename Allocator>
+		typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value, void>::type
+		reset(U* pValue, Deleter deleter, const Allocator& allocator)
+		{
+			this_type(pValue, deleter, allocator).swap(*this);
+		}
+
+		void swap(this_type& sharedPtr) EA_NOEXCEPT
+		{
+			element_type* const pValue = sharedPtr.mpValue;
+			sharedPtr.mpValue = mpValue;
+			mpValue           = pValue;
+
+			ref_count_lsp* const pRefCount = sharedPtr.mpRefCount;
+			sharedPtr.mpRefCount = mpRefCount;
+			mpRefCount           = pRefCount;
+		}
+
+		reference_type operator*() const EA_NOEXCEPT
+		{
+			return *mpValue;
+		}
+
+		element_type* operator->() const EA_NOEXCEPT
+		{
+			return mpValue;
+		}
+
+		element_type* get() const EA_NOEXCEPT
+		{
+			return mpValue;
+		}
+
+		int use_count() const EA_NOEXCEPT
+		{
+			return mpRefCount ? mpRefCount->use_count() : 0;
+		}
+
+		bool unique() const EA_NOEXCEPT
+		{
+			return (mpRefCount && (mpRefCount->use_count() == 1));
+		}
+
+		template <typename U>
+		bool owner_before(const local_shared_ptr<U>& sharedPtr) const EA_NOEXCEPT
+		{
+			return (mpRefCount < sharedPtr.mpRefCount);
+		}
+
+		template <typename U>
+		bool owner_before(const local_weak_ptr<U>& weakPtr) const EA_NOEXCEPT
+		{
+			return (mpRefCount < weakPtr.mpRefCount);
+		}
+
+		template <typename Deleter>
+		Deleter* get_deleter() const EA_NOEXCEPT
+		{
+			#if EASTL_RTTI_ENABLED
+				return mpRefCount ? static_cast<Deleter*>(mpRefCount->get_deleter(typeid(typename remove_cv<Deleter>::type))) : nullptr;
+			#else
+				return nullptr; // See shared_ptr::get_deleter.
+			#endif
+		}
+
+		#ifdef EA_COMPILER_NO_EXPLICIT_CONVERSION_OPERATORS
+			typedef T* (this_type::*bool_)() const;
+			operator bool_() const EA_NOEXCEPT
+			{
+				if(mpValue)
+					return &this_type::get;
+				return nullptr;
+			}
+
+			bool operator!() const EA_NOEXCEPT
+			{
+				return (mpValue == nullptr);
+			}
+		#else
+			explicit operator bool() const EA_NOEXCEPT
+			{
+				return (mpValue != nullptr);
+			}
+		#endif
+
+		/// Returns true if the given local_shared_ptr owns the same T pointer that we do.
+		template <typename U>
+		bool equivalent_ownership(const local_shared_ptr<U>& sharedPtr) const
+		{
+			return (mpRefCount == sharedPtr.mpRefCount);
+		}
+
+	protected:
+		// Friend declarations.
+		template <typename U> friend class local_shared_ptr;
+		template <typename U> friend class local_weak_ptr;
+		template <typename U> friend void allocate_local_shared_helper(local_shared_ptr<U>&, ref_count_lsp*, U*);
+
+		// Handles the allocating of mpRefCount, while assigning mpValue.
+		// The provided pValue may be NULL, as with constructing with a deleter and allocator but NULL pointer.
+		template <typename U, typename Allocator, typename Deleter>
+		void alloc_internal(U pValue, Allocator allocator, Deleter deleter)
+		{
+			typedef ref_count_sp_t<U, Allocator, Deleter, ref_count_lsp> ref_count_type;
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+					void* const pMemory = EASTLAlloc(allocator, sizeof(ref_count_type));
+					if(!pMemory)
+						throw std::bad_alloc();
+					mpRefCount = ::new(pMemory) ref_count_type(pValue, eastl::move(deleter), eastl::move(allocator));
+					mpValue = pValue;
+					do_enable_local_shared_from_this(mpRefCount, pValue, pValue);
+				}
+				catch(...)
+				{
+					deleter(pValue);
+					throw;
+				}
+			#else
+				void* const pMemory = EASTLAlloc(allocator, sizeof(ref_count_type));
+				if(pMemory)
+				{
+					mpRefCount = ::new(pMemory) ref_count_type(pValue, eastl::move(deleter), eastl::move(allocator));
+					mpValue = pValue;
+					do_enable_local_shared_from_this(mpRefCount, pValue, pValue);
+				}
+				else
+					deleter(pValue);
+			#endif
+		}
+
+	}; // class local_shared_ptr
+
+
+	template <typename T>
+	struct is_trivially_relocatable<local_shared_ptr<T>> : public true_type {};
+
+
+	template <typename T>
+	inline typename local_shared_ptr<T>::element_type* get_pointer(const local_shared_ptr<T>& sharedPtr) EA_NOEXCEPT
+	{
+		return sharedPtr.get();
+	}
+
+	template <typename Deleter, typename T>
+	Deleter* get_deleter(const local_shared_ptr<T>& sharedPtr) EA_NOEXCEPT
+	{
+		return sharedPtr.template get_deleter<Deleter>();
+	}
+
+	template <typename T>
+	inline void swap(local_shared_ptr<T>& a, local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		a.swap(b);
+	}
+
+
+	/// local_shared_ptr comparison operators
+	template <typename T, typename U>
+	inline bool operator==(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return (a.get() == b.get());
+	}
+
+	template <typename T>
+	inline bool operator==(const local_shared_ptr<T>& a, std::nullptr_t) EA_NOEXCEPT
+	{
+		return !a;
+	}
+
+#if defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	template <typename T, typename U>
+	std::strong_ordering operator<=>(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return a.get() <=> b.get();
+	}
+
+	template <typename T>
+	inline std::strong_ordering operator<=>(const local_shared_ptr<T>& a, std::nullptr_t) EA_NOEXCEPT
+	{
+		return a.get() <=> nullptr;
+	}
+#else
+	template <typename T, typename U>
+	inline bool operator!=(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return (a.get() != b.get());
+	}
+
+	template <typename T, typename U>
+	inline bool operator<(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		typedef typename eastl::common_type<T*, U*>::type CPointer; // See the shared_ptr operator< for why these temporaries are used.
+		CPointer pT = a.get();
+		CPointer pU = b.get();
+		return less<CPointer>()(pT, pU);
+	}
+
+	template <typename T, typename U>
+	inline bool operator>(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return (b < a);
+	}
+
+	template <typename T, typename U>
+	inline bool operator<=(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return !(b < a);
+	}
+
+	template <typename T, typename U>
+	inline bool operator>=(const local_shared_ptr<T>& a, const local_shared_ptr<U>& b) EA_NOEXCEPT
+	{
+		return !(a < b);
+	}
+
+	template <typename T>
+	inline bool operator==(std::nullptr_t, const local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		return !b;
+	}
+
+	template <typename T>
+	inline bool operator!=(const local_shared_ptr<T>& a, std::nullptr_t) EA_NOEXCEPT
+	{
+		return static_cast<bool>(a);
+	}
+
+	template <typename T>
+	inline bool operator!=(std::nullptr_t, const local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		return static_cast<bool>(b);
+	}
+
+	template <typename T>
+	inline bool operator<(const local_shared_ptr<T>& a, std::nullptr_t) EA_NOEXCEPT
+	{
+		return less<T*>()(a.get(), nullptr);
+	}
+
+	template <typename T>
+	inline bool operator<(std::nullptr_t, const local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		return less<T*>()(nullptr, b.get());
+	}
+
+	template <typename T>
+	inline bool operator>(const local_shared_ptr<T>& a, std::nullptr_t) EA_NOEXCEPT
+	{
+		return (nullptr < a);
+	}
+
+	template <typename T>
+	inline bool operator>(std::nullptr_t, const local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		return (b < nullptr);
+	}
+
+	template <typename T>
+	inline bool operator<=(const local_shared_ptr<T>& a, std::nullptr_t) EA_NOEXCEPT
+	{
+		return !(nullptr < a);
+	}
+
+	template <typename T>
+	inline bool operator<=(std::nullptr_t, const local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		return !(b < nullptr);
+	}
+
+	template <typename T>
+	inline bool operator>=(const local_shared_ptr<T>& a, std::nullptr_t) EA_NOEXCEPT
+	{
+		return !(a < nullptr);
+	}
+
+	template <typename T>
+	inline bool operator>=(std::nullptr_t, const local_shared_ptr<T>& b) EA_NOEXCEPT
+	{
+		return !(nullptr < b);
+	}
+#endif
+
+
+	/// local_shared_ptr casts
+	/// These behave like the shared_ptr casts of the same names.
+	template <typename T, typename U>
+	inline local_shared_ptr<T> reinterpret_pointer_cast(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+	{
+		return local_shared_ptr<T>(sharedPtr, reinterpret_cast<T*>(sharedPtr.get()));
+	}
+
+	template <typename T, typename U>
+	inline local_shared_ptr<T> static_pointer_cast(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+	{
+		return local_shared_ptr<T>(sharedPtr, static_cast<T*>(sharedPtr.get()));
+	}
+
+	template <typename T, typename U>
+	inline local_shared_ptr<T> const_pointer_cast(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+	{
+		return local_shared_ptr<T>(sharedPtr, const_cast<T*>(sharedPtr.get()));
+	}
+
+	#if EASTL_RTTI_ENABLED
+		template <typename T, typename U>
+		inline local_shared_ptr<T> dynamic_pointer_cast(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+		{
+			if(T* p = dynamic_cast<T*>(sharedPtr.get()))
+				return local_shared_ptr<T>(sharedPtr, p);
+			return local_shared_ptr<T>();
+		}
+	#endif
+
+
+	/// hash specialization for local_shared_ptr.
+	template <typename T>
+	struct hash< local_shared_ptr<T> >
+	{
+		size_t operator()(const local_shared_ptr<T>& x) const EA_NOEXCEPT
+			{ return eastl::hash<T*>()(x.get()); }
+	};
+
+
+	template <typename T>
+	void allocate_local_shared_helper(local_shared_ptr<T>& sharedPtr, ref_count_lsp* pRefCount, T* pValue)
+	{
+		sharedPtr.mpRefCount = pRefCount;
+		sharedPtr.mpValue = pValue;
+		do_enable_local_shared_from_this(pRefCount, pValue, pValue);
+	}
+
+	/// allocate_local_shared
+	///
+	/// Like allocate_shared, this allocates the object and its reference count in a single
+	/// memory allocation.
+	///
+	template <typename T, typename Allocator, typename... Args>
+	local_shared_ptr<T> allocate_local_shared(const Allocator& allocator, Args&&... args)
+	{
+		typedef ref_count_sp_t_inst<T, Allocator, ref_count_lsp> ref_count_type;
+		local_shared_ptr<T> ret;
+		void* const pMemory = EASTLAlloc(const_cast<Allocator&>(allocator), sizeof(ref_count_type));
+		if(pMemory)
+		{
+			ref_count_type* pRefCount = ::new(pMemory) ref_count_type(allocator, eastl::forward<Args>(args)...);
+			allocate_local_shared_helper(ret, pRefCount, pRefCount->GetValue());
+		}
+		return ret;
+	}
+
+	/// make_local_shared
+	///
+	/// The local_shared_ptr version of make_shared.
+	///
+	template <typename T, typename... Args>
+	local_shared_ptr<T> make_local_shared(Args&&... args)
+	{
+		return eastl::allocate_local_shared<T>(EASTL_LOCAL_SHARED_PTR_DEFAULT_ALLOCATOR, eastl::forward<Args>(args)...);
+	}
+
+
+
+	/// local_weak_ptr
+	///
+	/// The weak_ptr counterpart of local_shared_ptr. It has the same single thread
+	/// restriction as local_shared_ptr.
+	///
+	template <typename T>
+	class local_weak_ptr
+	{
+	public:
+		typedef local_weak_ptr<T> this_type;
+		typedef T                 element_type;
+
+	public:
+		local_weak_ptr() EA_NOEXCEPT
+			: mpValue(nullptr), mpRefCount(nullptr) {}
+
+		local_weak_ptr(const this_type& weakPtr) EA_NOEXCEPT
+			: mpValue(weakPtr.mpValue), mpRefCount(weakPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->weak_addref();
+		}
+
+		local_weak_ptr(this_type&& weakPtr) EA_NOEXCEPT
+			: mpValue(weakPtr.mpValue), mpRefCount(weakPtr.mpRefCount)
+		{
+			weakPtr.mpValue = nullptr;
+			weakPtr.mpRefCount = nullptr;
+		}
+
+		template <typename U>
+		local_weak_ptr(const local_weak_ptr<U>& weakPtr,
+		               typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+			: mpValue(weakPtr.mpValue), mpRefCount(weakPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->weak_addref();
+		}
+
+		template <typename U>
+		local_weak_ptr(local_weak_ptr<U>&& weakPtr,
+		               typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+			: mpValue(weakPtr.mpValue), mpRefCount(weakPtr.mpRefCount)
+		{
+			weakPtr.mpValue = nullptr;
+			weakPtr.mpRefCount = nullptr;
+		}
+
+		template <typename U>
+		local_weak_ptr(const local_shared_ptr<U>& sharedPtr,
+		               typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+			: mpValue(sharedPtr.mpValue), mpRefCount(sharedPtr.mpRefCount)
+		{
+			if(mpRefCount)
+				mpRefCount->weak_addref();
+		}
+
+		~local_weak_ptr()
+		{
+			if(mpRefCount)
+				mpRefCount->weak_release();
+		}
+
+		this_type& operator=(const this_type& weakPtr) EA_NOEXCEPT
+		{
+			assign(weakPtr);
+			return *this;
+		}
+
+		this_type& operator=(this_type&& weakPtr) EA_NOEXCEPT
+		{
+			this_type(eastl::move(weakPtr)).swap(*this);
+			return *this;
+		}
+
+		template <typename U>
+		typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(const local_weak_ptr<U>& weakPtr) EA_NOEXCEPT
+		{
+			assign(weakPtr);
+			return *this;
+		}
+
+		template <typename U>
+		typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(local_weak_ptr<U>&& weakPtr) EA_NOEXCEPT
+		{
+			this_type(eastl::move(weakPtr)).swap(*this);
+			return *this;
+		}
+
+		template <typename U>
+		typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value, this_type&>::type
+		operator=(const local_shared_ptr<U>& sharedPtr) EA_NOEXCEPT
+		{
+			assign(sharedPtr.mpValue, sharedPtr.mpRefCount);
+			return *this;
+		}
+
+		local_shared_ptr<T> lock() const EA_NOEXCEPT
+		{
+			local_shared_ptr<T> temp;
+			temp.mpRefCount = mpRefCount ? mpRefCount->lock() : mpRefCount; // mpRefCount->lock() addref's the return value for us.
+			if(temp.mpRefCount)
+				temp.mpValue = mpValue;
+			return temp;
+		}
+
+		int use_count() const EA_NOEXCEPT
+		{
+			return mpRefCount ? mpRefCount->use_count() : 0;
+		}
+
+		bool expired() const EA_NOEXCEPT
+		{
+			return (!mpRefCount || (mpRefCount->use_count() == 0));
+		}
+
+		void reset()
+		{
+			if(mpRefCount)
+				mpRefCount->weak_release();
+
+			mpValue    = nullptr;
+			mpRefCount = nullptr;
+		}
+
+		void swap(this_type& weakPtr)
+		{
+			T* const pValue = weakPtr.mpValue;
+			weakPtr.mpValue = mpValue;
+			mpValue         = pValue;
+
+			ref_count_lsp* const pRefCount = weakPtr.mpRefCount;
+			weakPtr.mpRefCount = mpRefCount;
+			mpRefCount         = pRefCount;
+		}
+
+		template <typename U>
+		void assign(const local_weak_ptr<U>& weakPtr,
+		            typename eastl::enable_if<eastl::is_convertible<U*, element_type*>::value>::type* = 0) EA_NOEXCEPT
+		{
+			assign(weakPtr.mpValue, weakPtr.mpRefCount);
+		}
+
+		template <typename U>
+		bool owner_before(const local_weak_ptr<U>& weakPtr) const EA_NOEXCEPT
+		{
+			return (mpRefCount < weakPtr.mpRefCount);
+		}
+
+		template <typename U>
+		bool owner_before(const local_shared_ptr<U>& sharedPtr) const EA_NOEXCEPT
+		{
+			return (mpRefCount < sharedPtr.mpRefCount);
+		}
+
+		/// assign
+		///
+		/// Assignment through a T/ref_count_lsp pair. This is used by
+		/// do_enable_local_shared_from_this.
+		///
+		void assign(element_type* pValue, ref_count_lsp* pRefCount)
+		{
+			mpValue = pValue;
+
+			if(pRefCount != mpRefCount)
+			{
+				if(pRefCount)
+					pRefCount->weak_addref();
+
+				if(mpRefCount)
+					mpRefCount->weak_release();
+
+				mpRefCount = pRefCount;
+			}
+		}
+
+	protected:
+		element_type*   mpValue;       /// The (weakly) owned pointer.
+		ref_count_lsp*  mpRefCount;    /// Reference count for owned pointer.
+
+		// Friend declarations
+		template <typename U> friend class local_shared_ptr;
+		template <typename U> friend class local_weak_ptr;
+
+	}; // class local_weak_ptr
+
+
+	template <typename T>
+	struct is_trivially_relocatable<local_weak_ptr<T>> : public true_type {};
+
+
+	template <typename T, typename U>
+	inline bool operator<(const local_weak_ptr<T>& weakPtr1, const local_weak_ptr<U>& weakPtr2)
+	{
+		return weakPtr1.owner_before(weakPtr2);
+	}
+
+	template <typename T>
+	void swap(local_weak_ptr<T>& weakPtr1, local_weak_ptr<T>& weakPtr2)
+	{
+		weakPtr1.swap(weakPtr2);
+	}
+
+
+	template <typename T>
+	struct owner_less< local_shared_ptr<T> >
+	{
+		bool operator()(local_shared_ptr<T> const& a, local_shared_ptr<T> const& b) const EA_NOEXCEPT
+			{ return a.owner_before(b); }
+
+		bool operator()(local_shared_ptr<T> const& a, local_weak_ptr<T> const& b) const EA_NOEXCEPT
+			{ return a.owner_before(b); }
+
+		bool operator()(local_weak_ptr<T> const& a, local_shared_ptr<T> const& b) const EA_NOEXCEPT
+			{ return a.owner_before(b); }
+	};
+
+	template <typename T>
+	struct owner_less< local_weak_ptr<T> >
+	{
+		bool operator()(local_weak_ptr<T> const& a, local_weak_ptr<T> const& b) const EA_NOEXCEPT
+			{ return a.owner_before(b); }
+
+		bool operator()(local_weak_ptr<T> const& a, local_shared_ptr<T> const& b) const EA_NOEXCEPT
+			{ return a.owner_before(b); }
+
+		bool operator()(local_shared_ptr<T> const& a, local_weak_ptr<T> const& b) const EA_NOEXCEPT
+			{ return a.owner_before(b); }
+	};
+
+
+
+	/// enable_local_shared_from_this
+	///
+	/// The local_shared_ptr version of enable_shared_from_this. A class which derives from it
+	/// and is owned by a local_shared_ptr can get more local_shared_ptrs to itself with
+	/// shared_from_this().
+	///
+	template <typename T>
+	class enable_local_shared_from_this
+	{
+	public:
+		local_shared_ptr<T> shared_from_this()
+			{ return local_shared_ptr<T>(mWeakPtr); }
+
+		local_shared_ptr<const T> shared_from_this() const
+			{ return local_shared_ptr<const T>(mWeakPtr); }
+
+		local_weak_ptr<T> weak_from_this()
+			{ return mWeakPtr; }
+
+		local_weak_ptr<const T> weak_from_this() const
+			{ return mWeakPtr; }
+
+	public: // This is public for the same reason as in enable_shared_from_this.
+		mutable local_weak_ptr<T> mWeakPtr;
+
+	protected:
+		template <typename U> friend class local_shared_ptr;
+
+		EA_CONSTEXPR enable_local_shared_from_this() EA_NOEXCEPT
+			{ }
+
+		enable_local_shared_from_this(const enable_local_shared_from_this&) EA_NOEXCEPT
+			{ }
+
+		enable_local_shared_from_this& operator=(const enable_local_shared_from_this&) EA_NOEXCEPT
+			{ return *this; }
+
+		~enable_local_shared_from_this()
+			{ }
+
+	}; // enable_local_shared_from_this
+
+} // namespace eastl
@@ -31,6 +31,7 @@
 //    uninitialized_copy_fill           - Extention to standard functionality.
 //    uninitialized_fill_copy           - Extention to standard functionality.
 //    uninitialized_copy_copy           - Extention to standard functionality.
+//    uninitialized_relocate            - Extention to standard functionality. Move-constructs then destroys the source, or memmoves is_trivially_relocatable types.
 //
 // In-place destructor helpers:
 //    destruct(T*)                      - Non-standard extension. Equivalent to destroy_at(T*)
@@ -53,7 +54,7 @@
 // 
 // Deprecations:
 // (EASTL_REMOVE_AT_2024_APRIL)
-//    uninitialized_relocate            - Use one of the other uninitialized_xxxx functions with move semantics.
+//    uninitialized_relocate_start/commit/abort - Use uninitialized_relocate or uninitialized_move_if_noexcept instead.
 //    uninitialized_default_fill        - Use uninitialized_value_construct instead.
 //    uninitialized_default_fill_n      - Use uninitialized_value_construct_n instead.
 // 
@@ -371,18 +372,16 @@ namespace eastl
 	};
 
 
-	/// uninitialized_relocate (formerly named uninitialized_move prior to C++11)
+	/// uninitialized_relocate_start/commit/abort (formerly named uninitialized_move prior to C++11)
 	///
-	/// This utility is deprecated in favor of C++11 rvalue move functionality.
+	/// These utilities are deprecated in favor of C++11 rvalue move functionality
+	/// and of uninitialized_relocate (below), which is not deprecated.
 	///
-	/// uninitialized_relocate takes a constructed sequence of objects and an
+	/// uninitialized_relocate_start takes a constructed sequence of objects and an
 	/// uninitialized destination buffer. In the case of any exception thrown
 	/// while moving the objects, any newly constructed objects are guaranteed
 	/// to be destructed and the input left fully constructed.
 	///
-	/// In the case where you need to do multiple moves atomically, split the
-	/// calls into uninitialized_relocate_start/abort/commit.
-	///
 	/// uninitialized_relocate_start can possibly throw an exception. If it does,
 	/// you don't need to do anything. However, if it returns without throwing
 	/// an exception you need to guarantee that either uninitialized_relocate_abort
@@ -545,19 +544,6 @@ namespace eastl
 		return Internal::uninitialized_relocate_impl<bHasTrivialMove, IC>::do_move_abort(first, last, dest);
 	}
 
-	/// uninitialized_relocate
-	///
-	/// See above for documentation.
-	///
-	template <typename ForwardIterator, typename ForwardIteratorDest>
-	[[deprecated]] inline ForwardIteratorDest uninitialized_relocate(ForwardIterator first, ForwardIterator last, ForwardIteratorDest dest)
-	{
-		ForwardIteratorDest result = uninitialized_relocate_start(first, last, dest);
-		eastl::uninitialized_relocate_commit(first, last, dest);
-
-		return result;
-	}
-
 	EASTL_INTERNAL_RESTORE_DEPRECATED()
 
 
@@ -1417,6 +1403,59 @@ namespace eastl
 	}
 
 
+	// uninitialized_relocate
+	//
+	namespace Internal
+	{
+		template <typename ForwardIterator, typename ForwardIteratorDest>
+		inline ForwardIteratorDest uninitialized_relocate_dispatch(ForwardIterator first, ForwardIterator last, ForwardIteratorDest dest, false_type)
+		{
+			ForwardIteratorDest result = eastl::uninitialized_move_if_noexcept(first, last, dest);
+			eastl::destruct(first, last);
+			return result;
+		}
+
+		template <typename T>
+		inline T* uninitialized_relocate_dispatch(T* first, T* last, T* dest, true_type) // true means T is trivially relocatable.
+		{
+			// memmove rather than memcpy, so that elements can also be relocated within a single buffer.
+			if(first != last)
+				memmove((void*)dest, (const void*)first, (size_t)((uintptr_t)last - (uintptr_t)first));
+			return dest + (last - first);
+		}
+	}
+
+	/// uninitialized_relocate
+	///
+	/// Relocates the constructed objects in [first, last) to the uninitialized 
+	/// memory at dest: afterwards [dest, dest + (last - first)) is constructed 
+	/// and [first, last) is uninitialized memory which the caller must not destroy.
+	/// Returns dest + (last - first).
+	///
+	/// For is_trivially_relocatable types in contiguous memory this is a single 
+	/// memmove and cannot throw. Otherwise each object is moved (or copied, as per
+	/// uninitialized_move_if_noexcept) and the source objects are then destroyed.
+	/// If that throws, the destination is left uninitialized and the source is 
+	/// left constructed, though it may have been moved from if the type's
+	/// move constructor can throw and it has no copy constructor.
+	///
+	/// Example usage:
+	///     T* pNewEnd = eastl::uninitialized_relocate(pBegin, pEnd, pNewBegin);
+	///     deallocate(pBegin);  // No destructor calls needed for [pBegin, pEnd).
+	///
+	template <typename ForwardIterator, typename ForwardIteratorDest>
+	inline ForwardIteratorDest uninitialized_relocate(ForwardIterator first, ForwardIterator last, ForwardIteratorDest dest)
+	{
+		typedef typename eastl::iterator_traits<ForwardIterator>::value_type value_type;
+
+		const bool bTriviallyRelocatable = eastl::is_trivially_relocatable<value_type>::value &&
+										   eastl::is_pointer<ForwardIterator>::value &&
+										   eastl::is_same<ForwardIterator, ForwardIteratorDest>::value;
+
+		return Internal::uninitialized_relocate_dispatch(first, last, dest, eastl::bool_constant<bTriviallyRelocatable>());
+	}
+
+
 	/// align
 	///
 	/// Same as C++11 std::align. http://en.cppreference.com/w/cpp/memory/align
@@ -0,0 +1,573 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     ebr_domain
+//     ebr_obj_base
+//     hazard_domain
+//     hazard_pointer
+//     hazard_pointer_obj_base
+//     atomic_load_intrusive / atomic_exchange_intrusive
+//
+// These defer the deletion of objects which lock-free readers may still be
+// using. A writer unlinks an object from a shared structure, such as an atomic
+// pointer to a container snapshot or a node in a lock-free list, and retires
+// it instead of deleting it. The object is deleted once no reader can still
+// hold a pointer to it.
+//
+// ebr_domain does this with epoch-based reclamation. Readers enter a guard,
+// which costs a store and a fence, and may use any number of objects inside it.
+// Retired objects are freed in batches once every reader which might have seen
+// them has left its guard. A reader which stays inside a guard for a long time
+// holds up all frees in the domain.
+//
+// hazard_pointer protects one object at a time. It costs a store, a fence and a
+// reload per object, but a stalled reader only holds up the objects that it has
+// protected, so memory use stays bounded.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+#include <EASTL/intrusive_ptr.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/unique_ptr.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <atomic>
+#include <new>
+#include <stddef.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+
+namespace eastl
+{
+
+	/// EASTL_EBR_RETIRE_THRESHOLD
+	///
+	/// The number of objects a thread retires to an ebr_domain between attempts to
+	/// advance the epoch and free what it has retired.
+	///
+	#ifndef EASTL_EBR_RETIRE_THRESHOLD
+		#define EASTL_EBR_RETIRE_THRESHOLD 64
+	#endif
+
+
+	/// EASTL_EBR_THREAD_CACHE_SIZE
+	///
+	/// The number of ebr_domains for which a thread keeps its per-thread state between
+	/// guards. A thread which uses more domains than this claims and releases its state
+	/// on every guard for the extra domains, which is slower but still correct.
+	///
+	#ifndef EASTL_EBR_THREAD_CACHE_SIZE
+		#define EASTL_EBR_THREAD_CACHE_SIZE 4
+	#endif
+
+
+	/// EASTL_HAZARD_POINTER_RETIRE_THRESHOLD
+	///
+	/// The smallest number of retired objects at which a hazard_domain scans the hazard
+	/// pointers and frees the retired objects which aren't protected. The domain scans
+	/// at twice its number of hazard pointers if that is larger, so that each scan frees
+	/// at least half of what it looks at.
+	///
+	#ifndef EASTL_HAZARD_POINTER_RETIRE_THRESHOLD
+		#define EASTL_HAZARD_POINTER_RETIRE_THRESHOLD 128
+	#endif
+
+
+
+	namespace Internal
+	{
+		/// retired_node
+		///
+		/// An object which has been retired and waits to be freed. Objects derived from
+		/// ebr_obj_base or hazard_pointer_obj_base are their own retired_node; other
+		/// objects are wrapped in a retired_box.
+		struct retired_node
+		{
+			retired_node* mpRetiredNext;
+			void        (*mpRetiredFree)(retired_node*);
+			const void*   mpRetiredObject;   // The address which hazard pointers protect.
+			uint64_t      mnRetiredEpoch;    // The ebr_domain epoch in which the object was retired.
+		};
+
+
+		/// retired_box
+		///
+		/// Holds an object and its deleter while the object waits to be freed.
+		template <typename T, typename Deleter>
+		struct retired_box : public retired_node
+		{
+			T*      mpObject;
+			Deleter mDeleter;
+
+			retired_box(T* p, Deleter deleter)
+				: mpObject(p), mDeleter(eastl::move(deleter))
+			{
+				mpRetiredFree   = &Free;
+				mpRetiredObject = p;
+			}
+
+			static void Free(retired_node* pNode)
+			{
+				retired_box* const pBox     = static_cast<retired_box*>(pNode);
+				T* const           pObject  = pBox->mpObject;
+				Deleter            deleter(eastl::move(pBox->mDeleter));
+
+				pBox->~retired_box();
+				EASTLFree(*EASTLAllocatorDefault(), pBox, sizeof(retired_box));
+				deleter(pObject);
+			}
+
+			static retired_node* Create(T* p, Deleter deleter)
+			{
+				void* const pMemory = EASTLAlloc(*EASTLAllocatorDefault(), sizeof(retired_box));
+				EASTL_ASSERT_MSG(pMemory, "retired_box: out of memory");
+				return ::new(pMemory) retired_box(p, eastl::move(deleter));
+			}
+		};
+
+
+		/// retirable_obj_base
+		///
+		/// The implementation shared by ebr_obj_base and hazard_pointer_obj_base.
+		template <typename T, typename Deleter>
+		class retirable_obj_base : protected retired_node
+		{
+		protected:
+			retirable_obj_base() EA_NOEXCEPT {}
+			retirable_obj_base(const retirable_obj_base&) EA_NOEXCEPT {}
+			retirable_obj_base& operator=(const retirable_obj_base&) EA_NOEXCEPT { return *this; }
+		   ~retirable_obj_base() {}
+
+			retired_node* DoPrepareRetire(Deleter deleter)
+			{
+				::new(&mDeleterStorage) Deleter(eastl::move(deleter));
+				mpRetiredFree   = &Free;
+				mpRetiredObject = static_cast<const T*>(this);
+				return this;
+			}
+
+			static void Free(retired_node* pNode)
+			{
+				retirable_obj_base* const pBase    = static_cast<retirable_obj_base*>(pNode);
+				Deleter* const            pDeleter = reinterpret_cast<Deleter*>(&pBase->mDeleterStorage);
+				Deleter                   deleter(eastl::move(*pDeleter));
+
+				pDeleter->~Deleter();
+				deleter(static_cast<T*>(pBase));
+			}
+
+			typename aligned_storage<sizeof(Deleter), alignment_of<Deleter>::value>::type mDeleterStorage; // Constructed only once the object is retired.
+		};
+
+
+		struct hazard_record;
+		struct ebr_record;
+
+	} // namespace Internal
+
+
+
+	/// intrusive_release_deleter
+	///
+	/// A deleter which releases a reference with intrusive_ptr_release. Retiring an object
+	/// with it gives up a reference which was held by a shared structure, once no reader
+	/// can be about to add a reference of its own.
+	///
+	struct intrusive_release_deleter
+	{
+		template <typename T>
+		void operator()(T* p) const
+			{ intrusive_ptr_release(p); } // Intentionally unqualified, so that user overloads are found.
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// ebr_domain
+	///////////////////////////////////////////////////////////////////////////
+
+	/// ebr_domain
+	///
+	/// Epoch-based reclamation. Readers of a shared structure enter an ebr_domain::guard
+	/// before loading pointers from it, and may use whatever they loaded until the guard
+	/// is destroyed. Writers unlink objects and retire them to the domain, which frees
+	/// them once every guard that was active when they were retired has ended.
+	///
+	/// The domain keeps a global epoch. A guard records the epoch at which it began, and
+	/// an object records the epoch at which it was retired. The epoch advances only once
+	/// every active guard has seen the current epoch, so an object retired at epoch e is
+	/// unreachable by every guard once the epoch reaches e + 2.
+	///
+	/// Each thread has its own list of retired objects in each domain, which it frees
+	/// as it retires more. A thread which exits leaves its list to be freed by the next
+	/// thread which takes its place, by synchronize(), or by the domain's destructor.
+	///
+	/// Guards may be nested and may be used for several domains at once. A thread must
+	/// not call synchronize() from inside a guard of the same domain, as it would wait
+	/// for itself. The domain must outlive every guard and retire call made on it.
+	///
+	/// Example usage:
+	///     std::atomic<Config*> gpConfig;
+	///
+	///     // Reader:
+	///     {
+	///         eastl::ebr_domain::guard guard;
+	///         Config* pConfig = gpConfig.load(std::memory_order_acquire);
+	///         UseConfig(pConfig);
+	///     }
+	///
+	///     // Writer:
+	///     Config* pOldConfig = gpConfig.exchange(new Config(...));
+	///     eastl::ebr_domain::get_default().retire(pOldConfig);
+	///
+	class EASTL_API ebr_domain
+	{
+	public:
+		/// guard
+		///
+		/// Marks the calling thread as reading from the domain for the guard's lifetime.
+		///
+		class EASTL_API guard
+		{
+		public:
+			explicit guard(ebr_domain& domain = ebr_domain::get_default());
+		   ~guard();
+
+			guard(const guard&) = delete;
+			guard& operator=(const guard&) = delete;
+
+		protected:
+			ebr_domain*           mpDomain;
+			Internal::ebr_record* mpRecord;
+			bool                  mbOwnsRecord; // True if the record was claimed just for this guard.
+		};
+
+	public:
+		ebr_domain();
+	   ~ebr_domain(); // Frees everything still retired.
+
+		ebr_domain(const ebr_domain&) = delete;
+		ebr_domain& operator=(const ebr_domain&) = delete;
+
+		/// Returns the process-wide domain, which is never destroyed.
+		static ebr_domain& get_default();
+
+		/// Frees p with deleter once no guard which could have seen it remains. p must
+		/// already be unreachable from the shared structure. The deleter must be movable.
+		template <typename T, typename Deleter = default_delete<T> >
+		void retire(T* p, Deleter deleter = Deleter())
+		{
+			if(p)
+				DoRetire(Internal::retired_box<T, Deleter>::Create(p, eastl::move(deleter)));
+		}
+
+		/// Tries to advance the epoch, and frees what the calling thread has retired and
+		/// is no longer reachable. Returns the number of objects freed.
+		size_t collect();
+
+		/// Waits until everything retired before the call is unreachable, and frees it,
+		/// except for what other live threads have retired and not yet collected.
+		/// Must not be called from inside a guard of this domain.
+		void synchronize();
+
+		/// Returns the current global epoch.
+		uint64_t epoch() const EA_NOEXCEPT
+			{ return mnEpoch.load(std::memory_order_relaxed); }
+
+	protected:
+		template <typename T, typename D> friend class ebr_obj_base;
+
+		void                  DoRetire(Internal::retired_node* pNode);
+		Internal::ebr_record* DoGetRecord(bool& bOwnsRecord);
+		Internal::ebr_record* DoClaimRecord();
+		bool                  DoTryAdvance();
+		size_t                DoCollect(Internal::ebr_record* pRecord);
+
+	protected:
+		std::atomic<uint64_t>              mnEpoch;
+		std::atomic<Internal::ebr_record*> mpRecordList;
+		uint64_t                           mnId;          // Unique for each domain ever created, so that thread caches can't mistake a new domain for a destroyed one at the same address.
+	};
+
+
+
+	/// ebr_obj_base
+	///
+	/// A base class for objects which are retired to an ebr_domain. Retiring such an object
+	/// makes no allocation, which suits the nodes of lock-free containers.
+	///
+	/// Example usage:
+	///     struct Node : public eastl::ebr_obj_base<Node> { ... };
+	///     pNode->retire();
+	///
+	template <typename T, typename D = default_delete<T> >
+	class ebr_obj_base : public Internal::retirable_obj_base<T, D>
+	{
+	public:
+		void retire(D deleter = D(), ebr_domain& domain = ebr_domain::get_default())
+			{ domain.DoRetire(this->DoPrepareRetire(eastl::move(deleter))); }
+
+	protected:
+		ebr_obj_base() EA_NOEXCEPT {}
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// hazard pointers
+	///////////////////////////////////////////////////////////////////////////
+
+	namespace Internal
+	{
+		struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) hazard_record
+		{
+			std::atomic<const void*> mpHazard;
+			std::atomic<bool>        mbClaimed;
+			hazard_record*           mpNext;
+		} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+	}
+
+
+	/// hazard_domain
+	///
+	/// Owns a set of hazard pointers and the objects retired against them. A retired object
+	/// is freed once no hazard pointer of the domain protects it. The domain must outlive
+	/// its hazard pointers.
+	///
+	class EASTL_API hazard_domain
+	{
+	public:
+		hazard_domain();
+	   ~hazard_domain(); // Frees everything still retired.
+
+		hazard_domain(const hazard_domain&) = delete;
+		hazard_domain& operator=(const hazard_domain&) = delete;
+
+		/// Returns the process-wide domain, which is never destroyed.
+		static hazard_domain& get_default();
+
+		/// Frees p with deleter once no hazard pointer protects it. p must already be
+		/// unreachable from the shared structure. The deleter must be movable.
+		template <typename T, typename Deleter = default_delete<T> >
+		void retire(T* p, Deleter deleter = Deleter())
+		{
+			if(p)
+				DoRetire(Internal::retired_box<T, Deleter>::Create(p, eastl::move(deleter)));
+		}
+
+		/// Frees every retired object which isn't protected right now. Returns the number
+		/// of objects freed.
+		size_t collect();
+
+		/// Returns the number of objects waiting to be freed.
+		size_t retired_count() const EA_NOEXCEPT
+			{ return mnRetiredCount.load(std::memory_order_relaxed); }
+
+	protected:
+		friend class hazard_pointer;
+		template <typename T, typename D> friend class hazard_pointer_obj_base;
+
+		void                     DoRetire(Internal::retired_node* pNode);
+		Internal::hazard_record* DoClaimRecord();
+		size_t                   DoScan();
+
+	protected:
+		std::atomic<Internal::hazard_record*> mpRecordList;
+		std::atomic<Internal::retired_node*>  mpRetiredList;
+		std::atomic<size_t>                   mnRetiredCount;
+		std::atomic<size_t>                   mnRecordCount;
+	};
+
+
+
+	/// hazard_pointer
+	///
+	/// A single-writer, multi-reader pointer which tells writers that the object it points
+	/// to must not be freed yet. It follows the C++26 std::hazard_pointer. A hazard_pointer
+	/// claims a slot in its domain when it is made, so keep one around for many
+	/// protections rather than making one per access.
+	///
+	/// Example usage:
+	///     eastl::hazard_pointer hp = eastl::make_hazard_pointer();
+	///
+	///     Node* pNode = hp.protect(gpHead); // pNode stays valid until hp protects something else.
+	///     UseNode(pNode);
+	///     hp.reset_protection();
+	///
+	class EASTL_API hazard_pointer
+	{
+	public:
+		hazard_pointer() EA_NOEXCEPT
+			: mpRecord(NULL) {}
+
+		explicit hazard_pointer(hazard_domain& domain)
+			: mpRecord(domain.DoClaimRecord()) {}
+
+		hazard_pointer(hazard_pointer&& x) EA_NOEXCEPT
+			: mpRecord(x.mpRecord) { x.mpRecord = NULL; }
+
+		hazard_pointer& operator=(hazard_pointer&& x) EA_NOEXCEPT
+		{
+			if(this != &x)
+			{
+				DoRelease();
+				mpRecord   = x.mpRecord;
+				x.mpRecord = NULL;
+			}
+			return *this;
+		}
+
+	   ~hazard_pointer()
+			{ DoRelease(); }
+
+		hazard_pointer(const hazard_pointer&) = delete;
+		hazard_pointer& operator=(const hazard_pointer&) = delete;
+
+		/// Returns true if this hazard_pointer has no slot, as when default-constructed or moved from.
+		bool empty() const EA_NOEXCEPT
+			{ return mpRecord == NULL; }
+
+		/// Loads source and protects the pointer, retrying until the protection is known to
+		/// have been published before the pointer was retired. Returns the protected pointer.
+		template <typename T>
+		T* protect(const std::atomic<T*>& source) EA_NOEXCEPT
+		{
+			T* p = source.load(std::memory_order_relaxed);
+			while(!try_protect(p, source))
+				{ }
+			return p;
+		}
+
+		/// Protects p, which was loaded from source, if source still holds it. Otherwise
+		/// sets p to the new value of source and returns false.
+		template <typename T>
+		bool try_protect(T*& p, const std::atomic<T*>& source) EA_NOEXCEPT
+		{
+			EASTL_ASSERT(mpRecord);
+			T* const pExpected = p;
+			mpRecord->mpHazard.store(pExpected, std::memory_order_seq_cst);
+			p = source.load(std::memory_order_seq_cst);
+
+			if(p == pExpected)
+				return true;
+
+			mpRecord->mpHazard.store(NULL, std::memory_order_release);
+			return false;
+		}
+
+		/// Protects p, which the caller knows is not retired yet.
+		template <typename T>
+		void reset_protection(const T* p) EA_NOEXCEPT
+			{ EASTL_ASSERT(mpRecord); mpRecord->mpHazard.store(p, std::memory_order_seq_cst); }
+
+		/// Ends the protection.
+		void reset_protection(std::nullptr_t = nullptr) EA_NOEXCEPT
+			{ EASTL_ASSERT(mpRecord); mpRecord->mpHazard.store(NULL, std::memory_order_release); }
+
+		void swap(hazard_pointer& x) EA_NOEXCEPT
+			{ eastl::swap(mpRecord, x.mpRecord); }
+
+	protected:
+		void DoRelease() EA_NOEXCEPT
+		{
+			if(mpRecord)
+			{
+				mpRecord->mpHazard.store(NULL, std::memory_order_release);
+				mpRecord->mbClaimed.store(false, std::memory_order_release);
+				mpRecord = NULL;
+			}
+		}
+
+		Internal::hazard_record* mpRecord;
+	};
+
+
+	inline hazard_pointer make_hazard_pointer(hazard_domain& domain = hazard_domain::get_default())
+	{
+		return hazard_pointer(domain);
+	}
+
+	inline void swap(hazard_pointer& a, hazard_pointer& b) EA_NOEXCEPT
+	{
+		a.swap(b);
+	}
+
+
+
+	/// hazard_pointer_obj_base
+	///
+	/// A base class for objects which are retired to a hazard_domain, as with the C++26
+	/// std::hazard_pointer_obj_base. Retiring such an object makes no allocation, which
+	/// suits the nodes of lock-free containers.
+	///
+	/// Example usage:
+	///     struct Node : public eastl::hazard_pointer_obj_base<Node> { ... };
+	///     pNode->retire();
+	///
+	template <typename T, typename D = default_delete<T> >
+	class hazard_pointer_obj_base : public Internal::retirable_obj_base<T, D>
+	{
+	public:
+		void retire(D deleter = D(), hazard_domain& domain = hazard_domain::get_default())
+			{ domain.DoRetire(this->DoPrepareRetire(eastl::move(deleter))); }
+
+	protected:
+		hazard_pointer_obj_base() EA_NOEXCEPT {}
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// intrusive_ptr support
+	//
+	// A shared structure holds a reference to an intrusively counted object through
+	// a std::atomic<T*>. Readers take a reference of their own while the object is
+	// protected, after which they no longer need the protection. Writers swap in a
+	// new object and retire the reference which the structure held.
+	///////////////////////////////////////////////////////////////////////////
+
+	/// atomic_load_intrusive
+	///
+	/// Returns an intrusive_ptr to the object held by source, using hazardPointer to keep
+	/// the object alive until the reference has been added.
+	///
+	template <typename T>
+	intrusive_ptr<T> atomic_load_intrusive(const std::atomic<T*>& source, hazard_pointer& hazardPointer)
+	{
+		intrusive_ptr<T> p(hazardPointer.protect(source));
+		hazardPointer.reset_protection();
+		return p;
+	}
+
+	/// Returns an intrusive_ptr to the object held by source, using an ebr_domain guard to
+	/// keep the object alive until the reference has been added.
+	template <typename T>
+	intrusive_ptr<T> atomic_load_intrusive(const std::atomic<T*>& source, ebr_domain& domain = ebr_domain::get_default())
+	{
+		ebr_domain::guard guard(domain);
+		return intrusive_ptr<T>(source.load(std::memory_order_acquire));
+	}
+
+
+	/// atomic_exchange_intrusive
+	///
+	/// Stores p in dest, transferring p's reference to dest, and retires the reference
+	/// which dest held to domain. The domain must be the one that readers use.
+	///
+	template <typename T, typename Domain>
+	void atomic_exchange_intrusive(std::atomic<T*>& dest, intrusive_ptr<T> p, Domain& domain)
+	{
+		T* const pOld = dest.exchange(p.detach(), std::memory_order_seq_cst);
+		domain.retire(pOld, intrusive_release_deleter());
+	}
+
+} // namespace eastl
@@ -53,6 +53,38 @@ namespace eastl
 
 
 
+	/// reduce
+	///
+	/// Like accumulate, but binary_op may be applied to the values in any order and
+	/// grouping, so it must be associative and commutative. This is what allows the
+	/// parallel reduce in <EASTL/execution.h> to split up the work. This version
+	/// processes the values in order.
+	///
+	template <typename InputIterator, typename T, typename BinaryOperation>
+	T reduce(InputIterator first, InputIterator last, T init, BinaryOperation binary_op)
+	{
+		for(; first != last; ++first)
+			init = binary_op(eastl::move(init), *first);
+		return init;
+	}
+
+	template <typename InputIterator, typename T>
+	T reduce(InputIterator first, InputIterator last, T init)
+	{
+		for(; first != last; ++first)
+			init = eastl::move(init) + *first;
+		return init;
+	}
+
+	template <typename InputIterator>
+	typename eastl::iterator_traits<InputIterator>::value_type
+	reduce(InputIterator first, InputIterator last)
+	{
+		return eastl::reduce(first, last, typename eastl::iterator_traits<InputIterator>::value_type());
+	}
+
+
+
 	/// iota
 	///
 	/// Requires: T shall be convertible to ForwardIterator's value type. The expression ++val, 
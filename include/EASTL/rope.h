@@ -0,0 +1,1434 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements rope, a string for large texts which are edited in
+// the middle. A rope is a balanced binary tree whose leaves are pieces of
+// immutable, reference counted character buffers. Inserting, erasing and
+// taking a substring split and rejoin the tree in O(log n) rather than
+// moving the characters after the edit, and copies and substrings share
+// their nodes and buffers with the original.
+//
+// rope differs from basic_string in the following ways:
+//    - Indexing and iterator movement are O(log n) rather than O(1), although
+//      iterators cache the piece they are in so that sequential iteration
+//      is O(1) per character. The characters are not contiguous, so there is
+//      no data() or c_str(). Use chunk_begin/chunk_end (or chunks()) to visit
+//      the pieces as string_views, or str() to flatten the rope into a string.
+//    - Elements can't be modified in place; only const iterators exist.
+//    - Copying a rope is O(1). Nodes are reference counted with atomic
+//      counts, so ropes which share nodes may be used from different threads,
+//      though any one rope object still needs external synchronization.
+//    - Ropes only share nodes with ropes whose allocator compares equal, as a
+//      shared node is freed by whichever rope releases it last. Assigning or
+//      inserting a rope with an unequal allocator copies its characters.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/allocator.h>
+#include <EASTL/iterator.h>
+#include <EASTL/string.h>
+#include <EASTL/string_view.h>
+#include <EASTL/bonus/compressed_pair.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <new>
+#include <stddef.h>
+#include <string.h>
+#if EASTL_EXCEPTIONS_ENABLED
+	#include <stdexcept> // std::out_of_range
+#endif
+EA_RESTORE_ALL_VC_WARNINGS()
+
+// 4530 - C++ exception handler used, but unwind semantics are not enabled. Specify /EHsc
+// 4571 - catch(...) semantics changed since Visual C++ 7.1; structured exceptions (SEH) are no longer caught.
+EA_DISABLE_VC_WARNING(4530 4571);
+
+
+
+namespace eastl
+{
+
+	/// EASTL_ROPE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_ROPE_DEFAULT_NAME
+		#define EASTL_ROPE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " rope" // Unless the user overrides something, this is "EASTL rope".
+	#endif
+
+
+	/// EASTL_ROPE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_ROPE_DEFAULT_ALLOCATOR
+		#define EASTL_ROPE_DEFAULT_ALLOCATOR allocator_type(EASTL_ROPE_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_ROPE_MERGE_LENGTH
+	///
+	/// When two pieces which together hold no more than this many characters
+	/// end up next to each other, they are copied into a single new piece.
+	/// This keeps a rope which is edited a few characters at a time (such as
+	/// by typing) from degenerating into a tree of single character pieces.
+	///
+	#ifndef EASTL_ROPE_MERGE_LENGTH
+		#define EASTL_ROPE_MERGE_LENGTH 128
+	#endif
+
+
+
+	namespace Internal
+	{
+		// The header of a reference counted character buffer. The characters follow it.
+		struct rope_chunk
+		{
+			std::atomic<int32_t> mRefCount;
+			eastl_size_t         mnAllocSize; // The size of the allocation in bytes, including this header.
+		};
+
+		// A tree node. Pieces (the leaves) have a height of 0 and refer to a range of a chunk.
+		// Concatenation nodes have two non-null children whose heights differ by at most one.
+		template <typename T>
+		struct rope_node
+		{
+			std::atomic<int32_t> mRefCount;
+			int32_t              mnHeight;
+			eastl_size_t         mnLength;
+			rope_node*           mpLeft;   // Concatenation nodes only.
+			rope_node*           mpRight;  // Concatenation nodes only.
+			rope_chunk*          mpChunk;  // Pieces only.
+			const T*             mpData;   // Pieces only.
+		};
+	}
+
+
+	template <typename T, typename Allocator>
+	class rope;
+
+
+
+	/// rope_iterator
+	///
+	/// A random access iterator over the characters of a rope. It caches the
+	/// piece which contains its position, so moving within a piece is O(1) and
+	/// moving into another piece is O(log n).
+	///
+	template <typename T, typename Allocator>
+	class rope_iterator
+	{
+		typedef rope_iterator<T, Allocator> this_type;
+		typedef rope<T, Allocator>          rope_type;
+
+	public:
+		typedef EASTL_ITC_NS::random_access_iterator_tag iterator_category;
+		typedef T                                        value_type;
+		typedef ptrdiff_t                                difference_type;
+		typedef const T*                                 pointer;
+		typedef const T&                                 reference;
+		typedef eastl_size_t                             size_type;
+
+	public:
+		rope_iterator() EA_NOEXCEPT
+			: mpRope(NULL), mnPosition(0), mpPiece(NULL), mnPieceStart(0), mnPieceEnd(0) {}
+
+		rope_iterator(const rope_type* pRope, size_type nPosition) EA_NOEXCEPT
+			: mpRope(pRope), mnPosition(nPosition), mpPiece(NULL), mnPieceStart(0), mnPieceEnd(0) {}
+
+		reference operator*() const
+		{
+			if((mnPosition - mnPieceStart) >= (mnPieceEnd - mnPieceStart)) // Also true if mnPosition < mnPieceStart.
+				mpPiece = mpRope->DoFindPiece(mnPosition, mnPieceStart, mnPieceEnd);
+			return mpPiece[mnPosition - mnPieceStart];
+		}
+
+		pointer   operator->() const                   { return &operator*(); }
+		reference operator[](difference_type n) const  { return *(*this + n); }
+
+		this_type& operator++()                        { ++mnPosition; return *this; }
+		this_type  operator++(int)                     { this_type temp(*this); ++mnPosition; return temp; }
+		this_type& operator--()                        { --mnPosition; return *this; }
+		this_type  operator--(int)                     { this_type temp(*this); --mnPosition; return temp; }
+
+		this_type& operator+=(difference_type n)       { mnPosition += (size_type)n; return *this; }
+		this_type& operator-=(difference_type n)       { mnPosition -= (size_type)n; return *this; }
+		this_type  operator+(difference_type n) const  { return this_type(*this) += n; }
+		this_type  operator-(difference_type n) const  { return this_type(*this) -= n; }
+
+		difference_type operator-(const this_type& x) const { return (difference_type)(mnPosition - x.mnPosition); }
+
+		/// Returns the index of the character the iterator refers to.
+		size_type position() const EA_NOEXCEPT         { return mnPosition; }
+
+		bool operator==(const this_type& x) const      { return mnPosition == x.mnPosition; }
+		bool operator!=(const this_type& x) const      { return mnPosition != x.mnPosition; }
+		bool operator< (const this_type& x) const      { return mnPosition <  x.mnPosition; }
+		bool operator> (const this_type& x) const      { return mnPosition >  x.mnPosition; }
+		bool operator<=(const this_type& x) const      { return mnPosition <= x.mnPosition; }
+		bool operator>=(const this_type& x) const      { return mnPosition >= x.mnPosition; }
+
+	protected:
+		const rope_type*  mpRope;
+		size_type         mnPosition;
+		mutable const T*  mpPiece;      // The characters of the cached piece, which covers [mnPieceStart, mnPieceEnd).
+		mutable size_type mnPieceStart;
+		mutable size_type mnPieceEnd;
+	};
+
+	template <typename T, typename Allocator>
+	inline rope_iterator<T, Allocator> operator+(ptrdiff_t n, const rope_iterator<T, Allocator>& x)
+		{ return x + n; }
+
+
+
+	/// rope_chunk_iterator
+	///
+	/// A forward iterator over the pieces of a rope, as string_views. The first
+	/// view starts at the position the iterator was created with, which may be
+	/// in the middle of a piece. Concatenating the views gives the rope's text.
+	///
+	template <typename T, typename Allocator>
+	class rope_chunk_iterator
+	{
+		typedef rope_chunk_iterator<T, Allocator> this_type;
+		typedef rope<T, Allocator>                rope_type;
+
+	public:
+		typedef EASTL_ITC_NS::forward_iterator_tag iterator_category;
+		typedef basic_string_view<T>               value_type;
+		typedef ptrdiff_t                          difference_type;
+		typedef const value_type*                  pointer;
+		typedef const value_type&                  reference;
+		typedef eastl_size_t                       size_type;
+
+	public:
+		rope_chunk_iterator() EA_NOEXCEPT
+			: mpRope(NULL), mnPosition(0), mView() {}
+
+		rope_chunk_iterator(const rope_type* pRope, size_type nPosition)
+			: mpRope(pRope), mnPosition(nPosition), mView() { DoUpdateView(); }
+
+		reference operator*() const                { return mView; }
+		pointer   operator->() const               { return &mView; }
+
+		this_type& operator++()                    { mnPosition += mView.size(); DoUpdateView(); return *this; }
+		this_type  operator++(int)                 { this_type temp(*this); ++*this; return temp; }
+
+		/// Returns the index in the rope of the first character of the current view.
+		size_type position() const EA_NOEXCEPT     { return mnPosition; }
+
+		bool operator==(const this_type& x) const  { return mnPosition == x.mnPosition; }
+		bool operator!=(const this_type& x) const  { return mnPosition != x.mnPosition; }
+
+	protected:
+		void DoUpdateView()
+		{
+			if(mnPosition < mpRope->size())
+			{
+				size_type nStart, nEnd;
+				const T* const pPiece = mpRope->DoFindPiece(mnPosition, nStart, nEnd);
+				mView = value_type(pPiece + (mnPosition - nStart), nEnd - mnPosition);
+			}
+			else
+				mView = value_type();
+		}
+
+		const rope_type* mpRope;
+		size_type        mnPosition;
+		value_type       mView;
+	};
+
+
+
+	/// rope
+	///
+	/// A string stored as a balanced tree of shared, immutable pieces. See the
+	/// top of this file for how it differs from basic_string.
+	///
+	/// Example usage:
+	///     eastl::rope<char> r(scriptText);         // O(n), makes a single piece.
+	///     r.insert(r.size() / 2, "// edited\n");   // O(log n)
+	///     r.erase(100, 20);                        // O(log n)
+	///     eastl::rope<char> line = r.substr(0, 80); // O(log n), shares r's buffer.
+	///
+	///     for(eastl::string_view chunk : r.chunks())
+	///         fwrite(chunk.data(), 1, chunk.size(), pFile);
+	///
+	template <typename T, typename Allocator = EASTLAllocatorType>
+	class rope
+	{
+		typedef rope<T, Allocator>     this_type;
+		typedef Internal::rope_node<T> node_type;
+		typedef Internal::rope_chunk   chunk_type;
+
+	public:
+		typedef T                                         value_type;
+		typedef const T*                                  const_pointer;
+		typedef const T&                                  const_reference;
+		typedef eastl_size_t                              size_type;
+		typedef ptrdiff_t                                 difference_type;
+		typedef Allocator                                 allocator_type;
+		typedef basic_string_view<T>                      view_type;
+		typedef basic_string<T, Allocator>                string_type;
+		typedef rope_iterator<T, Allocator>               const_iterator;
+		typedef eastl::reverse_iterator<const_iterator>   const_reverse_iterator;
+		typedef rope_chunk_iterator<T, Allocator>         chunk_iterator;
+
+		static const size_type npos = (size_type)-1;
+
+		/// A range of chunk_iterators, for use with range-based for.
+		struct chunk_range
+		{
+			chunk_iterator mBegin;
+			chunk_iterator mEnd;
+
+			chunk_iterator begin() const { return mBegin; }
+			chunk_iterator end() const   { return mEnd; }
+		};
+
+	public:
+		rope() EA_NOEXCEPT_IF(EA_NOEXCEPT_EXPR(EASTL_ROPE_DEFAULT_ALLOCATOR));
+		explicit rope(const allocator_type& allocator) EA_NOEXCEPT;
+		rope(const value_type* p, const allocator_type& allocator = EASTL_ROPE_DEFAULT_ALLOCATOR);
+		rope(const value_type* p, size_type n, const allocator_type& allocator = EASTL_ROPE_DEFAULT_ALLOCATOR);
+		explicit rope(const view_type& sv, const allocator_type& allocator = EASTL_ROPE_DEFAULT_ALLOCATOR);
+		rope(const this_type& x);
+		rope(this_type&& x) EA_NOEXCEPT;
+	   ~rope();
+
+		template <typename OtherAllocator>
+		explicit rope(const basic_string<T, OtherAllocator>& x, const allocator_type& allocator = EASTL_ROPE_DEFAULT_ALLOCATOR);
+
+		this_type& operator=(const this_type& x);
+		this_type& operator=(this_type&& x);
+		this_type& operator=(const view_type& sv);
+		this_type& operator=(const value_type* p);
+
+		this_type& assign(const this_type& x);
+		this_type& assign(const view_type& sv);
+		this_type& assign(const value_type* p, size_type n);
+
+		void swap(this_type& x);
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT;
+		allocator_type&       get_allocator() EA_NOEXCEPT;
+		void                  set_allocator(const allocator_type& allocator);
+
+		const_iterator         begin() const EA_NOEXCEPT;
+		const_iterator         cbegin() const EA_NOEXCEPT;
+		const_iterator         end() const EA_NOEXCEPT;
+		const_iterator         cend() const EA_NOEXCEPT;
+		const_reverse_iterator rbegin() const EA_NOEXCEPT;
+		const_reverse_iterator crbegin() const EA_NOEXCEPT;
+		const_reverse_iterator rend() const EA_NOEXCEPT;
+		const_reverse_iterator crend() const EA_NOEXCEPT;
+
+		chunk_iterator chunk_begin(size_type position = 0) const;
+		chunk_iterator chunk_end() const;
+		chunk_range    chunks() const;
+
+		bool      empty() const EA_NOEXCEPT;
+		size_type size() const EA_NOEXCEPT;
+		size_type length() const EA_NOEXCEPT;
+		size_type max_size() const EA_NOEXCEPT;
+
+		const_reference operator[](size_type n) const;
+		const_reference at(size_type n) const;
+		const_reference front() const;
+		const_reference back() const;
+
+		this_type& operator+=(const this_type& x);
+		this_type& operator+=(const view_type& sv);
+		this_type& operator+=(const value_type* p);
+		this_type& operator+=(value_type c);
+
+		this_type& append(const this_type& x);
+		this_type& append(const view_type& sv);
+		this_type& append(const value_type* p);
+		this_type& append(const value_type* p, size_type n);
+		void       push_back(value_type c);
+		void       pop_back();
+
+		this_type& insert(size_type position, const this_type& x);
+		this_type& insert(size_type position, const view_type& sv);
+		this_type& insert(size_type position, const value_type* p);
+		this_type& insert(size_type position, const value_type* p, size_type n);
+
+		this_type& erase(size_type position = 0, size_type n = npos);
+		this_type& replace(size_type position, size_type n, const view_type& sv);
+		this_type& replace(size_type position, size_type n, const value_type* p);
+		void       clear() EA_NOEXCEPT;
+
+		this_type   substr(size_type position = 0, size_type n = npos) const;
+		size_type   copy(value_type* p, size_type n, size_type position = 0) const;
+		string_type str() const;
+
+		int compare(const this_type& x) const;
+		int compare(const view_type& sv) const;
+
+		bool validate() const;
+
+		// Comparisons with views are friends so that anything which converts to a view, such as a
+		// basic_string, can be compared with a rope.
+		friend bool operator==(const this_type& a, const view_type& b) { return (a.size() == b.size()) && (a.compare(b) == 0); }
+		friend bool operator==(const view_type& a, const this_type& b) { return (b == a); }
+		friend bool operator!=(const this_type& a, const view_type& b) { return !(a == b); }
+		friend bool operator!=(const view_type& a, const this_type& b) { return !(b == a); }
+
+	protected:
+		template <typename, typename> friend class rope_iterator;
+		template <typename, typename> friend class rope_chunk_iterator;
+
+		node_type*  mpRoot;      // NULL when empty. Pieces are never empty.
+		compressed_pair<size_type, allocator_type> mUnusedAllocator;
+
+		allocator_type&       internalAllocator() EA_NOEXCEPT       { return mUnusedAllocator.second(); }
+		const allocator_type& internalAllocator() const EA_NOEXCEPT { return mUnusedAllocator.second(); }
+
+		const T*   DoFindPiece(size_type position, size_type& nStart, size_type& nEnd) const;
+
+		node_type* DoCreatePiece(chunk_type* pChunk, const T* pData, size_type n);
+		node_type* DoCreatePiece(const T* p, size_type n);
+		node_type* DoCreatePiece(const T* p1, size_type n1, const T* p2, size_type n2);
+		node_type* DoCreateConcat(node_type* pLeft, node_type* pRight);
+		node_type* DoShare(const this_type& x);
+
+		static void DoAddRef(node_type* p) EA_NOEXCEPT;
+		void        DoRelease(node_type* p) EA_NOEXCEPT;
+
+		node_type* DoJoin(node_type* pLeft, node_type* pRight);
+		node_type* DoRotateLeft(node_type* p);
+		node_type* DoRotateRight(node_type* p);
+		void       DoSplit(node_type* p, size_type position, node_type*& pLeft, node_type*& pRight);
+		void       DoReplace(size_type position, size_type n, node_type* pNew);
+
+		static bool DoValidate(const node_type* p);
+		void        DoCheckPosition(size_type position, const char* pMessage) const;
+	}; // rope
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// rope
+	///////////////////////////////////////////////////////////////////////
+
+	// The allocator is stored in a compressed_pair so that the default allocator takes no space.
+	// The size_type half of the pair is unused; a rope's size is its root's length.
+
+	template <typename T, typename Allocator>
+	inline rope<T, Allocator>::rope() EA_NOEXCEPT_IF(EA_NOEXCEPT_EXPR(EASTL_ROPE_DEFAULT_ALLOCATOR))
+		: mpRoot(NULL), mUnusedAllocator(0, EASTL_ROPE_DEFAULT_ALLOCATOR)
+	{
+	}
+
+
+	template <typename T, typename Allocator>
+	inline rope<T, Allocator>::rope(const allocator_type& allocator) EA_NOEXCEPT
+		: mpRoot(NULL), mUnusedAllocator(0, allocator)
+	{
+	}
+
+
+	template <typename T, typename Allocator>
+	inline rope<T, Allocator>::rope(const value_type* p, const allocator_type& allocator)
+		: mpRoot(NULL), mUnusedAllocator(0, allocator)
+	{
+		assign(p, (size_type)CharStrlen(p));
+	}
+
+
+	template <typename T, typename Allocator>
+	inline rope<T, Allocator>::rope(const value_type* p, size_type n, const allocator_type& allocator)
+		: mpRoot(NULL), mUnusedAllocator(0, allocator)
+	{
+		assign(p, n);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline rope<T, Allocator>::rope(const view_type& sv, const allocator_type& allocator)
+		: mpRoot(NULL), mUnusedAllocator(0, allocator)
+	{
+		assign(sv.data(), sv.size());
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename OtherAllocator>
+	inline rope<T, Allocator>::rope(const basic_string<T, OtherAllocator>& x, const allocator_type& allocator)
+		: mpRoot(NULL), mUnusedAllocator(0, allocator)
+	{
+		assign(x.data(), x.size());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline rope<T, Allocator>::rope(const this_type& x)
+		: mpRoot(x.mpRoot), mUnusedAllocator(0, x.internalAllocator())
+	{
+		DoAddRef(mpRoot);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline rope<T, Allocator>::rope(this_type&& x) EA_NOEXCEPT
+		: mpRoot(x.mpRoot), mUnusedAllocator(0, x.internalAllocator())
+	{
+		x.mpRoot = NULL;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline rope<T, Allocator>::~rope()
+	{
+		DoRelease(mpRoot);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::operator=(const this_type& x)
+	{
+		return assign(x);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::operator=(this_type&& x)
+	{
+		if(internalAllocator() == x.internalAllocator())
+			eastl::swap(mpRoot, x.mpRoot);
+		else
+			assign(x);
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::operator=(const view_type& sv)
+	{
+		return assign(sv.data(), sv.size());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::operator=(const value_type* p)
+	{
+		return assign(p, (size_type)CharStrlen(p));
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::assign(const this_type& x)
+	{
+		node_type* const pNew = DoShare(x); // Before releasing, in case x is *this.
+		DoRelease(mpRoot);
+		mpRoot = pNew;
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::assign(const view_type& sv)
+	{
+		return assign(sv.data(), sv.size());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::assign(const value_type* p, size_type n)
+	{
+		node_type* const pNew = n ? DoCreatePiece(p, n) : NULL; // Before releasing, in case p points into this rope.
+		DoRelease(mpRoot);
+		mpRoot = pNew;
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void rope<T, Allocator>::swap(this_type& x)
+	{
+		if(internalAllocator() == x.internalAllocator())
+			eastl::swap(mpRoot, x.mpRoot);
+		else
+		{
+			const this_type temp(*this); // Can't call eastl::swap because that would
+			*this = x;                   // itself call this member swap function.
+			x     = temp;
+		}
+	}
+
+
+	template <typename T, typename Allocator>
+	inline const typename rope<T, Allocator>::allocator_type&
+	rope<T, Allocator>::get_allocator() const EA_NOEXCEPT
+	{
+		return internalAllocator();
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::allocator_type&
+	rope<T, Allocator>::get_allocator() EA_NOEXCEPT
+	{
+		return internalAllocator();
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void rope<T, Allocator>::set_allocator(const allocator_type& allocator)
+	{
+		internalAllocator() = allocator;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_iterator rope<T, Allocator>::begin() const EA_NOEXCEPT
+	{
+		return const_iterator(this, 0);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_iterator rope<T, Allocator>::cbegin() const EA_NOEXCEPT
+	{
+		return const_iterator(this, 0);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_iterator rope<T, Allocator>::end() const EA_NOEXCEPT
+	{
+		return const_iterator(this, size());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_iterator rope<T, Allocator>::cend() const EA_NOEXCEPT
+	{
+		return const_iterator(this, size());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_reverse_iterator rope<T, Allocator>::rbegin() const EA_NOEXCEPT
+	{
+		return const_reverse_iterator(end());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_reverse_iterator rope<T, Allocator>::crbegin() const EA_NOEXCEPT
+	{
+		return const_reverse_iterator(end());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_reverse_iterator rope<T, Allocator>::rend() const EA_NOEXCEPT
+	{
+		return const_reverse_iterator(begin());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_reverse_iterator rope<T, Allocator>::crend() const EA_NOEXCEPT
+	{
+		return const_reverse_iterator(begin());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::chunk_iterator rope<T, Allocator>::chunk_begin(size_type position) const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(position > size()))
+				EASTL_FAIL_MSG("rope::chunk_begin -- invalid position");
+		#endif
+
+		return chunk_iterator(this, position);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::chunk_iterator rope<T, Allocator>::chunk_end() const
+	{
+		return chunk_iterator(this, size());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::chunk_range rope<T, Allocator>::chunks() const
+	{
+		const chunk_range range = { chunk_begin(), chunk_end() };
+		return range;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool rope<T, Allocator>::empty() const EA_NOEXCEPT
+	{
+		return (mpRoot == NULL);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::size_type rope<T, Allocator>::size() const EA_NOEXCEPT
+	{
+		return mpRoot ? mpRoot->mnLength : 0;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::size_type rope<T, Allocator>::length() const EA_NOEXCEPT
+	{
+		return size();
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::size_type rope<T, Allocator>::max_size() const EA_NOEXCEPT
+	{
+		return (size_type)-2;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_reference rope<T, Allocator>::operator[](size_type n) const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n >= size()))
+				EASTL_FAIL_MSG("rope::operator[] -- out of range");
+		#endif
+
+		size_type nStart, nEnd;
+		return DoFindPiece(n, nStart, nEnd)[n - nStart];
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_reference rope<T, Allocator>::at(size_type n) const
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			if(EASTL_UNLIKELY(n >= size()))
+				throw std::out_of_range("rope::at -- out of range");
+		#elif EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n >= size()))
+				EASTL_FAIL_MSG("rope::at -- out of range");
+		#endif
+
+		size_type nStart, nEnd;
+		return DoFindPiece(n, nStart, nEnd)[n - nStart];
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_reference rope<T, Allocator>::front() const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(empty()))
+				EASTL_FAIL_MSG("rope::front -- empty rope");
+		#endif
+
+		return operator[](0);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::const_reference rope<T, Allocator>::back() const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(empty()))
+				EASTL_FAIL_MSG("rope::back -- empty rope");
+		#endif
+
+		return operator[](size() - 1);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::operator+=(const this_type& x)
+	{
+		return append(x);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::operator+=(const view_type& sv)
+	{
+		return append(sv.data(), sv.size());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::operator+=(const value_type* p)
+	{
+		return append(p, (size_type)CharStrlen(p));
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::operator+=(value_type c)
+	{
+		return append(&c, 1);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::append(const this_type& x)
+	{
+		mpRoot = DoJoin(mpRoot, DoShare(x));
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::append(const view_type& sv)
+	{
+		return append(sv.data(), sv.size());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::append(const value_type* p)
+	{
+		return append(p, (size_type)CharStrlen(p));
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::append(const value_type* p, size_type n)
+	{
+		if(n)
+			mpRoot = DoJoin(mpRoot, DoCreatePiece(p, n));
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void rope<T, Allocator>::push_back(value_type c)
+	{
+		append(&c, 1);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void rope<T, Allocator>::pop_back()
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(empty()))
+				EASTL_FAIL_MSG("rope::pop_back -- empty rope");
+		#endif
+
+		DoReplace(size() - 1, 1, NULL);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::insert(size_type position, const this_type& x)
+	{
+		DoCheckPosition(position, "rope::insert -- invalid position");
+		DoReplace(position, 0, DoShare(x));
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::insert(size_type position, const view_type& sv)
+	{
+		return insert(position, sv.data(), sv.size());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::insert(size_type position, const value_type* p)
+	{
+		return insert(position, p, (size_type)CharStrlen(p));
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::insert(size_type position, const value_type* p, size_type n)
+	{
+		DoCheckPosition(position, "rope::insert -- invalid position");
+		if(n)
+			DoReplace(position, 0, DoCreatePiece(p, n));
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::erase(size_type position, size_type n)
+	{
+		DoCheckPosition(position, "rope::erase -- invalid position");
+		n = eastl::min_alt(n, size() - position);
+		if(n)
+			DoReplace(position, n, NULL);
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::replace(size_type position, size_type n, const view_type& sv)
+	{
+		DoCheckPosition(position, "rope::replace -- invalid position");
+		DoReplace(position, eastl::min_alt(n, size() - position), sv.empty() ? NULL : DoCreatePiece(sv.data(), sv.size()));
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::this_type& rope<T, Allocator>::replace(size_type position, size_type n, const value_type* p)
+	{
+		return replace(position, n, view_type(p));
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void rope<T, Allocator>::clear() EA_NOEXCEPT
+	{
+		DoRelease(mpRoot);
+		mpRoot = NULL;
+	}
+
+
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::this_type rope<T, Allocator>::substr(size_type position, size_type n) const
+	{
+		DoCheckPosition(position, "rope::substr -- invalid position");
+		n = eastl::min_alt(n, size() - position);
+
+		// The result has a copy of our allocator, so it can create and release our nodes.
+		this_type  result(internalAllocator());
+		node_type* pLeft;
+		node_type* pRest;
+		node_type* pRight;
+
+		result.DoSplit(mpRoot, position, pLeft, pRest);
+		result.DoSplit(pRest, n, result.mpRoot, pRight);
+
+		result.DoRelease(pLeft);
+		result.DoRelease(pRest);
+		result.DoRelease(pRight);
+
+		return result;
+	}
+
+
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::size_type rope<T, Allocator>::copy(value_type* p, size_type n, size_type position) const
+	{
+		DoCheckPosition(position, "rope::copy -- invalid position");
+		n = eastl::min_alt(n, size() - position);
+
+		size_type nCopied = 0;
+		for(chunk_iterator it = chunk_begin(position); nCopied < n; ++it)
+		{
+			const size_type nChunk = eastl::min_alt(it->size(), n - nCopied);
+			memcpy(p + nCopied, it->data(), nChunk * sizeof(value_type));
+			nCopied += nChunk;
+		}
+
+		return n;
+	}
+
+
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::string_type rope<T, Allocator>::str() const
+	{
+		string_type result(internalAllocator());
+		result.reserve(size());
+
+		for(chunk_iterator it = chunk_begin(), itEnd = chunk_end(); it != itEnd; ++it)
+			result.append(it->data(), it->data() + it->size());
+
+		return result;
+	}
+
+
+	template <typename T, typename Allocator>
+	int rope<T, Allocator>::compare(const this_type& x) const
+	{
+		chunk_iterator it1 = chunk_begin(), it1End = chunk_end();
+		chunk_iterator it2 = x.chunk_begin(), it2End = x.chunk_end();
+		view_type      v1, v2;
+
+		for(;;)
+		{
+			if(v1.empty())
+			{
+				if(it1 == it1End)
+					break;
+				v1 = *it1++;
+			}
+
+			if(v2.empty())
+			{
+				if(it2 == it2End)
+					break;
+				v2 = *it2++;
+			}
+
+			const size_type n = eastl::min_alt(v1.size(), v2.size());
+			const int nResult = Compare(v1.data(), v2.data(), n);
+			if(nResult != 0)
+				return nResult;
+
+			v1.remove_prefix(n);
+			v2.remove_prefix(n);
+		}
+
+		return (size() < x.size()) ? -1 : ((size() > x.size()) ? 1 : 0);
+	}
+
+
+	template <typename T, typename Allocator>
+	int rope<T, Allocator>::compare(const view_type& sv) const
+	{
+		view_type rest(sv);
+
+		for(chunk_iterator it = chunk_begin(), itEnd = chunk_end(); (it != itEnd) && !rest.empty(); ++it)
+		{
+			const size_type n = eastl::min_alt(it->size(), rest.size());
+			const int nResult = Compare(it->data(), rest.data(), n);
+			if(nResult != 0)
+				return nResult;
+
+			rest.remove_prefix(n);
+		}
+
+		return (size() < sv.size()) ? -1 : ((size() > sv.size()) ? 1 : 0);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool rope<T, Allocator>::validate() const
+	{
+		return DoValidate(mpRoot);
+	}
+
+
+	template <typename T, typename Allocator>
+	const T* rope<T, Allocator>::DoFindPiece(size_type position, size_type& nStart, size_type& nEnd) const
+	{
+		EASTL_ASSERT(position < size());
+
+		const node_type* p = mpRoot;
+		nStart = 0;
+
+		while(p->mnHeight)
+		{
+			if(position < p->mpLeft->mnLength)
+				p = p->mpLeft;
+			else
+			{
+				position -= p->mpLeft->mnLength;
+				nStart   += p->mpLeft->mnLength;
+				p         = p->mpRight;
+			}
+		}
+
+		nEnd = nStart + p->mnLength;
+		return p->mpData;
+	}
+
+
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::node_type* rope<T, Allocator>::DoCreatePiece(chunk_type* pChunk, const T* pData, size_type n)
+	{
+		node_type* const p = ::new(allocate_memory(internalAllocator(), sizeof(node_type), EASTL_ALIGN_OF(node_type), 0)) node_type;
+
+		p->mRefCount.store(1, std::memory_order_relaxed);
+		p->mnHeight = 0;
+		p->mnLength = n;
+		p->mpLeft   = NULL;
+		p->mpRight  = NULL;
+		p->mpChunk  = pChunk;
+		p->mpData   = pData;
+
+		pChunk->mRefCount.fetch_add(1, std::memory_order_relaxed);
+		return p;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename rope<T, Allocator>::node_type* rope<T, Allocator>::DoCreatePiece(const T* p, size_type n)
+	{
+		return DoCreatePiece(p, n, NULL, 0);
+	}
+
+
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::node_type* rope<T, Allocator>::DoCreatePiece(const T* p1, size_type n1, const T* p2, size_type n2)
+	{
+		const size_type nAllocSize = sizeof(chunk_type) + ((n1 + n2) * sizeof(T));
+		chunk_type* const pChunk = ::new(allocate_memory(internalAllocator(), nAllocSize, EASTL_ALIGN_OF(chunk_type), 0)) chunk_type;
+
+		pChunk->mRefCount.store(0, std::memory_order_relaxed);
+		pChunk->mnAllocSize = nAllocSize;
+
+		T* const pData = reinterpret_cast<T*>(pChunk + 1);
+		if(p1) // NULL leaves the characters for the caller to fill in.
+			memcpy(pData, p1, n1 * sizeof(T));
+		if(n2)
+			memcpy(pData + n1, p2, n2 * sizeof(T));
+
+		return DoCreatePiece(pChunk, pData, n1 + n2);
+	}
+
+
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::node_type* rope<T, Allocator>::DoCreateConcat(node_type* pLeft, node_type* pRight)
+	{
+		node_type* const p = ::new(allocate_memory(internalAllocator(), sizeof(node_type), EASTL_ALIGN_OF(node_type), 0)) node_type;
+
+		p->mRefCount.store(1, std::memory_order_relaxed);
+		p->mnHeight = 1 + eastl::max_alt(pLeft->mnHeight, pRight->mnHeight);
+		p->mnLength = pLeft->mnLength + pRight->mnLength;
+		p->mpLeft   = pLeft;
+		p->mpRight  = pRight;
+		p->mpChunk  = NULL;
+		p->mpData   = NULL;
+
+		return p;
+	}
+
+
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::node_type* rope<T, Allocator>::DoShare(const this_type& x)
+	{
+		if(internalAllocator() == x.internalAllocator())
+		{
+			DoAddRef(x.mpRoot);
+			return x.mpRoot;
+		}
+
+		// x's nodes will be freed with x's allocator, so copy its characters into a single new piece.
+		if(x.empty())
+			return NULL;
+
+		node_type* const p = DoCreatePiece(NULL, x.size(), NULL, 0);
+		x.copy(const_cast<T*>(p->mpData), x.size());
+		return p;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void rope<T, Allocator>::DoAddRef(node_type* p) EA_NOEXCEPT
+	{
+		if(p)
+			p->mRefCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+
+	template <typename T, typename Allocator>
+	void rope<T, Allocator>::DoRelease(node_type* p) EA_NOEXCEPT
+	{
+		// The recursion is bounded by the height of the tree.
+		if(p && (p->mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1))
+		{
+			if(p->mnHeight == 0)
+			{
+				chunk_type* const pChunk = p->mpChunk;
+
+				if(pChunk->mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					const size_type nAllocSize = pChunk->mnAllocSize;
+					pChunk->~chunk_type();
+					EASTLFree(internalAllocator(), pChunk, nAllocSize);
+				}
+			}
+			else
+			{
+				DoRelease(p->mpLeft);
+				DoRelease(p->mpRight);
+			}
+
+			p->~node_type();
+			EASTLFree(internalAllocator(), p, sizeof(node_type));
+		}
+	}
+
+
+	// Concatenates two trees, taking ownership of the references to both. This is the join
+	// of AVL trees: the shorter tree is attached where the taller tree's spine reaches its
+	// height, and the nodes on the way back up are rebuilt and rotated as needed. As nodes
+	// are shared, nothing is modified; the nodes along the spine are replaced by new ones.
+	// The cost is O(difference in heights).
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::node_type* rope<T, Allocator>::DoJoin(node_type* pLeft, node_type* pRight)
+	{
+		if(!pLeft)
+			return pRight;
+		if(!pRight)
+			return pLeft;
+
+		if((pLeft->mnHeight == 0) && (pRight->mnHeight == 0))
+		{
+			node_type* pMerged = NULL;
+
+			if((pLeft->mpChunk == pRight->mpChunk) && ((pLeft->mpData + pLeft->mnLength) == pRight->mpData))
+				pMerged = DoCreatePiece(pLeft->mpChunk, pLeft->mpData, pLeft->mnLength + pRight->mnLength); // Rejoining a split piece.
+			else if((pLeft->mnLength + pRight->mnLength) <= EASTL_ROPE_MERGE_LENGTH)
+				pMerged = DoCreatePiece(pLeft->mpData, pLeft->mnLength, pRight->mpData, pRight->mnLength);
+
+			if(pMerged)
+			{
+				DoRelease(pLeft);
+				DoRelease(pRight);
+				return pMerged;
+			}
+		}
+
+		// A short piece is always taken down the spine, so that it's merged with the piece next to it.
+		if((pLeft->mnHeight > (pRight->mnHeight + 1)) ||
+		   ((pLeft->mnHeight != 0) && (pRight->mnHeight == 0) && (pRight->mnLength < EASTL_ROPE_MERGE_LENGTH)))
+		{
+			node_type* const pA = pLeft->mpLeft;
+			node_type* const pB = pLeft->mpRight;
+
+			DoAddRef(pA);
+			DoAddRef(pB);
+			DoRelease(pLeft);
+
+			node_type* pJoined = DoJoin(pB, pRight);
+
+			if(pJoined->mnHeight <= (pA->mnHeight + 1))
+				return DoCreateConcat(pA, pJoined);
+
+			// pJoined is at most two taller than pA.
+			if(pJoined->mpLeft->mnHeight > pJoined->mpRight->mnHeight)
+				pJoined = DoRotateRight(pJoined);
+			return DoRotateLeft(DoCreateConcat(pA, pJoined));
+		}
+
+		if((pRight->mnHeight > (pLeft->mnHeight + 1)) ||
+		   ((pRight->mnHeight != 0) && (pLeft->mnHeight == 0) && (pLeft->mnLength < EASTL_ROPE_MERGE_LENGTH)))
+		{
+			node_type* const pB = pRight->mpLeft;
+			node_type* const pC = pRight->mpRight;
+
+			DoAddRef(pB);
+			DoAddRef(pC);
+			DoRelease(pRight);
+
+			node_type* pJoined = DoJoin(pLeft, pB);
+
+			if(pJoined->mnHeight <= (pC->mnHeight + 1))
+				return DoCreateConcat(pJoined, pC);
+
+			if(pJoined->mpRight->mnHeight > pJoined->mpLeft->mnHeight)
+				pJoined = DoRotateLeft(pJoined);
+			return DoRotateRight(DoCreateConcat(pJoined, pC));
+		}
+
+		return DoCreateConcat(pLeft, pRight);
+	}
+
+
+	// (A, (B, C)) -> ((A, B), C), taking ownership of the reference to p.
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::node_type* rope<T, Allocator>::DoRotateLeft(node_type* p)
+	{
+		node_type* const pA = p->mpLeft;
+		node_type* const pB = p->mpRight->mpLeft;
+		node_type* const pC = p->mpRight->mpRight;
+
+		DoAddRef(pA);
+		DoAddRef(pB);
+		DoAddRef(pC);
+		DoRelease(p);
+
+		return DoCreateConcat(DoCreateConcat(pA, pB), pC);
+	}
+
+
+	// ((A, B), C) -> (A, (B, C)), taking ownership of the reference to p.
+	template <typename T, typename Allocator>
+	typename rope<T, Allocator>::node_type* rope<T, Allocator>::DoRotateRight(node_type* p)
+	{
+		node_type* const pA = p->mpLeft->mpLeft;
+		node_type* const pB = p->mpLeft->mpRight;
+		node_type* const pC = p->mpRight;
+
+		DoAddRef(pA);
+		DoAddRef(pB);
+		DoAddRef(pC);
+		DoRelease(p);
+
+		return DoCreateConcat(pA, DoCreateConcat(pB, pC));
+	}
+
+
+	// Splits the tree p (which is borrowed, not consumed) into new references to trees
+	// holding its first position characters and the rest. A piece is split by making two
+	// pieces which refer to the same chunk, so no characters are copied.
+	template <typename T, typename Allocator>
+	void rope<T, Allocator>::DoSplit(node_type* p, size_type position, node_type*& pLeft, node_type*& pRight)
+	{
+		if(!p || (position == 0))
+		{
+			pLeft  = NULL;
+			pRight = p;
+			DoAddRef(p);
+		}
+		else if(position >= p->mnLength)
+		{
+			pLeft  = p;
+			pRight = NULL;
+			DoAddRef(p);
+		}
+		else if(p->mnHeight == 0)
+		{
+			pLeft  = DoCreatePiece(p->mpChunk, p->mpData, position);
+			pRight = DoCreatePiece(p->mpChunk, p->mpData + position, p->mnLength - position);
+		}
+		else if(position < p->mpLeft->mnLength)
+		{
+			node_type* pMiddle;
+			DoSplit(p->mpLeft, position, pLeft, pMiddle);
+			DoAddRef(p->mpRight);
+			pRight = DoJoin(pMiddle, p->mpRight);
+		}
+		else
+		{
+			node_type* pMiddle;
+			DoSplit(p->mpRight, position - p->mpLeft->mnLength, pMiddle, pRight);
+			DoAddRef(p->mpLeft);
+			pLeft = DoJoin(p->mpLeft, pMiddle);
+		}
+	}
+
+
+	// Replaces the n characters at position with the tree pNew (which may be NULL), taking
+	// ownership of the reference to pNew.
+	template <typename T, typename Allocator>
+	void rope<T, Allocator>::DoReplace(size_type position, size_type n, node_type* pNew)
+	{
+		node_type* pLeft;
+		node_type* pRest;
+		node_type* pErased;
+		node_type* pRight;
+
+		DoSplit(mpRoot, position, pLeft, pRest);
+		DoSplit(pRest, n, pErased, pRight);
+
+		DoRelease(pRest);
+		DoRelease(pErased);
+		DoRelease(mpRoot);
+
+		mpRoot = DoJoin(DoJoin(pLeft, pNew), pRight);
+	}
+
+
+	template <typename T, typename Allocator>
+	bool rope<T, Allocator>::DoValidate(const node_type* p)
+	{
+		if(!p)
+			return true;
+
+		if(p->mRefCount.load(std::memory_order_relaxed) <= 0)
+			return false;
+
+		if(p->mnHeight == 0)
+		{
+			const T* const pChunkData = reinterpret_cast<const T*>(p->mpChunk + 1);
+			const T* const pChunkEnd  = reinterpret_cast<const T*>(reinterpret_cast<const char*>(p->mpChunk) + p->mpChunk->mnAllocSize);
+
+			return (p->mnLength != 0) && !p->mpLeft && !p->mpRight && (p->mpChunk->mRefCount.load(std::memory_order_relaxed) > 0) &&
+				   (p->mpData >= pChunkData) && ((p->mpData + p->mnLength) <= pChunkEnd);
+		}
+
+		if(!p->mpLeft || !p->mpRight)
+			return false;
+
+		const int32_t nHeightDifference = p->mpLeft->mnHeight - p->mpRight->mnHeight;
+
+		return (p->mnHeight == (1 + eastl::max_alt(p->mpLeft->mnHeight, p->mpRight->mnHeight))) &&
+			   (nHeightDifference >= -1) && (nHeightDifference <= 1) &&
+			   (p->mnLength == (p->mpLeft->mnLength + p->mpRight->mnLength)) &&
+			   DoValidate(p->mpLeft) && DoValidate(p->mpRight);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void rope<T, Allocator>::DoCheckPosition(size_type position, const char* pMessage) const
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			if(EASTL_UNLIKELY(position > size()))
+				throw std::out_of_range(pMessage);
+		#elif EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(position > size()))
+				EASTL_FAIL_MSG(pMessage);
+		#else
+			EA_UNUSED(position);
+			EA_UNUSED(pMessage);
+		#endif
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Allocator>
+	inline rope<T, Allocator> operator+(const rope<T, Allocator>& a, const rope<T, Allocator>& b)
+	{
+		rope<T, Allocator> result(a);
+		result.append(b);
+		return result;
+	}
+
+	template <typename T, typename Allocator>
+	inline bool operator==(const rope<T, Allocator>& a, const rope<T, Allocator>& b)
+	{
+		return (a.size() == b.size()) && (a.compare(b) == 0);
+	}
+
+	template <typename T, typename Allocator>
+	inline bool operator!=(const rope<T, Allocator>& a, const rope<T, Allocator>& b)
+	{
+		return !(a == b);
+	}
+
+	template <typename T, typename Allocator>
+	inline bool operator<(const rope<T, Allocator>& a, const rope<T, Allocator>& b)
+	{
+		return a.compare(b) < 0;
+	}
+
+	template <typename T, typename Allocator>
+	inline bool operator>(const rope<T, Allocator>& a, const rope<T, Allocator>& b)
+	{
+		return a.compare(b) > 0;
+	}
+
+	template <typename T, typename Allocator>
+	inline bool operator<=(const rope<T, Allocator>& a, const rope<T, Allocator>& b)
+	{
+		return a.compare(b) <= 0;
+	}
+
+	template <typename T, typename Allocator>
+	inline bool operator>=(const rope<T, Allocator>& a, const rope<T, Allocator>& b)
+	{
+		return a.compare(b) >= 0;
+	}
+
+	template <typename T, typename Allocator>
+	inline void swap(rope<T, Allocator>& a, rope<T, Allocator>& b)
+	{
+		a.swap(b);
+	}
+
+} // namespace eastl
+
+
+EA_RESTORE_VC_WARNING();
@@ -1045,4 +1045,9 @@ namespace eastl
 	{
 		a.swap(b);
 	}
+
+	// segmented_vector's segments and free list are all heap memory which never points back into the container,
+	// so it can be relocated with memcpy whenever its allocator can.
+	template <typename T, size_t Count, typename Allocator>
+	struct is_trivially_relocatable<segmented_vector<T, Count, Allocator>> : public is_trivially_relocatable<Allocator> {};
 }
\ No newline at end of file
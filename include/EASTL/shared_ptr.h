@@ -200,21 +200,23 @@ namespace eastl
 	/// ref_count_sp_t
 	///
 	/// This is a version of ref_count_sp which is used to delete the contained pointer.
-	template <typename T, typename Allocator, typename Deleter>
-	class ref_count_sp_t : public ref_count_sp
+	/// RefCountBase is the reference count that it derives from; local_shared_ptr uses
+	/// this with its non-atomic ref_count_lsp.
+	template <typename T, typename Allocator, typename Deleter, typename RefCountBase = ref_count_sp>
+	class ref_count_sp_t : public RefCountBase
 	{
 	public:
-		typedef ref_count_sp_t<T, Allocator, Deleter>   this_type;
-		typedef T                                       value_type;
-		typedef Allocator                               allocator_type;
-		typedef Deleter                                 deleter_type;
+		typedef ref_count_sp_t<T, Allocator, Deleter, RefCountBase> this_type;
+		typedef T                                                   value_type;
+		typedef Allocator                                           allocator_type;
+		typedef Deleter                                             deleter_type;
 
 		value_type     mValue; // This is expected to be a pointer.
 		deleter_type   mDeleter;
 		allocator_type mAllocator;
 
 		ref_count_sp_t(value_type value, deleter_type deleter, allocator_type allocator)
-			: ref_count_sp(), mValue(value), mDeleter(eastl::move(deleter)), mAllocator(eastl::move(allocator))
+			: RefCountBase(), mValue(value), mDeleter(eastl::move(deleter)), mAllocator(eastl::move(allocator))
 		{}
 
 		void free_value() EA_NOEXCEPT
@@ -248,11 +250,11 @@ namespace eastl
 	/// This is a version of ref_count_sp which is used to actually hold an instance of
 	/// T (instead of a pointer). This is useful to allocate the object and ref count
 	/// in a single memory allocation.
-	template<typename T, typename Allocator>
-	class ref_count_sp_t_inst : public ref_count_sp
+	template<typename T, typename Allocator, typename RefCountBase = ref_count_sp>
+	class ref_count_sp_t_inst : public RefCountBase
 	{
 	public:
-		typedef ref_count_sp_t_inst<T, Allocator>                                        this_type;
+		typedef ref_count_sp_t_inst<T, Allocator, RefCountBase>                          this_type;
 		typedef T                                                                        value_type;
 		typedef Allocator                                                                allocator_type;
 		typedef typename aligned_storage<sizeof(T), eastl::alignment_of<T>::value>::type storage_type;
@@ -264,7 +266,7 @@ namespace eastl
 
 		template <typename... Args>
 		ref_count_sp_t_inst(allocator_type allocator, Args&&... args)
-			: ref_count_sp(), mAllocator(eastl::move(allocator))
+			: RefCountBase(), mAllocator(eastl::move(allocator))
 		{
 			new (&mMemory) value_type(eastl::forward<Args>(args)...);
 		}
@@ -938,6 +940,11 @@ namespace eastl
 	}; // class shared_ptr
 
 
+	// shared_ptr is a pair of pointers; the reference counts live in the control block, not in the object.
+	template <typename T>
+	struct is_trivially_relocatable<shared_ptr<T>> : public true_type {};
+
+
 	/// get_pointer
 	/// returns shared_ptr::get() via the input shared_ptr. 
 	template <typename T>
@@ -1276,8 +1283,12 @@ namespace eastl
 	template <typename T>
 	inline void atomic_store(shared_ptr<T>* pSharedPtrA, shared_ptr<T> sharedPtrB)
 	{
-		Internal::shared_ptr_auto_mutex autoMutex(pSharedPtrA);
-		pSharedPtrA->swap(sharedPtrB);
+		shared_ptr<T> sharedPtrPrev; // Released after the mutex is unlocked (see atomic_compare_exchange_strong).
+		{
+			Internal::shared_ptr_auto_mutex autoMutex(pSharedPtrA);
+			pSharedPtrA->swap(sharedPtrB);
+			sharedPtrPrev.swap(sharedPtrB);
+		}
 	}
 
 	template <typename T>
@@ -1289,9 +1300,13 @@ namespace eastl
 	template <typename T>
 	shared_ptr<T> atomic_exchange(shared_ptr<T>* pSharedPtrA, shared_ptr<T> sharedPtrB)
 	{
-		Internal::shared_ptr_auto_mutex autoMutex(pSharedPtrA);
-		pSharedPtrA->swap(sharedPtrB);
-		return sharedPtrB;
+		shared_ptr<T> sharedPtrPrev; // Returned to the caller, so it's only released after the mutex is unlocked.
+		{
+			Internal::shared_ptr_auto_mutex autoMutex(pSharedPtrA);
+			pSharedPtrA->swap(sharedPtrB);
+			sharedPtrPrev.swap(sharedPtrB);
+		}
+		return sharedPtrPrev;
 	}
   
 	template <typename T>
@@ -1304,18 +1319,29 @@ namespace eastl
 	// same pointer and refer to the same pointer), assigns sharedPtrNew into *pSharedPtr using the memory ordering constraints 
 	// specified by success and returns true. If they are not equivalent, assigns *pSharedPtr into *pSharedPtrCondition using the 
 	// memory ordering constraints specified by failure and returns false.
+	//
+	// A value which is replaced is moved into sharedPtrPrev and released after the mutex is
+	// unlocked. Releasing the last reference runs the object's destructor, which may use these
+	// functions on another shared_ptr, and so lock another of the mutexes. If two threads did
+	// that while still holding their own mutexes, each could wait for the other's.
 	template <typename T>
 	bool atomic_compare_exchange_strong(shared_ptr<T>* pSharedPtr, shared_ptr<T>* pSharedPtrCondition, shared_ptr<T> sharedPtrNew)
 	{
-		Internal::shared_ptr_auto_mutex autoMutex(pSharedPtr);
-
-		if(pSharedPtr->equivalent_ownership(*pSharedPtrCondition))
+		shared_ptr<T> sharedPtrPrev;
 		{
-			*pSharedPtr = sharedPtrNew;
-			return true;
+			Internal::shared_ptr_auto_mutex autoMutex(pSharedPtr);
+
+			if(pSharedPtr->equivalent_ownership(*pSharedPtrCondition))
+			{
+				pSharedPtr->swap(sharedPtrNew);
+				sharedPtrPrev.swap(sharedPtrNew);
+				return true;
+			}
+
+			sharedPtrPrev = *pSharedPtr;
 		}
 
-		*pSharedPtrCondition = *pSharedPtr;
+		pSharedPtrCondition->swap(sharedPtrPrev); // sharedPtrPrev now holds the previous condition.
 		return false;
 	}
 
@@ -1340,6 +1366,218 @@ namespace eastl
 
 
 
+	///////////////////////////////////////////////////////////////////////////
+	// atomic_shared_ptr
+	///////////////////////////////////////////////////////////////////////////
+
+	/// EASTL_ATOMIC_SHARED_PTR_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_ATOMIC_SHARED_PTR_DEFAULT_NAME
+		#define EASTL_ATOMIC_SHARED_PTR_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " atomic_shared_ptr" // Unless the user overrides something, this is "EASTL atomic_shared_ptr".
+	#endif
+
+
+	/// EASTL_ATOMIC_SHARED_PTR_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_ATOMIC_SHARED_PTR_DEFAULT_ALLOCATOR
+		#define EASTL_ATOMIC_SHARED_PTR_DEFAULT_ALLOCATOR allocator_type(EASTL_ATOMIC_SHARED_PTR_DEFAULT_NAME)
+	#endif
+
+
+	/// atomic_shared_ptr
+	///
+	/// A shared_ptr which may be loaded and replaced by several threads at once, like
+	/// the C++20 std::atomic<std::shared_ptr<T>>. It is meant for data which is read
+	/// far more often than it is replaced, such as a configuration snapshot which many
+	/// threads read and one thread occasionally republishes.
+	///
+	/// Loads don't take a lock, so readers never wait for each other or for writers.
+	/// The atomic functions for plain shared_ptr above instead lock a mutex chosen by
+	/// the shared_ptr's address, which every reader of that shared_ptr contends on.
+	///
+	/// The shared_ptr is kept in a small heap block, and the atomic_shared_ptr holds an
+	/// atomic pointer to that block. A load protects the block with a hazard pointer
+	/// (see Internal::shared_ptr_hazard) and copies the shared_ptr out of it. A store
+	/// allocates a new block, swaps it in, and then waits until no load still has the
+	/// old block protected before it destroys it. A load holds its protection only for
+	/// as long as it takes to copy a shared_ptr, so that wait is short, but it means
+	/// that stores, exchanges and compare-exchanges are not lock-free. is_lock_free
+	/// returns false for that reason.
+	///
+	/// Because of the wait, the reference that the atomic_shared_ptr held is always
+	/// released by the thread which replaced it, before the store returns.
+	///
+	/// All operations are sequentially consistent, whatever memory order is passed.
+	///
+	/// Example usage:
+	///     atomic_shared_ptr<const Config> gConfig(make_shared<const Config>());
+	///
+	///     // Any number of reader threads:
+	///     shared_ptr<const Config> pConfig = gConfig.load();
+	///
+	///     // A writer thread:
+	///     gConfig.store(make_shared<const Config>(LoadConfig()));
+	///
+	template <typename T>
+	class atomic_shared_ptr
+	{
+	public:
+		typedef atomic_shared_ptr<T>  this_type;
+		typedef shared_ptr<T>         value_type;
+		typedef EASTLAllocatorType    allocator_type;
+
+		static EA_CONSTEXPR_OR_CONST bool is_always_lock_free = false;
+
+	public:
+		atomic_shared_ptr() EA_NOEXCEPT
+			: mpBox(NULL), mAllocator(EASTL_ATOMIC_SHARED_PTR_DEFAULT_ALLOCATOR) {}
+
+		atomic_shared_ptr(value_type sharedPtr, const allocator_type& allocator = EASTL_ATOMIC_SHARED_PTR_DEFAULT_ALLOCATOR)
+			: mpBox(NULL), mAllocator(allocator)
+			{ mpBox.store(DoCreateBox(sharedPtr), std::memory_order_relaxed); }
+
+		~atomic_shared_ptr()
+			{ DoDestroyBox(mpBox.load(std::memory_order_relaxed)); }
+
+		atomic_shared_ptr(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+		this_type& operator=(value_type sharedPtr)
+			{ store(eastl::move(sharedPtr)); return *this; }
+
+		operator value_type() const
+			{ return load(); }
+
+		bool is_lock_free() const EA_NOEXCEPT
+			{ return false; }
+
+		value_type load(std::memory_order = std::memory_order_seq_cst) const
+		{
+			Internal::shared_ptr_hazard hazard;
+			box_type* const pBox = hazard.protect(mpBox);
+
+			return pBox ? pBox->mSharedPtr : value_type(); // The copy is made before hazard lets go of the box.
+		}
+
+		void store(value_type sharedPtr, std::memory_order memoryOrder = std::memory_order_seq_cst)
+		{
+			exchange(eastl::move(sharedPtr), memoryOrder);
+		}
+
+		value_type exchange(value_type sharedPtr, std::memory_order = std::memory_order_seq_cst)
+		{
+			box_type* const pOldBox = mpBox.exchange(DoCreateBox(sharedPtr), std::memory_order_seq_cst);
+
+			if(pOldBox)
+			{
+				Internal::shared_ptr_hazard::wait_until_unprotected(pOldBox);
+				sharedPtr = eastl::move(pOldBox->mSharedPtr);
+				DoDestroyBox(pOldBox);
+			}
+			else
+				sharedPtr.reset();
+
+			return sharedPtr;
+		}
+
+		/// Replaces the value with desired if it is equivalent to expected, which means that it
+		/// has the same pointer and shares ownership with it. Otherwise copies the value into
+		/// expected and returns false.
+		bool compare_exchange_strong(value_type& expected, value_type desired, std::memory_order = std::memory_order_seq_cst)
+		{
+			box_type* const pNewBox    = DoCreateBox(desired);
+			box_type*       pOldBox    = NULL;
+			bool            bExchanged = false;
+			value_type      current;
+
+			{
+				Internal::shared_ptr_hazard hazard;
+
+				for(;;)
+				{
+					box_type* pBox = hazard.protect(mpBox); // The box can't be freed and reused while it's protected, so the exchange below can't be fooled by a new box at the same address.
+
+					if(pBox ? !DoIsEquivalent(pBox->mSharedPtr, expected) : (expected.get() || expected.use_count()))
+					{
+						if(pBox)
+							current = pBox->mSharedPtr;
+						break;
+					}
+
+					if(mpBox.compare_exchange_strong(pBox, pNewBox, std::memory_order_seq_cst))
+					{
+						pOldBox    = pBox;
+						bExchanged = true;
+						break;
+					}
+				}
+			}
+
+			// The hazard is released before waiting, and before running any destructors,
+			// which may themselves use an atomic_shared_ptr.
+			if(bExchanged)
+			{
+				if(pOldBox)
+				{
+					Internal::shared_ptr_hazard::wait_until_unprotected(pOldBox);
+					DoDestroyBox(pOldBox);
+				}
+				return true;
+			}
+
+			DoDestroyBox(pNewBox);
+			expected = eastl::move(current);
+			return false;
+		}
+
+		bool compare_exchange_strong(value_type& expected, value_type desired, std::memory_order, std::memory_order)
+			{ return compare_exchange_strong(expected, eastl::move(desired)); }
+
+		bool compare_exchange_weak(value_type& expected, value_type desired, std::memory_order = std::memory_order_seq_cst)
+			{ return compare_exchange_strong(expected, eastl::move(desired)); }
+
+		bool compare_exchange_weak(value_type& expected, value_type desired, std::memory_order, std::memory_order)
+			{ return compare_exchange_strong(expected, eastl::move(desired)); }
+
+	protected:
+		struct box_type
+		{
+			value_type mSharedPtr;
+
+			box_type(const value_type& sharedPtr) : mSharedPtr(sharedPtr) {}
+		};
+
+		static bool DoIsEquivalent(const value_type& a, const value_type& b) EA_NOEXCEPT
+			{ return (a.get() == b.get()) && a.equivalent_ownership(b); }
+
+		box_type* DoCreateBox(const value_type& sharedPtr)
+		{
+			if(!sharedPtr.get() && !sharedPtr.use_count()) // An empty shared_ptr is stored as a NULL box.
+				return NULL;
+
+			void* const pMemory = EASTLAlloc(mAllocator, sizeof(box_type));
+			return pMemory ? ::new(pMemory) box_type(sharedPtr) : NULL;
+		}
+
+		void DoDestroyBox(box_type* pBox)
+		{
+			if(pBox)
+			{
+				pBox->~box_type();
+				EASTLFree(mAllocator, pBox, sizeof(box_type));
+			}
+		}
+
+	protected:
+		std::atomic<box_type*> mpBox;
+		allocator_type         mAllocator;
+	};
+
+
+
+
 	///////////////////////////////////////////////////////////////////////////
 	// weak_ptr
 	///////////////////////////////////////////////////////////////////////////
@@ -1636,6 +1874,10 @@ namespace eastl
 	}; // class weak_ptr
 
 
+	template <typename T>
+	struct is_trivially_relocatable<weak_ptr<T>> : public true_type {};
+
+
 
 	/// Note that the C++11 Standard does not specify that weak_ptr has comparison operators,
 	/// though it does specify that the owner_before function exists in weak_ptr.
@@ -0,0 +1,193 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     size_class_allocator
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+#include <EASTL/type_traits.h>
+#include <stddef.h>
+
+
+
+namespace eastl
+{
+
+	/// EASTL_SIZE_CLASS_ALLOCATOR_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_SIZE_CLASS_ALLOCATOR_DEFAULT_NAME
+		#define EASTL_SIZE_CLASS_ALLOCATOR_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " size_class_allocator" // Unless the user overrides something, this is "EASTL size_class_allocator".
+	#endif
+
+
+	/// EASTL_SIZE_CLASS_GRANULARITY
+	///
+	/// The spacing of the size classes, which is also the alignment every allocation gets.
+	/// Must be a power of two and at least EASTL_ALLOCATOR_MIN_ALIGNMENT.
+	///
+	#ifndef EASTL_SIZE_CLASS_GRANULARITY
+		#define EASTL_SIZE_CLASS_GRANULARITY 16
+	#endif
+
+
+	/// EASTL_SIZE_CLASS_MAX_SIZE
+	///
+	/// The largest size which is served from the size classes. Larger allocations go to
+	/// EASTLAllocatorDefault(). Must be a multiple of EASTL_SIZE_CLASS_GRANULARITY.
+	///
+	#ifndef EASTL_SIZE_CLASS_MAX_SIZE
+		#define EASTL_SIZE_CLASS_MAX_SIZE 256
+	#endif
+
+
+	/// EASTL_SIZE_CLASS_SLAB_SIZE
+	///
+	/// The size of the blocks which the size classes take from EASTLAllocatorDefault()
+	/// and carve into nodes. Slabs are never returned.
+	///
+	#ifndef EASTL_SIZE_CLASS_SLAB_SIZE
+		#define EASTL_SIZE_CLASS_SLAB_SIZE (64 * 1024)
+	#endif
+
+
+	/// EASTL_SIZE_CLASS_TRANSFER_COUNT
+	///
+	/// The number of nodes a thread cache moves to or from the shared lists at a time.
+	/// A thread caches at most twice this many free nodes per size class.
+	///
+	#ifndef EASTL_SIZE_CLASS_TRANSFER_COUNT
+		#define EASTL_SIZE_CLASS_TRANSFER_COUNT 32
+	#endif
+
+
+
+	/// size_class_allocator
+	///
+	/// A general purpose allocator for small objects, such as the nodes of list, slist,
+	/// map, set and hash_map, which scales across threads.
+	///
+	/// Small sizes are rounded up to one of a set of size classes, each of which is a
+	/// freelist of equal sized nodes in the manner of fixed_pool. Unlike fixed_pool, the
+	/// classes grow by carving new slabs, and each thread keeps its own cache of free nodes
+	/// per class, so most allocations and frees touch no shared state at all. The shared
+	/// per-class lists are only locked to move a batch of EASTL_SIZE_CLASS_TRANSFER_COUNT
+	/// nodes into or out of a thread's cache. Memory freed on another thread than the one
+	/// which allocated it is fine; it goes to the freeing thread's cache. A thread's cache
+	/// is returned to the shared lists when the thread exits, or with flush_thread_cache().
+	///
+	/// Sizes above EASTL_SIZE_CLASS_MAX_SIZE go to EASTLAllocatorDefault(). The class is
+	/// chosen from the size alone, as deallocate is only given the size, so an alignment
+	/// greater than EASTL_SIZE_CLASS_GRANULARITY is supported only when the size is a
+	/// multiple of it. This is always the case for objects and for container nodes.
+	///
+	/// All size_class_allocators share the same process-wide classes and compare equal.
+	/// Slab memory is held for the life of the process and reused, in the way that
+	/// malloc implementations hold their arenas.
+	///
+	/// Example usage:
+	///     eastl::list<Widget, eastl::size_class_allocator> widgetList;
+	///     eastl::map<int, Widget, eastl::less<int>, eastl::size_class_allocator> widgetMap;
+	///
+	class EASTL_API size_class_allocator
+	{
+	public:
+		EASTL_ALLOCATOR_EXPLICIT size_class_allocator(const char* pName = EASTL_NAME_VAL(EASTL_SIZE_CLASS_ALLOCATOR_DEFAULT_NAME))
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName ? pName : EASTL_SIZE_CLASS_ALLOCATOR_DEFAULT_NAME;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+		size_class_allocator(const size_class_allocator& x)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = x.mpName;
+			#else
+				EA_UNUSED(x);
+			#endif
+		}
+
+		size_class_allocator(const size_class_allocator&, const char* pName)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName ? pName : EASTL_SIZE_CLASS_ALLOCATOR_DEFAULT_NAME;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+		size_class_allocator& operator=(const size_class_allocator& x)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = x.mpName;
+			#else
+				EA_UNUSED(x);
+			#endif
+			return *this;
+		}
+
+		void* allocate(size_t n, int flags = 0);
+		void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+		void  deallocate(void* p, size_t n);
+
+		const char* get_name() const
+		{
+			#if EASTL_NAME_ENABLED
+				return mpName;
+			#else
+				return EASTL_SIZE_CLASS_ALLOCATOR_DEFAULT_NAME;
+			#endif
+		}
+
+		void set_name(const char* pName)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+		/// Returns the calling thread's cached free nodes to the shared lists. Threads which
+		/// are about to go idle for a long time can call this to make their cache available
+		/// to other threads; threads which exit do it automatically.
+		static void flush_thread_cache();
+
+		/// Returns the total size of the slabs carved so far, which is the memory the
+		/// size classes hold, whether in use or free.
+		static size_t slab_memory();
+
+	protected:
+		#if EASTL_NAME_ENABLED
+			const char* mpName; // Debug name, used to track memory.
+		#endif
+	};
+
+	inline bool operator==(const size_class_allocator&, const size_class_allocator&)
+	{
+		return true; // All size_class_allocators share the same classes.
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	inline bool operator!=(const size_class_allocator&, const size_class_allocator&)
+	{
+		return false;
+	}
+#endif
+
+	// size_class_allocator doesn't refer to its own address, so containers using it can be relocated with memcpy.
+	template <> struct is_trivially_relocatable<size_class_allocator> : public true_type {};
+
+} // namespace eastl
@@ -0,0 +1,443 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements small_vector, a vector which stores up to nodeCount
+// elements inside the container object itself and spills to the heap when
+// it grows beyond that.
+//
+// small_vector is a vector with an inline buffer swapped in as its initial
+// storage, in the same way as fixed_vector. It differs from
+// fixed_vector<T, nodeCount, true> in the following ways:
+//    - small_vector's allocator is the user allocator itself rather than a
+//      wrapper holding an overflow allocator and a pool pointer. Since
+//      small_vector only ever allocates more than nodeCount elements, a
+//      deallocation of nodeCount elements or fewer can only refer to the
+//      inline buffer and is ignored.
+//    - Moving a small_vector which has spilled to the heap hands over its
+//      heap block instead of moving the elements one by one.
+//    - Once a small_vector has spilled to the heap it stays there until
+//      set_capacity/shrink_to_fit is called with a value of nodeCount or less.
+//
+// Like fixed_vector, small_vector points into itself while its elements are
+// inline, and so it is not trivially relocatable.
+//
+// Iterators are plain pointers and are invalidated by any operation that
+// changes capacity, including the move from the inline buffer to the heap.
+// Unlike vector, moving or swapping a small_vector whose elements are inline
+// moves the elements themselves and therefore invalidates iterators too.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/vector.h>
+#include <EASTL/internal/fixed_pool.h>
+
+
+
+namespace eastl
+{
+	/// EASTL_SMALL_VECTOR_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_SMALL_VECTOR_DEFAULT_NAME
+		#define EASTL_SMALL_VECTOR_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " small_vector" // Unless the user overrides something, this is "EASTL small_vector".
+	#endif
+
+
+	/// EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR
+		#define EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR allocator_type(EASTL_SMALL_VECTOR_DEFAULT_NAME)
+	#endif
+
+
+
+	/// small_vector_allocator
+	///
+	/// The allocator small_vector hands to vector. It is Allocator with deallocate
+	/// taught to ignore the inline buffer, which small_vector recognizes by size:
+	/// heap blocks always hold more than nInlineSize bytes. Deriving from Allocator
+	/// keeps an empty Allocator empty inside vector.
+	///
+	/// Template parameters:
+	///     nInlineSize    The size in bytes of the owning small_vector's inline buffer.
+	///     Allocator      The allocator used for spilled storage.
+	///
+	template <size_t nInlineSize, typename Allocator>
+	class small_vector_allocator : public Allocator
+	{
+	public:
+		explicit small_vector_allocator(const char* pName = EASTL_SMALL_VECTOR_DEFAULT_NAME)
+			: Allocator(pName) { }
+
+		small_vector_allocator(const Allocator& allocator)
+			: Allocator(allocator) { }
+
+		void deallocate(void* p, size_t n)
+		{
+			if(n > nInlineSize)
+				Allocator::deallocate(p, n);
+		}
+	};
+
+
+
+	/// small_vector
+	///
+	/// A small_vector has the interface and guarantees of vector, except as noted at the
+	/// top of this file. The first nodeCount elements are stored inline; growing past that
+	/// allocates from Allocator using the same geometric growth policy as vector.
+	///
+	/// Template parameters:
+	///     T              The type of object the vector holds.
+	///     nodeCount      The number of objects stored inline before spilling to the heap. Must be at least 1.
+	///     Allocator      The allocator used for spilled storage. Defaults to the global heap.
+	///
+	/// Example usage:
+	///    small_vector<Widget, 8> widgets;
+	///
+	///    widgets.push_back(Widget());  // Stored inline.
+	///    widgets.resize(20);           // Moved to the heap.
+	///    widgets.shrink_to_fit();      // Still on the heap, as 20 > 8.
+	///    widgets.resize(4);
+	///    widgets.shrink_to_fit();      // Back inline.
+	///
+	template <typename T, size_t nodeCount, typename Allocator = EASTLAllocatorType>
+	class small_vector : public vector<T, small_vector_allocator<nodeCount * sizeof(T), Allocator> >
+	{
+	public:
+		typedef vector<T, small_vector_allocator<nodeCount * sizeof(T), Allocator> > base_type;
+		typedef small_vector<T, nodeCount, Allocator>                                   this_type;
+		typedef typename base_type::allocator_type                                      allocator_type;
+		typedef typename base_type::size_type                                           size_type;
+		typedef typename base_type::value_type                                          value_type;
+		typedef typename base_type::iterator                                            iterator;
+		typedef typename base_type::const_iterator                                      const_iterator;
+		typedef aligned_buffer<nodeCount * sizeof(T), EASTL_ALIGN_OF(T)>                aligned_buffer_type;
+
+		enum { kInlineCapacity = nodeCount };
+
+		using base_type::get_allocator;
+		using base_type::resize;
+		using base_type::clear;
+		using base_type::size;
+		using base_type::capacity;
+		using base_type::begin;
+		using base_type::end;
+		using base_type::npos;
+
+		static_assert(nodeCount >= 1, "small_vector<T, nodeCount> nodeCount must be at least 1.");
+		static_assert(!is_const<value_type>::value, "small_vector<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "small_vector<T> value_type must be non-volatile.");
+
+	protected:
+		aligned_buffer_type mBuffer;
+
+		using base_type::mpBegin;
+		using base_type::mpEnd;
+		using base_type::internalCapacityPtr;
+		using base_type::DoAllocate;
+		using base_type::DoFree;
+		using base_type::DoRelocate;
+		using base_type::DoFreeRelocated;
+
+	public:
+		small_vector() EA_NOEXCEPT_IF(EA_NOEXCEPT_EXPR(EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR));
+		explicit small_vector(const allocator_type& allocator) EA_NOEXCEPT;
+		explicit small_vector(size_type n, const allocator_type& allocator = EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR);
+		small_vector(size_type n, const value_type& value, const allocator_type& allocator = EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR);
+		small_vector(const this_type& x);
+		small_vector(const this_type& x, const allocator_type& allocator);
+		small_vector(this_type&& x) EA_NOEXCEPT_IF(eastl::is_nothrow_move_constructible<value_type>::value);
+		small_vector(this_type&& x, const allocator_type& allocator);
+		small_vector(std::initializer_list<value_type> ilist, const allocator_type& allocator = EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR);
+
+		// note: this has pre-C++11 semantics, the same as vector:
+		// this constructor is equivalent to small_vector(static_cast<size_type>(first), static_cast<value_type>(last), allocator) if InputIterator is an integral type.
+		template <typename InputIterator>
+		small_vector(InputIterator first, InputIterator last, const allocator_type& allocator = EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR);
+
+		this_type& operator=(const this_type& x);
+		this_type& operator=(std::initializer_list<value_type> ilist);
+		this_type& operator=(this_type&& x);
+
+		void swap(this_type& x);
+
+		void set_capacity(size_type n = npos);      // Same as vector::set_capacity, except that any n <= nodeCount moves the elements back inline and frees the heap block.
+		void shrink_to_fit();
+		void clear(bool freeOverflow);              // If freeOverflow is true then any heap block is freed and the container goes back inline.
+		void reset_lose_memory() EA_NOEXCEPT;       // This is a unilateral reset to an initially empty state. No destructors are called, no deallocation occurs.
+		bool has_overflowed() const EA_NOEXCEPT;    // Returns true if the elements currently live on the heap instead of in the inline buffer.
+
+	protected:
+		value_type* DoGetInlineData() EA_NOEXCEPT { return (value_type*)&mBuffer.buffer[0]; }
+
+		void DoMoveFrom(this_type& x);
+
+	}; // class small_vector
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// small_vector
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector() EA_NOEXCEPT_IF(EA_NOEXCEPT_EXPR(EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR))
+		: base_type(EASTL_SMALL_VECTOR_DEFAULT_ALLOCATOR)
+	{
+		reset_lose_memory();
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector(const allocator_type& allocator) EA_NOEXCEPT
+		: base_type(allocator)
+	{
+		reset_lose_memory();
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector(size_type n, const allocator_type& allocator)
+		: base_type(allocator)
+	{
+		reset_lose_memory();
+		resize(n);
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector(size_type n, const value_type& value, const allocator_type& allocator)
+		: base_type(allocator)
+	{
+		reset_lose_memory();
+		resize(n, value);
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector(const this_type& x)
+		: base_type(x.get_allocator())
+	{
+		reset_lose_memory();
+		base_type::template DoAssign<const_iterator, false>(x.begin(), x.end(), false_type());
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector(const this_type& x, const allocator_type& allocator)
+		: base_type(allocator)
+	{
+		reset_lose_memory();
+		base_type::template DoAssign<const_iterator, false>(x.begin(), x.end(), false_type());
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector(this_type&& x) EA_NOEXCEPT_IF(eastl::is_nothrow_move_constructible<value_type>::value)
+		: base_type(x.get_allocator())
+	{
+		reset_lose_memory();
+		DoMoveFrom(x);
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector(this_type&& x, const allocator_type& allocator)
+		: base_type(allocator)
+	{
+		reset_lose_memory();
+		DoMoveFrom(x);
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+		: base_type(allocator)
+	{
+		typedef typename std::initializer_list<value_type>::iterator InputIterator;
+		typedef typename eastl::iterator_traits<InputIterator>::iterator_category IC;
+
+		reset_lose_memory();
+		base_type::template DoAssignFromIterator<InputIterator, false>(ilist.begin(), ilist.end(), IC());
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	template <typename InputIterator>
+	inline small_vector<T, nodeCount, Allocator>::small_vector(InputIterator first, InputIterator last, const allocator_type& allocator)
+		: base_type(allocator)
+	{
+		reset_lose_memory();
+		base_type::template DoAssign<InputIterator, false>(first, last, is_integral<InputIterator>());
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline typename small_vector<T, nodeCount, Allocator>::this_type&
+	small_vector<T, nodeCount, Allocator>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			#if EASTL_ALLOCATOR_COPY_ENABLED
+				if(get_allocator() != x.get_allocator())
+				{
+					// Our heap block (if any) belongs to our current allocator, so release it before adopting x's.
+					clear(true);
+					get_allocator() = x.get_allocator();
+				}
+			#endif
+
+			base_type::template DoAssign<const_iterator, false>(x.begin(), x.end(), false_type());
+		}
+		return *this;
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline typename small_vector<T, nodeCount, Allocator>::this_type&
+	small_vector<T, nodeCount, Allocator>::operator=(std::initializer_list<value_type> ilist)
+	{
+		typedef typename std::initializer_list<value_type>::iterator InputIterator;
+		typedef typename eastl::iterator_traits<InputIterator>::iterator_category IC;
+
+		base_type::template DoAssignFromIterator<InputIterator, false>(ilist.begin(), ilist.end(), IC());
+		return *this;
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline typename small_vector<T, nodeCount, Allocator>::this_type&
+	small_vector<T, nodeCount, Allocator>::operator=(this_type&& x)
+	{
+		if(this != &x)
+		{
+			// Only a heap block of x's can be taken over, so if x has one we give up ours first.
+			if(x.has_overflowed() && (get_allocator() == x.get_allocator()))
+				clear(true);
+			else
+				clear();
+
+			DoMoveFrom(x);
+		}
+		return *this;
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline void small_vector<T, nodeCount, Allocator>::swap(this_type& x)
+	{
+		if((has_overflowed() && x.has_overflowed()) && (get_allocator() == x.get_allocator())) // If both containers are using the heap instead of local memory
+		{                                                                                      // then we can do a fast pointer swap instead of content swap.
+			eastl::swap(mpBegin,    x.mpBegin);
+			eastl::swap(mpEnd,      x.mpEnd);
+			eastl::swap(internalCapacityPtr(), x.internalCapacityPtr());
+		}
+		else
+		{
+			// Fixed containers use a special swap that can deal with excessively large buffers.
+			// Its moves hand over whichever heap block one side has.
+			eastl::fixed_swap(*this, x);
+		}
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	void small_vector<T, nodeCount, Allocator>::set_capacity(size_type n)
+	{
+		if(n == npos)       // If the user means to set the capacity so that it equals the size (i.e. free excess capacity)...
+			n = size();
+		else if(n < size()) // If the newly requested capacity is less than our size, we do what vector::set_capacity does and resize.
+			resize(n);
+
+		// vector::set_capacity could allocate a heap block of nodeCount or fewer elements, which our allocator
+		// would then never free. Any such request instead moves the elements back into the inline buffer.
+		if((n <= nodeCount) ? has_overflowed() : (n != capacity()))
+		{
+			value_type* const pNewData = (n <= nodeCount) ? DoGetInlineData() : DoAllocate(n);
+			value_type* const pNewEnd  = DoRelocate(mpBegin, mpEnd, pNewData);
+
+			DoFreeRelocated();
+
+			mpBegin    = pNewData;
+			mpEnd      = pNewEnd;
+			internalCapacityPtr() = pNewData + ((n <= nodeCount) ? nodeCount : n);
+		}
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline void small_vector<T, nodeCount, Allocator>::shrink_to_fit()
+	{
+		set_capacity();
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline void small_vector<T, nodeCount, Allocator>::clear(bool freeOverflow)
+	{
+		base_type::clear();
+		if(freeOverflow && has_overflowed())
+		{
+			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+			reset_lose_memory();
+		}
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline void small_vector<T, nodeCount, Allocator>::reset_lose_memory() EA_NOEXCEPT
+	{
+		mpBegin = mpEnd = DoGetInlineData();
+		internalCapacityPtr() = mpBegin + nodeCount;
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline bool small_vector<T, nodeCount, Allocator>::has_overflowed() const EA_NOEXCEPT
+	{
+		return ((void*)mpBegin != (void*)&mBuffer.buffer[0]);
+	}
+
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	void small_vector<T, nodeCount, Allocator>::DoMoveFrom(this_type& x)
+	{
+		// We are empty. If x is on the heap and its memory is compatible with our
+		// allocator we take its block; otherwise we move its elements.
+		if(x.has_overflowed() && (get_allocator() == x.get_allocator()))
+		{
+			mpBegin = x.mpBegin;
+			mpEnd   = x.mpEnd;
+			internalCapacityPtr() = x.internalCapacityPtr();
+			x.reset_lose_memory();
+		}
+		else
+		{
+			base_type::template DoAssign<move_iterator<iterator>, true>(eastl::make_move_iterator(x.begin()), eastl::make_move_iterator(x.end()), false_type());
+			x.clear();
+		}
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, size_t nodeCount, typename Allocator>
+	inline void swap(small_vector<T, nodeCount, Allocator>& a, small_vector<T, nodeCount, Allocator>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
@@ -0,0 +1,388 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     allocation_stats
+//     allocation_stats_snapshot
+//     stats_allocator
+//     GetAllocationStats / GetAllocationStatsSnapshots / DumpAllocationStats
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+#include <EASTL/type_traits.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <stddef.h>
+#include <atomic>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+
+namespace eastl
+{
+
+	/// EASTL_STATS_ALLOCATOR_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_STATS_ALLOCATOR_DEFAULT_NAME
+		#define EASTL_STATS_ALLOCATOR_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " stats_allocator" // Unless the user overrides something, this is "EASTL stats_allocator".
+	#endif
+
+
+	/// EASTL_ALLOCATION_STATS_MAX_NAMES
+	///
+	/// The number of distinct allocator names which get their own statistics. Allocations
+	/// under names beyond this many are recorded together under "(other)".
+	///
+	#ifndef EASTL_ALLOCATION_STATS_MAX_NAMES
+		#define EASTL_ALLOCATION_STATS_MAX_NAMES 256
+	#endif
+
+
+	/// EASTL_ALLOCATION_STATS_HISTOGRAM_SIZE
+	///
+	/// The number of buckets in an allocation size histogram. Bucket 0 counts sizes up to
+	/// 8 bytes, bucket i counts sizes in (2^(i+2), 2^(i+3)], and the last bucket counts
+	/// everything larger.
+	///
+	#ifndef EASTL_ALLOCATION_STATS_HISTOGRAM_SIZE
+		#define EASTL_ALLOCATION_STATS_HISTOGRAM_SIZE 20
+	#endif
+
+
+
+	/// allocation_stats_snapshot
+	///
+	/// A copy of the statistics of one allocator name at some moment.
+	///
+	struct allocation_stats_snapshot
+	{
+		const char* mpName;
+		uint64_t    mnAllocationCount;
+		uint64_t    mnDeallocationCount;
+		uint64_t    mnAllocatedBytes;    // Bytes allocated over all time.
+		uint64_t    mnDeallocatedBytes;  // Bytes freed over all time.
+		uint64_t    mnPeakBytes;         // The most bytes in use at once. Detailed mode only.
+		uint64_t    mnHistogram[EASTL_ALLOCATION_STATS_HISTOGRAM_SIZE]; // Allocation counts by size. Detailed mode only.
+
+		uint64_t current_count() const { return mnAllocationCount - mnDeallocationCount; }
+		uint64_t current_bytes() const { return mnAllocatedBytes - mnDeallocatedBytes; }
+	};
+
+
+
+	/// allocation_stats
+	///
+	/// The live statistics of one allocator name, as recorded by stats_allocator. There is
+	/// one per distinct name, found with GetAllocationStats, and it lives for the life of
+	/// the process. The counters are relaxed atomics, so that any thread may record into
+	/// them without a lock. The basic counters take two atomic adds per allocation and per
+	/// free. The detailed ones, the size histogram and the peak, take two more per allocation.
+	///
+	/// The peak is computed from counters which other threads may be updating at the same
+	/// time, so under concurrent use it is approximate.
+	///
+	class EASTL_API allocation_stats
+	{
+	public:
+		enum
+		{
+			kHistogramSize = EASTL_ALLOCATION_STATS_HISTOGRAM_SIZE
+		};
+
+		explicit allocation_stats(const char* pName = NULL);
+
+		void record_allocate(size_t n)
+		{
+			mnAllocationCount.fetch_add(1, std::memory_order_relaxed);
+			mnAllocatedBytes.fetch_add(n, std::memory_order_relaxed);
+		}
+
+		void record_allocate_detailed(size_t n)
+		{
+			const uint64_t nAllocatedBytes   = mnAllocatedBytes.fetch_add(n, std::memory_order_relaxed) + n;
+			const uint64_t nDeallocatedBytes = mnDeallocatedBytes.load(std::memory_order_relaxed); // Other threads' frees may be counted here but not their allocations.
+			const uint64_t nCurrentBytes     = (nAllocatedBytes > nDeallocatedBytes) ? (nAllocatedBytes - nDeallocatedBytes) : 0;
+			uint64_t       nPeakBytes        = mnPeakBytes.load(std::memory_order_relaxed);
+
+			mnAllocationCount.fetch_add(1, std::memory_order_relaxed);
+			mnHistogram[histogram_index(n)].fetch_add(1, std::memory_order_relaxed);
+
+			while((nCurrentBytes > nPeakBytes) && !mnPeakBytes.compare_exchange_weak(nPeakBytes, nCurrentBytes, std::memory_order_relaxed))
+				{ } // compare_exchange_weak reloads nPeakBytes on failure.
+		}
+
+		void record_deallocate(size_t n)
+		{
+			mnDeallocationCount.fetch_add(1, std::memory_order_relaxed);
+			mnDeallocatedBytes.fetch_add(n, std::memory_order_relaxed);
+		}
+
+		/// Copies the counters into a snapshot. Each counter is read separately, so a
+		/// snapshot taken while other threads allocate may be slightly inconsistent.
+		void get_snapshot(allocation_stats_snapshot& snapshot) const;
+
+		/// Sets the counters back to zero, except that the peak is set to the bytes currently in use.
+		void reset();
+
+		const char* get_name() const
+			{ return mpName; }
+
+		/// Returns the histogram bucket which an allocation of n bytes is counted in.
+		static size_t histogram_index(size_t n);
+
+	protected:
+		friend EASTL_API allocation_stats* GetAllocationStats(const char*);
+
+		const char*           mpName;
+		std::atomic<uint64_t> mnAllocationCount;
+		std::atomic<uint64_t> mnDeallocationCount;
+		std::atomic<uint64_t> mnAllocatedBytes;
+		std::atomic<uint64_t> mnDeallocatedBytes;
+		std::atomic<uint64_t> mnPeakBytes;
+		std::atomic<uint64_t> mnHistogram[kHistogramSize];
+
+		allocation_stats(const allocation_stats&) = delete;
+		allocation_stats& operator=(const allocation_stats&) = delete;
+	};
+
+
+
+	/// GetAllocationStats
+	///
+	/// Returns the statistics of the given allocator name, registering the name if it is new.
+	/// Names are compared by content, and the registry keeps its own copy of each one, so the
+	/// name may be a temporary. A NULL name is the same as EASTL_STATS_ALLOCATOR_DEFAULT_NAME.
+	/// Once EASTL_ALLOCATION_STATS_MAX_NAMES names are registered, new names all share one
+	/// "(other)" entry. This is thread-safe and doesn't lock for names already registered.
+	///
+	EASTL_API allocation_stats* GetAllocationStats(const char* pName);
+
+
+	/// GetAllocationStatsSnapshots
+	///
+	/// Copies a snapshot of each registered name into pSnapshotArray, up to nArrayCapacity
+	/// of them, in order of registration. Returns the number of registered names, which
+	/// may be more than nArrayCapacity.
+	///
+	EASTL_API size_t GetAllocationStatsSnapshots(allocation_stats_snapshot* pSnapshotArray, size_t nArrayCapacity);
+
+
+	/// ResetAllocationStats
+	///
+	/// Resets the statistics of every registered name. See allocation_stats::reset.
+	///
+	EASTL_API void ResetAllocationStats();
+
+
+	/// DumpAllocationStats
+	///
+	/// Writes a report of every registered name which has had any allocations, one line of
+	/// text at a time, to the given function. Names are ordered by the bytes they currently
+	/// have in use, most first. Each name's line is followed by its size histogram, if
+	/// there is one.
+	///
+	/// Example usage:
+	///     void PrintLine(const char* pLine, void*) { printf("%s\n", pLine); }
+	///
+	///     eastl::DumpAllocationStats(PrintLine, NULL);
+	///
+	typedef void (*AllocationStatsOutputFunction)(const char* pLine, void* pContext);
+
+	EASTL_API void DumpAllocationStats(AllocationStatsOutputFunction pOutputFunction, void* pContext);
+
+
+	/// SetAllocationTraceFunction
+	///
+	/// Sets a function which detailed stats_allocators call for every allocation and free,
+	/// with the allocator name, the pointer, the size and whether it is an allocation. Pass
+	/// NULL to stop tracing. The function may be called from any thread at once.
+	///
+	/// As with SetAssertionFailureFunction, there is no thread safety in the setting itself,
+	/// so it is best set on startup before other threads allocate.
+	///
+	typedef void (*AllocationTraceFunction)(const char* pName, void* p, size_t n, bool bAllocate, void* pContext);
+
+	EASTL_API void SetAllocationTraceFunction(AllocationTraceFunction pTraceFunction, void* pContext);
+
+	namespace Internal
+	{
+		extern EASTL_API AllocationTraceFunction gpAllocationTraceFunction;
+		extern EASTL_API void*                   gpAllocationTraceContext;
+	}
+
+
+
+	/// stats_allocator
+	///
+	/// An allocator adaptor which passes allocations through to Allocator and records them
+	/// under Allocator's name, so that the memory held by each kind of container can be seen
+	/// while the program runs. The containers name their allocators in the usual way, through
+	/// EASTL_NAME_VAL defaults such as "EASTL vector" or user-supplied names, and each name
+	/// gets its own allocation_stats. When EASTL_NAME_ENABLED is 0, everything is recorded
+	/// under the allocator's default name.
+	///
+	/// With bDetailed set, which is the default, a size histogram and the peak bytes in use
+	/// are recorded as well, and the trace function set by SetAllocationTraceFunction is
+	/// called. With bDetailed clear, only the counts and bytes are recorded, with two relaxed
+	/// atomic adds per call, which is cheap enough to leave on in a shipping build.
+	///
+	/// The name is looked up when the allocator is constructed or renamed, not on each
+	/// allocation. An allocator renamed while it has memory allocated records the frees of
+	/// that memory under the new name.
+	///
+	/// Example usage:
+	///     typedef eastl::stats_allocator<eastl::allocator, false> StatsAllocator;
+	///
+	///     eastl::vector<Widget, StatsAllocator> widgetArray(StatsAllocator("Widgets"));
+	///     ...
+	///     eastl::DumpAllocationStats(PrintLine, NULL);
+	///
+	template <typename Allocator = EASTLAllocatorType, bool bDetailed = true>
+	class stats_allocator
+	{
+	public:
+		typedef Allocator                            allocator_type;
+		typedef stats_allocator<Allocator, bDetailed> this_type;
+
+		EASTL_ALLOCATOR_EXPLICIT stats_allocator(const char* pName = EASTL_NAME_VAL(EASTL_STATS_ALLOCATOR_DEFAULT_NAME))
+			: mAllocator(pName),
+			  mpStats(GetAllocationStats(mAllocator.get_name()))
+		{
+		}
+
+		stats_allocator(const allocator_type& allocator)
+			: mAllocator(allocator),
+			  mpStats(GetAllocationStats(mAllocator.get_name()))
+		{
+		}
+
+		stats_allocator(const this_type& x)
+			: mAllocator(x.mAllocator),
+			  mpStats(x.mpStats)
+		{
+		}
+
+		stats_allocator(const this_type& x, const char* pName)
+			: mAllocator(x.mAllocator)
+		{
+			mAllocator.set_name(pName);
+			mpStats = GetAllocationStats(mAllocator.get_name());
+		}
+
+		this_type& operator=(const this_type& x)
+		{
+			mAllocator = x.mAllocator;
+			mpStats    = x.mpStats;
+			return *this;
+		}
+
+		void* allocate(size_t n, int flags = 0)
+		{
+			void* const p = mAllocator.allocate(n, flags);
+
+			if(p)
+				DoRecordAllocate(p, n);
+			return p;
+		}
+
+		void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0)
+		{
+			void* const p = mAllocator.allocate(n, alignment, offset, flags);
+
+			if(p)
+				DoRecordAllocate(p, n);
+			return p;
+		}
+
+		void deallocate(void* p, size_t n)
+		{
+			if(p)
+			{
+				mpStats->record_deallocate(n);
+
+				EA_CONSTEXPR_IF(bDetailed)
+				{
+					if(Internal::gpAllocationTraceFunction)
+						Internal::gpAllocationTraceFunction(mpStats->get_name(), p, n, false, Internal::gpAllocationTraceContext);
+				}
+			}
+
+			mAllocator.deallocate(p, n);
+		}
+
+		const char* get_name() const
+		{
+			return mAllocator.get_name();
+		}
+
+		void set_name(const char* pName)
+		{
+			mAllocator.set_name(pName);
+			mpStats = GetAllocationStats(mAllocator.get_name());
+		}
+
+		const allocator_type& get_allocator() const
+		{
+			return mAllocator;
+		}
+
+		allocator_type& get_allocator()
+		{
+			return mAllocator;
+		}
+
+		/// Returns the statistics this allocator records into, which are shared with every
+		/// allocator of the same name.
+		const allocation_stats& get_stats() const
+		{
+			return *mpStats;
+		}
+
+	protected:
+		void DoRecordAllocate(void* p, size_t n)
+		{
+			EA_CONSTEXPR_IF(bDetailed)
+			{
+				mpStats->record_allocate_detailed(n);
+
+				if(Internal::gpAllocationTraceFunction)
+					Internal::gpAllocationTraceFunction(mpStats->get_name(), p, n, true, Internal::gpAllocationTraceContext);
+			}
+			else
+				mpStats->record_allocate(n);
+		}
+
+	protected:
+		allocator_type    mAllocator;
+		allocation_stats* mpStats;
+	};
+
+
+	template <typename Allocator, bool bDetailed>
+	inline bool operator==(const stats_allocator<Allocator, bDetailed>& a, const stats_allocator<Allocator, bDetailed>& b)
+	{
+		return (a.get_allocator() == b.get_allocator());
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	template <typename Allocator, bool bDetailed>
+	inline bool operator!=(const stats_allocator<Allocator, bDetailed>& a, const stats_allocator<Allocator, bDetailed>& b)
+	{
+		return !(a.get_allocator() == b.get_allocator());
+	}
+#endif
+
+	// stats_allocator refers only to the process-wide statistics, so it is relocatable whenever the allocator it wraps is.
+	template <typename Allocator, bool bDetailed>
+	struct is_trivially_relocatable< stats_allocator<Allocator, bDetailed> > : public is_trivially_relocatable<Allocator> {};
+
+} // namespace eastl
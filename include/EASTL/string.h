@@ -126,6 +126,7 @@ EA_DISABLE_VC_WARNING(4530 4480 4571 4267 4702);
 
 #include <EASTL/internal/char_traits.h>
 #include <EASTL/string_view.h>
+#include <EASTL/charconv.h>
 
 ///////////////////////////////////////////////////////////////////////////////
 // EASTL_STRING_EXPLICIT
@@ -639,6 +640,20 @@ namespace eastl
 		template <typename OtherStringType>
 		this_type& append_convert(const OtherStringType& x);
 
+		// Appends the eastl::to_chars representation of the value, formatted directly into the
+		// string's spare capacity. These are much faster than append_sprintf for numbers.
+		template <typename Integer>
+		this_type& append_integer(Integer value, int base = 10);
+
+		template <typename Float>
+		this_type& append_float(Float value);
+
+		template <typename Float>
+		this_type& append_float(Float value, chars_format fmt);
+
+		template <typename Float>
+		this_type& append_float(Float value, chars_format fmt, int precision);
+
 		void push_back(value_type c);
 		void pop_back();
 
@@ -762,6 +777,9 @@ namespace eastl
 		void        RangeInitialize(const value_type* pBegin);
 		void        SizeInitialize(size_type n, value_type c);
 
+		template <typename ToChars>
+		this_type&  DoAppendChars(size_type nMaxLength, ToChars toChars);
+
 		bool        IsSSO() const EA_NOEXCEPT;
 
 		void        ThrowLengthException() const;
@@ -778,6 +796,12 @@ namespace eastl
 	}; // basic_string
 
 
+	// Neither the heap nor the SSO layout of basic_string points into the string object itself,
+	// so it can be relocated with memcpy whenever its allocator can.
+	template <typename T, typename Allocator>
+	struct is_trivially_relocatable<basic_string<T, Allocator>> : public is_trivially_relocatable<Allocator> {};
+
+
 
 
 
@@ -1865,6 +1889,97 @@ namespace eastl
 	}
 
 
+	template <typename T, typename Allocator>
+	template <typename Integer>
+	inline basic_string<T, Allocator>& basic_string<T, Allocator>::append_integer(Integer value, int base)
+	{
+		static_assert(is_integral<Integer>::value, "append_integer requires an integral type");
+
+		// A sign plus one digit per bit covers any base.
+		return DoAppendChars((size_type)(sizeof(Integer) * 8 + 1), [&](char* first, char* last) { return eastl::to_chars(first, last, value, base); });
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename Float>
+	inline basic_string<T, Allocator>& basic_string<T, Allocator>::append_float(Float value)
+	{
+		static_assert(is_floating_point<Float>::value, "append_float requires a floating point type");
+
+		return DoAppendChars(32, [&](char* first, char* last) { return eastl::to_chars(first, last, value); });
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename Float>
+	inline basic_string<T, Allocator>& basic_string<T, Allocator>::append_float(Float value, chars_format fmt)
+	{
+		static_assert(is_floating_point<Float>::value, "append_float requires a floating point type");
+
+		return DoAppendChars(32, [&](char* first, char* last) { return eastl::to_chars(first, last, value, fmt); });
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename Float>
+	inline basic_string<T, Allocator>& basic_string<T, Allocator>::append_float(Float value, chars_format fmt, int precision)
+	{
+		static_assert(is_floating_point<Float>::value, "append_float requires a floating point type");
+
+		return DoAppendChars((size_type)(32 + ((precision > 0) ? precision : 0)), [&](char* first, char* last) { return eastl::to_chars(first, last, value, fmt, precision); });
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename ToChars>
+	basic_string<T, Allocator>& basic_string<T, Allocator>::DoAppendChars(size_type nMaxLength, ToChars toChars)
+	{
+		// The chars are written into the spare capacity and, for wider character types, then
+		// widened in place from the back. Widening backwards never overwrites a char which
+		// hasn't been read yet, as element i starts at byte i * sizeof(value_type) >= i.
+		// Output which turns out to be longer than nMaxLength (large fixed format values)
+		// is retried with more room.
+		const size_type nSize = internalLayout().GetSize();
+
+		for(;;)
+		{
+			const size_type nCapacity = capacity();
+
+			if((nSize + nMaxLength) > nCapacity)
+				reserve(GetNewCapacity(nCapacity, (nSize + nMaxLength) - nCapacity));
+
+			value_type* const pEnd   = internalLayout().EndPtr();
+			char* const       pChars = reinterpret_cast<char*>(pEnd);
+			const to_chars_result result = toChars(pChars, pChars + nMaxLength);
+
+			if(result.ec == errc())
+			{
+				const size_type n = (size_type)(result.ptr - pChars);
+
+				if(sizeof(value_type) > 1)
+				{
+					for(size_type i = n; i > 0; --i)
+						pEnd[i - 1] = (value_type)(unsigned char)pChars[i - 1];
+				}
+
+				pEnd[n] = 0;
+				internalLayout().SetSize(nSize + n);
+				break;
+			}
+
+			if(nMaxLength >= 65536) // No number formats to this many chars; give up rather than loop.
+			{
+				*pEnd = 0;
+				break;
+			}
+
+			nMaxLength *= 4;
+		}
+
+		return *this;
+	}
+
+
 	template <typename T, typename Allocator>
 	inline void basic_string<T, Allocator>::push_back(value_type c)
 	{
@@ -2645,7 +2760,7 @@ namespace eastl
 
 		if(EASTL_LIKELY(((npos - n) >= position) && (position + n) <= internalLayout().GetSize())) // If the range is valid...
 		{
-			const value_type* const pTemp = eastl::search(internalLayout().BeginPtr() + position, internalLayout().EndPtr(), p, p + n);
+			const value_type* const pTemp = CharTypeStringSearch(internalLayout().BeginPtr() + position, internalLayout().EndPtr(), p, p + n);
 
 			if((pTemp != internalLayout().EndPtr()) || (n == 0))
 				return (size_type)(pTemp - internalLayout().BeginPtr());
@@ -2667,7 +2782,7 @@ namespace eastl
 
 		if(EASTL_LIKELY(position < internalLayout().GetSize()))// If the position is valid...
 		{
-			const const_iterator pResult = eastl::find(internalLayout().BeginPtr() + position, internalLayout().EndPtr(), c);
+			const const_iterator pResult = CharTypeStringFind(internalLayout().BeginPtr() + position, internalLayout().EndPtr(), c);
 
 			if(pResult != internalLayout().EndPtr())
 				return (size_type)(pResult - internalLayout().BeginPtr());
@@ -3847,18 +3962,58 @@ namespace eastl
 	///    #include <EASTL/hash_set.h>
 	///    hash_set<string> stringHashSet;
 	///
+	/// Transparent lookup
+	///
+	/// The hash<basic_string> specializations also accept basic_string_view and character
+	/// pointers, producing the same value as for an equal string, and define is_transparent.
+	/// Used with a transparent predicate, this allows string-keyed hash containers to be
+	/// searched without constructing a temporary string.
+	///
+	/// Example usage:
+	///    hash_map<string, int, hash<string>, equal_to<>> stringHashMap;
+	///    stringHashMap.find(string_view("hello"));
+	///
 	template <typename T> struct hash;
 
+	namespace Internal
+	{
+		// Hashes [p, pEnd) the same way hash<basic_string> hashes c_str(), which stops at the first zero character.
+		template <typename T>
+		inline size_t StringViewHash(const T* p, const T* pEnd)
+		{
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(basic_string_view<T>(p, (typename basic_string_view<T>::size_type)(pEnd - p)));
+			#else
+				unsigned int c, result = 2166136261U;
+				while((p != pEnd) && ((c = (unsigned int)(typename make_unsigned<T>::type)*p++) != 0))
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
+		}
+	}
+
 	template <>
 	struct hash<string>
 	{
+		typedef int is_transparent;
+
+		size_t operator()(const char* p) const
+			{ return Internal::StringViewHash(p, p + CharStrlen(p)); }
+
+		size_t operator()(const basic_string_view<char>& x) const
+			{ return Internal::StringViewHash(x.data(), x.data() + x.size()); }
+
 		size_t operator()(const string& x) const
 		{
-			const unsigned char* p = (const unsigned char*)x.c_str(); // To consider: limit p to at most 256 chars.
-			unsigned int c, result = 2166136261U; // We implement an FNV-like string hash.
-			while((c = *p++) != 0) // Using '!=' disables compiler warnings.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(x);
+			#else
+				const unsigned char* p = (const unsigned char*)x.c_str(); // To consider: limit p to at most 256 chars.
+				unsigned int c, result = 2166136261U; // We implement an FNV-like string hash.
+				while((c = *p++) != 0) // Using '!=' disables compiler warnings.
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -3866,13 +4021,25 @@ namespace eastl
 		template <>
 		struct hash<u8string>
 		{
+			typedef int is_transparent;
+
+			size_t operator()(const char8_t* p) const
+				{ return Internal::StringViewHash(p, p + CharStrlen(p)); }
+
+			size_t operator()(const basic_string_view<char8_t>& x) const
+				{ return Internal::StringViewHash(x.data(), x.data() + x.size()); }
+
 			size_t operator()(const u8string& x) const
 			{
-				const char8_t* p = (const char8_t*)x.c_str();
-				unsigned int c, result = 2166136261U;
-				while((c = *p++) != 0)
-					result = (result * 16777619) ^ c;
-				return (size_t)result;
+				#if EASTL_STRING_HASH_FAST
+					return fast_string_hash()(x);
+				#else
+					const char8_t* p = (const char8_t*)x.c_str();
+					unsigned int c, result = 2166136261U;
+					while((c = *p++) != 0)
+						result = (result * 16777619) ^ c;
+					return (size_t)result;
+				#endif
 			}
 		};
 	#endif
@@ -3880,26 +4047,50 @@ namespace eastl
 	template <>
 	struct hash<string16>
 	{
+		typedef int is_transparent;
+
+		size_t operator()(const char16_t* p) const
+			{ return Internal::StringViewHash(p, p + CharStrlen(p)); }
+
+		size_t operator()(const basic_string_view<char16_t>& x) const
+			{ return Internal::StringViewHash(x.data(), x.data() + x.size()); }
+
 		size_t operator()(const string16& x) const
 		{
-			const char16_t* p = x.c_str();
-			unsigned int c, result = 2166136261U;
-			while((c = *p++) != 0)
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(x);
+			#else
+				const char16_t* p = x.c_str();
+				unsigned int c, result = 2166136261U;
+				while((c = *p++) != 0)
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
 	template <>
 	struct hash<string32>
 	{
+		typedef int is_transparent;
+
+		size_t operator()(const char32_t* p) const
+			{ return Internal::StringViewHash(p, p + CharStrlen(p)); }
+
+		size_t operator()(const basic_string_view<char32_t>& x) const
+			{ return Internal::StringViewHash(x.data(), x.data() + x.size()); }
+
 		size_t operator()(const string32& x) const
 		{
-			const char32_t* p = x.c_str();
-			unsigned int c, result = 2166136261U;
-			while((c = (unsigned int)*p++) != 0)
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(x);
+			#else
+				const char32_t* p = x.c_str();
+				unsigned int c, result = 2166136261U;
+				while((c = (unsigned int)*p++) != 0)
+					result = (result * 16777619) ^ c;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -3907,13 +4098,25 @@ namespace eastl
 		template <>
 		struct hash<wstring>
 		{
+			typedef int is_transparent;
+
+			size_t operator()(const wchar_t* p) const
+				{ return Internal::StringViewHash(p, p + CharStrlen(p)); }
+
+			size_t operator()(const basic_string_view<wchar_t>& x) const
+				{ return Internal::StringViewHash(x.data(), x.data() + x.size()); }
+
 			size_t operator()(const wstring& x) const
 			{
-				const wchar_t* p = x.c_str();
-				unsigned int c, result = 2166136261U;
-				while((c = (unsigned int)*p++) != 0)
-					result = (result * 16777619) ^ c;
-				return (size_t)result;
+				#if EASTL_STRING_HASH_FAST
+					return fast_string_hash()(x);
+				#else
+					const wchar_t* p = x.c_str();
+					unsigned int c, result = 2166136261U;
+					while((c = (unsigned int)*p++) != 0)
+						result = (result * 16777619) ^ c;
+					return (size_t)result;
+				#endif
 			}
 		};
 	#endif
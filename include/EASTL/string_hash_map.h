@@ -6,10 +6,33 @@
 
 #include <EASTL/hash_map.h>
 #include <EASTL/string.h>
+#include <EASTL/string_pool.h>
 
 namespace eastl
 {
 
+namespace Internal
+{
+	// Compares a zero-terminated key with a string_view, which needn't be zero-terminated.
+	struct str_view_equal_to
+	{
+		bool operator()(const char* a, const string_view& b) const
+		{
+			for(const char* p = b.data(), *pEnd = p + b.size(); p != pEnd; ++p, ++a)
+			{
+				if((*a == 0) || (*a != *p))
+					return false;
+			}
+			return (*a == 0);
+		}
+	};
+
+	// True if the Hash and Predicate are the string_hash_map defaults, for which string_view lookup is supported.
+	template <typename Hash, typename Predicate>
+	struct is_default_string_hash_map_lookup
+		: public bool_constant<is_same<Hash, hash<const char*>>::value && is_same<Predicate, str_equal_to<const char*>>::value> {};
+}
+
 
 // Note: this class creates a copy of the key on insertion and manages it in its own internal
 // buffer this has side effects like:
@@ -86,6 +109,58 @@ public:
 	template <class... Args>
 	inline iterator try_emplace(const_iterator, const char* k, Args&&... valArgs);
 
+	// Lookup by string_view (or anything convertible to it, such as eastl::string), which never copies the key.
+	// These are provided for the default Hash and Predicate, which hash and compare a view and an equal
+	// char pointer identically. With user-supplied transparent Hash and Predicate types the hashtable's
+	// transparent find/count/contains/equal_range overloads are used instead.
+	using base::find;
+	using base::count;
+	using base::contains;
+	using base::equal_range;
+
+	template <typename HX = Hash, typename PX = Predicate, typename = enable_if_t<Internal::is_default_string_hash_map_lookup<HX, PX>::value>>
+	iterator find(const string_view& key)
+		{ return base::find_as(key, hash<string_view>(), Internal::str_view_equal_to()); }
+
+	template <typename HX = Hash, typename PX = Predicate, typename = enable_if_t<Internal::is_default_string_hash_map_lookup<HX, PX>::value>>
+	const_iterator find(const string_view& key) const
+		{ return base::find_as(key, hash<string_view>(), Internal::str_view_equal_to()); }
+
+	template <typename HX = Hash, typename PX = Predicate, typename = enable_if_t<Internal::is_default_string_hash_map_lookup<HX, PX>::value>>
+	size_type count(const string_view& key) const
+		{ return (find(key) != base::end()) ? 1 : 0; }
+
+	template <typename HX = Hash, typename PX = Predicate, typename = enable_if_t<Internal::is_default_string_hash_map_lookup<HX, PX>::value>>
+	bool contains(const string_view& key) const
+		{ return find(key) != base::end(); }
+
+	template <typename HX = Hash, typename PX = Predicate, typename = enable_if_t<Internal::is_default_string_hash_map_lookup<HX, PX>::value>>
+	eastl::pair<iterator, iterator> equal_range(const string_view& key)
+	{
+		const iterator it(find(key));
+		return eastl::pair<iterator, iterator>(it, (it == base::end()) ? it : eastl::next(it));
+	}
+
+	template <typename HX = Hash, typename PX = Predicate, typename = enable_if_t<Internal::is_default_string_hash_map_lookup<HX, PX>::value>>
+	eastl::pair<const_iterator, const_iterator> equal_range(const string_view& key) const
+	{
+		const const_iterator it(find(key));
+		return eastl::pair<const_iterator, const_iterator>(it, (it == base::end()) ? it : eastl::next(it));
+	}
+
+	template <typename HX = Hash, typename PX = Predicate, typename = enable_if_t<Internal::is_default_string_hash_map_lookup<HX, PX>::value>>
+	size_type erase(const string_view& key)
+	{
+		const iterator it(find(key));
+
+		if(it != base::end())
+		{
+			erase(it);
+			return 1;
+		}
+		return 0;
+	}
+
 private:
 	char*				strduplicate(const char* str);
 	void				free(const char* str);
@@ -284,4 +359,115 @@ string_hash_map<T, Hash, Predicate, Allocator>::free(const char* str)
 }
 
 
+
+/// interned_string_hash_map
+///
+/// A hash map with string keys, like string_hash_map, whose keys are interned in a string_pool
+/// rather than copied by each map. The pool must outlive the map. A key which is repeated across
+/// many maps is stored once, and finding an interned_string key hashes nothing and compares
+/// pointers. Lookups by string_view hash and compare the string once, in the pool, and never add
+/// the string to the pool.
+///
+/// Example usage:
+///     eastl::string_pool pool;
+///     eastl::interned_string_hash_map<int> map(pool);
+///
+///     map["speed"] = 3;
+///     eastl::interned_string speed = pool.intern("speed");
+///     map.find(speed)->second;    // 3, found by pointer comparison.
+///     map.find("speed")->second;  // 3
+///
+template <typename T, typename StringPool = string_pool, typename Allocator = EASTLAllocatorType>
+class interned_string_hash_map : public eastl::hash_map<interned_string, T, hash<interned_string>, equal_to<interned_string>, Allocator>
+{
+public:
+	typedef eastl::hash_map<interned_string, T, hash<interned_string>, equal_to<interned_string>, Allocator> base_type;
+	typedef interned_string_hash_map<T, StringPool, Allocator> this_type;
+	typedef StringPool pool_type;
+	typedef typename base_type::allocator_type allocator_type;
+	typedef typename base_type::insert_return_type insert_return_type;
+	typedef typename base_type::iterator iterator;
+	typedef typename base_type::const_iterator const_iterator;
+	typedef typename base_type::size_type size_type;
+	typedef typename base_type::value_type value_type;
+	typedef typename base_type::mapped_type mapped_type;
+
+	explicit interned_string_hash_map(pool_type& pool, const allocator_type& allocator = EASTL_HASH_MAP_DEFAULT_ALLOCATOR)
+		: base_type(allocator), mpPool(&pool) {}
+
+	pool_type& get_string_pool() const { return *mpPool; }
+
+	using base_type::insert;
+	using base_type::insert_or_assign;
+	using base_type::try_emplace;
+	using base_type::erase;
+	using base_type::find;
+	using base_type::count;
+	using base_type::contains;
+	using base_type::operator[];
+
+	insert_return_type insert(const string_view& key)
+		{ return base_type::insert(mpPool->intern(key)); }
+
+	insert_return_type insert(const string_view& key, const T& value)
+		{ return base_type::insert(value_type(mpPool->intern(key), value)); }
+
+	insert_return_type insert_or_assign(const string_view& key, const T& value)
+		{ return base_type::insert_or_assign(mpPool->intern(key), value); }
+
+	template <class... Args>
+	insert_return_type try_emplace(const string_view& key, Args&&... valArgs)
+		{ return base_type::try_emplace(mpPool->intern(key), eastl::forward<Args>(valArgs)...); }
+
+	mapped_type& operator[](const string_view& key)
+		{ return base_type::operator[](mpPool->intern(key)); }
+
+	// A string which isn't in the pool can't be a key, so these only search the map when it is.
+	iterator find(const string_view& key)
+	{
+		const interned_string interned(mpPool->find(key));
+		return (interned.empty() && !key.empty()) ? base_type::end() : base_type::find(interned);
+	}
+
+	const_iterator find(const string_view& key) const
+	{
+		const interned_string interned(mpPool->find(key));
+		return (interned.empty() && !key.empty()) ? base_type::end() : base_type::find(interned);
+	}
+
+	size_type count(const string_view& key) const
+		{ return (find(key) != base_type::end()) ? 1 : 0; }
+
+	bool contains(const string_view& key) const
+		{ return find(key) != base_type::end(); }
+
+	size_type erase(const string_view& key)
+	{
+		const iterator it(find(key));
+
+		if(it != base_type::end())
+		{
+			base_type::erase(it);
+			return 1;
+		}
+		return 0;
+	}
+
+	// Overloads for string literals and char pointers, which would otherwise be a better match for the
+	// container's templated overloads (such as insert(P&&)) than for the string_view ones above.
+	insert_return_type insert(const char* key)                           { return insert(string_view(key)); }
+	insert_return_type insert(const char* key, const T& value)           { return insert(string_view(key), value); }
+	insert_return_type insert_or_assign(const char* key, const T& value) { return insert_or_assign(string_view(key), value); }
+	mapped_type&       operator[](const char* key)                       { return operator[](string_view(key)); }
+	iterator           find(const char* key)                             { return find(string_view(key)); }
+	const_iterator     find(const char* key) const                       { return find(string_view(key)); }
+	size_type          count(const char* key) const                      { return count(string_view(key)); }
+	bool               contains(const char* key) const                   { return contains(string_view(key)); }
+	size_type          erase(const char* key)                            { return erase(string_view(key)); }
+
+protected:
+	pool_type* mpPool;
+};
+
+
 }
\ No newline at end of file
@@ -10,6 +10,31 @@
 namespace eastl
 {
 
+namespace Internal
+{
+	// Orders a zero-terminated key and a string_view, which needn't be zero-terminated, the same way str_less orders two keys.
+	struct str_view_less
+	{
+		static int Compare(const char* a, const string_view& b)
+		{
+			for(const char* p = b.data(), *pEnd = p + b.size(); p != pEnd; ++p, ++a)
+			{
+				if(*a == 0)
+					return -1;
+				if(*a != *p)
+					return ((uint8_t)*a < (uint8_t)*p) ? -1 : 1;
+			}
+			return (*a == 0) ? 0 : 1;
+		}
+
+		bool operator()(const char* a, const string_view& b) const
+			{ return Compare(a, b) < 0; }
+
+		bool operator()(const string_view& a, const char* b) const
+			{ return Compare(b, a) > 0; }
+	};
+}
+
 
 template<typename T, typename Predicate = str_less<const char*>, typename Allocator = EASTLAllocatorType>
 class string_map : public eastl::map<const char*, T, Predicate, Allocator>
@@ -40,6 +65,40 @@ public:
 	size_type			erase(const char* key);
 	mapped_type&		operator[](const char* key);
 
+	// Lookup by string_view (or anything convertible to it, such as eastl::string), which never copies the key.
+	// These are provided for the default Predicate, which orders a view and an equal char pointer identically.
+	using base::find;
+	using base::count;
+
+	template <typename PX = Predicate, typename = enable_if_t<is_same<PX, str_less<const char*>>::value>>
+	iterator find(const string_view& key)
+		{ return base::find_as(key, Internal::str_view_less()); }
+
+	template <typename PX = Predicate, typename = enable_if_t<is_same<PX, str_less<const char*>>::value>>
+	const_iterator find(const string_view& key) const
+		{ return base::find_as(key, Internal::str_view_less()); }
+
+	template <typename PX = Predicate, typename = enable_if_t<is_same<PX, str_less<const char*>>::value>>
+	size_type count(const string_view& key) const
+		{ return (find(key) != base::end()) ? 1 : 0; }
+
+	template <typename PX = Predicate, typename = enable_if_t<is_same<PX, str_less<const char*>>::value>>
+	bool contains(const string_view& key) const
+		{ return find(key) != base::end(); }
+
+	template <typename PX = Predicate, typename = enable_if_t<is_same<PX, str_less<const char*>>::value>>
+	size_type erase(const string_view& key)
+	{
+		const iterator it(find(key));
+
+		if(it != base::end())
+		{
+			erase(it);
+			return 1;
+		}
+		return 0;
+	}
+
 private:
 	char*				strduplicate(const char* str);
 
@@ -0,0 +1,590 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements string_pool and interned_string, for storing each of
+// a set of frequently repeated strings (such as asset names or tags) once.
+//
+// string_pool stores each distinct string it is given once, in large
+// blocks which are only freed when the pool is cleared or destroyed, and
+// keeps a hash index of them. Interning a string returns an interned_string,
+// which is a pointer to the pooled copy. Two interned_strings from the same
+// pool are equal if and only if they point to the same copy, so comparison
+// is O(1), and each carries its precomputed hash and a 32 bit handle. The
+// handle can be stored in place of the string (in a file, say) and turned
+// back into the interned_string with string_pool::get in O(1).
+//
+// interned_strings, and the characters they point to, remain valid until
+// their pool is cleared or destroyed. interned_strings from different pools
+// must not be compared with each other, except that the empty string is the
+// same in every pool (and is the default-constructed interned_string).
+//
+// string_pool is not thread-safe.
+//
+// See interned_string_hash_map in <EASTL/string_hash_map.h> for a hash map
+// which is keyed by interned_strings.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+#include <EASTL/functional.h>
+#include <EASTL/string_view.h>
+#include <EASTL/vector.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <stddef.h>
+#include <string.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+
+namespace eastl
+{
+
+	/// EASTL_STRING_POOL_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_STRING_POOL_DEFAULT_NAME
+		#define EASTL_STRING_POOL_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " string_pool" // Unless the user overrides something, this is "EASTL string_pool".
+	#endif
+
+
+	/// EASTL_STRING_POOL_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_STRING_POOL_DEFAULT_ALLOCATOR
+		#define EASTL_STRING_POOL_DEFAULT_ALLOCATOR allocator_type(EASTL_STRING_POOL_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_STRING_POOL_BLOCK_SIZE
+	///
+	/// The size in bytes of the blocks a string_pool stores its strings in.
+	/// Strings larger than a quarter of this get a block of their own.
+	///
+	#ifndef EASTL_STRING_POOL_BLOCK_SIZE
+		#define EASTL_STRING_POOL_BLOCK_SIZE 4096
+	#endif
+
+
+
+	namespace Internal
+	{
+		// A pooled string. The characters follow the header and are null-terminated.
+		struct interned_string_entry
+		{
+			uint32_t mnHash;
+			uint32_t mnHandle;
+			uint32_t mnLength;
+			char     mData[4]; // The actual size is mnLength + 1.
+		};
+
+		inline const interned_string_entry* GetEmptyInternedStringEntry() EA_NOEXCEPT
+		{
+			static const interned_string_entry sEmptyEntry = { 0, 0, 0, { 0 } };
+			return &sEmptyEntry;
+		}
+	}
+
+
+	template <typename Allocator>
+	class basic_string_pool;
+
+
+
+	/// interned_string
+	///
+	/// A string stored in a string_pool. Copying and comparing interned_strings
+	/// is as cheap as copying and comparing pointers.
+	///
+	class interned_string
+	{
+	public:
+		typedef eastl_size_t size_type;
+		typedef uint32_t     handle_type;
+
+	public:
+		interned_string() EA_NOEXCEPT
+			: mpEntry(Internal::GetEmptyInternedStringEntry()) {}
+
+		const char* c_str() const EA_NOEXCEPT        { return mpEntry->mData; }
+		const char* data() const EA_NOEXCEPT         { return mpEntry->mData; }
+		size_type   size() const EA_NOEXCEPT         { return mpEntry->mnLength; }
+		size_type   length() const EA_NOEXCEPT       { return mpEntry->mnLength; }
+		bool        empty() const EA_NOEXCEPT        { return mpEntry->mnLength == 0; }
+
+		/// Returns the hash of the string, which was computed when it was interned.
+		uint32_t    hash() const EA_NOEXCEPT         { return mpEntry->mnHash; }
+
+		/// Returns the handle which string_pool::get maps back to this string.
+		handle_type handle() const EA_NOEXCEPT       { return mpEntry->mnHandle; }
+
+		string_view view() const EA_NOEXCEPT         { return string_view(mpEntry->mData, mpEntry->mnLength); }
+		operator string_view() const EA_NOEXCEPT     { return view(); }
+
+		bool operator==(const interned_string& x) const EA_NOEXCEPT { return mpEntry == x.mpEntry; }
+		bool operator!=(const interned_string& x) const EA_NOEXCEPT { return mpEntry != x.mpEntry; }
+
+	protected:
+		template <typename> friend class basic_string_pool;
+
+		explicit interned_string(const Internal::interned_string_entry* pEntry) EA_NOEXCEPT
+			: mpEntry(pEntry) {}
+
+		const Internal::interned_string_entry* mpEntry;
+	};
+
+
+	template <>
+	struct hash<interned_string>
+	{
+		size_t operator()(const interned_string& x) const EA_NOEXCEPT { return (size_t)x.hash(); }
+	};
+
+
+
+	/// basic_string_pool
+	///
+	/// Example usage:
+	///     eastl::string_pool pool;
+	///
+	///     eastl::interned_string a = pool.intern("player_spawn");
+	///     eastl::interned_string b = pool.intern(eastl::string("player_") + "spawn");
+	///     a == b;                          // true, and a.c_str() == b.c_str().
+	///
+	///     uint32_t handle = a.handle();
+	///     pool.get(handle) == a;           // true
+	///
+	template <typename Allocator = EASTLAllocatorType>
+	class basic_string_pool
+	{
+		typedef basic_string_pool<Allocator>     this_type;
+		typedef Internal::interned_string_entry  entry_type;
+
+	public:
+		typedef Allocator    allocator_type;
+		typedef eastl_size_t size_type;
+		typedef uint32_t     handle_type;
+
+	public:
+		explicit basic_string_pool(const allocator_type& allocator = EASTL_STRING_POOL_DEFAULT_ALLOCATOR);
+	   ~basic_string_pool();
+
+		// A pool can't be copied, as its interned_strings point into it.
+		basic_string_pool(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+		/// Returns the interned copy of the given string, adding it to the pool if needed.
+		interned_string intern(const string_view& sv);
+		interned_string intern(const char* p);
+
+		/// Returns the interned copy of the given string if the pool holds one, else the
+		/// empty interned_string. Nothing is added to the pool.
+		interned_string find(const string_view& sv) const;
+		bool            contains(const string_view& sv) const;
+
+		/// Returns the interned_string with the given handle, which must be valid.
+		interned_string get(handle_type handle) const;
+		bool            is_valid_handle(handle_type handle) const EA_NOEXCEPT;
+
+		/// Returns the number of distinct non-empty strings in the pool.
+		size_type size() const EA_NOEXCEPT;
+		bool      empty() const EA_NOEXCEPT;
+
+		/// Returns the number of bytes allocated for the strings, the index and the handle table.
+		size_type allocated_memory() const EA_NOEXCEPT;
+
+		/// Makes room in the index for n strings in total without rehashing.
+		void reserve(size_type n);
+
+		/// Frees all the strings. This invalidates all interned_strings and handles from this pool.
+		void clear();
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT;
+		allocator_type&       get_allocator() EA_NOEXCEPT;
+		void                  set_allocator(const allocator_type& allocator);
+
+		bool validate() const;
+
+	protected:
+		struct Block
+		{
+			Block*    mpNext;
+			size_type mnSize;
+		};
+
+		// An index slot is unused if its handle is 0, which is the handle of the empty string.
+		struct IndexSlot
+		{
+			uint32_t mnHash;
+			uint32_t mnHandle;
+		};
+
+		typedef vector<const entry_type*, Allocator> handle_table_type;
+
+		allocator_type    mAllocator;
+		Block*            mpBlockList;
+		char*             mpBlockCurrent;     // The free part of the most recent shared block.
+		char*             mpBlockEnd;
+		size_type         mnBlockMemory;
+		IndexSlot*        mpIndex;
+		size_type         mnIndexCapacity;    // Zero or a power of two.
+		handle_table_type mHandles;           // Indexed by handle. mHandles[0] is the empty string.
+
+		size_type         DoFindSlot(const string_view& sv, uint32_t nHash) const;
+		const entry_type* DoAllocateEntry(const string_view& sv, uint32_t nHash);
+		void              DoRehash(size_type nIndexCapacity);
+		void              DoFreeBlocks();
+	}; // basic_string_pool
+
+
+	/// string_pool
+	///
+	typedef basic_string_pool<> string_pool;
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// basic_string_pool
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Allocator>
+	inline basic_string_pool<Allocator>::basic_string_pool(const allocator_type& allocator)
+		: mAllocator(allocator),
+		  mpBlockList(NULL),
+		  mpBlockCurrent(NULL),
+		  mpBlockEnd(NULL),
+		  mnBlockMemory(0),
+		  mpIndex(NULL),
+		  mnIndexCapacity(0),
+		  mHandles(allocator)
+	{
+		mHandles.push_back(Internal::GetEmptyInternedStringEntry());
+	}
+
+
+	template <typename Allocator>
+	inline basic_string_pool<Allocator>::~basic_string_pool()
+	{
+		DoFreeBlocks();
+
+		if(mpIndex)
+			EASTLFree(mAllocator, mpIndex, mnIndexCapacity * sizeof(IndexSlot));
+	}
+
+
+	template <typename Allocator>
+	interned_string basic_string_pool<Allocator>::intern(const string_view& sv)
+	{
+		if(sv.empty())
+			return interned_string();
+
+		const uint32_t nHash = (uint32_t)eastl::hash<string_view>()(sv);
+		size_type      nSlot = DoFindSlot(sv, nHash);
+
+		if(nSlot != (size_type)-1)
+		{
+			if(mpIndex[nSlot].mnHandle)
+				return interned_string(mHandles[mpIndex[nSlot].mnHandle]);
+		}
+
+		// Keep the index at most half full, so that probe sequences stay short.
+		if(((size() + 1) * 2) > mnIndexCapacity)
+		{
+			DoRehash(mnIndexCapacity ? (mnIndexCapacity * 2) : 64);
+			nSlot = DoFindSlot(sv, nHash);
+		}
+
+		const entry_type* const pEntry = DoAllocateEntry(sv, nHash);
+
+		mpIndex[nSlot].mnHash   = nHash;
+		mpIndex[nSlot].mnHandle = pEntry->mnHandle;
+
+		return interned_string(pEntry);
+	}
+
+
+	template <typename Allocator>
+	inline interned_string basic_string_pool<Allocator>::intern(const char* p)
+	{
+		return intern(string_view(p));
+	}
+
+
+	template <typename Allocator>
+	interned_string basic_string_pool<Allocator>::find(const string_view& sv) const
+	{
+		if(!sv.empty())
+		{
+			const size_type nSlot = DoFindSlot(sv, (uint32_t)eastl::hash<string_view>()(sv));
+
+			if((nSlot != (size_type)-1) && mpIndex[nSlot].mnHandle)
+				return interned_string(mHandles[mpIndex[nSlot].mnHandle]);
+		}
+
+		return interned_string();
+	}
+
+
+	template <typename Allocator>
+	inline bool basic_string_pool<Allocator>::contains(const string_view& sv) const
+	{
+		return sv.empty() || !find(sv).empty();
+	}
+
+
+	template <typename Allocator>
+	inline interned_string basic_string_pool<Allocator>::get(handle_type handle) const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(!is_valid_handle(handle)))
+				EASTL_FAIL_MSG("string_pool::get -- invalid handle");
+		#endif
+
+		return interned_string(mHandles[handle]);
+	}
+
+
+	template <typename Allocator>
+	inline bool basic_string_pool<Allocator>::is_valid_handle(handle_type handle) const EA_NOEXCEPT
+	{
+		return (handle < mHandles.size());
+	}
+
+
+	template <typename Allocator>
+	inline typename basic_string_pool<Allocator>::size_type
+	basic_string_pool<Allocator>::size() const EA_NOEXCEPT
+	{
+		return mHandles.size() - 1;
+	}
+
+
+	template <typename Allocator>
+	inline bool basic_string_pool<Allocator>::empty() const EA_NOEXCEPT
+	{
+		return (mHandles.size() == 1);
+	}
+
+
+	template <typename Allocator>
+	inline typename basic_string_pool<Allocator>::size_type
+	basic_string_pool<Allocator>::allocated_memory() const EA_NOEXCEPT
+	{
+		return mnBlockMemory + (mnIndexCapacity * sizeof(IndexSlot)) + (mHandles.capacity() * sizeof(const entry_type*));
+	}
+
+
+	template <typename Allocator>
+	void basic_string_pool<Allocator>::reserve(size_type n)
+	{
+		size_type nIndexCapacity = mnIndexCapacity ? mnIndexCapacity : 64;
+
+		while((n * 2) > nIndexCapacity)
+			nIndexCapacity *= 2;
+
+		if(nIndexCapacity != mnIndexCapacity)
+			DoRehash(nIndexCapacity);
+
+		mHandles.reserve(n + 1);
+	}
+
+
+	template <typename Allocator>
+	void basic_string_pool<Allocator>::clear()
+	{
+		DoFreeBlocks();
+
+		if(mpIndex)
+			memset(mpIndex, 0, mnIndexCapacity * sizeof(IndexSlot));
+
+		mHandles.resize(1);
+	}
+
+
+	template <typename Allocator>
+	inline const typename basic_string_pool<Allocator>::allocator_type&
+	basic_string_pool<Allocator>::get_allocator() const EA_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename Allocator>
+	inline typename basic_string_pool<Allocator>::allocator_type&
+	basic_string_pool<Allocator>::get_allocator() EA_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename Allocator>
+	inline void basic_string_pool<Allocator>::set_allocator(const allocator_type& allocator)
+	{
+		EASTL_ASSERT(!mpBlockList && !mpIndex); // The memory must be freed by the allocator that allocated it.
+		mAllocator = allocator;
+		mHandles.set_allocator(allocator);
+	}
+
+
+	template <typename Allocator>
+	bool basic_string_pool<Allocator>::validate() const
+	{
+		if(!mHandles.validate() || (mHandles[0] != Internal::GetEmptyInternedStringEntry()))
+			return false;
+
+		size_type nUsedSlots = 0;
+
+		for(size_type i = 0; i < mnIndexCapacity; i++)
+		{
+			const IndexSlot& slot = mpIndex[i];
+
+			if(slot.mnHandle)
+			{
+				if((slot.mnHandle >= mHandles.size()) || (mHandles[slot.mnHandle]->mnHash != slot.mnHash))
+					return false;
+
+				const entry_type* const pEntry = mHandles[slot.mnHandle];
+				const string_view       sv(pEntry->mData, pEntry->mnLength);
+
+				if((pEntry->mnHandle != slot.mnHandle) || (pEntry->mData[pEntry->mnLength] != 0) ||
+				   ((uint32_t)eastl::hash<string_view>()(sv) != slot.mnHash) || (DoFindSlot(sv, slot.mnHash) != i))
+					return false;
+
+				nUsedSlots++;
+			}
+		}
+
+		return (nUsedSlots == size());
+	}
+
+
+	// Returns the slot which holds sv, or else the unused slot where it would be inserted,
+	// or -1 if the index hasn't been allocated.
+	template <typename Allocator>
+	typename basic_string_pool<Allocator>::size_type
+	basic_string_pool<Allocator>::DoFindSlot(const string_view& sv, uint32_t nHash) const
+	{
+		if(!mpIndex)
+			return (size_type)-1;
+
+		const size_type nMask = mnIndexCapacity - 1;
+
+		for(size_type i = (nHash & nMask); ; i = ((i + 1) & nMask))
+		{
+			const IndexSlot& slot = mpIndex[i];
+
+			if(slot.mnHandle == 0)
+				return i;
+
+			if(slot.mnHash == nHash)
+			{
+				const entry_type* const pEntry = mHandles[slot.mnHandle];
+
+				if((pEntry->mnLength == sv.size()) && (memcmp(pEntry->mData, sv.data(), sv.size()) == 0))
+					return i;
+			}
+		}
+	}
+
+
+	template <typename Allocator>
+	const typename basic_string_pool<Allocator>::entry_type*
+	basic_string_pool<Allocator>::DoAllocateEntry(const string_view& sv, uint32_t nHash)
+	{
+		EASTL_ASSERT((sv.size() < 0xffffffff) && (mHandles.size() < 0xffffffff));
+
+		const size_type nAlign = EASTL_ALIGN_OF(entry_type);
+		const size_type nSize  = (offsetof(entry_type, mData) + sv.size() + 1 + (nAlign - 1)) & ~(nAlign - 1);
+		char*           pMemory;
+
+		if((size_type)(mpBlockEnd - mpBlockCurrent) >= nSize)
+		{
+			pMemory = mpBlockCurrent;
+			mpBlockCurrent += nSize;
+		}
+		else
+		{
+			// Large strings get a block of their own, which leaves the current shared block in use.
+			const bool      bShared     = (nSize <= (EASTL_STRING_POOL_BLOCK_SIZE / 4));
+			const size_type nBlockSize  = bShared ? (size_type)EASTL_STRING_POOL_BLOCK_SIZE : (sizeof(Block) + nSize);
+			Block* const    pBlock      = (Block*)allocate_memory(mAllocator, nBlockSize, EASTL_ALIGN_OF(Block), 0);
+
+			pBlock->mpNext = mpBlockList;
+			pBlock->mnSize = nBlockSize;
+			mpBlockList    = pBlock;
+			mnBlockMemory += nBlockSize;
+
+			pMemory = (char*)(pBlock + 1);
+
+			if(bShared)
+			{
+				mpBlockCurrent = pMemory + nSize;
+				mpBlockEnd     = (char*)pBlock + nBlockSize;
+			}
+		}
+
+		entry_type* const pEntry = (entry_type*)pMemory;
+
+		pEntry->mnHash   = nHash;
+		pEntry->mnHandle = (uint32_t)mHandles.size();
+		pEntry->mnLength = (uint32_t)sv.size();
+		memcpy(pEntry->mData, sv.data(), sv.size());
+		pEntry->mData[sv.size()] = 0;
+
+		mHandles.push_back(pEntry);
+		return pEntry;
+	}
+
+
+	template <typename Allocator>
+	void basic_string_pool<Allocator>::DoRehash(size_type nIndexCapacity)
+	{
+		IndexSlot* const pIndex = (IndexSlot*)allocate_memory(mAllocator, nIndexCapacity * sizeof(IndexSlot), EASTL_ALIGN_OF(IndexSlot), 0);
+		memset(pIndex, 0, nIndexCapacity * sizeof(IndexSlot));
+
+		const size_type nMask = nIndexCapacity - 1;
+
+		for(size_type i = 0; i < mnIndexCapacity; i++)
+		{
+			if(mpIndex[i].mnHandle)
+			{
+				size_type j = (mpIndex[i].mnHash & nMask);
+
+				while(pIndex[j].mnHandle)
+					j = ((j + 1) & nMask);
+
+				pIndex[j] = mpIndex[i];
+			}
+		}
+
+		if(mpIndex)
+			EASTLFree(mAllocator, mpIndex, mnIndexCapacity * sizeof(IndexSlot));
+
+		mpIndex         = pIndex;
+		mnIndexCapacity = nIndexCapacity;
+	}
+
+
+	template <typename Allocator>
+	void basic_string_pool<Allocator>::DoFreeBlocks()
+	{
+		while(mpBlockList)
+		{
+			Block* const pNext = mpBlockList->mpNext;
+			EASTLFree(mAllocator, mpBlockList, mpBlockList->mnSize);
+			mpBlockList = pNext;
+		}
+
+		mpBlockCurrent = NULL;
+		mpBlockEnd     = NULL;
+		mnBlockMemory  = 0;
+	}
+
+} // namespace eastl
@@ -209,7 +209,7 @@ namespace eastl
 			auto* pEnd = mpBegin + mnCount;
 			if (EASTL_LIKELY(((npos - sw.size()) >= pos) && (pos + sw.size()) <= mnCount))
 			{
-				const value_type* const pTemp = eastl::search(mpBegin + pos, pEnd, sw.data(), sw.data() + sw.size());
+				const value_type* const pTemp = CharTypeStringSearch(mpBegin + pos, pEnd, sw.data(), sw.data() + sw.size());
 
 				if ((pTemp != pEnd) || (sw.size() == 0))
 					return (size_type)(pTemp - mpBegin);
@@ -601,12 +601,16 @@ namespace eastl
 	{
 		size_t operator()(const string_view& x) const
 		{
-			string_view::const_iterator p = x.cbegin();
-			string_view::const_iterator end = x.cend();
-			uint32_t result = 2166136261U; // We implement an FNV-like string hash.
-			while (p != end)
-				result = (result * 16777619) ^ (uint8_t)*p++;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(x);
+			#else
+				string_view::const_iterator p = x.cbegin();
+				string_view::const_iterator end = x.cend();
+				uint32_t result = 2166136261U; // We implement an FNV-like string hash.
+				while (p != end)
+					result = (result * 16777619) ^ (uint8_t)*p++;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -615,12 +619,16 @@ namespace eastl
 		{
 			size_t operator()(const u8string_view& x) const
 			{
-				u8string_view::const_iterator p = x.cbegin();
-				u8string_view::const_iterator end = x.cend();
-				uint32_t result = 2166136261U;
-				while (p != end)
-					result = (result * 16777619) ^ (uint8_t)*p++;
-				return (size_t)result;
+				#if EASTL_STRING_HASH_FAST
+					return fast_string_hash()(x);
+				#else
+					u8string_view::const_iterator p = x.cbegin();
+					u8string_view::const_iterator end = x.cend();
+					uint32_t result = 2166136261U;
+					while (p != end)
+						result = (result * 16777619) ^ (uint8_t)*p++;
+					return (size_t)result;
+				#endif
 			}
 		};
 	#endif
@@ -629,12 +637,16 @@ namespace eastl
 	{
 		size_t operator()(const u16string_view& x) const
 		{
-			u16string_view::const_iterator p = x.cbegin();
-			u16string_view::const_iterator end = x.cend();
-			uint32_t result = 2166136261U;
-			while (p != end)
-				result = (result * 16777619) ^ (uint16_t)*p++;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(x);
+			#else
+				u16string_view::const_iterator p = x.cbegin();
+				u16string_view::const_iterator end = x.cend();
+				uint32_t result = 2166136261U;
+				while (p != end)
+					result = (result * 16777619) ^ (uint16_t)*p++;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -642,12 +654,16 @@ namespace eastl
 	{
 		size_t operator()(const u32string_view& x) const
 		{
-			u32string_view::const_iterator p = x.cbegin();
-			u32string_view::const_iterator end = x.cend();
-			uint32_t result = 2166136261U;
-			while (p != end)
-				result = (result * 16777619) ^ (uint32_t)*p++;
-			return (size_t)result;
+			#if EASTL_STRING_HASH_FAST
+				return fast_string_hash()(x);
+			#else
+				u32string_view::const_iterator p = x.cbegin();
+				u32string_view::const_iterator end = x.cend();
+				uint32_t result = 2166136261U;
+				while (p != end)
+					result = (result * 16777619) ^ (uint32_t)*p++;
+				return (size_t)result;
+			#endif
 		}
 	};
 
@@ -656,12 +672,16 @@ namespace eastl
 		{
 			size_t operator()(const wstring_view& x) const
 			{
-				wstring_view::const_iterator p = x.cbegin();
-				wstring_view::const_iterator end = x.cend();
-				uint32_t result = 2166136261U;
-				while (p != end)
-					result = (result * 16777619) ^ (uint32_t)*p++;
-				return (size_t)result;
+				#if EASTL_STRING_HASH_FAST
+					return fast_string_hash()(x);
+				#else
+					wstring_view::const_iterator p = x.cbegin();
+					wstring_view::const_iterator end = x.cend();
+					uint32_t result = 2166136261U;
+					while (p != end)
+						result = (result * 16777619) ^ (uint32_t)*p++;
+					return (size_t)result;
+				#endif
 			}
 		};
 	#endif
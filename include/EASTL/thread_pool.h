@@ -0,0 +1,153 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     thread_pool
+//
+// thread_pool is a small work-stealing pool for fork-join parallelism, which
+// the parallel algorithms in <EASTL/execution.h> run on. Each worker has its
+// own queue of tasks. It pushes and pops at the back of its own queue, and
+// when that is empty it steals from the front of the others' queues, where the
+// largest pieces of work are. A thread which waits for a task that was stolen
+// runs other tasks in the meantime, so fork-join may nest to any depth without
+// tying up the workers.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/utility.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <atomic>
+#include <stddef.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+
+namespace eastl
+{
+
+	/// EASTL_THREAD_POOL_MAX_DEFAULT_THREADS
+	///
+	/// The largest number of worker threads that thread_pool::get_default() starts,
+	/// however many hardware threads the machine has.
+	///
+	#ifndef EASTL_THREAD_POOL_MAX_DEFAULT_THREADS
+		#define EASTL_THREAD_POOL_MAX_DEFAULT_THREADS 63
+	#endif
+
+
+
+	namespace Internal
+	{
+		struct thread_pool_state;
+
+		/// pool_task
+		///
+		/// A task which has been handed to a thread_pool. Tasks live on the stack of the
+		/// thread which made them, which waits for them to finish, so they aren't allocated.
+		struct pool_task
+		{
+			void            (*mpExecute)(pool_task*);
+			std::atomic<bool> mbDone;
+
+			explicit pool_task(void (*pExecute)(pool_task*))
+				: mpExecute(pExecute), mbDone(false) {}
+		};
+
+
+		template <typename Function>
+		struct pool_task_impl : public pool_task
+		{
+			Function* mpFunction;
+
+			explicit pool_task_impl(Function& function)
+				: pool_task(&Execute), mpFunction(&function) {}
+
+			static void Execute(pool_task* pTask)
+				{ (*static_cast<pool_task_impl*>(pTask)->mpFunction)(); }
+		};
+	}
+
+
+
+	/// thread_pool
+	///
+	/// Runs tasks for fork-join algorithms. The thread which calls invoke takes part in
+	/// running the tasks, so a pool with N worker threads runs N + 1 tasks at a time.
+	/// A pool with no worker threads runs everything on the calling thread, which is what
+	/// every pool does on platforms without thread support.
+	///
+	/// Tasks must not throw, as with the standard parallel algorithms. Tasks may call
+	/// invoke on the same pool, and any number of threads may use a pool at once.
+	///
+	/// Example usage:
+	///     eastl::thread_pool pool(4);
+	///
+	///     pool.invoke([&]{ SortLeftHalf(); }, [&]{ SortRightHalf(); });
+	///
+	class EASTL_API thread_pool
+	{
+	public:
+		/// Starts nThreadCount worker threads.
+		explicit thread_pool(size_t nThreadCount = default_thread_count());
+
+		/// Waits for the worker threads to exit. No invoke may be running.
+	   ~thread_pool();
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		/// Returns a pool with default_thread_count() workers which is never destroyed.
+		/// It is made, and its workers started, the first time this is called.
+		static thread_pool& get_default();
+
+		/// Returns one less than the number of hardware threads, as the calling thread
+		/// also runs tasks, capped at EASTL_THREAD_POOL_MAX_DEFAULT_THREADS.
+		static size_t default_thread_count();
+
+		/// Returns the number of worker threads.
+		size_t thread_count() const EA_NOEXCEPT
+			{ return mnThreadCount; }
+
+		/// Returns the number of tasks which the pool may run at once, which includes
+		/// the calling thread. Algorithms use it to decide how finely to split their work.
+		size_t concurrency() const EA_NOEXCEPT
+			{ return mnThreadCount + 1; }
+
+		/// Calls function1 and function2, possibly at the same time on different threads,
+		/// and returns once both have returned.
+		template <typename Function1, typename Function2>
+		void invoke(Function1&& function1, Function2&& function2)
+		{
+			if(mnThreadCount)
+			{
+				Internal::pool_task_impl<typename remove_reference<Function2>::type> task(function2);
+
+				DoPush(&task);
+				function1();
+				DoWait(&task);
+			}
+			else
+			{
+				function1();
+				function2();
+			}
+		}
+
+	protected:
+		void DoPush(Internal::pool_task* pTask);
+		void DoWait(Internal::pool_task* pTask);
+
+	protected:
+		Internal::thread_pool_state* mpState;
+		size_t                       mnThreadCount;
+	};
+
+} // namespace eastl
@@ -171,6 +171,7 @@
 //    detected_or_t                         Equivalent to detected_or<Default, Op, Args...>::type.
 //    is_detected_exact                     Check that the type we obtain after expanding some arguments (Args) over a constraint (Op) is equivalent to Expected.
 //    is_detected_convertible               Check that the type we obtain after expanding some arguments (Args) over a constraint (Op) is convertible to Expected.
+//    is_trivially_relocatable              T can be moved to new storage with memcpy, without running the old object's destructor. Opt-in via EASTL_DECLARE_TRIVIALLY_RELOCATABLE or specialization.
 //
 // Deprecated pre-C++11 type traits
 //    add_reference							Deprecated in favor of add_lvalue_reference(_t).
@@ -328,6 +328,11 @@ namespace eastl
 	}; // class unique_ptr
 
 
+	// unique_ptr (including the array form) is a pointer plus its deleter, so it can be relocated with memcpy whenever the deleter can.
+	template <typename T, typename Deleter>
+	struct is_trivially_relocatable<unique_ptr<T, Deleter>> : public is_trivially_relocatable<Deleter> {};
+
+
 
 	/// unique_ptr specialization for unbounded arrays.
 	///
@@ -628,6 +628,10 @@ namespace eastl
 		}
 	};
 
+	template <typename T1, typename T2>
+	struct is_trivially_relocatable<pair<T1, T2>>
+		: public bool_constant<is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
+
 	#define EASTL_PAIR_CONFORMANCE 1
 
 
@@ -394,11 +394,24 @@ namespace eastl
 
 		void DoGrow(size_type n);
 
+		// Reallocation helpers. DoRelocate moves [first, last) into uninitialized memory at dest, the same
+		// way uninitialized_move_if_noexcept does, except that is_trivially_relocatable types are simply
+		// memmoved. DoFreeRelocated then frees the old buffer, destroying the old elements only if they
+		// were not memmoved. Since memmoved elements have no owner but dest, nothing that can throw may
+		// happen after the first DoRelocate call for a trivially relocatable type.
+		pointer DoRelocate(pointer first, pointer last, pointer dest);
+		void    DoFreeRelocated();
+
 		void DoSwap(this_type& x);
 
 	}; // class vector
 
 
+	// vector only holds pointers to its heap buffer, so it can be relocated with memcpy whenever its allocator can.
+	template <typename T, typename Allocator>
+	struct is_trivially_relocatable<vector<T, Allocator>> : public is_trivially_relocatable<Allocator> {};
+
+
 
 
 
@@ -865,9 +878,9 @@ namespace eastl
 		}
 		else // Else new capacity > size.
 		{
-			pointer const pNewData = DoRealloc(n, mpBegin, mpEnd, should_move_tag());
-			eastl::destruct(mpBegin, mpEnd);
-			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+			pointer const pNewData = DoAllocate(n);
+			DoRelocate(mpBegin, mpEnd, pNewData);
+			DoFreeRelocated();
 
 			const ptrdiff_t nPrevSize = mpEnd - mpBegin;
 			mpBegin    = pNewData;
@@ -1617,33 +1630,44 @@ namespace eastl
 			}
 			else // else we need to expand our capacity.
 			{
+				const size_type nPosSize  = size_type(destPosition - mpBegin);
 				const size_type nPrevSize = size_type(mpEnd - mpBegin);
 				const size_type nGrowSize = GetNewCapacity(nPrevSize);
 				const size_type nNewSize  = nGrowSize > (nPrevSize + n) ? nGrowSize : (nPrevSize + n);
 				pointer const   pNewData  = DoAllocate(nNewSize);
 
+				// The new values are constructed before the old ones are relocated, as relocation must come last (see DoRelocate).
 				#if EASTL_EXCEPTIONS_ENABLED
+					try
+					{
+						eastl::uninitialized_copy(first, last, pNewData + nPosSize);
+					}
+					catch(...)
+					{
+						DoFree(pNewData, nNewSize);
+						throw;
+					}
+
 					pointer pNewEnd = pNewData;
 					try
 					{
-						pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, destPosition, pNewData);
-						pNewEnd = eastl::uninitialized_copy(first, last, pNewEnd);
-						pNewEnd = eastl::uninitialized_move_if_noexcept(destPosition, mpEnd, pNewEnd);
+						pNewEnd = DoRelocate(mpBegin, destPosition, pNewData);
+						pNewEnd = DoRelocate(destPosition, mpEnd, pNewEnd + n);
 					}
 					catch(...)
 					{
 						eastl::destruct(pNewData, pNewEnd);
+						eastl::destruct(pNewData + nPosSize, pNewData + nPosSize + n);
 						DoFree(pNewData, nNewSize);
 						throw;
 					}
 				#else
-					pointer pNewEnd = eastl::uninitialized_move(mpBegin, destPosition, pNewData);
-					pNewEnd         = eastl::uninitialized_copy(first, last, pNewEnd);
-					pNewEnd         = eastl::uninitialized_move(destPosition, mpEnd, pNewEnd);
+					eastl::uninitialized_copy(first, last, pNewData + nPosSize);
+					pointer pNewEnd = DoRelocate(mpBegin, destPosition, pNewData);
+					pNewEnd         = DoRelocate(destPosition, mpEnd, pNewEnd + n);
 				#endif
 
-				eastl::destruct(mpBegin, mpEnd);
-				DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+				DoFreeRelocated();
 
 				mpBegin    = pNewData;
 				mpEnd      = pNewEnd;
@@ -1690,33 +1714,45 @@ namespace eastl
 		}
 		else // else n > capacity
 		{
+			const size_type nPosSize  = size_type(destPosition - mpBegin);
 			const size_type nPrevSize = size_type(mpEnd - mpBegin);
 			const size_type nGrowSize = GetNewCapacity(nPrevSize);
 			const size_type nNewSize  = nGrowSize > (nPrevSize + n) ? nGrowSize : (nPrevSize + n);
 			pointer const pNewData    = DoAllocate(nNewSize);
 
+			// The new values are constructed before the old ones are relocated, as relocation must come last (see DoRelocate).
+			// This also means that value may safely refer to an element of this vector.
 			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+					eastl::uninitialized_fill_n(pNewData + nPosSize, n, value);
+				}
+				catch(...)
+				{
+					DoFree(pNewData, nNewSize);
+					throw;
+				}
+
 				pointer pNewEnd = pNewData;
 				try
 				{
-					pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, destPosition, pNewData);
-					eastl::uninitialized_fill_n(pNewEnd, n, value);
-					pNewEnd = eastl::uninitialized_move_if_noexcept(destPosition, mpEnd, pNewEnd + n);
+					pNewEnd = DoRelocate(mpBegin, destPosition, pNewData);
+					pNewEnd = DoRelocate(destPosition, mpEnd, pNewEnd + n);
 				}
 				catch(...)
 				{
 					eastl::destruct(pNewData, pNewEnd);
+					eastl::destruct(pNewData + nPosSize, pNewData + nPosSize + n);
 					DoFree(pNewData, nNewSize);
 					throw;
 				}
 			#else
-				pointer pNewEnd = eastl::uninitialized_move(mpBegin, destPosition, pNewData);
-				eastl::uninitialized_fill_n(pNewEnd, n, value);
-				pNewEnd = eastl::uninitialized_move(destPosition, mpEnd, pNewEnd + n);
+				eastl::uninitialized_fill_n(pNewData + nPosSize, n, value);
+				pointer pNewEnd = DoRelocate(mpBegin, destPosition, pNewData);
+				pNewEnd = DoRelocate(destPosition, mpEnd, pNewEnd + n);
 			#endif
 
-			eastl::destruct(mpBegin, mpEnd);
-			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+			DoFreeRelocated();
 
 			mpBegin    = pNewData;
 			mpEnd      = pNewEnd;
@@ -1739,10 +1775,9 @@ namespace eastl
 	{
 		pointer const pNewData = DoAllocate(n);
 
-		pointer pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, mpEnd, pNewData);
+		pointer pNewEnd = DoRelocate(mpBegin, mpEnd, pNewData);
 
-		eastl::destruct(mpBegin, mpEnd);
-		DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+		DoFreeRelocated();
 
 		mpBegin    = pNewData;
 		mpEnd      = pNewEnd;
@@ -1750,6 +1785,27 @@ namespace eastl
 	}
 
 
+	template <typename T, typename Allocator>
+	inline typename vector<T, Allocator>::pointer
+	vector<T, Allocator>::DoRelocate(pointer first, pointer last, pointer dest)
+	{
+		EA_CONSTEXPR_IF(eastl::is_trivially_relocatable<value_type>::value)
+			return eastl::uninitialized_relocate(first, last, dest);
+		else
+			return eastl::uninitialized_move_if_noexcept(first, last, dest);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void vector<T, Allocator>::DoFreeRelocated()
+	{
+		EA_CONSTEXPR_IF(!eastl::is_trivially_relocatable<value_type>::value)
+			eastl::destruct(mpBegin, mpEnd);
+
+		DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+	}
+
+
 	template <typename T, typename Allocator>
 	inline void vector<T, Allocator>::DoSwap(this_type& x)
 	{
@@ -1770,27 +1826,36 @@ namespace eastl
 			const size_type nNewSize = eastl::max(nGrowSize, nPrevSize + n);
 			pointer const pNewData = DoAllocate(nNewSize);
 
+			// The new values are constructed before the old ones are relocated, as relocation must come last (see DoRelocate).
 			#if EASTL_EXCEPTIONS_ENABLED
-				pointer pNewEnd = pNewData; // Assign pNewEnd a value here in case the copy throws.
 				try
 				{
-					pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, mpEnd, pNewData);
+					eastl::uninitialized_fill_n(pNewData + nPrevSize, n, value);
 				}
 				catch(...)
 				{
-					eastl::destruct(pNewData, pNewEnd);
+					DoFree(pNewData, nNewSize);
+					throw;
+				}
+
+				try
+				{
+					DoRelocate(mpBegin, mpEnd, pNewData);
+				}
+				catch(...)
+				{
+					eastl::destruct(pNewData + nPrevSize, pNewData + nPrevSize + n);
 					DoFree(pNewData, nNewSize);
 					throw;
 				}
 			#else
-				pointer pNewEnd = eastl::uninitialized_move(mpBegin, mpEnd, pNewData);
+				eastl::uninitialized_fill_n(pNewData + nPrevSize, n, value);
+				DoRelocate(mpBegin, mpEnd, pNewData);
 			#endif
 
-			eastl::uninitialized_fill_n(pNewEnd, n, value);
-			pNewEnd += n;
+			pointer const pNewEnd = pNewData + nPrevSize + n;
 
-			eastl::destruct(mpBegin, mpEnd);
-			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+			DoFreeRelocated();
 
 			mpBegin    = pNewData;
 			mpEnd      = pNewEnd;
@@ -1813,24 +1878,30 @@ namespace eastl
 			const size_type nNewSize = eastl::max(nGrowSize, nPrevSize + n);
 			pointer const pNewData = DoAllocate(nNewSize);
 
+			// The new values are constructed before the old ones are relocated, as relocation must come last (see DoRelocate).
 			#if EASTL_EXCEPTIONS_ENABLED
-				pointer pNewEnd = pNewData;  // Assign pNewEnd a value here in case the copy throws.
-				try { pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, mpEnd, pNewData); }
+				try { eastl::uninitialized_value_construct_n(pNewData + nPrevSize, n); }
 				catch (...)
 				{
-					eastl::destruct(pNewData, pNewEnd);
+					DoFree(pNewData, nNewSize);
+					throw;
+				}
+
+				try { DoRelocate(mpBegin, mpEnd, pNewData); }
+				catch (...)
+				{
+					eastl::destruct(pNewData + nPrevSize, pNewData + nPrevSize + n);
 					DoFree(pNewData, nNewSize);
 					throw;
 				}
 			#else
-				pointer pNewEnd = eastl::uninitialized_move(mpBegin, mpEnd, pNewData);
+				eastl::uninitialized_value_construct_n(pNewData + nPrevSize, n);
+				DoRelocate(mpBegin, mpEnd, pNewData);
 			#endif
 
-			eastl::uninitialized_value_construct_n(pNewEnd, n);
-			pNewEnd += n;
+			pointer const pNewEnd = pNewData + nPrevSize + n;
 
-			eastl::destruct(mpBegin, mpEnd);
-			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+			DoFreeRelocated();
 
 			mpBegin = pNewData;
 			mpEnd = pNewEnd;
@@ -1891,8 +1962,8 @@ namespace eastl
 					// call eastl::destruct on the entire range if only the first part of the range was constructed.
 					::new((void*)(pNewData + nPosSize)) value_type(eastl::forward<Args>(args)...);              // Because the old data is potentially being moved rather than copied, we need to move.
 					pNewEnd = NULL;                                                                             // Set to NULL so that in catch we can tell the exception occurred during the next call.
-					pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, destPosition, pNewData);           // the value first, because it might possibly be a reference to the old data being moved.
-					pNewEnd = eastl::uninitialized_move_if_noexcept(destPosition, mpEnd, ++pNewEnd);
+					pNewEnd = DoRelocate(mpBegin, destPosition, pNewData);                                      // the value first, because it might possibly be a reference to the old data being moved.
+					pNewEnd = DoRelocate(destPosition, mpEnd, ++pNewEnd);
 				}
 				catch(...)
 				{
@@ -1905,12 +1976,11 @@ namespace eastl
 				}
 			#else
 				::new((void*)(pNewData + nPosSize)) value_type(eastl::forward<Args>(args)...);                  // Because the old data is potentially being moved rather than copied, we need to move 
-				pointer pNewEnd = eastl::uninitialized_move(mpBegin, destPosition, pNewData);					// the value first, because it might possibly be a reference to the old data being moved.
-				pNewEnd = eastl::uninitialized_move(destPosition, mpEnd, ++pNewEnd);
+				pointer pNewEnd = DoRelocate(mpBegin, destPosition, pNewData);									// the value first, because it might possibly be a reference to the old data being moved.
+				pNewEnd = DoRelocate(destPosition, mpEnd, ++pNewEnd);
 			#endif
 
-			eastl::destruct(mpBegin, mpEnd);
-			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+			DoFreeRelocated();
 
 			mpBegin    = pNewData;
 			mpEnd      = pNewEnd;
@@ -1927,31 +1997,38 @@ namespace eastl
 		const size_type nNewSize  = GetNewCapacity(nPrevSize);
 		pointer const   pNewData  = DoAllocate(nNewSize);
 
+		// The new value is constructed before the old ones are relocated, as relocation must come last (see DoRelocate).
+		// This also means that args may safely refer to an element of this vector.
 		#if EASTL_EXCEPTIONS_ENABLED
-			pointer pNewEnd = pNewData; // Assign pNewEnd a value here in case the copy throws.
 			try
 			{
-				pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, mpEnd, pNewData);
-				::new((void*)pNewEnd) value_type(eastl::forward<Args>(args)...);
-				pNewEnd++;
+				::new((void*)(pNewData + nPrevSize)) value_type(eastl::forward<Args>(args)...);
 			}
 			catch(...)
 			{
-				eastl::destruct(pNewData, pNewEnd);
+				DoFree(pNewData, nNewSize);
+				throw;
+			}
+
+			try
+			{
+				DoRelocate(mpBegin, mpEnd, pNewData);
+			}
+			catch(...)
+			{
+				eastl::destruct(pNewData + nPrevSize);
 				DoFree(pNewData, nNewSize);
 				throw;
 			}
 		#else
-			pointer pNewEnd = eastl::uninitialized_move(mpBegin, mpEnd, pNewData);
-			::new((void*)pNewEnd) value_type(eastl::forward<Args>(args)...);
-			pNewEnd++;
+			::new((void*)(pNewData + nPrevSize)) value_type(eastl::forward<Args>(args)...);
+			DoRelocate(mpBegin, mpEnd, pNewData);
 		#endif
 
-		eastl::destruct(mpBegin, mpEnd);
-		DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+		DoFreeRelocated();
 
 		mpBegin    = pNewData;
-		mpEnd      = pNewEnd;
+		mpEnd      = pNewData + nPrevSize + 1;
 		internalCapacityPtr() = pNewData + nNewSize;
 	}
 
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/arena_allocator.h>
+
+
+
+namespace eastl
+{
+
+	namespace
+	{
+		#if !defined(EA_COMPILER_NO_THREAD_LOCAL)
+			thread_local arena* gpDefaultArena = NULL;
+		#else
+			arena* gpDefaultArena = NULL;
+		#endif
+	}
+
+
+	EASTL_API arena* GetDefaultArena()
+	{
+		return gpDefaultArena;
+	}
+
+
+	EASTL_API arena* SetDefaultArena(arena* pArena)
+	{
+		arena* const pPrevArena = gpDefaultArena;
+		gpDefaultArena = pArena;
+		return pPrevArena;
+	}
+
+
+
+	arena::arena(size_t nInitialBlockSize, const EASTLAllocatorType& allocator)
+		: mAllocator(allocator)
+		, mpFirstBlock(NULL)
+		, mpCurrentBlock(NULL)
+		, mpLastBlock(NULL)
+		, mpCurrent(NULL)
+		, mpEnd(NULL)
+		, mnNextBlockSize(nInitialBlockSize)
+		, mnAllocatedSize(0)
+		, mnCapacity(0)
+		, mnBlockCount(0)
+	{
+	}
+
+
+	arena::arena(void* pBuffer, size_t nBufferSize, const EASTLAllocatorType& allocator)
+		: mAllocator(allocator)
+		, mpFirstBlock(NULL)
+		, mpCurrentBlock(NULL)
+		, mpLastBlock(NULL)
+		, mpCurrent(NULL)
+		, mpEnd(NULL)
+		, mnNextBlockSize(EASTL_ARENA_DEFAULT_BLOCK_SIZE)
+		, mnAllocatedSize(0)
+		, mnCapacity(0)
+		, mnBlockCount(0)
+	{
+		// The buffer's block header goes at its start, aligned for a Block.
+		char* const pBlock = (char*)(((uintptr_t)pBuffer + (EASTL_ALIGN_OF(Block) - 1)) & ~(uintptr_t)(EASTL_ALIGN_OF(Block) - 1));
+
+		if(pBuffer && ((size_t)(pBlock - (char*)pBuffer) + sizeof(Block)) <= nBufferSize)
+		{
+			mpFirstBlock = mpLastBlock = (Block*)pBlock;
+			mpFirstBlock->mpNext  = NULL;
+			mpFirstBlock->mpEnd   = (char*)pBuffer + nBufferSize;
+			mpFirstBlock->mbOwned = false;
+			mnCapacity   = nBufferSize;
+			mnBlockCount = 1;
+
+			if(mnNextBlockSize < nBufferSize)
+				mnNextBlockSize = nBufferSize;
+			DoSetCurrentBlock(mpFirstBlock);
+		}
+	}
+
+
+	arena::~arena()
+	{
+		release();
+	}
+
+
+	void arena::reset()
+	{
+		mnAllocatedSize = 0;
+
+		if(mpFirstBlock)
+			DoSetCurrentBlock(mpFirstBlock);
+	}
+
+
+	void arena::release()
+	{
+		Block* pKeep = NULL; // A user-supplied buffer is always the first block, and is kept.
+
+		for(Block* pBlock = mpFirstBlock; pBlock; )
+		{
+			Block* const pNext = pBlock->mpNext;
+
+			if(pBlock->mbOwned)
+			{
+				mnCapacity -= (size_t)(pBlock->mpEnd - (char*)pBlock);
+				EASTLFree(mAllocator, pBlock, (size_t)(pBlock->mpEnd - (char*)pBlock));
+			}
+			else
+				pKeep = pBlock;
+
+			pBlock = pNext;
+		}
+
+		mpFirstBlock = mpLastBlock = pKeep;
+		mpCurrentBlock  = NULL;
+		mpCurrent       = NULL;
+		mpEnd           = NULL;
+		mnAllocatedSize = 0;
+		mnBlockCount    = pKeep ? 1 : 0;
+
+		if(pKeep)
+		{
+			pKeep->mpNext = NULL;
+			DoSetCurrentBlock(pKeep);
+		}
+	}
+
+
+	const char* arena::get_name() const
+	{
+		return mAllocator.get_name();
+	}
+
+
+	void arena::set_name(const char* pName)
+	{
+		mAllocator.set_name(pName);
+	}
+
+
+	void arena::DoSetCurrentBlock(Block* pBlock)
+	{
+		mpCurrentBlock = pBlock;
+		mpCurrent      = BlockBegin(pBlock);
+		mpEnd          = pBlock->mpEnd;
+	}
+
+
+	void* arena::DoAllocateFromNextBlock(size_t n, size_t alignment, size_t alignmentOffset)
+	{
+		// Blocks kept by reset() are reused in order before any new block is allocated.
+		// A retained block which is too small for this allocation is skipped; its space
+		// comes back at the next reset.
+		while(mpCurrentBlock && mpCurrentBlock->mpNext)
+		{
+			DoSetCurrentBlock(mpCurrentBlock->mpNext);
+
+			char* const p = AlignUp(mpCurrent, alignment, alignmentOffset);
+
+			if((p <= mpEnd) && (n <= (size_t)(mpEnd - p)))
+			{
+				mpCurrent        = p + n;
+				mnAllocatedSize += n;
+				return p;
+			}
+		}
+
+		// Room for the header, the allocation and the worst case alignment padding.
+		const size_t nRequiredSize = sizeof(Block) + n + alignment + alignmentOffset;
+		size_t nBlockSize = mnNextBlockSize;
+
+		if(nBlockSize < nRequiredSize)
+			nBlockSize = nRequiredSize;
+		else if(mnNextBlockSize < EASTL_ARENA_MAX_BLOCK_SIZE)
+			mnNextBlockSize = ((mnNextBlockSize * 2) < EASTL_ARENA_MAX_BLOCK_SIZE) ? (mnNextBlockSize * 2) : EASTL_ARENA_MAX_BLOCK_SIZE;
+
+		Block* const pBlock = (Block*)allocate_memory(mAllocator, nBlockSize, EASTL_ALIGN_OF(Block), 0);
+
+		if(!pBlock) // If the backing allocator is out of memory...
+			return NULL;
+
+		pBlock->mpNext  = NULL;
+		pBlock->mpEnd   = (char*)pBlock + nBlockSize;
+		pBlock->mbOwned = true;
+
+		if(mpLastBlock)
+			mpLastBlock->mpNext = pBlock;
+		else
+			mpFirstBlock = pBlock;
+
+		mpLastBlock   = pBlock;
+		mnCapacity   += nBlockSize;
+		mnBlockCount += 1;
+		DoSetCurrentBlock(pBlock);
+
+		char* const p = AlignUp(mpCurrent, alignment, alignmentOffset);
+		mpCurrent        = p + n;
+		mnAllocatedSize += n;
+		return p;
+	}
+
+} // namespace eastl
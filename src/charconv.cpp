@@ -0,0 +1,1029 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/charconv.h>
+#include <EABase/eabase.h>
+#include <EASTL/allocator.h>
+#include <locale.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+namespace eastl
+{
+	namespace Internal
+	{
+		EASTL_API const char gCharConvDigitPairs[200] =
+		{
+			'0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+			'1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+			'2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+			'3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+			'4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+			'5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+			'6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+			'7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+			'8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+			'9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+		};
+	}
+
+
+	namespace
+	{
+		///////////////////////////////////////////////////////////////////////
+		// Grisu3
+		//
+		// Finds the shortest decimal representation which lies strictly
+		// between the midpoints of a value and its two neighbours, so that
+		// reading it back produces the same value. See Loitsch, "Printing
+		// Floating-Point Numbers Quickly and Accurately with Integers", PLDI
+		// 2010. The few values it can't decide are handled by a slower exact
+		// search.
+		//
+		// All values here are positive and finite; sign, zero, infinity and
+		// NaN are handled by the callers.
+		///////////////////////////////////////////////////////////////////////
+
+		// A "do-it-yourself floating point" value of f * 2^e.
+		struct DiyFp
+		{
+			uint64_t f;
+			int      e;
+
+			DiyFp(uint64_t f_, int e_) : f(f_), e(e_) {}
+		};
+
+		inline DiyFp DiyFpSub(const DiyFp& x, const DiyFp& y) // Requires x.e == y.e and x.f >= y.f.
+		{
+			return DiyFp(x.f - y.f, x.e);
+		}
+
+		// Returns x * y, rounded to the upper 64 bits of the 128 bit product.
+		inline DiyFp DiyFpMul(const DiyFp& x, const DiyFp& y)
+		{
+			const uint64_t u_lo = (x.f & 0xFFFFFFFFu), u_hi = (x.f >> 32);
+			const uint64_t v_lo = (y.f & 0xFFFFFFFFu), v_hi = (y.f >> 32);
+
+			const uint64_t p0 = u_lo * v_lo;
+			const uint64_t p1 = u_lo * v_hi;
+			const uint64_t p2 = u_hi * v_lo;
+			const uint64_t p3 = u_hi * v_hi;
+
+			uint64_t q = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+			q += (uint64_t(1) << 31); // Round.
+
+			return DiyFp(p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32), x.e + y.e + 64);
+		}
+
+		inline DiyFp DiyFpNormalize(DiyFp x) // Requires x.f != 0.
+		{
+			while((x.f >> 63) == 0)
+			{
+				x.f <<= 1;
+				x.e--;
+			}
+			return x;
+		}
+
+		inline DiyFp DiyFpNormalizeTo(const DiyFp& x, int e) // Requires e <= x.e and no bits to be lost.
+		{
+			return DiyFp(x.f << (x.e - e), e);
+		}
+
+
+		// Returns v along with the boundaries m- and m+ which lie halfway between v and its
+		// neighbours, with m- and m+ sharing the exponent of the normalized m+.
+		template <typename T>
+		void ComputeBoundaries(T value, DiyFp& v, DiyFp& mMinus, DiyFp& mPlus)
+		{
+			typedef typename conditional<(sizeof(T) == 4), uint32_t, uint64_t>::type bits_type;
+
+			const int       kPrecision = eastl::numeric_limits<T>::digits; // Including the hidden bit.
+			const int       kBias      = eastl::numeric_limits<T>::max_exponent - 1 + (kPrecision - 1);
+			const int       kMinExp    = 1 - kBias;
+			const uint64_t  kHiddenBit = uint64_t(1) << (kPrecision - 1);
+
+			bits_type bits;
+			memcpy(&bits, &value, sizeof(bits));
+
+			const uint64_t E = (uint64_t)bits >> (kPrecision - 1);
+			const uint64_t F = (uint64_t)bits & (kHiddenBit - 1);
+
+			v = (E == 0) ? DiyFp(F, kMinExp) : DiyFp(F + kHiddenBit, (int)E - kBias);
+
+			// The lower boundary is closer when v is a power of two, except for the smallest normal.
+			const bool bLowerBoundaryIsCloser = (F == 0) && (E > 1);
+
+			const DiyFp plus  = DiyFp((v.f << 1) + 1, v.e - 1);
+			const DiyFp minus = bLowerBoundaryIsCloser ? DiyFp((v.f << 2) - 1, v.e - 2) : DiyFp((v.f << 1) - 1, v.e - 1);
+
+			mPlus  = DiyFpNormalize(plus);
+			mMinus = DiyFpNormalizeTo(minus, mPlus.e);
+			v      = DiyFpNormalize(v);
+		}
+
+
+		// The binary exponent range of the scaled values. Within this range the
+		// integral part of the scaled m+ fits in 32 bits.
+		const int kGrisuAlpha = -60;
+		const int kGrisuGamma = -32;
+
+		struct CachedPower // c = f * 2^e ~= 10^k
+		{
+			uint64_t f;
+			int      e;
+			int      k;
+		};
+
+		// Normalized powers of ten from 10^-300 to 10^324 in steps of 8.
+		const CachedPower kCachedPowers[] =
+		{
+			{ UINT64_C(0xAB70FE17C79AC6CA), -1060, -300 },
+			{ UINT64_C(0xFF77B1FCBEBCDC4F), -1034, -292 },
+			{ UINT64_C(0xBE5691EF416BD60C), -1007, -284 },
+			{ UINT64_C(0x8DD01FAD907FFC3C),  -980, -276 },
+			{ UINT64_C(0xD3515C2831559A83),  -954, -268 },
+			{ UINT64_C(0x9D71AC8FADA6C9B5),  -927, -260 },
+			{ UINT64_C(0xEA9C227723EE8BCB),  -901, -252 },
+			{ UINT64_C(0xAECC49914078536D),  -874, -244 },
+			{ UINT64_C(0x823C12795DB6CE57),  -847, -236 },
+			{ UINT64_C(0xC21094364DFB5637),  -821, -228 },
+			{ UINT64_C(0x9096EA6F3848984F),  -794, -220 },
+			{ UINT64_C(0xD77485CB25823AC7),  -768, -212 },
+			{ UINT64_C(0xA086CFCD97BF97F4),  -741, -204 },
+			{ UINT64_C(0xEF340A98172AACE5),  -715, -196 },
+			{ UINT64_C(0xB23867FB2A35B28E),  -688, -188 },
+			{ UINT64_C(0x84C8D4DFD2C63F3B),  -661, -180 },
+			{ UINT64_C(0xC5DD44271AD3CDBA),  -635, -172 },
+			{ UINT64_C(0x936B9FCEBB25C996),  -608, -164 },
+			{ UINT64_C(0xDBAC6C247D62A584),  -582, -156 },
+			{ UINT64_C(0xA3AB66580D5FDAF6),  -555, -148 },
+			{ UINT64_C(0xF3E2F893DEC3F126),  -529, -140 },
+			{ UINT64_C(0xB5B5ADA8AAFF80B8),  -502, -132 },
+			{ UINT64_C(0x87625F056C7C4A8B),  -475, -124 },
+			{ UINT64_C(0xC9BCFF6034C13053),  -449, -116 },
+			{ UINT64_C(0x964E858C91BA2655),  -422, -108 },
+			{ UINT64_C(0xDFF9772470297EBD),  -396, -100 },
+			{ UINT64_C(0xA6DFBD9FB8E5B88F),  -369,  -92 },
+			{ UINT64_C(0xF8A95FCF88747D94),  -343,  -84 },
+			{ UINT64_C(0xB94470938FA89BCF),  -316,  -76 },
+			{ UINT64_C(0x8A08F0F8BF0F156B),  -289,  -68 },
+			{ UINT64_C(0xCDB02555653131B6),  -263,  -60 },
+			{ UINT64_C(0x993FE2C6D07B7FAC),  -236,  -52 },
+			{ UINT64_C(0xE45C10C42A2B3B06),  -210,  -44 },
+			{ UINT64_C(0xAA242499697392D3),  -183,  -36 },
+			{ UINT64_C(0xFD87B5F28300CA0E),  -157,  -28 },
+			{ UINT64_C(0xBCE5086492111AEB),  -130,  -20 },
+			{ UINT64_C(0x8CBCCC096F5088CC),  -103,  -12 },
+			{ UINT64_C(0xD1B71758E219652C),   -77,   -4 },
+			{ UINT64_C(0x9C40000000000000),   -50,    4 },
+			{ UINT64_C(0xE8D4A51000000000),   -24,   12 },
+			{ UINT64_C(0xAD78EBC5AC620000),     3,   20 },
+			{ UINT64_C(0x813F3978F8940984),    30,   28 },
+			{ UINT64_C(0xC097CE7BC90715B3),    56,   36 },
+			{ UINT64_C(0x8F7E32CE7BEA5C70),    83,   44 },
+			{ UINT64_C(0xD5D238A4ABE98068),   109,   52 },
+			{ UINT64_C(0x9F4F2726179A2245),   136,   60 },
+			{ UINT64_C(0xED63A231D4C4FB27),   162,   68 },
+			{ UINT64_C(0xB0DE65388CC8ADA8),   189,   76 },
+			{ UINT64_C(0x83C7088E1AAB65DB),   216,   84 },
+			{ UINT64_C(0xC45D1DF942711D9A),   242,   92 },
+			{ UINT64_C(0x924D692CA61BE758),   269,  100 },
+			{ UINT64_C(0xDA01EE641A708DEA),   295,  108 },
+			{ UINT64_C(0xA26DA3999AEF774A),   322,  116 },
+			{ UINT64_C(0xF209787BB47D6B85),   348,  124 },
+			{ UINT64_C(0xB454E4A179DD1877),   375,  132 },
+			{ UINT64_C(0x865B86925B9BC5C2),   402,  140 },
+			{ UINT64_C(0xC83553C5C8965D3D),   428,  148 },
+			{ UINT64_C(0x952AB45CFA97A0B3),   455,  156 },
+			{ UINT64_C(0xDE469FBD99A05FE3),   481,  164 },
+			{ UINT64_C(0xA59BC234DB398C25),   508,  172 },
+			{ UINT64_C(0xF6C69A72A3989F5C),   534,  180 },
+			{ UINT64_C(0xB7DCBF5354E9BECE),   561,  188 },
+			{ UINT64_C(0x88FCF317F22241E2),   588,  196 },
+			{ UINT64_C(0xCC20CE9BD35C78A5),   614,  204 },
+			{ UINT64_C(0x98165AF37B2153DF),   641,  212 },
+			{ UINT64_C(0xE2A0B5DC971F303A),   667,  220 },
+			{ UINT64_C(0xA8D9D1535CE3B396),   694,  228 },
+			{ UINT64_C(0xFB9B7CD9A4A7443C),   720,  236 },
+			{ UINT64_C(0xBB764C4CA7A44410),   747,  244 },
+			{ UINT64_C(0x8BAB8EEFB6409C1A),   774,  252 },
+			{ UINT64_C(0xD01FEF10A657842C),   800,  260 },
+			{ UINT64_C(0x9B10A4E5E9913129),   827,  268 },
+			{ UINT64_C(0xE7109BFBA19C0C9D),   853,  276 },
+			{ UINT64_C(0xAC2820D9623BF429),   880,  284 },
+			{ UINT64_C(0x80444B5E7AA7CF85),   907,  292 },
+			{ UINT64_C(0xBF21E44003ACDD2D),   933,  300 },
+			{ UINT64_C(0x8E679C2F5E44FF8F),   960,  308 },
+			{ UINT64_C(0xD433179D9C8CB841),   986,  316 },
+			{ UINT64_C(0x9E19DB92B4E31BA9),  1013,  324 }
+		};
+
+		// Returns a cached power c such that kGrisuAlpha <= (e + c.e + 64) <= kGrisuGamma.
+		inline const CachedPower& GetCachedPowerForBinaryExponent(int e)
+		{
+			const int kCachedPowersMinDecExp = -300;
+			const int kCachedPowersDecStep   = 8;
+
+			// k = ceil((kGrisuAlpha - e - 1) * log10(2)), using 78913 / 2^18 ~= log10(2).
+			const int f = kGrisuAlpha - e - 1;
+			const int k = ((f * 78913) / (1 << 18)) + (f > 0 ? 1 : 0);
+
+			const int index = (-kCachedPowersMinDecExp + k + (kCachedPowersDecStep - 1)) / kCachedPowersDecStep;
+			EASTL_ASSERT((index >= 0) && (index < (int)EAArrayCount(kCachedPowers)));
+
+			return kCachedPowers[index];
+		}
+
+		// Returns the number of digits of n and sets pow10 to 10^(digits - 1). Requires n < 10^10.
+		inline int FindLargestPow10(uint32_t n, uint32_t& pow10)
+		{
+			static const uint32_t kPowers[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+			int k = 10;
+			while((k > 1) && (n < kPowers[k - 1]))
+				--k;
+
+			pow10 = kPowers[k - 1];
+			return k;
+		}
+
+		// Moves the last digit towards w while the result stays within the unsafe interval, then
+		// returns whether the digits are guaranteed to be the shortest and closest. The values
+		// are in units of the scaled exponent and unit is the error bound of the scaled values.
+		inline bool GrisuRoundWeed(char* pBuffer, int length, uint64_t distTooHighW, uint64_t unsafeInterval, uint64_t rest, uint64_t tenK, uint64_t unit)
+		{
+			const uint64_t smallDist = distTooHighW - unit;
+			const uint64_t bigDist   = distTooHighW + unit;
+
+			while((rest < smallDist) && ((unsafeInterval - rest) >= tenK) &&
+				  (((rest + tenK) < smallDist) || ((smallDist - rest) >= (rest + tenK - smallDist))))
+			{
+				pBuffer[length - 1]--;
+				rest += tenK;
+			}
+
+			// If the digits could be moved further towards w when w is at the other end of its
+			// error bound, it is unknown which candidate is closest.
+			if((rest < bigDist) && ((unsafeInterval - rest) >= tenK) &&
+			   (((rest + tenK) < bigDist) || ((bigDist - rest) > (rest + tenK - bigDist))))
+			{
+				return false;
+			}
+
+			// The digits must lie within the safe interval.
+			return ((2 * unit) <= rest) && (rest <= (unsafeInterval - (4 * unit)));
+		}
+
+		// Generates the shortest digits in the unsafe interval (low - 1, high + 1). Returns false
+		// if the digits can't be guaranteed to be the shortest and closest to w, which happens for
+		// roughly 0.5% of doubles.
+		bool GrisuDigitGen(char* pBuffer, int& length, int& decimalExponent, const DiyFp& low, const DiyFp& w, const DiyFp& high)
+		{
+			uint64_t       unit = 1;
+			const DiyFp    tooLow(low.f - unit, low.e);
+			const DiyFp    tooHigh(high.f + unit, high.e);
+			uint64_t       unsafeInterval = DiyFpSub(tooHigh, tooLow).f;
+			const DiyFp    one(uint64_t(1) << -w.e, w.e);
+
+			uint32_t integrals   = (uint32_t)(tooHigh.f >> -one.e); // Fits in 32 bits for the chosen exponent range.
+			uint64_t fractionals = tooHigh.f & (one.f - 1);
+
+			uint32_t pow10;
+			int      kappa = FindLargestPow10(integrals, pow10);
+
+			while(kappa > 0)
+			{
+				pBuffer[length++] = (char)('0' + (integrals / pow10));
+				integrals %= pow10;
+				kappa--;
+
+				const uint64_t rest = (uint64_t(integrals) << -one.e) + fractionals;
+				if(rest < unsafeInterval)
+				{
+					decimalExponent += kappa;
+					return GrisuRoundWeed(pBuffer, length, DiyFpSub(tooHigh, w).f, unsafeInterval, rest, uint64_t(pow10) << -one.e, unit);
+				}
+
+				pow10 /= 10;
+			}
+
+			for(;;)
+			{
+				fractionals    *= 10;
+				unit           *= 10;
+				unsafeInterval *= 10;
+
+				pBuffer[length++] = (char)('0' + (fractionals >> -one.e));
+				fractionals &= (one.f - 1);
+				kappa--;
+
+				if(fractionals < unsafeInterval)
+				{
+					decimalExponent += kappa;
+					return GrisuRoundWeed(pBuffer, length, DiyFpSub(tooHigh, w).f * unit, unsafeInterval, fractionals, one.f, unit);
+				}
+			}
+		}
+
+
+		// The number of significant digits needed to round-trip any T. This is computed rather than
+		// taken from numeric_limits::max_digits10, which is the mantissa size in bits on some platforms.
+		template <typename T>
+		EA_CONSTEXPR int MaxDigits10()
+		{
+			return 2 + ((eastl::numeric_limits<T>::digits * 30103) / 100000);
+		}
+
+		inline void CharConvStrto(const char* p, float& value)  { value = strtof(p, NULL); }
+		inline void CharConvStrto(const char* p, double& value) { value = strtod(p, NULL); }
+
+		inline void CharConvSnprintf(char* pBuffer, size_t nCapacity, const char* pFormat, ...)
+		{
+			va_list arguments;
+			va_start(arguments, pFormat);
+			vsnprintf(pBuffer, nCapacity, pFormat, arguments);
+			va_end(arguments);
+		}
+
+		// Finds the shortest digits for the values Grisu can't decide. The correctly rounded
+		// printf output with the fewest digits that reads back as value is the answer, and as
+		// more digits never read back worse, the digit count can be binary searched.
+		template <typename T>
+		int PrintfShortestDigits(T value, char* pBuffer, int& decimalExponent)
+		{
+			char pScientific[40];
+			int  nLow  = 1;
+			int  nHigh = MaxDigits10<T>();
+
+			while(nLow < nHigh)
+			{
+				const int nMid = (nLow + nHigh) / 2;
+				T         result;
+
+				CharConvSnprintf(pScientific, sizeof(pScientific), "%.*e", nMid - 1, (double)value);
+				CharConvStrto(pScientific, result);
+
+				if(result == value)
+					nHigh = nMid;
+				else
+					nLow = nMid + 1;
+			}
+
+			CharConvSnprintf(pScientific, sizeof(pScientific), "%.*e", nLow - 1, (double)value);
+
+			// d[.ddd]e[+-]xx
+			const char* p = pScientific;
+			int         n = 0;
+
+			for(; *p && (*p != 'e'); ++p)
+			{
+				if(*p != '.')
+					pBuffer[n++] = *p;
+			}
+
+			while((n > 1) && (pBuffer[n - 1] == '0')) // Happens for values such as 1e23.
+				n--;
+
+			decimalExponent = atoi(p + 1) - (n - 1);
+			return n;
+		}
+
+		// Writes the shortest digits of value (positive and finite) to pBuffer, which must hold 17 chars.
+		// Returns the digit count and sets decimalExponent so that value ~= digits * 10^decimalExponent.
+		template <typename T>
+		int ShortestDigits(T value, char* pBuffer, int& decimalExponent)
+		{
+			DiyFp v(0, 0), mMinus(0, 0), mPlus(0, 0);
+			ComputeBoundaries(value, v, mMinus, mPlus);
+
+			const CachedPower& cached = GetCachedPowerForBinaryExponent(mPlus.e);
+			const DiyFp        c(cached.f, cached.e);
+
+			const DiyFp w      = DiyFpMul(v, c);
+			const DiyFp wMinus = DiyFpMul(mMinus, c);
+			const DiyFp wPlus  = DiyFpMul(mPlus, c);
+
+			int length = 0;
+			decimalExponent = -cached.k;
+
+			if(GrisuDigitGen(pBuffer, length, decimalExponent, wMinus, w, wPlus))
+				return length;
+
+			return PrintfShortestDigits(value, pBuffer, decimalExponent);
+		}
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// Formatting of digit strings
+		///////////////////////////////////////////////////////////////////////
+
+		// The digits d[0, n) with exponent k have the value d * 10^k.
+
+		inline ptrdiff_t FixedLength(int n, int k)
+		{
+			const int nPoint = n + k; // The number of digits before the decimal point.
+
+			if(k >= 0)
+				return n + k;
+			if(nPoint > 0)
+				return n + 1;
+			return 2 - nPoint + n;
+		}
+
+		inline ptrdiff_t ScientificLength(int n, int k)
+		{
+			const int e = n + k - 1;
+			return n + ((n > 1) ? 1 : 0) + 2 + (((e >= 100) || (e <= -100)) ? 3 : 2);
+		}
+
+		char* WriteFixed(char* p, const char* pDigits, int n, int k)
+		{
+			const int nPoint = n + k;
+
+			if(k >= 0)
+			{
+				memcpy(p, pDigits, (size_t)n);
+				memset(p + n, '0', (size_t)k);
+				return p + n + k;
+			}
+
+			if(nPoint > 0)
+			{
+				memcpy(p, pDigits, (size_t)nPoint);
+				p[nPoint] = '.';
+				memcpy(p + nPoint + 1, pDigits + nPoint, (size_t)(n - nPoint));
+				return p + n + 1;
+			}
+
+			p[0] = '0';
+			p[1] = '.';
+			memset(p + 2, '0', (size_t)-nPoint);
+			memcpy(p + 2 - nPoint, pDigits, (size_t)n);
+			return p + 2 - nPoint + n;
+		}
+
+		char* WriteScientific(char* p, const char* pDigits, int n, int k)
+		{
+			int e = n + k - 1;
+
+			*p++ = pDigits[0];
+			if(n > 1)
+			{
+				*p++ = '.';
+				memcpy(p, pDigits + 1, (size_t)(n - 1));
+				p += (n - 1);
+			}
+
+			*p++ = 'e';
+			*p++ = (e < 0) ? '-' : '+';
+			if(e < 0)
+				e = -e;
+
+			if(e >= 100)
+			{
+				*p++ = (char)('0' + (e / 100));
+				e %= 100;
+			}
+
+			*p++ = Internal::gCharConvDigitPairs[(e * 2)];
+			*p++ = Internal::gCharConvDigitPairs[(e * 2) + 1];
+			return p;
+		}
+
+
+		to_chars_result ToCharsPrintf(char* first, char* last, const char* pFormat, ...)
+		{
+			// Output is formatted into a local buffer, as vsnprintf needs room for a terminating
+			// null which the destination may not have. Longer output is formatted again directly
+			// into the destination when it has room for the null as well, and otherwise into a
+			// temporary allocation.
+			//
+			// vsnprintf writes the decimal point of the C locale's LC_NUMERIC category, which is
+			// replaced with '.', and writes a "0x" prefix for %a, which is removed. Output which
+			// shrinks to fit the destination after these is allowed for.
+			const ptrdiff_t nCapacity     = (last - first);
+			const char*     pPoint        = localeconv()->decimal_point;
+			const size_t    nPointLength  = strlen(pPoint);
+			const bool      bReplacePoint = (nPointLength != 0) && ((nPointLength != 1) || (*pPoint != '.'));
+			const bool      bHex          = (strchr(pFormat, 'a') != NULL);
+			const ptrdiff_t nMaxShrink    = (bHex ? 2 : 0) + (bReplacePoint ? (ptrdiff_t)nPointLength - 1 : 0);
+
+			char    buffer[512];
+			char*   pSource = buffer;
+			char*   pAllocation = NULL;
+			size_t  nAllocationSize = 0;
+			va_list arguments;
+
+			va_start(arguments, pFormat);
+			int n = vsnprintf(buffer, sizeof(buffer), pFormat, arguments);
+			va_end(arguments);
+
+			if((n < 0) || (n > (nCapacity + nMaxShrink)))
+				return { last, errc::value_too_large };
+
+			if((size_t)n >= sizeof(buffer))
+			{
+				if(n < nCapacity)
+					pSource = first;
+				else
+				{
+					nAllocationSize = (size_t)n + 1;
+					pAllocation = (char*)EASTLAlloc(*EASTLAllocatorDefault(), nAllocationSize);
+					EASTL_ASSERT(pAllocation);
+					pSource = pAllocation;
+				}
+
+				va_start(arguments, pFormat);
+				n = vsnprintf(pSource, (size_t)n + 1, pFormat, arguments);
+				va_end(arguments);
+			}
+
+			if(bReplacePoint)
+			{
+				char* pFoundPoint = strstr(pSource, pPoint);
+
+				if(pFoundPoint)
+				{
+					const size_t nTailLength = (size_t)(n - (pFoundPoint - pSource)) - nPointLength + 1; // Including the null.
+
+					*pFoundPoint = '.';
+					memmove(pFoundPoint + 1, pFoundPoint + nPointLength, nTailLength);
+					n -= (int)(nPointLength - 1);
+				}
+			}
+
+			// Hexadecimal output has no "0x" prefix, unlike %a.
+			const char* pPrefix = bHex ? strstr(pSource, "0x") : NULL;
+			const int   nLength = pPrefix ? (n - 2) : n;
+
+			if(nLength <= nCapacity)
+			{
+				if(pPrefix)
+				{
+					const ptrdiff_t nSign = (pPrefix - pSource);
+					memmove(first, pSource, (size_t)nSign);
+					memmove(first + nSign, pPrefix + 2, (size_t)(n - nSign - 2));
+				}
+				else if(pSource != first)
+					memcpy(first, pSource, (size_t)n);
+			}
+
+			if(pAllocation)
+				EASTLFree(*EASTLAllocatorDefault(), pAllocation, nAllocationSize);
+
+			if(nLength > nCapacity)
+				return { last, errc::value_too_large };
+
+			return { first + nLength, errc() };
+		}
+
+
+		// Writes inf and nan, and the sign of other values. Returns true if value was completely written.
+		template <typename T>
+		bool ToCharsSpecial(char*& first, char* last, T& value, to_chars_result& result)
+		{
+			if(signbit(value))
+			{
+				if(first == last)
+				{
+					result = { last, errc::value_too_large };
+					return true;
+				}
+				*first++ = '-';
+				value = -value;
+			}
+
+			const char* pSpecial = (value != value) ? "nan" : (value == eastl::numeric_limits<T>::infinity()) ? "inf" : NULL;
+
+			if(pSpecial)
+			{
+				if((last - first) < 3)
+					result = { last, errc::value_too_large };
+				else
+				{
+					memcpy(first, pSpecial, 3);
+					result = { first + 3, errc() };
+				}
+				return true;
+			}
+
+			return false;
+		}
+
+
+		template <typename T>
+		to_chars_result ToCharsShortest(char* first, char* last, T value, chars_format fmt)
+		{
+			to_chars_result result;
+
+			if(ToCharsSpecial(first, last, value, result))
+				return result;
+
+			if(fmt == chars_format::hex)
+				return ToCharsPrintf(first, last, "%a", (double)value);
+
+			char pDigits[20];
+			int  n, k;
+
+			if(value == 0)
+			{
+				pDigits[0] = '0';
+				n = 1;
+				k = 0;
+			}
+			else
+				n = ShortestDigits(value, pDigits, k);
+
+			const ptrdiff_t nFixed      = FixedLength(n, k);
+			const ptrdiff_t nScientific = ScientificLength(n, k);
+			const int       nExponent   = n + k - 1;
+
+			bool bFixed;
+			if(fmt == chars_format::fixed)
+				bFixed = true;
+			else if(fmt == chars_format::scientific)
+				bFixed = false;
+			else if(fmt == chars_format::general)
+				bFixed = (nExponent >= -4) && (nExponent < 6); // As %g with its default precision, like the standard library.
+			else
+				bFixed = (nFixed <= nScientific);
+
+			if((last - first) < (bFixed ? nFixed : nScientific))
+				return { last, errc::value_too_large };
+
+			// Like the standard library, integers too large for the shortest digits are written exactly
+			// rather than padded with zeros. The length is the same either way.
+			if(bFixed && (k > 0))
+				return ToCharsPrintf(first, last, "%.0f", (double)value);
+
+			return { bFixed ? WriteFixed(first, pDigits, n, k) : WriteScientific(first, pDigits, n, k), errc() };
+		}
+
+
+		// The format for printf, with "%.*" already written to pFormat.
+		inline void AppendPrintfConversion(char* pFormat, chars_format fmt, bool bLongDouble)
+		{
+			if(bLongDouble)
+				*pFormat++ = 'L';
+
+			switch(fmt)
+			{
+				case chars_format::scientific: *pFormat++ = 'e'; break;
+				case chars_format::fixed:      *pFormat++ = 'f'; break;
+				case chars_format::hex:        *pFormat++ = 'a'; break;
+				default:                       *pFormat++ = 'g'; break;
+			}
+
+			*pFormat = 0;
+		}
+
+
+		template <typename T>
+		to_chars_result ToCharsPrecision(char* first, char* last, T value, chars_format fmt, int precision)
+		{
+			to_chars_result result;
+
+			if(ToCharsSpecial(first, last, value, result))
+				return result;
+
+			char pFormat[8] = { '%', '.', '*' };
+			AppendPrintfConversion(pFormat + 3, fmt, false);
+
+			return ToCharsPrintf(first, last, pFormat, (precision < 0) ? 6 : precision, (double)value);
+		}
+
+
+		// long double is only handled separately when it has more precision than double.
+		const bool kLongDoubleIsDouble = (eastl::numeric_limits<long double>::digits == eastl::numeric_limits<double>::digits);
+
+		to_chars_result ToCharsLongDouble(char* first, char* last, long double value, chars_format fmt, int precision, bool bShortest)
+		{
+			to_chars_result result;
+
+			if(ToCharsSpecial(first, last, value, result))
+				return result;
+
+			if(bShortest)
+			{
+				// Values which are exactly representable as a double get the shortest double representation.
+				if((long double)(double)value == value)
+					return ToCharsShortest(first, last, (double)value, fmt);
+
+				const int kDigits = MaxDigits10<long double>();
+
+				if(fmt == chars_format::fixed)
+				{
+					// Find the decimal exponent, so that the fixed output has kDigits significant digits.
+					char buffer[48];
+					result = ToCharsPrintf(buffer, buffer + sizeof(buffer), "%.0Le", value);
+					int nExponent = atoi(strchr(buffer, 'e') + 1);
+					precision = (nExponent < (kDigits - 1)) ? (kDigits - 1 - nExponent) : 0;
+				}
+				else if(fmt == chars_format::scientific)
+					precision = kDigits - 1;
+				else if(fmt != chars_format::hex)
+				{
+					precision = kDigits;
+					fmt = chars_format::general;
+				}
+				else
+					return ToCharsPrintf(first, last, "%La", value);
+			}
+
+			char pFormat[8] = { '%', '.', '*' };
+			AppendPrintfConversion(pFormat + 3, fmt, true);
+
+			return ToCharsPrintf(first, last, pFormat, (precision < 0) ? 6 : precision, value);
+		}
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// from_chars
+		///////////////////////////////////////////////////////////////////////
+
+		template <typename T> struct FromCharsFloatTraits;
+
+		template <> struct FromCharsFloatTraits<float>
+		{
+			static const uint64_t kMaxExactMantissa = uint64_t(1) << 24;
+			static const int      kMaxExactPow10    = 10;
+			static float Strto(const char* p) { return strtof(p, NULL); }
+		};
+
+		template <> struct FromCharsFloatTraits<double>
+		{
+			static const uint64_t kMaxExactMantissa = uint64_t(1) << 53;
+			static const int      kMaxExactPow10    = 22;
+			static double Strto(const char* p) { return strtod(p, NULL); }
+		};
+
+		template <> struct FromCharsFloatTraits<long double>
+		{
+			// The fast path is only used when long double is double, as an exactly rounded double
+			// isn't an exactly rounded long double.
+			static const uint64_t kMaxExactMantissa = kLongDoubleIsDouble ? (uint64_t(1) << 53) : 0;
+			static const int      kMaxExactPow10    = kLongDoubleIsDouble ? 22 : -1;
+			static long double Strto(const char* p) { return strtold(p, NULL); }
+		};
+
+		const double kExactPowersOf10[] =
+		{
+			1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		// More significant digits than this are replaced with a single sticky digit that records
+		// whether any of them were non-zero. 800 digits exceeds the 767 that can be significant
+		// when rounding a decimal to a double.
+		const int kMaxSignificantDigits = 800;
+
+		inline bool CharConvMatchesI(const char* p, const char* last, const char* pLower)
+		{
+			for(; *pLower; ++p, ++pLower)
+			{
+				if((p == last) || ((*p | 0x20) != *pLower))
+					return false;
+			}
+			return true;
+		}
+
+		inline bool CharConvIsHexDigit(char c)
+		{
+			return ((c >= '0') && (c <= '9')) || (((c | 0x20) >= 'a') && ((c | 0x20) <= 'f'));
+		}
+
+
+		template <typename T>
+		from_chars_result FromCharsFloat(const char* first, const char* last, T& value, chars_format fmt)
+		{
+			typedef FromCharsFloatTraits<T> traits;
+
+			const char* p         = first;
+			const bool  bNegative = (p != last) && (*p == '-');
+
+			if(bNegative)
+				++p;
+
+			// inf, infinity, nan and nan(chars)
+			if((p != last) && (((*p | 0x20) == 'i') || ((*p | 0x20) == 'n')))
+			{
+				if(CharConvMatchesI(p, last, "inf"))
+				{
+					p += CharConvMatchesI(p, last, "infinity") ? 8 : 3;
+					value = bNegative ? -eastl::numeric_limits<T>::infinity() : eastl::numeric_limits<T>::infinity();
+					return { p, errc() };
+				}
+
+				if(CharConvMatchesI(p, last, "nan"))
+				{
+					p += 3;
+
+					if((p != last) && (*p == '('))
+					{
+						const char* pSeq = p + 1;
+						while((pSeq != last) && ((*pSeq == '_') || ((*pSeq | 0x20) >= 'a' && (*pSeq | 0x20) <= 'z') || ((*pSeq >= '0') && (*pSeq <= '9'))))
+							++pSeq;
+						if((pSeq != last) && (*pSeq == ')'))
+							p = pSeq + 1;
+					}
+
+					value = bNegative ? -eastl::numeric_limits<T>::quiet_NaN() : eastl::numeric_limits<T>::quiet_NaN();
+					return { p, errc() };
+				}
+
+				return { first, errc::invalid_argument };
+			}
+
+			// The significant digits are collected into pBuffer, as "0x" digits "p" exponent
+			// for hex and digits "e" exponent otherwise, ready for strtod. The first 19 decimal
+			// digits are also accumulated into nMantissa for the fast path.
+			const bool  bHex        = (fmt == chars_format::hex);
+			const int   kDigitScale = bHex ? 4 : 1; // The exponent change for each digit moved past the point.
+			char        pBuffer[kMaxSignificantDigits + 32];
+			char*       pOut        = pBuffer;
+			int         nDigits     = 0;     // The number of significant digits written to pBuffer.
+			int         nScale      = 0;     // The value is (pBuffer digits) * base^nScale before the exponent.
+			bool        bSticky     = false; // Whether any dropped digit was non-zero.
+			bool        bAnyDigits  = false;
+			bool        bFraction   = false;
+			uint64_t    nMantissa   = 0;
+
+			if(bHex)
+			{
+				*pOut++ = '0';
+				*pOut++ = 'x';
+			}
+
+			for(; p != last; ++p)
+			{
+				const char c = *p;
+
+				if((c == '.') && !bFraction)
+				{
+					bFraction = true;
+					continue;
+				}
+
+				if(bHex ? !CharConvIsHexDigit(c) : ((c < '0') || (c > '9')))
+					break;
+
+				bAnyDigits = true;
+
+				if((nDigits == 0) && (c == '0')) // Leading zero.
+				{
+					if(bFraction)
+						nScale -= kDigitScale;
+				}
+				else if(nDigits < kMaxSignificantDigits)
+				{
+					*pOut++ = c;
+					if(nDigits < 19)
+						nMantissa = (nMantissa * 10) + (uint64_t)(c - '0');
+					nDigits++;
+					if(bFraction)
+						nScale -= kDigitScale;
+				}
+				else
+				{
+					bSticky = bSticky || (c != '0');
+					if(!bFraction)
+						nScale += kDigitScale;
+				}
+			}
+
+			if(!bAnyDigits)
+				return { first, errc::invalid_argument };
+
+			// Exponent, which is only consumed if digits follow the 'e' or 'p' and the optional sign.
+			int nExponent = 0;
+
+			if((fmt != chars_format::fixed) && (p != last) && ((*p | 0x20) == (bHex ? 'p' : 'e')))
+			{
+				const char* pExp       = p + 1;
+				const bool  bExpNegative = (pExp != last) && (*pExp == '-');
+
+				if((pExp != last) && ((*pExp == '-') || (*pExp == '+')))
+					++pExp;
+
+				if((pExp != last) && (*pExp >= '0') && (*pExp <= '9'))
+				{
+					for(; (pExp != last) && (*pExp >= '0') && (*pExp <= '9'); ++pExp)
+					{
+						if(nExponent < 100000) // Larger exponents can only overflow or underflow.
+							nExponent = (nExponent * 10) + (*pExp - '0');
+					}
+
+					if(bExpNegative)
+						nExponent = -nExponent;
+					p = pExp;
+				}
+				else if(fmt == chars_format::scientific)
+					return { first, errc::invalid_argument };
+			}
+			else if(fmt == chars_format::scientific)
+				return { first, errc::invalid_argument };
+
+			if(nDigits == 0) // All zeros.
+			{
+				value = bNegative ? -T(0) : T(0);
+				return { p, errc() };
+			}
+
+			T result;
+
+			const int nExponent10 = nScale + nExponent;
+
+			if(!bHex && !bSticky && (nDigits <= 19) && (nMantissa <= traits::kMaxExactMantissa) &&
+			   (nExponent10 >= -traits::kMaxExactPow10) && (nExponent10 <= traits::kMaxExactPow10))
+			{
+				// Both the mantissa and the power of ten are exact, so a single rounding gives the correct result.
+				if(nExponent10 >= 0)
+					result = (T)nMantissa * (T)kExactPowersOf10[nExponent10];
+				else
+					result = (T)nMantissa / (T)kExactPowersOf10[-nExponent10];
+			}
+			else
+			{
+				if(bSticky)
+				{
+					*pOut++ = '1';
+					nScale -= kDigitScale;
+				}
+
+				*pOut++ = bHex ? 'p' : 'e';
+
+				to_chars_result expResult = to_chars(pOut, pBuffer + sizeof(pBuffer) - 1, nScale + nExponent);
+				*expResult.ptr = 0;
+
+				result = traits::Strto(pBuffer);
+
+				if((result == 0) || (result == eastl::numeric_limits<T>::infinity()))
+					return { p, errc::result_out_of_range };
+			}
+
+			value = bNegative ? -result : result;
+			return { p, errc() };
+		}
+
+	} // namespace
+
+
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, float value)
+		{ return ToCharsShortest(first, last, value, chars_format(0)); }
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, double value)
+		{ return ToCharsShortest(first, last, value, chars_format(0)); }
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, long double value)
+	{
+		if(kLongDoubleIsDouble)
+			return ToCharsShortest(first, last, (double)value, chars_format(0));
+		return ToCharsLongDouble(first, last, value, chars_format(0), 0, true);
+	}
+
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, float value, chars_format fmt)
+		{ return ToCharsShortest(first, last, value, fmt); }
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, double value, chars_format fmt)
+		{ return ToCharsShortest(first, last, value, fmt); }
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, long double value, chars_format fmt)
+	{
+		if(kLongDoubleIsDouble)
+			return ToCharsShortest(first, last, (double)value, fmt);
+		return ToCharsLongDouble(first, last, value, fmt, 0, true);
+	}
+
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, float value, chars_format fmt, int precision)
+		{ return ToCharsPrecision(first, last, value, fmt, precision); }
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, double value, chars_format fmt, int precision)
+		{ return ToCharsPrecision(first, last, value, fmt, precision); }
+
+	EASTL_API to_chars_result to_chars(char* first, char* last, long double value, chars_format fmt, int precision)
+		{ return ToCharsLongDouble(first, last, value, fmt, precision, false); }
+
+
+	EASTL_API from_chars_result from_chars(const char* first, const char* last, float& value, chars_format fmt)
+		{ return FromCharsFloat(first, last, value, fmt); }
+
+	EASTL_API from_chars_result from_chars(const char* first, const char* last, double& value, chars_format fmt)
+		{ return FromCharsFloat(first, last, value, fmt); }
+
+	EASTL_API from_chars_result from_chars(const char* first, const char* last, long double& value, chars_format fmt)
+		{ return FromCharsFloat(first, last, value, fmt); }
+
+} // namespace eastl
@@ -4,6 +4,7 @@
 
 
 #include <EASTL/internal/hashtable.h>
+#include <EASTL/internal/flat_hashtable.h>
 #include <EASTL/utility.h>
 #include <math.h>  // Not all compilers support <cmath> and std::ceilf(), which we need below.
 #include <stddef.h>
@@ -25,6 +26,24 @@ namespace eastl
 
 
 
+	namespace Internal
+	{
+		/// gFlatHashEmptyGroup
+		///
+		/// The shared control bytes of an empty flat_hashtable. A lone sentinel
+		/// followed by enough empty bytes that a full group can be read from it.
+		///
+		EASTL_API const flat_hash_ctrl_t gFlatHashEmptyGroup[16] =
+		{
+			kFlatHashSentinel, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+			kFlatHashEmpty,    kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+			kFlatHashEmpty,    kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+			kFlatHashEmpty,    kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty
+		};
+	}
+
+
+
 	/// gPrimeNumberArray
 	///
 	/// This is an array of prime numbers. This is the same set of prime
@@ -172,6 +191,132 @@ namespace eastl
 	}
 
 
+
+	/// kPower2BucketCountMin / kPower2BucketCountMax
+	///
+	/// The range of bucket counts used by power2_rehash_policy. A bucket count
+	/// of 1 is reserved for the shared empty bucket array.
+	///
+	const uint32_t kPower2BucketCountMin = 2u;
+	const uint32_t kPower2BucketCountMax = 0x80000000u;
+
+
+	/// Power2Ceil
+	/// Return the smallest power of two in [kPower2BucketCountMin, kPower2BucketCountMax] which is >= n.
+	///
+	static uint32_t Power2Ceil(uint32_t n)
+	{
+		if(n <= kPower2BucketCountMin)
+			return kPower2BucketCountMin;
+		if(n >= kPower2BucketCountMax)
+			return kPower2BucketCountMax;
+
+		n--;
+		n |= n >> 1;
+		n |= n >> 2;
+		n |= n >> 4;
+		n |= n >> 8;
+		n |= n >> 16;
+		return n + 1;
+	}
+
+
+	/// Power2Floor
+	/// Return the largest power of two in [kPower2BucketCountMin, kPower2BucketCountMax] which is <= n.
+	///
+	static uint32_t Power2Floor(uint32_t n)
+	{
+		if(n <= kPower2BucketCountMin)
+			return kPower2BucketCountMin;
+
+		const uint32_t nCeil = Power2Ceil(n);
+		return (nCeil == n) ? n : (nCeil >> 1);
+	}
+
+
+	/// GetPrevBucketCountOnly
+	/// Return a bucket count no greater than nBucketCountHint.
+	///
+	uint32_t power2_rehash_policy::GetPrevBucketCountOnly(uint32_t nBucketCountHint)
+	{
+		return Power2Floor(nBucketCountHint);
+	}
+
+
+	/// GetPrevBucketCount
+	/// Return a bucket count no greater than nBucketCountHint.
+	/// This function has a side effect of updating mnNextResize.
+	///
+	uint32_t power2_rehash_policy::GetPrevBucketCount(uint32_t nBucketCountHint) const
+	{
+		const uint32_t nBucketCount = Power2Floor(nBucketCountHint);
+
+		mnNextResize = (uint32_t)ceilf(nBucketCount * mfMaxLoadFactor);
+		return nBucketCount;
+	}
+
+
+	/// GetNextBucketCount
+	/// Return a power of two no smaller than nBucketCountHint.
+	/// This function has a side effect of updating mnNextResize.
+	///
+	uint32_t power2_rehash_policy::GetNextBucketCount(uint32_t nBucketCountHint) const
+	{
+		const uint32_t nBucketCount = Power2Ceil(nBucketCountHint);
+
+		mnNextResize = (uint32_t)ceilf(nBucketCount * mfMaxLoadFactor);
+		return nBucketCount;
+	}
+
+
+	/// GetBucketCount
+	/// Return the smallest power of two p such that alpha p >= nElementCount, where alpha
+	/// is the load factor. This function has a side effect of updating mnNextResize.
+	///
+	uint32_t power2_rehash_policy::GetBucketCount(uint32_t nElementCount) const
+	{
+		const uint32_t nMinBucketCount = (uint32_t)(nElementCount / mfMaxLoadFactor);
+		const uint32_t nBucketCount    = Power2Ceil(nMinBucketCount);
+
+		mnNextResize = (uint32_t)ceilf(nBucketCount * mfMaxLoadFactor);
+		return nBucketCount;
+	}
+
+
+	/// GetRehashRequired
+	/// Finds the smallest power of two p such that alpha p > nElementCount + nElementAdd.
+	/// If p > nBucketCount, return pair<bool, uint32_t>(true, p); otherwise return
+	/// pair<bool, uint32_t>(false, 0). This function has a side effect of updating mnNextResize.
+	///
+	eastl::pair<bool, uint32_t>
+	power2_rehash_policy::GetRehashRequired(uint32_t nBucketCount, uint32_t nElementCount, uint32_t nElementAdd) const
+	{
+		if((nElementCount + nElementAdd) > mnNextResize) // It is significant that we specify > next resize and not >= next resize.
+		{
+			if(nBucketCount == 1) // We force rehashing to occur if the bucket count is < 2.
+				nBucketCount = 0;
+
+			float fMinBucketCount = (nElementCount + nElementAdd) / mfMaxLoadFactor;
+
+			if(fMinBucketCount > (float)nBucketCount)
+			{
+				fMinBucketCount                = eastl::max_alt(fMinBucketCount, mfGrowthFactor * nBucketCount);
+				const uint32_t nNewBucketCount = (fMinBucketCount >= (float)kPower2BucketCountMax) ? kPower2BucketCountMax : Power2Ceil((uint32_t)fMinBucketCount);
+				mnNextResize                   = (uint32_t)ceilf(nNewBucketCount * mfMaxLoadFactor);
+
+				return eastl::pair<bool, uint32_t>(true, nNewBucketCount);
+			}
+			else
+			{
+				mnNextResize = (uint32_t)ceilf(nBucketCount * mfMaxLoadFactor);
+				return eastl::pair<bool, uint32_t>(false, (uint32_t)0);
+			}
+		}
+
+		return eastl::pair<bool, uint32_t>(false, (uint32_t)0);
+	}
+
+
 } // namespace eastl
 
 EA_RESTORE_VC_WARNING();
@@ -0,0 +1,533 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/memory_reclamation.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <new>
+#if EASTL_CPP11_MUTEX_ENABLED
+	#include <thread>
+#endif
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+// A thread keeps its ebr_domain records in a thread_local cache, so that a guard
+// doesn't have to find a free record every time. The cache needs a thread_local
+// object with a destructor, so that the records are given back when the thread exits.
+// Without one, every guard claims a record and gives it back.
+#if EASTL_THREAD_SUPPORT_AVAILABLE && !defined(EA_COMPILER_NO_THREAD_LOCAL)
+	#define EASTL_EBR_THREAD_CACHE_ENABLED 1
+#else
+	#define EASTL_EBR_THREAD_CACHE_ENABLED 0
+#endif
+
+
+namespace eastl
+{
+
+	namespace Internal
+	{
+		// A record holds one thread's state in one ebr_domain. Records are kept in a list
+		// which only grows while the domain lives. A record which isn't claimed keeps its
+		// retired list for the next thread which claims it.
+		struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) ebr_record
+		{
+			std::atomic<uint64_t> mnEpoch;         // The epoch at which the thread's outermost guard began, or 0 if it has no guard.
+			std::atomic<int>      mnState;         // One of RecordState.
+			uint32_t              mnNestCount;
+			retired_node*         mpRetiredHead;   // Oldest first, so in order of epoch.
+			retired_node*         mpRetiredTail;
+			size_t                mnRetiredCount;
+			ebr_record*           mpNext;
+		} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+	}
+
+
+	namespace
+	{
+		using Internal::retired_node;
+		using Internal::ebr_record;
+		using Internal::hazard_record;
+
+		enum RecordState
+		{
+			kRecordFree,       // Not used by any thread.
+			kRecordClaimed,    // Used by a thread.
+			kRecordOrphaned    // Claimed by a thread's cache when its domain was destroyed. The thread frees it.
+		};
+
+		std::atomic<uint64_t> gnNextEbrDomainId(1);
+
+
+		void Yield()
+		{
+			#if EASTL_CPP11_MUTEX_ENABLED
+				std::this_thread::yield();
+			#else
+				Internal::cpu_pause();
+			#endif
+		}
+
+
+		void FreeRetiredList(retired_node* pNode)
+		{
+			while(pNode)
+			{
+				retired_node* const pNext = pNode->mpRetiredNext;
+				pNode->mpRetiredFree(pNode);
+				pNode = pNext;
+			}
+		}
+
+
+		void DestroyEbrRecord(ebr_record* pRecord)
+		{
+			pRecord->~ebr_record();
+			EASTLFree(*EASTLAllocatorDefault(), pRecord, sizeof(ebr_record));
+		}
+
+
+		// Gives a record back to its domain, or frees it if the domain has been destroyed.
+		void ReleaseEbrRecord(ebr_record* pRecord)
+		{
+			EASTL_ASSERT(pRecord->mnNestCount == 0);
+
+			if(pRecord->mnState.exchange(kRecordFree, std::memory_order_acq_rel) == kRecordOrphaned)
+				DestroyEbrRecord(pRecord);
+		}
+
+
+		#if EASTL_EBR_THREAD_CACHE_ENABLED
+			struct ThreadEbrCache
+			{
+				struct Entry
+				{
+					const ebr_domain* mpDomain;
+					uint64_t          mnDomainId;
+					ebr_record*       mpRecord;
+				};
+
+				Entry    mEntries[EASTL_EBR_THREAD_CACHE_SIZE];
+				uint32_t mnNextVictim;
+
+			   ~ThreadEbrCache()
+				{
+					for(uint32_t i = 0; i < EASTL_EBR_THREAD_CACHE_SIZE; i++)
+					{
+						if(mEntries[i].mpRecord)
+							ReleaseEbrRecord(mEntries[i].mpRecord);
+					}
+				}
+			};
+
+			thread_local ThreadEbrCache gThreadEbrCache = {};
+		#endif
+
+	} // namespace
+
+
+
+	/////////////////////////////////////////////////////////////////
+	// ebr_domain
+	/////////////////////////////////////////////////////////////////
+
+	ebr_domain::ebr_domain()
+		: mnEpoch(1), mpRecordList(NULL), mnId(gnNextEbrDomainId.fetch_add(1, std::memory_order_relaxed))
+	{
+	}
+
+
+	ebr_domain::~ebr_domain()
+	{
+		ebr_record* pRecord = mpRecordList.load(std::memory_order_acquire);
+
+		while(pRecord)
+		{
+			ebr_record* const pNext = pRecord->mpNext;
+
+			EASTL_ASSERT(pRecord->mnNestCount == 0); // A guard of this domain still exists.
+			FreeRetiredList(pRecord->mpRetiredHead);
+			pRecord->mpRetiredHead = pRecord->mpRetiredTail = NULL;
+			pRecord->mnRetiredCount = 0;
+
+			// A record which is still in some thread's cache is left for that thread to free.
+			if(pRecord->mnState.exchange(kRecordOrphaned, std::memory_order_acq_rel) == kRecordFree)
+				DestroyEbrRecord(pRecord);
+
+			pRecord = pNext;
+		}
+	}
+
+
+	ebr_domain& ebr_domain::get_default()
+	{
+		// The default domain is never destroyed, as threads may still retire objects
+		// while the process's static objects are being destroyed.
+		alignas(ebr_domain) static unsigned char sDomainBuffer[sizeof(ebr_domain)];
+		static ebr_domain* const spDomain = new(sDomainBuffer) ebr_domain;
+		return *spDomain;
+	}
+
+
+	ebr_record* ebr_domain::DoClaimRecord()
+	{
+		for(ebr_record* pRecord = mpRecordList.load(std::memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+		{
+			int nState = kRecordFree;
+
+			if((pRecord->mnState.load(std::memory_order_relaxed) == kRecordFree) &&
+			   pRecord->mnState.compare_exchange_strong(nState, kRecordClaimed, std::memory_order_acquire))
+				return pRecord;
+		}
+
+		void* const pMemory = EASTLAllocAligned(*EASTLAllocatorDefault(), sizeof(ebr_record), EASTL_ALIGN_OF(ebr_record), 0);
+		EASTL_ASSERT(pMemory);
+
+		ebr_record* const pRecord = ::new(pMemory) ebr_record;
+		pRecord->mnEpoch.store(0, std::memory_order_relaxed);
+		pRecord->mnState.store(kRecordClaimed, std::memory_order_relaxed);
+		pRecord->mnNestCount    = 0;
+		pRecord->mpRetiredHead  = NULL;
+		pRecord->mpRetiredTail  = NULL;
+		pRecord->mnRetiredCount = 0;
+		pRecord->mpNext         = mpRecordList.load(std::memory_order_relaxed);
+
+		while(!mpRecordList.compare_exchange_weak(pRecord->mpNext, pRecord, std::memory_order_release, std::memory_order_relaxed))
+			{ }
+
+		return pRecord;
+	}
+
+
+	ebr_record* ebr_domain::DoGetRecord(bool& bOwnsRecord)
+	{
+		#if EASTL_EBR_THREAD_CACHE_ENABLED
+			ThreadEbrCache& cache = gThreadEbrCache;
+
+			for(uint32_t i = 0; i < EASTL_EBR_THREAD_CACHE_SIZE; i++)
+			{
+				ThreadEbrCache::Entry& entry = cache.mEntries[i];
+
+				if((entry.mpDomain == this) && (entry.mnDomainId == mnId) && entry.mpRecord)
+				{
+					bOwnsRecord = false;
+					return entry.mpRecord;
+				}
+			}
+
+			// Replace an entry which isn't inside a guard. If every entry is, this guard
+			// uses a record of its own.
+			for(uint32_t i = 0; i < EASTL_EBR_THREAD_CACHE_SIZE; i++)
+			{
+				ThreadEbrCache::Entry& entry = cache.mEntries[cache.mnNextVictim++ % EASTL_EBR_THREAD_CACHE_SIZE];
+
+				if(!entry.mpRecord || (entry.mpRecord->mnNestCount == 0))
+				{
+					if(entry.mpRecord)
+						ReleaseEbrRecord(entry.mpRecord);
+
+					entry.mpDomain   = this;
+					entry.mnDomainId = mnId;
+					entry.mpRecord   = DoClaimRecord();
+
+					bOwnsRecord = false;
+					return entry.mpRecord;
+				}
+			}
+		#endif
+
+		bOwnsRecord = true;
+		return DoClaimRecord();
+	}
+
+
+	ebr_domain::guard::guard(ebr_domain& domain)
+		: mpDomain(&domain), mpRecord(domain.DoGetRecord(mbOwnsRecord))
+	{
+		if(mpRecord->mnNestCount++ == 0)
+		{
+			// The fence orders the store of our epoch before our loads of the shared
+			// structure, and pairs with the fence in DoTryAdvance.
+			mpRecord->mnEpoch.store(domain.mnEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+	}
+
+
+	ebr_domain::guard::~guard()
+	{
+		if(--mpRecord->mnNestCount == 0)
+			mpRecord->mnEpoch.store(0, std::memory_order_release);
+
+		if(mbOwnsRecord)
+			ReleaseEbrRecord(mpRecord);
+	}
+
+
+	bool ebr_domain::DoTryAdvance()
+	{
+		uint64_t nEpoch = mnEpoch.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		for(ebr_record* pRecord = mpRecordList.load(std::memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+		{
+			const uint64_t nRecordEpoch = pRecord->mnEpoch.load(std::memory_order_acquire);
+
+			if(nRecordEpoch && (nRecordEpoch != nEpoch))
+				return false;
+		}
+
+		// Failure means another thread advanced it, which is as good.
+		mnEpoch.compare_exchange_strong(nEpoch, nEpoch + 1, std::memory_order_acq_rel, std::memory_order_relaxed);
+		return true;
+	}
+
+
+	size_t ebr_domain::DoCollect(ebr_record* pRecord)
+	{
+		const uint64_t nEpoch = mnEpoch.load(std::memory_order_acquire);
+		size_t         nFreed = 0;
+
+		// Freeing an object may retire others to this record, which go on the tail.
+		while(pRecord->mpRetiredHead && ((pRecord->mpRetiredHead->mnRetiredEpoch + 2) <= nEpoch))
+		{
+			retired_node* const pNode = pRecord->mpRetiredHead;
+
+			pRecord->mpRetiredHead = pNode->mpRetiredNext;
+			if(!pRecord->mpRetiredHead)
+				pRecord->mpRetiredTail = NULL;
+			pRecord->mnRetiredCount--;
+
+			pNode->mpRetiredFree(pNode);
+			nFreed++;
+		}
+
+		return nFreed;
+	}
+
+
+	void ebr_domain::DoRetire(retired_node* pNode)
+	{
+		bool              bOwnsRecord;
+		ebr_record* const pRecord = DoGetRecord(bOwnsRecord);
+
+		// The caller has already unlinked the object, so any guard which can still reach
+		// it began at this epoch or earlier.
+		pNode->mnRetiredEpoch = mnEpoch.load(std::memory_order_seq_cst);
+		pNode->mpRetiredNext  = NULL;
+
+		if(pRecord->mpRetiredTail)
+			pRecord->mpRetiredTail->mpRetiredNext = pNode;
+		else
+			pRecord->mpRetiredHead = pNode;
+		pRecord->mpRetiredTail = pNode;
+
+		if(++pRecord->mnRetiredCount >= EASTL_EBR_RETIRE_THRESHOLD)
+		{
+			DoTryAdvance();
+			DoCollect(pRecord);
+		}
+
+		if(bOwnsRecord)
+			ReleaseEbrRecord(pRecord);
+	}
+
+
+	size_t ebr_domain::collect()
+	{
+		bool              bOwnsRecord;
+		ebr_record* const pRecord = DoGetRecord(bOwnsRecord);
+
+		DoTryAdvance();
+		const size_t nFreed = DoCollect(pRecord);
+
+		if(bOwnsRecord)
+			ReleaseEbrRecord(pRecord);
+
+		return nFreed;
+	}
+
+
+	void ebr_domain::synchronize()
+	{
+		bool              bOwnsRecord;
+		ebr_record* const pOwnRecord = DoGetRecord(bOwnsRecord);
+
+		EASTL_ASSERT(pOwnRecord->mnNestCount == 0); // synchronize would wait for its own guard.
+
+		const uint64_t nTarget = mnEpoch.load(std::memory_order_seq_cst) + 2;
+
+		for(uint32_t nSpinCount = 1; mnEpoch.load(std::memory_order_acquire) < nTarget; nSpinCount++)
+		{
+			if(!DoTryAdvance() && ((nSpinCount % 64) == 0))
+				Yield();
+		}
+
+		DoCollect(pOwnRecord);
+
+		// Also free what exited threads left behind.
+		for(ebr_record* pRecord = mpRecordList.load(std::memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+		{
+			int nState = kRecordFree;
+
+			if(pRecord->mpRetiredHead && pRecord->mnState.compare_exchange_strong(nState, kRecordClaimed, std::memory_order_acquire))
+			{
+				DoCollect(pRecord);
+				ReleaseEbrRecord(pRecord);
+			}
+		}
+
+		if(bOwnsRecord)
+			ReleaseEbrRecord(pOwnRecord);
+	}
+
+
+
+	/////////////////////////////////////////////////////////////////
+	// hazard_domain
+	/////////////////////////////////////////////////////////////////
+
+	hazard_domain::hazard_domain()
+		: mpRecordList(NULL), mpRetiredList(NULL), mnRetiredCount(0), mnRecordCount(0)
+	{
+	}
+
+
+	hazard_domain::~hazard_domain()
+	{
+		FreeRetiredList(mpRetiredList.exchange(NULL, std::memory_order_acquire));
+
+		for(hazard_record* pRecord = mpRecordList.load(std::memory_order_acquire); pRecord; )
+		{
+			hazard_record* const pNext = pRecord->mpNext;
+
+			EASTL_ASSERT(!pRecord->mbClaimed.load(std::memory_order_relaxed)); // A hazard_pointer of this domain still exists.
+			pRecord->~hazard_record();
+			EASTLFree(*EASTLAllocatorDefault(), pRecord, sizeof(hazard_record));
+			pRecord = pNext;
+		}
+	}
+
+
+	hazard_domain& hazard_domain::get_default()
+	{
+		// The default domain is never destroyed, as threads may still retire objects
+		// while the process's static objects are being destroyed.
+		alignas(hazard_domain) static unsigned char sDomainBuffer[sizeof(hazard_domain)];
+		static hazard_domain* const spDomain = new(sDomainBuffer) hazard_domain;
+		return *spDomain;
+	}
+
+
+	hazard_record* hazard_domain::DoClaimRecord()
+	{
+		for(hazard_record* pRecord = mpRecordList.load(std::memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+		{
+			if(!pRecord->mbClaimed.load(std::memory_order_relaxed) && !pRecord->mbClaimed.exchange(true, std::memory_order_acquire))
+				return pRecord;
+		}
+
+		// Records are only freed with the domain, as a scan may be reading one at any time.
+		void* const pMemory = EASTLAllocAligned(*EASTLAllocatorDefault(), sizeof(hazard_record), EASTL_ALIGN_OF(hazard_record), 0);
+		EASTL_ASSERT(pMemory);
+
+		hazard_record* const pRecord = ::new(pMemory) hazard_record;
+		pRecord->mpHazard.store(NULL, std::memory_order_relaxed);
+		pRecord->mbClaimed.store(true, std::memory_order_relaxed);
+		pRecord->mpNext = mpRecordList.load(std::memory_order_relaxed);
+
+		while(!mpRecordList.compare_exchange_weak(pRecord->mpNext, pRecord, std::memory_order_release, std::memory_order_relaxed))
+			{ }
+
+		mnRecordCount.fetch_add(1, std::memory_order_relaxed);
+		return pRecord;
+	}
+
+
+	void hazard_domain::DoRetire(retired_node* pNode)
+	{
+		pNode->mpRetiredNext = mpRetiredList.load(std::memory_order_relaxed);
+
+		while(!mpRetiredList.compare_exchange_weak(pNode->mpRetiredNext, pNode, std::memory_order_release, std::memory_order_relaxed))
+			{ }
+
+		const size_t nRetiredCount = mnRetiredCount.fetch_add(1, std::memory_order_relaxed) + 1;
+		const size_t nThreshold    = eastl::max_alt((size_t)EASTL_HAZARD_POINTER_RETIRE_THRESHOLD, 2 * mnRecordCount.load(std::memory_order_relaxed));
+
+		if(nRetiredCount >= nThreshold)
+			DoScan();
+	}
+
+
+	size_t hazard_domain::DoScan()
+	{
+		// Take the whole list, so that concurrent scans work on different objects.
+		retired_node* pList = mpRetiredList.exchange(NULL, std::memory_order_acquire);
+
+		if(!pList)
+			return 0;
+
+		// Pairs with the fence implied by hazard_pointer::try_protect's seq_cst store and
+		// load: either the reader sees that the object was unlinked, or we see its hazard.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		eastl::vector<const void*> hazards(EASTL_NAME_VAL("EASTL hazard_domain"));
+		hazards.reserve(mnRecordCount.load(std::memory_order_relaxed));
+
+		for(hazard_record* pRecord = mpRecordList.load(std::memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+		{
+			const void* const p = pRecord->mpHazard.load(std::memory_order_seq_cst);
+
+			if(p)
+				hazards.push_back(p);
+		}
+
+		eastl::sort(hazards.begin(), hazards.end());
+
+		retired_node* pKeptHead = NULL;
+		retired_node* pKeptTail = NULL;
+		size_t        nFreed    = 0;
+
+		while(pList)
+		{
+			retired_node* const pNode = pList;
+			pList = pNode->mpRetiredNext;
+
+			if(eastl::binary_search(hazards.begin(), hazards.end(), pNode->mpRetiredObject))
+			{
+				pNode->mpRetiredNext = pKeptHead;
+				pKeptHead = pNode;
+				if(!pKeptTail)
+					pKeptTail = pNode;
+			}
+			else
+			{
+				mnRetiredCount.fetch_sub(1, std::memory_order_relaxed);
+				pNode->mpRetiredFree(pNode); // This may retire more objects, which is fine as we no longer touch the shared list.
+				nFreed++;
+			}
+		}
+
+		if(pKeptHead)
+		{
+			pKeptTail->mpRetiredNext = mpRetiredList.load(std::memory_order_relaxed);
+
+			while(!mpRetiredList.compare_exchange_weak(pKeptTail->mpRetiredNext, pKeptHead, std::memory_order_release, std::memory_order_relaxed))
+				{ }
+		}
+
+		return nFreed;
+	}
+
+
+	size_t hazard_domain::collect()
+	{
+		return DoScan();
+	}
+
+} // namespace eastl
@@ -37,6 +37,17 @@ namespace eastl
 	rbtree_node_base* RBTreeRotateRight(rbtree_node_base* pNode, rbtree_node_base* pNodeRoot);
 
 
+	#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+		/// RBTreeSubtreeSize
+		/// Returns the number of nodes in the subtree rooted at pNode, which may be NULL.
+		///
+		static inline size_t RBTreeSubtreeSize(const rbtree_node_base* pNode)
+		{
+			return pNode ? pNode->mnSubtreeSize : 0;
+		}
+	#endif
+
+
 
 	/// RBTreeIncrement
 	/// Returns the next item in a sorted red-black tree.
@@ -147,6 +158,12 @@ namespace eastl
 		pNodeTemp->mpNodeLeft = pNode;
 		pNode->mpNodeParent = pNodeTemp;
 
+		#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+			// pNodeTemp takes over pNode's subtree; pNode loses pNodeTemp and its right subtree.
+			pNodeTemp->mnSubtreeSize = pNode->mnSubtreeSize;
+			pNode->mnSubtreeSize     = RBTreeSubtreeSize(pNode->mpNodeLeft) + RBTreeSubtreeSize(pNode->mpNodeRight) + 1;
+		#endif
+
 		return pNodeRoot;
 	}
 
@@ -177,6 +194,11 @@ namespace eastl
 		pNodeTemp->mpNodeRight = pNode;
 		pNode->mpNodeParent = pNodeTemp;
 
+		#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+			pNodeTemp->mnSubtreeSize = pNode->mnSubtreeSize;
+			pNode->mnSubtreeSize     = RBTreeSubtreeSize(pNode->mpNodeLeft) + RBTreeSubtreeSize(pNode->mpNodeRight) + 1;
+		#endif
+
 		return pNodeRoot;
 	}
 
@@ -200,6 +222,14 @@ namespace eastl
 		pNode->mpNodeLeft   = NULL;
 		pNode->mColor       = kRBTreeColorRed;
 
+		#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+			// Count the new node in each of its ancestors before any rotations happen.
+			pNode->mnSubtreeSize = 1;
+
+			for(rbtree_node_base* pNodeAncestor = pNodeParent; pNodeAncestor != pNodeAnchor; pNodeAncestor = pNodeAncestor->mpNodeParent)
+				++pNodeAncestor->mnSubtreeSize;
+		#endif
+
 		// Insert the node.
 		if(insertionSide == kRBTreeSideLeft)
 		{
@@ -315,6 +345,14 @@ namespace eastl
 			pNodeChild = pNodeSuccessor->mpNodeRight;
 		}
 
+		#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+			// pNodeSuccessor is the node that physically leaves its position in the tree (it is pNode
+			// itself unless pNode has two children), so every node above that position loses one.
+			// pNode is among them, and pNodeSuccessor inherits its count below when it takes pNode's place.
+			for(rbtree_node_base* pNodeAncestor = pNodeSuccessor->mpNodeParent; pNodeAncestor != pNodeAnchor; pNodeAncestor = pNodeAncestor->mpNodeParent)
+				--pNodeAncestor->mnSubtreeSize;
+		#endif
+
 		// Here we remove pNode from the tree and fix up the node pointers appropriately around it.
 		if(pNodeSuccessor == pNode) // If pNode was a leaf node (had both NULL children)...
 		{
@@ -393,6 +431,10 @@ namespace eastl
 
 			pNodeSuccessor->mpNodeParent = pNode->mpNodeParent;
 			eastl::swap(pNodeSuccessor->mColor, pNode->mColor);
+
+			#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+				pNodeSuccessor->mnSubtreeSize = pNode->mnSubtreeSize;
+			#endif
 		}
 
 		// Here we do tree balancing as per the conventional red-black tree algorithm.
@@ -491,6 +533,59 @@ namespace eastl
 
 
 
+	#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+		/// RBTreeSelect
+		/// Returns the node at sorted position n (zero-based), or the anchor if n is 
+		/// not less than the number of nodes in the tree. Runs in O(log n) by 
+		/// descending from the root and using the left subtree sizes to pick a side.
+		///
+		EASTL_API rbtree_node_base* RBTreeSelect(const rbtree_node_base* pNodeAnchor, size_t n)
+		{
+			const rbtree_node_base* pNode = pNodeAnchor->mpNodeParent;
+
+			if(!pNode || (n >= pNode->mnSubtreeSize))
+				return const_cast<rbtree_node_base*>(pNodeAnchor);
+
+			for(;;)
+			{
+				const size_t nLeftSize = RBTreeSubtreeSize(pNode->mpNodeLeft);
+
+				if(n < nLeftSize)
+					pNode = pNode->mpNodeLeft;
+				else if(n > nLeftSize)
+				{
+					n    -= (nLeftSize + 1);
+					pNode = pNode->mpNodeRight;
+				}
+				else
+					return const_cast<rbtree_node_base*>(pNode);
+			}
+		}
+
+
+
+		/// RBTreeRank
+		/// Returns the sorted position (zero-based) of the given non-anchor node. 
+		/// Runs in O(log n) by walking up to the root and adding in the left 
+		/// subtree of every ancestor that pNode lies to the right of.
+		///
+		EASTL_API size_t RBTreeRank(const rbtree_node_base* pNode, const rbtree_node_base* pNodeAnchor)
+		{
+			const rbtree_node_base* const pNodeRoot = pNodeAnchor->mpNodeParent;
+			size_t nRank = RBTreeSubtreeSize(pNode->mpNodeLeft);
+
+			for(; pNode != pNodeRoot; pNode = pNode->mpNodeParent)
+			{
+				if(pNode == pNode->mpNodeParent->mpNodeRight)
+					nRank += RBTreeSubtreeSize(pNode->mpNodeParent->mpNodeLeft) + 1;
+			}
+
+			return nRank;
+		}
+	#endif
+
+
+
 } // namespace eastl
 
 
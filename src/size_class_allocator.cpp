@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/size_class_allocator.h>
+#include <EASTL/internal/thread_support.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <new>
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+// Thread caches need thread_local objects with destructors, so that a thread's cached
+// nodes go back to the shared lists when it exits. Without them, every allocation goes
+// to the shared lists.
+#if EASTL_THREAD_SUPPORT_AVAILABLE && !defined(EA_COMPILER_NO_THREAD_LOCAL)
+	#define EASTL_SIZE_CLASS_THREAD_CACHE_ENABLED 1
+#else
+	#define EASTL_SIZE_CLASS_THREAD_CACHE_ENABLED 0
+#endif
+
+
+namespace eastl
+{
+
+	namespace
+	{
+		static_assert((EASTL_SIZE_CLASS_GRANULARITY & (EASTL_SIZE_CLASS_GRANULARITY - 1)) == 0, "EASTL_SIZE_CLASS_GRANULARITY must be a power of two.");
+		static_assert((EASTL_SIZE_CLASS_MAX_SIZE % EASTL_SIZE_CLASS_GRANULARITY) == 0, "EASTL_SIZE_CLASS_MAX_SIZE must be a multiple of EASTL_SIZE_CLASS_GRANULARITY.");
+		static_assert(EASTL_SIZE_CLASS_SLAB_SIZE >= EASTL_SIZE_CLASS_MAX_SIZE, "EASTL_SIZE_CLASS_SLAB_SIZE must hold at least one node of the largest class.");
+
+		const size_t kClassCount = EASTL_SIZE_CLASS_MAX_SIZE / EASTL_SIZE_CLASS_GRANULARITY;
+
+		// Nodes of a class are laid out contiguously from the start of a slab, so a node is aligned
+		// to any power of two which divides the class size, up to the alignment of the slab.
+		// Slabs are aligned to the largest power of two that a class size can be a multiple of.
+		EA_CONSTEXPR size_t SlabAlignment(size_t n = EASTL_SIZE_CLASS_GRANULARITY)
+		{
+			return ((n * 2) <= EASTL_SIZE_CLASS_MAX_SIZE) ? SlabAlignment(n * 2) : n;
+		}
+
+		inline size_t ClassIndex(size_t n)
+		{
+			return n ? ((n - 1) / EASTL_SIZE_CLASS_GRANULARITY) : 0;
+		}
+
+		inline size_t ClassSize(size_t nClass)
+		{
+			return (nClass + 1) * EASTL_SIZE_CLASS_GRANULARITY;
+		}
+
+
+		struct Link
+		{
+			Link* mpNext;
+		};
+
+
+		// The free nodes of one size class which are available to every thread.
+		struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) SharedList
+		{
+			Internal::mutex mMutex;
+			Link*           mpHead;
+		} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+
+
+		struct SharedState
+		{
+			SharedList          mLists[kClassCount];
+			std::atomic<size_t> mnSlabMemory;
+
+			SharedState() : mnSlabMemory(0)
+			{
+				for(size_t i = 0; i < kClassCount; i++)
+					mLists[i].mpHead = NULL;
+			}
+		};
+
+
+		// The shared state is never destroyed, as threads may still free nodes while
+		// the process's static objects are being destroyed. The slabs are reclaimed by
+		// the system along with the rest of the process.
+		SharedState& GetSharedState()
+		{
+			alignas(SharedState) static unsigned char sStateBuffer[sizeof(SharedState)];
+			static SharedState* const spState = new(sStateBuffer) SharedState;
+			return *spState;
+		}
+
+
+		// Carves a new slab into a chain of nodes of the given class. Returns NULL if the
+		// default allocator is out of memory.
+		Link* CarveSlab(SharedState& state, size_t nClass)
+		{
+			const size_t nNodeSize  = ClassSize(nClass);
+			const size_t nNodeCount = EASTL_SIZE_CLASS_SLAB_SIZE / nNodeSize;
+			char* const  pSlab      = (char*)allocate_memory(*EASTLAllocatorDefault(), EASTL_SIZE_CLASS_SLAB_SIZE, SlabAlignment(), 0);
+
+			if(!pSlab)
+				return NULL;
+
+			for(size_t i = 0; i < (nNodeCount - 1); i++)
+				((Link*)(pSlab + (i * nNodeSize)))->mpNext = (Link*)(pSlab + ((i + 1) * nNodeSize));
+			((Link*)(pSlab + ((nNodeCount - 1) * nNodeSize)))->mpNext = NULL;
+
+			state.mnSlabMemory.fetch_add(EASTL_SIZE_CLASS_SLAB_SIZE, std::memory_order_relaxed);
+			return (Link*)pSlab;
+		}
+
+
+		// Removes up to nCount nodes from the shared list of a class, carving a new slab if
+		// the list is empty. Returns the chain and its length.
+		Link* TakeShared(size_t nClass, size_t nCount, size_t& nTaken)
+		{
+			SharedState& state = GetSharedState();
+			SharedList&  list  = state.mLists[nClass];
+			Internal::auto_mutex lock(list.mMutex);
+
+			if(!list.mpHead)
+				list.mpHead = CarveSlab(state, nClass);
+
+			Link* const pHead = list.mpHead;
+			Link*       pTail = pHead;
+			nTaken = 0;
+
+			if(pHead)
+			{
+				for(nTaken = 1; (nTaken < nCount) && pTail->mpNext; nTaken++)
+					pTail = pTail->mpNext;
+
+				list.mpHead   = pTail->mpNext;
+				pTail->mpNext = NULL;
+			}
+
+			return pHead;
+		}
+
+
+		// Adds a chain of nodes, from pHead to pTail, to the shared list of a class.
+		void GiveShared(size_t nClass, Link* pHead, Link* pTail)
+		{
+			SharedList& list = GetSharedState().mLists[nClass];
+			Internal::auto_mutex lock(list.mMutex);
+
+			pTail->mpNext = list.mpHead;
+			list.mpHead   = pHead;
+		}
+
+
+		#if EASTL_SIZE_CLASS_THREAD_CACHE_ENABLED
+			// The free nodes of each size class which only the owning thread uses.
+			struct ThreadCache
+			{
+				struct List
+				{
+					Link*  mpHead;
+					size_t mnCount;
+				};
+
+				List mLists[kClassCount];
+
+				~ThreadCache()
+					{ Flush(); }
+
+				void Flush()
+				{
+					for(size_t c = 0; c < kClassCount; c++)
+					{
+						if(mLists[c].mpHead)
+						{
+							Link* pTail = mLists[c].mpHead;
+							while(pTail->mpNext)
+								pTail = pTail->mpNext;
+
+							GiveShared(c, mLists[c].mpHead, pTail);
+							mLists[c].mpHead  = NULL;
+							mLists[c].mnCount = 0;
+						}
+					}
+				}
+			};
+
+			thread_local ThreadCache gThreadCache;
+		#endif
+
+
+		void* AllocateNode(size_t nClass)
+		{
+			#if EASTL_SIZE_CLASS_THREAD_CACHE_ENABLED
+				ThreadCache::List& list = gThreadCache.mLists[nClass];
+
+				if(EASTL_UNLIKELY(!list.mpHead))
+				{
+					list.mpHead = TakeShared(nClass, EASTL_SIZE_CLASS_TRANSFER_COUNT, list.mnCount);
+
+					if(!list.mpHead)
+						return NULL;
+				}
+
+				Link* const pLink = list.mpHead;
+				list.mpHead = pLink->mpNext;
+				list.mnCount--;
+				return pLink;
+			#else
+				size_t nTaken;
+				return TakeShared(nClass, 1, nTaken);
+			#endif
+		}
+
+
+		void DeallocateNode(void* p, size_t nClass)
+		{
+			Link* const pLink = (Link*)p;
+
+			#if EASTL_SIZE_CLASS_THREAD_CACHE_ENABLED
+				ThreadCache::List& list = gThreadCache.mLists[nClass];
+
+				pLink->mpNext = list.mpHead;
+				list.mpHead   = pLink;
+
+				if(EASTL_UNLIKELY(++list.mnCount >= (2 * EASTL_SIZE_CLASS_TRANSFER_COUNT)))
+				{
+					// Keep the most recently freed nodes, which are likely still in the cache,
+					// and give the rest back.
+					Link* pLast = list.mpHead;
+					for(size_t i = 1; i < EASTL_SIZE_CLASS_TRANSFER_COUNT; i++)
+						pLast = pLast->mpNext;
+
+					Link* const pGiveHead = pLast->mpNext;
+					Link*       pGiveTail = pGiveHead;
+					while(pGiveTail->mpNext)
+						pGiveTail = pGiveTail->mpNext;
+
+					pLast->mpNext = NULL;
+					list.mnCount  = EASTL_SIZE_CLASS_TRANSFER_COUNT;
+					GiveShared(nClass, pGiveHead, pGiveTail);
+				}
+			#else
+				GiveShared(nClass, pLink, pLink);
+			#endif
+		}
+
+	} // namespace
+
+
+
+	void* size_class_allocator::allocate(size_t n, int)
+	{
+		if(n > EASTL_SIZE_CLASS_MAX_SIZE)
+		{
+			void* const p = EASTLAlloc(*EASTLAllocatorDefault(), n);
+			return p;
+		}
+
+		return AllocateNode(ClassIndex(n));
+	}
+
+
+	void* size_class_allocator::allocate(size_t n, size_t alignment, size_t offset, int)
+	{
+		if(n > EASTL_SIZE_CLASS_MAX_SIZE)
+		{
+			void* const p = EASTLAllocAligned(*EASTLAllocatorDefault(), n, alignment, offset);
+			return p;
+		}
+
+		// Nodes are aligned to the largest power of two which divides their class size.
+		// See the class documentation.
+		EASTL_ASSERT((alignment <= EASTL_SIZE_CLASS_GRANULARITY) || ((n % alignment) == 0));
+		EASTL_ASSERT((offset % alignment) == 0);
+
+		return AllocateNode(ClassIndex(n));
+	}
+
+
+	void size_class_allocator::deallocate(void* p, size_t n)
+	{
+		if(n > EASTL_SIZE_CLASS_MAX_SIZE)
+			EASTLFree(*EASTLAllocatorDefault(), p, n);
+		else if(p)
+			DeallocateNode(p, ClassIndex(n));
+	}
+
+
+	void size_class_allocator::flush_thread_cache()
+	{
+		#if EASTL_SIZE_CLASS_THREAD_CACHE_ENABLED
+			gThreadCache.Flush();
+		#endif
+	}
+
+
+	size_t size_class_allocator::slab_memory()
+	{
+		return GetSharedState().mnSlabMemory.load(std::memory_order_relaxed);
+	}
+
+} // namespace eastl
@@ -0,0 +1,298 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/stats_allocator.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <new>
+#include <stdio.h>
+#include <string.h>
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+
+namespace eastl
+{
+
+	namespace Internal
+	{
+		EASTL_API AllocationTraceFunction gpAllocationTraceFunction = NULL;
+		EASTL_API void*                   gpAllocationTraceContext  = NULL;
+	}
+
+
+	namespace
+	{
+		// The hash table has at least twice as many slots as names, so probes stay short.
+		EA_CONSTEXPR size_t SlotCount(size_t n = 1)
+		{
+			return (n >= (2 * EASTL_ALLOCATION_STATS_MAX_NAMES)) ? n : SlotCount(n * 2);
+		}
+
+		const size_t kSlotCount = SlotCount();
+
+
+		size_t HashName(const char* pName)
+		{
+			size_t h = 2166136261U; // FNV-1
+
+			while(*pName)
+				h = (h * 16777619) ^ (uint8_t)*pName++;
+			return h;
+		}
+
+
+		struct Registry
+		{
+			Internal::mutex                   mMutex;
+			std::atomic<allocation_stats*>    mSlots[kSlotCount];   // Names are published here once their entry is initialized.
+			std::atomic<size_t>               mnCount;
+			allocation_stats                  mEntries[EASTL_ALLOCATION_STATS_MAX_NAMES];
+			allocation_stats                  mOther;
+
+			Registry() : mnCount(0), mOther("(other)")
+			{
+				for(size_t i = 0; i < kSlotCount; i++)
+					mSlots[i].store(NULL, std::memory_order_relaxed);
+			}
+		};
+
+
+		// The registry is never destroyed, as containers may still free memory while the
+		// process's static objects are being destroyed.
+		Registry& GetRegistry()
+		{
+			alignas(Registry) static unsigned char sRegistryBuffer[sizeof(Registry)];
+			static Registry* const spRegistry = new(sRegistryBuffer) Registry;
+			return *spRegistry;
+		}
+
+
+		// Looks for a name in the hash table. If it isn't there, nSlot is where it would go.
+		allocation_stats* FindName(Registry& registry, const char* pName, size_t& nSlot)
+		{
+			for(nSlot = HashName(pName) & (kSlotCount - 1); ; nSlot = (nSlot + 1) & (kSlotCount - 1))
+			{
+				allocation_stats* const pStats = registry.mSlots[nSlot].load(std::memory_order_acquire);
+
+				if(!pStats || (strcmp(pStats->get_name(), pName) == 0))
+					return pStats;
+			}
+		}
+
+
+		void FormatBytes(char* pBuffer, size_t nBufferSize, uint64_t nBytes)
+		{
+			if(nBytes >= (UINT64_C(10) << 30))
+				snprintf(pBuffer, nBufferSize, "%lluG", (unsigned long long)(nBytes >> 30));
+			else if(nBytes >= (UINT64_C(10) << 20))
+				snprintf(pBuffer, nBufferSize, "%lluM", (unsigned long long)(nBytes >> 20));
+			else if(nBytes >= (UINT64_C(10) << 10))
+				snprintf(pBuffer, nBufferSize, "%lluK", (unsigned long long)(nBytes >> 10));
+			else
+				snprintf(pBuffer, nBufferSize, "%llu", (unsigned long long)nBytes);
+		}
+
+
+		struct SnapshotCurrentBytesGreater
+		{
+			bool operator()(const allocation_stats_snapshot& a, const allocation_stats_snapshot& b) const
+				{ return a.current_bytes() > b.current_bytes(); }
+		};
+
+	} // namespace
+
+
+
+	allocation_stats::allocation_stats(const char* pName)
+		: mpName(pName)
+		, mnAllocationCount(0)
+		, mnDeallocationCount(0)
+		, mnAllocatedBytes(0)
+		, mnDeallocatedBytes(0)
+		, mnPeakBytes(0)
+	{
+		for(size_t i = 0; i < kHistogramSize; i++)
+			mnHistogram[i].store(0, std::memory_order_relaxed);
+	}
+
+
+	void allocation_stats::get_snapshot(allocation_stats_snapshot& snapshot) const
+	{
+		snapshot.mpName               = mpName;
+		snapshot.mnAllocationCount    = mnAllocationCount.load(std::memory_order_relaxed);
+		snapshot.mnDeallocationCount  = mnDeallocationCount.load(std::memory_order_relaxed);
+		snapshot.mnDeallocatedBytes   = mnDeallocatedBytes.load(std::memory_order_relaxed); // Read before the allocated bytes, so that current_bytes doesn't go negative.
+		snapshot.mnAllocatedBytes     = mnAllocatedBytes.load(std::memory_order_relaxed);
+		snapshot.mnPeakBytes          = mnPeakBytes.load(std::memory_order_relaxed);
+
+		for(size_t i = 0; i < kHistogramSize; i++)
+			snapshot.mnHistogram[i] = mnHistogram[i].load(std::memory_order_relaxed);
+	}
+
+
+	void allocation_stats::reset()
+	{
+		const uint64_t nDeallocatedBytes = mnDeallocatedBytes.exchange(0, std::memory_order_relaxed);
+		const uint64_t nAllocatedBytes   = mnAllocatedBytes.exchange(0, std::memory_order_relaxed);
+		const uint64_t nDeallocations    = mnDeallocationCount.exchange(0, std::memory_order_relaxed);
+		const uint64_t nAllocations      = mnAllocationCount.exchange(0, std::memory_order_relaxed);
+
+		// What is still in use stays counted, so that its later frees don't take the counts below zero.
+		mnAllocatedBytes.fetch_add(nAllocatedBytes - nDeallocatedBytes, std::memory_order_relaxed);
+		mnAllocationCount.fetch_add(nAllocations - nDeallocations, std::memory_order_relaxed);
+		mnPeakBytes.store(nAllocatedBytes - nDeallocatedBytes, std::memory_order_relaxed);
+
+		for(size_t i = 0; i < kHistogramSize; i++)
+			mnHistogram[i].store(0, std::memory_order_relaxed);
+	}
+
+
+	size_t allocation_stats::histogram_index(size_t n)
+	{
+		size_t i = 0;
+
+		if(n)
+		{
+			for(n = (n - 1) >> 3; n; n >>= 1)
+				i++;
+		}
+
+		return (i < kHistogramSize) ? i : (kHistogramSize - 1);
+	}
+
+
+
+	EASTL_API allocation_stats* GetAllocationStats(const char* pName)
+	{
+		Registry& registry = GetRegistry();
+
+		if(!pName)
+			pName = EASTL_STATS_ALLOCATOR_DEFAULT_NAME;
+
+		// Entries are never removed, so a name which is found stays valid without the lock.
+		size_t nSlot;
+		allocation_stats* pStats = FindName(registry, pName, nSlot);
+
+		if(!pStats)
+		{
+			Internal::auto_mutex lock(registry.mMutex);
+
+			// Another thread may have added the name since we looked.
+			pStats = FindName(registry, pName, nSlot);
+
+			if(!pStats)
+			{
+				const size_t nCount = registry.mnCount.load(std::memory_order_relaxed);
+				pStats = &registry.mOther;
+
+				if(nCount < EASTL_ALLOCATION_STATS_MAX_NAMES)
+				{
+					const size_t nNameSize = strlen(pName) + 1;
+					char* const  pNameCopy = (char*)EASTLAlloc(*EASTLAllocatorDefault(), nNameSize);
+
+					if(pNameCopy)
+					{
+						memcpy(pNameCopy, pName, nNameSize);
+
+						pStats = &registry.mEntries[nCount];
+						pStats->mpName = pNameCopy;
+						registry.mnCount.store(nCount + 1, std::memory_order_release);
+						registry.mSlots[nSlot].store(pStats, std::memory_order_release);
+					}
+				}
+			}
+		}
+
+		return pStats;
+	}
+
+
+	EASTL_API size_t GetAllocationStatsSnapshots(allocation_stats_snapshot* pSnapshotArray, size_t nArrayCapacity)
+	{
+		Registry&    registry = GetRegistry();
+		const size_t nCount   = registry.mnCount.load(std::memory_order_acquire);
+
+		for(size_t i = 0; (i < nCount) && (i < nArrayCapacity); i++)
+			registry.mEntries[i].get_snapshot(pSnapshotArray[i]);
+
+		if(nCount < nArrayCapacity)
+			registry.mOther.get_snapshot(pSnapshotArray[nCount]);
+
+		return nCount + 1; // +1 for "(other)".
+	}
+
+
+	EASTL_API void ResetAllocationStats()
+	{
+		Registry&    registry = GetRegistry();
+		const size_t nCount   = registry.mnCount.load(std::memory_order_acquire);
+
+		for(size_t i = 0; i < nCount; i++)
+			registry.mEntries[i].reset();
+		registry.mOther.reset();
+	}
+
+
+	EASTL_API void DumpAllocationStats(AllocationStatsOutputFunction pOutputFunction, void* pContext)
+	{
+		eastl::vector<allocation_stats_snapshot> snapshots(GetRegistry().mnCount.load(std::memory_order_acquire) + 1);
+
+		snapshots.resize(eastl::min_alt(snapshots.size(), GetAllocationStatsSnapshots(snapshots.data(), snapshots.size())));
+		eastl::stable_sort(snapshots.begin(), snapshots.end(), SnapshotCurrentBytesGreater());
+
+		char line[512];
+		char current[24], peak[24], total[24];
+
+		snprintf(line, sizeof(line), "%-40s %10s %10s %12s %12s %10s", "name", "in use", "peak", "allocations", "frees", "allocated");
+		pOutputFunction(line, pContext);
+
+		for(const allocation_stats_snapshot& snapshot : snapshots)
+		{
+			if(snapshot.mnAllocationCount == 0)
+				continue;
+
+			FormatBytes(current, sizeof(current), snapshot.current_bytes());
+			FormatBytes(peak,    sizeof(peak),    snapshot.mnPeakBytes);
+			FormatBytes(total,   sizeof(total),   snapshot.mnAllocatedBytes);
+
+			snprintf(line, sizeof(line), "%-40s %10s %10s %12llu %12llu %10s", snapshot.mpName, current, peak,
+					 (unsigned long long)snapshot.mnAllocationCount, (unsigned long long)snapshot.mnDeallocationCount, total);
+			pOutputFunction(line, pContext);
+
+			// The histogram line lists the non-empty buckets as <upper size bound>:<count>.
+			int nLength = snprintf(line, sizeof(line), "    sizes");
+			bool bHistogram = false;
+
+			for(size_t i = 0; (i < allocation_stats::kHistogramSize) && (nLength < (int)sizeof(line)); i++)
+			{
+				if(snapshot.mnHistogram[i])
+				{
+					if(i < (allocation_stats::kHistogramSize - 1))
+						FormatBytes(current, sizeof(current), UINT64_C(8) << i);
+					else
+						snprintf(current, sizeof(current), "more");
+
+					nLength += snprintf(line + nLength, sizeof(line) - (size_t)nLength, " <=%s:%llu", current, (unsigned long long)snapshot.mnHistogram[i]);
+					bHistogram = true;
+				}
+			}
+
+			if(bHistogram)
+				pOutputFunction(line, pContext);
+		}
+	}
+
+
+	EASTL_API void SetAllocationTraceFunction(AllocationTraceFunction pTraceFunction, void* pContext)
+	{
+		Internal::gpAllocationTraceContext  = pContext;
+		Internal::gpAllocationTraceFunction = pTraceFunction;
+	}
+
+} // namespace eastl
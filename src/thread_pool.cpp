@@ -0,0 +1,329 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/thread_pool.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/deque.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <new>
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+// Workers need std::thread and std::condition_variable, and a thread_local which tells
+// a thread which pool queue is its own. Without them, pools have no workers and run
+// everything on the calling thread.
+#if EASTL_THREAD_SUPPORT_AVAILABLE && EASTL_CPP11_MUTEX_ENABLED && !defined(EA_COMPILER_NO_THREAD_LOCAL)
+	#define EASTL_THREAD_POOL_ENABLED 1
+#else
+	#define EASTL_THREAD_POOL_ENABLED 0
+#endif
+
+#if EASTL_THREAD_POOL_ENABLED
+	EA_DISABLE_ALL_VC_WARNINGS();
+	#include <condition_variable>
+	#include <thread>
+	EA_RESTORE_ALL_VC_WARNINGS();
+#endif
+
+
+namespace eastl
+{
+
+	#if EASTL_THREAD_POOL_ENABLED
+		namespace Internal
+		{
+			// The queue of one worker, or of the threads outside the pool. The owner pushes and
+			// pops at the back; other threads steal from the front.
+			struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) pool_task_queue
+			{
+				Internal::mutex               mMutex;
+				eastl::deque<pool_task*, EASTLAllocatorType, 64> mTasks;
+
+				pool_task_queue() : mMutex(), mTasks(EASTLAllocatorType(EASTL_NAME_VAL("EASTL thread_pool"))) {}
+			} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+
+
+			struct thread_pool_state
+			{
+				pool_task_queue*        mpQueues;        // One per worker, and a last one for threads outside the pool.
+				size_t                  mnQueueCount;
+				std::thread*            mpThreads;
+				std::atomic<size_t>     mnQueuedCount;   // The number of tasks in all of the queues.
+				std::atomic<size_t>     mnSleeperCount;  // The number of workers waiting on mSleepCondition, or about to.
+				std::atomic<bool>       mbShouldStop;
+				std::mutex              mSleepMutex;
+				std::condition_variable mSleepCondition;
+
+				thread_pool_state() : mpQueues(NULL), mnQueueCount(0), mpThreads(NULL), mnQueuedCount(0), mnSleeperCount(0), mbShouldStop(false) {}
+			};
+		}
+
+
+		namespace
+		{
+			using Internal::pool_task;
+			using Internal::pool_task_queue;
+			using Internal::thread_pool_state;
+
+			// The spins a worker makes, looking for tasks, before it sleeps.
+			const uint32_t kWorkerSpinCount = 256;
+
+
+			struct CurrentWorker
+			{
+				const thread_pool_state* mpState;
+				size_t                   mnIndex;
+			};
+
+			thread_local CurrentWorker gCurrentWorker = { NULL, 0 };
+
+
+			// Returns the index of the calling thread's queue in pState.
+			inline size_t GetQueueIndex(const thread_pool_state* pState)
+			{
+				return (gCurrentWorker.mpState == pState) ? gCurrentWorker.mnIndex : (pState->mnQueueCount - 1);
+			}
+
+
+			pool_task* TryPop(pool_task_queue& queue, bool bBack)
+			{
+				Internal::auto_mutex lock(queue.mMutex);
+
+				if(queue.mTasks.empty())
+					return NULL;
+
+				pool_task* pTask;
+
+				if(bBack)
+				{
+					pTask = queue.mTasks.back();
+					queue.mTasks.pop_back();
+				}
+				else
+				{
+					pTask = queue.mTasks.front();
+					queue.mTasks.pop_front();
+				}
+
+				return pTask;
+			}
+
+
+			// Runs a task from the calling thread's own queue, or else one stolen from another
+			// queue. Returns false if there was nothing to run.
+			bool TryRunTask(thread_pool_state* pState, size_t nQueueIndex)
+			{
+				if(!pState->mnQueuedCount.load(std::memory_order_relaxed))
+					return false;
+
+				pool_task* pTask = TryPop(pState->mpQueues[nQueueIndex], true);
+
+				for(size_t i = 1; !pTask && (i < pState->mnQueueCount); i++)
+					pTask = TryPop(pState->mpQueues[(nQueueIndex + i) % pState->mnQueueCount], false);
+
+				if(!pTask)
+					return false;
+
+				pState->mnQueuedCount.fetch_sub(1, std::memory_order_relaxed);
+				pTask->mpExecute(pTask);
+				pTask->mbDone.store(true, std::memory_order_release); // The task's owner may destroy it as soon as this is seen.
+				return true;
+			}
+
+
+			void RunWorker(thread_pool_state* pState, size_t nQueueIndex)
+			{
+				gCurrentWorker.mpState = pState;
+				gCurrentWorker.mnIndex = nQueueIndex;
+
+				while(!pState->mbShouldStop.load(std::memory_order_acquire))
+				{
+					if(TryRunTask(pState, nQueueIndex))
+						continue;
+
+					bool bTaskQueued = false;
+
+					for(uint32_t i = 0; (i < kWorkerSpinCount) && !bTaskQueued; i++)
+					{
+						Internal::cpu_pause();
+						bTaskQueued = (pState->mnQueuedCount.load(std::memory_order_relaxed) != 0);
+					}
+
+					if(!bTaskQueued)
+					{
+						// The count of sleepers and the count of queued tasks are each written before the
+						// other is read, so either we see a new task here or DoPush sees us and wakes us.
+						std::unique_lock<std::mutex> lock(pState->mSleepMutex);
+						pState->mnSleeperCount.fetch_add(1, std::memory_order_seq_cst);
+						pState->mSleepCondition.wait(lock, [pState]
+						{
+							return pState->mbShouldStop.load(std::memory_order_relaxed) || (pState->mnQueuedCount.load(std::memory_order_seq_cst) != 0);
+						});
+						pState->mnSleeperCount.fetch_sub(1, std::memory_order_relaxed);
+					}
+				}
+
+				gCurrentWorker.mpState = NULL;
+			}
+
+		} // namespace
+	#endif
+
+
+
+	thread_pool::thread_pool(size_t nThreadCount)
+		: mpState(NULL), mnThreadCount(0)
+	{
+		#if EASTL_THREAD_POOL_ENABLED
+			if(nThreadCount)
+			{
+				mpState = new thread_pool_state;
+				mnThreadCount = nThreadCount;
+
+				mpState->mnQueueCount = nThreadCount + 1;
+				mpState->mpQueues = (pool_task_queue*)EASTLAllocAligned(*EASTLAllocatorDefault(), mpState->mnQueueCount * sizeof(pool_task_queue), EASTL_ALIGN_OF(pool_task_queue), 0);
+				EASTL_ASSERT(mpState->mpQueues);
+
+				for(size_t i = 0; i < mpState->mnQueueCount; i++)
+					::new(&mpState->mpQueues[i]) pool_task_queue;
+
+				mpState->mpThreads = (std::thread*)EASTLAlloc(*EASTLAllocatorDefault(), nThreadCount * sizeof(std::thread));
+				EASTL_ASSERT(mpState->mpThreads);
+
+				for(size_t i = 0; i < nThreadCount; i++)
+					::new(&mpState->mpThreads[i]) std::thread(&RunWorker, mpState, i);
+			}
+		#else
+			EA_UNUSED(nThreadCount);
+		#endif
+	}
+
+
+	thread_pool::~thread_pool()
+	{
+		#if EASTL_THREAD_POOL_ENABLED
+			if(mpState)
+			{
+				EASTL_ASSERT(mpState->mnQueuedCount.load() == 0); // An invoke is still running.
+
+				{
+					std::lock_guard<std::mutex> lock(mpState->mSleepMutex);
+					mpState->mbShouldStop.store(true, std::memory_order_release);
+				}
+				mpState->mSleepCondition.notify_all();
+
+				for(size_t i = 0; i < mnThreadCount; i++)
+				{
+					mpState->mpThreads[i].join();
+					mpState->mpThreads[i].~thread();
+				}
+
+				for(size_t i = 0; i < mpState->mnQueueCount; i++)
+					mpState->mpQueues[i].~pool_task_queue();
+
+				EASTLFree(*EASTLAllocatorDefault(), mpState->mpThreads, mnThreadCount * sizeof(std::thread));
+				EASTLFree(*EASTLAllocatorDefault(), mpState->mpQueues, mpState->mnQueueCount * sizeof(pool_task_queue));
+				delete mpState;
+			}
+		#endif
+	}
+
+
+	thread_pool& thread_pool::get_default()
+	{
+		// The default pool is never destroyed, as joining threads while the process's static
+		// objects are being destroyed can deadlock on some platforms.
+		alignas(thread_pool) static unsigned char sPoolBuffer[sizeof(thread_pool)];
+		static thread_pool* const spPool = new(sPoolBuffer) thread_pool;
+		return *spPool;
+	}
+
+
+	size_t thread_pool::default_thread_count()
+	{
+		#if EASTL_THREAD_POOL_ENABLED
+			const size_t nHardwareThreadCount = (size_t)std::thread::hardware_concurrency();
+
+			return nHardwareThreadCount ? eastl::min_alt(nHardwareThreadCount - 1, (size_t)EASTL_THREAD_POOL_MAX_DEFAULT_THREADS) : 0;
+		#else
+			return 0;
+		#endif
+	}
+
+
+	void thread_pool::DoPush(Internal::pool_task* pTask)
+	{
+		#if EASTL_THREAD_POOL_ENABLED
+			pool_task_queue& queue = mpState->mpQueues[GetQueueIndex(mpState)];
+
+			{
+				Internal::auto_mutex lock(queue.mMutex);
+				queue.mTasks.push_back(pTask);
+			}
+
+			mpState->mnQueuedCount.fetch_add(1, std::memory_order_seq_cst);
+
+			if(mpState->mnSleeperCount.load(std::memory_order_seq_cst))
+			{
+				std::lock_guard<std::mutex> lock(mpState->mSleepMutex);
+				mpState->mSleepCondition.notify_one();
+			}
+		#else
+			EA_UNUSED(pTask);
+			EASTL_FAIL_MSG("thread_pool: a pool without workers runs tasks inline.");
+		#endif
+	}
+
+
+	void thread_pool::DoWait(Internal::pool_task* pTask)
+	{
+		#if EASTL_THREAD_POOL_ENABLED
+			const size_t     nQueueIndex = GetQueueIndex(mpState);
+			pool_task_queue& queue       = mpState->mpQueues[nQueueIndex];
+			bool             bTaken      = false;
+
+			{
+				// A worker's task is at the back of its queue unless it was stolen. Threads outside
+				// the pool share a queue, so another thread may have pushed after us.
+				Internal::auto_mutex lock(queue.mMutex);
+
+				for(auto it = queue.mTasks.rbegin(); it != queue.mTasks.rend(); ++it)
+				{
+					if(*it == pTask)
+					{
+						queue.mTasks.erase(it.base() - 1);
+						bTaken = true;
+						break;
+					}
+				}
+			}
+
+			if(bTaken)
+			{
+				mpState->mnQueuedCount.fetch_sub(1, std::memory_order_relaxed);
+				pTask->mpExecute(pTask);
+				return;
+			}
+
+			// The task was stolen. Run other tasks until it is done, rather than leave this
+			// thread idle.
+			for(uint32_t nSpinCount = 1; !pTask->mbDone.load(std::memory_order_acquire); nSpinCount++)
+			{
+				if(!TryRunTask(mpState, nQueueIndex))
+				{
+					if((nSpinCount % 64) == 0)
+						std::this_thread::yield();
+					else
+						Internal::cpu_pause();
+				}
+			}
+		#else
+			EA_UNUSED(pTask);
+		#endif
+	}
+
+} // namespace eastl
@@ -95,13 +95,160 @@ namespace eastl
 		// shared_ptr_auto_mutex
 		/////////////////////////////////////////////////////////////////
 
-		// We could solve this by having single global mutex for all shared_ptrs, a set of mutexes for shared_ptrs, 
-		// a single mutex for every shared_ptr, or have a template parameter that enables mutexes for just some shared_ptrs.
-		eastl::late_constructed<mutex, true> gSharedPtrMutex;
+		// The shared_ptr atomic functions lock one of a table of mutexes, chosen by the address
+		// of the shared_ptr, so that threads using unrelated shared_ptrs rarely wait for each
+		// other. Each function locks only the mutex of the shared_ptr that it modifies.
+		#ifndef EASTL_SHARED_PTR_MUTEX_COUNT
+			#define EASTL_SHARED_PTR_MUTEX_COUNT 64
+		#endif
+
+		static_assert((EASTL_SHARED_PTR_MUTEX_COUNT & (EASTL_SHARED_PTR_MUTEX_COUNT - 1)) == 0, "EASTL_SHARED_PTR_MUTEX_COUNT must be a power of two.");
+
+		struct shared_ptr_mutex_table
+		{
+			struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) padded_mutex
+			{
+				mutex mMutex;
+			} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+
+			padded_mutex mMutexes[EASTL_SHARED_PTR_MUTEX_COUNT];
+
+			mutex& get(const void* p)
+			{
+				// shared_ptrs are at least pointer-aligned, so the low bits carry no information.
+				uintptr_t n = (uintptr_t)p;
+				n = (n >> 4) ^ (n >> 10) ^ (n >> 16);
+				return mMutexes[n & (EASTL_SHARED_PTR_MUTEX_COUNT - 1)].mMutex;
+			}
+		};
+
+		eastl::late_constructed<shared_ptr_mutex_table, true> gSharedPtrMutexTable;
+
+		shared_ptr_auto_mutex::shared_ptr_auto_mutex(const void* pSharedPtr)
+			: auto_mutex(gSharedPtrMutexTable->get(pSharedPtr))
+		{
+		}
+
 
-		shared_ptr_auto_mutex::shared_ptr_auto_mutex(const void* /*pSharedPtr*/)
-			: auto_mutex(*gSharedPtrMutex.get())
+
+		/////////////////////////////////////////////////////////////////
+		// shared_ptr_hazard
+		/////////////////////////////////////////////////////////////////
+
+		// The hazard slots are kept in a list which only grows. A thread claims a free slot
+		// the first time that it needs one and gives it back when it exits, so the list is
+		// as long as the largest number of threads which have used atomic_shared_ptr at once.
+		// Without thread_local, a slot is claimed and given back by every shared_ptr_hazard.
+		#if EASTL_THREAD_SUPPORT_AVAILABLE && !defined(EA_COMPILER_NO_THREAD_LOCAL)
+			#define EASTL_SHARED_PTR_HAZARD_THREAD_SLOT_ENABLED 1
+		#else
+			#define EASTL_SHARED_PTR_HAZARD_THREAD_SLOT_ENABLED 0
+		#endif
+
+		namespace
 		{
+			struct EA_PREFIX_ALIGN(EA_CACHE_LINE_SIZE) HazardRecord
+			{
+				std::atomic<const void*> mpHazard;
+				std::atomic<bool>        mbClaimed;
+				HazardRecord*            mpNext;
+			} EA_POSTFIX_ALIGN(EA_CACHE_LINE_SIZE);
+
+			std::atomic<HazardRecord*> gpHazardRecordList(NULL);
+
+
+			HazardRecord* ClaimHazardRecord()
+			{
+				for(HazardRecord* pRecord = gpHazardRecordList.load(std::memory_order_acquire); pRecord; pRecord = pRecord->mpNext)
+				{
+					if(!pRecord->mbClaimed.load(std::memory_order_relaxed) && !pRecord->mbClaimed.exchange(true, std::memory_order_acquire))
+						return pRecord;
+				}
+
+				// Records are never freed, as a writer may be reading one at any time.
+				void* const pMemory = EASTLAllocAligned(*EASTLAllocatorDefault(), sizeof(HazardRecord), EASTL_ALIGN_OF(HazardRecord), 0);
+				EASTL_ASSERT(pMemory);
+
+				HazardRecord* const pRecord = ::new(pMemory) HazardRecord;
+				pRecord->mpHazard.store(NULL, std::memory_order_relaxed);
+				pRecord->mbClaimed.store(true, std::memory_order_relaxed);
+				pRecord->mpNext = gpHazardRecordList.load(std::memory_order_relaxed);
+
+				while(!gpHazardRecordList.compare_exchange_weak(pRecord->mpNext, pRecord, std::memory_order_release, std::memory_order_relaxed))
+					{ }
+
+				return pRecord;
+			}
+
+
+			void ReleaseHazardRecord(HazardRecord* pRecord)
+			{
+				pRecord->mpHazard.store(NULL, std::memory_order_release);
+				pRecord->mbClaimed.store(false, std::memory_order_release);
+			}
+
+
+			#if EASTL_SHARED_PTR_HAZARD_THREAD_SLOT_ENABLED
+				struct ThreadHazardRecord
+				{
+					HazardRecord* mpRecord;
+
+				   ~ThreadHazardRecord()
+					{
+						if(mpRecord)
+							ReleaseHazardRecord(mpRecord);
+					}
+				};
+
+				thread_local ThreadHazardRecord gThreadHazardRecord = { NULL };
+			#endif
+
+		} // namespace
+
+
+		shared_ptr_hazard::shared_ptr_hazard()
+		{
+			#if EASTL_SHARED_PTR_HAZARD_THREAD_SLOT_ENABLED
+				if(EASTL_UNLIKELY(!gThreadHazardRecord.mpRecord))
+					gThreadHazardRecord.mpRecord = ClaimHazardRecord();
+				mpSlot = &gThreadHazardRecord.mpRecord->mpHazard;
+				EASTL_ASSERT(mpSlot->load(std::memory_order_relaxed) == NULL); // The thread already has a shared_ptr_hazard.
+			#else
+				mpSlot = &ClaimHazardRecord()->mpHazard;
+			#endif
+		}
+
+
+		shared_ptr_hazard::~shared_ptr_hazard()
+		{
+			#if EASTL_SHARED_PTR_HAZARD_THREAD_SLOT_ENABLED
+				mpSlot->store(NULL, std::memory_order_release);
+			#else
+				// mpHazard is the first member of its record.
+				ReleaseHazardRecord(reinterpret_cast<HazardRecord*>(mpSlot));
+			#endif
+		}
+
+
+		void shared_ptr_hazard::wait_until_unprotected(const void* p) EA_NOEXCEPT
+		{
+			// A reader only holds a pointer for as long as it takes to add a reference to
+			// what it points to, so these waits are short.
+			for(HazardRecord* pRecord = gpHazardRecordList.load(std::memory_order_seq_cst); pRecord; pRecord = pRecord->mpNext)
+			{
+				for(uint32_t nSpinCount = 1; pRecord->mpHazard.load(std::memory_order_seq_cst) == p; nSpinCount++)
+				{
+					#if EASTL_CPP11_MUTEX_ENABLED
+						if((nSpinCount % 64) == 0)
+						{
+							std::this_thread::yield();
+							continue;
+						}
+					#endif
+
+					cpu_pause();
+				}
+			}
 		}
 
 
@@ -33,11 +33,16 @@ int TestBit();
 #endif
 int TestBitVector();
 int TestBitset();
+int TestBTree();
 int TestCharTraits();
+int TestCharConv();
 int TestChrono();
 int TestConcepts();
+int TestConcurrentHashMap();
+int TestConcurrentQueue();
 int TestCppCXTypeTraits();
 int TestDeque();
+int TestExecution();
 int TestExtra();
 int TestFinally();
 int TestFixedFunction();
@@ -49,6 +54,7 @@ int TestFixedSet();
 int TestFixedString();
 int TestFixedTupleVector();
 int TestFixedVector();
+int TestFlatHash();
 int TestFunctional();
 int TestHash();
 int TestHeap();
@@ -62,21 +68,25 @@ int TestListMap();
 int TestLruCache();
 int TestMap();
 int TestMemory();
+int TestMemoryReclamation();
 int TestMeta();
 int TestNumericLimits();
 int TestOptional();
 int TestRandom();
 int TestRatio();
 int TestRingBuffer();
+int TestRope();
 int TestSList();
 int TestSegmentedVector();
 int TestSet();
+int TestSmallVector();
 int TestSmartPtr();
 int TestSort();
 int TestSpan();
 int TestString();
 int TestStringHashMap();
 int TestStringMap();
+int TestStringPool();
 int TestStringView();
 int TestTuple();
 int TestTupleVector();
@@ -6,9 +6,20 @@
 #include "EASTLTest.h"
 #include <EASTL/allocator.h>
 #include <EASTL/fixed_allocator.h>
+#include <EASTL/arena_allocator.h>
+#include <EASTL/size_class_allocator.h>
+#include <EASTL/stats_allocator.h>
 #include <EASTL/list.h>
+#include <EASTL/slist.h>
+#include <EASTL/vector.h>
+#include <EASTL/map.h>
+#include <EASTL/set.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/string.h>
+#include <EASTL/internal/thread_support.h>
 #include <EAStdC/EAString.h>
 #include <EAStdC/EAAlignment.h>
+#include <eathread/eathread_thread.h>
 
 
 
@@ -278,6 +289,622 @@ static int TestAllocationOffsetAndAlignment()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+// TestArenaAllocator
+//
+static int TestArenaAllocator()
+{
+	using namespace eastl;
+
+	int nErrorCount = 0;
+
+	{
+		// void* allocate(size_t n, size_t alignment, size_t alignmentOffset);
+		// void  deallocate(void* p, size_t n);
+		arena a(256);
+		EATEST_VERIFY(a.capacity() == 0 && a.block_count() == 0);
+
+		void* p1 = a.allocate(10, 1);
+		void* p2 = a.allocate(8, 8);
+		void* p3 = a.allocate(20, 64);
+		void* p4 = a.allocate(4, 16, 4);
+		EATEST_VERIFY(p1 && p2 && p3 && p4);
+		EATEST_VERIFY(EA::StdC::IsAligned(p2, 8));
+		EATEST_VERIFY(EA::StdC::IsAligned(p3, 64));
+		EATEST_VERIFY(EA::StdC::IsAligned((char*)p4 - 4, 16));
+		EATEST_VERIFY(((char*)p2 >= (char*)p1 + 10) && ((char*)p3 >= (char*)p2 + 8));
+		EATEST_VERIFY(a.allocated_size() == 42);
+		EATEST_VERIFY(a.block_count() == 1);
+
+		// The most recent allocation is given back; others are not.
+		a.deallocate(p4, 4);
+		EATEST_VERIFY(a.allocated_size() == 38);
+		EATEST_VERIFY(a.allocate(4, 16, 4) == p4);
+		a.deallocate(p1, 10);
+		EATEST_VERIFY(a.allocated_size() == 42);
+
+		// Blocks are chained as the arena grows, including for allocations larger than a block.
+		for(int i = 0; i < 100; i++)
+			EATEST_VERIFY(a.allocate(100) != NULL);
+		void* pLarge = a.allocate(100000);
+		EATEST_VERIFY(pLarge != NULL);
+		memset(pLarge, 0, 100000);
+		EATEST_VERIFY(a.block_count() > 2);
+		EATEST_VERIFY(a.capacity() >= a.allocated_size());
+
+		// reset() keeps the blocks and reuses them.
+		const size_t nCapacity   = a.capacity();
+		const size_t nBlockCount = a.block_count();
+		a.reset();
+		EATEST_VERIFY(a.allocated_size() == 0);
+		EATEST_VERIFY(a.allocate(10, 1) == p1);
+		for(int i = 0; i < 100; i++)
+			EATEST_VERIFY(a.allocate(100) != NULL);
+		EATEST_VERIFY((a.capacity() == nCapacity) && (a.block_count() == nBlockCount));
+
+		// release() frees them.
+		a.release();
+		EATEST_VERIFY(a.capacity() == 0 && a.block_count() == 0 && a.allocated_size() == 0);
+		EATEST_VERIFY(a.allocate(16) != NULL);
+	}
+
+	{
+		// arena(void* pBuffer, size_t nBufferSize);
+		char buffer[512];
+		arena a(buffer, sizeof(buffer));
+		EATEST_VERIFY(a.block_count() == 1 && a.capacity() == sizeof(buffer));
+
+		char* p = (char*)a.allocate(100);
+		EATEST_VERIFY((p >= buffer) && ((p + 100) <= (buffer + sizeof(buffer))));
+		EATEST_VERIFY(a.allocate(1000) != NULL); // Overflows to the allocator.
+		EATEST_VERIFY(a.block_count() == 2);
+
+		a.release(); // The user buffer is kept.
+		EATEST_VERIFY(a.block_count() == 1 && a.capacity() == sizeof(buffer));
+		EATEST_VERIFY(a.allocate(100) == p);
+	}
+
+	{
+		// Containers using arena_allocator.
+		arena a;
+
+		{
+			typedef vector<int, arena_allocator>                               IntVector;
+			typedef list<int, arena_allocator>                                 IntList;
+			typedef map<int, int, less<int>, arena_allocator>                  IntMap;
+			typedef hash_map<int, int, hash<int>, equal_to<int>, arena_allocator> IntHashMap;
+			typedef basic_string<char, arena_allocator>                        ArenaString;
+
+			IntVector   v((arena_allocator(a)));
+			IntList     l((arena_allocator(a)));
+			IntMap      m((arena_allocator(a)));
+			IntHashMap  h((arena_allocator(a)));
+			ArenaString s((arena_allocator(a)));
+
+			for(int i = 0; i < 1000; i++)
+			{
+				v.push_back(i);
+				l.push_back(i);
+				m[i] = i;
+				h[i] = i;
+				s.append_sprintf("%d", i % 10);
+			}
+
+			EATEST_VERIFY(v.size() == 1000 && v[999] == 999);
+			EATEST_VERIFY(l.size() == 1000 && l.back() == 999);
+			EATEST_VERIFY(m.size() == 1000 && m[500] == 500);
+			EATEST_VERIFY(h.size() == 1000 && h[500] == 500);
+			EATEST_VERIFY(s.size() == 1000 && s[999] == '9');
+			EATEST_VERIFY(v.get_allocator().get_arena() == &a);
+			EATEST_VERIFY(a.allocated_size() > (1000 * sizeof(int) * 4));
+
+			IntVector v2(v); // Copies use the same arena.
+			EATEST_VERIFY(v2 == v);
+			EATEST_VERIFY(v2.get_allocator() == v.get_allocator());
+		}
+
+		a.reset();
+		EATEST_VERIFY(a.allocated_size() == 0);
+	}
+
+	{
+		// scoped_default_arena
+		typedef vector<int, arena_allocator> IntVector;
+
+		arena a1, a2;
+		EATEST_VERIFY(GetDefaultArena() == NULL);
+
+		{
+			IntVector v; // No default arena, so it uses the heap.
+			v.push_back(1);
+			EATEST_VERIFY(v.get_allocator().get_arena() == NULL);
+		}
+
+		{
+			scoped_default_arena scope1(a1);
+			EATEST_VERIFY(GetDefaultArena() == &a1);
+
+			IntVector v1;
+			v1.push_back(1);
+			EATEST_VERIFY(v1.get_allocator().get_arena() == &a1);
+			EATEST_VERIFY(a1.allocated_size() > 0);
+
+			{
+				scoped_default_arena scope2(a2);
+				IntVector v2;
+				v2.push_back(2);
+				EATEST_VERIFY(v2.get_allocator().get_arena() == &a2);
+				EATEST_VERIFY(v2.get_allocator() != v1.get_allocator());
+			}
+
+			EATEST_VERIFY(GetDefaultArena() == &a1);
+		}
+
+		EATEST_VERIFY(GetDefaultArena() == NULL);
+	}
+
+	return nErrorCount;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestSizeClassAllocator
+//
+#if EASTL_THREAD_SUPPORT_AVAILABLE
+	namespace
+	{
+		typedef eastl::map<int, int, eastl::less<int>, eastl::size_class_allocator> SizeClassIntMap;
+		typedef eastl::list<int, eastl::size_class_allocator>                      SizeClassIntList;
+
+		// Each thread churns its own containers, and then allocates blocks which a SizeClassFreeThread
+		// frees once this thread has exited, so that nodes move between the thread caches.
+		struct SizeClassTestThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters mThreadParams;
+			EA::Thread::Thread           mThread;
+			std::atomic<int>*            mpStartedCount;
+			eastl::vector<uint32_t*>     mBlocks; // Allocated by this thread, and freed by a SizeClassFreeThread.
+			int                          mnThreadIndex;
+			int                          mnThreadCount;
+			int                          mnErrorCount;
+
+			SizeClassTestThread() : mThreadParams(), mThread(), mpStartedCount(NULL), mBlocks(), mnThreadIndex(0), mnThreadCount(0), mnErrorCount(0) {}
+			SizeClassTestThread(const SizeClassTestThread&) = delete;
+			void operator=(const SizeClassTestThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				int& nErrorCount = mnErrorCount; // declare nErrorCount so that EATEST_VERIFY can work, as it depends on it being declared.
+				eastl::size_class_allocator allocator;
+
+				mpStartedCount->fetch_add(1);
+				while(mpStartedCount->load() < mnThreadCount)
+					EA::Thread::ThreadSleep(0);
+
+				for(int r = 0; r < 20; r++)
+				{
+					SizeClassIntMap  m;
+					SizeClassIntList l;
+
+					for(int i = 0; i < 1000; i++)
+					{
+						m[i] = mnThreadIndex;
+						l.push_back(mnThreadIndex);
+					}
+
+					for(int i = 0; i < 1000; i += 2)
+						m.erase(i);
+
+					EATEST_VERIFY(m.size() == 500);
+					EATEST_VERIFY(eastl::count(l.begin(), l.end(), mnThreadIndex) == 1000);
+					for(SizeClassIntMap::iterator it = m.begin(); it != m.end(); ++it)
+						EATEST_VERIFY(it->second == mnThreadIndex);
+				}
+
+				// Blocks filled with a pattern unique to the thread, which would be overwritten
+				// if a block were handed out twice.
+				for(size_t i = 0; i < mBlocks.size(); i++)
+				{
+					mBlocks[i] = (uint32_t*)allocator.allocate(48);
+					for(int j = 0; j < 12; j++)
+						mBlocks[i][j] = (uint32_t)(mnThreadIndex + 1);
+				}
+
+				return nErrorCount;
+			}
+		};
+
+
+		// Frees, on a thread other than their own, the blocks of a SizeClassTestThread after checking them.
+		struct SizeClassFreeThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters mThreadParams;
+			EA::Thread::Thread           mThread;
+			eastl::vector<uint32_t*>*    mpBlocks;
+			uint32_t                     mnPattern;
+			int                          mnErrorCount;
+
+			SizeClassFreeThread() : mThreadParams(), mThread(), mpBlocks(NULL), mnPattern(0), mnErrorCount(0) {}
+			SizeClassFreeThread(const SizeClassFreeThread&) = delete;
+			void operator=(const SizeClassFreeThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				int& nErrorCount = mnErrorCount; // declare nErrorCount so that EATEST_VERIFY can work, as it depends on it being declared.
+				eastl::size_class_allocator allocator;
+
+				for(size_t i = 0; i < mpBlocks->size(); i++)
+				{
+					for(int j = 0; j < 12; j++)
+						EATEST_VERIFY((*mpBlocks)[i][j] == mnPattern);
+					allocator.deallocate((*mpBlocks)[i], 48);
+				}
+
+				return nErrorCount;
+			}
+		};
+	}
+#endif
+
+
+static int TestSizeClassAllocator()
+{
+	using namespace eastl;
+
+	int nErrorCount = 0;
+
+	{
+		// void* allocate(size_t n, int flags = 0);
+		// void  deallocate(void* p, size_t n);
+		size_class_allocator a;
+		vector<void*> blocks;
+
+		for(size_t n = 0; n <= EASTL_SIZE_CLASS_MAX_SIZE + 100; n++)
+		{
+			void* const p = a.allocate(n);
+			EATEST_VERIFY(p != NULL);
+			EATEST_VERIFY(EA::StdC::IsAligned(p, EASTL_SIZE_CLASS_GRANULARITY));
+			memset(p, (int)n, n);
+			blocks.push_back(p);
+		}
+
+		for(size_t n = 0; n < blocks.size(); n++)
+		{
+			const unsigned char* const p = (const unsigned char*)blocks[n];
+			for(size_t i = 0; i < n; i++)
+				EATEST_VERIFY(p[i] == (unsigned char)n);
+			a.deallocate(blocks[n], n);
+		}
+
+		// The most recently freed node of a class is the next one handed out.
+		void* const p1 = a.allocate(40);
+		a.deallocate(p1, 40);
+		EATEST_VERIFY(a.allocate(33) == p1);
+		a.deallocate(p1, 48);
+
+		// void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+		void* const p2 = a.allocate(64, 64, 0);
+		void* const p3 = a.allocate(96, 32, 0);
+		void* const p4 = a.allocate(1000, 128, 0);
+		EATEST_VERIFY(EA::StdC::IsAligned(p2, 64));
+		EATEST_VERIFY(EA::StdC::IsAligned(p3, 32));
+		EATEST_VERIFY(EA::StdC::IsAligned(p4, 128));
+		a.deallocate(p2, 64);
+		a.deallocate(p3, 96);
+		a.deallocate(p4, 1000);
+
+		EATEST_VERIFY(a == size_class_allocator());
+		EATEST_VERIFY(size_class_allocator::slab_memory() > 0);
+	}
+
+	{
+		// Node containers using size_class_allocator.
+		list<int, size_class_allocator>                                          l;
+		slist<int, size_class_allocator>                                         sl;
+		map<int, int, less<int>, size_class_allocator>                           m;
+		set<int, less<int>, size_class_allocator>                                s;
+		hash_map<int, int, hash<int>, equal_to<int>, size_class_allocator>       h;
+		vector<TestObject, size_class_allocator>                                 v;
+
+		for(int i = 0; i < 10000; i++)
+		{
+			l.push_back(i);
+			sl.push_front(i);
+			m[i] = i;
+			s.insert(i);
+			h[i] = i;
+			v.push_back(TestObject(i));
+		}
+
+		for(int i = 0; i < 10000; i += 3)
+		{
+			m.erase(i);
+			s.erase(i);
+			h.erase(i);
+		}
+
+		EATEST_VERIFY(l.size() == 10000 && l.back() == 9999);
+		EATEST_VERIFY(sl.size() == 10000 && sl.front() == 9999);
+		EATEST_VERIFY(m.size() == 6666 && m.validate() && m[1] == 1);
+		EATEST_VERIFY(s.size() == 6666 && s.validate());
+		EATEST_VERIFY(h.size() == 6666 && h.validate() && h[2] == 2);
+		EATEST_VERIFY(v.size() == 10000 && v[9999].mX == 9999);
+	}
+
+	#if EASTL_THREAD_SUPPORT_AVAILABLE
+	{
+		// Several threads churning nodes, and freeing blocks allocated by other threads.
+		const int kThreadCount = 8;
+		std::atomic<int> nStartedCount(0);
+
+		eastl::vector<SizeClassTestThread> threads(kThreadCount);
+		eastl::vector<SizeClassFreeThread> freeThreads(kThreadCount);
+
+		for(int t = 0; t < kThreadCount; t++)
+		{
+			threads[t].mpStartedCount = &nStartedCount;
+			threads[t].mnThreadIndex  = t;
+			threads[t].mnThreadCount  = kThreadCount;
+			threads[t].mBlocks.resize(5000);
+			threads[t].mThreadParams.mpName = "SizeClassTestThread";
+		}
+
+		for(int t = 0; t < kThreadCount; t++)
+			threads[t].mThread.Begin(&threads[t], NULL, &threads[t].mThreadParams);
+
+		for(int t = 0; t < kThreadCount; t++)
+		{
+			threads[t].mThread.WaitForEnd();
+			nErrorCount += threads[t].mnErrorCount;
+		}
+
+		for(int t = 0; t < kThreadCount; t++)
+		{
+			freeThreads[t].mpBlocks  = &threads[(t + 1) % kThreadCount].mBlocks;
+			freeThreads[t].mnPattern = (uint32_t)(((t + 1) % kThreadCount) + 1);
+			freeThreads[t].mThreadParams.mpName = "SizeClassFreeThread";
+			freeThreads[t].mThread.Begin(&freeThreads[t], NULL, &freeThreads[t].mThreadParams);
+		}
+
+		for(int t = 0; t < kThreadCount; t++)
+		{
+			freeThreads[t].mThread.WaitForEnd();
+			nErrorCount += freeThreads[t].mnErrorCount;
+		}
+
+		// The exited threads returned their caches, so running the same work again on new
+		// threads reuses the slabs rather than carving many more.
+		const size_t nSlabMemory = size_class_allocator::slab_memory();
+		nStartedCount = 0;
+
+		eastl::vector<SizeClassTestThread> threads2(kThreadCount);
+
+		for(int t = 0; t < kThreadCount; t++)
+		{
+			threads2[t].mpStartedCount = &nStartedCount;
+			threads2[t].mnThreadIndex  = t;
+			threads2[t].mnThreadCount  = kThreadCount;
+			threads2[t].mThreadParams.mpName = "SizeClassTestThread";
+			threads2[t].mThread.Begin(&threads2[t], NULL, &threads2[t].mThreadParams);
+		}
+
+		for(int t = 0; t < kThreadCount; t++)
+		{
+			threads2[t].mThread.WaitForEnd();
+			nErrorCount += threads2[t].mnErrorCount;
+		}
+
+		EATEST_VERIFY(size_class_allocator::slab_memory() <= (nSlabMemory + (kThreadCount * EASTL_SIZE_CLASS_SLAB_SIZE)));
+	}
+	#endif
+
+	return nErrorCount;
+}
+
+
+namespace
+{
+	struct StatsTraceCounts
+	{
+		int   mnAllocations;
+		int   mnFrees;
+		void* mpLast;
+	};
+
+	void StatsTraceFunction(const char*, void* p, size_t, bool bAllocate, void* pContext)
+	{
+		StatsTraceCounts* const pCounts = (StatsTraceCounts*)pContext;
+
+		(bAllocate ? pCounts->mnAllocations : pCounts->mnFrees)++;
+		pCounts->mpLast = p;
+	}
+
+	void StatsOutputFunction(const char* pLine, void* pContext)
+	{
+		eastl::vector<eastl::string>* const pLines = (eastl::vector<eastl::string>*)pContext;
+		pLines->push_back(pLine);
+	}
+
+	typedef eastl::stats_allocator<EASTLAllocatorType, true>  DetailedStatsAllocator;
+	typedef eastl::stats_allocator<EASTLAllocatorType, false> CheapStatsAllocator;
+}
+
+#if EASTL_THREAD_SUPPORT_AVAILABLE
+	namespace
+	{
+		// Allocates and frees through a stats_allocator shared by several threads.
+		struct StatsTestThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters mThreadParams;
+			EA::Thread::Thread           mThread;
+			CheapStatsAllocator*         mpAllocator;
+
+			StatsTestThread() : mThreadParams(), mThread(), mpAllocator(NULL) {}
+			StatsTestThread(const StatsTestThread&) = delete;
+			void operator=(const StatsTestThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				for(int i = 0; i < 10000; i++)
+					mpAllocator->deallocate(mpAllocator->allocate(16), 16);
+				return 0;
+			}
+		};
+	}
+#endif
+
+
+static int TestStatsAllocator()
+{
+	using namespace eastl;
+
+	int nErrorCount = 0;
+
+	{
+		// allocation_stats* GetAllocationStats(const char* pName);
+		char name[32];
+		EA::StdC::Strcpy(name, "TestStatsAllocator");
+
+		allocation_stats* const pStats = GetAllocationStats(name);
+		EATEST_VERIFY(pStats == GetAllocationStats("TestStatsAllocator"));
+		name[0] = 'X';
+		EATEST_VERIFY(EA::StdC::Strcmp(pStats->get_name(), "TestStatsAllocator") == 0);
+		EATEST_VERIFY(pStats != GetAllocationStats(name));
+		EATEST_VERIFY(GetAllocationStats(NULL) == GetAllocationStats(EASTL_STATS_ALLOCATOR_DEFAULT_NAME));
+
+		// static size_t histogram_index(size_t n);
+		EATEST_VERIFY(allocation_stats::histogram_index(1)  == 0);
+		EATEST_VERIFY(allocation_stats::histogram_index(8)  == 0);
+		EATEST_VERIFY(allocation_stats::histogram_index(9)  == 1);
+		EATEST_VERIFY(allocation_stats::histogram_index(16) == 1);
+		EATEST_VERIFY(allocation_stats::histogram_index(17) == 2);
+		EATEST_VERIFY(allocation_stats::histogram_index((size_t)1 << 40) == (allocation_stats::kHistogramSize - 1));
+	}
+
+	{
+		// Counts, bytes, peak and histogram.
+		DetailedStatsAllocator a(EASTL_NAME_VAL("TestStatsAllocator/detailed"));
+		allocation_stats_snapshot before, after;
+
+		a.get_stats().get_snapshot(before);
+		void* const p1 = a.allocate(100);
+		void* const p2 = a.allocate(8, 64, 0);
+		EATEST_VERIFY(EA::StdC::IsAligned(p2, 64));
+		a.get_stats().get_snapshot(after);
+
+		EATEST_VERIFY((after.mnAllocationCount - before.mnAllocationCount) == 2);
+		EATEST_VERIFY((after.current_bytes() - before.current_bytes()) == 108);
+		EATEST_VERIFY(after.mnPeakBytes >= (before.current_bytes() + 108));
+		EATEST_VERIFY((after.mnHistogram[allocation_stats::histogram_index(100)] - before.mnHistogram[allocation_stats::histogram_index(100)]) == 1);
+		EATEST_VERIFY((after.mnHistogram[0] - before.mnHistogram[0]) == 1);
+
+		a.deallocate(p1, 100);
+		a.deallocate(p2, 8);
+		a.get_stats().get_snapshot(after);
+
+		EATEST_VERIFY((after.mnDeallocationCount - before.mnDeallocationCount) == 2);
+		EATEST_VERIFY(after.current_bytes() == before.current_bytes());
+		EATEST_VERIFY(after.mnPeakBytes >= (before.current_bytes() + 108));
+
+		// Copies record into the same statistics.
+		DetailedStatsAllocator b(a);
+		EATEST_VERIFY(&b.get_stats() == &a.get_stats());
+		EATEST_VERIFY(a == b);
+	}
+
+	{
+		// The cheap mode, used by a container.
+		vector<int, CheapStatsAllocator> v(CheapStatsAllocator(EASTL_NAME_VAL("TestStatsAllocator/vector")));
+		const allocation_stats& stats = v.get_allocator().get_stats();
+		allocation_stats_snapshot before, after;
+
+		stats.get_snapshot(before);
+		v.resize(1000);
+		stats.get_snapshot(after);
+		EATEST_VERIFY((after.current_bytes() - before.current_bytes()) >= (1000 * sizeof(int)));
+		EATEST_VERIFY(after.mnAllocationCount > before.mnAllocationCount);
+
+		v.set_capacity(0);
+		stats.get_snapshot(after);
+		EATEST_VERIFY(after.current_bytes() == before.current_bytes());
+		EATEST_VERIFY(after.current_count() == before.current_count());
+	}
+
+	{
+		// void SetAllocationTraceFunction(AllocationTraceFunction pTraceFunction, void* pContext);
+		StatsTraceCounts counts = { 0, 0, NULL };
+		DetailedStatsAllocator detailed;
+		CheapStatsAllocator    cheap;
+
+		SetAllocationTraceFunction(StatsTraceFunction, &counts);
+
+		void* const p = detailed.allocate(32);
+		EATEST_VERIFY((counts.mnAllocations == 1) && (counts.mpLast == p));
+		detailed.deallocate(p, 32);
+		EATEST_VERIFY((counts.mnFrees == 1) && (counts.mpLast == p));
+
+		cheap.deallocate(cheap.allocate(32), 32); // The cheap mode doesn't trace.
+		EATEST_VERIFY((counts.mnAllocations == 1) && (counts.mnFrees == 1));
+
+		SetAllocationTraceFunction(NULL, NULL);
+		detailed.deallocate(detailed.allocate(32), 32);
+		EATEST_VERIFY((counts.mnAllocations == 1) && (counts.mnFrees == 1));
+	}
+
+	{
+		// size_t GetAllocationStatsSnapshots(allocation_stats_snapshot* pSnapshotArray, size_t nArrayCapacity);
+		// void   DumpAllocationStats(AllocationStatsOutputFunction pOutputFunction, void* pContext);
+		const size_t nCount = GetAllocationStatsSnapshots(NULL, 0);
+		EATEST_VERIFY(nCount >= 3);
+
+		vector<allocation_stats_snapshot> snapshots(nCount);
+		EATEST_VERIFY(GetAllocationStatsSnapshots(snapshots.data(), snapshots.size()) == nCount);
+		EATEST_VERIFY(EA::StdC::Strcmp(snapshots.back().mpName, "(other)") == 0);
+
+		vector<string> lines;
+		DumpAllocationStats(StatsOutputFunction, &lines);
+		EATEST_VERIFY(lines.size() >= 2);
+
+		#if EASTL_NAME_ENABLED
+			bool bFound = false;
+			for(size_t i = 0; i < lines.size(); i++)
+				bFound = bFound || (lines[i].find("TestStatsAllocator/detailed") != string::npos);
+			EATEST_VERIFY(bFound);
+		#endif
+	}
+
+	#if EASTL_THREAD_SUPPORT_AVAILABLE
+	{
+		// Several threads recording into the same statistics.
+		const int kThreadCount = 8;
+		CheapStatsAllocator allocator(EASTL_NAME_VAL("TestStatsAllocator/threads"));
+		allocation_stats_snapshot before, after;
+
+		allocator.get_stats().get_snapshot(before);
+
+		eastl::vector<StatsTestThread> threads(kThreadCount);
+
+		for(int t = 0; t < kThreadCount; t++)
+		{
+			threads[t].mpAllocator = &allocator;
+			threads[t].mThreadParams.mpName = "StatsTestThread";
+			threads[t].mThread.Begin(&threads[t], NULL, &threads[t].mThreadParams);
+		}
+
+		for(int t = 0; t < kThreadCount; t++)
+			threads[t].mThread.WaitForEnd();
+
+		allocator.get_stats().get_snapshot(after);
+		EATEST_VERIFY((after.mnAllocationCount - before.mnAllocationCount) == (uint64_t)(kThreadCount * 10000));
+		EATEST_VERIFY((after.mnDeallocationCount - before.mnDeallocationCount) == (uint64_t)(kThreadCount * 10000));
+		EATEST_VERIFY(after.current_bytes() == before.current_bytes());
+	}
+	#endif
+
+	return nErrorCount;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // TestAllocator
 //
@@ -286,6 +913,9 @@ int TestAllocator()
 	int nErrorCount = 0;
 	
 	nErrorCount += TestAllocationOffsetAndAlignment();
+	nErrorCount += TestArenaAllocator();
+	nErrorCount += TestSizeClassAllocator();
+	nErrorCount += TestStatsAllocator();
 	nErrorCount += TestFixedAllocator();
 	nErrorCount += TestSwapAllocator();
 
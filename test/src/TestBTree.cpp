@@ -0,0 +1,461 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "TestMap.h"
+#include "TestSet.h"
+#include "EASTLTest.h"
+#include <EASTL/btree_map.h>
+#include <EASTL/btree_set.h>
+#include <EASTL/map.h>
+#include <EASTL/set.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+	#include <map>
+	#include <set>
+#endif
+EA_RESTORE_ALL_VC_WARNINGS()
+
+using namespace eastl;
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::btree_map<int, int>;
+template class eastl::btree_multimap<int, int>;
+template class eastl::btree_set<int>;
+template class eastl::btree_multiset<int>;
+template class eastl::btree_map<TestObject, TestObject>;
+template class eastl::btree_multimap<TestObject, TestObject>;
+template class eastl::btree_set<TestObject>;
+template class eastl::btree_multiset<TestObject>;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// typedefs
+//
+typedef eastl::btree_map<int, int> VBM1;
+typedef eastl::btree_map<TestObject, TestObject> VBM4;
+typedef eastl::btree_multimap<int, int> VBMM1;
+typedef eastl::btree_multimap<TestObject, TestObject> VBMM4;
+typedef eastl::btree_set<int> VBS1;
+typedef eastl::btree_set<TestObject> VBS4;
+typedef eastl::btree_multiset<int> VBMS1;
+typedef eastl::btree_multiset<TestObject> VBMS4;
+
+// Small nodes make for deep trees even with few elements, which exercises splitting,
+// merging and rebalancing of internal nodes. This gives three values per node.
+typedef eastl::btree_map<int, int, eastl::less<int>, EASTLAllocatorType, 1> VBM1Small;
+typedef eastl::btree_multimap<int, int, eastl::less<int>, EASTLAllocatorType, 1> VBMM1Small;
+typedef eastl::btree_multiset<TestObject, eastl::less<TestObject>, EASTLAllocatorType, 1> VBMS4Small;
+
+namespace
+{
+	// A value whose copy throws if it was made with bThrowOnCopy, and which counts the live values.
+	// Moves never throw, so that the tree can move values between nodes.
+	struct BTreeThrowingValue
+	{
+		int  mX;
+		bool mbThrowOnCopy;
+
+		static int sLiveCount;
+
+		BTreeThrowingValue(int x, bool bThrowOnCopy = false) : mX(x), mbThrowOnCopy(bThrowOnCopy) { ++sLiveCount; }
+		BTreeThrowingValue(BTreeThrowingValue&& x) EA_NOEXCEPT : mX(x.mX), mbThrowOnCopy(x.mbThrowOnCopy) { ++sLiveCount; }
+		BTreeThrowingValue(const BTreeThrowingValue& x) : mX(x.mX), mbThrowOnCopy(x.mbThrowOnCopy)
+		{
+			#if EASTL_EXCEPTIONS_ENABLED
+				if(mbThrowOnCopy)
+					throw "Disallowed BTreeThrowingValue copy";
+			#endif
+			++sLiveCount;
+		}
+	   ~BTreeThrowingValue() { --sLiveCount; }
+
+		BTreeThrowingValue& operator=(const BTreeThrowingValue&) = default;
+
+		bool operator<(const BTreeThrowingValue& x) const
+			{ return mX < x.mX; }
+	};
+
+	int BTreeThrowingValue::sLiveCount = 0;
+
+	typedef eastl::btree_set<BTreeThrowingValue, eastl::less<BTreeThrowingValue>, EASTLAllocatorType, 1> VBSThrowingSmall;
+}
+
+#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+	typedef std::map<int, int> VM3;
+	typedef std::map<TestObject, TestObject> VM6;
+	typedef std::multimap<int, int> VMM3;
+	typedef std::multimap<TestObject, TestObject> VMM6;
+	typedef std::set<int> VS3;
+	typedef std::set<TestObject> VS6;
+	typedef std::multiset<int> VMS3;
+	typedef std::multiset<TestObject> VMS6;
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+// Does random inserts and erases on a btree container and on the equivalent rbtree
+// container, and verifies that they match each other throughout.
+template <typename BTree, typename RBTree>
+static int TestBTreeRandomAgainstRBTree(int nKeyLimit, int nOperationCount)
+{
+	int nErrorCount = 0;
+
+	BTree          bt;
+	RBTree         rbt;
+	EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+	for(int i = 0; i < nOperationCount; i++)
+	{
+		const int k = (int)rng.RandLimit((uint32_t)nKeyLimit);
+		const int v = (int)rng.RandLimit(1000);
+
+		switch(rng.RandLimit(6))
+		{
+			case 0:
+			case 1:
+			{
+				bt.insert(typename BTree::value_type(k, v));
+				rbt.insert(typename RBTree::value_type(k, v));
+				break;
+			}
+
+			case 2:
+			{
+				// Insert with a hint which is right half the time. rbtree's multimap inserts after
+				// a hint while btree inserts as close before it as it can, as the standard says,
+				// so we use hints which give the same result as an insert without a hint.
+				typename BTree::iterator itHint = rng.RandLimit(2) ? bt.upper_bound(k) : bt.end();
+				const typename BTree::iterator it = bt.insert(itHint, typename BTree::value_type(k, v));
+				EATEST_VERIFY(it->first == k);
+				rbt.insert(typename RBTree::value_type(k, v));
+				break;
+			}
+
+			case 3:
+			{
+				EATEST_VERIFY(bt.erase(k) == rbt.erase(k));
+				break;
+			}
+
+			case 4:
+			{
+				// Erase a key's first element, and verify that the returned iterator refers to the next one.
+				typename BTree::iterator  it   = bt.lower_bound(k);
+				typename RBTree::iterator itRB = rbt.lower_bound(k);
+
+				EATEST_VERIFY((it == bt.end()) == (itRB == rbt.end()));
+
+				if(it != bt.end())
+				{
+					it   = bt.erase(it);
+					itRB = rbt.erase(itRB);
+
+					EATEST_VERIFY((it == bt.end()) == (itRB == rbt.end()));
+					if(it != bt.end())
+						EATEST_VERIFY(*it == *itRB);
+				}
+				break;
+			}
+
+			default:
+			{
+				EATEST_VERIFY(bt.count(k) == rbt.count(k));
+				EATEST_VERIFY(bt.contains(k) == (rbt.find(k) != rbt.end()));
+
+				const typename BTree::iterator  itU   = bt.upper_bound(k);
+				const typename RBTree::iterator itURB = rbt.upper_bound(k);
+				EATEST_VERIFY((itU == bt.end()) ? (itURB == rbt.end()) : (*itU == *itURB));
+				break;
+			}
+		}
+
+		EATEST_VERIFY(bt.size() == rbt.size());
+
+		if((i % 256) == 0)
+		{
+			EATEST_VERIFY(bt.validate());
+			EATEST_VERIFY(eastl::equal(bt.begin(), bt.end(), rbt.begin()));
+			EATEST_VERIFY(eastl::equal(bt.rbegin(), bt.rend(), rbt.rbegin()));
+		}
+	}
+
+	EATEST_VERIFY(bt.validate());
+	EATEST_VERIFY(eastl::equal(bt.begin(), bt.end(), rbt.begin()));
+
+	// Erase everything from the front, then from the back, checking the tree as it shrinks.
+	while(!bt.empty())
+	{
+		typename BTree::iterator it = bt.erase(bt.begin());
+		EATEST_VERIFY(it == bt.begin());
+
+		if(!bt.empty())
+			bt.erase(--bt.end());
+
+		if((bt.size() % 64) == 0)
+			EATEST_VERIFY(bt.validate());
+	}
+
+	EATEST_VERIFY(bt.validate());
+	EATEST_VERIFY(bt.begin() == bt.end());
+	EATEST_VERIFY(bt.node_count() == 0);
+
+	return nErrorCount;
+}
+
+
+int TestBTree()
+{
+	int nErrorCount = 0;
+
+	#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+		{   // Test construction
+			nErrorCount += TestMapConstruction<VBM1, VM3, false>();
+			nErrorCount += TestMapConstruction<VBM4, VM6, false>();
+			nErrorCount += TestMapConstruction<VBMM1, VMM3, true>();
+			nErrorCount += TestMapConstruction<VBMM4, VMM6, true>();
+
+			nErrorCount += TestSetConstruction<VBS1, VS3, false>();
+			nErrorCount += TestSetConstruction<VBS4, VS6, false>();
+			nErrorCount += TestSetConstruction<VBMS1, VMS3, true>();
+			nErrorCount += TestSetConstruction<VBMS4, VMS6, true>();
+		}
+
+
+		{   // Test mutating functionality.
+			nErrorCount += TestMapMutation<VBM1, VM3, false>();
+			nErrorCount += TestMapMutation<VBM4, VM6, false>();
+			nErrorCount += TestMapMutation<VBMM1, VMM3, true>();
+			nErrorCount += TestMapMutation<VBMM4, VMM6, true>();
+
+			nErrorCount += TestSetMutation<VBS1, VS3, false>();
+			nErrorCount += TestSetMutation<VBS4, VS6, false>();
+			nErrorCount += TestSetMutation<VBMS1, VMS3, true>();
+			nErrorCount += TestSetMutation<VBMS4, VMS6, true>();
+		}
+	#endif // EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+
+
+	{   // Test searching functionality.
+		nErrorCount += TestMapSearch<VBM1, false>();
+		nErrorCount += TestMapSearch<VBM4, false>();
+		nErrorCount += TestMapSearch<VBMM1, true>();
+		nErrorCount += TestMapSearch<VBMM4, true>();
+
+		nErrorCount += TestSetSearch<VBS1, false>();
+		nErrorCount += TestSetSearch<VBS4, false>();
+		nErrorCount += TestSetSearch<VBMS1, true>();
+		nErrorCount += TestSetSearch<VBMS4, true>();
+	}
+
+
+	{
+		// C++11 emplace and related functionality
+		nErrorCount += TestMapCpp11<eastl::btree_map<int, TestObject>>();
+		nErrorCount += TestMultimapCpp11<eastl::btree_multimap<int, TestObject>>();
+
+		nErrorCount += TestSetCpp11<eastl::btree_set<TestObject>>();
+		nErrorCount += TestMultisetCpp11<eastl::btree_multiset<TestObject>>();
+	}
+
+	{
+		// C++17 try_emplace and related functionality
+		nErrorCount += TestMapCpp17<eastl::btree_map<int, TestObject>>();
+	}
+
+	{
+		// Tests for element access: operator[] and at()
+		nErrorCount += TestMapAccess<VBM1>();
+		nErrorCount += TestMapAccess<VBM4>();
+	}
+
+
+	{   // Test random use against map and multimap, with small nodes so that the trees are deep.
+		nErrorCount += TestBTreeRandomAgainstRBTree<VBM1Small,  eastl::map<int, int>>(2000, 20000);
+		nErrorCount += TestBTreeRandomAgainstRBTree<VBMM1Small, eastl::multimap<int, int>>(500, 20000);
+
+		// And with the default node size, where a node holds 30 pairs of ints.
+		nErrorCount += TestBTreeRandomAgainstRBTree<VBM1,  eastl::map<int, int>>(20000, 100000);
+		nErrorCount += TestBTreeRandomAgainstRBTree<VBMM1, eastl::multimap<int, int>>(5000, 100000);
+	}
+
+
+	{   // Test that every value is destroyed once, through splits, merges, rebalancing, copies and moves.
+		TestObject::Reset();
+
+		{
+			VBMS4Small     bt;
+			EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+			for(int i = 0; i < 2000; i++)
+				bt.insert(TestObject((int)rng.RandLimit(300)));
+
+			EATEST_VERIFY(bt.validate() && (bt.size() == 2000));
+
+			VBMS4Small btCopy(bt);
+			EATEST_VERIFY(btCopy.validate() && (btCopy == bt));
+
+			for(int i = 0; i < 300; i += 2)
+				bt.erase(TestObject(i));
+
+			EATEST_VERIFY(bt.validate());
+
+			VBMS4Small btMoved(eastl::move(btCopy));
+			EATEST_VERIFY(btMoved.validate() && btCopy.empty());
+
+			btCopy = bt;
+			EATEST_VERIFY(btCopy.validate() && (btCopy == bt) && (btCopy != btMoved));
+
+			swap(btCopy, btMoved);
+			EATEST_VERIFY(btCopy.validate() && btMoved.validate() && (btMoved == bt));
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+
+	#if EASTL_EXCEPTIONS_ENABLED
+		{   // Test that a copy which throws while it is appended to a full leaf leaves a valid tree.
+			for(int nCount = 1; nCount <= 40; nCount++)
+			{
+				{
+					VBSThrowingSmall bt;
+					for(int i = 0; i < nCount; i++)
+						bt.emplace_hint(bt.end(), i);
+
+					const BTreeThrowingValue valueThrowing(nCount, true);
+					bool bThrew = false;
+
+					try { bt.insert(bt.end(), valueThrowing); } catch(...) { bThrew = true; }
+
+					EATEST_VERIFY(bThrew);
+					EATEST_VERIFY(bt.validate() && (bt.size() == (eastl_size_t)nCount));
+					EATEST_VERIFY(BTreeThrowingValue::sLiveCount == (nCount + 1));
+
+					// The same from range insertion, whose values are appended in order.
+					eastl::vector<BTreeThrowingValue> values;
+					values.reserve(3);
+					for(int i = 0; i < 3; i++)
+						values.emplace_back(nCount + i, i == 2);
+
+					bThrew = false;
+					try { bt.insert(values.begin(), values.end()); } catch(...) { bThrew = true; }
+
+					EATEST_VERIFY(bThrew);
+					EATEST_VERIFY(bt.validate() && (bt.size() == (eastl_size_t)(nCount + 2)));
+
+					bt.emplace(nCount + 2, true); // The source tree for assignment, whose last value throws when copied.
+
+					VBSThrowingSmall btCopy;
+					bThrew = false;
+					try { btCopy = bt; } catch(...) { bThrew = true; }
+
+					EATEST_VERIFY(bThrew);
+					EATEST_VERIFY(btCopy.validate() && (btCopy.size() == (eastl_size_t)(nCount + 2)));
+
+					int i = 0;
+					for(VBSThrowingSmall::const_iterator it = btCopy.begin(); it != btCopy.end(); ++it, ++i)
+						EATEST_VERIFY(it->mX == i);
+				}
+
+				EATEST_VERIFY(BTreeThrowingValue::sLiveCount == 0);
+			}
+		}
+	#endif
+
+
+	{   // Test that a copied tree is packed, with nodes nearly full.
+		VBM1 bt;
+
+		for(int i = 0; i < 10000; i++)
+			bt.emplace(i * 7 % 10000, i * 7 % 10000);
+
+		const VBM1 btCopy(bt);
+		EATEST_VERIFY(btCopy.validate() && (btCopy == bt));
+		EATEST_VERIFY(btCopy.node_count() <= ((btCopy.size() / (VBM1::kNodeValues - 1)) * 11 / 10));
+		EATEST_VERIFY(btCopy.node_count() <= bt.node_count());
+
+		// Sorted insertion also packs nodes.
+		VBM1 btSorted;
+		for(int i = 0; i < 10000; i++)
+			btSorted.emplace_hint(btSorted.end(), i, i);
+
+		EATEST_VERIFY(btSorted.validate() && (btSorted == bt));
+		EATEST_VERIFY(btSorted.node_count() <= ((btSorted.size() / (VBM1::kNodeValues - 1)) * 11 / 10));
+	}
+
+
+	{   // Test iterator walks across node boundaries in both directions.
+		VBM1Small bt;
+
+		for(int i = 0; i < 1000; i++)
+			bt[i] = i * 2;
+
+		int i = 0;
+		for(VBM1Small::const_iterator it = bt.cbegin(); it != bt.cend(); ++it, ++i)
+			EATEST_VERIFY((it->first == i) && (it->second == i * 2));
+		EATEST_VERIFY(i == 1000);
+
+		for(VBM1Small::reverse_iterator it = bt.rbegin(); it != bt.rend(); ++it)
+			EATEST_VERIFY(it->first == --i);
+		EATEST_VERIFY(i == 0);
+
+		VBM1Small::iterator it = bt.end();
+		for(i = 999; i >= 0; i--)
+			EATEST_VERIFY((--it)->first == i);
+		EATEST_VERIFY(it == bt.begin());
+
+		EATEST_VERIFY(bt.validate_iterator(bt.find(500)) == (isf_valid | isf_current | isf_can_dereference));
+		EATEST_VERIFY(bt.validate_iterator(bt.end()) == (isf_valid | isf_current));
+
+		// Erasing a range which spans many nodes.
+		VBM1Small::iterator itErase = bt.erase(bt.find(100), bt.find(900));
+		EATEST_VERIFY((itErase->first == 900) && (bt.size() == 200) && bt.validate());
+	}
+
+
+	{   // Test that a multimap inserts as close before the hint as it can.
+		VBMM1Small mm = {{1, 0}, {1, 1}, {2, 0}};
+
+		VBMM1Small::iterator it = mm.insert(mm.begin(), VBMM1Small::value_type(1, 2));
+		EATEST_VERIFY((it == mm.begin()) && (it->second == 2));
+
+		it = mm.insert(mm.find(2), VBMM1Small::value_type(1, 3));
+		EATEST_VERIFY((it->second == 3) && ((++it)->first == 2));
+
+		it = mm.insert(mm.end(), VBMM1Small::value_type(1, 4)); // The hint is wrong, so this goes after the other 1s.
+		EATEST_VERIFY((it->second == 4) && ((++it)->first == 2));
+
+		const eastl::pair<VBMM1Small::iterator, VBMM1Small::iterator> range = mm.equal_range_small(1);
+		EATEST_VERIFY((eastl::distance(range.first, range.second) == 5) && (range.second->first == 2));
+		EATEST_VERIFY(mm.validate());
+	}
+
+
+	{   // Test find_as and erase_if
+		eastl::btree_set<eastl::string> strings = { "one", "two", "three", "four" };
+
+		EATEST_VERIFY(strings.find_as("two", eastl::less<>()) != strings.end());
+		EATEST_VERIFY(strings.find_as("five", eastl::less<>()) == strings.end());
+
+		eastl::btree_map<int, int> m = {{0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4}};
+		auto numErased = eastl::erase_if(m, [](auto p) { return p.first % 2 == 0; });
+		VERIFY((m == eastl::btree_map<int, int>{{1, 1},{3, 3}}));
+		VERIFY(numErased == 3);
+
+		eastl::btree_multiset<int> ms = {0, 0, 0, 1, 1, 2, 3, 4, 4, 4};
+		numErased = eastl::erase_if(ms, [](int i) { return i % 2 == 0; });
+		VERIFY((ms == eastl::btree_multiset<int>{1, 1, 3}));
+		VERIFY(numErased == 7);
+	}
+
+	return nErrorCount;
+}
@@ -0,0 +1,455 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/charconv.h>
+#include <EASTL/string.h>
+#include <EASTL/numeric_limits.h>
+#include <EAStdC/EASprintf.h>
+#include <locale.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+using namespace eastl;
+
+
+namespace
+{
+	template <typename T>
+	bool ToCharsEquals(T value, const char* pExpected, int base = 10)
+	{
+		char buffer[128];
+		const to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value, base);
+
+		return (result.ec == errc()) && ((size_t)(result.ptr - buffer) == strlen(pExpected)) && (memcmp(buffer, pExpected, strlen(pExpected)) == 0);
+	}
+
+	template <typename T>
+	bool FloatToCharsEquals(T value, const char* pExpected)
+	{
+		char buffer[512];
+		const to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value);
+
+		return (result.ec == errc()) && ((size_t)(result.ptr - buffer) == strlen(pExpected)) && (memcmp(buffer, pExpected, strlen(pExpected)) == 0);
+	}
+
+	template <typename T>
+	bool FloatToCharsEquals(T value, chars_format fmt, const char* pExpected)
+	{
+		char buffer[512];
+		const to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value, fmt);
+
+		return (result.ec == errc()) && ((size_t)(result.ptr - buffer) == strlen(pExpected)) && (memcmp(buffer, pExpected, strlen(pExpected)) == 0);
+	}
+
+	template <typename T>
+	bool FloatToCharsEquals(T value, chars_format fmt, int precision, const char* pExpected)
+	{
+		char buffer[512];
+		const to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value, fmt, precision);
+
+		return (result.ec == errc()) && ((size_t)(result.ptr - buffer) == strlen(pExpected)) && (memcmp(buffer, pExpected, strlen(pExpected)) == 0);
+	}
+
+	// Returns true if the value round trips through to_chars and from_chars, and the correctly
+	// rounded printf output with one digit fewer doesn't.
+	template <typename T>
+	bool FloatRoundTrips(T value)
+	{
+		char buffer[64];
+		const to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value, chars_format::scientific);
+
+		if(result.ec != errc())
+			return false;
+
+		T back = 0;
+		const from_chars_result parsed = from_chars(buffer, result.ptr, back);
+
+		if((parsed.ec != errc()) || (parsed.ptr != result.ptr) || (back != value))
+			return false;
+
+		int nDigits = 0;
+		for(const char* p = buffer; *p != 'e'; ++p)
+		{
+			if((*p >= '0') && (*p <= '9'))
+				nDigits++;
+		}
+
+		if(nDigits > 1)
+		{
+			// One digit fewer must not round trip.
+			char shorter[64];
+			const int nLength = EA::StdC::Snprintf(shorter, sizeof(shorter), "%.*e", nDigits - 2, (double)value);
+			from_chars(shorter, shorter + nLength, back);
+			if(back == value)
+				return false;
+		}
+
+		return true;
+	}
+}
+
+
+int TestCharConv()
+{
+	int nErrorCount = 0;
+
+	{
+		// to_chars_result to_chars(char* first, char* last, Integer value, int base = 10);
+		EATEST_VERIFY(ToCharsEquals(0, "0"));
+		EATEST_VERIFY(ToCharsEquals(7, "7"));
+		EATEST_VERIFY(ToCharsEquals(10, "10"));
+		EATEST_VERIFY(ToCharsEquals(-1, "-1"));
+		EATEST_VERIFY(ToCharsEquals(1234567890, "1234567890"));
+		EATEST_VERIFY(ToCharsEquals(UINT64_C(18446744073709551615), "18446744073709551615"));
+		EATEST_VERIFY(ToCharsEquals(INT64_C(-9223372036854775807) - 1, "-9223372036854775808"));
+		EATEST_VERIFY(ToCharsEquals((int8_t)-128, "-128"));
+		EATEST_VERIFY(ToCharsEquals((uint8_t)255, "255"));
+		EATEST_VERIFY(ToCharsEquals((int16_t)-32768, "-32768"));
+		EATEST_VERIFY(ToCharsEquals('A', "65"));
+
+		EATEST_VERIFY(ToCharsEquals(255, "ff", 16));
+		EATEST_VERIFY(ToCharsEquals(-255, "-ff", 16));
+		EATEST_VERIFY(ToCharsEquals(5, "101", 2));
+		EATEST_VERIFY(ToCharsEquals(35, "z", 36));
+		EATEST_VERIFY(ToCharsEquals(UINT64_C(0xFFFFFFFFFFFFFFFF), "1111111111111111111111111111111111111111111111111111111111111111", 2));
+
+		// Every power of ten and its neighbours, which are the digit count boundaries.
+		uint64_t nPow10 = 1;
+		for(int i = 0; i < 20; i++, nPow10 *= 10)
+		{
+			char expected[32];
+
+			EA::StdC::Snprintf(expected, sizeof(expected), "%llu", (unsigned long long)nPow10);
+			EATEST_VERIFY(ToCharsEquals(nPow10, expected));
+
+			EA::StdC::Snprintf(expected, sizeof(expected), "%llu", (unsigned long long)(nPow10 - 1));
+			EATEST_VERIFY(ToCharsEquals(nPow10 - 1, expected));
+
+			EA::StdC::Snprintf(expected, sizeof(expected), "%llu", (unsigned long long)(nPow10 + 1));
+			EATEST_VERIFY(ToCharsEquals(nPow10 + 1, expected));
+		}
+
+		// A too small range fails with value_too_large and last.
+		char buffer[8];
+		to_chars_result result = to_chars(buffer, buffer + 3, 1234);
+		EATEST_VERIFY((result.ec == errc::value_too_large) && (result.ptr == buffer + 3));
+
+		result = to_chars(buffer, buffer + 4, 1234);
+		EATEST_VERIFY((result.ec == errc()) && (result.ptr == buffer + 4) && (memcmp(buffer, "1234", 4) == 0));
+
+		result = to_chars(buffer, buffer, 0);
+		EATEST_VERIFY((result.ec == errc::value_too_large) && (result.ptr == buffer));
+	}
+
+	{
+		// from_chars_result from_chars(const char* first, const char* last, Integer& value, int base = 10);
+		const char* p = "12345xyz";
+		int n = 0;
+		from_chars_result result = from_chars(p, p + 8, n);
+		EATEST_VERIFY((result.ec == errc()) && (result.ptr == p + 5) && (n == 12345));
+
+		p = "-2147483648";
+		result = from_chars(p, p + strlen(p), n);
+		EATEST_VERIFY((result.ec == errc()) && (result.ptr == p + strlen(p)) && (n == INT32_MIN));
+
+		// Out of range values consume all the digits and leave the value unchanged.
+		n = 7;
+		p = "2147483648";
+		result = from_chars(p, p + strlen(p), n);
+		EATEST_VERIFY((result.ec == errc::result_out_of_range) && (result.ptr == p + strlen(p)) && (n == 7));
+
+		uint8_t u8 = 7;
+		p = "256";
+		result = from_chars(p, p + 3, u8);
+		EATEST_VERIFY((result.ec == errc::result_out_of_range) && (result.ptr == p + 3) && (u8 == 7));
+
+		uint64_t u64 = 0;
+		p = "18446744073709551615";
+		result = from_chars(p, p + strlen(p), u64);
+		EATEST_VERIFY((result.ec == errc()) && (u64 == UINT64_C(18446744073709551615)));
+
+		p = "18446744073709551616";
+		result = from_chars(p, p + strlen(p), u64);
+		EATEST_VERIFY(result.ec == errc::result_out_of_range);
+
+		// Unsigned types accept no sign, and no type accepts '+' or leading whitespace.
+		const char* const pInvalid[] = { "", "-", "+1", " 1", "x" };
+		for(const char* pText : pInvalid)
+		{
+			n = 7;
+			result = from_chars(pText, pText + strlen(pText), n);
+			EATEST_VERIFY((result.ec == errc::invalid_argument) && (result.ptr == pText) && (n == 7));
+		}
+
+		p = "-1";
+		result = from_chars(p, p + 2, u64);
+		EATEST_VERIFY((result.ec == errc::invalid_argument) && (result.ptr == p));
+
+		p = "fFz";
+		result = from_chars(p, p + 3, n, 16);
+		EATEST_VERIFY((result.ec == errc()) && (result.ptr == p + 2) && (n == 255));
+
+		p = "Zz";
+		result = from_chars(p, p + 2, n, 36);
+		EATEST_VERIFY((result.ec == errc()) && (n == (35 * 36) + 35));
+
+		// Round trips in every base.
+		for(int base = 2; base <= 36; base++)
+		{
+			const int64_t values[] = { 0, 1, -1, 1000000007, INT64_MAX, INT64_MIN };
+
+			for(int64_t value : values)
+			{
+				char buffer[80];
+				int64_t back = 0;
+				const to_chars_result written = to_chars(buffer, buffer + sizeof(buffer), value, base);
+				result = from_chars(buffer, written.ptr, back, base);
+				EATEST_VERIFY((result.ec == errc()) && (result.ptr == written.ptr) && (back == value));
+			}
+		}
+	}
+
+	{
+		// to_chars_result to_chars(char* first, char* last, double value);
+		EATEST_VERIFY(FloatToCharsEquals(0.0, "0"));
+		EATEST_VERIFY(FloatToCharsEquals(-0.0, "-0"));
+		EATEST_VERIFY(FloatToCharsEquals(1.0, "1"));
+		EATEST_VERIFY(FloatToCharsEquals(0.1, "0.1"));
+		EATEST_VERIFY(FloatToCharsEquals(0.3, "0.3"));
+		EATEST_VERIFY(FloatToCharsEquals(-1.5, "-1.5"));
+		EATEST_VERIFY(FloatToCharsEquals(123456.789, "123456.789"));
+		EATEST_VERIFY(FloatToCharsEquals(1e23, "1e+23"));
+		EATEST_VERIFY(FloatToCharsEquals(1e-7, "1e-07"));
+		EATEST_VERIFY(FloatToCharsEquals(5e-324, "5e-324"));
+		EATEST_VERIFY(FloatToCharsEquals(1.7976931348623157e308, "1.7976931348623157e+308"));
+		EATEST_VERIFY(FloatToCharsEquals(100.0, "100"));
+		EATEST_VERIFY(FloatToCharsEquals(1000000.0, "1e+06"));
+		EATEST_VERIFY(FloatToCharsEquals(numeric_limits<double>::infinity(), "inf"));
+		EATEST_VERIFY(FloatToCharsEquals(-numeric_limits<double>::infinity(), "-inf"));
+		EATEST_VERIFY(FloatToCharsEquals(numeric_limits<double>::quiet_NaN(), "nan"));
+
+		EATEST_VERIFY(FloatToCharsEquals(0.1f, "0.1"));
+		EATEST_VERIFY(FloatToCharsEquals(16777216.0f, "16777216"));
+		EATEST_VERIFY(FloatToCharsEquals(3.4028235e38f, "3.4028235e+38"));
+		EATEST_VERIFY(FloatToCharsEquals(1e-45f, "1e-45"));
+
+		// Values Grisu can't decide on its own.
+		EATEST_VERIFY(FloatToCharsEquals(3.53897996167164e-258, "3.53897996167164e-258"));
+		EATEST_VERIFY(FloatToCharsEquals(5.97173396460681e+242, "5.97173396460681e+242"));
+	}
+
+	{
+		// to_chars_result to_chars(char* first, char* last, double value, chars_format fmt);
+		EATEST_VERIFY(FloatToCharsEquals(1e23, chars_format::fixed, "99999999999999991611392"));
+		EATEST_VERIFY(FloatToCharsEquals(1e-7, chars_format::fixed, "0.0000001"));
+		EATEST_VERIFY(FloatToCharsEquals(1234.5, chars_format::scientific, "1.2345e+03"));
+		EATEST_VERIFY(FloatToCharsEquals(1234.5, chars_format::general, "1234.5"));
+		EATEST_VERIFY(FloatToCharsEquals(1e-5, chars_format::general, "1e-05"));
+		EATEST_VERIFY(FloatToCharsEquals(1e-4, chars_format::general, "0.0001"));
+		EATEST_VERIFY(FloatToCharsEquals(123456.0, chars_format::general, "123456"));
+		EATEST_VERIFY(FloatToCharsEquals(1234567.0, chars_format::general, "1.234567e+06"));
+		EATEST_VERIFY(FloatToCharsEquals(1e15, chars_format::general, "1e+15"));
+		EATEST_VERIFY(FloatToCharsEquals(1.0, chars_format::hex, "1p+0"));
+		EATEST_VERIFY(FloatToCharsEquals(-0.5, chars_format::hex, "-1p-1"));
+
+		// to_chars_result to_chars(char* first, char* last, double value, chars_format fmt, int precision);
+		EATEST_VERIFY(FloatToCharsEquals(3.14159, chars_format::fixed, 2, "3.14"));
+		EATEST_VERIFY(FloatToCharsEquals(3.14159, chars_format::scientific, 3, "3.142e+00"));
+		EATEST_VERIFY(FloatToCharsEquals(3.14159, chars_format::general, 3, "3.14"));
+		EATEST_VERIFY(FloatToCharsEquals(0.5, chars_format::fixed, 0, "0"));
+
+		{
+			// Output which exactly fills the range succeeds, however long it is.
+			char            bigBuffer[600];
+			to_chars_result result = to_chars(bigBuffer, bigBuffer + sizeof(bigBuffer), 1.0, chars_format::fixed, 598);
+			EATEST_VERIFY((result.ec == errc()) && (result.ptr == bigBuffer + sizeof(bigBuffer)));
+			EATEST_VERIFY((bigBuffer[0] == '1') && (bigBuffer[1] == '.') && (bigBuffer[sizeof(bigBuffer) - 1] == '0'));
+
+			result = to_chars(bigBuffer, bigBuffer + sizeof(bigBuffer) - 1, 1.0, chars_format::fixed, 598);
+			EATEST_VERIFY((result.ec == errc::value_too_large) && (result.ptr == bigBuffer + sizeof(bigBuffer) - 1));
+
+			result = to_chars(bigBuffer, bigBuffer + 4, 1.0, chars_format::hex);
+			EATEST_VERIFY((result.ec == errc()) && (result.ptr == bigBuffer + 4) && (memcmp(bigBuffer, "1p+0", 4) == 0));
+		}
+
+		{
+			// The decimal point is '.' whatever the C locale is.
+			const char* pLocale = setlocale(LC_NUMERIC, "de_DE.UTF-8");
+			if(!pLocale)
+				pLocale = setlocale(LC_NUMERIC, "de_DE");
+
+			if(pLocale)
+			{
+				EATEST_VERIFY(FloatToCharsEquals(1.5, chars_format::fixed, 2, "1.50"));
+				EATEST_VERIFY(FloatToCharsEquals(1.5, chars_format::scientific, 1, "1.5e+00"));
+				EATEST_VERIFY(FloatToCharsEquals(1.5, chars_format::hex, 1, "1.8p+0"));
+				setlocale(LC_NUMERIC, "C");
+			}
+		}
+
+		// A too small range fails with value_too_large and last, for every length.
+		char buffer[32];
+		const ptrdiff_t nLength = to_chars(buffer, buffer + sizeof(buffer), -0.125e-100).ptr - buffer;
+		EATEST_VERIFY(nLength == 10); // "-1.25e-101"
+		for(ptrdiff_t i = 0; i < nLength; i++)
+		{
+			const to_chars_result result = to_chars(buffer, buffer + i, -0.125e-100);
+			EATEST_VERIFY((result.ec == errc::value_too_large) && (result.ptr == buffer + i));
+		}
+	}
+
+	{
+		// Shortest round trip for a sweep of doubles and floats.
+		EA::UnitTest::Rand rng(EA::UnitTest::GetRandSeed());
+
+		for(int i = 0; i < 20000; i++)
+		{
+			uint64_t bits = ((uint64_t)rng.RandValue() << 32) | (uint64_t)rng.RandValue();
+			double   d;
+			memcpy(&d, &bits, sizeof(d));
+
+			if(isfinite(d))
+				EATEST_VERIFY(FloatRoundTrips(d));
+
+			const uint32_t bits32 = (uint32_t)bits;
+			float          f;
+			memcpy(&f, &bits32, sizeof(f));
+
+			if(isfinite(f))
+				EATEST_VERIFY(FloatRoundTrips(f));
+
+			EATEST_VERIFY(FloatRoundTrips((double)(rng.RandValue() % 100000) / 100.0));
+		}
+	}
+
+	{
+		// from_chars_result from_chars(const char* first, const char* last, double& value, chars_format fmt = chars_format::general);
+		double d = 0;
+		const char* p = "1.25e2xyz";
+		from_chars_result result = from_chars(p, p + strlen(p), d);
+		EATEST_VERIFY((result.ec == errc()) && (result.ptr == p + 6) && (d == 125.0));
+
+		p = "-0.000";
+		result = from_chars(p, p + strlen(p), d);
+		EATEST_VERIFY((result.ec == errc()) && (d == 0) && signbit(d));
+
+		p = ".5";
+		result = from_chars(p, p + 2, d);
+		EATEST_VERIFY((result.ec == errc()) && (d == 0.5));
+
+		// The exponent is only consumed when digits follow it.
+		p = "3e+";
+		result = from_chars(p, p + 3, d);
+		EATEST_VERIFY((result.ec == errc()) && (result.ptr == p + 1) && (d == 3.0));
+
+		p = "1e5";
+		result = from_chars(p, p + 3, d, chars_format::fixed);
+		EATEST_VERIFY((result.ec == errc()) && (result.ptr == p + 1) && (d == 1.0));
+
+		p = "15";
+		result = from_chars(p, p + 2, d, chars_format::scientific);
+		EATEST_VERIFY((result.ec == errc::invalid_argument) && (result.ptr == p));
+
+		p = "1.8p1";
+		result = from_chars(p, p + strlen(p), d, chars_format::hex);
+		EATEST_VERIFY((result.ec == errc()) && (d == 3.0));
+
+		p = "-InFiNiTy";
+		result = from_chars(p, p + strlen(p), d);
+		EATEST_VERIFY((result.ec == errc()) && (result.ptr == p + strlen(p)) && (d == -numeric_limits<double>::infinity()));
+
+		p = "nan(123)";
+		result = from_chars(p, p + strlen(p), d);
+		EATEST_VERIFY((result.ec == errc()) && (result.ptr == p + strlen(p)) && (d != d));
+
+		// Halfway cases which a naive parser rounds the wrong way.
+		p = "9007199254740993";
+		result = from_chars(p, p + strlen(p), d);
+		EATEST_VERIFY((result.ec == errc()) && (d == 9007199254740992.0));
+
+		p = "9007199254740993.0000000000000000000000000001";
+		result = from_chars(p, p + strlen(p), d);
+		EATEST_VERIFY((result.ec == errc()) && (d == 9007199254740994.0));
+
+		p = "2.4703282292062328e-324"; // Just above half of the smallest denormal.
+		result = from_chars(p, p + strlen(p), d);
+		EATEST_VERIFY((result.ec == errc()) && (d == 5e-324));
+
+		d = 7;
+		p = "1e400";
+		result = from_chars(p, p + strlen(p), d);
+		EATEST_VERIFY((result.ec == errc::result_out_of_range) && (result.ptr == p + strlen(p)) && (d == 7));
+
+		p = "1e-400";
+		result = from_chars(p, p + strlen(p), d);
+		EATEST_VERIFY((result.ec == errc::result_out_of_range) && (d == 7));
+
+		float f = 0;
+		p = "3.4028235e38";
+		result = from_chars(p, p + strlen(p), f);
+		EATEST_VERIFY((result.ec == errc()) && (f == 3.4028235e38f));
+
+		p = "3.5e38";
+		result = from_chars(p, p + strlen(p), f);
+		EATEST_VERIFY(result.ec == errc::result_out_of_range);
+
+		const char* const pInvalid[] = { "", "-", ".", "e5", "+1", " 1", "in" };
+		for(const char* pText : pInvalid)
+		{
+			d = 7;
+			result = from_chars(pText, pText + strlen(pText), d);
+			EATEST_VERIFY((result.ec == errc::invalid_argument) && (result.ptr == pText) && (d == 7));
+		}
+	}
+
+	{
+		// basic_string& append_integer(Integer value, int base = 10);
+		// basic_string& append_float(Float value);
+		// basic_string& append_float(Float value, chars_format fmt);
+		// basic_string& append_float(Float value, chars_format fmt, int precision);
+		string s("x=");
+		s.append_integer(-42).append(",").append_integer(255u, 16).append(",").append_float(0.1).append(",").append_float(2.5f, chars_format::scientific).append(",").append_float(3.14159, chars_format::fixed, 3);
+		EATEST_VERIFY(s == "x=-42,ff,0.1,2.5e+00,3.142");
+		EATEST_VERIFY(s.validate());
+
+		// Output longer than the initial estimate is retried with more room.
+		string sFixed;
+		sFixed.append_float(1e300, chars_format::fixed);
+		EATEST_VERIFY((sFixed.size() == 301) && (sFixed[0] == '1') && sFixed.validate());
+
+		string sPrecise;
+		sPrecise.append_float(1.0, chars_format::fixed, 1000);
+		EATEST_VERIFY((sPrecise.size() == 1002) && (sPrecise.back() == '0') && sPrecise.validate());
+
+		// Wider character types.
+		u16string s16;
+		s16.append_integer(INT64_MIN).append_float(-1.5);
+		EATEST_VERIFY(s16 == u"-9223372036854775808-1.5");
+		EATEST_VERIFY(s16.validate());
+
+		u32string s32;
+		for(int i = 0; i < 100; i++)
+			s32.append_integer(i % 10);
+		EATEST_VERIFY((s32.size() == 100) && (s32[99] == U'9') && (s32.c_str()[100] == 0));
+
+		wstring sw;
+		sw.append_float(1e23, chars_format::fixed);
+		EATEST_VERIFY(sw == L"99999999999999991611392");
+
+		// Matches append_sprintf.
+		string sPrintf, sConv;
+		for(int i = -1000; i < 1000; i += 7)
+		{
+			sPrintf.append_sprintf("%d %.3f ", i * 12345, i / 8.0);
+			sConv.append_integer(i * 12345).append(" ").append_float(i / 8.0, chars_format::fixed, 3).append(" ");
+		}
+		EATEST_VERIFY(sPrintf == sConv);
+	}
+
+	return nErrorCount;
+}
@@ -0,0 +1,269 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/concurrent_hash_map.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/string.h>
+#include <eathread/eathread_thread.h>
+#include <atomic>
+
+
+using namespace eastl;
+
+
+// Explicit Template instantiations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::concurrent_hash_map<int, int>;
+template class eastl::concurrent_hash_map<eastl::string, TestObject, eastl::hash<eastl::string>, eastl::equal_to<eastl::string>, EASTLAllocatorType, 4>;
+
+
+#if EASTL_THREAD_SUPPORT_AVAILABLE
+	namespace
+	{
+		typedef concurrent_hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, 8> ThreadTestMap;
+
+		const int kThreadKeyCount = 20000;
+		const int kCounterKey     = -1;
+
+		// Each thread inserts, updates and erases its own range of keys, reads the ranges of
+		// the other threads, and increments a counter which is shared by all threads.
+		struct ConcurrentHashMapTestThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters mThreadParams;
+			EA::Thread::Thread           mThread;
+			ThreadTestMap*               mpMap;
+			std::atomic<int>*            mpStartedCount;
+			int                          mnThreadIndex;
+			int                          mnThreadCount;
+			int                          mnErrorCount;
+
+			ConcurrentHashMapTestThread() : mThreadParams(), mThread(), mpMap(NULL), mpStartedCount(NULL), mnThreadIndex(0), mnThreadCount(0), mnErrorCount(0) {}
+			ConcurrentHashMapTestThread(const ConcurrentHashMapTestThread&) = delete;
+			void operator=(const ConcurrentHashMapTestThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				int& nErrorCount = mnErrorCount; // declare nErrorCount so that EATEST_VERIFY can work, as it depends on it being declared.
+				const int nBegin = mnThreadIndex * kThreadKeyCount;
+
+				// Wait for all threads to start, so that they really do run at the same time.
+				mpStartedCount->fetch_add(1);
+				while(mpStartedCount->load() < mnThreadCount)
+					EA::Thread::ThreadSleep(0);
+
+				for(int i = 0; i < kThreadKeyCount; i++)
+				{
+					const int k = nBegin + i;
+
+					EATEST_VERIFY(mpMap->insert(eastl::make_pair(k, k)));
+					EATEST_VERIFY(!mpMap->insert_or_assign(k, k * 2));
+					EATEST_VERIFY(mpMap->visit(kCounterKey, [](eastl::pair<const int, int>& v) { ++v.second; }));
+
+					// Read a key of another thread. It may or may not have been inserted yet,
+					// but if it has then its value is one of the two that its owner writes.
+					int value = 0;
+					const int kOther = (((mnThreadIndex + 1) % mnThreadCount) * kThreadKeyCount) + i;
+
+					if(mpMap->find(kOther, value))
+						EATEST_VERIFY((value == kOther) || (value == kOther * 2) || (value == -kOther));
+
+					// Erase every fourth key, and mark every other fourth key by negating it.
+					if((i % 4) == 0)
+						EATEST_VERIFY(mpMap->erase(k) == 1);
+					else if((i % 4) == 1)
+						EATEST_VERIFY(mpMap->visit(k, [](eastl::pair<const int, int>& v) { v.second = -v.first; }));
+				}
+
+				return nErrorCount;
+			}
+		};
+	}
+#endif
+
+
+int TestConcurrentHashMap()
+{
+	int nErrorCount = 0;
+
+	{  // Test rw_spinlock
+		Internal::rw_spinlock lock;
+
+		EATEST_VERIFY(lock.try_lock_shared());
+		EATEST_VERIFY(lock.try_lock_shared());
+		EATEST_VERIFY(!lock.try_lock());
+		lock.unlock_shared();
+		EATEST_VERIFY(!lock.try_lock());
+		lock.unlock_shared();
+
+		EATEST_VERIFY(lock.try_lock());
+		EATEST_VERIFY(!lock.try_lock_shared());
+		EATEST_VERIFY(!lock.try_lock());
+		lock.unlock();
+
+		{
+			Internal::auto_rw_spinlock_shared sharedLock(lock);
+			EATEST_VERIFY(!lock.try_lock());
+		}
+		{
+			Internal::auto_rw_spinlock writeLock(lock);
+			EATEST_VERIFY(!lock.try_lock_shared());
+		}
+
+		EATEST_VERIFY(lock.try_lock());
+		lock.unlock();
+	}
+
+
+	{  // Test single threaded use against hash_map as a reference
+		concurrent_hash_map<int, int> cmap;
+		hash_map<int, int>            refMap;
+		EASTLTest_Rand                rng(EA::UnitTest::GetRandSeed());
+
+		EATEST_VERIFY(cmap.empty() && (cmap.size() == 0));
+		EATEST_VERIFY(cmap.validate());
+
+		for(int i = 0; i < 20000; i++)
+		{
+			const int k = (int)rng.RandLimit(5000);
+			const int v = (int)rng.RandLimit(1000);
+
+			switch(rng.RandLimit(4))
+			{
+				case 0:
+					EATEST_VERIFY(cmap.insert(eastl::make_pair(k, v)) == refMap.insert(eastl::make_pair(k, v)).second);
+					break;
+
+				case 1:
+					EATEST_VERIFY(cmap.insert_or_assign(k, v) == refMap.insert_or_assign(k, v).second);
+					break;
+
+				case 2:
+					EATEST_VERIFY(cmap.erase(k) == refMap.erase(k));
+					break;
+
+				default:
+				{
+					int value = -1;
+					const bool bFound = cmap.find(k, value);
+					hash_map<int, int>::iterator it = refMap.find(k);
+
+					EATEST_VERIFY(bFound == (it != refMap.end()));
+					EATEST_VERIFY(bFound ? (value == it->second) : (value == -1));
+					EATEST_VERIFY(cmap.contains(k) == bFound);
+					break;
+				}
+			}
+		}
+
+		EATEST_VERIFY(cmap.validate());
+		EATEST_VERIFY(cmap.size() == refMap.size());
+
+		// visit_all sees every element once.
+		eastl_size_t nVisitCount = 0;
+		cmap.cvisit_all([&](const eastl::pair<const int, int>& v)
+		{
+			++nVisitCount;
+			EATEST_VERIFY(refMap[v.first] == v.second);
+		});
+		EATEST_VERIFY(nVisitCount == refMap.size());
+
+		cmap.visit_all([](eastl::pair<const int, int>& v) { v.second = v.first; });
+
+		for(hash_map<int, int>::iterator it = refMap.begin(); it != refMap.end(); ++it)
+		{
+			EATEST_VERIFY(cmap.cvisit(it->first, [&](const eastl::pair<const int, int>& v) { EATEST_VERIFY(v.second == it->first); }));
+			EATEST_VERIFY(cmap.visit(it->first, [](eastl::pair<const int, int>& v) { v.second++; }));
+		}
+
+		EATEST_VERIFY(!cmap.visit(-1, [](eastl::pair<const int, int>&) { }));
+		EATEST_VERIFY(!cmap.cvisit(-1, [](const eastl::pair<const int, int>&) { }));
+
+		cmap.clear();
+		EATEST_VERIFY(cmap.empty() && cmap.validate());
+	}
+
+
+	{  // Test try_emplace, move-only use of keys and values, reserve and object lifetimes
+		TestObject::Reset();
+
+		{
+			concurrent_hash_map<eastl::string, TestObject, eastl::hash<eastl::string>, eastl::equal_to<eastl::string>, EASTLAllocatorType, 4> cmap(100);
+
+			EATEST_VERIFY(cmap.try_emplace(eastl::string("one"), 1));
+			EATEST_VERIFY(!cmap.try_emplace(eastl::string("one"), 100));
+			EATEST_VERIFY(cmap.try_emplace("two", 2));
+
+			eastl::string key("three");
+			TestObject value(3);
+			EATEST_VERIFY(cmap.insert_or_assign(eastl::move(key), eastl::move(value)));
+			EATEST_VERIFY(!cmap.insert_or_assign("three", TestObject(33)));
+
+			TestObject found;
+			EATEST_VERIFY(cmap.find("one", found) && (found.mX == 1));
+			EATEST_VERIFY(cmap.find("three", found) && (found.mX == 33));
+			EATEST_VERIFY(!cmap.find("four", found) && (found.mX == 33));
+
+			EATEST_VERIFY(cmap.size() == 3);
+			EATEST_VERIFY(cmap.erase("two") == 1);
+			EATEST_VERIFY(cmap.erase("two") == 0);
+			EATEST_VERIFY(cmap.size() == 2);
+			EATEST_VERIFY(cmap.validate());
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+
+	#if EASTL_THREAD_SUPPORT_AVAILABLE
+		{  // Test use by several threads at once
+			ThreadTestMap               cmap;
+			ConcurrentHashMapTestThread thread[4];
+			std::atomic<int>            nStartedCount(0);
+			const int                   nThreadCount = (int)EAArrayCount(thread);
+
+			cmap.insert(eastl::make_pair(kCounterKey, 0));
+
+			for(int i = 0; i < nThreadCount; i++)
+			{
+				thread[i].mpMap          = &cmap;
+				thread[i].mpStartedCount = &nStartedCount;
+				thread[i].mnThreadIndex  = i;
+				thread[i].mnThreadCount  = nThreadCount;
+				thread[i].mThreadParams.mpName = "ConcurrentHashMapTestThread";
+			}
+
+			for(int i = 0; i < nThreadCount; i++)
+				thread[i].mThread.Begin(&thread[i], NULL, &thread[i].mThreadParams);
+
+			for(int i = 0; i < nThreadCount; i++)
+			{
+				thread[i].mThread.WaitForEnd();
+				nErrorCount += thread[i].mnErrorCount;
+			}
+
+			EATEST_VERIFY(cmap.validate());
+			EATEST_VERIFY(cmap.size() == (eastl_size_t)(1 + ((nThreadCount * kThreadKeyCount * 3) / 4)));
+
+			int value = 0;
+			EATEST_VERIFY(cmap.find(kCounterKey, value) && (value == nThreadCount * kThreadKeyCount));
+
+			for(int k = 0; k < nThreadCount * kThreadKeyCount; k++)
+			{
+				const bool bFound = cmap.find(k, value);
+
+				switch(k % 4)
+				{
+					case 0:  EATEST_VERIFY(!bFound);                        break;
+					case 1:  EATEST_VERIFY(bFound && (value == -k));        break;
+					default: EATEST_VERIFY(bFound && (value == k * 2));     break;
+				}
+			}
+		}
+	#endif
+
+	return nErrorCount;
+}
@@ -0,0 +1,496 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/bonus/spsc_ring_buffer.h>
+#include <EASTL/bonus/mpmc_bounded_queue.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <eathread/eathread_thread.h>
+#include <atomic>
+
+
+using namespace eastl;
+
+
+// Explicit Template instantiations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::spsc_ring_buffer<int>;
+template class eastl::spsc_ring_buffer<TestObject>;
+template class eastl::fixed_spsc_ring_buffer<int, 16>;
+template class eastl::mpmc_bounded_queue<int>;
+template class eastl::mpmc_bounded_queue<TestObject>;
+template class eastl::fixed_mpmc_bounded_queue<int, 16>;
+
+
+namespace
+{
+	// Runs the tests which don't need threads. The queue's elements are TestObjects
+	// so that their construction and destruction can be checked.
+	template <typename Queue>
+	int TestQueueSingleThreaded(Queue& q)
+	{
+		int nErrorCount = 0;
+
+		const eastl_size_t nCapacity = q.capacity();
+		TestObject value;
+
+		EATEST_VERIFY(q.empty() && (q.size() == 0));
+		EATEST_VERIFY(!q.try_pop(value));
+
+		// Fill the queue, one element at a time. A push into a full queue fails.
+		for(eastl_size_t i = 0; i < nCapacity; i++)
+			EATEST_VERIFY(q.try_push(TestObject((int)i)));
+
+		EATEST_VERIFY(q.size() == nCapacity);
+		EATEST_VERIFY(!q.try_push(TestObject(-1)));
+		EATEST_VERIFY(!q.try_emplace(-1));
+		EATEST_VERIFY(TestObject::sTOCount == (int64_t)(nCapacity + 1)); // The elements plus value.
+
+		// Go around the buffer a few times, so that the positions wrap.
+		for(int i = (int)nCapacity; i < (int)nCapacity * 5; i++)
+		{
+			EATEST_VERIFY(q.try_pop(value) && (value.mX == (i - (int)nCapacity)));
+			EATEST_VERIFY(q.try_emplace(i));
+		}
+
+		for(int i = (int)nCapacity * 4; i < (int)nCapacity * 5; i++)
+			EATEST_VERIFY(q.try_pop(value) && (value.mX == i));
+
+		EATEST_VERIFY(q.empty() && !q.try_pop(value));
+		EATEST_VERIFY(TestObject::sTOCount == 1);
+
+		// push_n and pop_n move as much as fits, or as is there.
+		eastl::vector<TestObject> in, out(nCapacity * 2);
+
+		for(int i = 0; i < (int)nCapacity * 2; i++)
+			in.push_back(TestObject(i + 100));
+
+		EATEST_VERIFY(q.push_n(in.begin(), 3) == 3);
+		EATEST_VERIFY(q.push_n(in.begin() + 3, nCapacity * 2) == nCapacity - 3);
+		EATEST_VERIFY(q.push_n(in.begin(), 1) == 0);
+		EATEST_VERIFY(q.size() == nCapacity);
+
+		EATEST_VERIFY(q.pop_n(out.begin(), 2) == 2);
+		EATEST_VERIFY(q.pop_n(out.begin() + 2, nCapacity * 2) == nCapacity - 2);
+		EATEST_VERIFY(q.pop_n(out.begin(), 1) == 0);
+
+		for(eastl_size_t i = 0; i < nCapacity; i++)
+			EATEST_VERIFY(out[i].mX == in[i].mX);
+
+		// A batch which straddles the end of the buffer.
+		EATEST_VERIFY(q.push_n(in.begin(), nCapacity / 2 + 1) == (nCapacity / 2 + 1));
+		EATEST_VERIFY(q.pop_n(out.begin(), nCapacity / 2 + 1) == (nCapacity / 2 + 1));
+		EATEST_VERIFY(q.push_n(in.begin(), nCapacity) == nCapacity);
+		EATEST_VERIFY(q.pop_n(out.begin(), nCapacity) == nCapacity);
+
+		for(eastl_size_t i = 0; i < nCapacity; i++)
+			EATEST_VERIFY(out[i].mX == in[i].mX);
+
+		// Elements which are still in the queue are destroyed with it.
+		EATEST_VERIFY(q.try_emplace(7) && q.try_emplace(8));
+		EATEST_VERIFY(q.size() == 2);
+
+		return nErrorCount;
+	}
+}
+
+
+#if EASTL_EXCEPTIONS_ENABLED
+	namespace
+	{
+		// A value whose copy throws once if it was made with bThrowOnCopy, and which counts
+		// the live values. Assignment counts as a copy, so that a pop can throw too.
+		struct QueueThrowingValue
+		{
+			int          mX;
+			mutable bool mbThrowOnCopy;
+
+			static int sLiveCount;
+
+			QueueThrowingValue(int x = 0, bool bThrowOnCopy = false) : mX(x), mbThrowOnCopy(bThrowOnCopy) { ++sLiveCount; }
+			QueueThrowingValue(const QueueThrowingValue& x) : mX(x.mX), mbThrowOnCopy(false) { CheckCopy(x); ++sLiveCount; }
+		   ~QueueThrowingValue() { --sLiveCount; }
+
+			QueueThrowingValue& operator=(const QueueThrowingValue& x)
+			{
+				CheckCopy(x);
+				mX = x.mX;
+				return *this;
+			}
+
+			static void CheckCopy(const QueueThrowingValue& x)
+			{
+				if(x.mbThrowOnCopy)
+				{
+					x.mbThrowOnCopy = false;
+					throw "Disallowed QueueThrowingValue copy";
+				}
+			}
+		};
+
+		int QueueThrowingValue::sLiveCount = 0;
+
+
+		// Tests that a queue stays usable when copying an element in or out of it throws.
+		// bPopKeepsValue is whether a pop which throws leaves its element in the queue,
+		// rather than destroying it.
+		template <typename Queue>
+		int TestQueueExceptions(Queue& q, bool bPopKeepsValue)
+		{
+			int nErrorCount = 0;
+
+			const eastl_size_t nCapacity = q.capacity();
+			QueueThrowingValue value, in[4], out[4];
+			bool bThrew = false;
+
+			// A push which throws stores nothing.
+			try { q.try_push(QueueThrowingValue(-1, true)); } catch(...) { bThrew = true; }
+
+			EATEST_VERIFY(bThrew);
+			EATEST_VERIFY(q.try_push(QueueThrowingValue(1)) && q.try_pop(value) && (value.mX == 1));
+			EATEST_VERIFY(!q.try_pop(value) && q.empty());
+
+			// push_n keeps the elements before the one which threw.
+			for(int i = 0; i < 4; i++)
+				in[i] = QueueThrowingValue(i);
+			in[2].mbThrowOnCopy = true;
+
+			bThrew = false;
+			try { q.push_n(in, 4); } catch(...) { bThrew = true; }
+
+			EATEST_VERIFY(bThrew);
+			EATEST_VERIFY((q.pop_n(out, 4) == 2) && (out[0].mX == 0) && (out[1].mX == 1));
+			EATEST_VERIFY(!q.try_pop(value) && q.empty());
+
+			// pop_n keeps the elements it moved out before the one which threw.
+			EATEST_VERIFY(q.try_emplace(6) && q.try_emplace(7) && q.try_emplace(8, true) && q.try_emplace(9));
+
+			bThrew = false;
+			try { q.pop_n(out, 4); } catch(...) { bThrew = true; }
+
+			EATEST_VERIFY(bThrew);
+			EATEST_VERIFY((out[0].mX == 6) && (out[1].mX == 7));
+
+			if(bPopKeepsValue)
+				EATEST_VERIFY((q.pop_n(out, 4) == 2) && (out[0].mX == 8) && (out[1].mX == 9));
+			EATEST_VERIFY(!q.try_pop(value) && q.empty());
+
+			EATEST_VERIFY(q.try_emplace(5, true));
+
+			bThrew = false;
+			try { q.try_pop(value); } catch(...) { bThrew = true; }
+
+			EATEST_VERIFY(bThrew);
+			if(bPopKeepsValue)
+				EATEST_VERIFY(q.try_pop(value) && (value.mX == 5));
+			EATEST_VERIFY(!q.try_pop(value) && q.empty());
+
+			// After a push which throws, the queue still takes its full capacity, in order.
+			bThrew = false;
+			try { q.try_push(QueueThrowingValue(-1, true)); } catch(...) { bThrew = true; }
+
+			EATEST_VERIFY(bThrew);
+			for(int lap = 0; lap < 3; lap++)
+			{
+				for(eastl_size_t i = 0; i < nCapacity; i++)
+					EATEST_VERIFY(q.try_emplace((int)i));
+				for(eastl_size_t i = 0; i < nCapacity; i++)
+					EATEST_VERIFY(q.try_pop(value) && (value.mX == (int)i));
+				EATEST_VERIFY(!q.try_pop(value));
+			}
+
+			// The queue is destroyed with elements in it, and with a position given up.
+			bThrew = false;
+			try { q.try_push(QueueThrowingValue(-1, true)); } catch(...) { bThrew = true; }
+
+			EATEST_VERIFY(bThrew);
+			for(eastl_size_t i = 0; i < nCapacity; i++)
+				EATEST_VERIFY(q.try_emplace((int)i));
+
+			return nErrorCount;
+		}
+	}
+#endif
+
+
+#if EASTL_THREAD_SUPPORT_AVAILABLE
+	namespace
+	{
+		const uint32_t kThreadValueCount = 100000;
+		const int      kBatchSize        = 7;
+
+		// Pushes the values [mnBegin, mnBegin + kThreadValueCount) in order, alternating between
+		// single pushes and batches. Waits for the consumers when the queue is full.
+		template <typename Queue>
+		struct QueueProducerThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters mThreadParams;
+			EA::Thread::Thread           mThread;
+			Queue*                       mpQueue;
+			uint32_t                     mnBegin;
+
+			QueueProducerThread() : mThreadParams(), mThread(), mpQueue(NULL), mnBegin(0) {}
+			QueueProducerThread(const QueueProducerThread&) = delete;
+			void operator=(const QueueProducerThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				uint32_t batch[kBatchSize];
+
+				for(uint32_t i = 0; i < kThreadValueCount; )
+				{
+					if((i / kBatchSize) % 2)
+					{
+						uint32_t n = 0;
+
+						for(; (n < (uint32_t)kBatchSize) && ((i + n) < kThreadValueCount); n++)
+							batch[n] = mnBegin + i + n;
+
+						for(uint32_t nPushed = 0; nPushed < n; )
+						{
+							const uint32_t nCount = (uint32_t)mpQueue->push_n(batch + nPushed, n - nPushed);
+
+							if(!nCount)
+								EA::Thread::ThreadSleep(0);
+							nPushed += nCount;
+						}
+
+						i += n;
+					}
+					else
+					{
+						while(!mpQueue->try_push(mnBegin + i))
+							EA::Thread::ThreadSleep(0);
+						i++;
+					}
+				}
+
+				return 0;
+			}
+		};
+
+
+		// Pops values until all of the producers' values have been consumed by some consumer.
+		// A consumer sees each producer's values in the order that it pushed them.
+		template <typename Queue>
+		struct QueueConsumerThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters mThreadParams;
+			EA::Thread::Thread           mThread;
+			Queue*                       mpQueue;
+			std::atomic<uint32_t>*       mpConsumedCount;
+			uint32_t                     mnTotalCount;
+			uint32_t                     mnLastValue[8];  // By producer, plus one.
+			uint64_t                     mnSum;
+			int                          mnErrorCount;
+
+			QueueConsumerThread() : mThreadParams(), mThread(), mpQueue(NULL), mpConsumedCount(NULL), mnTotalCount(0), mnLastValue(), mnSum(0), mnErrorCount(0) {}
+			QueueConsumerThread(const QueueConsumerThread&) = delete;
+			void operator=(const QueueConsumerThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				int& nErrorCount = mnErrorCount; // declare nErrorCount so that EATEST_VERIFY can work, as it depends on it being declared.
+				uint32_t batch[kBatchSize];
+
+				for(uint32_t nPass = 0; mpConsumedCount->load(std::memory_order_relaxed) < mnTotalCount; nPass++)
+				{
+					uint32_t n = 0;
+
+					if(nPass % 2)
+						n = (uint32_t)mpQueue->pop_n(batch, kBatchSize);
+					else if(mpQueue->try_pop(batch[0]))
+						n = 1;
+
+					if(!n)
+						EA::Thread::ThreadSleep(0);
+
+					for(uint32_t i = 0; i < n; i++)
+					{
+						const uint32_t nProducer = batch[i] / kThreadValueCount;
+
+						EATEST_VERIFY((nProducer < EAArrayCount(mnLastValue)) && (batch[i] + 1 > mnLastValue[nProducer]));
+						if(nProducer < EAArrayCount(mnLastValue))
+							mnLastValue[nProducer] = batch[i] + 1;
+						mnSum += batch[i];
+					}
+
+					mpConsumedCount->fetch_add(n, std::memory_order_relaxed);
+				}
+
+				return nErrorCount;
+			}
+		};
+
+
+		template <typename Queue>
+		int TestQueueThreads(Queue& q, int nProducerCount, int nConsumerCount)
+		{
+			int nErrorCount = 0;
+
+			eastl::vector<QueueProducerThread<Queue>> producers((eastl_size_t)nProducerCount);
+			eastl::vector<QueueConsumerThread<Queue>> consumers((eastl_size_t)nConsumerCount);
+			std::atomic<uint32_t> nConsumedCount(0);
+
+			for(int i = 0; i < nProducerCount; i++)
+			{
+				producers[i].mpQueue = &q;
+				producers[i].mnBegin = (uint32_t)i * kThreadValueCount;
+				producers[i].mThreadParams.mpName = "QueueProducerThread";
+			}
+
+			for(int i = 0; i < nConsumerCount; i++)
+			{
+				consumers[i].mpQueue         = &q;
+				consumers[i].mpConsumedCount = &nConsumedCount;
+				consumers[i].mnTotalCount    = (uint32_t)nProducerCount * kThreadValueCount;
+				consumers[i].mThreadParams.mpName = "QueueConsumerThread";
+			}
+
+			for(int i = 0; i < nConsumerCount; i++)
+				consumers[i].mThread.Begin(&consumers[i], NULL, &consumers[i].mThreadParams);
+			for(int i = 0; i < nProducerCount; i++)
+				producers[i].mThread.Begin(&producers[i], NULL, &producers[i].mThreadParams);
+
+			for(int i = 0; i < nProducerCount; i++)
+				producers[i].mThread.WaitForEnd();
+
+			uint64_t nSum = 0;
+
+			for(int i = 0; i < nConsumerCount; i++)
+			{
+				consumers[i].mThread.WaitForEnd();
+				nErrorCount += consumers[i].mnErrorCount;
+				nSum += consumers[i].mnSum;
+			}
+
+			// Every value was popped exactly once.
+			const uint64_t nValueCount = (uint64_t)nProducerCount * kThreadValueCount;
+
+			EATEST_VERIFY(nConsumedCount.load() == nValueCount);
+			EATEST_VERIFY(nSum == (nValueCount * (nValueCount - 1)) / 2);
+			EATEST_VERIFY(q.empty());
+
+			return nErrorCount;
+		}
+	}
+#endif
+
+
+int TestConcurrentQueue()
+{
+	int nErrorCount = 0;
+
+	{  // Test spsc_ring_buffer
+		TestObject::Reset();
+
+		{
+			spsc_ring_buffer<TestObject> q(10);
+
+			EATEST_VERIFY(q.capacity() == 16); // Rounded up to a power of two.
+			nErrorCount += TestQueueSingleThreaded(q);
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+
+		{
+			fixed_spsc_ring_buffer<TestObject, 8> q;
+
+			EATEST_VERIFY(q.capacity() == 8);
+			nErrorCount += TestQueueSingleThreaded(q);
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+
+		{
+			spsc_ring_buffer<eastl::string> q(1, EASTLAllocatorType("spsc_ring_buffer test"));
+			eastl::string s;
+
+			EATEST_VERIFY(q.capacity() == 1);
+			EATEST_VERIFY(q.try_emplace(3, 'x') && !q.try_push("y"));
+			EATEST_VERIFY(q.try_pop(s) && (s == "xxx"));
+			EATEST_VERIFY(q.try_push("y") && q.try_pop(s) && (s == "y"));
+		}
+	}
+
+
+	{  // Test mpmc_bounded_queue
+		TestObject::Reset();
+
+		{
+			mpmc_bounded_queue<TestObject> q(10);
+
+			EATEST_VERIFY(q.capacity() == 16);
+			nErrorCount += TestQueueSingleThreaded(q);
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+
+		{
+			fixed_mpmc_bounded_queue<TestObject, 8> q;
+
+			EATEST_VERIFY(q.capacity() == 8);
+			nErrorCount += TestQueueSingleThreaded(q);
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+
+		{
+			mpmc_bounded_queue<eastl::string> q(1);
+			eastl::string s;
+
+			EATEST_VERIFY(q.capacity() == 2); // A capacity of one isn't supported.
+			EATEST_VERIFY(q.try_emplace(3, 'x') && q.try_push("y") && !q.try_push("z"));
+			EATEST_VERIFY(q.try_pop(s) && (s == "xxx"));
+			EATEST_VERIFY(q.try_pop(s) && (s == "y"));
+			EATEST_VERIFY(!q.try_pop(s));
+		}
+	}
+
+
+	#if EASTL_EXCEPTIONS_ENABLED
+		{  // Test that the queues stay usable when an element copy throws.
+			{
+				spsc_ring_buffer<QueueThrowingValue> q(8);
+				nErrorCount += TestQueueExceptions(q, true);
+			}
+
+			EATEST_VERIFY(QueueThrowingValue::sLiveCount == 0);
+
+			{
+				mpmc_bounded_queue<QueueThrowingValue> q(8);
+				nErrorCount += TestQueueExceptions(q, false);
+			}
+
+			EATEST_VERIFY(QueueThrowingValue::sLiveCount == 0);
+		}
+	#endif
+
+
+	#if EASTL_THREAD_SUPPORT_AVAILABLE
+		{  // Test one producer thread and one consumer thread
+			spsc_ring_buffer<uint32_t> q(64);
+			nErrorCount += TestQueueThreads(q, 1, 1);
+
+			fixed_spsc_ring_buffer<uint32_t, 4> fq; // A small buffer, so that both sides often find it full or empty.
+			nErrorCount += TestQueueThreads(fq, 1, 1);
+		}
+
+		{  // Test several producer and consumer threads
+			mpmc_bounded_queue<uint32_t> q(64);
+			nErrorCount += TestQueueThreads(q, 4, 4);
+
+			fixed_mpmc_bounded_queue<uint32_t, 8> fq;
+			nErrorCount += TestQueueThreads(fq, 3, 5);
+		}
+	#endif
+
+	return nErrorCount;
+}
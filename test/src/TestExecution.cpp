@@ -0,0 +1,319 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/execution.h>
+#include <EASTL/list.h>
+#include <EASTL/thread_pool.h>
+#include <EASTL/vector.h>
+#include <eathread/eathread_thread.h>
+#include <atomic>
+
+
+using namespace eastl;
+
+
+static_assert(is_execution_policy<execution::sequenced_policy>::value, "is_execution_policy failure");
+static_assert(is_execution_policy<execution::parallel_policy>::value, "is_execution_policy failure");
+static_assert(!is_execution_policy<int>::value, "is_execution_policy failure");
+
+
+namespace
+{
+	// Sums [nBegin, nEnd) by splitting it in halves down to single values, which makes
+	// many small nested tasks.
+	int64_t ParallelSum(thread_pool& pool, int64_t nBegin, int64_t nEnd)
+	{
+		if((nEnd - nBegin) == 1)
+			return nBegin;
+
+		const int64_t nMid = nBegin + ((nEnd - nBegin) / 2);
+		int64_t       nSum1 = 0, nSum2 = 0;
+
+		pool.invoke([&]{ nSum1 = ParallelSum(pool, nBegin, nMid); },
+					[&]{ nSum2 = ParallelSum(pool, nMid,   nEnd); });
+
+		return nSum1 + nSum2;
+	}
+
+
+	struct KeyIndex
+	{
+		int mnKey;
+		int mnIndex;
+
+		bool operator<(const KeyIndex& x) const { return mnKey < x.mnKey; }
+	};
+
+
+	// Fills v with values of the given pattern.
+	void FillPattern(eastl::vector<int>& v, eastl_size_t nSize, int nPattern, EASTLTest_Rand& rng)
+	{
+		v.resize(nSize);
+
+		for(eastl_size_t i = 0; i < nSize; i++)
+		{
+			switch(nPattern)
+			{
+				case 0:  v[i] = (int)rng.RandLimit(0x7fffffff);  break; // Random
+				case 1:  v[i] = (int)rng.RandLimit(16);          break; // Many duplicates
+				case 2:  v[i] = (int)i;                          break; // Sorted
+				case 3:  v[i] = (int)(nSize - i);                break; // Reversed
+				default: v[i] = 7;                               break; // All equal
+			}
+		}
+	}
+
+
+	template <typename ExecutionPolicy>
+	int TestSortPolicy(const ExecutionPolicy& policy)
+	{
+		int nErrorCount = 0;
+
+		EASTLTest_Rand     rng(EA::UnitTest::GetRandSeed());
+		eastl::vector<int> v, vExpected;
+
+		const eastl_size_t kSizes[] = { 0, 1, 2, 100, 5000, 100000 };
+
+		for(eastl_size_t s = 0; s < EAArrayCount(kSizes); s++)
+		{
+			for(int nPattern = 0; nPattern < 5; nPattern++)
+			{
+				FillPattern(v, kSizes[s], nPattern, rng);
+				vExpected = v;
+				eastl::sort(vExpected.begin(), vExpected.end());
+
+				eastl::sort(policy, v.begin(), v.end());
+				EATEST_VERIFY(v == vExpected);
+
+				eastl::reverse(vExpected.begin(), vExpected.end());
+				eastl::sort(policy, v.begin(), v.end(), eastl::greater<int>());
+				EATEST_VERIFY(v == vExpected);
+			}
+		}
+
+		{   // stable_sort keeps equivalent elements in their original order.
+			eastl::vector<KeyIndex> kv(100000);
+
+			for(int i = 0; i < (int)kv.size(); i++)
+			{
+				kv[i].mnKey   = (int)rng.RandLimit(100);
+				kv[i].mnIndex = i;
+			}
+
+			eastl::stable_sort(policy, kv.begin(), kv.end());
+
+			bool bStable = true;
+
+			for(eastl_size_t i = 1; i < kv.size(); i++)
+			{
+				if((kv[i].mnKey < kv[i - 1].mnKey) || ((kv[i].mnKey == kv[i - 1].mnKey) && (kv[i].mnIndex < kv[i - 1].mnIndex)))
+					bStable = false;
+			}
+
+			EATEST_VERIFY(bStable);
+
+			for(int i = 0; i < (int)kv.size(); i++)
+			{
+				kv[i].mnKey   = i % 3;
+				kv[i].mnIndex = i;
+			}
+
+			eastl::stable_sort(policy, kv.begin(), kv.end(), [](const KeyIndex& a, const KeyIndex& b) { return a.mnKey > b.mnKey; });
+			EATEST_VERIFY((kv.front().mnKey == 2) && (kv.back().mnKey == 0));
+			EATEST_VERIFY(eastl::is_sorted(kv.begin(), kv.end(), [](const KeyIndex& a, const KeyIndex& b) { return (a.mnKey > b.mnKey) || ((a.mnKey == b.mnKey) && (a.mnIndex < b.mnIndex)); }));
+		}
+
+		{   // Strings, which are not trivially copyable.
+			eastl::vector<eastl::string> sv, svExpected;
+
+			for(int i = 0; i < 20000; i++)
+				sv.push_back(eastl::string(eastl::string::CtorSprintf(), "%08u", (unsigned)rng.RandLimit(100000)));
+
+			svExpected = sv;
+			eastl::stable_sort(svExpected.begin(), svExpected.end());
+
+			eastl::vector<eastl::string> sv2(sv);
+			eastl::sort(policy, sv.begin(), sv.end());
+			eastl::stable_sort(policy, sv2.begin(), sv2.end());
+			EATEST_VERIFY(sv == svExpected);
+			EATEST_VERIFY(sv2 == svExpected);
+		}
+
+		return nErrorCount;
+	}
+
+
+	template <typename ExecutionPolicy>
+	int TestAlgorithmPolicy(const ExecutionPolicy& policy)
+	{
+		int nErrorCount = 0;
+
+		const int kSize = 100000;
+
+		eastl::vector<int> v(kSize), v2(kSize), vResult(kSize);
+		eastl::list<int>   l;
+
+		for(int i = 0; i < kSize; i++)
+			v[i] = i;
+
+		for(int i = 0; i < 100; i++)
+			l.push_back(i);
+
+		{   // for_each
+			eastl::for_each(policy, v.begin(), v.end(), [](int& x) { x *= 2; });
+
+			bool bCorrect = true;
+			for(int i = 0; i < kSize; i++)
+				bCorrect = bCorrect && (v[i] == (i * 2));
+			EATEST_VERIFY(bCorrect);
+
+			std::atomic<int> nCount(0);
+			eastl::for_each(policy, v.begin(), v.end(), [&](int) { nCount.fetch_add(1, std::memory_order_relaxed); });
+			EATEST_VERIFY(nCount.load() == kSize);
+
+			eastl::for_each(policy, l.begin(), l.end(), [](int& x) { x += 1; }); // Not random access, so sequential.
+			EATEST_VERIFY((l.front() == 1) && (l.back() == 100));
+
+			eastl::for_each(policy, v.begin(), v.begin(), [](int& x) { x = -1; });
+			EATEST_VERIFY(v[0] == 0);
+		}
+
+		{   // transform
+			eastl::vector<int>::iterator it = eastl::transform(policy, v.begin(), v.end(), vResult.begin(), [](int x) { return x + 1; });
+			EATEST_VERIFY(it == vResult.end());
+
+			bool bCorrect = true;
+			for(int i = 0; i < kSize; i++)
+				bCorrect = bCorrect && (vResult[i] == (i * 2) + 1);
+			EATEST_VERIFY(bCorrect);
+
+			for(int i = 0; i < kSize; i++)
+				v2[i] = -i;
+
+			it = eastl::transform(policy, v.begin(), v.end(), v2.begin(), vResult.begin(), [](int x, int y) { return x + y; });
+			EATEST_VERIFY(it == vResult.end());
+
+			bCorrect = true;
+			for(int i = 0; i < kSize; i++)
+				bCorrect = bCorrect && (vResult[i] == i);
+			EATEST_VERIFY(bCorrect);
+
+			eastl::vector<int> lResult(l.size());
+			it = eastl::transform(policy, l.begin(), l.end(), lResult.begin(), [](int x) { return x * 3; });
+			EATEST_VERIFY((it == lResult.end()) && (lResult.front() == 3) && (lResult.back() == 300));
+		}
+
+		{   // reduce
+			const int64_t nExpected = ((int64_t)kSize * (kSize - 1)) / 2;
+
+			EATEST_VERIFY(eastl::reduce(policy, vResult.begin(), vResult.end(), (int64_t)0) == nExpected);
+			EATEST_VERIFY(eastl::reduce(policy, vResult.begin(), vResult.end(), (int64_t)1000) == nExpected + 1000);
+			EATEST_VERIFY(eastl::reduce(policy, vResult.begin(), vResult.begin() + 10) == 45);
+			EATEST_VERIFY(eastl::reduce(policy, vResult.begin(), vResult.begin(), 5) == 5);
+			EATEST_VERIFY(eastl::reduce(policy, vResult.begin(), vResult.end(), INT_MIN, [](int a, int b) { return eastl::max_alt(a, b); }) == kSize - 1);
+			EATEST_VERIFY(eastl::reduce(policy, l.begin(), l.end(), 0) == 5050);
+		}
+
+		return nErrorCount;
+	}
+}
+
+
+#if EASTL_THREAD_SUPPORT_AVAILABLE
+	namespace
+	{
+		// Calls ParallelSum on a shared pool from a thread outside of it.
+		struct PoolUserThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters mThreadParams;
+			EA::Thread::Thread           mThread;
+			thread_pool*                 mpPool;
+			int64_t                      mnSum;
+
+			PoolUserThread() : mThreadParams(), mThread(), mpPool(NULL), mnSum(0) {}
+			PoolUserThread(const PoolUserThread&) = delete;
+			void operator=(const PoolUserThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				for(int i = 0; i < 20; i++)
+					mnSum += ParallelSum(*mpPool, 0, 10000);
+				return 0;
+			}
+		};
+	}
+#endif
+
+
+int TestExecution()
+{
+	int nErrorCount = 0;
+
+	{  // Test thread_pool
+		{   // A pool without workers runs everything on the calling thread.
+			thread_pool pool(0);
+
+			EATEST_VERIFY((pool.thread_count() == 0) && (pool.concurrency() == 1));
+			EATEST_VERIFY(ParallelSum(pool, 0, 1000) == 499500);
+		}
+
+		{
+			thread_pool pool(3);
+
+			#if EASTL_THREAD_SUPPORT_AVAILABLE && EASTL_CPP11_MUTEX_ENABLED
+				EATEST_VERIFY((pool.thread_count() == 3) && (pool.concurrency() == 4));
+			#endif
+
+			for(int i = 0; i < 10; i++)
+				EATEST_VERIFY(ParallelSum(pool, 0, 100000) == (int64_t)4999950000);
+
+			#if EASTL_THREAD_SUPPORT_AVAILABLE
+				// Several threads outside the pool use it at once.
+				eastl::vector<PoolUserThread> threads(3);
+
+				for(eastl_size_t t = 0; t < threads.size(); t++)
+				{
+					threads[t].mpPool = &pool;
+					threads[t].mThreadParams.mpName = "PoolUserThread";
+					threads[t].mThread.Begin(&threads[t], NULL, &threads[t].mThreadParams);
+				}
+
+				for(eastl_size_t t = 0; t < threads.size(); t++)
+				{
+					threads[t].mThread.WaitForEnd();
+					EATEST_VERIFY(threads[t].mnSum == (int64_t)49995000 * 20);
+				}
+			#endif
+		}
+
+		EATEST_VERIFY(&thread_pool::get_default() == &thread_pool::get_default());
+		EATEST_VERIFY(thread_pool::get_default().thread_count() == thread_pool::default_thread_count());
+	}
+
+
+	{  // Test the sequenced and parallel algorithms
+		thread_pool pool(3);
+
+		nErrorCount += TestSortPolicy(execution::seq);
+		nErrorCount += TestSortPolicy(execution::par);
+		nErrorCount += TestSortPolicy(execution::par.on(pool));
+
+		nErrorCount += TestAlgorithmPolicy(execution::seq);
+		nErrorCount += TestAlgorithmPolicy(execution::par);
+		nErrorCount += TestAlgorithmPolicy(execution::par.on(pool));
+	}
+
+
+	{  // Test the sequential reduce
+		const int a[] = { 1, 2, 3, 4 };
+
+		EATEST_VERIFY(eastl::reduce(a, a + 4) == 10);
+		EATEST_VERIFY(eastl::reduce(a, a + 4, 10) == 20);
+		EATEST_VERIFY(eastl::reduce(a, a + 4, 1, [](int x, int y) { return x * y; }) == 24);
+	}
+
+	return nErrorCount;
+}
@@ -136,6 +136,8 @@ template class eastl::fixed_hash_map<A, A, 1, 2, true, eastl::hash<A>, eastl::eq
 template class eastl::fixed_hash_multiset<A, 1, 2, true, eastl::hash<A>, eastl::equal_to<A>, false, MallocAllocator>;
 template class eastl::fixed_hash_multimap<A, A, 1, 2, true, eastl::hash<A>, eastl::equal_to<A>, false, MallocAllocator>;
 
+template class eastl::fixed_hash_map<int, int, 1, 2, true, eastl::hash<int>, eastl::equal_to<int>, false, eastl::slab_overflow_allocator<> >;
+
 
 
 template<typename FixedHashMap, int ELEMENT_MAX, int ITERATION_MAX>
@@ -247,6 +249,46 @@ int TestFixedHash()
 			fixedHashMap.get_allocator().set_overflow_allocator(a);
 		}
 
+		{
+			// Test version with pool overflow into slabs.
+			typedef eastl::fixed_hash_map<int, int, 100, 100, true, eastl::hash<int>, eastl::equal_to<int>, false, eastl::slab_overflow_allocator<> > FixedHashMapSlabs;
+			FixedHashMapSlabs fixedHashMap;
+			FixedHashMapSlabs::allocator_type& allocator = fixedHashMap.get_allocator();
+
+			for(int i = 0; i < 1000; i++)
+				fixedHashMap.insert(FixedHashMapSlabs::value_type(i, i));
+			VERIFY(fixedHashMap.size() == 1000);
+			VERIFY(fixedHashMap.validate());
+
+			for(int i = 0; i < 1000; i++)
+				VERIFY(fixedHashMap.find(i)->second == i);
+
+			for(int i = 100; i < 1000; i++)
+				fixedHashMap.erase(i);
+			VERIFY(allocator.release_empty_slabs() > 0);
+			VERIFY(allocator.release_empty_slabs() == 0);
+
+			for(int i = 0; i < 100; i++)
+				VERIFY(fixedHashMap.find(i)->second == i);
+
+			for(int i = 100; i < 1000; i++)
+				fixedHashMap.insert(FixedHashMapSlabs::value_type(i, i));
+			VERIFY(fixedHashMap.size() == 1000);
+			VERIFY(fixedHashMap.validate());
+
+			fixedHashMap.clear();
+			VERIFY(allocator.release_empty_slabs() > 0);
+			VERIFY(fixedHashMap.validate());
+
+			for(int i = 0; i < 1000; i++)
+				fixedHashMap.insert(FixedHashMapSlabs::value_type(i, i));
+
+			// clear(true) resets the pool, which frees the slabs.
+			fixedHashMap.clear(true);
+			VERIFY(allocator.release_empty_slabs() == 0);
+			VERIFY(fixedHashMap.validate());
+		}
+
 		// Test that fixed_hash_map (with and without overflow enabled) is usable after the node and bucket array has
 		// been cleared.
 		{
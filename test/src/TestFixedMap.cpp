@@ -28,6 +28,8 @@ template class eastl::fixed_multimap<float,      int,        1, true, eastl::les
 template class eastl::fixed_map     <int,        TestObject, 1, true, eastl::less<int>,        MallocAllocator>;
 template class eastl::fixed_multimap<TestObject, int,        1, true, eastl::less<TestObject>, MallocAllocator>;
 
+template class eastl::fixed_map     <int,        TestObject, 1, true, eastl::less<int>,        eastl::slab_overflow_allocator<> >;
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // typedefs
@@ -168,6 +170,61 @@ int TestFixedMap()
 	}
 
 
+	{
+		// Test overflow into slabs.
+		typedef fixed_map<int, TestObject, 16, true, eastl::less<int>, slab_overflow_allocator<EASTLAllocatorType, 32> > FixedMapWithSlabs;
+
+		FixedMapWithSlabs fm;
+		FixedMapWithSlabs::fixed_allocator_type& a = fm.get_allocator();
+
+		VERIFY(a.mPool.slab_count() == 0);
+		VERIFY(a.mPool.slab_node_count() >= 32);
+
+		const int kCount = 16 + (int)(3 * a.mPool.slab_node_count());
+
+		for(int i = 0; i < kCount; i++)
+			fm.insert(FixedMapWithSlabs::value_type(i, TestObject(i)));
+
+		VERIFY(fm.size() == (eastl_size_t)kCount);
+		VERIFY(a.mPool.slab_count() == 3);
+		VERIFY(fm.validate());
+
+		for(int i = 0; i < kCount; i++)
+			VERIFY(fm[i].mX == i);
+
+		// Slabs with any node in use are kept.
+		for(int i = 16; i < kCount - 1; i++)
+			fm.erase(i);
+		VERIFY(a.release_empty_slabs() == 2);
+		VERIFY(a.mPool.slab_count() == 1);
+		VERIFY(fm.validate());
+
+		fm.erase(kCount - 1);
+		VERIFY(a.release_empty_slabs() == 1);
+		VERIFY(a.mPool.slab_count() == 0);
+		VERIFY(a.release_empty_slabs() == 0);
+
+		// The freelist no longer refers to the released slabs, and the pool grows again.
+		for(int i = 16; i < kCount; i++)
+			fm.insert(FixedMapWithSlabs::value_type(i, TestObject(i)));
+
+		VERIFY(fm.size() == (eastl_size_t)kCount);
+		VERIFY(a.mPool.slab_count() == 3);
+		VERIFY(fm.validate());
+
+		for(int i = 0; i < kCount; i++)
+			VERIFY(fm[i].mX == i);
+
+		FixedMapWithSlabs fmCopy(fm);
+		VERIFY(fmCopy == fm);
+		VERIFY(fmCopy.get_allocator().mPool.slab_count() == 3);
+
+		fm.clear();
+		VERIFY(a.release_empty_slabs() == 3);
+		VERIFY(fm.empty() && fm.validate());
+	}
+
+
 	return nErrorCount;
 }
 EA_RESTORE_VC_WARNING()
@@ -0,0 +1,403 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/flat_hash_map.h>
+#include <EASTL/flat_hash_set.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <EASTL/unique_ptr.h>
+
+
+using namespace eastl;
+
+
+// Explicit Template instantiations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::flat_hashtable<int,
+                                     eastl::pair<const int, int>,
+                                     eastl::allocator,
+                                     eastl::use_first<eastl::pair<const int, int>>,
+                                     eastl::equal_to<int>,
+                                     eastl::hash<int>,
+                                     true // bMutableIterators
+                                     >;
+template class eastl::flat_hashtable<int, int, eastl::allocator, eastl::use_self<int>, eastl::equal_to<int>, eastl::hash<int>, false>;
+
+template class eastl::flat_hash_set<int>;
+template class eastl::flat_hash_map<int, int>;
+template class eastl::flat_hash_map<eastl::string, TestObject>;
+
+
+// A key which counts its copies and is declared trivially relocatable, so that tests can tell whether
+// rehashing copies keys.
+struct FlatHashCountedKey
+{
+	int mX;
+
+	static int sCopyCount;
+
+	explicit FlatHashCountedKey(int x = 0) : mX(x) {}
+	FlatHashCountedKey(const FlatHashCountedKey& x) : mX(x.mX) { ++sCopyCount; }
+	FlatHashCountedKey(FlatHashCountedKey&& x) : mX(x.mX) {}
+	FlatHashCountedKey& operator=(const FlatHashCountedKey&) = default;
+
+	bool operator==(const FlatHashCountedKey& x) const { return mX == x.mX; }
+};
+
+int FlatHashCountedKey::sCopyCount = 0;
+
+EASTL_DECLARE_TRIVIALLY_RELOCATABLE(FlatHashCountedKey)
+
+
+namespace
+{
+	struct flat_counted_key_hash
+	{
+		size_t operator()(const FlatHashCountedKey& key) const
+			{ return eastl::hash<int>()(key.mX); }
+	};
+
+	// A value whose copy throws if it was made with bThrowOnCopy, and which counts the live values.
+	struct FlatHashThrowingValue
+	{
+		int  mX;
+		bool mbThrowOnCopy;
+
+		static int sLiveCount;
+
+		FlatHashThrowingValue(int x, bool bThrowOnCopy) : mX(x), mbThrowOnCopy(bThrowOnCopy) { ++sLiveCount; }
+		FlatHashThrowingValue(const FlatHashThrowingValue& x) : mX(x.mX), mbThrowOnCopy(x.mbThrowOnCopy)
+		{
+			#if EASTL_EXCEPTIONS_ENABLED
+				if(mbThrowOnCopy)
+					throw "Disallowed FlatHashThrowingValue copy";
+			#endif
+			++sLiveCount;
+		}
+	   ~FlatHashThrowingValue() { --sLiveCount; }
+	};
+
+	int FlatHashThrowingValue::sLiveCount = 0;
+
+	// A hash function with a high number of collisions, to exercise long probe sequences and tombstones.
+	struct flat_colliding_hash
+	{
+		size_t operator()(int val) const
+			{ return static_cast<size_t>(val % 3); }
+	};
+}
+
+
+int TestFlatHash()
+{
+	int nErrorCount = 0;
+
+	{  // Test declarations and empty state
+		flat_hash_set<int>      hashSet;
+		flat_hash_map<int, int> hashMap;
+
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.empty() && (hashSet.size() == 0) && (hashSet.bucket_count() == 0));
+		EATEST_VERIFY(hashSet.begin() == hashSet.end());
+		EATEST_VERIFY(hashSet.find(37) == hashSet.end());
+		EATEST_VERIFY(hashSet.count(37) == 0);
+		EATEST_VERIFY(hashMap.erase(37) == 0);
+		EATEST_VERIFY(hashMap.load_factor() == 0.f);
+
+		flat_hash_set<int> hashSet2(hashSet);
+		EATEST_VERIFY(hashSet2.validate() && (hashSet2 == hashSet));
+
+		flat_hash_map<int, int> hashMap2(hashMap);
+		EATEST_VERIFY(hashMap2.validate() && (hashMap2 == hashMap));
+
+		hashMap2.clear(true);
+		EATEST_VERIFY(hashMap2.validate());
+	}
+
+
+	{  // Test insert, find, erase against hash_map as a reference, with enough elements for several rehashes.
+		flat_hash_map<int, int> flatMap;
+		hash_map<int, int>      refMap;
+		EASTLTest_Rand          rng(EA::UnitTest::GetRandSeed());
+
+		const int kCount = 20000;
+
+		for(int i = 0; i < kCount; i++)
+		{
+			const int k = (int)rng.RandLimit(kCount * 2);
+			const bool bInserted = flatMap.insert(eastl::make_pair(k, i)).second;
+			EATEST_VERIFY(bInserted == refMap.insert(eastl::make_pair(k, i)).second);
+		}
+
+		EATEST_VERIFY(flatMap.validate());
+		EATEST_VERIFY(flatMap.size() == refMap.size());
+		EATEST_VERIFY(flatMap.load_factor() <= flatMap.get_max_load_factor());
+
+		for(hash_map<int, int>::iterator it = refMap.begin(); it != refMap.end(); ++it)
+		{
+			flat_hash_map<int, int>::iterator itFlat = flatMap.find(it->first);
+			EATEST_VERIFY((itFlat != flatMap.end()) && (itFlat->second == it->second));
+		}
+
+		// Erase about half of the elements by key, then verify the rest are still present.
+		for(int i = 0; i < kCount * 2; i += 2)
+			EATEST_VERIFY(flatMap.erase(i) == refMap.erase(i));
+
+		EATEST_VERIFY(flatMap.validate());
+		EATEST_VERIFY(flatMap.size() == refMap.size());
+
+		eastl_size_t nIterCount = 0;
+		for(flat_hash_map<int, int>::iterator it = flatMap.begin(); it != flatMap.end(); ++it, ++nIterCount)
+		{
+			EATEST_VERIFY((it->first % 2) == 1);
+			EATEST_VERIFY(refMap.find(it->first)->second == it->second);
+			it->second = -it->second; // Verify iterators are mutable.
+		}
+		EATEST_VERIFY(nIterCount == flatMap.size());
+	}
+
+
+	{  // Test erase by iterator, including while iterating, and reuse of deleted slots.
+		flat_hash_set<int> hashSet;
+
+		for(int i = 0; i < 1000; i++)
+			hashSet.insert(i);
+
+		EATEST_VERIFY(hashSet.size() == 1000);
+
+		for(flat_hash_set<int>::iterator it = hashSet.begin(); it != hashSet.end(); )
+		{
+			if((*it % 3) == 0)
+				it = hashSet.erase(it);
+			else
+				++it;
+		}
+
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == 666);
+		EATEST_VERIFY(!hashSet.contains(300) && hashSet.contains(301));
+
+		// Repeated insert/erase churn must not grow the table without bound.
+		const eastl_size_t nCapacity = hashSet.bucket_count();
+
+		for(int i = 0; i < 100000; i++)
+		{
+			hashSet.insert(1000000 + i);
+			hashSet.erase(1000000 + i);
+		}
+
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == 666);
+		EATEST_VERIFY(hashSet.bucket_count() == nCapacity);
+
+		flat_hash_set<int>::iterator itErase = hashSet.erase(hashSet.begin(), hashSet.end());
+		EATEST_VERIFY(itErase == hashSet.end());
+		EATEST_VERIFY(hashSet.empty() && hashSet.validate());
+	}
+
+
+	{  // Test colliding hashes
+		flat_hash_set<int, flat_colliding_hash> hashSet;
+
+		for(int i = 0; i < 500; i++)
+			hashSet.insert(i);
+
+		EATEST_VERIFY(hashSet.validate());
+
+		for(int i = 0; i < 500; i += 2)
+			hashSet.erase(i);
+
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == 250);
+
+		for(int i = 0; i < 500; i++)
+			EATEST_VERIFY(hashSet.contains(i) == ((i % 2) == 1));
+	}
+
+
+	{  // Test map extensions: operator[], at, try_emplace, insert_or_assign, insert(key), emplace
+		flat_hash_map<eastl::string, int> hashMap;
+
+		hashMap["one"] = 1;
+		hashMap["two"] = 2;
+		EATEST_VERIFY(hashMap["one"] == 1);
+		EATEST_VERIFY(hashMap.at("two") == 2);
+
+		auto result = hashMap.try_emplace("one", 100);
+		EATEST_VERIFY(!result.second && (result.first->second == 1));
+
+		result = hashMap.try_emplace("three", 3);
+		EATEST_VERIFY(result.second && (result.first->second == 3));
+
+		result = hashMap.insert_or_assign("one", 11);
+		EATEST_VERIFY(!result.second && (hashMap["one"] == 11));
+
+		result = hashMap.insert(eastl::string("four"));
+		EATEST_VERIFY(result.second && (result.first->second == 0));
+
+		result = hashMap.emplace("five", 5);
+		EATEST_VERIFY(result.second && (result.first->second == 5));
+
+		EATEST_VERIFY(hashMap.size() == 5);
+		EATEST_VERIFY(hashMap.find_as("three", eastl::hash<const char*>(), eastl::equal_to<>()) != hashMap.end());
+		EATEST_VERIFY(hashMap.find_as("six", eastl::hash<const char*>(), eastl::equal_to<>()) == hashMap.end());
+
+		auto range = hashMap.equal_range("two");
+		EATEST_VERIFY((range.first != range.second) && (range.first->second == 2) && (eastl::distance(range.first, range.second) == 1));
+
+		range = hashMap.equal_range("six");
+		EATEST_VERIFY(range.first == range.second);
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			bool bThrew = false;
+			try { hashMap.at("six"); } catch(std::out_of_range&) { bThrew = true; }
+			EATEST_VERIFY(bThrew);
+		#endif
+
+		EATEST_VERIFY(eastl::erase_if(hashMap, [](const eastl::pair<const eastl::string, int>& x) { return x.second > 3; }) == 2);
+		EATEST_VERIFY(hashMap.size() == 3);
+		EATEST_VERIFY(hashMap.validate());
+	}
+
+
+	{  // Test object lifetimes, copy, move, assignment and swap
+		TestObject::Reset();
+
+		{
+			flat_hash_map<int, TestObject> hashMap;
+
+			for(int i = 0; i < 100; i++)
+				hashMap.try_emplace(i, i);
+
+			flat_hash_map<int, TestObject> hashMap2(hashMap);
+			EATEST_VERIFY(hashMap2.validate() && (hashMap2.size() == 100));
+			EATEST_VERIFY(hashMap2 == hashMap);
+
+			flat_hash_map<int, TestObject> hashMap3(eastl::move(hashMap2));
+			EATEST_VERIFY(hashMap3.validate() && hashMap2.validate());
+			EATEST_VERIFY(hashMap2.empty() && (hashMap3.size() == 100));
+
+			hashMap2 = hashMap3;
+			EATEST_VERIFY(hashMap2 == hashMap3);
+
+			hashMap3.erase(7);
+			EATEST_VERIFY(hashMap2 != hashMap3);
+
+			hashMap2.swap(hashMap3);
+			EATEST_VERIFY((hashMap2.size() == 99) && (hashMap3.size() == 100));
+
+			hashMap3 = { {1, TestObject(1)}, {2, TestObject(2)} };
+			EATEST_VERIFY(hashMap3.size() == 2);
+
+			hashMap.clear();
+			EATEST_VERIFY(hashMap.empty() && hashMap.validate());
+
+			hashMap.rehash(0);
+			EATEST_VERIFY(hashMap.bucket_count() == 0);
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+
+	{  // Test reserve and rehash
+		flat_hash_set<int> hashSet;
+
+		hashSet.reserve(1000);
+		const eastl_size_t nCapacity = hashSet.bucket_count();
+		EATEST_VERIFY(nCapacity >= 1000);
+
+		for(int i = 0; i < 1000; i++)
+			hashSet.insert(i);
+
+		EATEST_VERIFY(hashSet.bucket_count() == nCapacity); // No growth was needed.
+
+		for(int i = 0; i < 900; i++)
+			hashSet.erase(i);
+
+		hashSet.rehash(0); // Shrink to fit.
+		EATEST_VERIFY(hashSet.bucket_count() < nCapacity);
+		EATEST_VERIFY(hashSet.validate() && (hashSet.size() == 100));
+
+		for(int i = 900; i < 1000; i++)
+			EATEST_VERIFY(hashSet.contains(i));
+	}
+
+	{  // Test that rehashing relocates values rather than copying their keys.
+		flat_hash_map<FlatHashCountedKey, eastl::string, flat_counted_key_hash> hashMap;
+
+		FlatHashCountedKey::sCopyCount = 0;
+
+		for(int i = 0; i < 1000; i++)
+			hashMap.try_emplace(FlatHashCountedKey(i), "value");
+
+		EATEST_VERIFY(hashMap.validate() && (hashMap.size() == 1000));
+		EATEST_VERIFY(FlatHashCountedKey::sCopyCount == 0);
+	}
+
+	#if EASTL_EXCEPTIONS_ENABLED
+		{  // Test that a rehash whose copy throws leaves the table as it was.
+			{
+				flat_hash_map<int, FlatHashThrowingValue> hashMap;
+				hashMap.reserve(100);
+
+				for(int i = 0; i < 100; i++)
+					hashMap.try_emplace(i, i, (i == 50)); // Copying the value of 50 throws.
+
+				const eastl_size_t nCapacity = hashMap.bucket_count();
+				bool bThrew = false;
+
+				try { hashMap.rehash(nCapacity * 4); } catch(...) { bThrew = true; }
+
+				EATEST_VERIFY(bThrew);
+				EATEST_VERIFY(hashMap.validate() && (hashMap.size() == 100) && (hashMap.bucket_count() == nCapacity));
+				EATEST_VERIFY(FlatHashThrowingValue::sLiveCount == 100);
+
+				for(int i = 0; i < 100; i++)
+					EATEST_VERIFY((hashMap.find(i) != hashMap.end()) && (hashMap.find(i)->second.mX == i));
+			}
+
+			EATEST_VERIFY(FlatHashThrowingValue::sLiveCount == 0);
+		}
+	#endif
+
+
+	{  // Test initializer lists, range construction and move-only values
+		flat_hash_set<int> hashSet = { 3, 4, 5, 3 };
+		EATEST_VERIFY(hashSet.size() == 3);
+
+		eastl::vector<int> v = { 10, 20, 30 };
+		flat_hash_set<int> hashSet2(v.begin(), v.end());
+		EATEST_VERIFY((hashSet2.size() == 3) && hashSet2.contains(20));
+
+		hashSet2.insert(hashSet.begin(), hashSet.end());
+		EATEST_VERIFY(hashSet2.size() == 6);
+		EATEST_VERIFY(hashSet2.validate_iterator(hashSet2.find(4)) == (isf_valid | isf_current | isf_can_dereference));
+		EATEST_VERIFY(hashSet2.validate_iterator(hashSet2.end()) == (isf_valid | isf_current));
+
+		flat_hash_map<int, eastl::unique_ptr<int>> hashMap;
+		for(int i = 0; i < 100; i++)
+			hashMap.try_emplace(i, eastl::make_unique<int>(i));
+
+		EATEST_VERIFY(hashMap.validate());
+		EATEST_VERIFY(*hashMap[42] == 42);
+	}
+
+
+	{  // Test custom allocator
+		flat_hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, MallocAllocator> hashMap;
+
+		for(int i = 0; i < 100; i++)
+			hashMap[i] = i;
+
+		EATEST_VERIFY(hashMap.validate());
+		EATEST_VERIFY(hashMap.get_allocator().mAllocCount > 0);
+	}
+
+	return nErrorCount;
+}
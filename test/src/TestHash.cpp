@@ -12,6 +12,7 @@
 #include <EASTL/unordered_map.h>
 #include <EASTL/map.h>
 #include <EASTL/string.h>
+#include <EASTL/string_view.h>
 #include <EASTL/algorithm.h>
 #include <EASTL/vector.h>
 #include <EASTL/unique_ptr.h>
@@ -131,6 +132,32 @@ template class eastl::hashtable<int,
 								true,  // bMutableIterators
 								true   // bUniqueKeys
 								>;
+template class eastl::hashtable<int,
+								eastl::pair<const int, int>,
+								eastl::allocator,
+								eastl::use_first<eastl::pair<const int, int>>,
+								eastl::equal_to<int>,
+								eastl::hash<int>,
+								mask_range_hashing,
+								default_ranged_hash,
+								power2_rehash_policy,
+								false, // bCacheHashCode
+								true,  // bMutableIterators
+								true   // bUniqueKeys
+								>;
+template class eastl::hashtable<int,
+								eastl::pair<const int, int>,
+								eastl::allocator,
+								eastl::use_first<eastl::pair<const int, int>>,
+								eastl::equal_to<int>,
+								eastl::hash<int>,
+								mod_range_hashing,
+								default_ranged_hash,
+								incremental_rehash_policy,
+								true,  // bCacheHashCode
+								true,  // bMutableIterators
+								true   // bUniqueKeys
+								>;
 // TODO(rparolin): known compiler error, we should fix this.
 // template class eastl::hashtable<int,
 //                                 eastl::pair<const int, int>,
@@ -1478,6 +1505,432 @@ int TestHash()
 		}
 	}
 
+	{ // Test power2_rehash_policy with mask_range_hashing
+		typedef hashtable<int, eastl::pair<const int, int>, eastl::allocator, eastl::use_first<eastl::pair<const int, int>>,
+						  eastl::equal_to<int>, eastl::hash<int>, mask_range_hashing, default_ranged_hash,
+						  power2_rehash_policy, false, true, true> Power2HashMap;
+
+		Power2HashMap hashMap(0, eastl::hash<int>(), mask_range_hashing(), default_ranged_hash(),
+							  eastl::equal_to<int>(), eastl::use_first<eastl::pair<const int, int>>());
+
+		VERIFY(hashMap.validate());
+		VERIFY(hashMap.find(3) == hashMap.end());
+
+		for(int i = 0; i < 10000; i++)
+			hashMap.insert(eastl::make_pair(i * 16, i)); // Keys with zero low bits must still spread across buckets.
+
+		VERIFY(hashMap.validate());
+		VERIFY(hashMap.size() == 10000);
+		VERIFY((hashMap.bucket_count() & (hashMap.bucket_count() - 1)) == 0);
+		VERIFY(hashMap.load_factor() <= hashMap.get_max_load_factor());
+
+		eastl_size_t nEmptyBucketCount = 0;
+		for(eastl_size_t i = 0; i < hashMap.bucket_count(); i++)
+			nEmptyBucketCount += (hashMap.bucket_size(i) == 0) ? 1 : 0;
+		VERIFY(nEmptyBucketCount < ((hashMap.bucket_count() * 3) / 4)); // Without mixing, 15/16 of the buckets would be empty.
+
+		for(int i = 0; i < 10000; i++)
+		{
+			Power2HashMap::iterator it = hashMap.find(i * 16);
+			VERIFY((it != hashMap.end()) && (it->second == i));
+			VERIFY(hashMap.find_as(i * 16, eastl::hash<int>(), eastl::equal_to<int>()) == it);
+		}
+
+		for(int i = 0; i < 10000; i += 2)
+			VERIFY(hashMap.erase(i * 16) == 1);
+
+		VERIFY(hashMap.validate());
+		VERIFY(hashMap.size() == 5000);
+
+		hashMap.set_max_load_factor(0.5f);
+		hashMap.reserve(20000);
+		VERIFY((hashMap.bucket_count() >= 40000) && ((hashMap.bucket_count() & (hashMap.bucket_count() - 1)) == 0));
+		VERIFY(hashMap.validate());
+		VERIFY(hashMap.count(16) == 1);
+
+		VERIFY(power2_rehash_policy::GetPrevBucketCountOnly(1000) == 512);
+		VERIFY(power2_rehash_policy::GetPrevBucketCountOnly(1024) == 1024);
+		VERIFY(power2_rehash_policy().GetNextBucketCount(1000) == 1024);
+		VERIFY(power2_rehash_policy().GetNextBucketCount(0) == 2);
+	}
+
+	{ // Test fast_string_hash
+		fast_string_hash fsh;
+
+		const char* const pHello = "hello world";
+		VERIFY(fsh(pHello) == fsh(eastl::string(pHello)));
+		VERIFY(fsh(pHello) == fsh(eastl::string_view(pHello)));
+		VERIFY(fsh(u"hello") == fsh(eastl::u16string(u"hello")));
+		VERIFY(fsh(u"hello") != fsh("hello")); // Wide characters hash their full byte representation.
+		VERIFY(fsh("") == fsh(eastl::string()));
+
+		// Every prefix length of a long string, which covers each tail-handling path, must hash uniquely.
+		char buffer[256];
+		for(int i = 0; i < 255; i++)
+			buffer[i] = (char)('a' + (i % 26));
+
+		eastl::hash_set<size_t> hashValues;
+		for(size_t i = 0; i < 255; i++)
+			VERIFY(hashValues.insert(fsh(eastl::string_view(buffer, i))).second);
+
+		// Flipping any single bit of a key must change the hash.
+		eastl::string key("The quick brown fox jumps over the lazy dog");
+		const size_t h = fsh(key);
+		for(eastl_size_t i = 0; i < key.size(); i++)
+		{
+			for(int b = 0; b < 8; b++)
+			{
+				key[i] ^= (char)(1 << b);
+				VERIFY(fsh(key) != h);
+				key[i] ^= (char)(1 << b);
+			}
+		}
+		VERIFY(fsh(key) == h);
+
+		hash_map<eastl::string, int, fast_string_hash> hashMap;
+		for(int i = 0; i < 1000; i++)
+			hashMap[eastl::string(eastl::string::CtorSprintf(), "key%d", i)] = i;
+
+		VERIFY(hashMap.validate());
+		VERIFY(hashMap.find_as("key37", fast_string_hash(), eastl::equal_to<>())->second == 37);
+		VERIFY(hashMap.find_as("key1000", fast_string_hash(), eastl::equal_to<>()) == hashMap.end());
+
+		#if EASTL_STRING_HASH_FAST
+			VERIFY(eastl::hash<eastl::string>()(key) == fsh(key));
+			VERIFY(eastl::hash<const char*>()(pHello) == fsh(pHello));
+		#endif
+	}
+
+	{ // Test transparent (heterogeneous) lookup
+		// hash<basic_string> hashes string views and character pointers the same as strings.
+		const eastl::string s("transparent");
+		VERIFY(eastl::hash<eastl::string>()(s) == eastl::hash<eastl::string>()(eastl::string_view(s)));
+		VERIFY(eastl::hash<eastl::string>()(s) == eastl::hash<eastl::string>()(s.c_str()));
+		VERIFY(eastl::hash<eastl::string16>()(eastl::string16(u"abc")) == eastl::hash<eastl::string16>()(u"abc"));
+		VERIFY(eastl::hash<eastl::string32>()(eastl::string32(U"abc")) == eastl::hash<eastl::string32>()(eastl::u32string_view(U"abc")));
+
+		const eastl::string sEmbeddedZero("ab\0cd", 5);
+		VERIFY(eastl::hash<eastl::string>()(sEmbeddedZero) == eastl::hash<eastl::string>()(eastl::string_view(sEmbeddedZero)));
+
+		typedef hash_map<eastl::string, int, eastl::hash<eastl::string>, eastl::equal_to<>> TransparentMap;
+		TransparentMap hashMap;
+
+		for(int i = 0; i < 100; i++)
+			hashMap[eastl::string(eastl::string::CtorSprintf(), "%d", i)] = i;
+
+		const char buffer[] = "4217";
+		VERIFY(hashMap.find(eastl::string_view(buffer, 2))->second == 42); // The view is not zero-terminated.
+		VERIFY(hashMap.find("42")->second == 42);
+		VERIFY(hashMap.find(eastl::string("42"))->second == 42);
+		VERIFY(hashMap.find(eastl::string_view("420")) == hashMap.end());
+		VERIFY(hashMap.count(eastl::string_view(buffer, 2)) == 1);
+		VERIFY(hashMap.count("420") == 0);
+		VERIFY(hashMap.contains(eastl::string_view(buffer + 1, 1)));
+		VERIFY(!hashMap.contains("-1"));
+
+		const TransparentMap& constHashMap = hashMap;
+		VERIFY(constHashMap.find(eastl::string_view(buffer, 1))->second == 4);
+		auto constRange = constHashMap.equal_range(eastl::string_view(buffer, 1));
+		VERIFY(eastl::distance(constRange.first, constRange.second) == 1);
+
+		VERIFY(hashMap.erase(eastl::string_view(buffer, 2)) == 1);
+		VERIFY(hashMap.erase("42") == 0);
+		VERIFY(hashMap.size() == 99);
+
+		// Erasing with a view of the key being erased must not read freed memory.
+		TransparentMap::iterator it = hashMap.find("17");
+		VERIFY(hashMap.erase(eastl::string_view(it->first)) == 1);
+		VERIFY(hashMap.validate() && (hashMap.size() == 98));
+
+		// Multi-key containers and cached hash codes.
+		hash_multimap<eastl::string, int, eastl::hash<eastl::string>, eastl::equal_to<>, EASTLAllocatorType, true> hashMultiMap;
+		for(int i = 0; i < 10; i++)
+		{
+			hashMultiMap.insert(eastl::make_pair(eastl::string("dup"), i));
+			hashMultiMap.insert(eastl::make_pair(eastl::string(eastl::string::CtorSprintf(), "%d", i), i));
+		}
+
+		auto range = hashMultiMap.equal_range(eastl::string_view("dup"));
+		VERIFY(eastl::distance(range.first, range.second) == 10);
+		VERIFY(hashMultiMap.count("dup") == 10);
+		VERIFY(hashMultiMap.erase(eastl::string_view("dup")) == 10);
+		VERIFY(hashMultiMap.validate() && (hashMultiMap.size() == 10));
+
+		// Without a transparent predicate, lookups convert to the key type as before.
+		hash_set<eastl::string> hashSet;
+		hashSet.insert("abc");
+		VERIFY(hashSet.find("abc") != hashSet.end());
+		VERIFY(hashSet.contains(eastl::string("abc")));
+	}
+
+	{ // Test insert_bulk, insert_with_hash and find_with_hash
+		eastl::vector<eastl::pair<int, int>> values;
+		for(int i = 0; i < 10000; i++)
+			values.push_back(eastl::make_pair(i % 7000, i)); // Includes duplicate keys.
+
+		hash_map<int, int> hashMapBulk, hashMapRef;
+		hashMapBulk[5] = -5; // Already present keys must not be replaced.
+		hashMapRef[5]  = -5;
+
+		hashMapBulk.insert_bulk(values.begin(), values.end());
+		hashMapRef.insert(values.begin(), values.end());
+
+		VERIFY(hashMapBulk.validate());
+		VERIFY(hashMapBulk.size() == 7000);
+		VERIFY(hashMapBulk == hashMapRef);
+		VERIFY(hashMapBulk[5] == -5);
+		VERIFY(hashMapBulk.load_factor() <= hashMapBulk.get_max_load_factor());
+
+		hash_multimap<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, true> hashMultiMap;
+		hashMultiMap.insert_bulk(values.begin(), values.end());
+		hashMultiMap.insert_bulk(values.begin(), values.begin() + 10);
+		VERIFY(hashMultiMap.validate());
+		VERIFY(hashMultiMap.size() == 10010);
+		VERIFY(hashMultiMap.count(3) == 3);
+		auto range = hashMultiMap.equal_range(3);
+		VERIFY(eastl::distance(range.first, range.second) == 3); // Equal keys remain contiguous.
+
+		hash_set<int> hashSet;
+		eastl::vector<int> emptyVector;
+		hashSet.insert_bulk(emptyVector.begin(), emptyVector.end());
+		VERIFY(hashSet.empty() && hashSet.validate());
+
+		{
+			TestObject::Reset();
+			eastl::vector<TestObject> objects;
+			for(int i = 0; i < 100; i++)
+				objects.push_back(TestObject(i % 50));
+
+			hash_set<TestObject> objectSet;
+			objectSet.insert_bulk(objects.begin(), objects.end());
+			VERIFY(objectSet.validate() && (objectSet.size() == 50));
+			objects.clear();
+			objectSet.clear();
+			VERIFY(TestObject::IsClear());
+			TestObject::Reset();
+		}
+
+		// Hash once, then probe and insert into several tables sharing the hash function.
+		hash_map<eastl::string, int> hashMap1, hashMap2;
+		hash_map<eastl::string, int, eastl::hash<eastl::string>, eastl::equal_to<eastl::string>, EASTLAllocatorType, true> hashMap3;
+		const eastl::string key("shared key");
+		const size_t h = hashMap1.hash_function()(key);
+
+		VERIFY(hashMap1.insert_with_hash(h, eastl::make_pair(key, 1)).second);
+		VERIFY(!hashMap1.insert_with_hash(h, eastl::make_pair(key, 2)).second);
+		VERIFY(hashMap2.insert_with_hash(h, eastl::make_pair(key, 2)).second);
+		VERIFY(hashMap3.insert_with_hash((uint32_t)h, eastl::make_pair(key, 3)).second);
+
+		VERIFY(hashMap1.find_with_hash(key, h)->second == 1);
+		VERIFY(hashMap2.find_with_hash(key, h)->second == 2);
+		VERIFY(hashMap3.find_with_hash(key, (uint32_t)h)->second == 3);
+		VERIFY(hashMap3.find(key)->second == 3);
+		VERIFY(hashMap2.find_with_hash(eastl::string("other"), hashMap2.hash_function()(eastl::string("other"))) == hashMap2.end());
+	}
+
+	{ // Test find_batch
+		hash_map<int, int> hashMap;
+		for(int i = 0; i < 1000; i += 2)
+			hashMap[i] = -i;
+
+		const int kKeyCount = 53; // Not a multiple of the internal group size.
+		int keys[kKeyCount];
+		for(int i = 0; i < kKeyCount; i++)
+			keys[i] = i * 7;
+
+		hash_map<int, int>::iterator results[kKeyCount];
+		hashMap.find_batch(keys, kKeyCount, results);
+
+		for(int i = 0; i < kKeyCount; i++)
+			VERIFY(results[i] == hashMap.find(keys[i]));
+
+		const hash_map<int, int>& constHashMap = hashMap;
+		hash_map<int, int>::const_iterator constResults[kKeyCount];
+		constHashMap.find_batch(keys, kKeyCount, constResults);
+
+		for(int i = 0; i < kKeyCount; i++)
+			VERIFY(constResults[i] == constHashMap.find(keys[i]));
+
+		hash_set<eastl::string, eastl::hash<eastl::string>, eastl::equal_to<eastl::string>, EASTLAllocatorType, true> stringSet;
+		stringSet.insert("a");
+		stringSet.insert("b");
+		const eastl::string stringKeys[3] = { "b", "c", "a" };
+		decltype(stringSet)::iterator stringResults[3];
+		stringSet.find_batch(stringKeys, 3, stringResults);
+		VERIFY((*stringResults[0] == "b") && (stringResults[1] == stringSet.end()) && (*stringResults[2] == "a"));
+
+		hash_map<int, int> emptyMap;
+		emptyMap.find_batch(keys, kKeyCount, results);
+		VERIFY(results[0] == emptyMap.end());
+		emptyMap.find_batch(keys, 0, results);
+	}
+
+	{ // Test incremental_rehash_policy
+		typedef hashtable<int, eastl::pair<const int, TestObject>, eastl::allocator, eastl::use_first<eastl::pair<const int, TestObject>>,
+						  eastl::equal_to<int>, eastl::hash<int>, mod_range_hashing, default_ranged_hash,
+						  incremental_rehash_policy, false, true, true> IncrementalHashMap;
+		typedef hashtable<int, eastl::pair<const int, int>, eastl::allocator, eastl::use_first<eastl::pair<const int, int>>,
+						  eastl::equal_to<int>, eastl::hash<int>, mod_range_hashing, default_ranged_hash,
+						  incremental_rehash_policy, true, true, false> IncrementalHashMultiMap;
+
+		TestObject::Reset();
+
+		{
+			IncrementalHashMap hashMap(0, eastl::hash<int>(), mod_range_hashing(), default_ranged_hash(),
+									   eastl::equal_to<int>(), eastl::use_first<eastl::pair<const int, TestObject>>());
+			hash_map<int, int> refMap;
+			EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+			hashMap.rehash_policy(incremental_rehash_policy(1.f, 1)); // Move as little as possible per operation, to keep rehashes in progress.
+			VERIFY(!hashMap.rehash_in_progress());
+
+			bool bSawRehash = false;
+
+			for(int i = 0; i < 20000; i++)
+			{
+				const int k = (int)rng.RandLimit(30000);
+
+				switch(rng.RandLimit(4))
+				{
+					case 0:
+					case 1:
+					{
+						const eastl_size_t nBucketCount = hashMap.bucket_count();
+						const bool bInserted = hashMap.insert(eastl::make_pair(k, TestObject(i))).second;
+						VERIFY(bInserted == refMap.insert(eastl::make_pair(k, i)).second);
+
+						if((nBucketCount > 2) && (hashMap.bucket_count() != nBucketCount))
+						{
+							VERIFY(hashMap.rehash_in_progress());
+							bSawRehash = true;
+						}
+						break;
+					}
+
+					case 2:
+						VERIFY(hashMap.erase(k) == refMap.erase(k));
+						break;
+
+					case 3:
+					{
+						const IncrementalHashMap& constHashMap = hashMap;
+						IncrementalHashMap::const_iterator it = constHashMap.find(k);
+						hash_map<int, int>::iterator itRef = refMap.find(k);
+						VERIFY((it == constHashMap.end()) == (itRef == refMap.end()));
+						if(itRef != refMap.end())
+							VERIFY(it->second.mX == itRef->second);
+						VERIFY(constHashMap.count(k) == refMap.count(k));
+						break;
+					}
+				}
+
+				VERIFY(hashMap.size() == refMap.size());
+			}
+
+			VERIFY(bSawRehash);
+
+			// Copying, moving and swapping a table in the middle of a rehash.
+			for(int i = 0; !hashMap.rehash_in_progress(); i++)
+			{
+				hashMap.insert(eastl::make_pair(30000 + i, TestObject(i)));
+				refMap.insert(eastl::make_pair(30000 + i, i));
+			}
+			for(int i = 0; i < 5; i++)
+				hashMap.insert(eastl::make_pair(60000 + i, TestObject(i))); // Move a few more buckets.
+			for(int i = 0; i < 5; i++)
+				refMap.insert(eastl::make_pair(60000 + i, i));
+
+			IncrementalHashMap hashMapCopy(hashMap); // The copy has every element in its current bucket array. The source is untouched.
+			VERIFY(hashMap.rehash_in_progress() && !hashMapCopy.rehash_in_progress());
+			VERIFY(hashMapCopy.validate() && (hashMapCopy.size() == hashMap.size()));
+
+			for(hash_map<int, int>::iterator it = refMap.begin(); it != refMap.end(); ++it)
+			{
+				IncrementalHashMap::iterator itFind = hashMapCopy.find(it->first);
+				VERIFY((itFind != hashMapCopy.end()) && (itFind->second.mX == it->second));
+			}
+
+			IncrementalHashMap hashMapMoved(eastl::move(hashMap));
+			VERIFY(hashMapMoved.rehash_in_progress() && !hashMap.rehash_in_progress());
+			VERIFY(hashMap.empty() && hashMap.validate());
+
+			hashMap.swap(hashMapMoved);
+			VERIFY(hashMap.rehash_in_progress() && !hashMapMoved.rehash_in_progress());
+
+			for(hash_map<int, int>::iterator it = refMap.begin(); it != refMap.end(); ++it)
+			{
+				IncrementalHashMap::iterator itFind = hashMap.find(it->first);
+				VERIFY((itFind != hashMap.end()) && (itFind->second.mX == it->second));
+			}
+
+			// Iteration visits the old bucket array and then the new one, and neither it nor the
+			// lookups made during it move any element, so every element is visited once.
+			const IncrementalHashMap& constHashMap = hashMap;
+			eastl_size_t nIterCount = 0;
+			for(IncrementalHashMap::const_iterator it = constHashMap.begin(); it != constHashMap.end(); ++it)
+			{
+				hash_map<int, int>::iterator itRef = refMap.find(it->first);
+				VERIFY((itRef != refMap.end()) && (it->second.mX == itRef->second));
+				VERIFY(constHashMap.find(it->first) != constHashMap.end());
+				VERIFY(hashMap.count(it->first) == 1);
+				++nIterCount;
+			}
+			VERIFY(hashMap.rehash_in_progress());
+			VERIFY((nIterCount == hashMap.size()) && hashMap.validate());
+			VERIFY(hashMap.size() == refMap.size());
+
+			// Erasing while iterating, from either bucket array.
+			for(IncrementalHashMap::iterator it = hashMap.begin(); it != hashMap.end(); )
+			{
+				if(it->first & 1)
+				{
+					VERIFY(refMap.erase(it->first) == 1);
+					it = hashMap.erase(it);
+				}
+				else
+					++it;
+			}
+			VERIFY(hashMap.rehash_in_progress());
+			VERIFY(hashMap.validate() && (hashMap.size() == refMap.size()));
+
+			// Clearing a table in the middle of a rehash.
+			for(int i = 0; !hashMapCopy.rehash_in_progress(); i++)
+				hashMapCopy.insert(eastl::make_pair(40000 + i, TestObject(i)));
+			hashMapCopy.clear();
+			VERIFY(!hashMapCopy.rehash_in_progress() && hashMapCopy.empty() && hashMapCopy.validate());
+
+			// Destroying a table in the middle of a rehash.
+			for(int i = 0; !hashMap.rehash_in_progress(); i++)
+				hashMap.insert(eastl::make_pair(50000 + i, TestObject(i)));
+		}
+
+		VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+
+		{
+			IncrementalHashMultiMap hashMultiMap(0, eastl::hash<int>(), mod_range_hashing(), default_ranged_hash(),
+												 eastl::equal_to<int>(), eastl::use_first<eastl::pair<const int, int>>());
+			hashMultiMap.set_max_load_factor(2.f);
+			VERIFY(hashMultiMap.get_max_load_factor() == 2.f);
+
+			for(int i = 0; i < 3000; i++)
+			{
+				hashMultiMap.insert(eastl::make_pair(i % 1000, i));
+
+				const int k = (i * 7) % 1000;
+				const eastl_size_t nCount = (eastl_size_t)((i / 1000) + ((k <= (i % 1000)) ? 1 : 0));
+				VERIFY(hashMultiMap.count(k) == nCount);
+
+				// Equal elements stay adjacent while they are moved between bucket arrays.
+				eastl::pair<IncrementalHashMultiMap::iterator, IncrementalHashMultiMap::iterator> range = hashMultiMap.equal_range(k);
+				VERIFY((eastl_size_t)eastl::distance(range.first, range.second) == nCount);
+			}
+
+			VERIFY(hashMultiMap.find_by_hash(eastl::hash<int>()(7)) != hashMultiMap.end());
+			VERIFY(hashMultiMap.validate() && (hashMultiMap.size() == 3000));
+		}
+	}
+
 	{ // User reported regression for code changes limiting hash code generated for non-arithmetic types.
 	    { VERIFY(HashTest<char>{}('a') == size_t('a')); }
 	    { VERIFY(HashTest<int>{}(42) == 42); }
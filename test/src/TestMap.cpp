@@ -288,6 +288,47 @@ int TestMap()
 	}
 #endif
 
+#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+	{ // nth / rank
+		eastl::map<int, int> m;
+		eastl::multimap<int, int> mm;
+
+		for(int i = 0; i < 500; i++)
+		{
+			m[(i * 37) % 500] = i;
+			mm.insert(eastl::make_pair(i % 50, i));
+		}
+
+		for(int i = 0; i < 500; i += 3)
+		{
+			m.erase(i);
+			mm.erase(mm.nth((size_t)(i % (int)mm.size())));
+		}
+
+		VERIFY(m.validate() && mm.validate());
+
+		eastl_size_t r = 0;
+		for(auto it = m.begin(); it != m.end(); ++it, ++r)
+		{
+			VERIFY(m.nth(r) == it);
+			VERIFY(m.rank(it) == r);
+		}
+		VERIFY(m.nth(m.size()) == m.end());
+		VERIFY(m.rank(m.end()) == m.size());
+
+		r = 0;
+		for(auto it = mm.cbegin(); it != mm.cend(); ++it, ++r)
+		{
+			VERIFY(mm.nth(r) == it);
+			VERIFY(mm.rank(it) == r);
+		}
+
+		// Percentile-style query: the median key.
+		const eastl::map<int, int>& mc = m;
+		VERIFY(mc.nth(mc.size() / 2) == eastl::next(mc.begin(), (ptrdiff_t)(mc.size() / 2)));
+	}
+#endif
+
 	return nErrorCount;
 }
 
@@ -26,6 +26,29 @@ public:
 };
 typedef eastl::vector<AssetHandler> AssetHandlerArray;
 
+
+// A type with a non-trivial move constructor and destructor which is declared trivially relocatable, 
+// so that tests can tell whether it was relocated with memmove or moved and destroyed.
+struct RelocatableCounter
+{
+	int mX;
+
+	static int sMoveCount;
+	static int sDtorCount;
+
+	explicit RelocatableCounter(int x = 0) : mX(x) {}
+	RelocatableCounter(const RelocatableCounter& x) : mX(x.mX) {}
+	RelocatableCounter(RelocatableCounter&& x) : mX(x.mX) { ++sMoveCount; }
+	RelocatableCounter& operator=(const RelocatableCounter&) = default;
+	RelocatableCounter& operator=(RelocatableCounter&&) = default;
+	~RelocatableCounter() { ++sDtorCount; }
+};
+
+int RelocatableCounter::sMoveCount = 0;
+int RelocatableCounter::sDtorCount = 0;
+
+EASTL_DECLARE_TRIVIALLY_RELOCATABLE(RelocatableCounter)
+
 // Regression test for a default memory fill optimization that defers to memset instead of explicitly
 // value-initialization each element in a vector individually.  This test ensures that the value of the memset is
 // consistent with an explicitly value-initialized element (namely when the container holds a scalar value that is
@@ -409,6 +432,72 @@ int TestMemory()
 	EASTL_INTERNAL_RESTORE_DEPRECATED()
 
 
+	{
+		// template <typename ForwardIterator, typename ForwardIteratorDest>
+		// ForwardIteratorDest uninitialized_relocate(ForwardIterator first, ForwardIterator last, ForwardIteratorDest dest)
+
+		static_assert(eastl::is_trivially_relocatable<RelocatableCounter>::value, "is_trivially_relocatable failure");
+		static_assert(!eastl::is_trivially_relocatable<TestObject>::value, "is_trivially_relocatable failure");
+
+		{   // Types that aren't trivially relocatable are moved, and the sources destroyed.
+			TestObject::Reset();
+
+			alignas(TestObject) char source[sizeof(TestObject) * 3];
+			alignas(TestObject) char dest[sizeof(TestObject) * 3];
+			TestObject* const pSource = reinterpret_cast<TestObject*>(source);
+			TestObject* const pDest   = reinterpret_cast<TestObject*>(dest);
+
+			for(int i = 0; i < 3; i++)
+				::new(pSource + i) TestObject(i);
+
+			TestObject* const pDestEnd = eastl::uninitialized_relocate(pSource, pSource + 3, pDest);
+			EATEST_VERIFY(pDestEnd == pDest + 3);
+			EATEST_VERIFY((pDest[0].mX == 0) && (pDest[1].mX == 1) && (pDest[2].mX == 2));
+			EATEST_VERIFY(TestObject::sTOCount == 3);
+			EATEST_VERIFY(TestObject::sTOMoveCtorCount == 3);
+			EATEST_VERIFY(TestObject::sTODtorCount == 3);
+
+			eastl::destruct(pDest, pDestEnd);
+			EATEST_VERIFY(TestObject::IsClear());
+			TestObject::Reset();
+		}
+
+		{   // Trivially relocatable types are memmoved; no move constructors or destructors run.
+			RelocatableCounter::sMoveCount = RelocatableCounter::sDtorCount = 0;
+
+			alignas(RelocatableCounter) char source[sizeof(RelocatableCounter) * 3];
+			alignas(RelocatableCounter) char dest[sizeof(RelocatableCounter) * 3];
+			RelocatableCounter* const pSource = reinterpret_cast<RelocatableCounter*>(source);
+			RelocatableCounter* const pDest   = reinterpret_cast<RelocatableCounter*>(dest);
+
+			for(int i = 0; i < 3; i++)
+				::new(pSource + i) RelocatableCounter(i);
+
+			RelocatableCounter* const pDestEnd = eastl::uninitialized_relocate(pSource, pSource + 3, pDest);
+			EATEST_VERIFY(pDestEnd == pDest + 3);
+			EATEST_VERIFY((pDest[0].mX == 0) && (pDest[1].mX == 1) && (pDest[2].mX == 2));
+			EATEST_VERIFY((RelocatableCounter::sMoveCount == 0) && (RelocatableCounter::sDtorCount == 0));
+
+			eastl::destruct(pDest, pDestEnd);
+			EATEST_VERIFY(RelocatableCounter::sDtorCount == 3);
+		}
+
+		{   // vector growth relocates trivially relocatable elements instead of moving them.
+			RelocatableCounter::sMoveCount = RelocatableCounter::sDtorCount = 0;
+
+			eastl::vector<RelocatableCounter> v;
+			for(int i = 0; i < 1024; i++)
+				v.emplace_back(i);
+			v.insert(v.begin() + 10, 5, RelocatableCounter(-1)); // size() == capacity(), so this reallocates.
+			v.resize(v.capacity() + 1);
+
+			EATEST_VERIFY(RelocatableCounter::sMoveCount == 0);
+			EATEST_VERIFY(RelocatableCounter::sDtorCount == 1); // Only the temporary passed to insert.
+			EATEST_VERIFY((v[9].mX == 9) && (v[10].mX == -1) && (v[15].mX == 10) && (v[1028].mX == 1023));
+		}
+	}
+
+
 
 	{
 		// template <typename InputIterator, typename ForwardIterator>
@@ -0,0 +1,687 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/memory_reclamation.h>
+#include <EASTL/intrusive_ptr.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+#include <eathread/eathread_thread.h>
+#include <atomic>
+
+
+using namespace eastl;
+
+
+namespace
+{
+	const uint32_t kAlive = 0xA11FE000;
+	const uint32_t kDead  = 0xDEADBEEF;
+
+	std::atomic<int> gnLiveCount(0);
+
+
+	// Counts the live objects, and marks itself dead on destruction so that a use after
+	// retirement shows up as a bad mnPoison as well as under address sanitizers.
+	struct Tracked
+	{
+		uint32_t mnPoison;
+		int      mnValue;
+
+		explicit Tracked(int nValue = 0) : mnPoison(kAlive), mnValue(nValue) { gnLiveCount.fetch_add(1); }
+		~Tracked() { mnPoison = kDead; gnLiveCount.fetch_sub(1); }
+	};
+
+
+	struct CountingDeleter
+	{
+		int* mpDeleteCount;
+
+		explicit CountingDeleter(int* pDeleteCount = NULL) : mpDeleteCount(pDeleteCount) {}
+
+		template <typename T>
+		void operator()(T* p) const
+		{
+			if(mpDeleteCount)
+				++*mpDeleteCount;
+			delete p;
+		}
+	};
+
+
+	struct EbrTracked : public Tracked, public ebr_obj_base<EbrTracked, CountingDeleter>
+	{
+		explicit EbrTracked(int nValue = 0) : Tracked(nValue) {}
+	};
+
+
+	struct HazardTracked : public Tracked, public hazard_pointer_obj_base<HazardTracked>
+	{
+		explicit HazardTracked(int nValue = 0) : Tracked(nValue) {}
+	};
+
+
+	// An intrusively reference counted object, which is found by intrusive_ptr through
+	// its AddRef and Release members.
+	struct RefCounted : public Tracked
+	{
+		std::atomic<int> mnRefCount;
+
+		explicit RefCounted(int nValue = 0) : Tracked(nValue), mnRefCount(0) {}
+
+		void AddRef() { mnRefCount.fetch_add(1, std::memory_order_relaxed); }
+
+		void Release()
+		{
+			if(mnRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				delete this;
+		}
+	};
+
+
+	// A Treiber stack whose popped nodes are retired to a reclamation domain. The Policy
+	// protects the head while a pop reads it.
+	template <typename Node, typename Policy>
+	struct TreiberStack
+	{
+		std::atomic<Node*> mpHead;
+
+		TreiberStack() : mpHead(NULL) {}
+
+		void Push(Node* pNode)
+		{
+			pNode->mpNext = mpHead.load(std::memory_order_relaxed);
+			while(!mpHead.compare_exchange_weak(pNode->mpNext, pNode, std::memory_order_release, std::memory_order_relaxed))
+				{ }
+		}
+
+		// Returns the popped value, or -1 if the stack was empty. Sets bPoisoned if a node
+		// which had already been freed was read.
+		int Pop(Policy& policy, bool& bPoisoned)
+		{
+			return policy.Pop(mpHead, bPoisoned);
+		}
+	};
+
+
+	struct EbrNode : public Tracked, public ebr_obj_base<EbrNode>
+	{
+		EbrNode* mpNext;
+		explicit EbrNode(int nValue) : Tracked(nValue), mpNext(NULL) {}
+	};
+
+	struct HazardNode : public Tracked, public hazard_pointer_obj_base<HazardNode>
+	{
+		HazardNode* mpNext;
+		explicit HazardNode(int nValue) : Tracked(nValue), mpNext(NULL) {}
+	};
+
+
+	struct EbrPopPolicy
+	{
+		ebr_domain* mpDomain;
+
+		explicit EbrPopPolicy(ebr_domain& domain) : mpDomain(&domain) {}
+
+		int Pop(std::atomic<EbrNode*>& head, bool& bPoisoned)
+		{
+			EbrNode* pNode;
+
+			{
+				ebr_domain::guard guard(*mpDomain);
+
+				pNode = head.load(std::memory_order_acquire);
+				while(pNode)
+				{
+					bPoisoned |= (pNode->mnPoison != kAlive);
+
+					if(head.compare_exchange_weak(pNode, pNode->mpNext, std::memory_order_acquire, std::memory_order_acquire))
+						break;
+				}
+			}
+
+			if(!pNode)
+				return -1;
+
+			const int nValue = pNode->mnValue;
+			pNode->retire(default_delete<EbrNode>(), *mpDomain);
+			return nValue;
+		}
+	};
+
+
+	struct HazardPopPolicy
+	{
+		hazard_domain* mpDomain;
+		hazard_pointer mHazardPointer;
+
+		explicit HazardPopPolicy(hazard_domain& domain) : mpDomain(&domain), mHazardPointer(make_hazard_pointer(domain)) {}
+
+		int Pop(std::atomic<HazardNode*>& head, bool& bPoisoned)
+		{
+			HazardNode* pNode;
+
+			for(;;)
+			{
+				pNode = mHazardPointer.protect(head);
+
+				if(!pNode)
+					break;
+
+				bPoisoned |= (pNode->mnPoison != kAlive);
+
+				if(head.compare_exchange_strong(pNode, pNode->mpNext, std::memory_order_acquire, std::memory_order_relaxed))
+					break;
+			}
+
+			mHazardPointer.reset_protection();
+
+			if(!pNode)
+				return -1;
+
+			const int nValue = pNode->mnValue;
+			pNode->retire(default_delete<HazardNode>(), *mpDomain);
+			return nValue;
+		}
+	};
+
+
+	template <typename Domain>
+	int TestRetireBasics(Domain& domain, int& nDeleteCount)
+	{
+		int nErrorCount = 0;
+
+		domain.retire((Tracked*)NULL); // A null pointer is ignored.
+		domain.retire(new Tracked(1));
+		domain.retire(new Tracked(2), CountingDeleter(&nDeleteCount));
+		domain.retire(new Tracked[3], default_delete<Tracked[]>());
+
+		EATEST_VERIFY(gnLiveCount.load() == 5);
+		EATEST_VERIFY(nDeleteCount == 0);
+
+		return nErrorCount;
+	}
+}
+
+
+#if EASTL_THREAD_SUPPORT_AVAILABLE
+	namespace
+	{
+		const int kStackThreadCount = 4;
+		const int kStackOpCount     = 20000;
+
+		// Pushes and pops nodes on a shared stack. Each pushed value is unique, and the
+		// sums of pushed and popped values are kept so that the main thread can check that
+		// every value was popped exactly once.
+		template <typename Node, typename Policy, typename Domain>
+		struct StackThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters   mThreadParams;
+			EA::Thread::Thread             mThread;
+			TreiberStack<Node, Policy>*    mpStack;
+			Domain*                        mpDomain;
+			std::atomic<int>*              mpStartedCount;
+			int                            mnThreadIndex;
+			int64_t                        mnPushedSum;
+			int64_t                        mnPoppedSum;
+			bool                           mbPoisoned;
+
+			StackThread() : mThreadParams(), mThread(), mpStack(NULL), mpDomain(NULL), mpStartedCount(NULL), mnThreadIndex(0), mnPushedSum(0), mnPoppedSum(0), mbPoisoned(false) {}
+			StackThread(const StackThread&) = delete;
+			void operator=(const StackThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				Policy policy(*mpDomain);
+
+				mpStartedCount->fetch_add(1);
+				while(mpStartedCount->load() < kStackThreadCount)
+					EA::Thread::ThreadSleep(0);
+
+				for(int i = 0; i < kStackOpCount; i++)
+				{
+					const int nValue = (mnThreadIndex * kStackOpCount) + i;
+
+					mpStack->Push(new Node(nValue));
+					mnPushedSum += nValue;
+
+					// Pop more often than not, so that the stack stays short and the
+					// threads keep contending for the same nodes.
+					for(int j = 0; j < (1 + (i % 2)); j++)
+					{
+						const int nPopped = mpStack->Pop(policy, mbPoisoned);
+
+						if(nPopped >= 0)
+							mnPoppedSum += nPopped;
+					}
+				}
+
+				return 0;
+			}
+		};
+
+
+		template <typename Node, typename Policy, typename Domain>
+		int TestStackThreads(Domain& domain)
+		{
+			int nErrorCount = 0;
+
+			typedef StackThread<Node, Policy, Domain> Thread;
+
+			TreiberStack<Node, Policy> stack;
+			eastl::vector<Thread>      threads(kStackThreadCount);
+			std::atomic<int>           nStartedCount(0);
+
+			for(int t = 0; t < kStackThreadCount; t++)
+			{
+				threads[t].mpStack        = &stack;
+				threads[t].mpDomain       = &domain;
+				threads[t].mpStartedCount = &nStartedCount;
+				threads[t].mnThreadIndex  = t;
+				threads[t].mThreadParams.mpName = "ReclamationStackThread";
+			}
+
+			for(int t = 0; t < kStackThreadCount; t++)
+				threads[t].mThread.Begin(&threads[t], NULL, &threads[t].mThreadParams);
+
+			int64_t nPushedSum = 0;
+			int64_t nPoppedSum = 0;
+
+			for(int t = 0; t < kStackThreadCount; t++)
+			{
+				threads[t].mThread.WaitForEnd();
+				EATEST_VERIFY(!threads[t].mbPoisoned);
+				nPushedSum += threads[t].mnPushedSum;
+				nPoppedSum += threads[t].mnPoppedSum;
+			}
+
+			{
+				Policy policy(domain);
+				bool   bPoisoned = false;
+
+				for(int nPopped; (nPopped = stack.Pop(policy, bPoisoned)) >= 0; )
+					nPoppedSum += nPopped;
+
+				EATEST_VERIFY(!bPoisoned);
+			}
+
+			EATEST_VERIFY(nPushedSum == nPoppedSum);
+
+			return nErrorCount;
+		}
+
+
+		// Loads the shared object until told to stop, checking that it is still alive.
+		template <typename Domain>
+		struct SnapshotReaderThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters mThreadParams;
+			EA::Thread::Thread           mThread;
+			std::atomic<RefCounted*>*    mpSource;
+			Domain*                      mpDomain;
+			std::atomic<bool>*           mpShouldContinue;
+			bool                         mbPoisoned;
+
+			SnapshotReaderThread() : mThreadParams(), mThread(), mpSource(NULL), mpDomain(NULL), mpShouldContinue(NULL), mbPoisoned(false) {}
+			SnapshotReaderThread(const SnapshotReaderThread&) = delete;
+			void operator=(const SnapshotReaderThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				DoRun(*mpDomain);
+				return 0;
+			}
+
+			void DoRun(ebr_domain& domain)
+			{
+				while(mpShouldContinue->load(std::memory_order_relaxed))
+				{
+					intrusive_ptr<RefCounted> p = atomic_load_intrusive(*mpSource, domain);
+					mbPoisoned |= (p->mnPoison != kAlive);
+				}
+			}
+
+			void DoRun(hazard_domain& domain)
+			{
+				hazard_pointer hp = make_hazard_pointer(domain);
+
+				while(mpShouldContinue->load(std::memory_order_relaxed))
+				{
+					intrusive_ptr<RefCounted> p = atomic_load_intrusive(*mpSource, hp);
+					mbPoisoned |= (p->mnPoison != kAlive);
+				}
+			}
+		};
+
+
+		template <typename Domain>
+		int TestSnapshotThreads(Domain& domain)
+		{
+			int nErrorCount = 0;
+
+			const int kReaderCount = 3;
+
+			std::atomic<RefCounted*>                   source(intrusive_ptr<RefCounted>(new RefCounted(0)).detach());
+			eastl::vector<SnapshotReaderThread<Domain>> readers(kReaderCount);
+			std::atomic<bool>                          bShouldContinue(true);
+
+			for(int t = 0; t < kReaderCount; t++)
+			{
+				readers[t].mpSource         = &source;
+				readers[t].mpDomain         = &domain;
+				readers[t].mpShouldContinue = &bShouldContinue;
+				readers[t].mThreadParams.mpName = "ReclamationSnapshotThread";
+				readers[t].mThread.Begin(&readers[t], NULL, &readers[t].mThreadParams);
+			}
+
+			for(int i = 1; i < 20000; i++)
+			{
+				atomic_exchange_intrusive(source, intrusive_ptr<RefCounted>(new RefCounted(i)), domain);
+				if((i % 64) == 0)
+					EA::Thread::ThreadSleep(0);
+			}
+
+			bShouldContinue.store(false, std::memory_order_relaxed);
+
+			for(int t = 0; t < kReaderCount; t++)
+			{
+				readers[t].mThread.WaitForEnd();
+				EATEST_VERIFY(!readers[t].mbPoisoned);
+			}
+
+			domain.retire(source.exchange(NULL), intrusive_release_deleter());
+
+			return nErrorCount;
+		}
+	}
+#endif
+
+
+int TestMemoryReclamation()
+{
+	int nErrorCount = 0;
+
+	gnLiveCount = 0;
+
+	{  // Test ebr_domain
+		{
+			ebr_domain domain;
+			int        nDeleteCount = 0;
+
+			EATEST_VERIFY(domain.epoch() == 1);
+
+			nErrorCount += TestRetireBasics(domain, nDeleteCount);
+
+			domain.synchronize();
+			EATEST_VERIFY(gnLiveCount.load() == 0);
+			EATEST_VERIFY(nDeleteCount == 1);
+			EATEST_VERIFY(domain.epoch() >= 3);
+		}
+
+		{   // An object isn't freed while a guard which could have seen it remains.
+			ebr_domain domain;
+
+			{
+				ebr_domain::guard guard(domain);
+				ebr_domain::guard nestedGuard(domain);
+
+				domain.retire(new Tracked);
+
+				for(int i = 0; i < 10; i++)
+					domain.collect();
+
+				EATEST_VERIFY(gnLiveCount.load() == 1);
+			}
+
+			size_t nFreed = 0;
+
+			for(int i = 0; (i < 3) && !nFreed; i++)
+				nFreed = domain.collect();
+
+			EATEST_VERIFY(nFreed == 1);
+			EATEST_VERIFY(gnLiveCount.load() == 0);
+		}
+
+		{   // Retiring past the threshold frees older objects without an explicit collect.
+			ebr_domain domain;
+
+			for(int i = 0; i < EASTL_EBR_RETIRE_THRESHOLD * 4; i++)
+				domain.retire(new Tracked(i));
+
+			EATEST_VERIFY(gnLiveCount.load() < EASTL_EBR_RETIRE_THRESHOLD * 4);
+		}
+
+		EATEST_VERIFY(gnLiveCount.load() == 0); // The destructor frees the rest.
+
+		{   // ebr_obj_base
+			ebr_domain domain;
+			int        nDeleteCount = 0;
+
+			(new EbrTracked(1))->retire(CountingDeleter(&nDeleteCount), domain);
+			(new EbrTracked(2))->retire(CountingDeleter(&nDeleteCount), domain);
+			EATEST_VERIFY(nDeleteCount == 0);
+
+			domain.synchronize();
+			EATEST_VERIFY(nDeleteCount == 2);
+			EATEST_VERIFY(gnLiveCount.load() == 0);
+		}
+
+		{   // Guards for more domains than the thread caches by default, nested inside each other.
+			const int kDomainCount = 6;
+
+			eastl::vector<eastl::unique_ptr<ebr_domain>> domains;
+
+			for(int i = 0; i < kDomainCount; i++)
+				domains.push_back(eastl::unique_ptr<ebr_domain>(new ebr_domain));
+
+			{
+				ebr_domain::guard guard0(*domains[0]);
+				ebr_domain::guard guard1(*domains[1]);
+				ebr_domain::guard guard2(*domains[2]);
+				ebr_domain::guard guard3(*domains[3]);
+				ebr_domain::guard guard4(*domains[4]);
+				ebr_domain::guard guard5(*domains[5]);
+
+				for(int i = 0; i < kDomainCount; i++)
+					domains[i]->retire(new Tracked(i));
+			}
+
+			for(int i = 0; i < kDomainCount; i++)
+				domains[i]->synchronize();
+
+			EATEST_VERIFY(gnLiveCount.load() == 0);
+
+			// A domain created at the address of a destroyed one doesn't reuse its state.
+			domains[0].reset();
+			domains[0].reset(new ebr_domain);
+			domains[0]->retire(new Tracked);
+			domains[0]->synchronize();
+			EATEST_VERIFY(gnLiveCount.load() == 0);
+		}
+
+		{   // The default domain
+			ebr_domain& domain = ebr_domain::get_default();
+
+			EATEST_VERIFY(&domain == &ebr_domain::get_default());
+
+			{
+				ebr_domain::guard guard;
+				domain.retire(new Tracked);
+			}
+
+			domain.synchronize();
+			EATEST_VERIFY(gnLiveCount.load() == 0);
+		}
+	}
+
+
+	{  // Test hazard_pointer
+		{
+			hazard_domain domain;
+			int           nDeleteCount = 0;
+
+			nErrorCount += TestRetireBasics(domain, nDeleteCount);
+			EATEST_VERIFY(domain.retired_count() == 3);
+
+			EATEST_VERIFY(domain.collect() == 3);
+			EATEST_VERIFY(nDeleteCount == 1);
+			EATEST_VERIFY(domain.retired_count() == 0);
+			EATEST_VERIFY(gnLiveCount.load() == 0);
+		}
+
+		{   // A protected object isn't freed until its protection ends.
+			hazard_domain          domain;
+			hazard_pointer         hp = make_hazard_pointer(domain);
+			std::atomic<Tracked*>  source(new Tracked(1));
+
+			EATEST_VERIFY(!hp.empty());
+
+			Tracked* const p = hp.protect(source);
+			EATEST_VERIFY(p && (p->mnValue == 1));
+
+			domain.retire(source.exchange(new Tracked(2)));
+			EATEST_VERIFY(domain.collect() == 0);
+			EATEST_VERIFY((gnLiveCount.load() == 2) && (p->mnPoison == kAlive));
+
+			Tracked* pStale = p;
+			EATEST_VERIFY(!hp.try_protect(pStale, source)); // source has changed since pStale was loaded.
+			EATEST_VERIFY(pStale && (pStale->mnValue == 2));
+			EATEST_VERIFY(domain.collect() == 1);           // The failed try_protect dropped the old protection.
+
+			hp.reset_protection(source.load());
+			domain.retire(source.exchange(NULL));
+			EATEST_VERIFY(domain.collect() == 0);
+
+			hp.reset_protection();
+			EATEST_VERIFY(domain.collect() == 1);
+			EATEST_VERIFY(gnLiveCount.load() == 0);
+
+			// Moving transfers the slot; an empty hazard_pointer has none.
+			hazard_pointer hp2(eastl::move(hp));
+			EATEST_VERIFY(hp.empty() && !hp2.empty());
+
+			swap(hp, hp2);
+			EATEST_VERIFY(!hp.empty() && hp2.empty());
+
+			hazard_pointer hp3;
+			EATEST_VERIFY(hp3.empty());
+			hp3 = eastl::move(hp);
+			EATEST_VERIFY(hp.empty() && !hp3.empty());
+		}
+
+		{   // Released slots are reused.
+			hazard_domain domain;
+			std::atomic<Tracked*> source(new Tracked);
+
+			for(int i = 0; i < 100; i++)
+			{
+				hazard_pointer hp = make_hazard_pointer(domain);
+				hp.protect(source);
+			}
+
+			domain.retire(source.exchange(NULL));
+			EATEST_VERIFY(domain.collect() == 1);
+		}
+
+		{   // hazard_pointer_obj_base, retired past the threshold.
+			hazard_domain domain;
+
+			for(int i = 0; i < EASTL_HAZARD_POINTER_RETIRE_THRESHOLD * 2; i++)
+				(new HazardTracked(i))->retire(default_delete<HazardTracked>(), domain);
+
+			EATEST_VERIFY(domain.retired_count() < EASTL_HAZARD_POINTER_RETIRE_THRESHOLD);
+			EATEST_VERIFY((size_t)gnLiveCount.load() == domain.retired_count());
+		}
+
+		EATEST_VERIFY(gnLiveCount.load() == 0); // The destructor frees the rest.
+	}
+
+
+	{  // Test atomic_load_intrusive / atomic_exchange_intrusive
+		{
+			hazard_domain            domain;
+			hazard_pointer           hp = make_hazard_pointer(domain);
+			std::atomic<RefCounted*> source(intrusive_ptr<RefCounted>(new RefCounted(1)).detach());
+
+			intrusive_ptr<RefCounted> p = atomic_load_intrusive(source, hp);
+			EATEST_VERIFY(p && (p->mnValue == 1) && (p->mnRefCount.load() == 2));
+
+			atomic_exchange_intrusive(source, intrusive_ptr<RefCounted>(new RefCounted(2)), domain);
+			EATEST_VERIFY(source.load()->mnRefCount.load() == 1);
+			EATEST_VERIFY(domain.collect() == 1);               // Gives up the reference which source held.
+			EATEST_VERIFY((gnLiveCount.load() == 2) && (p->mnRefCount.load() == 1));
+
+			p.reset();
+			EATEST_VERIFY(gnLiveCount.load() == 1);
+
+			p = atomic_load_intrusive(source, hp);
+			EATEST_VERIFY(p->mnValue == 2);
+
+			domain.retire(source.exchange(NULL), intrusive_release_deleter());
+		}
+
+		EATEST_VERIFY(gnLiveCount.load() == 0);
+
+		{
+			ebr_domain               domain;
+			std::atomic<RefCounted*> source(intrusive_ptr<RefCounted>(new RefCounted(1)).detach());
+
+			intrusive_ptr<RefCounted> p = atomic_load_intrusive(source, domain);
+			EATEST_VERIFY(p && (p->mnValue == 1) && (p->mnRefCount.load() == 2));
+
+			atomic_exchange_intrusive(source, intrusive_ptr<RefCounted>(new RefCounted(2)), domain);
+			domain.synchronize();
+			EATEST_VERIFY((gnLiveCount.load() == 2) && (p->mnRefCount.load() == 1));
+
+			p = atomic_load_intrusive(source, domain);
+			EATEST_VERIFY((gnLiveCount.load() == 1) && (p->mnValue == 2));
+
+			domain.retire(source.exchange(NULL), intrusive_release_deleter());
+		}
+
+		EATEST_VERIFY(gnLiveCount.load() == 0);
+	}
+
+
+	#if EASTL_THREAD_SUPPORT_AVAILABLE
+		{  // Test a lock-free stack whose nodes are reclaimed while other threads may read them.
+			{
+				ebr_domain domain;
+
+				nErrorCount += TestStackThreads<EbrNode, EbrPopPolicy>(domain);
+
+				domain.synchronize(); // Also frees what the exited threads retired.
+				EATEST_VERIFY(gnLiveCount.load() == 0);
+			}
+
+			{
+				hazard_domain domain;
+
+				nErrorCount += TestStackThreads<HazardNode, HazardPopPolicy>(domain);
+
+				domain.collect();
+				EATEST_VERIFY(gnLiveCount.load() == 0);
+			}
+		}
+
+		{  // Test intrusive_ptr snapshots which are replaced while other threads load them.
+			{
+				ebr_domain domain;
+				nErrorCount += TestSnapshotThreads(domain);
+				domain.synchronize();
+				EATEST_VERIFY(gnLiveCount.load() == 0);
+			}
+
+			{
+				hazard_domain domain;
+				nErrorCount += TestSnapshotThreads(domain);
+				domain.collect();
+				EATEST_VERIFY(gnLiveCount.load() == 0);
+			}
+		}
+	#endif
+
+	return nErrorCount;
+}
@@ -0,0 +1,405 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/rope.h>
+#include <EASTL/string.h>
+#include <EASTL/string_view.h>
+#include <EASTL/algorithm.h>
+
+
+using namespace eastl;
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::rope<char>;
+template class eastl::rope<char16_t>;
+template class eastl::rope<char32_t, InstanceAllocator>;
+
+
+// Returns true if r holds the same characters as s, checked through each of the ways
+// of reading a rope.
+template <typename Rope, typename String>
+static bool RopeMatches(const Rope& r, const String& s)
+{
+	typedef typename Rope::value_type value_type;
+
+	if(!r.validate() || (r.size() != s.size()) || (r.empty() != s.empty()))
+		return false;
+
+	if(r.str() != s)
+		return false;
+
+	if(!eastl::equal(r.begin(), r.end(), s.begin()))
+		return false;
+
+	if(!eastl::equal(r.rbegin(), r.rend(), s.rbegin()))
+		return false;
+
+	eastl_size_t nPosition = 0;
+	for(const basic_string_view<value_type>& chunk : r.chunks())
+	{
+		if(chunk.empty() || (s.compare(nPosition, chunk.size(), chunk.data(), chunk.size()) != 0))
+			return false;
+		nPosition += chunk.size();
+	}
+
+	if(nPosition != s.size())
+		return false;
+
+	for(eastl_size_t i = 0; i < s.size(); i += 1 + (s.size() / 64))
+	{
+		if(r[i] != s[i])
+			return false;
+	}
+
+	return true;
+}
+
+
+int TestRope()
+{
+	int nErrorCount = 0;
+
+	{
+		// rope();
+		// rope(const value_type* p);
+		// rope(const value_type* p, size_type n);
+		// rope(const view_type& sv);
+		// rope(const basic_string<T, OtherAllocator>& x);
+		rope<char> r1;
+		EATEST_VERIFY(r1.empty());
+		EATEST_VERIFY(r1.size() == 0);
+		EATEST_VERIFY(r1.begin() == r1.end());
+		EATEST_VERIFY(r1.chunk_begin() == r1.chunk_end());
+		EATEST_VERIFY(r1.validate());
+		EATEST_VERIFY(r1 == "");
+
+		rope<char> r2("hello world");
+		EATEST_VERIFY(RopeMatches(r2, string("hello world")));
+
+		rope<char> r3("hello world", 5);
+		EATEST_VERIFY(RopeMatches(r3, string("hello")));
+
+		rope<char> r4(string_view("abc"));
+		EATEST_VERIFY(RopeMatches(r4, string("abc")));
+
+		string s("a string to convert");
+		rope<char> r5(s);
+		EATEST_VERIFY(RopeMatches(r5, s));
+		EATEST_VERIFY(r5.str() == s);
+		EATEST_VERIFY(r5.front() == 'a');
+		EATEST_VERIFY(r5.back() == 't');
+		EATEST_VERIFY(r5.at(2) == 's');
+
+		// rope(const this_type& x);
+		// rope(this_type&& x);
+		rope<char> r6(r5);
+		EATEST_VERIFY(r6 == r5);
+		rope<char> r7(eastl::move(r6));
+		EATEST_VERIFY(r7 == r5);
+		EATEST_VERIFY(r6.empty());
+		EATEST_VERIFY(r6.validate());
+
+		// this_type& operator=(...);
+		r6 = r7;
+		EATEST_VERIFY(r6 == r7);
+		r6 = r6;
+		EATEST_VERIFY(r6 == r7);
+		r6 = string_view("view");
+		EATEST_VERIFY(r6 == "view");
+		r6 = "pointer";
+		EATEST_VERIFY(r6 == "pointer");
+		r6 = eastl::move(r7);
+		EATEST_VERIFY(r6 == s);
+
+		// void swap(this_type& x);
+		r6.swap(r2);
+		EATEST_VERIFY((r6 == "hello world") && (r2 == s));
+		eastl::swap(r6, r2);
+		EATEST_VERIFY((r2 == "hello world") && (r6 == s));
+
+		// void clear();
+		r6.clear();
+		EATEST_VERIFY(r6.empty() && r6.validate());
+	}
+
+	{
+		// append, push_back, pop_back, insert, erase, replace
+		rope<char> r;
+		string     s;
+
+		r.append("abc");
+		r.push_back('d');
+		r += string_view("ef");
+		r += 'g';
+		s = "abcdefg";
+		EATEST_VERIFY(RopeMatches(r, s));
+
+		r.insert(0, "01");
+		r.insert(r.size(), "89");
+		r.insert(4, "--", 2);
+		s = "01ab--cdefg89";
+		EATEST_VERIFY(RopeMatches(r, s));
+
+		r.erase(2, 2);
+		s = "01--cdefg89";
+		EATEST_VERIFY(RopeMatches(r, s));
+
+		r.erase(9);
+		s = "01--cdefg";
+		EATEST_VERIFY(RopeMatches(r, s));
+
+		r.replace(2, 2, "ab");
+		s = "01abcdefg";
+		EATEST_VERIFY(RopeMatches(r, s));
+
+		r.replace(7, 100, "");
+		s = "01abcde";
+		EATEST_VERIFY(RopeMatches(r, s));
+
+		r.pop_back();
+		s = "01abcd";
+		EATEST_VERIFY(RopeMatches(r, s));
+
+		// Insert a rope into itself.
+		r.insert(3, r);
+		s = "01a01abcdbcd";
+		EATEST_VERIFY(RopeMatches(r, s));
+
+		r.append(r);
+		s += s;
+		EATEST_VERIFY(RopeMatches(r, s));
+
+		r.erase();
+		EATEST_VERIFY(r.empty() && r.validate());
+	}
+
+	{
+		// this_type substr(size_type position, size_type n) const;
+		// size_type copy(value_type* p, size_type n, size_type position) const;
+		string s;
+		for(int i = 0; i < 2000; i++)
+			s.append_sprintf("%d,", i);
+
+		rope<char> r(s);
+		r.insert(100, "inserted");
+		s.insert(100, "inserted");
+
+		EATEST_VERIFY(RopeMatches(r.substr(), s));
+		EATEST_VERIFY(RopeMatches(r.substr(50), s.substr(50)));
+		EATEST_VERIFY(RopeMatches(r.substr(90, 30), s.substr(90, 30)));
+		EATEST_VERIFY(RopeMatches(r.substr(r.size()), string()));
+		EATEST_VERIFY(RopeMatches(r.substr(5000, 100000), s.substr(5000, 100000)));
+
+		char buffer[64];
+		const eastl_size_t n = r.copy(buffer, sizeof(buffer), 95);
+		EATEST_VERIFY((n == sizeof(buffer)) && (s.compare(95, n, buffer, n) == 0));
+		EATEST_VERIFY(r.copy(buffer, sizeof(buffer), r.size() - 3) == 3);
+
+		// chunk_begin(position) starts its first view in the middle of a piece.
+		rope<char>::chunk_iterator it = r.chunk_begin(103);
+		EATEST_VERIFY((it->size() > 0) && (it->front() == s[103]) && (it.position() == 103));
+	}
+
+	{
+		// Iterators
+		rope<char> r("0123456789");
+		r.insert(5, string(500, 'x'));
+		r.insert(2, string(300, 'y'));
+
+		rope<char>::const_iterator it = r.begin();
+		EATEST_VERIFY(*it == '0');
+		EATEST_VERIFY(it[2] == 'y');
+		it += 302;
+		EATEST_VERIFY(*it == '2');
+		it = it + 3;
+		EATEST_VERIFY((*it == 'x') && (it.position() == 305));
+		--it;
+		EATEST_VERIFY(*it == '4');
+		it -= 304;
+		EATEST_VERIFY((*it == '0') && (it == r.begin()));
+		EATEST_VERIFY((r.end() - r.begin()) == (ptrdiff_t)r.size());
+		EATEST_VERIFY(*(r.end() - 1) == '9');
+		EATEST_VERIFY(*r.rbegin() == '9');
+		EATEST_VERIFY(r.begin() < r.end());
+		EATEST_VERIFY(eastl::count(r.begin(), r.end(), 'x') == 500);
+	}
+
+	{
+		// compare and relational operators
+		rope<char> a("apple");
+		rope<char> b("apricot");
+		rope<char> c("app");
+		c.append("le");
+
+		EATEST_VERIFY(a == c);
+		EATEST_VERIFY(a != b);
+		EATEST_VERIFY(a < b);
+		EATEST_VERIFY(b > a);
+		EATEST_VERIFY((a <= c) && (a >= c));
+		EATEST_VERIFY(a.compare(rope<char>("app")) > 0);
+		EATEST_VERIFY(a.compare(string_view("applesauce")) < 0);
+		EATEST_VERIFY(a == string_view("apple"));
+		EATEST_VERIFY(string_view("apple") == a);
+		EATEST_VERIFY((a + b) == "appleapricot");
+	}
+
+	{
+		// Ropes share their structure: copies and substrings don't copy characters,
+		// and editing one doesn't affect the others.
+		string s(100000, 'a');
+		for(eastl_size_t i = 0; i < s.size(); i += 7)
+			s[i] = (char)('a' + (i % 26));
+
+		CountingAllocator::resetCount();
+		rope<char, CountingAllocator> r(s.c_str(), s.size());
+		const auto nInitialSize = CountingAllocator::getTotalAllocationSize();
+
+		rope<char, CountingAllocator> r2(r);
+		rope<char, CountingAllocator> r3 = r.substr(1000, 50000);
+		EATEST_VERIFY((CountingAllocator::getTotalAllocationSize() - nInitialSize) < 1000);
+
+		r.erase(10, 90000);
+		r.insert(5, "new text");
+		EATEST_VERIFY((CountingAllocator::getTotalAllocationSize() - nInitialSize) < 2000);
+
+		EATEST_VERIFY(r2.str() == s.c_str());
+		EATEST_VERIFY(r3.str() == s.substr(1000, 50000).c_str());
+		EATEST_VERIFY(r.size() == 10008);
+		EATEST_VERIFY(r.validate() && r2.validate() && r3.validate());
+
+		r.clear();
+		r2.clear();
+		r3.clear();
+		EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() == 0);
+	}
+
+	{
+		// Ropes with unequal allocators copy characters rather than share nodes.
+		InstanceAllocator::reset_all();
+		{
+			rope<char, InstanceAllocator> r1("first rope", InstanceAllocator((uint8_t)1));
+			rope<char, InstanceAllocator> r2("second", InstanceAllocator((uint8_t)2));
+
+			r2.insert(3, r1);
+			EATEST_VERIFY(r2 == "secfirst ropeond");
+
+			r1 = r2;
+			EATEST_VERIFY(r1 == "secfirst ropeond");
+			EATEST_VERIFY(r1.get_allocator().mInstanceId == 1);
+
+			r1.swap(r2);
+			EATEST_VERIFY(r1.get_allocator().mInstanceId == 1);
+			EATEST_VERIFY(r1.validate() && r2.validate());
+
+			rope<char, InstanceAllocator> r3(eastl::move(r2));
+			EATEST_VERIFY(r3.get_allocator().mInstanceId == 2);
+			r1 = eastl::move(r3);
+			EATEST_VERIFY(r1 == "secfirst ropeond");
+		}
+		EATEST_VERIFY(InstanceAllocator::mMismatchCount == 0);
+	}
+
+	{
+		// Many small edits stay balanced and merge into reasonably sized pieces.
+		rope<char> r;
+		for(int i = 0; i < 20000; i++)
+			r.push_back((char)('a' + (i % 26)));
+
+		EATEST_VERIFY(r.validate());
+		EATEST_VERIFY(r.size() == 20000);
+		EATEST_VERIFY(eastl::distance(r.chunk_begin(), r.chunk_end()) <= (ptrdiff_t)(20000 / (EASTL_ROPE_MERGE_LENGTH / 2)));
+		EATEST_VERIFY(r[12345] == (char)('a' + (12345 % 26)));
+	}
+
+	{
+		// Random edits compared against a string.
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+		rope<char16_t> r;
+		u16string      s;
+
+		for(int i = 0; (i < 3000) && (nErrorCount == 0); i++)
+		{
+			const eastl_size_t nPosition = rng.RandLimit((uint32_t)s.size() + 1);
+			const eastl_size_t nLength   = rng.RandLimit(rng.RandLimit(2) ? 8 : 400);
+
+			switch(rng.RandLimit(6))
+			{
+				case 0:
+				case 1:
+				{
+					u16string text(nLength, (char16_t)('A' + (i % 26)));
+					r.insert(nPosition, text.data(), text.size());
+					s.insert(nPosition, text);
+					break;
+				}
+
+				case 2:
+					r.erase(nPosition, nLength);
+					s.erase(nPosition, nLength);
+					break;
+
+				case 3:
+				{
+					const rope<char16_t> sub = r.substr(nPosition, nLength);
+					const u16string      subString = s.substr(nPosition, nLength);
+					EATEST_VERIFY(RopeMatches(sub, subString));
+
+					const eastl_size_t nInsertPosition = rng.RandLimit((uint32_t)s.size() + 1);
+					r.insert(nInsertPosition, sub);
+					s.insert(nInsertPosition, subString);
+					break;
+				}
+
+				case 4:
+				{
+					u16string text(rng.RandLimit(20), u'z');
+					r.replace(nPosition, nLength, u16string_view(text.data(), text.size()));
+					s.replace(nPosition, eastl::min_alt(nLength, s.size() - nPosition), text);
+					break;
+				}
+
+				case 5:
+					r.append(u16string_view(u"tail"));
+					s.append(u"tail");
+					break;
+			}
+
+			if((i % 100) == 0)
+				EATEST_VERIFY(RopeMatches(r, s));
+			else
+				EATEST_VERIFY(r.validate() && (r.size() == s.size()));
+		}
+
+		EATEST_VERIFY(RopeMatches(r, s));
+	}
+
+	#if EASTL_EXCEPTIONS_ENABLED
+	{
+		rope<char> r("abc");
+		bool bThrew = false;
+
+		try { r.insert(4, "x"); }
+		catch(std::out_of_range&) { bThrew = true; }
+		EATEST_VERIFY(bThrew);
+
+		bThrew = false;
+		try { r.at(3); }
+		catch(std::out_of_range&) { bThrew = true; }
+		EATEST_VERIFY(bThrew);
+
+		bThrew = false;
+		try { r.substr(4); }
+		catch(std::out_of_range&) { bThrew = true; }
+		EATEST_VERIFY(bThrew);
+
+		EATEST_VERIFY(r == "abc");
+	}
+	#endif
+
+	return nErrorCount;
+}
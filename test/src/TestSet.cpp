@@ -95,6 +95,78 @@ struct xvalue_test
 
 
 
+#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+	// Compares nth() and rank() against a linear walk of the tree.
+	template <typename T1>
+	int VerifyOrderStatistics(const T1& c)
+	{
+		int nErrorCount = 0;
+		typename T1::size_type i = 0;
+
+		EATEST_VERIFY(c.validate());
+
+		for(typename T1::const_iterator it = c.begin(); it != c.end(); ++it, ++i)
+		{
+			EATEST_VERIFY(c.nth(i) == it);
+			EATEST_VERIFY(c.rank(it) == i);
+		}
+
+		EATEST_VERIFY(c.nth(c.size()) == c.end());
+		EATEST_VERIFY(c.nth(c.size() + 100) == c.end());
+		EATEST_VERIFY(c.rank(c.end()) == c.size());
+
+		return nErrorCount;
+	}
+
+
+	template <typename T1>
+	int TestSetOrderStatistics()
+	{
+		int nErrorCount = 0;
+
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+		T1 c;
+
+		nErrorCount += VerifyOrderStatistics(c);
+
+		for(int i = 0; i < 2000; i++)
+		{
+			if(!c.empty() && (rng.RandLimit(3) == 0))
+				c.erase(c.nth(rng.RandLimit((uint32_t)c.size())));
+			else
+				c.insert((int)rng.RandLimit(1000));
+
+			if((i % 100) == 0)
+				nErrorCount += VerifyOrderStatistics(c);
+		}
+
+		nErrorCount += VerifyOrderStatistics(c);
+
+		// Range erase and lower_bound based queries.
+		c.erase(c.lower_bound(200), c.lower_bound(400));
+		nErrorCount += VerifyOrderStatistics(c);
+
+		typename T1::const_iterator it = c.lower_bound(500);
+		EATEST_VERIFY(c.rank(it) == (typename T1::size_type)eastl::distance(c.cbegin(), it));
+
+		// Copies carry their subtree sizes along.
+		T1 c2(c);
+		nErrorCount += VerifyOrderStatistics(c2);
+
+		c2.clear();
+		nErrorCount += VerifyOrderStatistics(c2);
+		c2.insert(37);
+		EATEST_VERIFY((c2.rank(c2.begin()) == 0) && (*c2.nth(0) == 37));
+
+		c.swap(c2);
+		nErrorCount += VerifyOrderStatistics(c);
+		nErrorCount += VerifyOrderStatistics(c2);
+
+		return nErrorCount;
+	}
+#endif
+
+
 int TestSet()
 {
 	int nErrorCount = 0;
@@ -216,6 +288,19 @@ int TestSet()
 	}
 #endif
 
+#if EASTL_RBTREE_ORDER_STATISTICS_ENABLED
+	{ // nth / rank
+		nErrorCount += TestSetOrderStatistics<eastl::set<int>>();
+		nErrorCount += TestSetOrderStatistics<eastl::multiset<int>>();
+
+		set<int> s = {10, 20, 30, 40, 50};
+		VERIFY(*s.nth(0) == 10);
+		VERIFY(*s.nth(4) == 50);
+		VERIFY(s.rank(s.find(30)) == 2);
+		VERIFY(s.rank(s.lower_bound(35)) == 3);
+	}
+#endif
+
 	{
 		// user reported regression: ensure container elements are NOT 
 		// moved from during the eastl::set construction process.
@@ -0,0 +1,265 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/small_vector.h>
+#include <EASTL/fixed_vector.h>
+#include <EASTL/vector.h>
+#include <EASTL/string.h>
+#include <EASTL/unique_ptr.h>
+
+
+using namespace eastl;
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::small_vector<int,        1>;
+template class eastl::small_vector<TestObject, 4>;
+template class eastl::small_vector<Align64,    2, CustomAllocator>;
+
+
+// small_vector carries no pool pointer or overflow allocator wrapper.
+static_assert(sizeof(eastl::small_vector<uint64_t, 16>) < sizeof(eastl::fixed_vector<uint64_t, 16, true>), "small_vector should be smaller than fixed_vector");
+
+// Like fixed_vector, small_vector points into its own inline buffer.
+static_assert(!eastl::is_trivially_relocatable<eastl::small_vector<int, 4>>::value, "small_vector should not be relocatable");
+
+
+int TestSmallVector()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		// small_vector();
+		// size_type capacity() const;
+		typedef small_vector<int, 4> SmallVectorInt4;
+
+		SmallVectorInt4 sv1;
+		EATEST_VERIFY(sv1.empty());
+		EATEST_VERIFY(sv1.capacity() == 4);
+		EATEST_VERIFY(!sv1.has_overflowed());
+		EATEST_VERIFY(sv1.validate());
+
+		// explicit small_vector(size_type n);
+		SmallVectorInt4 sv2(3);
+		EATEST_VERIFY(VerifySequence(sv2, {0, 0, 0}, "small_vector"));
+		EATEST_VERIFY(!sv2.has_overflowed());
+
+		// small_vector(size_type n, const value_type& value);
+		SmallVectorInt4 sv3((eastl_size_t)6, 7);
+		EATEST_VERIFY(VerifySequence(sv3, {7, 7, 7, 7, 7, 7}, "small_vector"));
+		EATEST_VERIFY(sv3.has_overflowed());
+		EATEST_VERIFY(sv3.capacity() >= 6);
+
+		// small_vector(InputIterator first, InputIterator last);
+		const int intArray[5] = { 0, 1, 2, 3, 4 };
+		SmallVectorInt4 sv4(intArray, intArray + 5);
+		EATEST_VERIFY(VerifySequence(sv4, {0, 1, 2, 3, 4}, "small_vector"));
+
+		// small_vector(std::initializer_list<value_type> ilist);
+		SmallVectorInt4 sv5 = {5, 6};
+		EATEST_VERIFY(VerifySequence(sv5, {5, 6}, "small_vector"));
+
+		// small_vector(const this_type& x);
+		SmallVectorInt4 sv6(sv4);
+		EATEST_VERIFY(sv6 == sv4);
+
+		// this_type& operator=(const this_type& x);
+		sv6 = sv5;
+		EATEST_VERIFY(sv6 == sv5);
+		sv6 = sv3;
+		EATEST_VERIFY(sv6 == sv3);
+
+		// void assign(size_type n, const value_type& value);
+		sv6.assign(2, sv6[0]);
+		EATEST_VERIFY(VerifySequence(sv6, {7, 7}, "small_vector"));
+
+		// global operators
+		EATEST_VERIFY(sv5 != sv4);
+		EATEST_VERIFY(sv4 < sv5);
+		EATEST_VERIFY(sv5 > sv4);
+
+		EATEST_VERIFY(sv1.validate() && sv2.validate() && sv3.validate() && sv4.validate() && sv5.validate() && sv6.validate());
+	}
+
+	{
+		// Spill to the heap and come back.
+		small_vector<int, 4> sv;
+
+		for(int i = 0; i < 4; i++)
+			sv.push_back(i);
+		EATEST_VERIFY(!sv.has_overflowed());
+		EATEST_VERIFY(sv.capacity() == 4);
+
+		sv.push_back(sv[0]); // Growth with a reference to an existing element.
+		EATEST_VERIFY(sv.has_overflowed());
+		EATEST_VERIFY(VerifySequence(sv, {0, 1, 2, 3, 0}, "small_vector"));
+
+		// Spilled storage stays on the heap until explicitly shrunk.
+		sv.resize(2);
+		EATEST_VERIFY(sv.has_overflowed());
+		sv.shrink_to_fit();
+		EATEST_VERIFY(!sv.has_overflowed());
+		EATEST_VERIFY(sv.capacity() == 4);
+		EATEST_VERIFY(VerifySequence(sv, {0, 1}, "small_vector"));
+
+		// void reserve(size_type n);
+		// void set_capacity(size_type n);
+		sv.reserve(100);
+		EATEST_VERIFY(sv.has_overflowed());
+		EATEST_VERIFY(sv.capacity() == 100);
+		sv.set_capacity(50);
+		EATEST_VERIFY(sv.capacity() == 50);
+		sv.set_capacity(4);
+		EATEST_VERIFY(!sv.has_overflowed());
+		EATEST_VERIFY(VerifySequence(sv, {0, 1}, "small_vector"));
+		EATEST_VERIFY(sv.validate());
+	}
+
+	{
+		// insert / emplace / erase
+		small_vector<int, 4> sv = {0, 1, 2};
+
+		sv.insert(sv.begin() + 1, 9);
+		EATEST_VERIFY(VerifySequence(sv, {0, 9, 1, 2}, "small_vector"));
+
+		sv.insert(sv.begin(), (eastl_size_t)2, sv[3]); // Growth with a reference to an existing element.
+		EATEST_VERIFY(VerifySequence(sv, {2, 2, 0, 9, 1, 2}, "small_vector"));
+
+		const int intArray[3] = { 7, 8, 9 };
+		sv.insert(sv.end() - 1, intArray, intArray + 3);
+		EATEST_VERIFY(VerifySequence(sv, {2, 2, 0, 9, 1, 7, 8, 9, 2}, "small_vector"));
+
+		sv.insert(sv.begin() + 2, {5, 5});
+		EATEST_VERIFY(VerifySequence(sv, {2, 2, 5, 5, 0, 9, 1, 7, 8, 9, 2}, "small_vector"));
+
+		sv.emplace(sv.begin(), 4);
+		sv.emplace_back(3);
+		EATEST_VERIFY(VerifySequence(sv, {4, 2, 2, 5, 5, 0, 9, 1, 7, 8, 9, 2, 3}, "small_vector"));
+
+		sv.erase(sv.begin() + 1, sv.begin() + 5);
+		EATEST_VERIFY(VerifySequence(sv, {4, 0, 9, 1, 7, 8, 9, 2, 3}, "small_vector"));
+
+		sv.erase(sv.begin());
+		EATEST_VERIFY(VerifySequence(sv, {0, 9, 1, 7, 8, 9, 2, 3}, "small_vector"));
+
+		sv.erase_unsorted(sv.begin());
+		EATEST_VERIFY(VerifySequence(sv, {3, 9, 1, 7, 8, 9, 2}, "small_vector"));
+
+		EATEST_VERIFY(eastl::erase(sv, 9) == 2);
+		EATEST_VERIFY(eastl::erase_if(sv, [](int i) { return i > 5; }) == 2);
+		EATEST_VERIFY(VerifySequence(sv, {3, 1, 2}, "small_vector"));
+
+		sv.pop_back();
+		EATEST_VERIFY(sv.back() == 1);
+		EATEST_VERIFY(sv.front() == 3);
+		EATEST_VERIFY(sv.at(1) == 1);
+		EATEST_VERIFY(sv.validate());
+		EATEST_VERIFY(sv.validate_iterator(sv.begin()) == (isf_valid | isf_current | isf_can_dereference));
+		EATEST_VERIFY(sv.validate_iterator(sv.end()) == (isf_valid | isf_current));
+	}
+
+	{
+		// Move and swap, inline and spilled.
+		typedef small_vector<TestObject, 4> SmallVectorTO;
+
+		SmallVectorTO svHeap;
+		for(int i = 0; i < 10; i++)
+			svHeap.emplace_back(i);
+		EATEST_VERIFY(svHeap.has_overflowed());
+
+		// A spilled small_vector hands over its heap block on move.
+		const TestObject* const pHeapData = svHeap.data();
+		SmallVectorTO svMoved(eastl::move(svHeap));
+		EATEST_VERIFY(svMoved.data() == pHeapData);
+		EATEST_VERIFY(svMoved.size() == 10);
+		EATEST_VERIFY(svHeap.empty());
+		EATEST_VERIFY(!svHeap.has_overflowed());
+
+		// An inline small_vector moves its elements.
+		SmallVectorTO svInline;
+		svInline.emplace_back(100);
+		svInline.emplace_back(101);
+		SmallVectorTO svInlineMoved(eastl::move(svInline));
+		EATEST_VERIFY(svInline.empty());
+		EATEST_VERIFY((svInlineMoved.size() == 2) && (svInlineMoved[1].mX == 101));
+
+		// Swap of spilled with inline.
+		svMoved.swap(svInlineMoved);
+		EATEST_VERIFY((svMoved.size() == 2) && (svMoved[0].mX == 100));
+		EATEST_VERIFY((svInlineMoved.size() == 10) && (svInlineMoved[9].mX == 9));
+		EATEST_VERIFY(svInlineMoved.data() == pHeapData);
+
+		// Swap of two spilled containers is a pointer swap.
+		SmallVectorTO svHeap2(6, TestObject(6));
+		const TestObject* const pHeapData2 = svHeap2.data();
+		svHeap2.swap(svInlineMoved);
+		EATEST_VERIFY(svHeap2.data() == pHeapData);
+		EATEST_VERIFY(svInlineMoved.data() == pHeapData2);
+
+		// this_type& operator=(this_type&& x);
+		svMoved = eastl::move(svHeap2);
+		EATEST_VERIFY(svMoved.data() == pHeapData);
+		EATEST_VERIFY((svMoved.size() == 10) && (svMoved[9].mX == 9));
+
+		svMoved.clear();
+		EATEST_VERIFY(svMoved.has_overflowed()); // clear() keeps the heap block, like vector::clear.
+		EATEST_VERIFY(svMoved.validate() && svHeap2.validate() && svInlineMoved.validate());
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	{
+		// Aligned types spill into CustomAllocator memory, which honours the alignment.
+		small_vector<Align64, 2, CustomAllocator> svA64;
+
+		for(int i = 0; i < 5; i++)
+		{
+			svA64.push_back(Align64(i));
+			EATEST_VERIFY(((uintptr_t)svA64.data() % 64) == 0);
+		}
+		EATEST_VERIFY(svA64.has_overflowed());
+		EATEST_VERIFY(svA64[4].mX == 4);
+	}
+
+	{
+		// Move-only types.
+		small_vector<unique_ptr<int>, 2> svUP;
+
+		for(int i = 0; i < 8; i++)
+			svUP.push_back(unique_ptr<int>(new int(i)));
+		svUP.erase(svUP.begin() + 3);
+		svUP.insert(svUP.begin(), unique_ptr<int>(new int(-1)));
+		EATEST_VERIFY((svUP.size() == 8) && (*svUP[0] == -1) && (*svUP[4] == 4) && (*svUP[7] == 7));
+	}
+
+	{
+		// A vector of small_vectors moves them when it grows, which must leave each
+		// one pointing at its own inline buffer or at the heap block it took over.
+		vector<small_vector<string, 2>> v;
+
+		for(int i = 0; i < 100; i++)
+		{
+			v.emplace_back();
+			for(int j = 0; j < (i % 4); j++)
+				v.back().push_back(string(32, (char)('a' + j)));
+		}
+
+		bool bValid = true;
+		for(int i = 0; i < 100; i++)
+		{
+			bValid = bValid && v[i].validate() && (v[i].size() == (eastl_size_t)(i % 4));
+			for(int j = 0; j < (i % 4); j++)
+				bValid = bValid && (v[i][j] == string(32, (char)('a' + j)));
+		}
+		EATEST_VERIFY(bValid);
+	}
+
+	return nErrorCount;
+}
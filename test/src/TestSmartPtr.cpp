@@ -9,6 +9,7 @@
 #include <EAStdC/EAString.h>
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/intrusive_ptr.h>
+#include <EASTL/local_shared_ptr.h>
 #include <EASTL/safe_ptr.h>
 #include <EASTL/shared_array.h>
 #include <EASTL/shared_ptr.h>
@@ -284,6 +285,27 @@ namespace SmartPtrTest
 
 
 
+	/// LocalY
+	///
+	/// This is used for tests involving local_shared_ptr and enable_local_shared_from_this.
+	///
+	struct LocalY : public eastl::enable_local_shared_from_this<LocalY>
+	{
+		static int mnCount;
+
+		LocalY() { ++mnCount; }
+		LocalY(const LocalY&) { ++mnCount; }
+		LocalY& operator=(const LocalY&) { return *this; }
+	   ~LocalY() { --mnCount; }
+
+		eastl::local_shared_ptr<LocalY> f()
+			{ return shared_from_this(); }
+	};
+
+	int LocalY::mnCount = 0;
+
+
+
 	/// ACLS / BCLS
 	///
 	/// This is used for tests involving shared_ptr.
@@ -1254,6 +1276,26 @@ static int Test_shared_ptr()
 			return nErrorCount;
 		}
 	};
+
+	// An object whose destructor reads a shared_ptr with atomic_load. If an atomic function on
+	// that shared_ptr released the object while holding its mutex, the thread would lock it twice.
+	struct SharedPtrAtomicReader
+	{
+		static int sLastReadX;
+
+		const eastl::shared_ptr<SharedPtrAtomicReader>* mpSource;
+		int                                             mX;
+
+		SharedPtrAtomicReader(const eastl::shared_ptr<SharedPtrAtomicReader>* pSource, int x) : mpSource(pSource), mX(x) {}
+
+	   ~SharedPtrAtomicReader()
+		{
+			eastl::shared_ptr<SharedPtrAtomicReader> spCurrent = eastl::atomic_load(mpSource);
+			sLastReadX = spCurrent ? spCurrent->mX : -1;
+		}
+	};
+
+	int SharedPtrAtomicReader::sLastReadX = 0;
 #endif
 
 
@@ -1346,6 +1388,30 @@ static int Test_shared_ptr_thread()
 			EATEST_VERIFY(spTO2->mX == 56);
 			EATEST_VERIFY(spTO3->mX == 88);
 		}
+
+		{
+			// The atomic functions release the values they replace after unlocking, so their
+			// destructors can use the atomic functions on the same shared_ptr.
+			shared_ptr<SharedPtrAtomicReader> sp(new SharedPtrAtomicReader(&sp, 1));
+
+			atomic_store(&sp, shared_ptr<SharedPtrAtomicReader>(new SharedPtrAtomicReader(&sp, 2)));
+			EATEST_VERIFY(SharedPtrAtomicReader::sLastReadX == 2);
+
+			atomic_exchange(&sp, make_shared<SharedPtrAtomicReader>(&sp, 3));
+			EATEST_VERIFY(SharedPtrAtomicReader::sLastReadX == 3);
+
+			shared_ptr<SharedPtrAtomicReader> spCondition = make_shared<SharedPtrAtomicReader>(&sp, 4);
+			SharedPtrAtomicReader::sLastReadX = 0;
+			EATEST_VERIFY(!atomic_compare_exchange_strong(&sp, &spCondition, make_shared<SharedPtrAtomicReader>(&sp, 5))); // Releases 4, and 5.
+			EATEST_VERIFY((spCondition->mX == 3) && (SharedPtrAtomicReader::sLastReadX == 3));
+
+			EATEST_VERIFY(atomic_compare_exchange_strong(&sp, &spCondition, make_shared<SharedPtrAtomicReader>(&sp, 6)));
+			spCondition.reset();
+			EATEST_VERIFY(SharedPtrAtomicReader::sLastReadX == 6);
+
+			atomic_store(&sp, shared_ptr<SharedPtrAtomicReader>());
+			EATEST_VERIFY(SharedPtrAtomicReader::sLastReadX == -1);
+		}
 	#endif
 
 	EATEST_VERIFY(A::mCount == 0);
@@ -1355,6 +1421,331 @@ static int Test_shared_ptr_thread()
 }
 
 
+
+#if EASTL_THREAD_SUPPORT_AVAILABLE
+	namespace
+	{
+		// A snapshot which can tell whether it was read after being destroyed.
+		struct AtomicSharedPtrSnapshot
+		{
+			static std::atomic<int> sCount;
+
+			int mnVersion;
+			int mnCheck;
+
+			explicit AtomicSharedPtrSnapshot(int nVersion) : mnVersion(nVersion), mnCheck(~nVersion) { ++sCount; }
+		   ~AtomicSharedPtrSnapshot() { mnCheck = 0; --sCount; }
+
+			bool IsValid() const { return mnCheck == ~mnVersion; }
+		};
+
+		std::atomic<int> AtomicSharedPtrSnapshot::sCount(0);
+
+		typedef eastl::atomic_shared_ptr<AtomicSharedPtrSnapshot> AtomicSnapshotPtr;
+
+
+		// Reads the snapshot until told to stop. The versions that it sees never go backwards.
+		struct AtomicSharedPtrReaderThread : public EA::Thread::IRunnable
+		{
+			EA::Thread::ThreadParameters mThreadParams;
+			EA::Thread::Thread           mThread;
+			AtomicSnapshotPtr*           mpSnapshot;
+			std::atomic<bool>*           mpShouldContinue;
+			int                          mnErrorCount;
+
+			AtomicSharedPtrReaderThread() : mThreadParams(), mThread(), mpSnapshot(NULL), mpShouldContinue(NULL), mnErrorCount(0) {}
+			AtomicSharedPtrReaderThread(const AtomicSharedPtrReaderThread&) = delete;
+			void operator=(const AtomicSharedPtrReaderThread&) = delete;
+
+			intptr_t Run(void*) override
+			{
+				int& nErrorCount = mnErrorCount; // declare nErrorCount so that EATEST_VERIFY can work, as it depends on it being declared.
+				int nLastVersion = 0;
+
+				while(mpShouldContinue->load(std::memory_order_relaxed))
+				{
+					eastl::shared_ptr<AtomicSharedPtrSnapshot> pSnapshot = mpSnapshot->load();
+
+					EATEST_VERIFY(pSnapshot && pSnapshot->IsValid());
+					EATEST_VERIFY(pSnapshot->mnVersion >= nLastVersion);
+					nLastVersion = pSnapshot->mnVersion;
+				}
+
+				return nErrorCount;
+			}
+		};
+	}
+#endif
+
+
+static int Test_atomic_shared_ptr()
+{
+	using namespace eastl;
+
+	int nErrorCount(0);
+
+	#if EASTL_THREAD_SUPPORT_AVAILABLE
+		TestObject::Reset();
+
+		{
+			atomic_shared_ptr<TestObject> aspTO;
+
+			EATEST_VERIFY(!aspTO.is_lock_free());
+			EATEST_VERIFY(!aspTO.load());
+
+			shared_ptr<TestObject> spTO(new TestObject(55));
+			aspTO.store(spTO);
+			EATEST_VERIFY(aspTO.load() == spTO);
+			EATEST_VERIFY(spTO.use_count() == 2);
+
+			// exchange returns the previous value, and releases the atomic_shared_ptr's reference to it.
+			shared_ptr<TestObject> spOld = aspTO.exchange(make_shared<TestObject>(66));
+			EATEST_VERIFY((spOld == spTO) && (spTO.use_count() == 2));
+			EATEST_VERIFY(aspTO.load()->mX == 66);
+			spOld.reset();
+
+			// compare_exchange fails when expected isn't the current value, and copies the current value into expected.
+			shared_ptr<TestObject> spExpected = spTO;
+			EATEST_VERIFY(!aspTO.compare_exchange_strong(spExpected, make_shared<TestObject>(77)));
+			EATEST_VERIFY(spExpected->mX == 66);
+
+			EATEST_VERIFY(aspTO.compare_exchange_weak(spExpected, spTO));
+			EATEST_VERIFY((aspTO.load() == spTO) && (spExpected.use_count() == 1));
+			spExpected.reset();
+
+			// A pointer which equals the current one but doesn't share its ownership isn't equivalent.
+			shared_ptr<TestObject> spOwner(new TestObject(1));
+			shared_ptr<TestObject> spAlias(spOwner, spTO.get());
+			EATEST_VERIFY(!aspTO.compare_exchange_strong(spAlias, shared_ptr<TestObject>()));
+			EATEST_VERIFY(spAlias == spTO);
+			spAlias.reset();
+
+			// Storing an empty shared_ptr, and exchanging it back out.
+			aspTO = shared_ptr<TestObject>();
+			EATEST_VERIFY(!aspTO.load() && (spTO.use_count() == 1));
+
+			shared_ptr<TestObject> spEmpty;
+			EATEST_VERIFY(aspTO.compare_exchange_strong(spEmpty, spTO));
+			EATEST_VERIFY(((shared_ptr<TestObject>)aspTO)->mX == 55);
+			EATEST_VERIFY(aspTO.exchange(spTO) == spTO);
+		}
+
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+
+		{  // Test readers loading while a writer replaces the value
+			AtomicSnapshotPtr           aspSnapshot(make_shared<AtomicSharedPtrSnapshot>(1));
+			AtomicSharedPtrReaderThread thread[4];
+			std::atomic<bool>           bShouldContinue(true);
+
+			for(size_t i = 0; i < EAArrayCount(thread); i++)
+			{
+				thread[i].mpSnapshot       = &aspSnapshot;
+				thread[i].mpShouldContinue = &bShouldContinue;
+				thread[i].mThreadParams.mpName = "AtomicSharedPtrReaderThread";
+				thread[i].mThread.Begin(&thread[i], NULL, &thread[i].mThreadParams);
+			}
+
+			for(int nVersion = 2; nVersion < 20000; nVersion++)
+			{
+				shared_ptr<AtomicSharedPtrSnapshot> pSnapshot = make_shared<AtomicSharedPtrSnapshot>(nVersion);
+
+				switch(nVersion % 3)
+				{
+					case 0:
+						aspSnapshot.store(pSnapshot);
+						break;
+
+					case 1:
+						EATEST_VERIFY(aspSnapshot.exchange(pSnapshot)->mnVersion == (nVersion - 1));
+						break;
+
+					default:
+					{
+						shared_ptr<AtomicSharedPtrSnapshot> pExpected = aspSnapshot.load();
+						EATEST_VERIFY(aspSnapshot.compare_exchange_strong(pExpected, pSnapshot));
+						break;
+					}
+				}
+
+				if((nVersion % 1000) == 0)
+					EA::Thread::ThreadSleep(1); // Give the readers a chance to run on machines with few cores.
+			}
+
+			bShouldContinue.store(false, std::memory_order_relaxed);
+
+			for(size_t i = 0; i < EAArrayCount(thread); i++)
+			{
+				thread[i].mThread.WaitForEnd();
+				nErrorCount += thread[i].mnErrorCount;
+			}
+
+			EATEST_VERIFY(AtomicSharedPtrSnapshot::sCount == 1);
+		}
+
+		EATEST_VERIFY(AtomicSharedPtrSnapshot::sCount == 0);
+	#endif
+
+	return nErrorCount;
+}
+
+
+
+static int Test_local_shared_ptr()
+{
+	using namespace SmartPtrTest;
+	using namespace eastl;
+
+	int nErrorCount(0);
+
+	TestObject::Reset();
+
+	{
+		local_shared_ptr<TestObject> pEmpty;
+		EATEST_VERIFY(!pEmpty && (pEmpty.use_count() == 0) && !pEmpty.unique());
+		EATEST_VERIFY(pEmpty == nullptr);
+
+		local_shared_ptr<TestObject> pTO(new TestObject(3));
+		EATEST_VERIFY(pTO && pTO.unique() && (pTO->mX == 3) && ((*pTO).mX == 3));
+
+		{
+			local_shared_ptr<TestObject> pTO2(pTO);
+			local_shared_ptr<TestObject> pTO3;
+			pTO3 = pTO2;
+
+			EATEST_VERIFY((pTO.use_count() == 3) && (pTO2 == pTO) && pTO3.equivalent_ownership(pTO));
+			EATEST_VERIFY(!pTO.owner_before(pTO3) && !pTO3.owner_before(pTO));
+
+			local_shared_ptr<TestObject> pTO4(eastl::move(pTO3));
+			EATEST_VERIFY(!pTO3 && (pTO.use_count() == 3));
+		}
+
+		EATEST_VERIFY(pTO.unique() && (TestObject::sTOCount == 1));
+
+		pTO.reset(new TestObject(4));
+		EATEST_VERIFY((pTO->mX == 4) && (TestObject::sTOCount == 1));
+
+		pTO.reset();
+		EATEST_VERIFY(!pTO && (TestObject::sTOCount == 0));
+
+		local_shared_ptr<TestObject> pTO5(unique_ptr<TestObject>(new TestObject(5)));
+		EATEST_VERIFY(pTO5.unique() && (pTO5->mX == 5));
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	{ // Test custom deleters.
+		local_shared_ptr<TestObject> pTO(new TestObject, CustomDeleter());
+		#if EASTL_RTTI_ENABLED
+			EATEST_VERIFY(get_deleter<CustomDeleter>(pTO) != nullptr);
+			EATEST_VERIFY(get_deleter<default_delete<TestObject>>(pTO) == nullptr);
+		#endif
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	{ // Test make_local_shared and allocate_local_shared, which make a single allocation.
+		local_shared_ptr<TestObject> pTO = make_local_shared<TestObject>(6);
+		EATEST_VERIFY(pTO.unique() && (pTO->mX == 6));
+
+		CountingAllocator::resetCount();
+		{
+			local_shared_ptr<TestObject> pTO2 = allocate_local_shared<TestObject>(CountingAllocator(), 7);
+			EATEST_VERIFY((pTO2->mX == 7) && (CountingAllocator::getActiveAllocationCount() == 1));
+
+			local_shared_ptr<TestObject> pTO3(pTO2);
+			EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() == 1);
+		}
+		EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() == 0);
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	{ // Test local_weak_ptr.
+		local_weak_ptr<TestObject> pW;
+		EATEST_VERIFY(pW.expired() && !pW.lock());
+
+		{
+			local_shared_ptr<TestObject> pTO = make_local_shared<TestObject>(8);
+			pW = pTO;
+			EATEST_VERIFY(!pW.expired() && (pW.use_count() == 1));
+
+			local_weak_ptr<TestObject> pW2(pW);
+			local_shared_ptr<TestObject> pTO2 = pW2.lock();
+			EATEST_VERIFY((pTO2 == pTO) && (pTO.use_count() == 2));
+
+			local_shared_ptr<TestObject> pTO3(pW2);
+			EATEST_VERIFY(pTO3.use_count() == 3);
+		}
+
+		// The object is destroyed, but the control block lives on until pW lets go of it.
+		EATEST_VERIFY(pW.expired() && !pW.lock() && (TestObject::sTOCount == 0));
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			bool bThrown = false;
+			try
+			{
+				local_shared_ptr<TestObject> pTO(pW);
+			}
+			catch(bad_weak_ptr&)
+			{
+				bThrown = true;
+			}
+			EATEST_VERIFY(bThrown);
+		#endif
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	{ // Test enable_local_shared_from_this.
+		{
+			local_shared_ptr<LocalY> p(new LocalY);
+			local_shared_ptr<LocalY> q = p->f();
+
+			EATEST_VERIFY((p == q) && (p.use_count() == 2));
+			EATEST_VERIFY(!(p.owner_before(q) || q.owner_before(p)));
+
+			const LocalY* pConstY = p.get();
+			local_shared_ptr<const LocalY> r = pConstY->shared_from_this();
+			EATEST_VERIFY((r == p) && (p.use_count() == 3));
+
+			local_weak_ptr<LocalY> w = p->weak_from_this();
+			EATEST_VERIFY(w.lock() == p);
+		}
+		EATEST_VERIFY(LocalY::mnCount == 0);
+
+		{
+			local_shared_ptr<LocalY> p = make_local_shared<LocalY>();
+			EATEST_VERIFY(p->f() == p);
+		}
+		EATEST_VERIFY(LocalY::mnCount == 0);
+	}
+
+	{ // Test the casts.
+		local_shared_ptr<GrandChildClass> pGCC(new GrandChildClass);
+		local_shared_ptr<ParentClass>     pPC = static_pointer_cast<ParentClass>(pGCC);
+		EATEST_VERIFY((pPC == pGCC) && (pGCC.use_count() == 2));
+
+		#if EASTL_RTTI_ENABLED
+			local_shared_ptr<ChildClass> pCC = dynamic_pointer_cast<ChildClass>(pPC);
+			EATEST_VERIFY(pCC == pGCC);
+		#endif
+
+		local_shared_ptr<const ParentClass> pCPC(pPC);
+		local_shared_ptr<ParentClass>       pPC2 = const_pointer_cast<ParentClass>(pCPC);
+		EATEST_VERIFY(pPC2 == pPC);
+
+		EATEST_VERIFY(hash<local_shared_ptr<ParentClass>>()(pPC) == hash<ParentClass*>()(pPC.get()));
+	}
+
+	return nErrorCount;
+}
+
+
 static int Test_weak_ptr()
 {
 	using namespace SmartPtrTest;
@@ -1936,6 +2327,8 @@ int TestSmartPtr()
 	nErrorCount += Test_unique_ptr();
 	nErrorCount += Test_shared_ptr();
 	nErrorCount += Test_shared_ptr_thread();
+	nErrorCount += Test_atomic_shared_ptr();
+	nErrorCount += Test_local_shared_ptr();
 	nErrorCount += Test_weak_ptr();
 	nErrorCount += Test_shared_array();
 	nErrorCount += Test_intrusive_ptr();
@@ -1689,6 +1689,37 @@ int TEST_STRING_NAME()
 		VERIFY(str.find(LITERAL('1'), 2) == StringType::npos);
 	}
 
+	{
+		// Strings which span several SIMD registers, with the match at every offset
+		// including those in the partial block at the end.
+		for(typename StringType::size_type len = 2; len < 80; len++)
+		{
+			StringType str(len, LITERAL('a'));
+
+			for(typename StringType::size_type i = 0; i < len; i++)
+			{
+				str[i] = LITERAL('x');
+
+				VERIFY(str.find(LITERAL('x')) == i);
+				VERIFY(str.find(LITERAL('x'), i + 1) == StringType::npos);
+				VERIFY(str.rfind(LITERAL('x')) == i);
+				VERIFY(str.find_first_of(LITERAL("yx")) == i);
+				VERIFY(str.find_first_of(LITERAL("0123456789ABCDEFGHIJx")) == i);
+				VERIFY(str.find(LITERAL("aya")) == StringType::npos); // First and last characters match almost everywhere.
+
+				if(i > 0)
+					VERIFY(str.find(LITERAL("ax")) == (i - 1));
+				if((i + 1) < len)
+					VERIFY(str.find(LITERAL("xa")) == i);
+
+				str[i] = LITERAL('a');
+			}
+
+			VERIFY(str.find(LITERAL("aa"), len - 2) == (len - 2));
+			VERIFY(str.find(LITERAL("aa"), len - 1) == StringType::npos);
+		}
+	}
+
 	// size_type rfind(const this_type& x, size_type position = npos) const EA_NOEXCEPT;
 	// size_type rfind(const value_type* p, size_type position = npos) const;
 	// size_type rfind(const value_type* p, size_type position, size_type n) const;
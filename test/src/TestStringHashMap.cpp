@@ -14,6 +14,7 @@ using namespace eastl;
 // These tell the compiler to compile all the functions for the given class.
 template class eastl::string_hash_map<int>;
 template class eastl::string_hash_map<Align32>;
+template class eastl::interned_string_hash_map<int>;
 
 static const char* strings[] = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r", "s", "t"};
 static const size_t kStringCount = 10; // This is intentionally half the length of strings, so that we can test with strings that are not inserted to the map. 
@@ -421,5 +422,91 @@ int TestStringHashMap()
 		EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() == 0);
 	}
 
+	{ // Test lookup by string_view, which needn't be zero-terminated and mustn't allocate.
+		typedef string_hash_map<int, hash<const char*>, str_equal_to<const char*>, CountingAllocator> counting_string_hash_map;
+		counting_string_hash_map m;
+
+		for (int i = 0; i < (int)kStringCount; i++)
+			m.insert(strings[i], i);
+		m.insert("hello", 100);
+
+		const auto nAllocationCount = CountingAllocator::getTotalAllocationCount();
+		const char buffer[] = "hellobcd";
+
+		EATEST_VERIFY(m.find(string_view(buffer, 5))->second == 100);
+		EATEST_VERIFY(m.find(string_view(buffer, 4)) == m.end());   // "hell" is a prefix of a key.
+		EATEST_VERIFY(m.find(string_view(buffer, 6)) == m.end());   // "hellob" has a key as a prefix.
+		EATEST_VERIFY(m.find(string_view(buffer + 5, 1))->second == 1);
+		EATEST_VERIFY(m.find(eastl::string("c"))->second == 2);
+		EATEST_VERIFY(m.find("c")->second == 2);
+		EATEST_VERIFY(m.count(string_view(buffer + 6, 1)) == 1);
+		EATEST_VERIFY(m.contains(string_view(buffer, 5)));
+		EATEST_VERIFY(!m.contains(string_view("z")));
+		EATEST_VERIFY(m.contains("a"));
+
+		const counting_string_hash_map& cm = m;
+		auto range = cm.equal_range(string_view(buffer, 5));
+		EATEST_VERIFY((eastl::distance(range.first, range.second) == 1) && (range.first->second == 100));
+		EATEST_VERIFY(CountingAllocator::getTotalAllocationCount() == nAllocationCount);
+
+		EATEST_VERIFY(m.erase(string_view(buffer, 5)) == 1);
+		EATEST_VERIFY(m.erase(string_view(buffer, 5)) == 0);
+		EATEST_VERIFY(m.validate() && (m.size() == kStringCount));
+	}
+
+	{
+		// interned_string_hash_map
+		string_pool pool;
+		interned_string_hash_map<int> m1(pool);
+		interned_string_hash_map<int> m2(pool);
+
+		for (int i = 0; i < (int)kStringCount; i++)
+		{
+			m1.insert(strings[i], i);
+			m2[string_view(strings[i])] = i * 10;
+		}
+
+		// Both maps share the pool's copy of each key.
+		EATEST_VERIFY(pool.size() == kStringCount);
+		EATEST_VERIFY(m1.find("c")->first.c_str() == m2.find("c")->first.c_str());
+		EATEST_VERIFY(&m1.get_string_pool() == &pool);
+
+		const interned_string c = pool.intern("c");
+		EATEST_VERIFY(m1.find(c)->second == 2);
+		EATEST_VERIFY(m2.find(c)->second == 20);
+		EATEST_VERIFY(m1[c] == 2);
+		EATEST_VERIFY(m1.count(c) == 1);
+
+		// Lookups of strings which were never interned don't add them to the pool.
+		EATEST_VERIFY(m1.find("z") == m1.end());
+		EATEST_VERIFY(m1.find(eastl::string("zz")) == m1.end());
+		EATEST_VERIFY(!m1.contains(string_view("zzz")));
+		EATEST_VERIFY(m1.count("z") == 0);
+		EATEST_VERIFY(m1.erase("z") == 0);
+		EATEST_VERIFY(pool.size() == kStringCount);
+
+		// Strings which are interned but aren't keys aren't found.
+		pool.intern("y");
+		EATEST_VERIFY(!m1.contains("y"));
+
+		EATEST_VERIFY(!m1.insert("a", 100).second);
+		EATEST_VERIFY(m1.insert_or_assign("a", 100).first->second == 100);
+		EATEST_VERIFY(m1.try_emplace(string_view("x"), 7).second);
+		EATEST_VERIFY(m1.find(eastl::string("x"))->second == 7);
+
+		// The empty string is a valid key.
+		m1[""] = -1;
+		EATEST_VERIFY(m1.find("")->second == -1);
+		EATEST_VERIFY(m1.find(interned_string())->second == -1);
+
+		EATEST_VERIFY(m1.erase("b") == 1);
+		EATEST_VERIFY(m1.erase(string_view("b")) == 0);
+		EATEST_VERIFY(m1.erase(pool.intern("d")) == 1);
+		EATEST_VERIFY(m1.validate() && (m1.size() == kStringCount));
+
+		interned_string_hash_map<int> m3(m2);
+		EATEST_VERIFY((m3 == m2) && (m3.find("e")->second == 40));
+	}
+
 	return nErrorCount;
 }
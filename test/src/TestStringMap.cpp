@@ -203,5 +203,35 @@ int TestStringMap()
 
 	}
 
+	{ // Test lookup by string_view, which needn't be zero-terminated and mustn't allocate.
+		string_map<int> stringMap;
+
+		for (int i = 0; i < (int)kStringCount; i++)
+			stringMap.insert(strings[i], i);
+		stringMap.insert("hello", 100);
+		stringMap.insert("\xff", 255); // Characters are ordered as unsigned, as str_less does.
+
+		const char buffer[] = "hellobcd";
+
+		EATEST_VERIFY(stringMap.find(string_view(buffer, 5))->second == 100);
+		EATEST_VERIFY(stringMap.find(string_view(buffer, 4)) == stringMap.end());
+		EATEST_VERIFY(stringMap.find(string_view(buffer, 6)) == stringMap.end());
+		EATEST_VERIFY(stringMap.find(string_view(buffer + 5, 1))->second == 1);
+		EATEST_VERIFY(stringMap.find(eastl::string("c"))->second == 2);
+		EATEST_VERIFY(stringMap.find(string_view("\xff"))->second == 255);
+		EATEST_VERIFY(stringMap.find("c")->second == 2);
+		EATEST_VERIFY(stringMap.count(string_view(buffer + 6, 1)) == 1);
+		EATEST_VERIFY(stringMap.count(string_view("z")) == 0);
+		EATEST_VERIFY(stringMap.contains(string_view(buffer, 5)));
+		EATEST_VERIFY(stringMap.contains("a") && !stringMap.contains(""));
+
+		const string_map<int>& constStringMap = stringMap;
+		EATEST_VERIFY(constStringMap.find(string_view(buffer, 5))->second == 100);
+
+		EATEST_VERIFY(stringMap.erase(string_view(buffer, 5)) == 1);
+		EATEST_VERIFY(stringMap.erase(string_view(buffer, 5)) == 0);
+		EATEST_VERIFY(stringMap.validate() && (stringMap.size() == kStringCount + 1));
+	}
+
 	return nErrorCount;
 }
@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/string_pool.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <EAStdC/EASprintf.h>
+
+
+using namespace eastl;
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::basic_string_pool<>;
+template class eastl::basic_string_pool<CountingAllocator>;
+
+
+int TestStringPool()
+{
+	int nErrorCount = 0;
+
+	{
+		// interned_string();
+		interned_string empty;
+		EATEST_VERIFY(empty.empty());
+		EATEST_VERIFY(empty.size() == 0);
+		EATEST_VERIFY(empty.c_str() && (empty.c_str()[0] == 0));
+		EATEST_VERIFY(empty.handle() == 0);
+		EATEST_VERIFY(empty.view() == "");
+		EATEST_VERIFY(empty == interned_string());
+	}
+
+	{
+		// interned_string intern(const string_view& sv);
+		// interned_string intern(const char* p);
+		string_pool pool;
+		EATEST_VERIFY(pool.empty() && pool.validate());
+
+		const interned_string a = pool.intern("asset/texture/rock.dds");
+		const interned_string b = pool.intern(string_view("asset/texture/rock.dds"));
+		const interned_string c = pool.intern(string("asset/texture/") + "rock.dds");
+		const interned_string d = pool.intern("asset/texture/sand.dds");
+
+		EATEST_VERIFY((a == b) && (a == c));
+		EATEST_VERIFY(a.c_str() == c.c_str());
+		EATEST_VERIFY(a != d);
+		EATEST_VERIFY(a.view() == "asset/texture/rock.dds");
+		EATEST_VERIFY(strcmp(a.c_str(), "asset/texture/rock.dds") == 0);
+		EATEST_VERIFY(a.size() == 22);
+		EATEST_VERIFY(a.hash() == (uint32_t)eastl::hash<string_view>()(string_view("asset/texture/rock.dds")));
+		EATEST_VERIFY(eastl::hash<interned_string>()(a) == a.hash());
+		EATEST_VERIFY(pool.size() == 2);
+
+		// A substring of a pooled string is interned separately.
+		const interned_string prefix = pool.intern(a.view().substr(0, 5));
+		EATEST_VERIFY((prefix.view() == "asset") && (prefix.c_str()[5] == 0));
+		EATEST_VERIFY(pool.size() == 3);
+
+		// The empty string is never added to the pool.
+		EATEST_VERIFY(pool.intern("") == interned_string());
+		EATEST_VERIFY(pool.size() == 3);
+
+		// interned_string get(handle_type handle) const;
+		EATEST_VERIFY(pool.get(a.handle()) == a);
+		EATEST_VERIFY(pool.get(d.handle()) == d);
+		EATEST_VERIFY(pool.get(0) == interned_string());
+		EATEST_VERIFY(pool.is_valid_handle(d.handle()));
+		EATEST_VERIFY(!pool.is_valid_handle(1000));
+
+		// interned_string find(const string_view& sv) const;
+		EATEST_VERIFY(pool.find("asset/texture/sand.dds") == d);
+		EATEST_VERIFY(pool.find("asset/texture/mud.dds").empty());
+		EATEST_VERIFY(pool.contains("asset"));
+		EATEST_VERIFY(pool.contains(""));
+		EATEST_VERIFY(!pool.contains("asse"));
+		EATEST_VERIFY(pool.size() == 3);
+		EATEST_VERIFY(pool.validate());
+
+		// void clear();
+		pool.clear();
+		EATEST_VERIFY(pool.empty() && pool.validate());
+		EATEST_VERIFY(pool.find("asset").empty());
+		EATEST_VERIFY(pool.intern("asset").handle() == 1);
+	}
+
+	{
+		// Many strings: the pooled strings and handles stay valid as the pool grows.
+		string_pool   pool;
+		vector<string> strings;
+		vector<interned_string> interned;
+		char buffer[64];
+
+		for(int i = 0; i < 20000; i++)
+		{
+			EA::StdC::Snprintf(buffer, sizeof(buffer), "tag_%d", i % 5000);
+			strings.push_back(buffer);
+			interned.push_back(pool.intern(buffer));
+		}
+
+		// A few strings larger than the pool's blocks.
+		const string sLarge(EASTL_STRING_POOL_BLOCK_SIZE * 2, 'L');
+		const interned_string large = pool.intern(sLarge);
+		EATEST_VERIFY(pool.intern("tag_1") == interned[1]);
+
+		EATEST_VERIFY(pool.size() == 5001);
+		EATEST_VERIFY(pool.validate());
+		EATEST_VERIFY(large.view() == sLarge);
+		EATEST_VERIFY(pool.get(large.handle()) == large);
+
+		for(eastl_size_t i = 0; i < strings.size(); i++)
+		{
+			EATEST_VERIFY(interned[i].view() == strings[i]);
+			EATEST_VERIFY(interned[i] == interned[i % 5000]);
+			EATEST_VERIFY(pool.get(interned[i].handle()) == interned[i]);
+		}
+
+		// Each distinct string is stored once.
+		EATEST_VERIFY(pool.allocated_memory() < (5000 * 64) + (sLarge.size() * 2));
+	}
+
+	{
+		// All memory comes from the pool's allocator and is freed.
+		CountingAllocator::resetCount();
+		{
+			basic_string_pool<CountingAllocator> pool;
+			pool.reserve(1000);
+
+			const auto nAllocationCount = CountingAllocator::getTotalAllocationCount();
+			for(int i = 0; i < 1000; i++)
+				pool.intern(string(1 + (i % 50), (char)('a' + (i % 26))));
+			EATEST_VERIFY(pool.size() == 50 * 26 / 2);
+			EATEST_VERIFY(CountingAllocator::getTotalAllocationCount() - nAllocationCount < 20); // No rehash, and few blocks.
+			EATEST_VERIFY(pool.validate());
+
+			pool.clear();
+			EATEST_VERIFY(pool.validate());
+		}
+		EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() == 0);
+	}
+
+	return nErrorCount;
+}
@@ -365,6 +365,17 @@ int TEST_STRING_NAME()
 			VERIFY(sw.find(LITERAL("Vancouv"), 7) != StringViewT::npos);
 		}
 
+		// find over more than one SIMD register, with the match in the partial block at the end.
+		{
+			StringViewT sw(LITERAL("The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy cat."));
+			VERIFY(sw.find(LITERAL("cat")) == 85);
+			VERIFY(sw.find(LITERAL("lazy c")) == 80);
+			VERIFY(sw.find(LITERAL("lazy d")) == 35);
+			VERIFY(sw.find(LITERAL("lazy e")) == StringViewT::npos);
+			VERIFY(sw.find(LITERAL('.'), 44) == 88);
+			VERIFY(sw.find(LITERAL("."), 89) == StringViewT::npos);
+		}
+
 
 		// EA_CONSTEXPR size_type rfind(basic_string_view s, size_type pos = npos) const EA_NOEXCEPT;
 		// EA_CONSTEXPR size_type rfind(T c, size_type pos = npos) const EA_NOEXCEPT;
@@ -4,6 +4,7 @@
 
 
 #include "EASTLTest.h"
+#include <EASTL/segmented_vector.h>
 #include <EASTL/type_traits.h>
 #include <EASTL/vector.h>
 #include <EAStdC/EAAlignment.h>
@@ -1116,6 +1117,20 @@ int TestTypeTraits()
 	EATEST_VERIFY(GetType(has_trivial_relocate<int*>()) == true);
 
 
+	// is_trivially_relocatable
+	static_assert(is_trivially_relocatable<int>::value == true,                     "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<int*>::value == true,                    "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<const int[4]>::value == true,            "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<volatile int>::value == false,           "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<Class>::value == true,                   "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<NonPod1>::value == false,                "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<eastl::vector<NonPod1>>::value == true,  "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<eastl::pair<int, NonPod1>>::value == false,  "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable_v<const eastl::vector<int>> == true,     "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<eastl::segmented_vector<NonPod1, 8>>::value == true,  "is_trivially_relocatable failure");
+	EATEST_VERIFY(GetType(is_trivially_relocatable<int>()) == true);
+
+
 	// is_signed
 	static_assert(is_signed<int>::value == true,                "is_signed failure ");
 	static_assert(is_signed_v<int> == true,                     "is_signed failure ");
@@ -1860,5 +1860,43 @@ int TestVector()
 			EATEST_VERIFY(VerifySequence(vec, {0, 8, 2, 6, 4}, "erase_unordered_if") );
 		}
 	}
+
+	{
+		// Growth of trivially relocatable element types (memmoved rather than moved).
+		static_assert(eastl::is_trivially_relocatable<eastl::string>::value, "is_trivially_relocatable failure");
+		static_assert(eastl::is_trivially_relocatable<eastl::unique_ptr<int>>::value, "is_trivially_relocatable failure");
+
+		eastl::vector<eastl::string> strings;
+		for(int i = 0; i < 300; i++)
+			strings.push_back(eastl::string(eastl::string::CtorSprintf(), "a string long enough to live on the heap %d", i));
+
+		// Values which refer to elements of the vector itself, while the vector reallocates.
+		strings.set_capacity(strings.size());
+		strings.push_back(strings[3]);
+		strings.set_capacity(strings.size());
+		strings.emplace(strings.begin() + 1, strings[4]);
+		strings.set_capacity(strings.size());
+		strings.insert(strings.begin() + 2, 2, strings[5]);
+		strings.set_capacity(strings.size());
+
+		const eastl::vector<eastl::string> other(11, eastl::string("x"));
+		strings.insert(strings.begin(), other.begin(), other.end());
+
+		EATEST_VERIFY(strings.size() == 315);
+		EATEST_VERIFY((strings[0] == "x") && (strings[10] == "x"));
+		EATEST_VERIFY(strings[11] == "a string long enough to live on the heap 0");
+		EATEST_VERIFY((strings[12] == "a string long enough to live on the heap 4") && (strings[13] == strings[12]) && (strings[14] == strings[12]));
+		EATEST_VERIFY(strings[15] == "a string long enough to live on the heap 1");
+		EATEST_VERIFY(strings.back() == "a string long enough to live on the heap 3");
+		EATEST_VERIFY(strings.validate());
+
+		eastl::vector<eastl::unique_ptr<int>> pointers;
+		for(int i = 0; i < 1000; i++)
+			pointers.emplace_back(new int(i));
+		pointers.insert(pointers.begin() + 500, eastl::unique_ptr<int>(new int(-1)));
+
+		EATEST_VERIFY((*pointers[499] == 499) && (*pointers[500] == -1) && (*pointers[501] == 500) && (*pointers.back() == 999));
+	}
+
 	return nErrorCount;
 }
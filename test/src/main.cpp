@@ -93,10 +93,15 @@ int EAMain(int argc, char* argv[])
 #endif
 	testSuite.AddTest("BitVector",				TestBitVector);
 	testSuite.AddTest("Bitset",					TestBitset);
+	testSuite.AddTest("BTree",					TestBTree);
 	testSuite.AddTest("CharTraits",			    TestCharTraits);
+	testSuite.AddTest("CharConv",				TestCharConv);
 	testSuite.AddTest("Chrono",					TestChrono);
 	testSuite.AddTest("Concepts", 				TestConcepts);
+	testSuite.AddTest("ConcurrentHashMap",		TestConcurrentHashMap);
+	testSuite.AddTest("ConcurrentQueue",		TestConcurrentQueue);
 	testSuite.AddTest("Deque",					TestDeque);
+	testSuite.AddTest("Execution",				TestExecution);
 	testSuite.AddTest("Extra",					TestExtra);
 	testSuite.AddTest("Finally",				TestFinally);
 	testSuite.AddTest("FixedFunction",			TestFixedFunction);
@@ -108,6 +113,7 @@ int EAMain(int argc, char* argv[])
 	testSuite.AddTest("FixedString",			TestFixedString);
 	testSuite.AddTest("FixedTupleVector",		TestFixedTupleVector);
 	testSuite.AddTest("FixedVector",			TestFixedVector);
+	testSuite.AddTest("FlatHash",				TestFlatHash);
 	testSuite.AddTest("Functional",				TestFunctional);
 	testSuite.AddTest("Hash",					TestHash);
 	testSuite.AddTest("Heap",					TestHeap);
@@ -121,21 +127,25 @@ int EAMain(int argc, char* argv[])
 	testSuite.AddTest("ListMap",				TestListMap);
 	testSuite.AddTest("Map",					TestMap);
 	testSuite.AddTest("Memory",					TestMemory);
+	testSuite.AddTest("MemoryReclamation",		TestMemoryReclamation);
 	testSuite.AddTest("Meta",				    TestMeta);
 	testSuite.AddTest("NumericLimits",			TestNumericLimits);
 	testSuite.AddTest("Optional",				TestOptional);
 	testSuite.AddTest("Random",					TestRandom);
 	testSuite.AddTest("Ratio",					TestRatio);
 	testSuite.AddTest("RingBuffer",				TestRingBuffer);
+	testSuite.AddTest("Rope",					TestRope);
 	testSuite.AddTest("SList",					TestSList);
 	testSuite.AddTest("SegmentedVector",		TestSegmentedVector);
 	testSuite.AddTest("Set",					TestSet);
+	testSuite.AddTest("SmallVector",			TestSmallVector);
 	testSuite.AddTest("SmartPtr",				TestSmartPtr);
 	testSuite.AddTest("Sort",					TestSort);
 	testSuite.AddTest("Span",				    TestSpan);
 	testSuite.AddTest("String",					TestString);
 	testSuite.AddTest("StringHashMap",			TestStringHashMap);
 	testSuite.AddTest("StringMap",				TestStringMap);
+	testSuite.AddTest("StringPool",				TestStringPool);
 	testSuite.AddTest("StringView",			    TestStringView);
 	testSuite.AddTest("TestCppCXTypeTraits",	TestCppCXTypeTraits);
 	testSuite.AddTest("Tuple",					TestTuple);